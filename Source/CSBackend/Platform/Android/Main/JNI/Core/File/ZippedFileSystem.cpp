@@ -37,7 +37,9 @@
 #include <ChilliSource/Core/Cryptographic/HashCRC32.h>
 
 #include <algorithm>
+#include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace CSBackend
 {
@@ -71,6 +73,25 @@ namespace CSBackend
             : m_filePath(in_zipFilePath)
         {
             BuildManifest(in_rootDirectoryPath);
+
+            if (m_isValid == true)
+            {
+                m_fileDescriptor = open(m_filePath.c_str(), O_RDONLY);
+            }
+        }
+        //------------------------------------------------------------------------------
+        //------------------------------------------------------------------------------
+        ZippedFileSystem::~ZippedFileSystem()
+        {
+            for (auto unzipper : m_unzipperPool)
+            {
+                unzClose(unzipper);
+            }
+
+            if (m_fileDescriptor >= 0)
+            {
+                close(m_fileDescriptor);
+            }
         }
         //------------------------------------------------------------------------------
         //------------------------------------------------------------------------------
@@ -141,101 +162,156 @@ namespace CSBackend
                 return nullptr;
             }
 
-            //read the contents of the zip file.
-            std::unique_lock<std::mutex> lock(m_mutex);
+            std::unique_ptr<u8[]> buffer = ReadFileContents(item);
+            if (buffer != nullptr)
+            {
+                numBytesRead = item.m_fileInfo.m_uncompressedSize;
+            }
 
-            unzFile unzipper = unzOpen(m_filePath.c_str());
+            return buffer;
+        }
+        //------------------------------------------------------------------------------
+        //------------------------------------------------------------------------------
+        std::unique_ptr<u8[]> ZippedFileSystem::ReadFileContents(const ManifestItem& in_item) const noexcept
+        {
+            CS_ASSERT(in_item.m_isFile == true, "Cannot read the contents of a directory.");
+
+            const auto& fileInfo = in_item.m_fileInfo;
+            std::unique_ptr<u8[]> buffer(new u8[fileInfo.m_uncompressedSize]);
+
+            //Stored files can be read straight from the zip at the data offset. pread() doesn't change the file
+            //offset so this is safe to do from multiple threads without locking.
+            u32 dataOffset = 0;
+            if (fileInfo.m_isCompressed == false && m_fileDescriptor >= 0 && TryResolveDataOffset(in_item, dataOffset) == true)
+            {
+                u32 totalRead = 0;
+                while (totalRead < fileInfo.m_uncompressedSize)
+                {
+                    ssize_t numRead = pread(m_fileDescriptor, buffer.get() + totalRead, fileInfo.m_uncompressedSize - totalRead, off_t(dataOffset + totalRead));
+                    if (numRead <= 0)
+                    {
+                        return nullptr;
+                    }
+
+                    totalRead += u32(numRead);
+                }
+
+                return buffer;
+            }
+
+            unzFile unzipper = AcquireUnzipper();
             if (unzipper == nullptr)
             {
                 return nullptr;
             }
 
-            s32 result = unzGoToFilePos(unzipper, &item.m_zipPosition);
-            if (result != UNZ_OK)
+            unz_file_pos zipPosition = in_item.m_zipPosition;
+            if (unzGoToFilePos(unzipper, &zipPosition) != UNZ_OK || unzOpenCurrentFile(unzipper) != UNZ_OK)
             {
+                ReleaseUnzipper(unzipper);
                 return nullptr;
             }
 
-            unz_file_info info;
-            unzGetCurrentFileInfo(unzipper, &info, nullptr, 0, nullptr, 0, nullptr, 0);
+            s32 numRead = unzReadCurrentFile(unzipper, (voidp)buffer.get(), fileInfo.m_uncompressedSize);
+            unzCloseCurrentFile(unzipper);
+            ReleaseUnzipper(unzipper);
 
-            result = unzOpenCurrentFile(unzipper);
-            if (result != UNZ_OK)
+            if (numRead != s32(fileInfo.m_uncompressedSize))
             {
                 return nullptr;
             }
 
-            numBytesRead = info.uncompressed_size;
-            std::unique_ptr<u8[]> buffer(new u8[numBytesRead]);
-
-            unzReadCurrentFile(unzipper, (voidp)buffer.get(), numBytesRead);
-            unzCloseCurrentFile(unzipper);
-            unzClose(unzipper);
-
-            return std::move(buffer);
+            return buffer;
         }
         //------------------------------------------------------------------------------
         //------------------------------------------------------------------------------
-        bool ZippedFileSystem::ExtractFiles(const std::vector<std::string>& in_filePaths, const FileReadDelegate& in_delegate) const
+        bool ZippedFileSystem::TryResolveDataOffset(const ManifestItem& in_item, u32& out_offset) const noexcept
         {
-            CS_ASSERT(IsValid() == true, "Calling into an invalid ZippedFileSystem.");
+            CS_ASSERT(in_item.m_isFile == true, "Cannot get the data offset of a directory.");
 
-            std::unique_lock<std::mutex> lock(m_mutex);
-
-            unzFile unzipper = unzOpen(m_filePath.c_str());
-            if (unzipper == nullptr)
+            //The data always follows a local header, so an offset of zero means it hasn't been resolved yet. If two
+            //threads resolve the same file at once they will both store the same value.
+            auto& cachedOffset = m_dataOffsets[in_item.m_fileIndex];
+            u32 offset = cachedOffset.load(std::memory_order_relaxed);
+            if (offset == 0)
             {
-                return false;
-            }
+                unzFile unzipper = AcquireUnzipper();
+                if (unzipper == nullptr)
+                {
+                    return false;
+                }
 
-            bool success = true;
-            ManifestItem item;
-            unz_file_info info;
-            for (const auto& unstandardisedFilePath : in_filePaths)
-            {
-                auto filePath = ChilliSource::StringUtils::StandardiseFilePath(unstandardisedFilePath);
-                if (TryGetManifestItem(filePath, item) == false)
+                unz_file_pos zipPosition = in_item.m_zipPosition;
+                if (unzGoToFilePos(unzipper, &zipPosition) == UNZ_OK && unzOpenCurrentFile(unzipper) == UNZ_OK)
                 {
-                    success = false;
-                    break;
+                    offset = static_cast<u32>(unzGetCurrentFileZStreamPos64(unzipper));
+                    unzCloseCurrentFile(unzipper);
                 }
+                ReleaseUnzipper(unzipper);
 
-                if (item.m_isFile == false)
+                if (offset == 0)
                 {
-                    success = false;
-                    break;
+                    return false;
                 }
 
-                s32 result = unzGoToFilePos(unzipper, &item.m_zipPosition);
-                if (result != UNZ_OK)
+                cachedOffset.store(offset, std::memory_order_relaxed);
+            }
+
+            out_offset = offset;
+            return true;
+        }
+        //------------------------------------------------------------------------------
+        //------------------------------------------------------------------------------
+        unzFile ZippedFileSystem::AcquireUnzipper() const noexcept
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_unzipperPoolMutex);
+                if (m_unzipperPool.empty() == false)
                 {
-                    success = false;
-                    break;
+                    unzFile unzipper = m_unzipperPool.back();
+                    m_unzipperPool.pop_back();
+                    return unzipper;
                 }
+            }
 
-                unzGetCurrentFileInfo(unzipper, &info, nullptr, 0, nullptr, 0, nullptr, 0);
+            //The pool only grows to the number of threads which read concurrently, so opening a new handle is rare.
+            return unzOpen(m_filePath.c_str());
+        }
+        //------------------------------------------------------------------------------
+        //------------------------------------------------------------------------------
+        void ZippedFileSystem::ReleaseUnzipper(unzFile in_unzipper) const noexcept
+        {
+            std::unique_lock<std::mutex> lock(m_unzipperPoolMutex);
+            m_unzipperPool.push_back(in_unzipper);
+        }
+        //------------------------------------------------------------------------------
+        //------------------------------------------------------------------------------
+        bool ZippedFileSystem::ExtractFiles(const std::vector<std::string>& in_filePaths, const FileReadDelegate& in_delegate) const
+        {
+            CS_ASSERT(IsValid() == true, "Calling into an invalid ZippedFileSystem.");
 
-                result = unzOpenCurrentFile(unzipper);
-                if (result != UNZ_OK)
+            ManifestItem item;
+            for (const auto& unstandardisedFilePath : in_filePaths)
+            {
+                auto filePath = ChilliSource::StringUtils::StandardiseFilePath(unstandardisedFilePath);
+                if (TryGetManifestItem(filePath, item) == false || item.m_isFile == false)
                 {
-                    success = false;
-                    break;
+                    return false;
                 }
 
-                std::unique_ptr<u8[]> buffer(new u8[info.uncompressed_size]);
-                unzReadCurrentFile(unzipper, (voidp)buffer.get(), info.uncompressed_size);
-                unzCloseCurrentFile(unzipper);
+                std::unique_ptr<u8[]> buffer = ReadFileContents(item);
+                if (buffer == nullptr)
+                {
+                    return false;
+                }
 
-                if (in_delegate(unstandardisedFilePath, std::move(buffer), info.uncompressed_size) == false)
+                if (in_delegate(unstandardisedFilePath, std::move(buffer), item.m_fileInfo.m_uncompressedSize) == false)
                 {
-                    success = false;
-                    break;
+                    return false;
                 }
             }
 
-            unzClose(unzipper);
-
-            return success;
+            return true;
         }
         //------------------------------------------------------------------------------
         //------------------------------------------------------------------------------
@@ -334,39 +410,8 @@ namespace CSBackend
                 return false;
             }
 
-            //read the contents of the zip file.
-            std::unique_lock<std::mutex> lock(m_mutex);
-
-            unzFile unzipper = unzOpen(m_filePath.c_str());
-            if (unzipper == nullptr)
-            {
-                return false;
-            }
-
-            s32 result = unzGoToFilePos(unzipper, &item.m_zipPosition);
-            if (result != UNZ_OK)
-            {
-                return false;
-            }
-
-            unz_file_info info;
-            unzGetCurrentFileInfo(unzipper, &info, nullptr, 0, nullptr, 0, nullptr, 0);
-
-            result = unzOpenCurrentFile(unzipper);
-            if (result != UNZ_OK)
-            {
-                return false;
-            }
-
-            out_fileInfo.m_offset = static_cast<u32>(unzGetCurrentFileZStreamPos64(unzipper));
-            out_fileInfo.m_size = static_cast<u32>(info.compressed_size);
-            out_fileInfo.m_uncompressedSize = static_cast<u32>(info.uncompressed_size);
-            out_fileInfo.m_isCompressed = (info.compression_method != 0);
-
-            unzCloseCurrentFile(unzipper);
-            unzClose(unzipper);
-
-            return true;
+            out_fileInfo = item.m_fileInfo;
+            return TryResolveDataOffset(item, out_fileInfo.m_offset);
         }
         //------------------------------------------------------------------------------
         //------------------------------------------------------------------------------
@@ -401,13 +446,30 @@ namespace CSBackend
 
                     unz_file_pos filePos;
                     unzGetFilePos(unzipper, &filePos);
-                    AddItemToManifest(filePath, filePos, IsFile(info));
+
+                    //Everything but the data offset is available from the central directory, so no file is opened
+                    //here. The offset is resolved on first use; see TryResolveDataOffset().
+                    FileInfo fileInfo;
+                    if (IsFile(info) == true)
+                    {
+                        fileInfo.m_size = static_cast<u32>(info.compressed_size);
+                        fileInfo.m_uncompressedSize = static_cast<u32>(info.uncompressed_size);
+                        fileInfo.m_isCompressed = (info.compression_method != 0);
+                    }
+
+                    AddItemToManifest(filePath, filePos, IsFile(info), fileInfo);
                 }
 
                 status = unzGoToNextFile(unzipper);
             }
             unzClose(unzipper);
 
+            m_dataOffsets.reset(new std::atomic<u32>[m_numFiles]);
+            for (u32 i = 0; i < m_numFiles; ++i)
+            {
+                m_dataOffsets[i].store(0, std::memory_order_relaxed);
+            }
+
             std::sort(m_manifestItems.begin(), m_manifestItems.end(), [](const ManifestItem& in_lhs, const ManifestItem& in_rhs)
             {
                 return in_lhs.m_pathHash < in_rhs.m_pathHash;
@@ -417,7 +479,7 @@ namespace CSBackend
         }
         //------------------------------------------------------------------------------
         //------------------------------------------------------------------------------
-        void ZippedFileSystem::AddItemToManifest(const std::string& in_filePath, unz_file_pos in_zipPosition, bool in_isFile)
+        void ZippedFileSystem::AddItemToManifest(const std::string& in_filePath, unz_file_pos in_zipPosition, bool in_isFile, const FileInfo& in_fileInfo)
         {
             std::string filePath = ChilliSource::StringUtils::StandardiseFilePath(in_filePath);
 
@@ -456,6 +518,11 @@ namespace CSBackend
 			item.m_pathHash = ChilliSource::HashCRC32::GenerateHashCode(item.m_path);
 			item.m_isFile = in_isFile;
 			item.m_zipPosition = in_zipPosition;
+			item.m_fileInfo = in_fileInfo;
+			if (in_isFile == true)
+			{
+				item.m_fileIndex = m_numFiles++;
+			}
 			m_manifestItems.push_back(item);
         }
         //------------------------------------------------------------------------------
@@ -35,6 +35,9 @@
 
 #include <minizip/unzip.h>
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -49,10 +52,13 @@ namespace CSBackend
         /// This includes operations such as creation of (virtual) file streams, copying
         /// a file and listing the contents of a directory.
         ///
-        /// This is thread-safe and many operations can be performed without locking.
-        /// This isn't possible for some operations, however, such as creating a file
-        /// stream or copying files. In these cases care needs to be taken to avoid
-        /// negatively hurting performance.
+        /// This is thread-safe and most operations can be performed without locking.
+        /// The manifest is built from the zip's central directory alone. The offset of
+        /// each file's data is resolved the first time it is needed and cached, after
+        /// which files stored uncompressed are read directly from the zip file at that
+        /// offset. Compressed files are inflated using a
+        /// pool of open zip handles, allowing multiple threads to read from the zip
+        /// concurrently without re-opening it for every file.
         ///
         /// @author Ian Copland
         //------------------------------------------------------------------------------
@@ -103,6 +109,10 @@ namespace CSBackend
             //------------------------------------------------------------------------------
             ZippedFileSystem(const std::string& in_zipFilePath, const std::string& in_rootDirectoryPath = "");
             //------------------------------------------------------------------------------
+            /// Closes the zip file and any pooled zip handles.
+            //------------------------------------------------------------------------------
+            ~ZippedFileSystem();
+            //------------------------------------------------------------------------------
             /// This should be checked prior to using any of the other methods. If this
             /// returns false the ZippedFileSystem should be discarded.
             ///
@@ -117,10 +127,9 @@ namespace CSBackend
             /// file is inflated in full and stored in memory. The "virtual" file stream
             /// then treats this memory as if it were a file on disk.
             ///
-            /// This can only be called by one thread at a time meaning others will block
-            /// until it is finished. This can be a slow operation if accessing a large
-            /// file, so care needs to be taken to ensure this doesn't cause visible
-            /// stutters on the main thread.
+            /// This can be called from multiple threads concurrently. This can be a slow
+            /// operation if accessing a large file, so care needs to be taken to ensure
+            /// this doesn't cause visible stutters on the main thread.
             ///
             /// @author HMcLaughlin
             ///
@@ -135,10 +144,9 @@ namespace CSBackend
             /// file is inflated in full and stored in memory. The "virtual" file stream
             /// then treats this memory as if it were a file on disk.
             ///
-            /// This can only be called by one thread at a time meaning others will block
-            /// until it is finished. This can be a slow operation if accessing a large
-            /// file, so care needs to be taken to ensure this doesn't cause visible
-            /// stutters on the main thread.
+            /// This can be called from multiple threads concurrently. This can be a slow
+            /// operation if accessing a large file, so care needs to be taken to ensure
+            /// this doesn't cause visible stutters on the main thread.
             ///
             /// @author HMcLaughlin
             ///
@@ -158,10 +166,9 @@ namespace CSBackend
             /// inefficient. This method doesn't close the zip after each file stream is
             /// created and acts as a more efficient alternate.
             ///
-            /// This can only be called by one thread at a time meaning others will block
-            /// until it is finished. This can be a slow operation if copying large files,
-            /// so care needs to be taken to ensure this doesn't cause visible stutters on
-            /// the main thread.
+            /// This can be called from multiple threads concurrently. This can be a slow
+            /// operation if copying large files, so care needs to be taken to ensure this
+            /// doesn't cause visible stutters on the main thread.
             ///
             /// @author Ian Copland
             ///
@@ -212,9 +219,9 @@ namespace CSBackend
             //------------------------------------------------------------------------------
             std::vector<std::string> GetDirectoryPaths(const std::string& in_directoryPath, bool in_recursive) const;
             //------------------------------------------------------------------------------
-            /// Gets information on a single file within the zip. This information requires
-            /// the zip file to be opened and therefore requires a lock to remain thread
-            /// safe.
+            /// Gets information on a single file within the zip. The sizes are recorded
+            /// when the manifest is built, and the data offset is resolved from the
+            /// file's local header on first request and cached.
             ///
             /// @author Ian Copland
             ///
@@ -238,6 +245,8 @@ namespace CSBackend
                 std::string m_path;
                 bool m_isFile = false;
                 unz_file_pos m_zipPosition;
+                FileInfo m_fileInfo;
+                u32 m_fileIndex = 0;
             };
             //------------------------------------------------------------------------------
             /// Builds a manifest of the contents of the given root directory within the
@@ -265,8 +274,9 @@ namespace CSBackend
             /// @param in_filePath - The file path which should be added to the manifest.
             /// @param in_zipPosition - The position of the file inside the zip.
             /// @param in_isFile - Whether or not the entry is a file.
+            /// @param in_fileInfo - The location of the file data within the zip.
             //------------------------------------------------------------------------------
-            void AddItemToManifest(const std::string& in_filePath, unz_file_pos in_zipPosition, bool in_isFile);
+            void AddItemToManifest(const std::string& in_filePath, unz_file_pos in_zipPosition, bool in_isFile, const FileInfo& in_fileInfo);
             //------------------------------------------------------------------------------
             /// Searches the manifest item list for the manifest item with the given path.
             /// If it is found true is returned and the output manifest item is set. If it
@@ -293,12 +303,54 @@ namespace CSBackend
             /// @return The data read.
             //------------------------------------------------------------------------------
             std::unique_ptr<u8[]> ReadZipFileContents(const std::string& filePath, u32& numBytesRead) const noexcept;
+            //------------------------------------------------------------------------------
+            /// Reads the full contents of the given file manifest item. Files stored
+            /// without compression are read directly from the zip file at the offset
+            /// recorded in the manifest, while compressed files are inflated using a
+            /// pooled zip handle.
+            ///
+            /// @param in_item - The manifest item for the file. Must be a file.
+            ///
+            /// @return The contents of the file, or null if it could not be read.
+            //------------------------------------------------------------------------------
+            std::unique_ptr<u8[]> ReadFileContents(const ManifestItem& in_item) const noexcept;
+            //------------------------------------------------------------------------------
+            /// Gets the offset of the given file's data within the zip. The central
+            /// directory doesn't contain this as the size of each local header can differ
+            /// from the central directory entry, so the first call for each file opens it
+            /// with a pooled zip handle and the result is cached. This is thread-safe.
+            ///
+            /// @param in_item - The manifest item for the file. Must be a file.
+            /// @param out_offset - [Out] The offset of the file data within the zip.
+            ///
+            /// @return Whether or not the offset could be resolved.
+            //------------------------------------------------------------------------------
+            bool TryResolveDataOffset(const ManifestItem& in_item, u32& out_offset) const noexcept;
+            //------------------------------------------------------------------------------
+            /// Takes an open zip handle from the pool, opening a new one if the pool is
+            /// empty. The handle must be returned with ReleaseUnzipper() once finished
+            /// with. This is thread-safe.
+            ///
+            /// @return The zip handle, or null if the zip could not be opened.
+            //------------------------------------------------------------------------------
+            unzFile AcquireUnzipper() const noexcept;
+            //------------------------------------------------------------------------------
+            /// Returns a zip handle to the pool so it can be re-used by any thread. This
+            /// is thread-safe.
+            ///
+            /// @param in_unzipper - The zip handle. Must not have a current file open.
+            //------------------------------------------------------------------------------
+            void ReleaseUnzipper(unzFile in_unzipper) const noexcept;
 
             std::string m_filePath;
             bool m_isValid = false;
             std::vector<ManifestItem> m_manifestItems;
+            u32 m_numFiles = 0;
+            std::unique_ptr<std::atomic<u32>[]> m_dataOffsets;
+            s32 m_fileDescriptor = -1;
 
-            mutable std::mutex m_mutex;
+            mutable std::mutex m_unzipperPoolMutex;
+            mutable std::vector<unzFile> m_unzipperPool;
         };
     }
 }
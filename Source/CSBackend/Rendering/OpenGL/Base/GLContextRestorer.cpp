@@ -31,6 +31,7 @@
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/Resource/ResourcePool.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/RenderUploadScheduler.h>
 #include <ChilliSource/Rendering/Base/TargetType.h>
 #include <ChilliSource/Rendering/Material/Material.h>
 #include <ChilliSource/Rendering/Model/Model.h>
@@ -141,10 +142,13 @@ namespace CSBackend
 #endif
                 resourcePool->RefreshResources<ChilliSource::Shader>();
                 
+                //Resources which are still waiting to be uploaded will be loaded with their original data.
+                auto uploadScheduler = ChilliSource::Application::Get()->GetSystem<ChilliSource::RenderUploadScheduler>();
+                
                 auto allTextures = resourcePool->GetAllResources<ChilliSource::Texture>();
                 for (const auto& texture : allTextures)
 				{
-                    if (texture->GetStorageLocation() == ChilliSource::StorageLocation::k_none)
+                    if (texture->GetStorageLocation() == ChilliSource::StorageLocation::k_none && !uploadScheduler->IsTextureUploadPending(texture->GetRenderTexture()))
                     {
                         ChilliSource::RestoreTextureRenderCommand command(texture->GetRenderTexture());
                         m_pendingRestoreTextureCommands.push_back(std::move(command));
@@ -155,7 +159,7 @@ namespace CSBackend
                 auto allCubemaps = resourcePool->GetAllResources<ChilliSource::Cubemap>();
                 for (const auto& cubemap : allCubemaps)
                 {
-                    if (cubemap->GetStorageLocation() == ChilliSource::StorageLocation::k_none)
+                    if (cubemap->GetStorageLocation() == ChilliSource::StorageLocation::k_none && !uploadScheduler->IsTextureUploadPending(cubemap->GetRenderTexture()))
                     {
                         ChilliSource::RestoreCubemapRenderCommand command(cubemap->GetRenderTexture());
                         m_pendingRestoreCubemapCommands.push_back(std::move(command));
@@ -170,8 +174,11 @@ namespace CSBackend
                     {
                         for(u32 i = 0; i < model->GetNumMeshes(); ++i)
                         {
-                            ChilliSource::RestoreMeshRenderCommand command(model->GetRenderMesh(i));
-                            m_pendingRestoreMeshCommands.push_back(std::move(command));
+                            if (!uploadScheduler->IsMeshUploadPending(model->GetRenderMesh(i)))
+                            {
+                                ChilliSource::RestoreMeshRenderCommand command(model->GetRenderMesh(i));
+                                m_pendingRestoreMeshCommands.push_back(std::move(command));
+                            }
                         }
                     }
                 }
@@ -31,10 +31,16 @@
 extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 extern PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT;
 extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
+extern PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisorEXTEXT;
+extern PFNGLDRAWARRAYSINSTANCEDEXTPROC glDrawArraysInstancedEXTEXT;
+extern PFNGLDRAWELEMENTSINSTANCEDEXTPROC glDrawElementsInstancedEXTEXT;
 
 #   define glGenVertexArraysOES glGenVertexArraysOESEXT
 #   define glBindVertexArrayOES glBindVertexArrayOESEXT
 #   define glDeleteVertexArraysOES glDeleteVertexArraysOESEXT
+#   define glVertexAttribDivisorEXT glVertexAttribDivisorEXTEXT
+#   define glDrawArraysInstancedEXT glDrawArraysInstancedEXTEXT
+#   define glDrawElementsInstancedEXT glDrawElementsInstancedEXTEXT
 #endif
 
 #ifdef CS_OPENGLVERSION_ES
@@ -45,6 +51,11 @@ extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
 #   define GL_WRITE_ONLY GL_WRITE_ONLY_OES
 #   define glMapBuffer glMapBufferOES
 #   define glUnmapBuffer glUnmapBufferOES
+
+//Instancing is provided by extensions on both ES and standard OpenGL, so the ES extension is mapped to the ARB names.
+#   define glVertexAttribDivisorARB glVertexAttribDivisorEXT
+#   define glDrawArraysInstancedARB glDrawArraysInstancedEXT
+#   define glDrawElementsInstancedARB glDrawElementsInstancedEXT
 #endif
 
 namespace CSBackend
@@ -0,0 +1,320 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
+
+#include <CSBackend/Rendering/OpenGL/Base/GLError.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLExtensions.h>
+
+#include <algorithm>
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        namespace
+        {
+            /// @param capability
+            ///     The OpenGL capability.
+            ///
+            /// @return The index of the capability in the capability cache.
+            ///
+            u32 GetCapabilityIndex(GLenum capability) noexcept
+            {
+                switch (capability)
+                {
+                    case GL_BLEND:
+                        return 0;
+                    case GL_CULL_FACE:
+                        return 1;
+                    case GL_DEPTH_TEST:
+                        return 2;
+                    case GL_STENCIL_TEST:
+                        return 3;
+                    default:
+                        CS_LOG_FATAL("Unsupported capability.");
+                        return 0;
+                }
+            }
+            
+            /// @param target
+            ///     The OpenGL texture target.
+            ///
+            /// @return The index of the target in the texture binding cache.
+            ///
+            u32 GetTextureTargetIndex(GLenum target) noexcept
+            {
+                switch (target)
+                {
+                    case GL_TEXTURE_2D:
+                        return 0;
+                    case GL_TEXTURE_CUBE_MAP:
+                        return 1;
+                    default:
+                        CS_LOG_FATAL("Unsupported texture target.");
+                        return 0;
+                }
+            }
+        }
+        
+        constexpr u32 GLStateCache::k_maxVertexAttributes;
+        
+        //------------------------------------------------------------------------------
+        GLStateCache::GLStateCache(u32 numTextureUnits, u32 numVertexAttributes) noexcept
+            : m_numVertexAttributes(std::min(numVertexAttributes, k_maxVertexAttributes)), m_textureBindings(numTextureUnits)
+        {
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::ResetCounters() noexcept
+        {
+            m_numIssued = 0;
+            m_numElided = 0;
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::Reset() noexcept
+        {
+            m_program.m_isKnown = false;
+            m_vertexArray.m_isKnown = false;
+            m_arrayBuffer.m_isKnown = false;
+            m_elementArrayBuffer.m_isKnown = false;
+            
+            for (auto& vertexAttribArray : m_vertexAttribArrays)
+            {
+                vertexAttribArray.m_isKnown = false;
+            }
+            
+            m_activeTextureUnit.m_isKnown = false;
+            for (auto& textureBinding : m_textureBindings)
+            {
+                for (auto& targetBinding : textureBinding)
+                {
+                    targetBinding.m_isKnown = false;
+                }
+            }
+            
+            m_frameBuffer.m_isKnown = false;
+            m_viewport.m_isKnown = false;
+            
+            for (auto& capability : m_capabilities)
+            {
+                capability.m_isKnown = false;
+            }
+            
+            m_depthMask.m_isKnown = false;
+            m_colourMask.m_isKnown = false;
+            m_depthFunc.m_isKnown = false;
+            m_blendFunc.m_isKnown = false;
+            m_cullFace.m_isKnown = false;
+            m_stencilOp.m_isKnown = false;
+            m_stencilFunc.m_isKnown = false;
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::UseProgram(GLuint programId) noexcept
+        {
+            if (Update(m_program, programId))
+            {
+                glUseProgram(programId);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::BindVertexArray(GLuint vertexArray) noexcept
+        {
+            if (Update(m_vertexArray, vertexArray))
+            {
+                glBindVertexArray(vertexArray);
+                
+                m_elementArrayBuffer.m_isKnown = false;
+                for (auto& vertexAttribArray : m_vertexAttribArrays)
+                {
+                    vertexAttribArray.m_isKnown = false;
+                }
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::BindBuffer(GLenum target, GLuint buffer) noexcept
+        {
+            CS_ASSERT(target == GL_ARRAY_BUFFER || target == GL_ELEMENT_ARRAY_BUFFER, "Unsupported buffer target.");
+            
+            auto& state = (target == GL_ARRAY_BUFFER) ? m_arrayBuffer : m_elementArrayBuffer;
+            if (Update(state, buffer))
+            {
+                glBindBuffer(target, buffer);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetEnabledVertexAttribArrays(u32 enabledMask) noexcept
+        {
+            CS_ASSERT((u64(enabledMask) >> m_numVertexAttributes) == 0, "Vertex attribute index out of range.");
+            
+            for (u32 i = 0; i < m_numVertexAttributes; ++i)
+            {
+                SetVertexAttribArrayEnabled(i, (enabledMask & (1u << i)) != 0);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetVertexAttribArrayEnabled(u32 index, bool enabled) noexcept
+        {
+            CS_ASSERT(index < m_numVertexAttributes, "Vertex attribute index out of range.");
+            
+            if (Update(m_vertexAttribArrays[index], enabled))
+            {
+                enabled ? glEnableVertexAttribArray(index) : glDisableVertexAttribArray(index);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::BindTexture(u32 unit, GLenum target, GLuint texture) noexcept
+        {
+            CS_ASSERT(unit < m_textureBindings.size(), "Texture unit out of range.");
+            
+            auto& state = m_textureBindings[unit][GetTextureTargetIndex(target)];
+            if (state.m_isKnown && state.m_value == texture)
+            {
+                ++m_numElided;
+                return;
+            }
+            
+            if (Update(m_activeTextureUnit, unit))
+            {
+                glActiveTexture(GLenum(GL_TEXTURE0 + unit));
+            }
+            
+            Update(state, texture);
+            glBindTexture(target, texture);
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::BindFramebuffer(GLuint frameBuffer) noexcept
+        {
+            if (Update(m_frameBuffer, frameBuffer))
+            {
+                glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) noexcept
+        {
+            if (Update(m_viewport, std::array<GLint, 4>{{ x, y, GLint(width), GLint(height) }}))
+            {
+                glViewport(x, y, width, height);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetCapabilityEnabled(GLenum capability, bool enabled) noexcept
+        {
+            if (Update(m_capabilities[GetCapabilityIndex(capability)], enabled))
+            {
+                enabled ? glEnable(capability) : glDisable(capability);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetDepthMask(bool enabled) noexcept
+        {
+            if (Update(m_depthMask, enabled))
+            {
+                glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetColourMask(bool enabled) noexcept
+        {
+            if (Update(m_colourMask, enabled))
+            {
+                GLboolean mask = enabled ? GL_TRUE : GL_FALSE;
+                glColorMask(mask, mask, mask, mask);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetDepthFunc(GLenum func) noexcept
+        {
+            if (Update(m_depthFunc, func))
+            {
+                glDepthFunc(func);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetBlendFunc(GLenum sourceFactor, GLenum destinationFactor) noexcept
+        {
+            if (Update(m_blendFunc, std::array<GLenum, 2>{{ sourceFactor, destinationFactor }}))
+            {
+                glBlendFunc(sourceFactor, destinationFactor);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetCullFace(GLenum cullFace) noexcept
+        {
+            if (Update(m_cullFace, cullFace))
+            {
+                glCullFace(cullFace);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetStencilOp(GLenum failOp, GLenum depthFailOp, GLenum passOp) noexcept
+        {
+            if (Update(m_stencilOp, std::array<GLenum, 3>{{ failOp, depthFailOp, passOp }}))
+            {
+                glStencilOp(failOp, depthFailOp, passOp);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::SetStencilFunc(GLenum func, GLint ref, GLuint mask) noexcept
+        {
+            if (Update(m_stencilFunc, std::array<GLuint, 3>{{ GLuint(func), GLuint(ref), mask }}))
+            {
+                glStencilFunc(func, ref, mask);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        template <typename TValue> bool GLStateCache::Update(CachedState<TValue>& state, const TValue& value) noexcept
+        {
+            if (state.m_isKnown && state.m_value == value)
+            {
+                ++m_numElided;
+                return false;
+            }
+            
+            state.m_value = value;
+            state.m_isKnown = true;
+            ++m_numIssued;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,262 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CSBACKEND_RENDERING_OPENGL_BASE_GLSTATECACHE_H_
+#define _CSBACKEND_RENDERING_OPENGL_BASE_GLSTATECACHE_H_
+
+#include <CSBackend/Rendering/OpenGL/ForwardDeclarations.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLIncludes.h>
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <array>
+#include <vector>
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        /// A shadow copy of the OpenGL state which is changed while rendering. Each state change
+        /// is compared against the shadowed value and calls which wouldn't change anything are
+        /// not issued. The number of issued and elided calls is recorded so the effectiveness of
+        /// the cache can be measured.
+        ///
+        /// State which is changed without going through the cache, for example while loading
+        /// resources, isn't tracked, so the cache must be reset afterwards. After being reset
+        /// the state is considered unknown and the next change to each piece of state is always
+        /// issued.
+        ///
+        /// This is not thread-safe and should only be accessed from the render thread.
+        ///
+        class GLStateCache final
+        {
+        public:
+            CS_DECLARE_NOCOPY(GLStateCache);
+            
+            /// The maximum number of vertex attributes which can have their enabled state set. This
+            /// is limited by the size of the mask passed to SetEnabledVertexAttribArrays().
+            ///
+            static constexpr u32 k_maxVertexAttributes = 32;
+            
+            /// Creates a new cache in which all state is unknown.
+            ///
+            /// @param numTextureUnits
+            ///     The number of texture units available.
+            /// @param numVertexAttributes
+            ///     The number of vertex attributes available. Only the first k_maxVertexAttributes
+            ///     are tracked.
+            ///
+            GLStateCache(u32 numTextureUnits, u32 numVertexAttributes) noexcept;
+            
+            /// @return The number of state changes issued since the counters were last reset.
+            ///
+            u32 GetNumIssued() const noexcept { return m_numIssued; }
+            
+            /// @return The number of state changes elided since the counters were last reset.
+            ///
+            u32 GetNumElided() const noexcept { return m_numElided; }
+            
+            /// Resets the issued and elided counters to zero.
+            ///
+            void ResetCounters() noexcept;
+            
+            /// Marks all state as unknown. This should be called whenever the OpenGL state may have
+            /// been changed without going through the cache, or the context has been lost.
+            ///
+            void Reset() noexcept;
+            
+            /// Sets the current shader program.
+            ///
+            /// @param programId
+            ///     The program id.
+            ///
+            void UseProgram(GLuint programId) noexcept;
+            
+            /// Binds the given vertex array object. The element array buffer and vertex attribute
+            /// state is part of the vertex array object, so it becomes unknown if the bound vertex
+            /// array object changes.
+            ///
+            /// @param vertexArray
+            ///     The vertex array object.
+            ///
+            void BindVertexArray(GLuint vertexArray) noexcept;
+            
+            /// Binds the given buffer.
+            ///
+            /// @param target
+            ///     The target. Must be GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+            /// @param buffer
+            ///     The buffer handle.
+            ///
+            void BindBuffer(GLenum target, GLuint buffer) noexcept;
+            
+            /// Enables the vertex attribute arrays in the given mask and disables all others.
+            ///
+            /// @param enabledMask
+            ///     A bit mask of the attribute indices which should be enabled.
+            ///
+            void SetEnabledVertexAttribArrays(u32 enabledMask) noexcept;
+            
+            /// Enables or disables a single vertex attribute array, leaving all others unchanged.
+            ///
+            /// @param index
+            ///     The attribute index.
+            /// @param enabled
+            ///     Whether or not the attribute array should be enabled.
+            ///
+            void SetVertexAttribArrayEnabled(u32 index, bool enabled) noexcept;
+            
+            /// Binds the given texture to the given texture unit, changing the active texture unit
+            /// if required.
+            ///
+            /// @param unit
+            ///     The texture unit.
+            /// @param target
+            ///     The target. Must be GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP.
+            /// @param texture
+            ///     The texture handle.
+            ///
+            void BindTexture(u32 unit, GLenum target, GLuint texture) noexcept;
+            
+            /// Binds the given frame buffer.
+            ///
+            /// @param frameBuffer
+            ///     The frame buffer handle.
+            ///
+            void BindFramebuffer(GLuint frameBuffer) noexcept;
+            
+            /// Sets the viewport.
+            ///
+            /// @param x
+            ///     The left of the viewport.
+            /// @param y
+            ///     The bottom of the viewport.
+            /// @param width
+            ///     The width of the viewport.
+            /// @param height
+            ///     The height of the viewport.
+            ///
+            void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) noexcept;
+            
+            /// Enables or disables the given capability.
+            ///
+            /// @param capability
+            ///     The capability. Must be GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST or GL_STENCIL_TEST.
+            /// @param enabled
+            ///     Whether or not the capability should be enabled.
+            ///
+            void SetCapabilityEnabled(GLenum capability, bool enabled) noexcept;
+            
+            /// @param enabled
+            ///     Whether or not depth writes are enabled.
+            ///
+            void SetDepthMask(bool enabled) noexcept;
+            
+            /// @param enabled
+            ///     Whether or not colour writes are enabled for all channels.
+            ///
+            void SetColourMask(bool enabled) noexcept;
+            
+            /// @param func
+            ///     The depth test function.
+            ///
+            void SetDepthFunc(GLenum func) noexcept;
+            
+            /// @param sourceFactor
+            ///     The source blend factor.
+            /// @param destinationFactor
+            ///     The destination blend factor.
+            ///
+            void SetBlendFunc(GLenum sourceFactor, GLenum destinationFactor) noexcept;
+            
+            /// @param cullFace
+            ///     The face which should be culled.
+            ///
+            void SetCullFace(GLenum cullFace) noexcept;
+            
+            /// @param failOp
+            ///     The op used when the stencil test fails.
+            /// @param depthFailOp
+            ///     The op used when the stencil test passes but the depth test fails.
+            /// @param passOp
+            ///     The op used when both the stencil and depth tests pass.
+            ///
+            void SetStencilOp(GLenum failOp, GLenum depthFailOp, GLenum passOp) noexcept;
+            
+            /// @param func
+            ///     The stencil test function.
+            /// @param ref
+            ///     The stencil reference value.
+            /// @param mask
+            ///     The stencil mask.
+            ///
+            void SetStencilFunc(GLenum func, GLint ref, GLuint mask) noexcept;
+            
+        private:
+            /// A single piece of shadowed state.
+            ///
+            template <typename TValue> struct CachedState
+            {
+                TValue m_value;
+                bool m_isKnown = false;
+            };
+            
+            /// Compares the given value with the shadowed state, updating the state and the
+            /// counters.
+            ///
+            /// @param state
+            ///     The shadowed state.
+            /// @param value
+            ///     The requested value.
+            ///
+            /// @return Whether or not the state changed and the call should be issued.
+            ///
+            template <typename TValue> bool Update(CachedState<TValue>& state, const TValue& value) noexcept;
+            
+            u32 m_numIssued = 0;
+            u32 m_numElided = 0;
+            u32 m_numVertexAttributes;
+            
+            CachedState<GLuint> m_program;
+            CachedState<GLuint> m_vertexArray;
+            CachedState<GLuint> m_arrayBuffer;
+            CachedState<GLuint> m_elementArrayBuffer;
+            std::array<CachedState<bool>, k_maxVertexAttributes> m_vertexAttribArrays;
+            CachedState<u32> m_activeTextureUnit;
+            std::vector<std::array<CachedState<GLuint>, 2>> m_textureBindings;
+            CachedState<GLuint> m_frameBuffer;
+            CachedState<std::array<GLint, 4>> m_viewport;
+            std::array<CachedState<bool>, 4> m_capabilities;
+            CachedState<bool> m_depthMask;
+            CachedState<bool> m_colourMask;
+            CachedState<GLenum> m_depthFunc;
+            CachedState<std::array<GLenum, 2>> m_blendFunc;
+            CachedState<GLenum> m_cullFace;
+            CachedState<std::array<GLenum, 3>> m_stencilOp;
+            CachedState<std::array<GLuint, 3>> m_stencilFunc;
+        };
+    }
+}
+
+#endif
@@ -30,6 +30,7 @@
 #include <CSBackend/Rendering/OpenGL/Lighting/GLDirectionalLight.h>
 #include <CSBackend/Rendering/OpenGL/Lighting/GLPointLight.h>
 #include <CSBackend/Rendering/OpenGL/Material/GLMaterial.h>
+#include <CSBackend/Rendering/OpenGL/Material/GLMaterialBinding.h>
 #include <CSBackend/Rendering/OpenGL/Model/GLMesh.h>
 #include <CSBackend/Rendering/OpenGL/Model/GLSkinnedAnimation.h>
 #include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
@@ -37,6 +38,9 @@
 #include <CSBackend/Rendering/OpenGL/Texture/GLCubemap.h>
 #include <CSBackend/Rendering/OpenGL/Texture/GLTexture.h>
 
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Time/Profiler.h>
+#include <ChilliSource/Rendering/Base/RenderCapabilities.h>
 #include <ChilliSource/Rendering/Model/IndexFormat.h>
 #include <ChilliSource/Rendering/Model/PolygonType.h>
 #include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
@@ -61,6 +65,7 @@
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadCubemapRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadTextureRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstanceRenderCommand.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstancesRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreMeshRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreRenderTargetGroupCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreCubemapRenderCommand.h>
@@ -83,11 +88,6 @@ namespace CSBackend
     {
         namespace
         {
-            const std::string k_uniformWVPMat = "u_wvpMat";
-            const std::string k_uniformWorldMat = "u_worldMat";
-            const std::string k_uniformViewMat = "u_viewMat";
-            const std::string k_uniformNormalMat = "u_normalMat";
-            
             /// Converts from a ChilliSource polygon type to a OpenGL polygon type.
             ///
             /// @param blendMode
@@ -134,15 +134,19 @@ namespace CSBackend
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::Process(const ChilliSource::RenderCommandBuffer* renderCommandBuffer) noexcept
         {
+            CS_PROFILE_ZONE("RenderCommandProcessor::Process");
+            
             if (m_initRequired)
             {
                 m_initRequired = false;
                 Init();
             }
             
+            m_glStateCache->ResetCounters();
+            
             for(const auto& renderCommandList : renderCommandBuffer->GetQueue())
             {
-                for (const auto& renderCommand : renderCommandList->GetOrderedList())
+                for (const auto renderCommand : *renderCommandList)
                 {
                     switch (renderCommand->GetType())
                     {
@@ -156,7 +160,7 @@ namespace CSBackend
                             LoadCubemap(static_cast<const ChilliSource::LoadCubemapRenderCommand*>(renderCommand));
                             break;
                         case ChilliSource::RenderCommand::Type::k_loadMaterialGroup:
-                            // Do nothing in OpenGL 2.0 / ES 2.0
+                            LoadMaterialGroup(static_cast<const ChilliSource::LoadMaterialGroupRenderCommand*>(renderCommand));
                             break;
                         case ChilliSource::RenderCommand::Type::k_loadMesh:
                             LoadMesh(static_cast<const ChilliSource::LoadMeshRenderCommand*>(renderCommand));
@@ -212,6 +216,9 @@ namespace CSBackend
                         case ChilliSource::RenderCommand::Type::k_renderInstance:
                             RenderInstance(static_cast<const ChilliSource::RenderInstanceRenderCommand*>(renderCommand));
                             break;
+                        case ChilliSource::RenderCommand::Type::k_renderInstances:
+                            RenderInstances(static_cast<const ChilliSource::RenderInstancesRenderCommand*>(renderCommand));
+                            break;
                         case ChilliSource::RenderCommand::Type::k_end:
                             End();
                             break;
@@ -225,7 +232,7 @@ namespace CSBackend
                             UnloadCubemap(static_cast<const ChilliSource::UnloadCubemapRenderCommand*>(renderCommand));
                             break;
                         case ChilliSource::RenderCommand::Type::k_unloadMaterialGroup:
-                            // Do nothing in OpenGL 2.0 / ES 2.0
+                            UnloadMaterialGroup(static_cast<const ChilliSource::UnloadMaterialGroupRenderCommand*>(renderCommand));
                             break;
                         case ChilliSource::RenderCommand::Type::k_unloadMesh:
                             UnloadMesh(static_cast<const ChilliSource::UnloadMeshRenderCommand*>(renderCommand));
@@ -239,6 +246,9 @@ namespace CSBackend
                     }
                 }
             }
+            
+            m_frameStats.m_numStateChangesIssued = m_glStateCache->GetNumIssued();
+            m_frameStats.m_numStateChangesElided = m_glStateCache->GetNumElided();
         }
         
         //------------------------------------------------------------------------------
@@ -248,6 +258,16 @@ namespace CSBackend
             {
                 m_glDynamicMesh->Invalidate();
             }
+            
+            if(m_glInstanceBuffer)
+            {
+                m_glInstanceBuffer->Invalidate();
+            }
+            
+            if(m_glStateCache)
+            {
+                m_glStateCache->Reset();
+            }
         }
         
         //------------------------------------------------------------------------------
@@ -257,14 +277,23 @@ namespace CSBackend
             
             m_glDynamicMesh.reset();
             m_glDynamicMesh = GLDynamicMeshUPtr(new GLDynamicMesh(ChilliSource::RenderDynamicMesh::k_maxVertexDataSize, ChilliSource::RenderDynamicMesh::k_maxIndexDataSize));
+            
+            m_glInstanceBuffer.reset();
+            m_glInstanceBuffer = GLInstanceBufferUPtr(new GLInstanceBuffer());
         }
         
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::Init() noexcept
         {
             GLExtensions::InitExtensions();
-            m_textureUnitManager = GLTextureUnitManagerUPtr(new GLTextureUnitManager());
+            
+            auto renderCapabilities = ChilliSource::Application::Get()->GetSystem<ChilliSource::RenderCapabilities>();
+            m_isInstancingSupported = renderCapabilities->IsInstancingSupported();
+            
+            m_glStateCache = GLStateCacheUPtr(new GLStateCache(renderCapabilities->GetNumTextureUnits(), renderCapabilities->GetNumVertexAttributes()));
+            m_textureUnitManager = GLTextureUnitManagerUPtr(new GLTextureUnitManager(m_glStateCache.get()));
             m_glDynamicMesh = GLDynamicMeshUPtr(new GLDynamicMesh(ChilliSource::RenderDynamicMesh::k_maxVertexDataSize, ChilliSource::RenderDynamicMesh::k_maxIndexDataSize));
+            m_glInstanceBuffer = GLInstanceBufferUPtr(new GLInstanceBuffer());
             
             ResetCache();
         }
@@ -308,6 +337,20 @@ namespace CSBackend
             renderTexture->SetExtraData(glCubemap);
         }
         
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::LoadMaterialGroup(const ChilliSource::LoadMaterialGroupRenderCommand* renderCommand) noexcept
+        {
+            auto renderMaterialGroup = renderCommand->GetRenderMaterialGroup();
+            
+            for (auto renderMaterial : renderMaterialGroup->GetRenderMaterials())
+            {
+                //TODO: Should be pooled.
+                auto glMaterialBinding = new GLMaterialBinding(renderMaterial);
+                
+                renderMaterial->SetExtraData(glMaterialBinding);
+            }
+        }
+        
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::LoadMesh(const ChilliSource::LoadMeshRenderCommand* renderCommand) noexcept
         {
@@ -392,12 +435,12 @@ namespace CSBackend
             GLKView* glView = (GLKView*)[CSAppDelegate sharedInstance].viewController.view;
             [glView bindDrawable];
 #else
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glViewport(0, 0, renderCommand->GetResolution().x, renderCommand->GetResolution().y);
+            m_glStateCache->BindFramebuffer(0);
+            m_glStateCache->SetViewport(0, 0, renderCommand->GetResolution().x, renderCommand->GetResolution().y);
 #endif
             
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-            glDepthMask(GL_TRUE);
+            m_glStateCache->SetColourMask(true);
+            m_glStateCache->SetDepthMask(true);
             
             glClearColor(renderCommand->GetClearColour().r, renderCommand->GetClearColour().g, renderCommand->GetClearColour().b, renderCommand->GetClearColour().a);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
@@ -418,12 +461,12 @@ namespace CSBackend
             auto glTargetGroup = static_cast<GLTargetGroup*>(m_currentRenderTargetGroup->GetExtraData());
             CS_ASSERT(glTargetGroup, "Cannot render with a render target group which hasn't been loaded.");
             
-            glTargetGroup->Bind();
+            glTargetGroup->Bind(m_glStateCache.get());
             
-            glViewport(0, 0, m_currentRenderTargetGroup->GetResolution().x, m_currentRenderTargetGroup->GetResolution().y);
+            m_glStateCache->SetViewport(0, 0, m_currentRenderTargetGroup->GetResolution().x, m_currentRenderTargetGroup->GetResolution().y);
             
-            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-            glDepthMask(GL_TRUE);
+            m_glStateCache->SetColourMask(true);
+            m_glStateCache->SetDepthMask(true);
             
             glClearColor(renderCommand->GetClearColour().r, renderCommand->GetClearColour().g, renderCommand->GetClearColour().b, renderCommand->GetClearColour().a);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
@@ -482,7 +525,7 @@ namespace CSBackend
                     
                     m_currentShader = renderShader;
                     
-                    glShader->Bind();
+                    glShader->Bind(m_glStateCache.get());
                 }
                 
                 m_textureUnitManager->Bind(GL_TEXTURE_2D, m_currentMaterial->GetRenderTextures2D(), 0u);
@@ -490,7 +533,7 @@ namespace CSBackend
                 
                 m_currentCamera.Apply(glShader);
                 
-                GLMaterial::Apply(renderMaterial, glShader);
+                GLMaterial::Apply(renderMaterial, glShader, m_glStateCache.get());
                 
                 if (m_currentLight)
                 {
@@ -515,7 +558,7 @@ namespace CSBackend
                 
                 auto glMesh = static_cast<GLMesh*>(m_currentMesh->GetExtraData());
                 auto glShader = static_cast<GLShader*>(m_currentShader->GetExtraData());
-                glMesh->Bind(glShader);
+                glMesh->Bind(glShader, m_glStateCache.get());
             }
         }
         
@@ -544,7 +587,7 @@ namespace CSBackend
                 auto indexData = m_currentDynamicMesh->GetIndexData();
                 auto indexDataSize = m_currentDynamicMesh->GetIndexDataSize();
                 
-                m_glDynamicMesh->Bind(glShader, polygonType, vertexFormat, indexFormat, numVertices, numIndices, vertexData, vertexDataSize, indexData, indexDataSize);
+                m_glDynamicMesh->Bind(glShader, m_glStateCache.get(), polygonType, vertexFormat, indexFormat, numVertices, numIndices, vertexData, vertexDataSize, indexData, indexDataSize);
             }
         }
         
@@ -566,11 +609,12 @@ namespace CSBackend
             auto indexFormat = renderMeshBatch->GetIndexFormat();
             auto numVertices = renderMeshBatch->GetNumVertices();
             auto numIndices = renderMeshBatch->GetNumIndices();
+            auto vertexData = renderMeshBatch->GetVertexData();
             auto vertexDataSize = renderMeshBatch->GetVertexDataSize();
+            auto indexData = renderMeshBatch->GetIndexData();
             auto indexDataSize = renderMeshBatch->GetIndexDataSize();
-            const auto& meshes = renderMeshBatch->GetMeshes();
             
-            m_glDynamicMesh->Bind(glShader, polygonType, vertexFormat, indexFormat, numVertices, numIndices, vertexDataSize, indexDataSize, meshes);
+            m_glDynamicMesh->Bind(glShader, m_glStateCache.get(), polygonType, vertexFormat, indexFormat, numVertices, numIndices, vertexData, vertexDataSize, indexData, indexDataSize);
         }
         
         //------------------------------------------------------------------------------
@@ -597,21 +641,11 @@ namespace CSBackend
             CS_ASSERT(m_currentShader, "A shader must be applied before rendering a mesh.");
             
             auto glShader = static_cast<GLShader*>(m_currentShader->GetExtraData());
-            glShader->SetUniform(k_uniformWorldMat, renderCommand->GetWorldMatrix(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformViewMat, m_currentCamera.GetViewMatrix(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformWVPMat, renderCommand->GetWorldMatrix() * m_currentCamera.GetViewProjectionMatrix(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformNormalMat, ChilliSource::Matrix4::Transpose(ChilliSource::Matrix4::Inverse(renderCommand->GetWorldMatrix())), GLShader::FailurePolicy::k_silent);
+            ApplyInstanceWorldMatrix(glShader, renderCommand->GetWorldMatrix());
             
             if (m_currentMesh)
             {
-                if (m_currentMesh->GetNumIndices() > 0)
-                {
-                    glDrawElements(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumIndices(), ToGLIndexType(m_currentMesh->GetIndexFormat()), 0);
-                }
-                else
-                {
-                    glDrawArrays(ToGLPolygonType(m_currentMesh->GetPolygonType()), 0, m_currentMesh->GetNumVertices());
-                }
+                DrawMesh();
             }
             else
             {
@@ -630,6 +664,45 @@ namespace CSBackend
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while rendering an instance.");
         }
         
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::RenderInstances(const ChilliSource::RenderInstancesRenderCommand* renderCommand) noexcept
+        {
+            CS_ASSERT(m_currentMaterial, "A material must be applied before rendering a mesh.");
+            CS_ASSERT(m_currentShader, "A shader must be applied before rendering a mesh.");
+            CS_ASSERT(m_currentMesh, "Only static meshes can be rendered as instances.");
+            
+            auto glShader = static_cast<GLShader*>(m_currentShader->GetExtraData());
+            
+            if (m_isInstancingSupported && glShader->GetInstanceWorldMatrixAttributeHandle() >= 0)
+            {
+                glShader->SetUniform(GLShader::Uniform::k_viewMat, m_currentCamera.GetViewMatrix());
+                glShader->SetUniform(GLShader::Uniform::k_viewProjMat, m_currentCamera.GetViewProjectionMatrix());
+                
+                m_glInstanceBuffer->Bind(glShader, m_glStateCache.get(), renderCommand->GetWorldMatrices(), renderCommand->GetNumInstances());
+                
+                if (m_currentMesh->GetNumIndices() > 0)
+                {
+                    glDrawElementsInstancedARB(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumIndices(), ToGLIndexType(m_currentMesh->GetIndexFormat()), 0, renderCommand->GetNumInstances());
+                }
+                else
+                {
+                    glDrawArraysInstancedARB(ToGLPolygonType(m_currentMesh->GetPolygonType()), 0, m_currentMesh->GetNumVertices(), renderCommand->GetNumInstances());
+                }
+                
+                m_glInstanceBuffer->Unbind(glShader, m_glStateCache.get());
+            }
+            else
+            {
+                for (u32 i = 0; i < renderCommand->GetNumInstances(); ++i)
+                {
+                    ApplyInstanceWorldMatrix(glShader, renderCommand->GetWorldMatrices()[i]);
+                    DrawMesh();
+                }
+            }
+            
+            CS_ASSERT_NOGLERROR("An OpenGL error occurred while rendering instances.");
+        }
+        
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::End() noexcept
         {
@@ -686,6 +759,22 @@ namespace CSBackend
             CS_SAFEDELETE(glCubemap);
         }
         
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::UnloadMaterialGroup(const ChilliSource::UnloadMaterialGroupRenderCommand* renderCommand) noexcept
+        {
+            ResetCache();
+            
+            auto renderMaterialGroup = renderCommand->GetRenderMaterialGroup();
+            
+            for (auto renderMaterial : renderMaterialGroup->GetRenderMaterials())
+            {
+                auto glMaterialBinding = static_cast<GLMaterialBinding*>(renderMaterial->GetExtraData());
+                
+                CS_SAFEDELETE(glMaterialBinding);
+                renderMaterial->SetExtraData(nullptr);
+            }
+        }
+        
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::UnloadMesh(const ChilliSource::UnloadMeshRenderCommand* renderCommand) noexcept
         {
@@ -708,9 +797,42 @@ namespace CSBackend
             CS_SAFEDELETE(glTargetGroup);
         }
         
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::ApplyInstanceWorldMatrix(GLShader* glShader, const ChilliSource::Matrix4& worldMatrix) noexcept
+        {
+            glShader->SetUniform(GLShader::Uniform::k_worldMat, worldMatrix);
+            glShader->SetUniform(GLShader::Uniform::k_viewMat, m_currentCamera.GetViewMatrix());
+            glShader->SetUniform(GLShader::Uniform::k_viewProjMat, m_currentCamera.GetViewProjectionMatrix());
+            glShader->SetUniform(GLShader::Uniform::k_wvpMat, worldMatrix * m_currentCamera.GetViewProjectionMatrix());
+            glShader->SetUniform(GLShader::Uniform::k_normalMat, ChilliSource::Matrix4::Transpose(ChilliSource::Matrix4::Inverse(worldMatrix)));
+            
+            GLint attribHandle = glShader->GetInstanceWorldMatrixAttributeHandle();
+            if (attribHandle >= 0)
+            {
+                for (u32 i = 0; i < 4; ++i)
+                {
+                    glVertexAttrib4fv(GLuint(attribHandle) + i, worldMatrix.m + i * 4);
+                }
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void RenderCommandProcessor::DrawMesh() noexcept
+        {
+            if (m_currentMesh->GetNumIndices() > 0)
+            {
+                glDrawElements(ToGLPolygonType(m_currentMesh->GetPolygonType()), m_currentMesh->GetNumIndices(), ToGLIndexType(m_currentMesh->GetIndexFormat()), 0);
+            }
+            else
+            {
+                glDrawArrays(ToGLPolygonType(m_currentMesh->GetPolygonType()), 0, m_currentMesh->GetNumVertices());
+            }
+        }
+        
         //------------------------------------------------------------------------------
         void RenderCommandProcessor::ResetCache() noexcept
         {
+            m_glStateCache->Reset();
             m_textureUnitManager->Reset();
             m_currentCamera = GLCamera();
             m_currentLight.reset();
@@ -729,6 +851,7 @@ namespace CSBackend
             // However, if this is called the context is about to be lost anyway so it doesn't need to be
             // cleaned up, so we can just invalidate it.
             m_glDynamicMesh->Invalidate();
+            m_glInstanceBuffer->Invalidate();
         }
     }
 }
@@ -27,9 +27,11 @@
 
 #include <CSBackend/Rendering/OpenGL/ForwardDeclarations.h>
 
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
 #include <CSBackend/Rendering/OpenGL/Camera/GLCamera.h>
 #include <CSBackend/Rendering/OpenGL/Lighting/GLLight.h>
 #include <CSBackend/Rendering/OpenGL/Model/GLDynamicMesh.h>
+#include <CSBackend/Rendering/OpenGL/Model/GLInstanceBuffer.h>
 #include <CSBackend/Rendering/OpenGL/Texture/GLTextureUnitManager.h>
 
 #include <ChilliSource/ChilliSource.h>
@@ -57,6 +59,11 @@ namespace CSBackend
             ///
             void Process(const ChilliSource::RenderCommandBuffer* renderCommandBuffer) noexcept override;
             
+            /// @return The statistics gathered while processing the most recent render command
+            ///     buffer.
+            ///
+            ChilliSource::RenderFrameStats GetFrameStats() const noexcept override { return m_frameStats; }
+            
             /// Called when the GL context is lost, iterate any GL resources and place
             /// them in an invalid state
             ///
@@ -95,6 +102,14 @@ namespace CSBackend
             ///
             void LoadCubemap(const ChilliSource::LoadCubemapRenderCommand* renderCommand) noexcept;
             
+            /// Creates the material bindings for each material in the group described by the given
+            /// load command.
+            ///
+            /// @param renderCommand
+            ///     The render command
+            ///
+            void LoadMaterialGroup(const ChilliSource::LoadMaterialGroupRenderCommand* renderCommand) noexcept;
+            
             /// Loads the mesh described by the given load command
             ///
             /// @param renderCommand
@@ -233,6 +248,17 @@ namespace CSBackend
             ///
             void RenderInstance(const ChilliSource::RenderInstanceRenderCommand* renderCommand) noexcept;
             
+            /// Renders multiple instances of the static mesh described by the current OpenGL context
+            /// state. A camera, material and mesh must all currently be appled to the context. If
+            /// instancing is supported and the current shader has an instance world matrix attribute
+            /// this is performed with a single instanced draw call, otherwise each instance is drawn
+            /// individually.
+            ///
+            /// @param renderCommand
+            ///     The render command
+            ///
+            void RenderInstances(const ChilliSource::RenderInstancesRenderCommand* renderCommand) noexcept;
+            
             /// Ends rendering to the current render target.
             ///
             void End() noexcept;
@@ -258,6 +284,14 @@ namespace CSBackend
             ///
             void UnloadCubemap(const ChilliSource::UnloadCubemapRenderCommand* renderCommand) noexcept;
             
+            /// Destroys the material bindings for each material in the group described by the given
+            /// unload command.
+            ///
+            /// @param renderCommand
+            ///     The render command
+            ///
+            void UnloadMaterialGroup(const ChilliSource::UnloadMaterialGroupRenderCommand* renderCommand) noexcept;
+            
             /// Unloads the mesh described by the given unload command
             ///
             /// @param renderCommand
@@ -272,14 +306,33 @@ namespace CSBackend
             ///
             void UnloadTargetGroup(const ChilliSource::UnloadTargetGroupRenderCommand* renderCommand) noexcept;
             
+            /// Sets the per-instance uniforms for an individually drawn instance with the given world
+            /// matrix. If the shader has an instance world matrix attribute, its constant value is
+            /// also set so that instancing shaders can be used for non-instanced draws.
+            ///
+            /// @param glShader
+            ///     The currently bound shader.
+            /// @param worldMatrix
+            ///     The world matrix of the instance.
+            ///
+            void ApplyInstanceWorldMatrix(GLShader* glShader, const ChilliSource::Matrix4& worldMatrix) noexcept;
+            
+            /// Draws the currently applied static mesh once.
+            ///
+            void DrawMesh() noexcept;
+            
             /// Resets the cached values back to thier original state.
             ///
             void ResetCache() noexcept;
             
             bool m_initRequired = true;
+            ChilliSource::RenderFrameStats m_frameStats;
             
+            GLStateCacheUPtr m_glStateCache;
             GLTextureUnitManagerUPtr m_textureUnitManager;
             GLDynamicMeshUPtr m_glDynamicMesh;
+            GLInstanceBufferUPtr m_glInstanceBuffer;
+            bool m_isInstancingSupported = false;
             
             GLCamera m_currentCamera;
             GLLightUPtr m_currentLight;
@@ -53,6 +53,7 @@ namespace CSBackend
             bool areHighPrecFragmentsSupported = true;
             bool areMapBuffersSupported = true;
             bool areVAOsSupported = true;
+            bool isInstancingSupported = false;
             bool areDepthTexturesSupported = false;
             bool areShadowMapsSupported = false;
             
@@ -81,13 +82,20 @@ namespace CSBackend
             areDepthTexturesSupported = CheckForOpenGLExtension("GL_OES_depth_texture");
 #endif
             areShadowMapsSupported = (areDepthTexturesSupported && areHighPrecFragmentsSupported);
+            
+#ifdef CS_OPENGLVERSION_STANDARD
+            isInstancingSupported = CheckForOpenGLExtension("GL_ARB_instanced_arrays") && CheckForOpenGLExtension("GL_ARB_draw_instanced");
+#elif defined(CS_OPENGLVERSION_ES)
+            isInstancingSupported = CheckForOpenGLExtension("GL_EXT_instanced_arrays") && CheckForOpenGLExtension("GL_EXT_draw_instanced");
+#endif
+            
             glGetIntegerv(GL_MAX_TEXTURE_SIZE, (GLint*)&maxTextureSize);
             glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, (GLint*)&maxTextureUnits);
             glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, (GLint*)&maxVertexAttribs);
             
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while getting render capabilities.");
             
-            ChilliSource::RenderInfo renderInfo(areShadowMapsSupported, areDepthTexturesSupported, areMapBuffersSupported, areVAOsSupported, areHighPrecFragmentsSupported, maxTextureSize, maxTextureUnits, maxVertexAttribs);
+            ChilliSource::RenderInfo renderInfo(areShadowMapsSupported, areDepthTexturesSupported, areMapBuffersSupported, areVAOsSupported, isInstancingSupported, areHighPrecFragmentsSupported, maxTextureSize, maxTextureUnits, maxVertexAttribs);
             
             return renderInfo;
         }
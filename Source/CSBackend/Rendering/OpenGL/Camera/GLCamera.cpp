@@ -30,11 +30,6 @@ namespace CSBackend
 {
     namespace OpenGL
     {
-        namespace
-        {
-            const std::string k_uniformCameraPos = "u_cameraPos";
-        }
-        
         //------------------------------------------------------------------------------
         GLCamera::GLCamera(const ChilliSource::Vector3& position, const ChilliSource::Matrix4& viewMatrix, const ChilliSource::Matrix4& viewProjectionMatrix) noexcept
             : m_position(position), m_viewMatrix(viewMatrix), m_viewProjectionMatrix(viewProjectionMatrix)
@@ -44,7 +39,7 @@ namespace CSBackend
         //------------------------------------------------------------------------------
         void GLCamera::Apply(GLShader* glShader) const noexcept
         {
-            glShader->SetUniform(k_uniformCameraPos, m_position, GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(GLShader::Uniform::k_cameraPos, m_position);
         }
     }
 }
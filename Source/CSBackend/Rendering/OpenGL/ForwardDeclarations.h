@@ -42,6 +42,7 @@ namespace CSBackend
         //----------------------------------------------------
         CS_FORWARDDECLARE_CLASS(ContextState);
         CS_FORWARDDECLARE_CLASS(GLContextRestorer);
+        CS_FORWARDDECLARE_CLASS(GLStateCache);
 
         CS_FORWARDDECLARE_CLASS(RenderCapabilities);
         CS_FORWARDDECLARE_CLASS(RenderCommandProcessor);
@@ -57,10 +58,15 @@ namespace CSBackend
         CS_FORWARDDECLARE_CLASS(GLLight);
         CS_FORWARDDECLARE_CLASS(GLPointLight);
         //----------------------------------------------------
+        /// Material
+        //----------------------------------------------------
+        CS_FORWARDDECLARE_CLASS(GLMaterialBinding);
+        //----------------------------------------------------
         /// Model
         //----------------------------------------------------
         CS_FORWARDDECLARE_CLASS(GLMesh);
         CS_FORWARDDECLARE_CLASS(GLDynamicMesh);
+        CS_FORWARDDECLARE_CLASS(GLInstanceBuffer);
         //----------------------------------------------------
         /// Shader
         //----------------------------------------------------
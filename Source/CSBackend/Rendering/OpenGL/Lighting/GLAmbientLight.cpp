@@ -30,11 +30,6 @@ namespace CSBackend
 {
     namespace OpenGL
     {
-        namespace
-        {
-            const std::string k_uniformLightCol = "u_lightCol";
-        }
-        
         //------------------------------------------------------------------------------
         GLAmbientLight::GLAmbientLight(const ChilliSource::Colour& colour) noexcept
             : m_colour(colour)
@@ -44,7 +39,7 @@ namespace CSBackend
         //------------------------------------------------------------------------------
         void GLAmbientLight::Apply(GLShader* glShader, GLTextureUnitManager* glTextureUnitManager) const noexcept
         {
-            glShader->SetUniform(k_uniformLightCol, m_colour, GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(GLShader::Uniform::k_lightCol, m_colour);
         }
     }
 }
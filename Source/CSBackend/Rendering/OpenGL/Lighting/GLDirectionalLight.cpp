@@ -31,15 +31,6 @@ namespace CSBackend
 {
     namespace OpenGL
     {
-        namespace
-        {
-            const std::string k_uniformLightCol = "u_lightCol";
-            const std::string k_uniformLightDir = "u_lightDir";
-            const std::string k_uniformShadowMap = "u_shadowMap";
-            const std::string k_uniformShadowTolerance = "u_shadowTolerance";
-            const std::string k_uniformLightMat = "u_lightMat";
-        }
-        
         //------------------------------------------------------------------------------
         GLDirectionalLight::GLDirectionalLight(const ChilliSource::Colour& colour, const ChilliSource::Vector3& direction, const ChilliSource::Matrix4& lightViewProjection, f32 shadowTolerance,
                                                const ChilliSource::RenderTexture* shadowMapRenderTexture) noexcept
@@ -50,16 +41,16 @@ namespace CSBackend
         //------------------------------------------------------------------------------
         void GLDirectionalLight::Apply(GLShader* glShader, GLTextureUnitManager* glTextureUnitManager) const noexcept
         {
-            glShader->SetUniform(k_uniformLightCol, m_colour, GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformLightDir, m_direction, GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(GLShader::Uniform::k_lightCol, m_colour);
+            glShader->SetUniform(GLShader::Uniform::k_lightDir, m_direction);
             
             if (m_shadowMapRenderTexture)
             {
                 auto texUnit = glTextureUnitManager->BindAdditional(GL_TEXTURE_2D, m_shadowMapRenderTexture);
                 
-                glShader->SetUniform(k_uniformShadowMap, s32(texUnit), GLShader::FailurePolicy::k_silent);
-                glShader->SetUniform(k_uniformShadowTolerance, m_shadowTolerance, GLShader::FailurePolicy::k_silent);
-                glShader->SetUniform(k_uniformLightMat, m_lightViewProjection, GLShader::FailurePolicy::k_silent);
+                glShader->SetUniform(GLShader::Uniform::k_shadowMap, s32(texUnit));
+                glShader->SetUniform(GLShader::Uniform::k_shadowTolerance, m_shadowTolerance);
+                glShader->SetUniform(GLShader::Uniform::k_lightMat, m_lightViewProjection);
             }
         }
     }
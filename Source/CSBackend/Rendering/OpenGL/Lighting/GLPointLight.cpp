@@ -30,15 +30,6 @@ namespace CSBackend
 {
     namespace OpenGL
     {
-        namespace
-        {
-            const std::string k_uniformLightCol = "u_lightCol";
-            const std::string k_uniformLightPos = "u_lightPos";
-            const std::string k_uniformAttenuationConstant = "u_attenuationConstant";
-            const std::string k_uniformAttenuationLinear = "u_attenuationLinear";
-            const std::string k_uniformAttenuationQuadratic = "u_attenuationQuadratic";
-        }
-        
         //------------------------------------------------------------------------------
         GLPointLight::GLPointLight(const ChilliSource::Colour& colour, const ChilliSource::Vector3& position, const ChilliSource::Vector3& attenuation) noexcept
             : m_colour(colour), m_position(position), m_attenuation(attenuation)
@@ -48,11 +39,11 @@ namespace CSBackend
         //------------------------------------------------------------------------------
         void GLPointLight::Apply(GLShader* glShader, GLTextureUnitManager* glTextureUnitManager) const noexcept
         {
-            glShader->SetUniform(k_uniformLightCol, m_colour, GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformLightPos, m_position, GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformAttenuationConstant, m_attenuation.x, GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformAttenuationLinear, m_attenuation.y, GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformAttenuationQuadratic, m_attenuation.z, GLShader::FailurePolicy::k_silent);
+            glShader->SetUniform(GLShader::Uniform::k_lightCol, m_colour);
+            glShader->SetUniform(GLShader::Uniform::k_lightPos, m_position);
+            glShader->SetUniform(GLShader::Uniform::k_attenuationConstant, m_attenuation.x);
+            glShader->SetUniform(GLShader::Uniform::k_attenuationLinear, m_attenuation.y);
+            glShader->SetUniform(GLShader::Uniform::k_attenuationQuadratic, m_attenuation.z);
         }
     }
 }
@@ -24,7 +24,9 @@
 
 #include <CSBackend/Rendering/OpenGL/Material/GLMaterial.h>
 
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
 #include <CSBackend/Rendering/OpenGL/Camera/GLCamera.h>
+#include <CSBackend/Rendering/OpenGL/Material/GLMaterialBinding.h>
 #include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
 
 #include <ChilliSource/Core/Base/Colour.h>
@@ -40,13 +42,6 @@ namespace CSBackend
     {
         namespace
         {
-            const std::string k_uniformEmissive = "u_emissive";
-            const std::string k_uniformAmbient = "u_ambient";
-            const std::string k_uniformDiffuse = "u_diffuse";
-            const std::string k_uniformSpecular = "u_specular";
-            const std::string k_uniformTexturePrefix = "u_texture";
-            const std::string k_uniformCubemapPrefix = "u_cubemap";
-            
             /// Converts from a ChilliSource blend mode to an OpenGL blend mode.
             ///
             /// @param blendMode
@@ -170,120 +165,43 @@ namespace CSBackend
 						return GL_BACK;
                 }
             }
-            
-            /// Applies the given batch of custom shader variables to the given shader. If
-            /// any of the variables do not exist in the shader, this will assert.
-            ///
-            /// @param renderShaderVariables
-            ///     The shader variables to apply.
-            /// @param glShader
-            ///     The shader to apply the variables to.
-            ///
-            void ApplyCustomShaderVariables(const ChilliSource::RenderShaderVariables* renderShaderVariables, GLShader* glShader) noexcept
-            {
-                CS_ASSERT(renderShaderVariables, "Cannot apply null shader variables.");
-                CS_ASSERT(glShader, "Cannot apply shader variables to null shader.");
-                
-                for (const auto& pair : renderShaderVariables->GetFloatVariables())
-                {
-                    glShader->SetUniform(pair.first, pair.second);
-                }
-                
-                for (const auto& pair : renderShaderVariables->GetVector2Variables())
-                {
-                    glShader->SetUniform(pair.first, pair.second);
-                }
-                
-                for (const auto& pair : renderShaderVariables->GetVector3Variables())
-                {
-                    glShader->SetUniform(pair.first, pair.second);
-                }
-                
-                for (const auto& pair : renderShaderVariables->GetVector4Variables())
-                {
-                    glShader->SetUniform(pair.first, pair.second);
-                }
-                
-                for (const auto& pair : renderShaderVariables->GetMatrix4Variables())
-                {
-                    glShader->SetUniform(pair.first, pair.second);
-                }
-                
-                for (const auto& pair : renderShaderVariables->GetColourVariables())
-                {
-                    glShader->SetUniform(pair.first, pair.second);
-                }
-            }
         }
         
         //------------------------------------------------------------------------------
-        void GLMaterial::Apply(const ChilliSource::RenderMaterial* renderMaterial, GLShader* glShader) noexcept
+        void GLMaterial::Apply(const ChilliSource::RenderMaterial* renderMaterial, GLShader* glShader, GLStateCache* glStateCache) noexcept
         {
-            renderMaterial->IsDepthWriteEnabled() ? glDepthMask(GL_TRUE) : glDepthMask(GL_FALSE);
-            renderMaterial->IsColourWriteEnabled() ? glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE) : glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            glStateCache->SetDepthMask(renderMaterial->IsDepthWriteEnabled());
+            glStateCache->SetColourMask(renderMaterial->IsColourWriteEnabled());
 
+            glStateCache->SetCapabilityEnabled(GL_DEPTH_TEST, renderMaterial->IsDepthTestEnabled());
             if(renderMaterial->IsDepthTestEnabled())
             {
-                glEnable(GL_DEPTH_TEST);
-                glDepthFunc(ToGLTestFunc(renderMaterial->GetDepthTestFunc()));
-            }
-            else
-            {
-                glDisable(GL_DEPTH_TEST);
+                glStateCache->SetDepthFunc(ToGLTestFunc(renderMaterial->GetDepthTestFunc()));
             }
             
+            glStateCache->SetCapabilityEnabled(GL_CULL_FACE, renderMaterial->IsFaceCullingEnabled());
             if (renderMaterial->IsFaceCullingEnabled())
             {
-                glEnable(GL_CULL_FACE);
-                glCullFace(ToGLCullFace(renderMaterial->GetCullFace()));
-            }
-            else
-            {
-                glDisable(GL_CULL_FACE);
+                glStateCache->SetCullFace(ToGLCullFace(renderMaterial->GetCullFace()));
             }
             
+            glStateCache->SetCapabilityEnabled(GL_BLEND, renderMaterial->IsTransparencyEnabled());
             if (renderMaterial->IsTransparencyEnabled())
             {
-                glEnable(GL_BLEND);
-                glBlendFunc(ToGLBlendMode(renderMaterial->GetSourceBlendMode()), ToGLBlendMode(renderMaterial->GetDestinationBlendMode()));
-            }
-            else
-            {
-                glDisable(GL_BLEND);
+                glStateCache->SetBlendFunc(ToGLBlendMode(renderMaterial->GetSourceBlendMode()), ToGLBlendMode(renderMaterial->GetDestinationBlendMode()));
             }
             
+            glStateCache->SetCapabilityEnabled(GL_STENCIL_TEST, renderMaterial->IsStencilTestEnabled());
             if(renderMaterial->IsStencilTestEnabled())
             {
-                glEnable(GL_STENCIL_TEST);
-                glStencilOp(ToGLStencilOp(renderMaterial->GetStencilFailOp()), ToGLStencilOp(renderMaterial->GetStencilDepthFailOp()), ToGLStencilOp(renderMaterial->GetStencilPassOp()));
-                glStencilFunc(ToGLTestFunc(renderMaterial->GetStencilTestFunc()), (GLint)renderMaterial->GetStencilTestFuncRef(), (GLuint)renderMaterial->GetStencilTestFuncMask());
-            }
-            else
-            {
-                glDisable(GL_STENCIL_TEST);
+                glStateCache->SetStencilOp(ToGLStencilOp(renderMaterial->GetStencilFailOp()), ToGLStencilOp(renderMaterial->GetStencilDepthFailOp()), ToGLStencilOp(renderMaterial->GetStencilPassOp()));
+                glStateCache->SetStencilFunc(ToGLTestFunc(renderMaterial->GetStencilTestFunc()), (GLint)renderMaterial->GetStencilTestFuncRef(), (GLuint)renderMaterial->GetStencilTestFuncMask());
             }
             
-            s32 samplerNumber = 0;
+            auto glMaterialBinding = static_cast<GLMaterialBinding*>(renderMaterial->GetExtraData());
+            CS_ASSERT(glMaterialBinding, "Cannot apply a render material which hasn't been loaded.");
             
-            for (std::size_t i = 0; i < renderMaterial->GetRenderTextures2D().size(); ++i, ++samplerNumber)
-            {
-                glShader->SetUniform(k_uniformTexturePrefix + ChilliSource::ToString(i), samplerNumber);
-            }
-            
-            for (std::size_t i = 0; i < renderMaterial->GetRenderTexturesCubemap().size(); ++i, ++samplerNumber)
-            {
-                glShader->SetUniform(k_uniformCubemapPrefix + ChilliSource::ToString(i), samplerNumber);
-            }
-            
-            glShader->SetUniform(k_uniformEmissive, renderMaterial->GetEmissiveColour(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformAmbient, renderMaterial->GetAmbientColour(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformDiffuse, renderMaterial->GetDiffuseColour(), GLShader::FailurePolicy::k_silent);
-            glShader->SetUniform(k_uniformSpecular, renderMaterial->GetSpecularColour(), GLShader::FailurePolicy::k_silent);
-            
-            if (renderMaterial->GetRenderShaderVariables())
-            {
-                ApplyCustomShaderVariables(renderMaterial->GetRenderShaderVariables(), glShader);
-            }
+            glMaterialBinding->Apply(glShader);
         }
     }
 }
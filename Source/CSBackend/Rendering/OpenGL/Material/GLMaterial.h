@@ -44,8 +44,10 @@ namespace CSBackend
             ///     The render material to apply.
             /// @param glShader
             ///     The currently active shader to apply uniforms to.
+            /// @param glStateCache
+            ///     The state cache to change OpenGL state through.
             ///
-            void Apply(const ChilliSource::RenderMaterial* renderMaterial, GLShader* glShader) noexcept;
+            void Apply(const ChilliSource::RenderMaterial* renderMaterial, GLShader* glShader, GLStateCache* glStateCache) noexcept;
         };
     }
 }
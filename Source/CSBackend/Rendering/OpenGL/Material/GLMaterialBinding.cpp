@@ -0,0 +1,154 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <CSBackend/Rendering/OpenGL/Material/GLMaterialBinding.h>
+
+#include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
+
+#include <ChilliSource/Rendering/Material/RenderMaterial.h>
+#include <ChilliSource/Rendering/Shader/RenderShaderVariables.h>
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        namespace
+        {
+            const std::string k_uniformTexturePrefix = "u_texture";
+            const std::string k_uniformCubemapPrefix = "u_cubemap";
+            
+            /// Sets each of the given uniform bindings on the given shader.
+            ///
+            /// @param glShader
+            ///     The shader to apply the uniforms to.
+            /// @param bindings
+            ///     The bindings to apply.
+            ///
+            template <typename TBinding> void ApplyBindings(GLShader* glShader, const std::vector<TBinding>& bindings) noexcept
+            {
+                for (const auto& binding : bindings)
+                {
+                    glShader->SetUniform(binding.m_slot, *binding.m_value);
+                }
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        GLMaterialBinding::GLMaterialBinding(const ChilliSource::RenderMaterial* renderMaterial) noexcept
+            : m_renderMaterial(renderMaterial)
+        {
+            CS_ASSERT(m_renderMaterial, "Cannot bind a null render material.");
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLMaterialBinding::Apply(GLShader* glShader) noexcept
+        {
+            CS_ASSERT(glShader, "Cannot apply a material to a null shader.");
+            
+            if (m_glShaderId != glShader->GetId())
+            {
+                Bind(glShader);
+            }
+            
+            for (const auto& sampler : m_samplers)
+            {
+                glShader->SetUniform(sampler.m_slot, sampler.m_value);
+            }
+            
+            glShader->SetUniform(GLShader::Uniform::k_emissive, m_renderMaterial->GetEmissiveColour());
+            glShader->SetUniform(GLShader::Uniform::k_ambient, m_renderMaterial->GetAmbientColour());
+            glShader->SetUniform(GLShader::Uniform::k_diffuse, m_renderMaterial->GetDiffuseColour());
+            glShader->SetUniform(GLShader::Uniform::k_specular, m_renderMaterial->GetSpecularColour());
+            
+            ApplyBindings(glShader, m_floatVariables);
+            ApplyBindings(glShader, m_vec2Variables);
+            ApplyBindings(glShader, m_vec3Variables);
+            ApplyBindings(glShader, m_vec4Variables);
+            ApplyBindings(glShader, m_mat4Variables);
+            ApplyBindings(glShader, m_colourVariables);
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLMaterialBinding::Bind(GLShader* glShader) noexcept
+        {
+            m_glShaderId = glShader->GetId();
+            
+            m_samplers.clear();
+            m_floatVariables.clear();
+            m_vec2Variables.clear();
+            m_vec3Variables.clear();
+            m_vec4Variables.clear();
+            m_mat4Variables.clear();
+            m_colourVariables.clear();
+            
+            s32 samplerNumber = 0;
+            
+            for (std::size_t i = 0; i < m_renderMaterial->GetRenderTextures2D().size(); ++i, ++samplerNumber)
+            {
+                auto slot = glShader->GetUniformSlot(k_uniformTexturePrefix + ChilliSource::ToString(i));
+                if (slot >= 0)
+                {
+                    m_samplers.push_back(UniformBinding<s32>{ u32(slot), samplerNumber });
+                }
+            }
+            
+            for (std::size_t i = 0; i < m_renderMaterial->GetRenderTexturesCubemap().size(); ++i, ++samplerNumber)
+            {
+                auto slot = glShader->GetUniformSlot(k_uniformCubemapPrefix + ChilliSource::ToString(i));
+                if (slot >= 0)
+                {
+                    m_samplers.push_back(UniformBinding<s32>{ u32(slot), samplerNumber });
+                }
+            }
+            
+            auto renderShaderVariables = m_renderMaterial->GetRenderShaderVariables();
+            if (renderShaderVariables)
+            {
+                BindVariables(glShader, renderShaderVariables->GetFloatVariables(), m_floatVariables);
+                BindVariables(glShader, renderShaderVariables->GetVector2Variables(), m_vec2Variables);
+                BindVariables(glShader, renderShaderVariables->GetVector3Variables(), m_vec3Variables);
+                BindVariables(glShader, renderShaderVariables->GetVector4Variables(), m_vec4Variables);
+                BindVariables(glShader, renderShaderVariables->GetMatrix4Variables(), m_mat4Variables);
+                BindVariables(glShader, renderShaderVariables->GetColourVariables(), m_colourVariables);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        template <typename TValue> void GLMaterialBinding::BindVariables(GLShader* glShader, const std::unordered_map<std::string, TValue>& variables, std::vector<UniformBinding<const TValue*>>& outBindings) noexcept
+        {
+            outBindings.reserve(variables.size());
+            
+            for (const auto& pair : variables)
+            {
+                auto slot = glShader->GetUniformSlot(pair.first);
+                CS_ASSERT(slot >= 0, "Cannot find shader uniform: " + pair.first);
+                
+                if (slot >= 0)
+                {
+                    outBindings.push_back(UniformBinding<const TValue*>{ u32(slot), &pair.second });
+                }
+            }
+        }
+    }
+}
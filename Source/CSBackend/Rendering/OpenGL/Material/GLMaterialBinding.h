@@ -0,0 +1,119 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CSBACKEND_RENDERING_OPENGL_MATERIAL_GLMATERIALBINDING_H_
+#define _CSBACKEND_RENDERING_OPENGL_MATERIAL_GLMATERIALBINDING_H_
+
+#include <CSBackend/Rendering/OpenGL/ForwardDeclarations.h>
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Core/Math/Vector4.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        /// The uniforms which a single render material sets, resolved to slots in the uniform slot
+        /// table of the material's shader. The slots are resolved the first time the material is
+        /// applied, after which applying the material is an indexed loop over the slots, rather
+        /// than building uniform names and looking them up in the shader.
+        ///
+        /// A binding is created for each render material when its material group is loaded, and
+        /// stored in the render material's extra data.
+        ///
+        /// This is not thread-safe and should only be accessed from the render thread.
+        ///
+        class GLMaterialBinding final
+        {
+        public:
+            CS_DECLARE_NOCOPY(GLMaterialBinding);
+            
+            /// Creates a new binding for the given render material. Slots are not resolved until
+            /// the material is first applied, as the shader may not have been loaded yet.
+            ///
+            /// @param renderMaterial
+            ///     The render material. Must outlive the binding.
+            ///
+            GLMaterialBinding(const ChilliSource::RenderMaterial* renderMaterial) noexcept;
+            
+            /// Applies the material's texture samplers, colours and custom shader variables to the
+            /// given shader, resolving their slots if the binding hasn't been used with the shader
+            /// before. The shader must be bound.
+            ///
+            /// @param glShader
+            ///     The currently active shader to apply uniforms to.
+            ///
+            void Apply(GLShader* glShader) noexcept;
+            
+        private:
+            /// A single uniform slot and the value it should be set to.
+            ///
+            template <typename TValue> struct UniformBinding
+            {
+                u32 m_slot;
+                TValue m_value;
+            };
+            
+            /// Resolves the slots of all of the material's texture samplers and custom shader
+            /// variables in the given shader.
+            ///
+            /// @param glShader
+            ///     The shader to resolve slots in.
+            ///
+            void Bind(GLShader* glShader) noexcept;
+            
+            /// Resolves the slots of the given map of custom shader variables. If any of the
+            /// variables do not exist in the shader, this will assert.
+            ///
+            /// @param glShader
+            ///     The shader to resolve slots in.
+            /// @param variables
+            ///     The custom shader variables.
+            /// @param outBindings
+            ///     (Out) The list of bindings to add to.
+            ///
+            template <typename TValue> void BindVariables(GLShader* glShader, const std::unordered_map<std::string, TValue>& variables, std::vector<UniformBinding<const TValue*>>& outBindings) noexcept;
+            
+            const ChilliSource::RenderMaterial* m_renderMaterial;
+            u32 m_glShaderId = 0;
+            
+            std::vector<UniformBinding<s32>> m_samplers;
+            std::vector<UniformBinding<const f32*>> m_floatVariables;
+            std::vector<UniformBinding<const ChilliSource::Vector2*>> m_vec2Variables;
+            std::vector<UniformBinding<const ChilliSource::Vector3*>> m_vec3Variables;
+            std::vector<UniformBinding<const ChilliSource::Vector4*>> m_vec4Variables;
+            std::vector<UniformBinding<const ChilliSource::Matrix4*>> m_mat4Variables;
+            std::vector<UniformBinding<const ChilliSource::Colour*>> m_colourVariables;
+        };
+    }
+}
+
+#endif
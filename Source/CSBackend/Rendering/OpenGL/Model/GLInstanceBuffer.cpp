@@ -0,0 +1,106 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <CSBackend/Rendering/OpenGL/Model/GLInstanceBuffer.h>
+
+#include <CSBackend/Rendering/OpenGL/Base/GLError.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLExtensions.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
+#include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
+
+#include <ChilliSource/Core/Math/Matrix4.h>
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        namespace
+        {
+            /// The number of attributes occupied by a matrix attribute, one per column.
+            ///
+            constexpr u32 k_numMatrixColumns = 4;
+        }
+        
+        //------------------------------------------------------------------------------
+        GLInstanceBuffer::GLInstanceBuffer() noexcept
+        {
+            glGenBuffers(1, &m_bufferHandle);
+            CS_ASSERT(m_bufferHandle != 0, "Invalid instance buffer.");
+            
+            CS_ASSERT_NOGLERROR("An OpenGL error occurred while creating GLInstanceBuffer.");
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLInstanceBuffer::Bind(GLShader* glShader, GLStateCache* glStateCache, const ChilliSource::Matrix4* worldMatrices, u32 numInstances) noexcept
+        {
+            GLint attribHandle = glShader->GetInstanceWorldMatrixAttributeHandle();
+            CS_ASSERT(attribHandle >= 0, "Cannot bind instance buffer to a shader without an instance world matrix attribute.");
+            
+            glStateCache->BindBuffer(GL_ARRAY_BUFFER, m_bufferHandle);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(ChilliSource::Matrix4) * numInstances, worldMatrices, GL_STREAM_DRAW);
+            
+            // Matrices are stored row major and uploaded without transposing, so each row of the
+            // world matrix becomes a column of the shader's matrix attribute.
+            for (u32 i = 0; i < k_numMatrixColumns; ++i)
+            {
+                GLuint columnHandle = GLuint(attribHandle) + i;
+                auto offset = reinterpret_cast<const GLvoid*>(u64(i * k_numMatrixColumns * sizeof(f32)));
+                
+                glStateCache->SetVertexAttribArrayEnabled(columnHandle, true);
+                glVertexAttribPointer(columnHandle, k_numMatrixColumns, GL_FLOAT, GL_FALSE, sizeof(ChilliSource::Matrix4), offset);
+                glVertexAttribDivisorARB(columnHandle, 1);
+            }
+            
+            CS_ASSERT_NOGLERROR("An OpenGL error occurred while binding GLInstanceBuffer.");
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLInstanceBuffer::Unbind(GLShader* glShader, GLStateCache* glStateCache) noexcept
+        {
+            GLint attribHandle = glShader->GetInstanceWorldMatrixAttributeHandle();
+            CS_ASSERT(attribHandle >= 0, "Cannot unbind instance buffer from a shader without an instance world matrix attribute.");
+            
+            for (u32 i = 0; i < k_numMatrixColumns; ++i)
+            {
+                GLuint columnHandle = GLuint(attribHandle) + i;
+                
+                glVertexAttribDivisorARB(columnHandle, 0);
+                glStateCache->SetVertexAttribArrayEnabled(columnHandle, false);
+            }
+            
+            CS_ASSERT_NOGLERROR("An OpenGL error occurred while unbinding GLInstanceBuffer.");
+        }
+        
+        //------------------------------------------------------------------------------
+        GLInstanceBuffer::~GLInstanceBuffer() noexcept
+        {
+            if(!m_invalidData)
+            {
+                glDeleteBuffers(1, &m_bufferHandle);
+                
+                CS_ASSERT_NOGLERROR("An OpenGL error occurred while deleting GLInstanceBuffer.");
+            }
+        }
+    }
+}
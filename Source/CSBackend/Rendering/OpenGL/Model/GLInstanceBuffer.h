@@ -0,0 +1,97 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CSBACKEND_RENDERING_OPENGL_MODEL_GLINSTANCEBUFFER_H_
+#define _CSBACKEND_RENDERING_OPENGL_MODEL_GLINSTANCEBUFFER_H_
+
+#include <CSBackend/Rendering/OpenGL/ForwardDeclarations.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLIncludes.h>
+
+#include <ChilliSource/ChilliSource.h>
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        /// A container for the per-instance data used when rendering multiple instances of a mesh
+        /// in a single instanced draw call. The world matrix of each instance is uploaded to a
+        /// vertex buffer and bound to the instance world matrix attribute of the shader, which is
+        /// advanced once per instance rather than once per vertex.
+        ///
+        /// This should only be used if instancing is supported by the render capabilities.
+        ///
+        /// This is not thread-safe and should only be accessed from the render thread.
+        ///
+        class GLInstanceBuffer final
+        {
+        public:
+            CS_DECLARE_NOCOPY(GLInstanceBuffer);
+            
+            /// Creates a new empty OpenGL instance buffer.
+            ///
+            GLInstanceBuffer() noexcept;
+            
+            /// Uploads the given world matrices and binds them to the instance world matrix attribute
+            /// of the given shader. The mesh should already have been bound. This must be followed
+            /// by a call to Unbind() once the instances have been drawn.
+            ///
+            /// @param glShader
+            ///     The shader to apply attributes to. Must have an instance world matrix attribute.
+            /// @param glStateCache
+            ///     The state cache to change OpenGL state through.
+            /// @param worldMatrices
+            ///     The world matrix of each instance.
+            /// @param numInstances
+            ///     The number of instances.
+            ///
+            void Bind(GLShader* glShader, GLStateCache* glStateCache, const ChilliSource::Matrix4* worldMatrices, u32 numInstances) noexcept;
+            
+            /// Restores the instance world matrix attribute of the given shader to per-vertex and
+            /// disables it, so that subsequent non-instanced draws using the same mesh are unaffected.
+            ///
+            /// @param glShader
+            ///     The shader that was passed to Bind().
+            /// @param glStateCache
+            ///     The state cache to change OpenGL state through.
+            ///
+            void Unbind(GLShader* glShader, GLStateCache* glStateCache) noexcept;
+            
+            /// Called when graphics memory is lost, usually through the GLContext being destroyed
+            /// on Android. Function will set a flag to handle safe destructing of this object, preventing
+            /// us from trying to delete invalid memory.
+            ///
+            void Invalidate() noexcept { m_invalidData = true; }
+            
+            /// Destroys the OpenGL instance buffer that this represents.
+            ///
+            ~GLInstanceBuffer() noexcept;
+            
+        private:
+            GLuint m_bufferHandle = 0;
+            bool m_invalidData = false;
+        };
+    }
+}
+
+#endif
@@ -30,6 +30,7 @@
 
 #include <CSBackend/Rendering/OpenGL/Base/GLExtensions.h>
 #include <CSBackend/Rendering/OpenGL/Base/GLError.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
 #include <CSBackend/Rendering/OpenGL/Model/GLMeshUtils.h>
 #include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
 
@@ -74,7 +75,7 @@ namespace CSBackend
         }
         
         //------------------------------------------------------------------------------
-        void GLMesh::Bind(GLShader* glShader) noexcept
+        void GLMesh::Bind(GLShader* glShader, GLStateCache* glStateCache) noexcept
         {
             if(m_areVAOsSupported == true)
             {
@@ -92,7 +93,7 @@ namespace CSBackend
                 
                 if(vao > 0)
                 {
-                    glBindVertexArray(vao);
+                    glStateCache->BindVertexArray(vao);
                     CS_ASSERT_NOGLERROR("An OpenGL error occurred while binding GLMesh.");
                     return;
                 }
@@ -100,19 +101,16 @@ namespace CSBackend
                 //Otherwise we need to create a VAO
                 GLuint vaoHandle = 0;
                 glGenVertexArrays(1, &vaoHandle);
-                glBindVertexArray(vaoHandle);
+                glStateCache->BindVertexArray(vaoHandle);
                 m_vaoCache.push_back(std::make_pair(glShader, vaoHandle));
             }
             
-            glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferHandle);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferHandle);
+            glStateCache->BindBuffer(GL_ARRAY_BUFFER, m_vertexBufferHandle);
+            glStateCache->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferHandle);
             
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while creating VAO for GLMesh.");
             
-            for (u32 i = 0; i < ChilliSource::VertexFormat::k_maxElements; ++i)
-            {
-                glDisableVertexAttribArray(i);
-            }
+            u32 enabledAttributes = 0;
             
             auto vertexFormat = m_renderMesh->GetVertexFormat();
             for (u32 i = 0; i < vertexFormat.GetNumElements(); ++i)
@@ -123,7 +121,8 @@ namespace CSBackend
                 if(attribHandle < 0)
                     continue;
                 
-                glEnableVertexAttribArray(attribHandle);
+                CS_ASSERT(u32(attribHandle) < GLStateCache::k_maxVertexAttributes, "Vertex attribute handle out of range.");
+                enabledAttributes |= 1u << attribHandle;
                 
                 auto numComponents = ChilliSource::VertexFormat::GetNumComponents(elementType);
                 auto type = GLMeshUtils::GetGLType(ChilliSource::VertexFormat::GetDataType(elementType));
@@ -132,6 +131,8 @@ namespace CSBackend
                 
                 glShader->SetAttribute((u32)elementType, numComponents, type, normalised, vertexFormat.GetSize(), offset);
             }
+            
+            glStateCache->SetEnabledVertexAttribArrays(enabledAttributes);
         }
         
         //------------------------------------------------------------------------------
@@ -67,8 +67,10 @@ namespace CSBackend
             ///
             /// @param glShader
             ///     The shader to apply attributes to.
+            /// @param glStateCache
+            ///     The state cache to change OpenGL state through.
             ///
-            void Bind(GLShader* glShader) noexcept;
+            void Bind(GLShader* glShader, GLStateCache* glStateCache) noexcept;
             
             /// Called when we should restore any cached mesh data.
             ///
@@ -32,15 +32,10 @@ namespace CSBackend
 {
     namespace OpenGL
     {
-        namespace
-        {
-            const std::string k_uniformJoints = "u_joints";
-        }
-        
         //------------------------------------------------------------------------------
         void GLSkinnedAnimation::Apply(const ChilliSource::RenderSkinnedAnimation* renderSkinnedAnimation, GLShader* glShader) noexcept
         {
-            glShader->SetUniform(k_uniformJoints, renderSkinnedAnimation->GetJointData(), renderSkinnedAnimation->GetJointDataSize());
+            glShader->SetUniform(GLShader::Uniform::k_joints, renderSkinnedAnimation->GetJointData(), renderSkinnedAnimation->GetJointDataSize());
         }
     }
 }
@@ -25,8 +25,10 @@
 #include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
 
 #include <CSBackend/Rendering/OpenGL/Base/GLError.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
 
 #include <array>
+#include <cstring>
 
 namespace CSBackend
 {
@@ -91,6 +93,11 @@ namespace CSBackend
                 
                 glAttachShader(programId, vsHandle);
                 glAttachShader(programId, fsHandle);
+                
+                //Some desktop drivers require attribute 0 to be an enabled array, so make sure it is the
+                //position rather than an attribute which may be supplied as a constant, such as the
+                //instance world matrix.
+                glBindAttribLocation(programId, 0, GLShader::k_attributePosition.c_str());
                 glLinkProgram(programId);
                 
                 //Check for success
@@ -119,6 +126,38 @@ namespace CSBackend
             }
         }
         
+        namespace
+        {
+            u32 g_nextShaderId = 1;
+            
+            /// The names of the engine uniforms. This list must be kept in the same order as the
+            /// Uniform enum.
+            ///
+            const std::array<const char*, u32(GLShader::Uniform::k_total)> k_uniformNames =
+            {{
+                "u_wvpMat",
+                "u_worldMat",
+                "u_viewMat",
+                "u_viewProjMat",
+                "u_normalMat",
+                "u_cameraPos",
+                "u_emissive",
+                "u_ambient",
+                "u_diffuse",
+                "u_specular",
+                "u_lightCol",
+                "u_lightPos",
+                "u_lightDir",
+                "u_lightMat",
+                "u_attenuationConstant",
+                "u_attenuationLinear",
+                "u_attenuationQuadratic",
+                "u_shadowMap",
+                "u_shadowTolerance",
+                "u_joints"
+            }};
+        }
+        
         const std::string GLShader::k_attributePosition = "a_position";
         const std::string GLShader::k_attributeNormal = "a_normal";
         const std::string GLShader::k_attributeTangent = "a_tangent";
@@ -127,120 +166,256 @@ namespace CSBackend
         const std::string GLShader::k_attributeColour = "a_colour";
         const std::string GLShader::k_attributeWeights = "a_weights";
         const std::string GLShader::k_attributeJointIndices = "a_jointIndices";
+        const std::string GLShader::k_attributeInstanceWorldMat = "a_instanceWorldMat";
     
         //------------------------------------------------------------------------------
         GLShader::GLShader(const std::string& vertexShader, const std::string& fragmentShader) noexcept
+            : m_id(g_nextShaderId++)
         {
             m_vertexShaderId = CompileShader(vertexShader, GL_VERTEX_SHADER);
             m_fragmentShaderId = CompileShader(fragmentShader, GL_FRAGMENT_SHADER);
             m_programId = CreateProgram(m_vertexShaderId, m_fragmentShaderId);
             
             BuildAttributeHandleMap();
+            BuildUniformSlotTable();
         }
     
         //------------------------------------------------------------------------------
-        void GLShader::Bind() noexcept
+        void GLShader::Bind(GLStateCache* glStateCache) noexcept
         {
-            glUseProgram(m_programId);
+            glStateCache->UseProgram(m_programId);
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while binding shader.");
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, s32 value, FailurePolicy failurePolicy) noexcept
+        s32 GLShader::GetUniformSlot(const std::string& name, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = -1;
+            
+            auto it = m_uniformSlotIndices.find(name);
+            if(it != m_uniformSlotIndices.end())
+            {
+                slot = it->second;
+            }
+            else
+            {
+                GLint uniformHandle = glGetUniformLocation(m_programId, name.c_str());
+                CS_ASSERT_NOGLERROR("An OpenGL error occurred while getting uniform handle.");
+                
+                if(uniformHandle >= 0)
+                {
+                    slot = s32(m_uniformSlots.size());
+                    
+                    UniformSlot uniformSlot;
+                    uniformSlot.m_handle = uniformHandle;
+                    m_uniformSlots.push_back(uniformSlot);
+                }
+                
+                m_uniformSlotIndices.insert(std::make_pair(name, slot));
+            }
+            
+            if (slot < 0 && failurePolicy == FailurePolicy::k_hard)
+            {
+                CS_LOG_FATAL("Cannot find shader uniform: " + name);
+            }
+            
+            return slot;
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(u32 slot, s32 value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniform1i(uniformHandle, value);
+                glUniform1i(uniformSlot.m_handle, value);
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, f32 value, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, f32 value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniform1f(uniformHandle, value);
+                glUniform1f(uniformSlot.m_handle, value);
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector2& value, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, const ChilliSource::Vector2& value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniform2fv(uniformHandle, 1, reinterpret_cast<const GLfloat*>(&value));
+                glUniform2fv(uniformSlot.m_handle, 1, reinterpret_cast<const GLfloat*>(&value));
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector3& value, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, const ChilliSource::Vector3& value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniform3fv(uniformHandle, 1, reinterpret_cast<const GLfloat*>(&value));
+                glUniform3fv(uniformSlot.m_handle, 1, reinterpret_cast<const GLfloat*>(&value));
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector4& value, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, const ChilliSource::Vector4& value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniform4fv(uniformHandle, 1, reinterpret_cast<const GLfloat*>(&value));
+                glUniform4fv(uniformSlot.m_handle, 1, reinterpret_cast<const GLfloat*>(&value));
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, const ChilliSource::Matrix4& value, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, const ChilliSource::Matrix4& value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniformMatrix4fv(uniformHandle, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&value.m));
+                glUniformMatrix4fv(uniformSlot.m_handle, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&value.m));
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, const ChilliSource::Colour& value, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, const ChilliSource::Colour& value) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            const auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0 && UpdateCachedValue(slot, value))
             {
-                glUniform4fv(uniformHandle, 1, reinterpret_cast<const GLfloat*>(&value));
+                glUniform4fv(uniformSlot.m_handle, 1, reinterpret_cast<const GLfloat*>(&value));
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
         //------------------------------------------------------------------------------
-        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector4* values, u32 numValues, FailurePolicy failurePolicy) noexcept
+        void GLShader::SetUniform(u32 slot, const ChilliSource::Vector4* values, u32 numValues) noexcept
         {
-            GLint uniformHandle = GetUniformHandle(name, failurePolicy);
+            CS_ASSERT(slot < m_uniformSlots.size(), "Uniform slot out of bounds.");
             
-            if(uniformHandle >= 0)
+            auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_handle >= 0)
             {
-                glUniform4fv(uniformHandle, numValues, reinterpret_cast<const GLfloat*>(values));
+                uniformSlot.m_hasCachedValue = false;
+                
+                glUniform4fv(uniformSlot.m_handle, numValues, reinterpret_cast<const GLfloat*>(values));
                 CS_ASSERT_NOGLERROR("An OpenGL error occurred while setting uniform.");
             }
         }
         
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, s32 value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, f32 value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector2& value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector3& value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector4& value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, const ChilliSource::Matrix4& value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, const ChilliSource::Colour& value, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), value);
+            }
+        }
+        
+        //------------------------------------------------------------------------------
+        void GLShader::SetUniform(const std::string& name, const ChilliSource::Vector4* values, u32 numValues, FailurePolicy failurePolicy) noexcept
+        {
+            s32 slot = GetUniformSlot(name, failurePolicy);
+            
+            if(slot >= 0)
+            {
+                SetUniform(u32(slot), values, numValues);
+            }
+        }
+        
         //------------------------------------------------------------------------------
         void GLShader::SetAttribute(u32 index, GLint size, GLenum type, GLboolean isNormalised, GLsizei stride, const GLvoid* offset) noexcept
         {
@@ -286,33 +461,42 @@ namespace CSBackend
 				}
             }
             
+            m_instanceWorldMatAttributeHandle = glGetAttribLocation(m_programId, k_attributeInstanceWorldMat.c_str());
+            
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while populating attribute handles.");
         }
         
         //------------------------------------------------------------------------------
-        GLint GLShader::GetUniformHandle(const std::string& name, FailurePolicy failurePolicy) noexcept
+        void GLShader::BuildUniformSlotTable() noexcept
         {
-            GLint uniformHandle = -1;
+            m_uniformSlots.resize(k_uniformNames.size());
             
-            auto it = m_uniformHandles.find(name);
-            if(it != m_uniformHandles.end())
+            for(std::size_t i = 0; i < k_uniformNames.size(); ++i)
             {
-                uniformHandle = it->second;
-            }
-            else
-            {
-                uniformHandle = glGetUniformLocation(m_programId, name.c_str());
-                CS_ASSERT_NOGLERROR("An OpenGL error occurred while getting uniform handle.");
+                GLint uniformHandle = glGetUniformLocation(m_programId, k_uniformNames[i]);
+                m_uniformSlots[i].m_handle = uniformHandle;
                 
-                m_uniformHandles.insert(std::make_pair(name, uniformHandle));
+                // Engine uniforms always occupy their slot, but are looked up by name as missing if not in the shader.
+                m_uniformSlotIndices.insert(std::make_pair(std::string(k_uniformNames[i]), uniformHandle >= 0 ? s32(i) : -1));
             }
-
-            if (uniformHandle < 0 && failurePolicy == FailurePolicy::k_hard)
+            
+            CS_ASSERT_NOGLERROR("An OpenGL error occurred while populating uniform handles.");
+        }
+        
+        //------------------------------------------------------------------------------
+        template <typename TValue> bool GLShader::UpdateCachedValue(u32 slot, const TValue& value) noexcept
+        {
+            static_assert(sizeof(TValue) <= sizeof(UniformSlot::m_cachedValue), "Uniform value is too large to be cached.");
+            
+            auto& uniformSlot = m_uniformSlots[slot];
+            if(uniformSlot.m_hasCachedValue && std::memcmp(uniformSlot.m_cachedValue.data(), &value, sizeof(TValue)) == 0)
             {
-                CS_LOG_FATAL("Cannot find shader uniform: " + name);
+                return false;
             }
             
-            return uniformHandle;
+            std::memcpy(uniformSlot.m_cachedValue.data(), &value, sizeof(TValue));
+            uniformSlot.m_hasCachedValue = true;
+            return true;
         }
         
         //------------------------------------------------------------------------------
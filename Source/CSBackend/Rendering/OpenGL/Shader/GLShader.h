@@ -35,8 +35,9 @@
 #include <ChilliSource/Core/Math/Vector3.h>
 #include <ChilliSource/Core/Math/Vector4.h>
 
-#include <unordered_map>
 #include <array>
+#include <unordered_map>
+#include <vector>
 
 namespace CSBackend
 {
@@ -61,6 +62,7 @@ namespace CSBackend
             static const std::string k_attributeColour;
             static const std::string k_attributeWeights;
             static const std::string k_attributeJointIndices;
+            static const std::string k_attributeInstanceWorldMat;
             
             /// An enum describing the different types of failure policy. This is used when setting
             /// uniforms to judge if an assertion should occur when the uniform doesn't exist.
@@ -71,6 +73,36 @@ namespace CSBackend
                 k_silent
             };
             
+            /// The uniforms which are set by the engine. The handles for these are resolved when the
+            /// shader is linked, and they occupy the first slots in the shader's uniform slot table,
+            /// in this order.
+            ///
+            enum class Uniform
+            {
+                k_wvpMat,
+                k_worldMat,
+                k_viewMat,
+                k_viewProjMat,
+                k_normalMat,
+                k_cameraPos,
+                k_emissive,
+                k_ambient,
+                k_diffuse,
+                k_specular,
+                k_lightCol,
+                k_lightPos,
+                k_lightDir,
+                k_lightMat,
+                k_attenuationConstant,
+                k_attenuationLinear,
+                k_attenuationQuadratic,
+                k_shadowMap,
+                k_shadowTolerance,
+                k_joints,
+                
+                k_total
+            };
+            
             /// Creates and loads a new shader with the given vertex and fragment shader strings.
             ///
             /// @param vertexShader
@@ -80,9 +112,143 @@ namespace CSBackend
             ///
             GLShader(const std::string& vertexShader, const std::string& fragmentShader) noexcept;
             
+            /// @return An id which is unique to this shader for the lifetime of the application. Unlike
+            ///     the shader's address or program id this is never reused, so it can be used to check
+            ///     whether resolved uniform slots still belong to the shader.
+            ///
+            u32 GetId() const noexcept { return m_id; }
+            
             /// Binds the shader such that it is ready for use in rendering.
             ///
-            void Bind() noexcept;
+            /// @param glStateCache
+            ///     The state cache to change OpenGL state through.
+            ///
+            void Bind(GLStateCache* glStateCache) noexcept;
+            
+            /// Looks up the slot of the uniform with the given name. Slots are stable for the lifetime
+            /// of the shader, so this should be called once and the result stored rather than calling
+            /// it each time the uniform is set. If the hard failure policy is specified and there is
+            /// no uniform with the requested name, then this will assert.
+            ///
+            /// @param name
+            ///     The name of the uniform.
+            /// @param failurePolicy
+            ///     The failure policy for if the uniform doesn't exist. Defaults to hard.
+            ///
+            /// @return The slot of the uniform, or -1 if it doesn't exist in the shader.
+            ///
+            s32 GetUniformSlot(const std::string& name, FailurePolicy failurePolicy = FailurePolicy::k_hard) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, s32 value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, f32 value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, const ChilliSource::Vector2& value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, const ChilliSource::Vector3& value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, const ChilliSource::Vector4& value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, const ChilliSource::Matrix4& value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given value. The last value set in each slot
+            /// is cached, so this does nothing if the value is unchanged. Slots which don't exist in
+            /// the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            void SetUniform(u32 slot, const ChilliSource::Colour& value) noexcept;
+            
+            /// Sets the uniform in the given slot to the given array of values. Arrays are not cached
+            /// so this always uploads the values. Slots which don't exist in the shader are ignored.
+            ///
+            /// @param slot
+            ///     The slot of the uniform.
+            /// @param values
+            ///     The values to set the uniform to.
+            /// @param numValues
+            ///     The number of values to set.
+            ///
+            void SetUniform(u32 slot, const ChilliSource::Vector4* values, u32 numValues) noexcept;
+            
+            /// Sets the given engine uniform to the given value. If the uniform doesn't exist in the
+            /// shader then this does nothing.
+            ///
+            /// @param uniform
+            ///     The engine uniform.
+            /// @param value
+            ///     The value to set the uniform to.
+            ///
+            template <typename TValue> void SetUniform(Uniform uniform, const TValue& value) noexcept { SetUniform(u32(uniform), value); }
+            
+            /// Sets the given engine uniform to the given array of values. If the uniform doesn't exist
+            /// in the shader then this does nothing.
+            ///
+            /// @param uniform
+            ///     The engine uniform.
+            /// @param values
+            ///     The values to set the uniform to.
+            /// @param numValues
+            ///     The number of values to set.
+            ///
+            void SetUniform(Uniform uniform, const ChilliSource::Vector4* values, u32 numValues) noexcept { SetUniform(u32(uniform), values, numValues); }
             
             /// Sets the uniform with the given name to the given value. If if the hard failure policy
             /// is specified and there is no uniform with the requested name, then this will assert.
@@ -189,6 +355,15 @@ namespace CSBackend
             ///
             GLint GetAttributeHandle(u32 index) const noexcept { return m_attributeHandles[index]; }
             
+            /// The per-instance world matrix attribute is optional, and is used to render multiple
+            /// instances of a mesh in a single draw call. As a matrix attribute it occupies four
+            /// consecutive attribute handles, one for each column.
+            ///
+            /// @return Handle of the first column of the instance world matrix attribute. -1 if
+            ///     doesn't exist.
+            ///
+            GLint GetInstanceWorldMatrixAttributeHandle() const noexcept { return m_instanceWorldMatAttributeHandle; }
+            
             /// Sets the attribute with the given name and data information. If the attribute doesn't
             /// exist then it will be ignored.
             ///
@@ -218,28 +393,46 @@ namespace CSBackend
             ~GLShader() noexcept;
             
         private:
+            /// An entry in the uniform slot table. This contains the uniform handle and the last
+            /// value which was uploaded to it. Uniform values are stored per program, so the cache
+            /// remains valid while other shaders are bound.
+            ///
+            struct UniformSlot
+            {
+                GLint m_handle = -1;
+                bool m_hasCachedValue = false;
+                std::array<u8, sizeof(ChilliSource::Matrix4)> m_cachedValue;
+            };
+            
             /// Evaulates which attributes exist in the shader and builds a map to their handles.
             ///
             void BuildAttributeHandleMap() noexcept;
             
-            /// Finds the handle of the shader with the given name. Uniform handles are cached. This
-            /// will assert if the uniform doesn't exist and the hard failure policy is specified.
+            /// Resolves the handles of all engine uniforms and adds them to the start of the uniform
+            /// slot table.
             ///
-            /// @param name
-            ///     The name of the uniform.
-            /// @param failurePolicy
-            ///     The failure policy.
+            void BuildUniformSlotTable() noexcept;
+            
+            /// Compares the given value to the cached value in the given slot, updating the cache if
+            /// they differ.
+            ///
+            /// @param slot
+            ///     The slot of the uniform. Must exist in the shader.
+            /// @param value
+            ///     The new value.
             ///
-            /// @return The uniform handle, or -1 if it doesn't exist in the shader and a silent failure
-            ///     policy was requested.
+            /// @return Whether or not the value changed and should be uploaded.
             ///
-            GLint GetUniformHandle(const std::string& name, FailurePolicy failurePolicy) noexcept;
+            template <typename TValue> bool UpdateCachedValue(u32 slot, const TValue& value) noexcept;
             
+            u32 m_id;
             GLuint m_vertexShaderId = 0;
             GLuint m_fragmentShaderId = 0;
             GLuint m_programId = 0;
-            std::unordered_map<std::string, GLint> m_uniformHandles;
+            std::vector<UniformSlot> m_uniformSlots;
+            std::unordered_map<std::string, s32> m_uniformSlotIndices;
             std::array<GLint, k_numAttributes> m_attributeHandles;
+            GLint m_instanceWorldMatAttributeHandle = -1;
             
             bool m_invalidData = false;
         };
@@ -25,6 +25,7 @@
 #include <CSBackend/Rendering/OpenGL/Target/GLTargetGroup.h>
 
 #include <CSBackend/Rendering/OpenGL/Base/GLError.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
 #include <CSBackend/Rendering/OpenGL/Texture/GLTexture.h>
 
 #include <ChilliSource/Rendering/Target/RenderTargetGroup.h>
@@ -121,9 +122,9 @@ namespace CSBackend
         }
         
         //------------------------------------------------------------------------------
-        void GLTargetGroup::Bind() noexcept
+        void GLTargetGroup::Bind(GLStateCache* glStateCache) noexcept
         {
-            glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferHandle);
+            glStateCache->BindFramebuffer(m_frameBufferHandle);
             
              CS_ASSERT_NOGLERROR("An OpenGL error occurred while binding target group.");
         }
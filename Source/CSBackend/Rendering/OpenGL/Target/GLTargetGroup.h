@@ -56,7 +56,10 @@ namespace CSBackend
             
             /// Binds the frame buffer that this target group represents for rendering.
             ///
-            void Bind() noexcept;
+            /// @param glStateCache
+            ///     The state cache to change OpenGL state through.
+            ///
+            void Bind(GLStateCache* glStateCache) noexcept;
             
             /// Called when we should restore the target group.
             ///
@@ -25,6 +25,7 @@
 #include <CSBackend/Rendering/OpenGL/Texture/GLTextureUnitManager.h>
 
 #include <CSBackend/Rendering/OpenGL/Base/GLError.h>
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
 #include <CSBackend/Rendering/OpenGL/Texture/GLCubemap.h>
 #include <CSBackend/Rendering/OpenGL/Texture/GLTexture.h>
 
@@ -37,8 +38,11 @@ namespace CSBackend
     namespace OpenGL
     {
         //------------------------------------------------------------------------------
-        GLTextureUnitManager::GLTextureUnitManager() noexcept
+        GLTextureUnitManager::GLTextureUnitManager(GLStateCache* glStateCache) noexcept
+            : m_glStateCache(glStateCache)
         {
+            CS_ASSERT(m_glStateCache, "Cannot create a texture unit manager with a null state cache.");
+            
             u32 numTextureUnits = CS::Application::Get()->GetSystem<CS::RenderCapabilities>()->GetNumTextureUnits();
  
             m_boundTextures.reserve(numTextureUnits);
@@ -61,8 +65,6 @@ namespace CSBackend
                 {
                     m_boundTextures[textureUnitIndex] = textures[i];
                     
-                    glActiveTexture((GLenum)(GL_TEXTURE0 + textureUnitIndex));
-                    
                     switch(target)
                     {
                         case GL_TEXTURE_2D:
@@ -71,7 +73,7 @@ namespace CSBackend
                             
                             CS_ASSERT(glTexture, "Cannot bind a texture which hasn't been loaded.");
                             CS_ASSERT(!glTexture->IsDataInvalid(), "GLTextureUnitManager::Bind(): Failed to bind texture, its context is invalid!");
-                            glBindTexture(target, glTexture->GetHandle());
+                            m_glStateCache->BindTexture(u32(textureUnitIndex), target, glTexture->GetHandle());
                             break;
                         }
                         case GL_TEXTURE_CUBE_MAP:
@@ -80,15 +82,13 @@ namespace CSBackend
                             
                             CS_ASSERT(glCubemap, "Cannot bind a cubemap which hasn't been loaded.");
                             CS_ASSERT(!glCubemap->IsDataInvalid(), "GLTextureUnitManager::Bind(): Failed to bind cubemap, its context is invalid!");
-                            glBindTexture(target, glCubemap->GetHandle());
+                            m_glStateCache->BindTexture(u32(textureUnitIndex), target, glCubemap->GetHandle());
                             break;
                         }
                     }
                 }
             }
             
-            glActiveTexture(GL_TEXTURE0);
-            
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while binding textures.");
         }
         
@@ -101,29 +101,25 @@ namespace CSBackend
             {
                 m_boundTextures[textureIndex] = texture;
                 
-                glActiveTexture((GLenum)GL_TEXTURE0 + textureIndex);
-                
                 switch(target)
                 {
                     case GL_TEXTURE_2D:
                     {
                         auto glTexture = static_cast<GLTexture*>(texture->GetExtraData());
                         CS_ASSERT(glTexture, "Cannot bind a texture which hasn't been loaded.");
-                        glBindTexture(target, glTexture->GetHandle());
+                        m_glStateCache->BindTexture(textureIndex, target, glTexture->GetHandle());
                         break;
                     }
                     case GL_TEXTURE_CUBE_MAP:
                     {
                         auto glCubemap = static_cast<GLCubemap*>(texture->GetExtraData());
                         CS_ASSERT(glCubemap, "Cannot bind a cubemap which hasn't been loaded.");
-                        glBindTexture(target, glCubemap->GetHandle());
+                        m_glStateCache->BindTexture(textureIndex, target, glCubemap->GetHandle());
                         break;
                     }
                 }
             }
         
-            glActiveTexture(GL_TEXTURE0);
-            
             CS_ASSERT_NOGLERROR("An OpenGL error occurred while binding an additional texture.");
             
             return textureIndex;
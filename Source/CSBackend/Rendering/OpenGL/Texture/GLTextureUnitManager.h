@@ -46,7 +46,12 @@ namespace CSBackend
         public:
             CS_DECLARE_NOCOPY(GLTextureUnitManager);
             
-            GLTextureUnitManager() noexcept;
+            /// Creates a new texture unit manager which binds textures through the given state cache.
+            ///
+            /// @param glStateCache
+            ///     The state cache. Must outlive the texture unit manager.
+            ///
+            GLTextureUnitManager(GLStateCache* glStateCache) noexcept;
             
             /// @return The number of available texture slots.
             ///
@@ -87,6 +92,7 @@ namespace CSBackend
             ///
             GLint GetBoundOrAvailableUnit(const ChilliSource::RenderTexture* texture) const noexcept;
             
+            GLStateCache* m_glStateCache;
             std::vector<const ChilliSource::RenderTexture*> m_boundTextures;
         };
     }
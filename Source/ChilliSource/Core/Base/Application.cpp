@@ -46,6 +46,7 @@
 #include <ChilliSource/Core/State/StateManager.h>
 #include <ChilliSource/Core/String/StringParser.h>
 #include <ChilliSource/Core/Time/CoreTimer.h>
+#include <ChilliSource/Core/Time/Profiler.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 
 #include <ChilliSource/Input/DeviceButtons/DeviceButtonSystem.h>
@@ -58,6 +59,7 @@
 #include <ChilliSource/Rendering/Base/RenderCommandBufferManager.h>
 #include <ChilliSource/Rendering/Base/Renderer.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/RenderUploadScheduler.h>
 #include <ChilliSource/Rendering/Base/TargetType.h>
 #include <ChilliSource/Rendering/Camera/CameraComponent.h>
 #include <ChilliSource/Rendering/Font/Font.h>
@@ -66,8 +68,10 @@
 #include <ChilliSource/Rendering/Material/MaterialProvider.h>
 #include <ChilliSource/Rendering/Material/MaterialFactory.h>
 #include <ChilliSource/Rendering/Material/RenderMaterialGroupManager.h>
+#include <ChilliSource/Rendering/Model/AnimationUpdateScheduler.h>
 #include <ChilliSource/Rendering/Model/RenderMeshManager.h>
 #include <ChilliSource/Rendering/Particle/CSParticleProvider.h>
+#include <ChilliSource/Rendering/Particle/ParticleUpdateScheduler.h>
 #include <ChilliSource/Rendering/Particle/Affector/ParticleAffectorDefFactory.h>
 #include <ChilliSource/Rendering/Particle/Drawable/ParticleDrawableDefFactory.h>
 #include <ChilliSource/Rendering/Particle/Emitter/ParticleEmitterDefFactory.h>
@@ -328,6 +332,7 @@ namespace ChilliSource
         
         CreateSystem<RenderCommandBufferManager>();
         m_renderer = CreateSystem<Renderer>();
+        CreateSystem<RenderUploadScheduler>();
         m_renderMaterialGroupManager = CreateSystem<RenderMaterialGroupManager>();
         CreateSystem<RenderMeshManager>();
         CreateSystem<RenderShaderManager>();
@@ -342,12 +347,14 @@ namespace ChilliSource
         CreateSystem<TextureAtlasProvider>();
         CreateSystem<TextureProvider>();
         CreateSystem<FontProvider>();
+        CreateSystem<AnimationUpdateScheduler>();
         
         //Particles
         CreateSystem<CSParticleProvider>();
         CreateSystem<ParticleAffectorDefFactory>();
         CreateSystem<ParticleDrawableDefFactory>();
         CreateSystem<ParticleEmitterDefFactory>();
+        CreateSystem<ParticleUpdateScheduler>();
         
         //UI
         CreateSystem<UIComponentFactory>();
@@ -412,6 +419,8 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void Application::RenderScene(Scene* scene, TargetGroup* target) noexcept
     {
+        CS_PROFILE_ZONE("Application::RenderScene");
+        
         CS_RELEASE_ASSERT(GetTaskScheduler()->IsMainThread(), "Tried to render scene from background thread.");
         
         auto targetToUse = target == nullptr ? scene->GetRenderTarget() : target;
@@ -522,6 +531,8 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void Application::Update(f32 deltaTime, TimeIntervalSecs timestamp) noexcept
     {
+        CS_PROFILE_ZONE("Application::Update");
+        
 
 #if CS_ENABLE_DEBUG
         //When debugging we may have breakpoints so restrict the time between
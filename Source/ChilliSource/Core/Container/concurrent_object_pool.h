@@ -0,0 +1,259 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_CORE_CONTAINER_CONCURRENTOBJECTPOOL_H_
+#define _CHILLISOURCE_CORE_CONTAINER_CONCURRENTOBJECTPOOL_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------------
+    /// A lock-free pool of reusable object slots. Objects can be allocated and
+    /// deallocated from any thread. Only a compare-and-swap on the head of a free
+    /// list is needed, so no mutex is taken and no heap allocation is made.
+    ///
+    /// Slots are allocated in fixed-size blocks. When the free list runs out, a new
+    /// block is added under a lock. Blocks are never released until the pool is
+    /// destroyed, so the pool grows to its peak usage and then stays allocation
+    /// free. The free list head carries a tag which is incremented on every change,
+    /// which protects it against the ABA problem.
+    ///
+    /// All objects must have been deallocated before the pool is destroyed.
+    //------------------------------------------------------------------------------
+    template <typename TType> class concurrent_object_pool final
+    {
+    public:
+        CS_DECLARE_NOCOPY(concurrent_object_pool);
+        
+        using size_type = std::size_t;
+        
+        static constexpr size_type k_maxBlocks = 256;
+        
+        //------------------------------------------------------------------------------
+        /// Constructs a new pool. A single block is allocated up front.
+        ///
+        /// @param in_blockSize - The number of slots in each block.
+        //------------------------------------------------------------------------------
+        concurrent_object_pool(size_type in_blockSize = 1024) noexcept;
+        //------------------------------------------------------------------------------
+        /// @return The number of slots that have been allocated, whether they are in
+        /// use or not.
+        //------------------------------------------------------------------------------
+        size_type capacity() const noexcept;
+        //------------------------------------------------------------------------------
+        /// Takes a slot from the pool and constructs an object in it. This can be
+        /// called from any thread.
+        ///
+        /// @param in_args - The arguments passed to the object's constructor.
+        ///
+        /// @return The new object.
+        //------------------------------------------------------------------------------
+        template <typename... TArgs> TType* allocate(TArgs&&... in_args) noexcept;
+        //------------------------------------------------------------------------------
+        /// Destructs the given object and returns its slot to the pool. This can be
+        /// called from any thread.
+        ///
+        /// @param in_object - An object which was allocated from this pool.
+        //------------------------------------------------------------------------------
+        void deallocate(TType* in_object) noexcept;
+        //------------------------------------------------------------------------------
+        /// Destroys the pool, freeing all blocks.
+        //------------------------------------------------------------------------------
+        ~concurrent_object_pool() noexcept;
+        
+    private:
+        static constexpr u32 k_nullIndex = std::numeric_limits<u32>::max();
+        
+        //------------------------------------------------------------------------------
+        /// A single slot. The storage must be the first member so that an object
+        /// pointer can be converted back to its slot.
+        //------------------------------------------------------------------------------
+        struct Slot final
+        {
+            typename std::aligned_storage<sizeof(TType), alignof(TType)>::type m_storage;
+            u32 m_index;
+            std::atomic<u32> m_next;
+        };
+        
+        //------------------------------------------------------------------------------
+        /// @param in_index - The index of a slot.
+        ///
+        /// @return The slot.
+        //------------------------------------------------------------------------------
+        Slot* get_slot(u32 in_index) const noexcept;
+        //------------------------------------------------------------------------------
+        /// Allocates a new block and adds its slots to the free list.
+        //------------------------------------------------------------------------------
+        void add_block() noexcept;
+        //------------------------------------------------------------------------------
+        /// Pushes a linked chain of slots onto the free list.
+        ///
+        /// @param in_first - The first slot in the chain.
+        /// @param in_last - The last slot in the chain.
+        //------------------------------------------------------------------------------
+        void push_free(Slot* in_first, Slot* in_last) noexcept;
+        
+        const size_type m_blockSize;
+        std::array<std::atomic<Slot*>, k_maxBlocks> m_blocks;
+        std::atomic<u32> m_numBlocks;
+        std::mutex m_growMutex;
+        
+        //The low 32 bits hold the index of the first free slot; the high 32 bits hold a tag.
+        std::atomic<u64> m_freeHead;
+    };
+    
+    template <typename TType> constexpr typename concurrent_object_pool<TType>::size_type concurrent_object_pool<TType>::k_maxBlocks;
+    template <typename TType> constexpr u32 concurrent_object_pool<TType>::k_nullIndex;
+    
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> concurrent_object_pool<TType>::concurrent_object_pool(size_type in_blockSize) noexcept
+        : m_blockSize(in_blockSize), m_numBlocks(0), m_freeHead(k_nullIndex)
+    {
+        CS_ASSERT(m_blockSize > 0, "Object pool block size must be greater than zero.");
+        
+        for (auto& block : m_blocks)
+        {
+            block.store(nullptr, std::memory_order_relaxed);
+        }
+        
+        add_block();
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> typename concurrent_object_pool<TType>::size_type concurrent_object_pool<TType>::capacity() const noexcept
+    {
+        return m_numBlocks.load(std::memory_order_acquire) * m_blockSize;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> template <typename... TArgs> TType* concurrent_object_pool<TType>::allocate(TArgs&&... in_args) noexcept
+    {
+        u64 head = m_freeHead.load(std::memory_order_acquire);
+        while (true)
+        {
+            u32 index = u32(head);
+            if (index == k_nullIndex)
+            {
+                add_block();
+                head = m_freeHead.load(std::memory_order_acquire);
+                continue;
+            }
+            
+            //The slot may be taken by another thread before the exchange, in which case the next index is stale
+            //but the tag ensures the exchange fails.
+            Slot* slot = get_slot(index);
+            u64 next = u64(slot->m_next.load(std::memory_order_relaxed));
+            u64 newHead = (((head >> 32) + 1) << 32) | next;
+            
+            if (m_freeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return new (&slot->m_storage) TType(std::forward<TArgs>(in_args)...);
+            }
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> void concurrent_object_pool<TType>::deallocate(TType* in_object) noexcept
+    {
+        CS_ASSERT(in_object, "Cannot deallocate null.");
+        
+        in_object->~TType();
+        
+        Slot* slot = reinterpret_cast<Slot*>(in_object);
+        push_free(slot, slot);
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> typename concurrent_object_pool<TType>::Slot* concurrent_object_pool<TType>::get_slot(u32 in_index) const noexcept
+    {
+        return m_blocks[in_index / m_blockSize].load(std::memory_order_acquire) + (in_index % m_blockSize);
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> void concurrent_object_pool<TType>::add_block() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_growMutex);
+        
+        //Another thread may have added a block while this one was waiting for the lock.
+        if (u32(m_freeHead.load(std::memory_order_acquire)) != k_nullIndex)
+        {
+            return;
+        }
+        
+        u32 blockIndex = m_numBlocks.load(std::memory_order_relaxed);
+        CS_RELEASE_ASSERT(blockIndex < k_maxBlocks, "Object pool has exceeded its maximum number of blocks.");
+        CS_RELEASE_ASSERT((blockIndex + 1) * m_blockSize < k_nullIndex, "Object pool has exceeded its maximum number of slots.");
+        
+        Slot* block = new Slot[m_blockSize];
+        u32 firstIndex = u32(blockIndex * m_blockSize);
+        for (size_type i = 0; i < m_blockSize; ++i)
+        {
+            block[i].m_index = firstIndex + u32(i);
+            block[i].m_next.store((i + 1 < m_blockSize) ? firstIndex + u32(i + 1) : k_nullIndex, std::memory_order_relaxed);
+        }
+        
+        m_blocks[blockIndex].store(block, std::memory_order_release);
+        m_numBlocks.store(blockIndex + 1, std::memory_order_release);
+        
+        push_free(&block[0], &block[m_blockSize - 1]);
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> void concurrent_object_pool<TType>::push_free(Slot* in_first, Slot* in_last) noexcept
+    {
+        u64 head = m_freeHead.load(std::memory_order_acquire);
+        while (true)
+        {
+            in_last->m_next.store(u32(head), std::memory_order_relaxed);
+            u64 newHead = (((head >> 32) + 1) << 32) | u64(in_first->m_index);
+            
+            if (m_freeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> concurrent_object_pool<TType>::~concurrent_object_pool() noexcept
+    {
+        for (auto& block : m_blocks)
+        {
+            delete[] block.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,224 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_CORE_CONTAINER_WORKSTEALINGQUEUE_H_
+#define _CHILLISOURCE_CORE_CONTAINER_WORKSTEALINGQUEUE_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+#include <atomic>
+#include <memory>
+
+namespace ChilliSource
+{
+    //------------------------------------------------------------------------------
+    /// A fixed capacity, lock-free, single producer multiple consumer deque of
+    /// pointers, based on the Chase-Lev work stealing deque.
+    ///
+    /// The owning thread pushes and pops from the bottom of the queue in LIFO
+    /// order, while any other thread can steal from the top in FIFO order. The
+    /// queue doesn't grow; push() fails if it is full, leaving the caller to decide
+    /// where the overflow should go.
+    ///
+    /// push() and pop() must only be called from the owning thread. steal(),
+    /// empty() and size() are thread-safe.
+    ///
+    /// The queue doesn't take ownership of the pointed to objects.
+    //------------------------------------------------------------------------------
+    template <typename TType> class work_stealing_queue final
+    {
+    public:
+        CS_DECLARE_NOCOPY(work_stealing_queue);
+
+        using size_type = std::size_t;
+
+        //------------------------------------------------------------------------------
+        /// Constructs a new empty queue with the given capacity.
+        ///
+        /// @param in_capacity - The capacity of the queue. Must be a power of two.
+        //------------------------------------------------------------------------------
+        work_stealing_queue(size_type in_capacity = 1024) noexcept;
+        //------------------------------------------------------------------------------
+        /// @return Whether or not the queue was empty at the time of calling. Other
+        /// threads may have changed this by the time the result is used.
+        //------------------------------------------------------------------------------
+        bool empty() const noexcept;
+        //------------------------------------------------------------------------------
+        /// @return The approximate number of items in the queue.
+        //------------------------------------------------------------------------------
+        size_type size() const noexcept;
+        //------------------------------------------------------------------------------
+        /// @return The maximum number of items the queue can hold.
+        //------------------------------------------------------------------------------
+        size_type capacity() const noexcept;
+        //------------------------------------------------------------------------------
+        /// Pushes the given item onto the bottom of the queue. This must only be called
+        /// from the owning thread.
+        ///
+        /// @param in_item - The item to push. Must not be null.
+        ///
+        /// @return Whether or not the item was pushed. This fails if the queue is full.
+        //------------------------------------------------------------------------------
+        bool push(TType* in_item) noexcept;
+        //------------------------------------------------------------------------------
+        /// Pops the most recently pushed item from the bottom of the queue. This must
+        /// only be called from the owning thread.
+        ///
+        /// @return The popped item, or null if the queue was empty or the last item
+        /// was stolen by another thread.
+        //------------------------------------------------------------------------------
+        TType* pop() noexcept;
+        //------------------------------------------------------------------------------
+        /// Steals the oldest item from the top of the queue. This can be called from
+        /// any thread.
+        ///
+        /// @return The stolen item, or null if the queue was empty or another thread
+        /// won the race for the item.
+        //------------------------------------------------------------------------------
+        TType* steal() noexcept;
+
+    private:
+        const size_type m_mask;
+        std::unique_ptr<std::atomic<TType*>[]> m_buffer;
+        std::atomic<s64> m_top;
+        std::atomic<s64> m_bottom;
+    };
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> work_stealing_queue<TType>::work_stealing_queue(size_type in_capacity) noexcept
+        : m_mask(in_capacity - 1), m_buffer(new std::atomic<TType*>[in_capacity]), m_top(0), m_bottom(0)
+    {
+        CS_ASSERT(in_capacity > 0 && (in_capacity & m_mask) == 0, "Work stealing queue capacity must be a power of two.");
+
+        for (size_type i = 0; i < in_capacity; ++i)
+        {
+            m_buffer[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> bool work_stealing_queue<TType>::empty() const noexcept
+    {
+        return size() == 0;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> typename work_stealing_queue<TType>::size_type work_stealing_queue<TType>::size() const noexcept
+    {
+        s64 bottom = m_bottom.load(std::memory_order_acquire);
+        s64 top = m_top.load(std::memory_order_acquire);
+
+        return (bottom > top) ? size_type(bottom - top) : 0;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> typename work_stealing_queue<TType>::size_type work_stealing_queue<TType>::capacity() const noexcept
+    {
+        return m_mask + 1;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> bool work_stealing_queue<TType>::push(TType* in_item) noexcept
+    {
+        CS_ASSERT(in_item, "Cannot push null onto a work stealing queue.");
+
+        s64 bottom = m_bottom.load(std::memory_order_relaxed);
+        s64 top = m_top.load(std::memory_order_acquire);
+
+        if (bottom - top > s64(m_mask))
+        {
+            return false;
+        }
+
+        m_buffer[size_type(bottom) & m_mask].store(in_item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> TType* work_stealing_queue<TType>::pop() noexcept
+    {
+        //Only the owner changes the bottom and the top only ever increases, so if the
+        //queue looks empty here it really is, and the fence below can be skipped.
+        if (m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        
+        s64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        s64 top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        TType* item = m_buffer[size_type(bottom) & m_mask].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            //This is the last item so we have to race any stealing threads for it.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    template <typename TType> TType* work_stealing_queue<TType>::steal() noexcept
+    {
+        s64 top = m_top.load(std::memory_order_acquire);
+        if (top >= m_bottom.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        s64 bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        TType* item = m_buffer[size_type(top) & m_mask].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return item;
+    }
+}
+
+#endif
@@ -29,6 +29,8 @@
 #include <ChilliSource/Core/Entity/Entity.h>
 #include <ChilliSource/Core/Scene/Scene.h>
 #include <ChilliSource/Core/String/StringUtils.h>
+#include <ChilliSource/Core/Volume/VolumeComponent.h>
+#include <ChilliSource/Core/Volume/VolumeHierarchy.h>
 
 #include <algorithm>
 
@@ -38,6 +40,35 @@ namespace ChilliSource
     {
         const EntitySPtr EntityNullPtr;
         const ComponentSPtr ComponentNullPtr;
+        
+        //------------------------------------------------------------------
+        /// Adds the component to the scene's volume hierarchy if it is a
+        /// volume component.
+        ///
+        /// @param The scene.
+        /// @param The component.
+        //------------------------------------------------------------------
+        void AddToVolumeHierarchy(Scene* in_scene, Component* in_component)
+        {
+            if (in_component->IsA<VolumeComponent>() == true)
+            {
+                in_scene->GetVolumeHierarchy()->Add(static_cast<VolumeComponent*>(in_component));
+            }
+        }
+        //------------------------------------------------------------------
+        /// Removes the component from the scene's volume hierarchy if it is
+        /// a volume component.
+        ///
+        /// @param The scene.
+        /// @param The component.
+        //------------------------------------------------------------------
+        void RemoveFromVolumeHierarchy(Scene* in_scene, Component* in_component)
+        {
+            if (in_component->IsA<VolumeComponent>() == true)
+            {
+                in_scene->GetVolumeHierarchy()->Remove(static_cast<VolumeComponent*>(in_component));
+            }
+        }
     }
     
     //------------------------------------------------------------------
@@ -213,6 +244,7 @@ namespace ChilliSource
         if(GetScene() != nullptr)
         {
             in_component->OnAddedToScene();
+            AddToVolumeHierarchy(GetScene(), in_component.get());
             if (m_appActive == true)
             {
                 in_component->OnResume();
@@ -244,6 +276,7 @@ namespace ChilliSource
                         }
                         in_component->OnSuspend();
                     }
+                    RemoveFromVolumeHierarchy(GetScene(), in_component);
                     in_component->OnRemovedFromScene();
                 }
                 
@@ -274,6 +307,7 @@ namespace ChilliSource
                     }
                     component->OnSuspend();
                 }
+                RemoveFromVolumeHierarchy(GetScene(), component);
                 component->OnRemovedFromScene();
             }
             
@@ -385,6 +419,7 @@ namespace ChilliSource
         for (u32 i = 0; i < m_components.size(); ++i)
         {
             m_components[i]->OnAddedToScene();
+            AddToVolumeHierarchy(m_scene, m_components[i].get());
         }
         
         for (u32 i = 0; i < m_children.size(); ++i)
@@ -427,6 +462,7 @@ namespace ChilliSource
         
         for (auto it = m_components.rbegin(); it != m_components.rend(); ++it)
         {
+            RemoveFromVolumeHierarchy(m_scene, it->get());
             (*it)->OnRemovedFromScene();
         }
     }
@@ -67,6 +67,7 @@ namespace ChilliSource
     template <typename TType> class random_access_iterator;
     template <typename TType> class ReferenceProperty;
     template <typename TType> class ValueProperty;
+    template <typename TType> class work_stealing_queue;
     //---------------------------------------------------------
     /// Delegate
     //---------------------------------------------------------
@@ -214,18 +215,24 @@ namespace ChilliSource
     //---------------------------------------------------------
     /// Threading
     //---------------------------------------------------------
+    CS_FORWARDDECLARE_CLASS(FileTaskQueue);
     CS_FORWARDDECLARE_CLASS(SingleThreadTaskPool);
     CS_FORWARDDECLARE_CLASS(TaskContext);
+    CS_FORWARDDECLARE_CLASS(TaskGraph);
+    CS_FORWARDDECLARE_CLASS(TaskHandle);
     CS_FORWARDDECLARE_CLASS(TaskPool);
     CS_FORWARDDECLARE_CLASS(TaskScheduler);
     CS_FORWARDDECLARE_CLASS(TaskScheduler);
     CS_FORWARDDECLARE_CLASS(ThreadPool);
+    enum class FileTaskPriority;
     enum class TaskType;
     //---------------------------------------------------------
     /// Time
     //---------------------------------------------------------
     CS_FORWARDDECLARE_CLASS(CoreTimer);
     CS_FORWARDDECLARE_CLASS(PerformanceTimer);
+    CS_FORWARDDECLARE_CLASS(Profiler);
+    CS_FORWARDDECLARE_CLASS(ProfilerZone);
     CS_FORWARDDECLARE_CLASS(Timer);
     //---------------------------------------------------------
     /// Tween
@@ -235,6 +242,7 @@ namespace ChilliSource
     /// Volume
     //---------------------------------------------------------
     CS_FORWARDDECLARE_CLASS(VolumeComponent);
+    CS_FORWARDDECLARE_CLASS(VolumeHierarchy);
     //---------------------------------------------------------
     /// XML
     //---------------------------------------------------------
@@ -22,37 +22,43 @@
 // SOFTWARE.
 //
 
+
 #include <ChilliSource/Core/Memory/PagedLinearAllocator.h>
 
-#include <cassert>
+#include <ChilliSource/Core/Memory/MemoryUtils.h>
 
 namespace ChilliSource
 {
     //------------------------------------------------------------------------------
     PagedLinearAllocator::PagedLinearAllocator(std::size_t pageSize) noexcept
-        : m_pageSize(pageSize), m_freeStoreLinearAllocators()
+        : m_pageSize(pageSize), m_activeAllocationCount(0)
     {
-        m_freeStoreLinearAllocators.push_back(std::unique_ptr<LinearAllocator>(new LinearAllocator(m_pageSize)));
+        CS_ASSERT(MemoryUtils::IsAligned(m_pageSize, sizeof(std::intptr_t)), "Page size must be a multiple of the pointer size.");
+
+        m_firstPage = CreatePage();
+        m_currentPage = m_firstPage;
     }
 
     //------------------------------------------------------------------------------
     PagedLinearAllocator::PagedLinearAllocator(IAllocator& parentAllocator, std::size_t pageSize) noexcept
-        : m_pageSize(pageSize), m_parentAllocator(&parentAllocator), m_parentAllocatorLinearAllocators()
+        : m_pageSize(pageSize), m_parentAllocator(&parentAllocator), m_activeAllocationCount(0)
     {
-        m_parentAllocatorLinearAllocators.push_back(MakeUnique<LinearAllocator>(*m_parentAllocator, *m_parentAllocator, m_pageSize));
+        CS_ASSERT(MemoryUtils::IsAligned(m_pageSize, sizeof(std::intptr_t)), "Page size must be a multiple of the pointer size.");
+
+        m_firstPage = CreatePage();
+        m_currentPage = m_firstPage;
     }
 
     //------------------------------------------------------------------------------
     std::size_t PagedLinearAllocator::GetNumPages() const noexcept
     {
-        if (m_parentAllocator)
+        std::size_t numPages = 0;
+        for (auto page = m_firstPage; page; page = page->m_next.load(std::memory_order_acquire))
         {
-            return m_parentAllocatorLinearAllocators.size();
-        }
-        else
-        {
-            return m_freeStoreLinearAllocators.size();
+            ++numPages;
         }
+
+        return numPages;
     }
 
     //------------------------------------------------------------------------------
@@ -60,99 +66,133 @@ namespace ChilliSource
     {
         CS_ASSERT(allocationSize <= GetMaxAllocationSize(), "Allocation size is too big.");
 
-        if (m_parentAllocator)
+        auto alignedSize = MemoryUtils::Align(allocationSize, sizeof(std::intptr_t));
+        auto page = m_currentPage.load(std::memory_order_acquire);
+
+        while (true)
         {
-            for (const auto& allocator : m_parentAllocatorLinearAllocators)
+            // Threads which overshoot the end of the page simply move on, as the offset is only ever
+            // reset when no other threads are using the allocator.
+            auto offset = page->m_nextOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+            if (offset + alignedSize <= m_pageSize)
             {
-                if (allocator->GetRemainingSpace() >= allocationSize)
-                {
-                    return allocator->Allocate(allocationSize);
-                }
+                m_activeAllocationCount.fetch_add(1, std::memory_order_relaxed);
+                return page->m_buffer + offset;
             }
 
-            m_parentAllocatorLinearAllocators.push_back(MakeUnique<LinearAllocator>(*m_parentAllocator, *m_parentAllocator, m_pageSize));
-            return m_parentAllocatorLinearAllocators.back()->Allocate(allocationSize);
+            page = MoveToNextPage(page);
         }
-        else
+    }
+
+    //------------------------------------------------------------------------------
+    void PagedLinearAllocator::Deallocate(void* pointer, std::size_t allocationSize) noexcept
+    {
+        CS_ASSERT(Contains(pointer), "Cannot deallocate a pointer that did not originate from this allocator.");
+
+        m_activeAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    //------------------------------------------------------------------------------
+    void PagedLinearAllocator::Reset() noexcept
+    {
+        CS_ASSERT(m_activeAllocationCount.load(std::memory_order_relaxed) == 0, "Cannot reset before all allocations have been deallocated.");
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (auto page = m_firstPage; page; page = page->m_next.load(std::memory_order_relaxed))
         {
-            for (const auto& allocator : m_freeStoreLinearAllocators)
-            {
-                if (allocator->GetRemainingSpace() >= allocationSize)
-                {
-                    return allocator->Allocate(allocationSize);
-                }
-            }
+            page->m_nextOffset.store(0, std::memory_order_relaxed);
+        }
+
+        m_currentPage.store(m_firstPage, std::memory_order_release);
+    }
 
-            m_freeStoreLinearAllocators.push_back(std::unique_ptr<LinearAllocator>(new LinearAllocator(m_pageSize)));
-            return m_freeStoreLinearAllocators.back()->Allocate(allocationSize);
+    //------------------------------------------------------------------------------
+    void PagedLinearAllocator::ResetAndShrink() noexcept
+    {
+        Reset();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        auto page = m_firstPage->m_next.load(std::memory_order_relaxed);
+        while (page)
+        {
+            auto next = page->m_next.load(std::memory_order_relaxed);
+            DestroyPage(page);
+            page = next;
         }
+
+        m_firstPage->m_next.store(nullptr, std::memory_order_relaxed);
     }
 
     //------------------------------------------------------------------------------
-    void PagedLinearAllocator::Deallocate(void* pointer, std::size_t allocationSize) noexcept
+    PagedLinearAllocator::Page* PagedLinearAllocator::CreatePage() const noexcept
     {
+        auto page = new Page();
+        page->m_nextOffset.store(0, std::memory_order_relaxed);
+        page->m_next.store(nullptr, std::memory_order_relaxed);
+
         if (m_parentAllocator)
         {
-            for (const auto& allocator : m_parentAllocatorLinearAllocators)
-            {
-                if (allocator->Contains(pointer))
-                {
-                    return allocator->Deallocate(pointer, allocationSize);
-                }
-            }
+            page->m_buffer = reinterpret_cast<std::uint8_t*>(m_parentAllocator->Allocate(m_pageSize));
         }
         else
         {
-            for (const auto& allocator : m_freeStoreLinearAllocators)
-            {
-                if (allocator->Contains(pointer))
-                {
-                    return allocator->Deallocate(pointer, allocationSize);
-                }
-            }
+            page->m_buffer = new std::uint8_t[m_pageSize];
         }
 
-        CS_LOG_FATAL("Cannot deallocate a pointer that did not originate from this allocator.");
+        CS_ASSERT(MemoryUtils::IsAligned(reinterpret_cast<std::uintptr_t>(page->m_buffer), sizeof(std::intptr_t)), "Pages must be pointer aligned.");
+
+        return page;
     }
 
     //------------------------------------------------------------------------------
-    void PagedLinearAllocator::Reset() noexcept
+    void PagedLinearAllocator::DestroyPage(Page* page) const noexcept
     {
         if (m_parentAllocator)
         {
-            for (auto& allocator : m_parentAllocatorLinearAllocators)
-            {
-                allocator->Reset();
-            }
+            m_parentAllocator->Deallocate(page->m_buffer, m_pageSize);
         }
         else
         {
-            for (auto& allocator : m_freeStoreLinearAllocators)
-            {
-                allocator->Reset();
-            }
+            delete[] page->m_buffer;
         }
+
+        delete page;
     }
 
     //------------------------------------------------------------------------------
-    void PagedLinearAllocator::ResetAndShrink() noexcept
+    PagedLinearAllocator::Page* PagedLinearAllocator::MoveToNextPage(Page* fullPage) noexcept
     {
-        Reset();
+        std::unique_lock<std::mutex> lock(m_mutex);
 
-        if (m_parentAllocator)
+        if (m_currentPage.load(std::memory_order_relaxed) == fullPage)
         {
-            while (m_parentAllocatorLinearAllocators.size() > 1)
+            auto nextPage = fullPage->m_next.load(std::memory_order_relaxed);
+            if (!nextPage)
             {
-                m_parentAllocatorLinearAllocators.erase(m_parentAllocatorLinearAllocators.begin() + 1);
+                nextPage = CreatePage();
+                fullPage->m_next.store(nextPage, std::memory_order_release);
             }
+
+            m_currentPage.store(nextPage, std::memory_order_release);
         }
-        else
+
+        return m_currentPage.load(std::memory_order_acquire);
+    }
+
+    //------------------------------------------------------------------------------
+    bool PagedLinearAllocator::Contains(void* pointer) const noexcept
+    {
+        for (auto page = m_firstPage; page; page = page->m_next.load(std::memory_order_acquire))
         {
-            while (m_freeStoreLinearAllocators.size() > 1)
+            if (pointer >= page->m_buffer && pointer < page->m_buffer + m_pageSize)
             {
-                m_freeStoreLinearAllocators.erase(m_freeStoreLinearAllocators.begin() + 1);
+                return true;
             }
         }
+
+        return false;
     }
 
     //------------------------------------------------------------------------------
@@ -160,13 +200,12 @@ namespace ChilliSource
     {
         Reset();
 
-        if (m_parentAllocator)
-        {
-            m_parentAllocatorLinearAllocators.~vector();
-        }
-        else
+        auto page = m_firstPage;
+        while (page)
         {
-            m_freeStoreLinearAllocators.~vector();
+            auto next = page->m_next.load(std::memory_order_relaxed);
+            DestroyPage(page);
+            page = next;
         }
     }
 }
@@ -22,14 +22,15 @@
 // SOFTWARE.
 //
 
+
 #ifndef _CHILLISOURCE_CORE_MEMORY_PAGEDLINEARALLOCATOR_H_
 #define _CHILLISOURCE_CORE_MEMORY_PAGEDLINEARALLOCATOR_H_
 
 #include <ChilliSource/ChilliSource.h>
-#include <ChilliSource/Core/Memory/LinearAllocator.h>
-#include <ChilliSource/Core/Memory/UniquePtr.h>
+#include <ChilliSource/Core/Memory/IAllocator.h>
 
-#include <vector>
+#include <atomic>
+#include <mutex>
 
 namespace ChilliSource
 {
@@ -37,14 +38,18 @@ namespace ChilliSource
     /// simply moving the next allocation pointer through the buffer by the size of the
     /// allocation. All allocations are 'deallocated' at the same time by resetting the 
     /// allocation pointer back to the start of the buffer. If an allocation will not
-    /// fit in the current buffer then a new page is allocated. Once a page has been
-    /// allocated it will not be deallocated until ResetAndShink() is called.
+    /// fit in the current buffer then the next page is used, allocating it if needed.
+    /// Once a page has been allocated it will not be deallocated until ResetAndShrink()
+    /// is called.
     ///
     /// A PagedLinearAllocator can be backed by other allocator types, from which pages 
     /// will be allocated, otherwise they are allocated from the free store.
     ///
-    /// Note that this is not thread-safe and should not be accessed from multiple
-    /// threads at the same time.
+    /// Allocate() and Deallocate() are thread-safe, allowing a single frame allocator to
+    /// be shared by the tasks which make up the render pipeline. Allocating within the
+    /// current page is a single atomic increment; a lock is only taken when moving on
+    /// to the next page. Reset() and ResetAndShrink() must not be called while other
+    /// threads are using the allocator.
     ///
     class PagedLinearAllocator final : public IAllocator
     {
@@ -87,8 +92,10 @@ namespace ChilliSource
         std::size_t GetNumPages() const noexcept;
 
         /// Allocates a new block of memory of the requested size. If there is no space left in the
-        /// buffer for the alloaction then a new page will be allocated. Allocations must be smaller
-        /// than the size of a single page.
+        /// current page for the alloaction then the next page will be used. Allocations must be
+        /// smaller than the size of a single page.
+        ///
+        /// This is thread-safe.
         ///
         /// @param allocationSize
         ///     The size of the allocation.
@@ -100,6 +107,8 @@ namespace ChilliSource
         /// Decriments the allocation count. This is checked when resetting to ensure that all previously
         /// allocated memory has been deallocated.
         ///
+        /// This is thread-safe.
+        ///
         /// @param pointer
         ///     The pointer to deallocate.
         /// @param allocationSize
@@ -124,15 +133,53 @@ namespace ChilliSource
         PagedLinearAllocator(PagedLinearAllocator&&) = delete;
         PagedLinearAllocator& operator=(PagedLinearAllocator&&) = delete;
 
-        const std::size_t m_pageSize;
+        /// A single page of memory. Pages form a list which is only ever appended to while the
+        /// allocator is in use, so it can be read without taking the lock.
+        ///
+        struct Page final
+        {
+            std::uint8_t* m_buffer = nullptr;
+            std::atomic<std::size_t> m_nextOffset;
+            std::atomic<Page*> m_next;
+        };
+
+        /// Allocates a new page, from the parent allocator if there is one.
+        ///
+        /// @return The new page.
+        ///
+        Page* CreatePage() const noexcept;
+
+        /// Deallocates the given page.
+        ///
+        /// @param page
+        ///     The page to deallocate.
+        ///
+        void DestroyPage(Page* page) const noexcept;
+
+        /// Moves on to the next page once the given page is full. If another thread has already
+        /// done so this simply returns the new current page.
+        ///
+        /// @param fullPage
+        ///     The page which an allocation didn't fit in.
+        ///
+        /// @return The current page.
+        ///
+        Page* MoveToNextPage(Page* fullPage) noexcept;
+
+        /// @param pointer
+        ///     The pointer.
+        ///
+        /// @return Whether or not the given pointer is within one of the pages.
+        ///
+        bool Contains(void* pointer) const noexcept;
 
+        const std::size_t m_pageSize;
         IAllocator* m_parentAllocator = nullptr;
 
-        union
-        {
-            std::vector<std::unique_ptr<LinearAllocator>> m_freeStoreLinearAllocators;
-            std::vector<UniquePtr<LinearAllocator>> m_parentAllocatorLinearAllocators;
-        };
+        std::mutex m_mutex;
+        Page* m_firstPage = nullptr;
+        std::atomic<Page*> m_currentPage;
+        std::atomic<std::size_t> m_activeAllocationCount;
     };
 }
 
@@ -28,6 +28,7 @@
 
 #include <ChilliSource/Core/Scene/Scene.h>
 #include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Time/Profiler.h>
 #include <ChilliSource/Rendering/Target/TargetGroup.h>
 
 #include <algorithm>
@@ -45,7 +46,7 @@ namespace ChilliSource
     //-------------------------------------------------------
     //-------------------------------------------------------
     Scene::Scene(TargetGroupUPtr renderTarget) noexcept
-    : m_renderTarget(std::move(renderTarget))
+    : m_renderTarget(std::move(renderTarget)), m_volumeHierarchy(new VolumeHierarchy())
     {
         m_clearColour = ChilliSource::Colour::k_black;
     }
@@ -107,6 +108,8 @@ namespace ChilliSource
     //-------------------------------------------------------
     void Scene::RenderSnapshotEntities(RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
     {
+        CS_PROFILE_ZONE("Scene::RenderSnapshotEntities");
+        
         for(u32 i=0; i<m_entities.size(); ++i)
         {
             m_entities[i]->OnRenderSnapshot(renderSnapshot, frameAllocator);
@@ -225,24 +228,7 @@ namespace ChilliSource
     //--------------------------------------------------------------------------------------------------
     void Scene::QuerySceneForIntersection(const Ray &in_ray, std::vector<VolumeComponent*>& out_volumeComponents)
     {
-        std::vector<VolumeComponent*> intersectableComponents;
-        QuerySceneForComponents(intersectableComponents);
-        
-        //Loop through the render components and check for intersection
-        //If any intersect then add them to the intersect list
-        for(std::vector<VolumeComponent*>::iterator it = intersectableComponents.begin(); it != intersectableComponents.end(); ++it)
-        {
-            VolumeComponent* component = (*it);
-            
-            f32 nearIntersection, farIntersection = 0.0f;
-            
-            if(component->GetOOBB().Contains(in_ray, nearIntersection, farIntersection))
-            {
-                //We use this to sort by
-                component->mfQueryIntersectionValue = nearIntersection;
-                out_volumeComponents.push_back(component);
-            }
-        }
+        m_volumeHierarchy->QueryRay(in_ray, out_volumeComponents);
     }
     //--------------------------------------------------------------------------------------------------
     //--------------------------------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #include <ChilliSource/Core/Math/Geometry/Shapes.h>
 #include <ChilliSource/Core/System/StateSystem.h>
 #include <ChilliSource/Core/Volume/VolumeComponent.h>
+#include <ChilliSource/Core/Volume/VolumeHierarchy.h>
 #include <ChilliSource/Rendering/Target/TargetGroup.h>
 
 namespace ChilliSource
@@ -216,10 +217,15 @@ namespace ChilliSource
         ///
         void Render(TargetGroup* target = nullptr) noexcept;
         
+        /// @return The bounding volume hierarchy containing every volume component in the scene. This
+        ///     can be used to perform ray, sphere, box and frustum queries against the scene.
+        ///
+        VolumeHierarchy* GetVolumeHierarchy() const noexcept { return m_volumeHierarchy.get(); }
+        
         //--------------------------------------------------------------------------------------------------
-        /// Traverses the contents of the scene and adds any objects that intersect with the ray to the
-        /// list. The list order is undefined. Use the query intersection value on the volume component
-        /// to sort by depth
+        /// Queries the scene's volume hierarchy for any objects that intersect with the ray and adds them
+        /// to the list. The added objects are sorted by depth, nearest first, and the depth of each is
+        /// stored in the query intersection value on the volume component.
         ///
         /// @author S Downie
         ///
@@ -314,6 +320,7 @@ namespace ChilliSource
         bool m_enabled = true;
         CameraComponent* m_activeCameraComponent = nullptr;
         TargetGroupUPtr m_renderTarget;
+        VolumeHierarchyUPtr m_volumeHierarchy;
     };		
 }
 
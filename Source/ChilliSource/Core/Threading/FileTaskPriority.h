@@ -1,11 +1,7 @@
 //
-//  Particle.h
-//  ChilliSource
-//  Created by Ian Copland on 07/10/2014.
-//
 //  The MIT License (MIT)
 //
-//  Copyright (c) 2014 Tag Games Limited
+//  Copyright (c) 2017 Tag Games Limited
 //
 //  Permission is hereby granted, free of charge, to any person obtaining a copy
 //  of this software and associated documentation files (the "Software"), to deal
@@ -26,34 +22,33 @@
 //  THE SOFTWARE.
 //
 
-#ifndef _CHILLISOURCE_RENDERING_PARTICLE_PARTICLE_H_
-#define _CHILLISOURCE_RENDERING_PARTICLE_PARTICLE_H_
 
-#include <ChilliSource/ChilliSource.h>
+#ifndef _CHILLISOURCE_CORE_THREADING_FILETASKPRIORITY_H_
+#define _CHILLISOURCE_CORE_THREADING_FILETASKPRIORITY_H_
 
-#include <ChilliSource/Core/Math/Vector3.h>
-#include <ChilliSource/Core/Math/Vector2.h>
-#include <ChilliSource/Core/Math/Quaternion.h>
-#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/ChilliSource.h>
 
 namespace ChilliSource
 {
-    //-----------------------------------------------------------------------
-    /// A struct containing the properties for a single particle.
+    /// The priority of a file task. Higher priority tasks are always started before lower
+    /// priority tasks, and tasks of the same priority are started in the order they were
+    /// added.
+    ///
+    /// Blocking: Something is waiting on the result of the task, for example a loading
+    /// screen, or UI which will be noticeably missing until the file is loaded.
+    ///
+    /// Visible: The result of the task will be seen by the user as soon as it's available.
+    /// This is the priority given to tasks scheduled as TaskType::k_file.
+    ///
+    /// Prefetch: The result of the task will only be needed later, so it should only be
+    /// processed when nothing else is waiting.
     ///
-    /// @author Ian Copland
-    //-----------------------------------------------------------------------
-    struct Particle final
+    enum class FileTaskPriority
     {
-        bool m_isActive = false;
-        f32 m_lifetime = 0.0f;
-        f32 m_energy = 0.0f;
-        Vector3 m_position;
-        Vector2 m_scale = Vector2::k_one;
-        f32 m_rotation = 0.0f;
-        Colour m_colour = Colour::k_white;
-        Vector3 m_velocity;
-        f32 m_angularVelocity = 0.0f;
+        k_blocking,
+        k_visible,
+        k_prefetch,
+        k_total
     };
 }
 
@@ -0,0 +1,284 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Threading/FileTaskQueue.h>
+
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        /// @return A monotonic timestamp in microseconds.
+        ///
+        u64 GetTimestampMicroS() noexcept
+        {
+            return u64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+    
+    constexpr FileTaskQueue::TaskId FileTaskQueue::k_invalidTaskId;
+    constexpr u32 FileTaskQueue::k_defaultMaxConcurrentTasks;
+    constexpr u32 FileTaskQueue::k_numHistogramBuckets;
+    
+    //------------------------------------------------------------------------------
+    f64 FileTaskQueue::Histogram::GetBucketUpperBoundMS(u32 bucketIndex) noexcept
+    {
+        CS_ASSERT(bucketIndex < k_numHistogramBuckets, "Histogram bucket index out of bounds.");
+        
+        if (bucketIndex == k_numHistogramBuckets - 1)
+        {
+            return std::numeric_limits<f64>::infinity();
+        }
+        
+        return f64(1u << bucketIndex);
+    }
+    
+    //------------------------------------------------------------------------------
+    void FileTaskQueue::Histogram::Add(u64 durationMicroS) noexcept
+    {
+        u32 bucketIndex = 0;
+        while (bucketIndex < k_numHistogramBuckets - 1 && durationMicroS > u64(1000u << bucketIndex))
+        {
+            ++bucketIndex;
+        }
+        
+        ++m_counts[bucketIndex];
+    }
+    
+    //------------------------------------------------------------------------------
+    FileTaskQueue::FileTaskQueue(TaskPool* taskPool, u32 maxConcurrentTasks) noexcept
+        : m_taskPool(taskPool), m_maxConcurrentTasks(maxConcurrentTasks)
+    {
+        CS_ASSERT(m_taskPool, "File task queue requires a task pool.");
+        CS_ASSERT(m_maxConcurrentTasks > 0, "File task queue must allow at least one concurrent task.");
+    }
+    
+    //------------------------------------------------------------------------------
+    FileTaskQueue::TaskId FileTaskQueue::Add(FileTaskPriority priority, const Task& task, const std::string& coalescingKey) noexcept
+    {
+        CS_ASSERT(priority != FileTaskPriority::k_total, "Invalid file task priority.");
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        auto taskId = m_nextTaskId++;
+        
+        if (!coalescingKey.empty())
+        {
+            auto it = m_coalescableRequests.find(coalescingKey);
+            if (it != m_coalescableRequests.end())
+            {
+                auto request = it->second;
+                request->m_tasks.push_back(std::make_pair(taskId, task));
+                m_pendingTasks.emplace(taskId, request);
+                ++m_stats.m_numTasksCoalesced;
+                
+                //The request is left in its old queue as well; whichever entry is reached first starts it and the other is discarded as stale.
+                if (u32(priority) < u32(request->m_priority))
+                {
+                    request->m_priority = priority;
+                    m_queues[u32(priority)].push_back(request);
+                    StartRequests(lock);
+                }
+                
+                return taskId;
+            }
+        }
+        
+        auto request = std::make_shared<Request>();
+        request->m_tasks.push_back(std::make_pair(taskId, task));
+        request->m_priority = priority;
+        request->m_coalescingKey = coalescingKey;
+        request->m_queuedTimeMicroS = GetTimestampMicroS();
+        
+        m_queues[u32(priority)].push_back(request);
+        m_pendingTasks.emplace(taskId, request);
+        if (!coalescingKey.empty())
+        {
+            m_coalescableRequests.emplace(coalescingKey, request);
+        }
+        
+        StartRequests(lock);
+        
+        return taskId;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool FileTaskQueue::Cancel(TaskId taskId) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        auto it = m_pendingTasks.find(taskId);
+        if (it == m_pendingTasks.end())
+        {
+            return false;
+        }
+        
+        auto request = it->second;
+        m_pendingTasks.erase(it);
+        
+        auto& tasks = request->m_tasks;
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [=](const std::pair<TaskId, Task>& entry) { return entry.first == taskId; }), tasks.end());
+        
+        //Empty requests are left in the queues and discarded when they are reached.
+        if (tasks.empty() && !request->m_coalescingKey.empty())
+        {
+            m_coalescableRequests.erase(request->m_coalescingKey);
+        }
+        
+        ++m_stats.m_numTasksCancelled;
+        return true;
+    }
+    
+    //------------------------------------------------------------------------------
+    void FileTaskQueue::SetMaxConcurrentTasks(u32 maxConcurrentTasks) noexcept
+    {
+        CS_ASSERT(maxConcurrentTasks > 0, "File task queue must allow at least one concurrent task.");
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_maxConcurrentTasks = maxConcurrentTasks;
+        StartRequests(lock);
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 FileTaskQueue::GetMaxConcurrentTasks() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_maxConcurrentTasks;
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 FileTaskQueue::GetNumPendingTasks() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return u32(m_pendingTasks.size());
+    }
+    
+    //------------------------------------------------------------------------------
+    FileTaskQueue::Stats FileTaskQueue::GetStats() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+    
+    //------------------------------------------------------------------------------
+    void FileTaskQueue::ResetStats() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stats = Stats();
+    }
+    
+    //------------------------------------------------------------------------------
+    void FileTaskQueue::StartRequests(std::unique_lock<std::mutex>& lock) noexcept
+    {
+        CS_ASSERT(lock.owns_lock(), "The file task queue must be locked to start requests.");
+        
+        std::vector<Task> tasks;
+        
+        while (m_numRunningRequests < m_maxConcurrentTasks)
+        {
+            auto request = PopNextRequest();
+            if (!request)
+            {
+                break;
+            }
+            
+            ++m_numRunningRequests;
+            
+            auto startTimeMicroS = GetTimestampMicroS();
+            tasks.push_back([=](const TaskContext&) noexcept
+            {
+                ProcessRequest(request, startTimeMicroS);
+            });
+        }
+        
+        lock.unlock();
+        
+        if (!tasks.empty())
+        {
+            m_taskPool->AddTasks(tasks);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    FileTaskQueue::RequestSPtr FileTaskQueue::PopNextRequest() noexcept
+    {
+        for (auto& queue : m_queues)
+        {
+            while (!queue.empty())
+            {
+                auto request = queue.front();
+                queue.pop_front();
+                
+                if (request->m_isStarted || request->m_tasks.empty())
+                {
+                    continue;
+                }
+                
+                request->m_isStarted = true;
+                
+                for (const auto& entry : request->m_tasks)
+                {
+                    m_pendingTasks.erase(entry.first);
+                }
+                
+                if (!request->m_coalescingKey.empty())
+                {
+                    m_coalescableRequests.erase(request->m_coalescingKey);
+                }
+                
+                return request;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    //------------------------------------------------------------------------------
+    void FileTaskQueue::ProcessRequest(const RequestSPtr& request, u64 startTimeMicroS) noexcept
+    {
+        for (const auto& entry : request->m_tasks)
+        {
+            entry.second(TaskContext(TaskType::k_file));
+        }
+        
+        auto endTimeMicroS = GetTimestampMicroS();
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        m_stats.m_queueWaitTimes.Add(startTimeMicroS - request->m_queuedTimeMicroS);
+        m_stats.m_serviceTimes.Add(endTimeMicroS - startTimeMicroS);
+        ++m_stats.m_numRequestsCompleted;
+        
+        --m_numRunningRequests;
+        StartRequests(lock);
+    }
+}
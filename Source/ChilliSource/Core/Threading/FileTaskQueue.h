@@ -0,0 +1,220 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_THREADING_FILETASKQUEUE_H_
+#define _CHILLISOURCE_CORE_THREADING_FILETASKQUEUE_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Threading/FileTaskPriority.h>
+#include <ChilliSource/Core/Threading/Task.h>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ChilliSource
+{
+    /// The queue through which all file tasks are scheduled. File tasks are run on the
+    /// large task pool. By default they are run serially, but the number of tasks in
+    /// flight at once can be raised for storage which serves concurrent reads faster.
+    ///
+    /// Tasks are started in priority order, and in the order they were added within a
+    /// priority. Tasks which share a coalescing key, typically the path of the file they
+    /// read, are merged into a single request while they are waiting. The request takes
+    /// one slot, and its tasks are run one after another, so they can share a single read
+    /// of the file. A pending task can be cancelled up until it starts.
+    ///
+    /// Histograms of the time requests spend waiting in the queue, and the time taken to
+    /// service them, are recorded for tuning the concurrency limit.
+    ///
+    /// This is thread-safe.
+    ///
+    class FileTaskQueue final
+    {
+    public:
+        CS_DECLARE_NOCOPY(FileTaskQueue);
+        
+        using TaskId = u64;
+        
+        static constexpr TaskId k_invalidTaskId = 0;
+        static constexpr u32 k_defaultMaxConcurrentTasks = 1;
+        static constexpr u32 k_numHistogramBuckets = 12;
+        
+        /// A histogram of durations. Bucket i holds durations of up to 2^i milliseconds,
+        /// and which are greater than the previous bucket's bound. The final bucket holds
+        /// everything else.
+        ///
+        struct Histogram final
+        {
+            /// @param bucketIndex
+            ///     The index of the bucket.
+            ///
+            /// @return The upper bound of the bucket in milliseconds. This is infinity for
+            ///     the final bucket.
+            ///
+            static f64 GetBucketUpperBoundMS(u32 bucketIndex) noexcept;
+            
+            /// Adds a duration to the histogram.
+            ///
+            /// @param durationMicroS
+            ///     The duration in microseconds.
+            ///
+            void Add(u64 durationMicroS) noexcept;
+            
+            std::array<u32, k_numHistogramBuckets> m_counts = {{}};
+        };
+        
+        /// Statistics on the requests processed by the queue.
+        ///
+        struct Stats final
+        {
+            Histogram m_queueWaitTimes;
+            Histogram m_serviceTimes;
+            u32 m_numRequestsCompleted = 0;
+            u32 m_numTasksCoalesced = 0;
+            u32 m_numTasksCancelled = 0;
+        };
+        
+        /// @param taskPool
+        ///     The task pool on which file tasks are run. This must outlive the queue.
+        /// @param maxConcurrentTasks
+        ///     The maximum number of requests which can be in flight at once.
+        ///
+        FileTaskQueue(TaskPool* taskPool, u32 maxConcurrentTasks = k_defaultMaxConcurrentTasks) noexcept;
+        
+        /// Adds a task to the queue.
+        ///
+        /// @param priority
+        ///     The priority of the task.
+        /// @param task
+        ///     The task. This is provided with a k_file task context.
+        /// @param coalescingKey
+        ///     (Optional) If a pending request has the same key then the task is added to it
+        ///     rather than creating a new request, and the request takes the higher of the
+        ///     two priorities. Coalesced tasks are run one after another on the same thread,
+        ///     in the order they were added. An empty key never coalesces.
+        ///
+        /// @return The id of the task, which can be used to cancel it.
+        ///
+        TaskId Add(FileTaskPriority priority, const Task& task, const std::string& coalescingKey = "") noexcept;
+        
+        /// Cancels a task which has not yet been started.
+        ///
+        /// @param taskId
+        ///     The id of the task.
+        ///
+        /// @return Whether or not the task was cancelled. This is false if the task has
+        ///     already been started.
+        ///
+        bool Cancel(TaskId taskId) noexcept;
+        
+        /// Sets the maximum number of requests which can be in flight at once. If this is
+        /// lower than the number currently in flight, the running requests are allowed to
+        /// finish. Raising it above 1 means file tasks no longer run serially, so it should
+        /// only be done if every file task in the application is safe to run concurrently.
+        ///
+        /// @param maxConcurrentTasks
+        ///     The maximum number of concurrent requests. Must be at least 1.
+        ///
+        void SetMaxConcurrentTasks(u32 maxConcurrentTasks) noexcept;
+        
+        /// @return The maximum number of requests which can be in flight at once.
+        ///
+        u32 GetMaxConcurrentTasks() const noexcept;
+        
+        /// @return The number of tasks waiting to be started.
+        ///
+        u32 GetNumPendingTasks() const noexcept;
+        
+        /// @return The statistics recorded since the queue was created, or since the last
+        ///     call to ResetStats().
+        ///
+        Stats GetStats() const noexcept;
+        
+        /// Clears all recorded statistics.
+        ///
+        void ResetStats() noexcept;
+        
+    private:
+        /// A group of tasks which are started together. This typically contains a single
+        /// task unless other tasks have been coalesced into it.
+        ///
+        struct Request final
+        {
+            std::vector<std::pair<TaskId, Task>> m_tasks;
+            FileTaskPriority m_priority;
+            std::string m_coalescingKey;
+            u64 m_queuedTimeMicroS = 0;
+            bool m_isStarted = false;
+        };
+        
+        using RequestSPtr = std::shared_ptr<Request>;
+        
+        /// Starts as many pending requests as the concurrency limit allows. The lock is
+        /// released before the requests are passed to the task pool.
+        ///
+        /// @param lock
+        ///     The lock on the queue mutex, which must be held.
+        ///
+        void StartRequests(std::unique_lock<std::mutex>& lock) noexcept;
+        
+        /// Removes the highest priority pending request from the queues, marking it as
+        /// started. Stale entries for requests which have been started or emptied by
+        /// cancellation are discarded along the way.
+        ///
+        /// The queue mutex must be held.
+        ///
+        /// @return The request, or null if there are none pending.
+        ///
+        RequestSPtr PopNextRequest() noexcept;
+        
+        /// Runs each task in the request and records its timings, then starts the next
+        /// requests.
+        ///
+        /// @param request
+        ///     The request to process.
+        /// @param startTimeMicroS
+        ///     The time at which the request was removed from the queue.
+        ///
+        void ProcessRequest(const RequestSPtr& request, u64 startTimeMicroS) noexcept;
+        
+        TaskPool* m_taskPool;
+        
+        mutable std::mutex m_mutex;
+        std::array<std::deque<RequestSPtr>, u32(FileTaskPriority::k_total)> m_queues;
+        std::unordered_map<TaskId, RequestSPtr> m_pendingTasks;
+        std::unordered_map<std::string, RequestSPtr> m_coalescableRequests;
+        TaskId m_nextTaskId = k_invalidTaskId + 1;
+        u32 m_maxConcurrentTasks;
+        u32 m_numRunningRequests = 0;
+        Stats m_stats;
+    };
+}
+
+#endif
@@ -0,0 +1,269 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Threading/TaskGraph.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace ChilliSource
+{
+    /// The state shared by a task graph and all of its nodes. This is kept alive by any
+    /// node which has not yet finished, so that graphs can be destroyed while their tasks
+    /// are in flight.
+    ///
+    struct TaskGraphState final
+    {
+        TaskScheduler* m_taskScheduler = nullptr;
+        std::atomic<bool> m_isCancelled;
+    };
+    
+    /// A single task in a task graph. The node is started once its pending dependency count
+    /// reaches zero, and on finishing it notifies each of its continuations.
+    ///
+    struct TaskGraphNode final
+    {
+        std::shared_ptr<TaskGraphState> m_graphState;
+        TaskType m_taskType = TaskType::k_small;
+        Task m_task;
+        
+        std::atomic<u32> m_numPendingDependencies;
+        std::atomic<bool> m_isFinished;
+        std::atomic<bool> m_isCancelled;
+        
+        std::mutex m_continuationsMutex;
+        std::vector<std::shared_ptr<TaskGraphNode>> m_continuations;
+    };
+    
+    namespace
+    {
+        bool TryScheduleNode(const std::shared_ptr<TaskGraphNode>& node) noexcept;
+        
+        /// Marks the node as finished and notifies each of its continuations that one of
+        /// their dependencies has finished. Continuations which can be finished immediately,
+        /// because they have no task or their graph was cancelled, are finished in turn. This
+        /// is done iteratively so long chains of such nodes cannot overflow the stack.
+        ///
+        /// @param node
+        ///     The node which has finished.
+        ///
+        void FinishNode(const std::shared_ptr<TaskGraphNode>& node) noexcept
+        {
+            std::vector<std::shared_ptr<TaskGraphNode>> nodesToFinish { node };
+            std::vector<std::shared_ptr<TaskGraphNode>> continuations;
+            
+            while (!nodesToFinish.empty())
+            {
+                auto nodeToFinish = std::move(nodesToFinish.back());
+                nodesToFinish.pop_back();
+                
+                std::unique_lock<std::mutex> lock(nodeToFinish->m_continuationsMutex);
+                nodeToFinish->m_isFinished = true;
+                continuations.swap(nodeToFinish->m_continuations);
+                lock.unlock();
+                
+                for (const auto& continuation : continuations)
+                {
+                    if (--continuation->m_numPendingDependencies == 0 && !TryScheduleNode(continuation))
+                    {
+                        nodesToFinish.push_back(continuation);
+                    }
+                }
+                
+                continuations.clear();
+            }
+        }
+        
+        /// Schedules the task of a node whose dependencies have all finished. Nodes without
+        /// a task, and nodes in a cancelled graph, are not scheduled and should be finished
+        /// immediately by the caller.
+        ///
+        /// @param node
+        ///     The node to schedule.
+        ///
+        /// @return Whether or not the node was scheduled.
+        ///
+        bool TryScheduleNode(const std::shared_ptr<TaskGraphNode>& node) noexcept
+        {
+            if (!node->m_task)
+            {
+                return false;
+            }
+            
+            if (node->m_graphState->m_isCancelled)
+            {
+                node->m_isCancelled = true;
+                node->m_task = nullptr;
+                return false;
+            }
+            
+            node->m_graphState->m_taskScheduler->ScheduleTask(node->m_taskType, [=](const TaskContext& taskContext) noexcept
+            {
+                if (node->m_graphState->m_isCancelled)
+                {
+                    node->m_isCancelled = true;
+                }
+                else
+                {
+                    node->m_task(taskContext);
+                }
+                
+                node->m_task = nullptr;
+                FinishNode(node);
+            });
+            
+            return true;
+        }
+        
+        /// Starts a node whose dependencies have all finished, either scheduling its task
+        /// or finishing it immediately.
+        ///
+        /// @param node
+        ///     The node to start.
+        ///
+        void StartNode(const std::shared_ptr<TaskGraphNode>& node) noexcept
+        {
+            if (!TryScheduleNode(node))
+            {
+                FinishNode(node);
+            }
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskHandle::TaskHandle(const std::shared_ptr<TaskGraphNode>& node) noexcept
+        : m_node(node)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    bool TaskHandle::IsValid() const noexcept
+    {
+        return (m_node != nullptr);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool TaskHandle::IsFinished() const noexcept
+    {
+        CS_ASSERT(m_node, "Cannot query an invalid task handle.");
+        
+        return m_node->m_isFinished;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool TaskHandle::IsCancelled() const noexcept
+    {
+        CS_ASSERT(m_node, "Cannot query an invalid task handle.");
+        
+        return m_node->m_isCancelled;
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskGraph::TaskGraph() noexcept
+        : m_state(std::make_shared<TaskGraphState>())
+    {
+        m_state->m_taskScheduler = Application::Get()->GetTaskScheduler();
+        m_state->m_isCancelled = false;
+        
+        CS_ASSERT(m_state->m_taskScheduler, "Task graphs require the task scheduler.");
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskHandle TaskGraph::Add(TaskType taskType, const Task& task) noexcept
+    {
+        return Add(taskType, task, std::vector<TaskHandle>());
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskHandle TaskGraph::Add(TaskType taskType, const Task& task, const std::vector<TaskHandle>& dependencies) noexcept
+    {
+        auto node = std::make_shared<TaskGraphNode>();
+        node->m_graphState = m_state;
+        node->m_taskType = taskType;
+        node->m_task = task;
+        node->m_isFinished = false;
+        node->m_isCancelled = false;
+        
+        //The count starts with an extra reference which is only released once all dependencies have been
+        //registered, ensuring the node cannot be started while it is still being set up.
+        node->m_numPendingDependencies = 1;
+        
+        for (const auto& dependency : dependencies)
+        {
+            if (!dependency.IsValid())
+            {
+                continue;
+            }
+            
+            ++node->m_numPendingDependencies;
+            
+            std::unique_lock<std::mutex> lock(dependency.m_node->m_continuationsMutex);
+            if (dependency.m_node->m_isFinished)
+            {
+                lock.unlock();
+                --node->m_numPendingDependencies;
+            }
+            else
+            {
+                dependency.m_node->m_continuations.push_back(node);
+            }
+        }
+        
+        if (--node->m_numPendingDependencies == 0)
+        {
+            StartNode(node);
+        }
+        
+        return TaskHandle(node);
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskHandle TaskGraph::Then(const TaskHandle& dependency, TaskType taskType, const Task& task) noexcept
+    {
+        return Add(taskType, task, std::vector<TaskHandle>{ dependency });
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskHandle TaskGraph::WhenAll(const std::vector<TaskHandle>& dependencies) noexcept
+    {
+        return Add(TaskType::k_small, nullptr, dependencies);
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskGraph::Cancel() noexcept
+    {
+        m_state->m_isCancelled = true;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool TaskGraph::IsCancelled() const noexcept
+    {
+        return m_state->m_isCancelled;
+    }
+}
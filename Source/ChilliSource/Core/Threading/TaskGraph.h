@@ -0,0 +1,167 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_CORE_THREADING_TASKGRAPH_H_
+#define _CHILLISOURCE_CORE_THREADING_TASKGRAPH_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Threading/Task.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include <memory>
+#include <vector>
+
+namespace ChilliSource
+{
+    struct TaskGraphNode;
+    struct TaskGraphState;
+    
+    /// A handle to a task which has been added to a task graph. Handles can be used as
+    /// dependencies of other tasks, or to query whether or not the task has finished.
+    ///
+    /// Handles are cheap to copy and remain valid after the task has finished, and after the
+    /// graph that created them has been destroyed.
+    ///
+    /// This is thread-safe.
+    ///
+    class TaskHandle final
+    {
+    public:
+        TaskHandle() = default;
+        
+        /// @return Whether or not this refers to a task. Default constructed handles do not.
+        ///
+        bool IsValid() const noexcept;
+        
+        /// @return Whether or not the task has finished. This is true for tasks that were
+        ///     skipped because their graph was cancelled.
+        ///
+        bool IsFinished() const noexcept;
+        
+        /// @return Whether or not the task was skipped because its graph was cancelled before
+        ///     it could be run.
+        ///
+        bool IsCancelled() const noexcept;
+        
+    private:
+        friend class TaskGraph;
+        
+        /// @param node
+        ///     The node this handle refers to.
+        ///
+        TaskHandle(const std::shared_ptr<TaskGraphNode>& node) noexcept;
+        
+        std::shared_ptr<TaskGraphNode> m_node;
+    };
+    
+    /// Builds and schedules dependency graphs of tasks on top of the TaskScheduler. Each task
+    /// is scheduled with the scheduler as soon as all of its dependencies have finished, so
+    /// no thread is blocked waiting on another task. For example, a resource provider can
+    /// load a file as a k_file task, decode it with a dependent k_large task and then upload
+    /// it with a dependent k_mainThread task.
+    ///
+    /// Dependencies can be on tasks from any graph, but cancellation applies per graph:
+    /// once a graph is cancelled any of its tasks which have not yet started are skipped.
+    /// Skipped tasks still count as finished, so continuations in other graphs will still
+    /// run.
+    ///
+    /// Destroying the graph does not cancel or wait on any of its tasks.
+    ///
+    /// This is thread-safe.
+    ///
+    class TaskGraph final
+    {
+    public:
+        CS_DECLARE_NOCOPY(TaskGraph);
+        
+        /// Creates a new, empty graph which schedules with the application's task scheduler.
+        ///
+        TaskGraph() noexcept;
+        
+        /// Adds a task to the graph which is scheduled immediately.
+        ///
+        /// @param taskType
+        ///     The type of task.
+        /// @param task
+        ///     The task.
+        ///
+        /// @return A handle to the task.
+        ///
+        TaskHandle Add(TaskType taskType, const Task& task) noexcept;
+        
+        /// Adds a task to the graph which is scheduled once all of the given dependencies
+        /// have finished.
+        ///
+        /// @param taskType
+        ///     The type of task.
+        /// @param task
+        ///     The task.
+        /// @param dependencies
+        ///     The tasks which must finish before this one is scheduled. Invalid handles are
+        ///     ignored.
+        ///
+        /// @return A handle to the task.
+        ///
+        TaskHandle Add(TaskType taskType, const Task& task, const std::vector<TaskHandle>& dependencies) noexcept;
+        
+        /// Adds a continuation: a task which is scheduled once the given task has finished.
+        ///
+        /// @param dependency
+        ///     The task which must finish first.
+        /// @param taskType
+        ///     The type of the continuation task.
+        /// @param task
+        ///     The continuation task.
+        ///
+        /// @return A handle to the continuation task.
+        ///
+        TaskHandle Then(const TaskHandle& dependency, TaskType taskType, const Task& task) noexcept;
+        
+        /// Creates a handle which finishes once all of the given tasks have finished. No task
+        /// is scheduled, so this is a cheap way to join several branches of a graph.
+        ///
+        /// @param dependencies
+        ///     The tasks to join.
+        ///
+        /// @return A handle which finishes with the last of the dependencies.
+        ///
+        TaskHandle WhenAll(const std::vector<TaskHandle>& dependencies) noexcept;
+        
+        /// Cancels the graph. Any tasks in the graph which have not yet started will be
+        /// skipped, as will any tasks which are added later. Tasks which are already running
+        /// will run to completion; long tasks can poll IsCancelled() to finish early.
+        ///
+        void Cancel() noexcept;
+        
+        /// @return Whether or not the graph has been cancelled.
+        ///
+        bool IsCancelled() const noexcept;
+        
+    private:
+        std::shared_ptr<TaskGraphState> m_state;
+    };
+}
+
+#endif
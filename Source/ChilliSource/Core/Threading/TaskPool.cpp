@@ -28,27 +28,48 @@
 
 #include <ChilliSource/Core/Threading/TaskPool.h>
 
-#include <ChilliSource/Core/Delegate/MakeDelegate.h>
+#include <ChilliSource/Core/String/ToString.h>
 #include <ChilliSource/Core/Threading/TaskType.h>
+#include <ChilliSource/Core/Time/Profiler.h>
 
 #ifdef CS_TARGETPLATFORM_ANDROID
 #   include <CSBackend/Platform/Android/Main/JNI/Core/Java/JavaVirtualMachine.h>
 #endif
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 namespace ChilliSource
 {
+    namespace
+    {
+        constexpr std::size_t k_workerQueueCapacity = 4096;
+        constexpr std::size_t k_taskSlotBlockSize = 1024;
+        constexpr std::size_t k_taskSlotBatchSize = 64;
+    }
+    
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     TaskPool::TaskPool(TaskType in_taskType, u32 in_numThreads) noexcept
-        : m_numThreads(in_numThreads), m_taskContext(in_taskType, this), m_isFinished(false), m_taskCountHeuristic(0)
+        : m_numThreads(in_numThreads), m_taskContext(in_taskType, this), m_taskSlots(k_taskSlotBlockSize), m_numSpareTaskSlots(0), m_sharedQueueSize(0), m_taskCountHeuristic(0), m_numSleepingThreads(0), m_numSleepingYielders(0), m_isWakingThread(false), m_isFinished(false)
     {
         CS_ASSERT(in_taskType == TaskType::k_small || in_taskType == TaskType::k_large, "Task type must be small or large");
         
+        m_workerQueues.reserve(m_numThreads);
         for (u32 i = 0; i < m_numThreads; ++i)
         {
-            m_threads.push_back(std::thread(MakeDelegate(this, &TaskPool::ProcessTasks)));
+            m_workerQueues.push_back(std::unique_ptr<work_stealing_queue<Task>>(new work_stealing_queue<Task>(k_workerQueueCapacity)));
+            m_workerFreeTaskSlots.push_back(std::unique_ptr<std::vector<Task*>>(new std::vector<Task*>()));
+            m_workerFreeTaskSlots.back()->reserve(2 * k_taskSlotBatchSize);
+        }
+        
+        m_threads.reserve(m_numThreads);
+        m_threadIds.reserve(m_numThreads);
+        for (u32 i = 0; i < m_numThreads; ++i)
+        {
+            m_threads.push_back(std::thread(&TaskPool::ProcessTasks, this, i));
+            m_threadIds.push_back(m_threads.back().get_id());
         }
     }
     //------------------------------------------------------------------------------
@@ -61,84 +82,300 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void TaskPool::AddTasks(const std::vector<Task>& in_tasks) noexcept
     {
-        std::unique_lock<std::mutex> queueLock(m_taskQueueMutex);
-        m_taskQueue.insert(m_taskQueue.begin(), in_tasks.begin(), in_tasks.end());
+        if (in_tasks.empty())
+        {
+            return;
+        }
+        
+        //The count is incremented before the tasks are pushed so that it can never
+        //underflow when another thread takes one of them.
         m_taskCountHeuristic += u32(in_tasks.size());
         
-        if (in_tasks.size() > 1)
+        u32 workerIndex = GetCurrentWorkerIndex();
+        if (workerIndex != k_noWorker)
         {
-            m_emptyWaitCondition.notify_all();
+            auto& queue = m_workerQueues[workerIndex];
+            std::vector<Task> overflow;
+            
+            for (const auto& task : in_tasks)
+            {
+                Task* taskCopy = AcquireTaskSlot(workerIndex, task);
+                if (!queue->push(taskCopy))
+                {
+                    overflow.push_back(std::move(*taskCopy));
+                    ReleaseTaskSlot(workerIndex, taskCopy);
+                }
+            }
+            
+            if (!overflow.empty())
+            {
+                std::unique_lock<std::mutex> queueLock(m_sharedQueueMutex);
+                std::move(overflow.begin(), overflow.end(), std::back_inserter(m_sharedQueue));
+                m_sharedQueueSize.store(u32(m_sharedQueue.size()), std::memory_order_relaxed);
+            }
         }
         else
         {
-            m_emptyWaitCondition.notify_one();
+            std::unique_lock<std::mutex> queueLock(m_sharedQueueMutex);
+            m_sharedQueue.insert(m_sharedQueue.end(), in_tasks.begin(), in_tasks.end());
+            m_sharedQueueSize.store(u32(m_sharedQueue.size()), std::memory_order_relaxed);
         }
+        
+        WakeThreads();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
     void TaskPool::AddTasksAndYield(const std::vector<Task>& in_tasks) noexcept
     {
-        std::atomic<u32> taskCount(u32(in_tasks.size()));
-        std::atomic<bool> finished(false);
+        //The wrapped tasks only capture two references so they fit in std::function's
+        //small buffer and don't allocate.
+        struct YieldState
+        {
+            TaskPool* m_taskPool;
+            std::atomic<u32> m_taskCount;
+            std::atomic<bool> m_finished;
+        };
+        YieldState yieldState { this, { u32(in_tasks.size()) }, { false } };
         
         std::vector<Task> tasksWithCounter;
+        tasksWithCounter.reserve(in_tasks.size());
         for (const auto& task : in_tasks)
         {
-            tasksWithCounter.push_back([=, &task, &taskCount, &finished](const TaskContext& in_taskContext) noexcept
+            tasksWithCounter.push_back([&task, &yieldState](const TaskContext& in_taskContext) noexcept
             {
                 task(in_taskContext);
 
-                if (--taskCount == 0)
+                if (--yieldState.m_taskCount == 0)
                 {
-                    std::unique_lock<std::mutex> queueLock(m_taskQueueMutex);
-                    finished = true;
-                    m_emptyWaitCondition.notify_all();
+                    //Sleeping threads are only woken if the yielding thread is one of them, otherwise
+                    //every join would wake all idle workers for nothing.
+                    auto taskPool = yieldState.m_taskPool;
+                    std::unique_lock<std::mutex> sleepLock(taskPool->m_sleepMutex);
+                    yieldState.m_finished = true;
+                    if (taskPool->m_numSleepingYielders > 0)
+                    {
+                        taskPool->m_sleepCondition.notify_all();
+                    }
                 }
             });
         }
         
         AddTasks(tasksWithCounter);
         
-        while (!finished)
+        u32 workerIndex = GetCurrentWorkerIndex();
+        while (!yieldState.m_finished)
+        {
+            PerformTask(workerIndex, yieldState.m_finished, true);
+        }
+        
+        //Ensure the thread which set the flag has released the sleep mutex before the
+        //flag goes out of scope.
+        std::unique_lock<std::mutex> sleepLock(m_sleepMutex);
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    u32 TaskPool::GetCurrentWorkerIndex() const noexcept
+    {
+        auto threadId = std::this_thread::get_id();
+        for (u32 i = 0; i < u32(m_threadIds.size()); ++i)
+        {
+            if (m_threadIds[i] == threadId)
+            {
+                return i;
+            }
+        }
+        
+        return k_noWorker;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    Task* TaskPool::AcquireTaskSlot(u32 in_workerIndex, const Task& in_task) noexcept
+    {
+        auto& freeTaskSlots = *m_workerFreeTaskSlots[in_workerIndex];
+        if (freeTaskSlots.empty() && m_numSpareTaskSlots > 0)
+        {
+            std::unique_lock<std::mutex> spareLock(m_spareTaskSlotsMutex);
+            auto count = std::min(m_spareTaskSlots.size(), k_taskSlotBatchSize);
+            freeTaskSlots.insert(freeTaskSlots.end(), m_spareTaskSlots.end() - count, m_spareTaskSlots.end());
+            m_spareTaskSlots.resize(m_spareTaskSlots.size() - count);
+            m_numSpareTaskSlots.store(u32(m_spareTaskSlots.size()), std::memory_order_relaxed);
+        }
+        
+        if (freeTaskSlots.empty())
+        {
+            Task* taskSlot = m_taskSlots.allocate(in_task);
+            
+            //Every slot can end up spare, so space is reserved for all of them to ensure
+            //that moving slots there never allocates.
+            std::unique_lock<std::mutex> spareLock(m_spareTaskSlotsMutex);
+            m_spareTaskSlots.reserve(m_taskSlots.capacity());
+            return taskSlot;
+        }
+        
+        Task* taskSlot = freeTaskSlots.back();
+        freeTaskSlots.pop_back();
+        *taskSlot = in_task;
+        return taskSlot;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TaskPool::ReleaseTaskSlot(u32 in_workerIndex, Task* in_taskSlot) noexcept
+    {
+        //The task is cleared so that its captures are destroyed now, rather than
+        //when the slot is next used.
+        *in_taskSlot = nullptr;
+        
+        if (in_workerIndex == k_noWorker)
+        {
+            std::unique_lock<std::mutex> spareLock(m_spareTaskSlotsMutex);
+            m_spareTaskSlots.push_back(in_taskSlot);
+            m_numSpareTaskSlots.store(u32(m_spareTaskSlots.size()), std::memory_order_relaxed);
+            return;
+        }
+        
+        //Tasks are often added by one worker and run by another, so free slots are
+        //handed back in batches to stop them building up on the workers that run tasks.
+        auto& freeTaskSlots = *m_workerFreeTaskSlots[in_workerIndex];
+        freeTaskSlots.push_back(in_taskSlot);
+        if (freeTaskSlots.size() >= 2 * k_taskSlotBatchSize)
         {
-            PerformTask(finished);
+            std::unique_lock<std::mutex> spareLock(m_spareTaskSlotsMutex);
+            m_spareTaskSlots.insert(m_spareTaskSlots.end(), freeTaskSlots.end() - k_taskSlotBatchSize, freeTaskSlots.end());
+            m_numSpareTaskSlots.store(u32(m_spareTaskSlots.size()), std::memory_order_relaxed);
+            spareLock.unlock();
+            
+            freeTaskSlots.resize(freeTaskSlots.size() - k_taskSlotBatchSize);
         }
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
-    void TaskPool::PerformTask(const std::atomic<bool>& in_forceContinue) noexcept
+    Task* TaskPool::TryAcquireTask(u32 in_workerIndex, Task& out_sharedTask) noexcept
     {
-        std::unique_lock<std::mutex> queueLock(m_taskQueueMutex);
+        if (in_workerIndex != k_noWorker)
+        {
+            Task* task = m_workerQueues[in_workerIndex]->pop();
+            if (task)
+            {
+                return task;
+            }
+        }
         
-        if (m_taskQueue.empty() && !in_forceContinue)
+        if (m_sharedQueueSize > 0)
         {
-            m_emptyWaitCondition.wait(queueLock);
+            std::unique_lock<std::mutex> queueLock(m_sharedQueueMutex);
+            if (!m_sharedQueue.empty())
+            {
+                out_sharedTask = std::move(m_sharedQueue.front());
+                m_sharedQueue.pop_front();
+                m_sharedQueueSize.store(u32(m_sharedQueue.size()), std::memory_order_relaxed);
+                return &out_sharedTask;
+            }
         }
         
-        if (m_taskQueue.empty())
+        u32 startIndex = (in_workerIndex != k_noWorker) ? in_workerIndex + 1 : 0;
+        for (u32 i = 0; i < m_numThreads; ++i)
         {
+            u32 victimIndex = (startIndex + i) % m_numThreads;
+            if (victimIndex == in_workerIndex)
+            {
+                continue;
+            }
+            
+            Task* task = m_workerQueues[victimIndex]->steal();
+            if (task)
+            {
+                return task;
+            }
+        }
+        
+        return nullptr;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TaskPool::WakeThreads() noexcept
+    {
+        //Only one thread is woken at a time. Until it is running, further wakes would
+        //only cost a system call each without getting any more threads working.
+        if (m_numSleepingThreads == 0 || m_isWakingThread || m_isWakingThread.exchange(true))
+        {
+            return;
+        }
+        
+        std::unique_lock<std::mutex> sleepLock(m_sleepMutex);
+        if (m_numSleepingThreads == 0)
+        {
+            m_isWakingThread = false;
             return;
         }
         
-        Task task = m_taskQueue.front();
-        m_taskQueue.pop_front();
-        --m_taskCountHeuristic;
+        //At least one sleeping thread is waiting on the condition, and the flag is
+        //cleared by whichever thread is woken.
+        m_sleepCondition.notify_one();
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TaskPool::PerformTask(u32 in_workerIndex, const std::atomic<bool>& in_forceContinue, bool in_isYielding) noexcept
+    {
+        Task sharedTask;
+        Task* task = TryAcquireTask(in_workerIndex, sharedTask);
+        
+        if (!task)
+        {
+            //The task count is checked after registering as a sleeping thread, and it is
+            //incremented before checking for sleeping threads when adding, so at least
+            //one side is guaranteed to see the other.
+            std::unique_lock<std::mutex> sleepLock(m_sleepMutex);
+            ++m_numSleepingThreads;
+            if (in_isYielding)
+            {
+                ++m_numSleepingYielders;
+            }
+            
+            while (m_taskCountHeuristic == 0 && !in_forceContinue)
+            {
+                m_sleepCondition.wait(sleepLock);
+                m_isWakingThread = false;
+            }
             
-        queueLock.unlock();
+            if (in_isYielding)
+            {
+                --m_numSleepingYielders;
+            }
+            --m_numSleepingThreads;
+            return;
+        }
+        
+        //Only one thread is woken per batch of tasks. If there is still work left once it
+        //has taken a task then another thread is woken, so idle threads join in as long
+        //as there is work for them without all being woken at once.
+        if (--m_taskCountHeuristic > 0)
+        {
+            WakeThreads();
+        }
+        
+        {
+            CS_PROFILE_ZONE("TaskPool::PerformTask");
+            (*task)(m_taskContext);
+        }
         
-        task(m_taskContext);
+        if (task != &sharedTask)
+        {
+            ReleaseTaskSlot(in_workerIndex, task);
+        }
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
-    void TaskPool::ProcessTasks() noexcept
+    void TaskPool::ProcessTasks(u32 in_workerIndex) noexcept
     {
 #ifdef CS_TARGETPLATFORM_ANDROID
         CSBackend::Android::JavaVirtualMachine::Get()->AttachCurrentThread();
 #endif
 
+        CS_PROFILE_THREAD_NAME(std::string(m_taskContext.GetType() == TaskType::k_small ? "Small" : "Large") + " Task Worker " + ToString(in_workerIndex));
+        
         while (!m_isFinished || m_taskCountHeuristic > 0)
         {
-            PerformTask(m_isFinished);
+            PerformTask(in_workerIndex, m_isFinished, false);
         }
         
 #ifdef CS_TARGETPLATFORM_ANDROID
@@ -149,14 +386,29 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     TaskPool::~TaskPool() noexcept
     {
-        std::unique_lock<std::mutex> queueLock(m_taskQueueMutex);
+        std::unique_lock<std::mutex> sleepLock(m_sleepMutex);
         m_isFinished = true;
-        queueLock.unlock();
+        sleepLock.unlock();
         
-        m_emptyWaitCondition.notify_all();
+        m_sleepCondition.notify_all();
         for (auto& thread : m_threads)
         {
             thread.join();
         }
+        
+        CS_ASSERT(m_sharedQueue.empty(), "All tasks should have been processed before the task pool is destroyed.");
+        
+        for (auto& freeTaskSlots : m_workerFreeTaskSlots)
+        {
+            for (auto taskSlot : *freeTaskSlots)
+            {
+                m_taskSlots.deallocate(taskSlot);
+            }
+        }
+        
+        for (auto taskSlot : m_spareTaskSlots)
+        {
+            m_taskSlots.deallocate(taskSlot);
+        }
     }
 }
@@ -30,11 +30,14 @@
 #define _CHILLISOURCE_CORE_THREADING_TASKPOOL_H_
 
 #include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Container/concurrent_object_pool.h>
+#include <ChilliSource/Core/Container/work_stealing_queue.h>
 #include <ChilliSource/Core/Threading/TaskContext.h>
 
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <limits>
 #include <mutex>
 #include <thread>
 
@@ -44,9 +47,24 @@ namespace ChilliSource
     /// A collection of tasks which will be performed on one of the worker threads
     /// owned by the pool.
     ///
-    /// Currently this does no task stealing or other clever tricks for performance;
-    /// all tasks are drawn from a single global queue which is locked on every
-    /// access.
+    /// Each worker thread owns a lock-free work stealing queue. Tasks added from a
+    /// worker thread are pushed onto that thread's queue and processed in LIFO
+    /// order, which keeps child tasks hot in the cache. Tasks added from any other
+    /// thread go into a shared queue. Idle workers first check their own queue,
+    /// then the shared queue, and finally try to steal the oldest task from
+    /// another worker's queue. Threads only lock when the shared queue is used or
+    /// when there is no work available and they need to sleep.
+    ///
+    /// Tasks in worker queues are stored in slots taken from an object pool, so
+    /// adding a task from a worker doesn't allocate once the pool has grown to the
+    /// peak number of queued tasks. Each worker caches free slots, so taking and
+    /// releasing them is usually free of atomics. The shared queue stores tasks by
+    /// value, as it is only accessed under its lock. Tasks whose captures don't
+    /// fit within std::function's small buffer will still allocate when copied.
+    ///
+    /// Only one sleeping thread is woken when tasks are added. Once it has taken
+    /// a task it wakes another if there is still work left, so idle threads join
+    /// in one at a time rather than all contending for the queues at once.
     ///
     /// This is thread-safe.
     ///
@@ -99,36 +117,103 @@ namespace ChilliSource
         ~TaskPool() noexcept;
         
     private:
+        static constexpr u32 k_noWorker = std::numeric_limits<u32>::max();
+        
         //------------------------------------------------------------------------------
-        /// Performs a task from the task pool. This must be called from one of the
-        /// threads owned by the task pool.
+        /// @return The index of the worker thread owned by this pool that the calling
+        /// thread represents, or k_noWorker if called from any other thread.
+        //------------------------------------------------------------------------------
+        u32 GetCurrentWorkerIndex() const noexcept;
+        //------------------------------------------------------------------------------
+        /// Takes a slot for a task which is about to be pushed onto a worker's queue,
+        /// and copies the task into it. Free slots are cached per worker, and are
+        /// only taken from the spare slots, or the task slot pool, when the worker
+        /// has none left.
+        ///
+        /// @param in_workerIndex - The index of the calling worker.
+        /// @param in_task - The task to copy into the slot.
+        ///
+        /// @return The slot containing the task.
+        //------------------------------------------------------------------------------
+        Task* AcquireTaskSlot(u32 in_workerIndex, const Task& in_task) noexcept;
+        //------------------------------------------------------------------------------
+        /// Clears the task in the given slot and returns it to the calling worker's
+        /// cache. Once a worker has cached too many slots a batch of them is moved to
+        /// the spare slots for other workers to use.
+        ///
+        /// @param in_workerIndex - The index of the calling worker, or k_noWorker.
+        /// @param in_taskSlot - The slot to release.
+        //------------------------------------------------------------------------------
+        void ReleaseTaskSlot(u32 in_workerIndex, Task* in_taskSlot) noexcept;
+        //------------------------------------------------------------------------------
+        /// Attempts to take a task from the pool without blocking. The given worker's
+        /// own queue is checked first, followed by the shared queue, and then the
+        /// queues of the other workers are stolen from.
+        ///
+        /// @param in_workerIndex - The index of the calling worker, or k_noWorker.
+        /// @param out_sharedTask - Tasks in the shared queue are stored by value, so
+        /// if one is taken it is moved into this.
+        ///
+        /// @return The task, or null if none were available. Unless it points to the
+        /// given shared task, the caller takes ownership of the task, and must
+        /// return it to the task slot pool.
+        //------------------------------------------------------------------------------
+        Task* TryAcquireTask(u32 in_workerIndex, Task& out_sharedTask) noexcept;
+        //------------------------------------------------------------------------------
+        /// Awakens a single sleeping thread to process newly added tasks. This will
+        /// only lock if there are threads which are actually sleeping.
+        //------------------------------------------------------------------------------
+        void WakeThreads() noexcept;
+        //------------------------------------------------------------------------------
+        /// Performs a task from the task pool. If no task is available then the thread
+        /// will sleep until either a task is added or the force continue flag is set.
         ///
         /// A flag is provided which can be changed by other threads to notify that
         /// the current thread should continue regardless of whether there are any tasks
-        /// available. AwakenAllThreads() can be used in conjunction with this flag.
+        /// available. The sleep mutex must be held when changing the flag, and the
+        /// sleep condition notified.
         ///
         /// @author Ian Copland
         ///
+        /// @param in_workerIndex - The index of the calling worker, or k_noWorker.
         /// @param in_forceContinue - The force continue flag.
+        /// @param in_isYielding - Whether the calling thread is yielding in
+        /// AddTasksAndYield(), rather than processing tasks in ProcessTasks().
         //------------------------------------------------------------------------------
-        void PerformTask(const std::atomic<bool>& in_forceContinue) noexcept;
+        void PerformTask(u32 in_workerIndex, const std::atomic<bool>& in_forceContinue, bool in_isYielding) noexcept;
         //------------------------------------------------------------------------------
         /// Continues to perform tasks until the task pool is deallocated. If there are
         /// no tasks currently available this will sleep until a task is added.
         ///
         /// @author Ian Copland
+        ///
+        /// @param in_workerIndex - The index of the worker this is running on.
         //------------------------------------------------------------------------------
-        void ProcessTasks() noexcept;
+        void ProcessTasks(u32 in_workerIndex) noexcept;
         
         const u32 m_numThreads;
         const TaskContext m_taskContext;
 
+        concurrent_object_pool<Task> m_taskSlots;
+        std::vector<std::unique_ptr<std::vector<Task*>>> m_workerFreeTaskSlots;
+        std::vector<Task*> m_spareTaskSlots;
+        std::atomic<u32> m_numSpareTaskSlots;
+        std::mutex m_spareTaskSlotsMutex;
+        
         std::vector<std::thread> m_threads;
+        std::vector<std::thread::id> m_threadIds;
+        std::vector<std::unique_ptr<work_stealing_queue<Task>>> m_workerQueues;
+        
+        std::deque<Task> m_sharedQueue;
+        std::atomic<u32> m_sharedQueueSize;
+        std::mutex m_sharedQueueMutex;
         
         std::atomic<u32> m_taskCountHeuristic;
-        std::deque<Task> m_taskQueue;
-        std::mutex m_taskQueueMutex;
-        std::condition_variable m_emptyWaitCondition;
+        std::atomic<u32> m_numSleepingThreads;
+        u32 m_numSleepingYielders;
+        std::atomic<bool> m_isWakingThread;
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCondition;
         
         std::atomic<bool> m_isFinished;
     };
@@ -118,18 +118,9 @@ namespace ChilliSource
             }
             case TaskType::k_file:
             {
-                std::unique_lock<std::mutex> lock(m_fileTaskMutex);
-
-                m_fileTaskQueue.insert(m_fileTaskQueue.begin(), in_tasks.begin(), in_tasks.end());
-
-                if (!m_isFileTaskRunning)
+                for (const auto& task : in_tasks)
                 {
-                    m_isFileTaskRunning = true;
-                    auto task = m_fileTaskQueue.front();
-                    m_fileTaskQueue.pop_front();
-                    lock.unlock();
-
-                    StartNextFileTask(task);
+                    m_fileTaskQueue->Add(FileTaskPriority::k_visible, task);
                 }
                 break;
             }
@@ -184,32 +175,9 @@ namespace ChilliSource
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
-    void TaskScheduler::StartNextFileTask(const Task& in_task) noexcept
+    FileTaskQueue* TaskScheduler::GetFileTaskQueue() noexcept
     {
-        std::vector<Task> tasks;
-        tasks.reserve(1);
-
-        tasks.push_back([=](const TaskContext& in_taskContext)
-        {
-            in_task(TaskContext(TaskType::k_file));
-            
-            std::unique_lock<std::mutex> lock(m_fileTaskMutex);
-            
-            if (m_fileTaskQueue.empty())
-            {
-                m_isFileTaskRunning = false;
-                return;
-            }
-            
-            auto task = m_fileTaskQueue.front();
-            m_fileTaskQueue.pop_front();
-            
-            lock.unlock();
-            
-            StartNextFileTask(task);
-        });
-
-        m_largeTaskPool->AddTasks(tasks);
+        return m_fileTaskQueue.get();
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
@@ -227,6 +195,7 @@ namespace ChilliSource
         m_largeTaskPool = TaskPoolUPtr(new TaskPool(TaskType::k_large, threadsPerPool));
         m_mainThreadTaskPool = SingleThreadTaskPoolUPtr(new SingleThreadTaskPool(TaskType::k_mainThread));
         m_systemThreadTaskPool = SingleThreadTaskPoolUPtr(new SingleThreadTaskPool(TaskType::k_system));
+        m_fileTaskQueue = FileTaskQueueUPtr(new FileTaskQueue(m_largeTaskPool.get()));
 
         m_mainThreadId = std::this_thread::get_id();
     }
@@ -237,5 +206,6 @@ namespace ChilliSource
         m_smallTaskPool.reset();
         m_largeTaskPool.reset();
         m_mainThreadTaskPool.reset();
+        m_fileTaskQueue.reset();
     }
 }
\ No newline at end of file
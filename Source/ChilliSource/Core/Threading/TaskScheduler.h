@@ -31,6 +31,7 @@
 
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/System/AppSystem.h>
+#include <ChilliSource/Core/Threading/FileTaskQueue.h>
 #include <ChilliSource/Core/Threading/SingleThreadTaskPool.h>
 #include <ChilliSource/Core/Threading/Task.h>
 #include <ChilliSource/Core/Threading/TaskPool.h>
@@ -113,6 +114,15 @@ namespace ChilliSource
         /// have all completed.
         //------------------------------------------------------------------------------
         void ScheduleTasks(TaskType in_taskType, const std::vector<Task>& in_tasks, const Task& in_completionTask) noexcept;
+        //------------------------------------------------------------------------------
+        /// File tasks scheduled through ScheduleTask() are added to this queue with
+        /// visible priority. The queue can be used directly to schedule file tasks with
+        /// an explicit priority or coalescing key, to cancel pending file tasks, to
+        /// change the number of concurrent file tasks, or to query file task timings.
+        ///
+        /// @return The file task queue.
+        //------------------------------------------------------------------------------
+        FileTaskQueue* GetFileTaskQueue() noexcept;
         
     private:
         friend class Application;
@@ -150,15 +160,6 @@ namespace ChilliSource
         //------------------------------------------------------------------------------
         void ExecuteSystemThreadTasks() noexcept;
     private:
-        //------------------------------------------------------------------------------
-        /// Adds the given task to the large task pool. Once the task is complete then
-        /// this is called again for the next task in the file queue. If the file queue
-        /// is empty then flag indication whether or not file tasks are running is set
-        /// to false.
-        ///
-        /// @author Ian Copland
-        //------------------------------------------------------------------------------
-        void StartNextFileTask(const Task& in_task) noexcept;
         //------------------------------------------------------------------------------
         /// Cleans up the Task Scheduler, joining on all existing threads and then
         /// destroying them.
@@ -185,9 +186,7 @@ namespace ChilliSource
         std::condition_variable m_gameLogicTaskCondition;
         std::mutex m_gameLogicTaskMutex;
         
-        std::mutex m_fileTaskMutex;
-        bool m_isFileTaskRunning = false;
-        std::deque<Task> m_fileTaskQueue;
+        FileTaskQueueUPtr m_fileTaskQueue;
 
         std::thread::id m_mainThreadId;
     };
@@ -58,7 +58,9 @@ namespace ChilliSource
     ///
     /// File Task: A large task specifically for processing file input or output.
     /// All background processing of files should use this rather than standard
-    /// large tasks.
+    /// large tasks. File tasks are run serially, and are started in priority order
+    /// through the FileTaskQueue. Applications whose file tasks are all safe to run
+    /// concurrently can raise the limit with FileTaskQueue::SetMaxConcurrentTasks().
     ///
     /// @author Ian Copland
     //------------------------------------------------------------------------------
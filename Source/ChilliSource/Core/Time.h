@@ -32,6 +32,7 @@
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Time/CoreTimer.h>
 #include <ChilliSource/Core/Time/PerformanceTimer.h>
+#include <ChilliSource/Core/Time/Profiler.h>
 #include <ChilliSource/Core/Time/Timer.h>
 
 #endif
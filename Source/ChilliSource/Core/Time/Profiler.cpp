@@ -0,0 +1,455 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Time/Profiler.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/File/FileSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#ifdef CS_TARGETPLATFORM_IOS
+#include <pthread.h>
+#endif
+
+namespace ChilliSource
+{
+    namespace
+    {
+#ifdef CS_TARGETPLATFORM_IOS
+        /// iOS doesn't support C++ thread_local so a pthread key is used to store the
+        /// current thread's data instead.
+        ///
+        /// @return The key.
+        ///
+        pthread_key_t GetThreadDataKey() noexcept
+        {
+            static pthread_key_t s_key = []()
+            {
+                pthread_key_t key;
+                pthread_key_create(&key, nullptr);
+                return key;
+            }();
+            
+            return s_key;
+        }
+        
+#elif defined (CS_TARGETPLATFORM_WINDOWS)
+        /// Visual C++ doesn't support thread_local yet, so the compiler specific version
+        /// is used instead. Only a pointer is stored so this is safe.
+        ///
+        __declspec(thread) void* g_currentThreadData = nullptr;
+        
+#else
+        thread_local void* g_currentThreadData = nullptr;
+#endif
+        
+        /// @return The type erased thread data for the current thread, or null if it hasn't
+        ///     been registered.
+        ///
+        void* GetThreadLocalData() noexcept
+        {
+#ifdef CS_TARGETPLATFORM_IOS
+            return pthread_getspecific(GetThreadDataKey());
+#else
+            return g_currentThreadData;
+#endif
+        }
+        
+        /// Sets the type erased thread data for the current thread.
+        ///
+        /// @param threadData
+        ///     The thread data.
+        ///
+        void SetThreadLocalData(void* threadData) noexcept
+        {
+#ifdef CS_TARGETPLATFORM_IOS
+            pthread_setspecific(GetThreadDataKey(), threadData);
+#else
+            g_currentThreadData = threadData;
+#endif
+        }
+        
+        /// @return The current time in microseconds, measured using a monotonic clock.
+        ///
+        u64 GetSteadyTimeMicroS() noexcept
+        {
+            return u64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+        
+        /// Calculates the index of the first entry in a ring buffer which has not been
+        /// overwritten, given the total number written, the capacity of the buffer and
+        /// the first entry which should be read.
+        ///
+        /// @param numWritten
+        ///     The total number of entries written to the ring buffer.
+        /// @param capacity
+        ///     The capacity of the ring buffer.
+        /// @param firstToRead
+        ///     The first entry which should be read, regardless of whether it is still valid.
+        ///
+        /// @return The index of the first valid entry.
+        ///
+        template <typename TIndex> TIndex CalcFirstValidIndex(TIndex numWritten, TIndex capacity, TIndex firstToRead) noexcept
+        {
+            auto firstValid = (numWritten > capacity) ? numWritten - capacity : 0;
+            return std::max(firstValid, firstToRead);
+        }
+        
+        /// Writes the given string to the stream as a JSON string, escaping any characters
+        /// which require it.
+        ///
+        /// @param stream
+        ///     The output stream.
+        /// @param value
+        ///     The string to write.
+        ///
+        void WriteJsonString(std::ostringstream& stream, const std::string& value) noexcept
+        {
+            stream << '"';
+            for (auto character : value)
+            {
+                if (character == '"' || character == '\\')
+                {
+                    stream << '\\' << character;
+                }
+                else if (static_cast<unsigned char>(character) >= 0x20)
+                {
+                    stream << character;
+                }
+            }
+            stream << '"';
+        }
+    }
+    
+    constexpr u32 Profiler::k_maxThreads;
+    constexpr u32 Profiler::k_maxZones;
+    constexpr u32 Profiler::k_invalidZoneId;
+    constexpr u32 Profiler::k_maxEventsPerThread;
+    constexpr u32 Profiler::k_statsWindowSize;
+    
+    //------------------------------------------------------------------------------
+    Profiler* Profiler::Get() noexcept
+    {
+        static Profiler s_profiler;
+        return &s_profiler;
+    }
+    
+    //------------------------------------------------------------------------------
+    Profiler::Profiler() noexcept
+        : m_startTimeMicroS(GetSteadyTimeMicroS()), m_numThreads(0), m_numZones(0)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    u64 Profiler::GetTimestampMicroS() const noexcept
+    {
+        return GetSteadyTimeMicroS() - m_startTimeMicroS;
+    }
+    
+    //------------------------------------------------------------------------------
+    void Profiler::SetCurrentThreadName(const std::string& name) noexcept
+    {
+        auto threadData = GetCurrentThreadData();
+        if (threadData)
+        {
+            std::unique_lock<std::mutex> lock(threadData->m_nameMutex);
+            threadData->m_name = name;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 Profiler::RegisterZone(const char* name) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_registrationMutex);
+        
+        u32 numZones = m_numZones.load(std::memory_order_relaxed);
+        for (u32 zoneId = 0; zoneId < numZones; ++zoneId)
+        {
+            if (std::strcmp(m_zoneNames[zoneId], name) == 0)
+            {
+                return zoneId;
+            }
+        }
+        
+        if (numZones >= k_maxZones)
+        {
+            return k_invalidZoneId;
+        }
+        
+        m_zoneNames[numZones] = name;
+        m_numZones.store(numZones + 1, std::memory_order_release);
+        
+        return numZones;
+    }
+    
+    //------------------------------------------------------------------------------
+    void Profiler::RecordZone(u32 zoneId, u64 startMicroS, u64 endMicroS) noexcept
+    {
+        auto threadData = GetCurrentThreadData();
+        if (!threadData || zoneId >= k_maxZones)
+        {
+            return;
+        }
+        
+        //Only this thread writes to its data, so the counters can be read relaxed; the release stores publish the new entries to readers.
+        auto eventIndex = threadData->m_numEventsWritten.load(std::memory_order_relaxed);
+        auto& event = threadData->m_events[eventIndex % k_maxEventsPerThread];
+        event.m_zoneId.store(zoneId, std::memory_order_relaxed);
+        event.m_startMicroS.store(startMicroS, std::memory_order_relaxed);
+        event.m_endMicroS.store(endMicroS, std::memory_order_relaxed);
+        threadData->m_numEventsWritten.store(eventIndex + 1, std::memory_order_release);
+        
+        auto& history = threadData->m_zoneHistories[zoneId];
+        auto sampleIndex = history.m_numSamples.load(std::memory_order_relaxed);
+        history.m_durationsMS[sampleIndex % k_statsWindowSize].store(f32(endMicroS - startMicroS) / 1000.0f, std::memory_order_relaxed);
+        history.m_numSamples.store(sampleIndex + 1, std::memory_order_release);
+    }
+    
+    //------------------------------------------------------------------------------
+    std::vector<Profiler::ZoneStats> Profiler::GetZoneStats() const noexcept
+    {
+        u32 numZones = m_numZones.load(std::memory_order_acquire);
+        std::vector<ZoneStats> allStats(numZones);
+        for (u32 zoneId = 0; zoneId < numZones; ++zoneId)
+        {
+            allStats[zoneId].m_name = m_zoneNames[zoneId];
+            allStats[zoneId].m_minMS = std::numeric_limits<f64>::max();
+        }
+        
+        std::vector<f32> durationsMS;
+        durationsMS.reserve(k_statsWindowSize);
+        
+        u32 numThreads = m_numThreads.load(std::memory_order_acquire);
+        for (u32 threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+        {
+            const auto& threadData = m_threadData[threadIndex];
+            
+            for (u32 zoneId = 0; zoneId < numZones; ++zoneId)
+            {
+                const auto& history = threadData->m_zoneHistories[zoneId];
+                
+                auto numSamples = history.m_numSamples.load(std::memory_order_acquire);
+                auto firstSample = CalcFirstValidIndex(numSamples, k_statsWindowSize, history.m_firstSample.load(std::memory_order_relaxed));
+                
+                durationsMS.clear();
+                for (auto i = firstSample; i < numSamples; ++i)
+                {
+                    durationsMS.push_back(history.m_durationsMS[i % k_statsWindowSize].load(std::memory_order_relaxed));
+                }
+                
+                //Discard any samples which were overwritten while they were being read.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                auto numOverwritten = CalcFirstValidIndex(history.m_numSamples.load(std::memory_order_relaxed), k_statsWindowSize, firstSample) - firstSample;
+                if (numOverwritten >= durationsMS.size())
+                {
+                    continue;
+                }
+                
+                auto& stats = allStats[zoneId];
+                for (auto it = durationsMS.begin() + numOverwritten; it != durationsMS.end(); ++it)
+                {
+                    f64 durationMS = *it;
+                    stats.m_averageMS += durationMS;
+                    stats.m_minMS = std::min(stats.m_minMS, durationMS);
+                    stats.m_maxMS = std::max(stats.m_maxMS, durationMS);
+                    ++stats.m_numSamples;
+                }
+            }
+        }
+        
+        std::vector<ZoneStats> output;
+        output.reserve(allStats.size());
+        for (auto& stats : allStats)
+        {
+            if (stats.m_numSamples > 0)
+            {
+                stats.m_averageMS /= f64(stats.m_numSamples);
+                output.push_back(std::move(stats));
+            }
+        }
+        
+        std::sort(output.begin(), output.end(), [](const ZoneStats& a, const ZoneStats& b)
+        {
+            return a.m_name < b.m_name;
+        });
+        
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    void Profiler::Reset() noexcept
+    {
+        u32 numZones = m_numZones.load(std::memory_order_acquire);
+        u32 numThreads = m_numThreads.load(std::memory_order_acquire);
+        for (u32 threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+        {
+            const auto& threadData = m_threadData[threadIndex];
+            
+            //The buffers are owned by the recording thread, so rather than clearing them everything currently written is excluded from future reads.
+            threadData->m_firstEvent.store(threadData->m_numEventsWritten.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            
+            for (u32 zoneId = 0; zoneId < numZones; ++zoneId)
+            {
+                auto& history = threadData->m_zoneHistories[zoneId];
+                history.m_firstSample.store(history.m_numSamples.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    std::string Profiler::GetChromeTrace() const noexcept
+    {
+        std::ostringstream stream;
+        stream << "{\"traceEvents\":[";
+        
+        bool firstEvent = true;
+        auto writeSeparator = [&]()
+        {
+            if (!firstEvent)
+            {
+                stream << ",\n";
+            }
+            firstEvent = false;
+        };
+        
+        struct EventCopy final
+        {
+            u32 m_zoneId;
+            u64 m_startMicroS;
+            u64 m_endMicroS;
+        };
+        std::vector<EventCopy> events;
+        
+        u32 numZones = m_numZones.load(std::memory_order_acquire);
+        u32 numThreads = m_numThreads.load(std::memory_order_acquire);
+        for (u32 threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+        {
+            const auto& threadData = m_threadData[threadIndex];
+            
+            std::string threadName;
+            {
+                std::unique_lock<std::mutex> lock(threadData->m_nameMutex);
+                threadName = threadData->m_name;
+            }
+            
+            if (!threadName.empty())
+            {
+                writeSeparator();
+                stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadData->m_index << ",\"args\":{\"name\":";
+                WriteJsonString(stream, threadName);
+                stream << "}}";
+            }
+            
+            auto numEventsWritten = threadData->m_numEventsWritten.load(std::memory_order_acquire);
+            auto firstEventIndex = CalcFirstValidIndex(numEventsWritten, u64(k_maxEventsPerThread), threadData->m_firstEvent.load(std::memory_order_relaxed));
+            
+            events.clear();
+            for (auto i = firstEventIndex; i < numEventsWritten; ++i)
+            {
+                const auto& event = threadData->m_events[i % k_maxEventsPerThread];
+                events.push_back(EventCopy { event.m_zoneId.load(std::memory_order_relaxed), event.m_startMicroS.load(std::memory_order_relaxed), event.m_endMicroS.load(std::memory_order_relaxed) });
+            }
+            
+            //Discard any events which were overwritten while they were being copied.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto numOverwritten = CalcFirstValidIndex(threadData->m_numEventsWritten.load(std::memory_order_relaxed), u64(k_maxEventsPerThread), firstEventIndex) - firstEventIndex;
+            
+            for (auto i = numOverwritten; i < u64(events.size()); ++i)
+            {
+                const auto& event = events[std::size_t(i)];
+                if (event.m_zoneId >= numZones)
+                {
+                    continue;
+                }
+                
+                writeSeparator();
+                stream << "{\"name\":";
+                WriteJsonString(stream, m_zoneNames[event.m_zoneId]);
+                stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadData->m_index << ",\"ts\":" << event.m_startMicroS << ",\"dur\":" << (event.m_endMicroS - event.m_startMicroS) << "}";
+            }
+        }
+        
+        stream << "]}";
+        return stream.str();
+    }
+    
+    //------------------------------------------------------------------------------
+    bool Profiler::SaveChromeTrace(StorageLocation storageLocation, const std::string& filePath) const noexcept
+    {
+        auto fileSystem = Application::Get()->GetFileSystem();
+        CS_ASSERT(fileSystem, "File system must exist to save a trace.");
+        
+        return fileSystem->WriteFile(storageLocation, filePath, GetChromeTrace());
+    }
+    
+    //------------------------------------------------------------------------------
+    Profiler::ThreadData* Profiler::GetCurrentThreadData() noexcept
+    {
+        auto currentThreadData = GetThreadLocalData();
+        if (currentThreadData)
+        {
+            return static_cast<ThreadData*>(currentThreadData);
+        }
+        
+        std::unique_lock<std::mutex> lock(m_registrationMutex);
+        
+        u32 numThreads = m_numThreads.load(std::memory_order_relaxed);
+        if (numThreads >= k_maxThreads)
+        {
+            return nullptr;
+        }
+        
+        std::unique_ptr<ThreadData> threadData(new ThreadData());
+        threadData->m_index = numThreads;
+        threadData->m_events.reset(new Event[k_maxEventsPerThread]());
+        threadData->m_numEventsWritten.store(0, std::memory_order_relaxed);
+        threadData->m_firstEvent.store(0, std::memory_order_relaxed);
+        threadData->m_zoneHistories.reset(new ZoneHistory[k_maxZones]());
+        
+        auto output = threadData.get();
+        m_threadData[numThreads] = std::move(threadData);
+        m_numThreads.store(numThreads + 1, std::memory_order_release);
+        
+        SetThreadLocalData(output);
+        return output;
+    }
+    
+    //------------------------------------------------------------------------------
+    ProfilerZone::ProfilerZone(u32 zoneId) noexcept
+        : m_zoneId(zoneId), m_startMicroS(Profiler::Get()->GetTimestampMicroS())
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    ProfilerZone::~ProfilerZone() noexcept
+    {
+        auto profiler = Profiler::Get();
+        profiler->RecordZone(m_zoneId, m_startMicroS, profiler->GetTimestampMicroS());
+    }
+}
@@ -0,0 +1,250 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_CORE_TIME_PROFILER_H_
+#define _CHILLISOURCE_CORE_TIME_PROFILER_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/File/StorageLocation.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+/// Profiling macros. These are compiled out unless CS_ENABLE_PROFILER is
+/// defined, so zones can be left in performance critical code.
+///
+/// CS_PROFILE_ZONE(name): Times the enclosing scope. The name must be a string
+/// literal, or otherwise outlive the profiler. The zone is registered the first
+/// time each call site is reached, so recording it only costs a pair of
+/// timestamps and a lock free write to the current thread's buffer.
+///
+/// CS_PROFILE_THREAD_NAME(name): Sets the name of the current thread, as shown
+/// in captured traces.
+//------------------------------------------------------------------------------
+#define CS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CS_PROFILE_CONCAT(a, b) CS_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef CS_ENABLE_PROFILER
+#   define CS_PROFILE_ZONE(name) \
+        static const u32 CS_PROFILE_CONCAT(csProfilerZoneId, __LINE__) = ChilliSource::Profiler::Get()->RegisterZone(name); \
+        ChilliSource::ProfilerZone CS_PROFILE_CONCAT(csProfilerZone, __LINE__)(CS_PROFILE_CONCAT(csProfilerZoneId, __LINE__))
+#   define CS_PROFILE_THREAD_NAME(name) ChilliSource::Profiler::Get()->SetCurrentThreadName(name)
+#else
+#   define CS_PROFILE_ZONE(name)
+#   define CS_PROFILE_THREAD_NAME(name)
+#endif
+
+namespace ChilliSource
+{
+    /// A low overhead, scoped zone profiler. Zones are registered once, giving each an id.
+    /// Each thread which records a zone is given its own ring buffer of events, holding the
+    /// most recent zones recorded on that thread, along with a rolling window of durations
+    /// for each zone id which is used to calculate per-zone statistics.
+    ///
+    /// A thread's buffers are only written by that thread and are found through a thread
+    /// local pointer, so recording a zone takes no locks and performs no lookups. Readers
+    /// on other threads detect and discard any events overwritten while they were reading.
+    /// Thread slots are not reused, so at most k_maxThreads threads can record zones over
+    /// the lifetime of the application.
+    ///
+    /// The contents of the ring buffers can be dumped at any time in the Chrome trace_event
+    /// JSON format, which can be viewed with chrome://tracing.
+    ///
+    /// Zones are typically recorded using the CS_PROFILE_ZONE() macro rather than by using
+    /// this directly, allowing them to be compiled out.
+    ///
+    /// This is thread-safe.
+    ///
+    class Profiler final
+    {
+    public:
+        CS_DECLARE_NOCOPY(Profiler);
+        
+        static constexpr u32 k_maxThreads = 64;
+        static constexpr u32 k_maxZones = 256;
+        static constexpr u32 k_invalidZoneId = k_maxZones;
+        static constexpr u32 k_maxEventsPerThread = 8 * 1024;
+        static constexpr u32 k_statsWindowSize = 120;
+        
+        /// Statistics for a single zone, calculated over the most recent samples from all threads.
+        ///
+        struct ZoneStats final
+        {
+            std::string m_name;
+            u32 m_numSamples = 0;
+            f64 m_averageMS = 0.0;
+            f64 m_minMS = 0.0;
+            f64 m_maxMS = 0.0;
+        };
+        
+        /// @return The profiler singleton. This is available from any thread at any time.
+        ///
+        static Profiler* Get() noexcept;
+        
+        /// @return The time in microseconds since the profiler was created.
+        ///
+        u64 GetTimestampMicroS() const noexcept;
+        
+        /// Sets the name of the current thread, as shown in captured traces.
+        ///
+        /// @param name
+        ///     The name of the thread.
+        ///
+        void SetCurrentThreadName(const std::string& name) noexcept;
+        
+        /// Registers a zone, returning its id. Registering a name which has already been
+        /// registered returns the existing id. This takes a lock, so should be called once
+        /// per call site rather than each time the zone is recorded.
+        ///
+        /// @param name
+        ///     The name of the zone. This must outlive the profiler, so should typically be a
+        ///     string literal.
+        ///
+        /// @return The zone id, or k_invalidZoneId if the maximum number of zones has been
+        ///     reached.
+        ///
+        u32 RegisterZone(const char* name) noexcept;
+        
+        /// Records a zone on the current thread. If the thread's ring buffer is full the oldest
+        /// event is overwritten. This is lock free once the thread has recorded its first zone.
+        ///
+        /// @param zoneId
+        ///     The id of the zone, as returned by RegisterZone().
+        /// @param startMicroS
+        ///     The start time of the zone, as returned by GetTimestampMicroS().
+        /// @param endMicroS
+        ///     The end time of the zone, as returned by GetTimestampMicroS().
+        ///
+        void RecordZone(u32 zoneId, u64 startMicroS, u64 endMicroS) noexcept;
+        
+        /// @return The rolling statistics for every zone which has been recorded, sorted by name.
+        ///
+        std::vector<ZoneStats> GetZoneStats() const noexcept;
+        
+        /// Clears all recorded events and statistics. Events recorded before this is called are
+        /// excluded from future stats and traces.
+        ///
+        void Reset() noexcept;
+        
+        /// @return The events currently held in the ring buffers, in the Chrome trace_event
+        ///     JSON format.
+        ///
+        std::string GetChromeTrace() const noexcept;
+        
+        /// Writes the events currently held in the ring buffers to file in the Chrome
+        /// trace_event JSON format.
+        ///
+        /// @param storageLocation
+        ///     The storage location to write to.
+        /// @param filePath
+        ///     The file path.
+        ///
+        /// @return Whether or not the trace was successfully written.
+        ///
+        bool SaveChromeTrace(StorageLocation storageLocation, const std::string& filePath) const noexcept;
+        
+    private:
+        /// A single recorded zone. The fields are atomic as they may be overwritten by the
+        /// owning thread while being read by another; relaxed accesses are used throughout.
+        ///
+        struct Event final
+        {
+            std::atomic<u32> m_zoneId;
+            std::atomic<u64> m_startMicroS;
+            std::atomic<u64> m_endMicroS;
+        };
+        
+        /// The most recent durations of a single zone on a single thread. Samples before
+        /// m_firstSample were recorded before the last call to Reset().
+        ///
+        struct ZoneHistory final
+        {
+            std::array<std::atomic<f32>, k_statsWindowSize> m_durationsMS;
+            std::atomic<u32> m_numSamples;
+            std::atomic<u32> m_firstSample;
+        };
+        
+        /// The profiling data for a single thread. The events and histories are only written
+        /// by the owning thread. Only the thread name is locked.
+        ///
+        struct ThreadData final
+        {
+            u32 m_index = 0;
+            mutable std::mutex m_nameMutex;
+            std::string m_name;
+            std::unique_ptr<Event[]> m_events;
+            std::atomic<u64> m_numEventsWritten;
+            std::atomic<u64> m_firstEvent;
+            std::unique_ptr<ZoneHistory[]> m_zoneHistories;
+        };
+        
+        Profiler() noexcept;
+        
+        /// Finds the data for the current thread, registering the thread if this is the first
+        /// time it has been used. Once registered the data is found through a thread local
+        /// pointer.
+        ///
+        /// @return The thread data, or null if the maximum number of threads has been reached.
+        ///
+        ThreadData* GetCurrentThreadData() noexcept;
+        
+        const u64 m_startTimeMicroS;
+        std::mutex m_registrationMutex;
+        std::array<std::unique_ptr<ThreadData>, k_maxThreads> m_threadData;
+        std::atomic<u32> m_numThreads;
+        std::array<const char*, k_maxZones> m_zoneNames;
+        std::atomic<u32> m_numZones;
+    };
+    
+    /// Records the lifetime of the zone object as a zone with the profiler. This is typically
+    /// used via the CS_PROFILE_ZONE() macro.
+    ///
+    class ProfilerZone final
+    {
+    public:
+        CS_DECLARE_NOCOPY(ProfilerZone);
+        
+        /// Starts the zone.
+        ///
+        /// @param zoneId
+        ///     The id of the zone, as returned by Profiler::RegisterZone().
+        ///
+        ProfilerZone(u32 zoneId) noexcept;
+        
+        /// Ends the zone, recording it with the profiler.
+        ///
+        ~ProfilerZone() noexcept;
+        
+    private:
+        u32 m_zoneId;
+        u64 m_startMicroS;
+    };
+}
+
+#endif
@@ -31,5 +31,6 @@
 
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Volume/VolumeComponent.h>
+#include <ChilliSource/Core/Volume/VolumeHierarchy.h>
 
 #endif
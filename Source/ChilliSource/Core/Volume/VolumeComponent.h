@@ -83,6 +83,22 @@ namespace ChilliSource
         virtual bool IsVisible() const = 0;
 
         f32 mfQueryIntersectionValue;
+        
+    protected:
+        //----------------------------------------------------
+        /// Notifies the scene's volume hierarchy that the
+        /// bounds have changed for a reason other than the
+        /// entity's transform changing, for example a new
+        /// model being set. Changes to the transform are
+        /// tracked automatically.
+        //----------------------------------------------------
+        void InvalidateVolume();
+        
+    private:
+        friend class VolumeHierarchy;
+        
+        VolumeHierarchy* m_volumeHierarchy = nullptr;
+        s32 m_volumeHierarchyLeaf = -1;
     };
 }
 
@@ -0,0 +1,813 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Volume/VolumeHierarchy.h>
+
+#include <ChilliSource/Core/Entity/Entity.h>
+#include <ChilliSource/Core/Volume/VolumeComponent.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        constexpr s32 k_nullNode = -1;
+        
+        /// The factor by which the cost of the tree can increase relative to the last build
+        /// before it is rebuilt.
+        ///
+        constexpr f64 k_rebuildCostRatio = 1.5;
+        
+        /// @param min
+        ///     The minimum of the bounds.
+        /// @param max
+        ///     The maximum of the bounds.
+        ///
+        /// @return Half of the surface area of the given bounds.
+        ///
+        f32 CalculateArea(const Vector3& min, const Vector3& max) noexcept
+        {
+            Vector3 size = max - min;
+            return size.x * size.y + size.y * size.z + size.z * size.x;
+        }
+        
+        /// Sorts the volume components which were appended to the list by their query
+        /// intersection value.
+        ///
+        /// @param volumeComponents
+        ///     (In/Out) The list of volume components.
+        /// @param first
+        ///     The index of the first appended volume component.
+        ///
+        void SortResults(std::vector<VolumeComponent*>& volumeComponents, std::size_t first) noexcept
+        {
+            std::sort(volumeComponents.begin() + first, volumeComponents.end(), [](const VolumeComponent* a, const VolumeComponent* b)
+            {
+                return a->mfQueryIntersectionValue < b->mfQueryIntersectionValue;
+            });
+        }
+        
+        /// @param point
+        ///     The point.
+        /// @param min
+        ///     The minimum of the bounds.
+        /// @param max
+        ///     The maximum of the bounds.
+        ///
+        /// @return The squared distance from the given point to the closest point in the bounds.
+        ///
+        f32 CalculateDistanceSquared(const Vector3& point, const Vector3& min, const Vector3& max) noexcept
+        {
+            Vector3 closest = Vector3::Min(Vector3::Max(point, min), max);
+            return (point - closest).LengthSquared();
+        }
+        
+        /// @param plane
+        ///     The plane.
+        /// @param min
+        ///     The minimum of the bounds.
+        /// @param max
+        ///     The maximum of the bounds.
+        ///
+        /// @return Whether or not the bounds are entirely behind the given plane.
+        ///
+        bool IsBehindPlane(const Plane& plane, const Vector3& min, const Vector3& max) noexcept
+        {
+            Vector3 positiveVertex((plane.mvNormal.x >= 0.0f) ? max.x : min.x, (plane.mvNormal.y >= 0.0f) ? max.y : min.y, (plane.mvNormal.z >= 0.0f) ? max.z : min.z);
+            return plane.DistanceFromPoint(positiveVertex) < 0.0f;
+        }
+        
+        /// A world space oriented box.
+        ///
+        struct OrientedBox
+        {
+            Vector3 m_centre;
+            Vector3 m_axes[3];
+            Vector3 m_halfSize;
+        };
+        
+        /// Converts the given OOBB to a world space oriented box. The transform of the OOBB is
+        /// assumed not to contain any shear, so its scaled axes remain orthogonal.
+        ///
+        /// @param oobb
+        ///     The OOBB.
+        ///
+        /// @return The world space oriented box.
+        ///
+        OrientedBox ToOrientedBox(const OOBB& oobb) noexcept
+        {
+            const auto& transform = oobb.GetTransform();
+            const Vector3 halfSize = oobb.GetSize() * 0.5f;
+            
+            OrientedBox box;
+            box.m_centre = oobb.GetOrigin() * transform;
+            for (u32 axis = 0; axis < 3; ++axis)
+            {
+                Vector3 scaledAxis(transform.m[axis * 4], transform.m[axis * 4 + 1], transform.m[axis * 4 + 2]);
+                f32 scale = scaledAxis.Length();
+                box.m_axes[axis] = (scale > 0.0f) ? scaledAxis / scale : Vector3::k_zero;
+                (&box.m_halfSize.x)[axis] = (&halfSize.x)[axis] * scale;
+            }
+            
+            return box;
+        }
+        
+        /// @param box
+        ///     The oriented box.
+        /// @param direction
+        ///     The direction to project onto. Need not be normalised.
+        ///
+        /// @return The radius of the given box when projected onto the given direction, scaled
+        ///     by the length of the direction.
+        ///
+        f32 CalculateProjectedRadius(const OrientedBox& box, const Vector3& direction) noexcept
+        {
+            return box.m_halfSize.x * std::abs(Vector3::DotProduct(box.m_axes[0], direction)) + box.m_halfSize.y * std::abs(Vector3::DotProduct(box.m_axes[1], direction)) +
+                box.m_halfSize.z * std::abs(Vector3::DotProduct(box.m_axes[2], direction));
+        }
+        
+        /// @param box
+        ///     The oriented box.
+        /// @param sphere
+        ///     The sphere.
+        ///
+        /// @return Whether or not the oriented box intersects the sphere.
+        ///
+        bool Intersects(const OrientedBox& box, const Sphere& sphere) noexcept
+        {
+            Vector3 offset = sphere.vOrigin - box.m_centre;
+            Vector3 closest = box.m_centre;
+            for (u32 axis = 0; axis < 3; ++axis)
+            {
+                f32 halfSize = (&box.m_halfSize.x)[axis];
+                closest += box.m_axes[axis] * std::min(std::max(Vector3::DotProduct(offset, box.m_axes[axis]), -halfSize), halfSize);
+            }
+            
+            return (sphere.vOrigin - closest).LengthSquared() <= sphere.fRadius * sphere.fRadius;
+        }
+        
+        /// Tests the oriented box against the bounds using the separating axis theorem. The axes
+        /// tested are the world axes, the axes of the box, and the cross product of each pair.
+        ///
+        /// @param box
+        ///     The oriented box.
+        /// @param min
+        ///     The minimum of the bounds.
+        /// @param max
+        ///     The maximum of the bounds.
+        ///
+        /// @return Whether or not the oriented box intersects the bounds.
+        ///
+        bool Intersects(const OrientedBox& box, const Vector3& min, const Vector3& max) noexcept
+        {
+            //Cross products of near parallel axes are degenerate, and are covered by the face axes.
+            constexpr f32 k_minAxisLengthSquared = 0.000001f;
+            
+            const Vector3 boundsHalfSize = (max - min) * 0.5f;
+            const Vector3 offset = box.m_centre - (min + max) * 0.5f;
+            const auto isSeparatingAxis = [&](const Vector3& axis) noexcept
+            {
+                f32 boundsRadius = Vector3::DotProduct(boundsHalfSize, Vector3::Abs(axis));
+                return std::abs(Vector3::DotProduct(offset, axis)) > boundsRadius + CalculateProjectedRadius(box, axis);
+            };
+            
+            const Vector3 worldAxes[3] = { Vector3::k_unitPositiveX, Vector3::k_unitPositiveY, Vector3::k_unitPositiveZ };
+            for (u32 i = 0; i < 3; ++i)
+            {
+                if (isSeparatingAxis(worldAxes[i]) || isSeparatingAxis(box.m_axes[i]))
+                {
+                    return false;
+                }
+            }
+            
+            for (const auto& worldAxis : worldAxes)
+            {
+                for (const auto& boxAxis : box.m_axes)
+                {
+                    Vector3 axis = Vector3::CrossProduct(worldAxis, boxAxis);
+                    if (axis.LengthSquared() > k_minAxisLengthSquared && isSeparatingAxis(axis))
+                    {
+                        return false;
+                    }
+                }
+            }
+            
+            return true;
+        }
+        
+        /// @param plane
+        ///     The plane.
+        /// @param box
+        ///     The oriented box.
+        ///
+        /// @return Whether or not the oriented box is entirely behind the given plane.
+        ///
+        bool IsBehindPlane(const Plane& plane, const OrientedBox& box) noexcept
+        {
+            return plane.DistanceFromPoint(box.m_centre) < -CalculateProjectedRadius(box, plane.mvNormal);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    template <typename TOverlapTest> void VolumeHierarchy::CollectLeaves(const TOverlapTest& overlapTest) noexcept
+    {
+        m_queryLeaves.clear();
+        if (m_root == k_nullNode)
+        {
+            return;
+        }
+        
+        m_traversalStack.clear();
+        m_traversalStack.push_back(m_root);
+        while (!m_traversalStack.empty())
+        {
+            s32 nodeIndex = m_traversalStack.back();
+            m_traversalStack.pop_back();
+            
+            const auto& node = m_nodes[nodeIndex];
+            if (!overlapTest(node.m_min, node.m_max))
+            {
+                continue;
+            }
+            
+            if (node.m_left == k_nullNode)
+            {
+                m_queryLeaves.push_back(nodeIndex);
+            }
+            else
+            {
+                m_traversalStack.push_back(node.m_right);
+                m_traversalStack.push_back(node.m_left);
+            }
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::Add(VolumeComponent* volumeComponent) noexcept
+    {
+        CS_ASSERT(volumeComponent, "Cannot add a null volume component.");
+        CS_ASSERT(volumeComponent->GetEntity(), "Cannot add a volume component which isn't attached to an entity.");
+        CS_ASSERT(!volumeComponent->m_volumeHierarchy, "Volume component is already in a volume hierarchy.");
+        
+        s32 leafIndex = AllocateNode();
+        auto& leaf = m_nodes[leafIndex];
+        leaf.m_volumeComponent = volumeComponent;
+        leaf.m_transformChangedConnection = volumeComponent->GetEntity()->GetTransform().GetTransformChangedEvent().OpenConnection([=]()
+        {
+            Invalidate(volumeComponent);
+        });
+        leaf.m_isDirty = true;
+        m_dirtyLeaves.push_back(leafIndex);
+        
+        volumeComponent->m_volumeHierarchy = this;
+        volumeComponent->m_volumeHierarchyLeaf = leafIndex;
+        
+        ++m_numLeaves;
+        ++m_numPendingLeaves;
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::Remove(VolumeComponent* volumeComponent) noexcept
+    {
+        CS_ASSERT(volumeComponent, "Cannot remove a null volume component.");
+        CS_ASSERT(volumeComponent->m_volumeHierarchy == this, "Volume component is not in this volume hierarchy.");
+        
+        s32 leafIndex = volumeComponent->m_volumeHierarchyLeaf;
+        auto& leaf = m_nodes[leafIndex];
+        
+        if (leaf.m_isDirty)
+        {
+            auto it = std::find(m_dirtyLeaves.begin(), m_dirtyLeaves.end(), leafIndex);
+            CS_ASSERT(it != m_dirtyLeaves.end(), "Dirty leaf is missing from the dirty list.");
+            
+            std::swap(*it, m_dirtyLeaves.back());
+            m_dirtyLeaves.pop_back();
+        }
+        
+        if (leaf.m_isInTree)
+        {
+            RemoveLeaf(leafIndex);
+        }
+        else
+        {
+            --m_numPendingLeaves;
+        }
+        
+        FreeNode(leafIndex);
+        
+        volumeComponent->m_volumeHierarchy = nullptr;
+        volumeComponent->m_volumeHierarchyLeaf = k_nullNode;
+        
+        --m_numLeaves;
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::Invalidate(VolumeComponent* volumeComponent) noexcept
+    {
+        CS_ASSERT(volumeComponent->m_volumeHierarchy == this, "Volume component is not in this volume hierarchy.");
+        
+        s32 leafIndex = volumeComponent->m_volumeHierarchyLeaf;
+        auto& leaf = m_nodes[leafIndex];
+        if (!leaf.m_isDirty)
+        {
+            leaf.m_isDirty = true;
+            m_dirtyLeaves.push_back(leafIndex);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::QueryRay(const Ray& ray, std::vector<VolumeComponent*>& outVolumeComponents) noexcept
+    {
+        Update();
+        
+        //This mirrors the slab test used by the ray intersection shape tests, which treats the ray
+        //as extending infinitely forwards from its origin.
+        const Vector3 direction = ray.vDirection * ray.fLength;
+        CollectLeaves([&](const Vector3& min, const Vector3& max) noexcept
+        {
+            f32 entry = -std::numeric_limits<f32>::infinity();
+            f32 exit = std::numeric_limits<f32>::infinity();
+            for (u32 axis = 0; axis < 3; ++axis)
+            {
+                f32 origin = (&ray.vOrigin.x)[axis];
+                f32 delta = (&direction.x)[axis];
+                f32 slabMin = (&min.x)[axis];
+                f32 slabMax = (&max.x)[axis];
+                
+                if (delta == 0.0f)
+                {
+                    if (origin < slabMin || origin > slabMax)
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    f32 inverseDelta = 1.0f / delta;
+                    f32 near = (slabMin - origin) * inverseDelta;
+                    f32 far = (slabMax - origin) * inverseDelta;
+                    entry = std::max(entry, std::min(near, far));
+                    exit = std::min(exit, std::max(near, far));
+                    
+                    if (entry > exit || exit < 0.0f)
+                    {
+                        return false;
+                    }
+                }
+            }
+            
+            return true;
+        });
+        
+        std::size_t first = outVolumeComponents.size();
+        for (auto leafIndex : m_queryLeaves)
+        {
+            auto volumeComponent = m_nodes[leafIndex].m_volumeComponent;
+            
+            f32 nearIntersection = 0.0f, farIntersection = 0.0f;
+            if (volumeComponent->GetOOBB().Contains(ray, nearIntersection, farIntersection))
+            {
+                volumeComponent->mfQueryIntersectionValue = nearIntersection;
+                outVolumeComponents.push_back(volumeComponent);
+            }
+        }
+        
+        SortResults(outVolumeComponents, first);
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::QuerySphere(const Sphere& sphere, std::vector<VolumeComponent*>& outVolumeComponents) noexcept
+    {
+        Update();
+        
+        const f32 radiusSquared = sphere.fRadius * sphere.fRadius;
+        CollectLeaves([&](const Vector3& min, const Vector3& max) noexcept
+        {
+            return CalculateDistanceSquared(sphere.vOrigin, min, max) <= radiusSquared;
+        });
+        
+        std::size_t first = outVolumeComponents.size();
+        for (auto leafIndex : m_queryLeaves)
+        {
+            auto volumeComponent = m_nodes[leafIndex].m_volumeComponent;
+            
+            auto box = ToOrientedBox(volumeComponent->GetOOBB());
+            if (Intersects(box, sphere))
+            {
+                volumeComponent->mfQueryIntersectionValue = (box.m_centre - sphere.vOrigin).Length();
+                outVolumeComponents.push_back(volumeComponent);
+            }
+        }
+        
+        SortResults(outVolumeComponents, first);
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::QueryAABB(const AABB& aabb, std::vector<VolumeComponent*>& outVolumeComponents) noexcept
+    {
+        Update();
+        
+        const Vector3& queryMin = aabb.GetMin();
+        const Vector3& queryMax = aabb.GetMax();
+        CollectLeaves([&](const Vector3& min, const Vector3& max) noexcept
+        {
+            return min.x <= queryMax.x && max.x >= queryMin.x && min.y <= queryMax.y && max.y >= queryMin.y && min.z <= queryMax.z && max.z >= queryMin.z;
+        });
+        
+        std::size_t first = outVolumeComponents.size();
+        for (auto leafIndex : m_queryLeaves)
+        {
+            auto volumeComponent = m_nodes[leafIndex].m_volumeComponent;
+            
+            auto box = ToOrientedBox(volumeComponent->GetOOBB());
+            if (Intersects(box, queryMin, queryMax))
+            {
+                volumeComponent->mfQueryIntersectionValue = (box.m_centre - aabb.GetOrigin()).Length();
+                outVolumeComponents.push_back(volumeComponent);
+            }
+        }
+        
+        SortResults(outVolumeComponents, first);
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::QueryFrustum(const Frustum& frustum, std::vector<VolumeComponent*>& outVolumeComponents) noexcept
+    {
+        Update();
+        
+        CollectLeaves([&](const Vector3& min, const Vector3& max) noexcept
+        {
+            return !IsBehindPlane(frustum.mNearClipPlane, min, max) && !IsBehindPlane(frustum.mFarClipPlane, min, max) && !IsBehindPlane(frustum.mLeftClipPlane, min, max) &&
+                !IsBehindPlane(frustum.mRightClipPlane, min, max) && !IsBehindPlane(frustum.mTopClipPlane, min, max) && !IsBehindPlane(frustum.mBottomClipPlane, min, max);
+        });
+        
+        std::size_t first = outVolumeComponents.size();
+        for (auto leafIndex : m_queryLeaves)
+        {
+            auto volumeComponent = m_nodes[leafIndex].m_volumeComponent;
+            
+            auto box = ToOrientedBox(volumeComponent->GetOOBB());
+            if (!IsBehindPlane(frustum.mNearClipPlane, box) && !IsBehindPlane(frustum.mFarClipPlane, box) && !IsBehindPlane(frustum.mLeftClipPlane, box) &&
+                !IsBehindPlane(frustum.mRightClipPlane, box) && !IsBehindPlane(frustum.mTopClipPlane, box) && !IsBehindPlane(frustum.mBottomClipPlane, box))
+            {
+                volumeComponent->mfQueryIntersectionValue = frustum.mNearClipPlane.DistanceFromPoint(box.m_centre);
+                outVolumeComponents.push_back(volumeComponent);
+            }
+        }
+        
+        SortResults(outVolumeComponents, first);
+    }
+    
+    //------------------------------------------------------------------------------
+    s32 VolumeHierarchy::AllocateNode() noexcept
+    {
+        if (!m_freeNodes.empty())
+        {
+            s32 nodeIndex = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            return nodeIndex;
+        }
+        
+        m_nodes.push_back(Node());
+        return s32(m_nodes.size() - 1);
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::FreeNode(s32 nodeIndex) noexcept
+    {
+        auto& node = m_nodes[nodeIndex];
+        if (node.m_left != k_nullNode)
+        {
+            m_internalArea -= CalculateArea(node.m_min, node.m_max);
+        }
+        
+        node = Node();
+        m_freeNodes.push_back(nodeIndex);
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::SetNodeBounds(s32 nodeIndex, const Vector3& min, const Vector3& max) noexcept
+    {
+        auto& node = m_nodes[nodeIndex];
+        if (node.m_left != k_nullNode)
+        {
+            m_internalArea += CalculateArea(min, max) - CalculateArea(node.m_min, node.m_max);
+        }
+        
+        node.m_min = min;
+        node.m_max = max;
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::UpdateLeafBounds(s32 leafIndex) noexcept
+    {
+        const auto& oobb = m_nodes[leafIndex].m_volumeComponent->GetOOBB();
+        const auto& transform = oobb.GetTransform();
+        const Vector3 halfSize = oobb.GetSize() * 0.5f;
+        
+        //The world space box enclosing the OOBB is found by transforming the centre and
+        //projecting the half size onto each world axis.
+        Vector3 centre = oobb.GetOrigin() * transform;
+        Vector3 extents(std::abs(transform.m[0]) * halfSize.x + std::abs(transform.m[4]) * halfSize.y + std::abs(transform.m[8]) * halfSize.z,
+                        std::abs(transform.m[1]) * halfSize.x + std::abs(transform.m[5]) * halfSize.y + std::abs(transform.m[9]) * halfSize.z,
+                        std::abs(transform.m[2]) * halfSize.x + std::abs(transform.m[6]) * halfSize.y + std::abs(transform.m[10]) * halfSize.z);
+        
+        SetNodeBounds(leafIndex, centre - extents, centre + extents);
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::InsertLeaf(s32 leafIndex) noexcept
+    {
+        m_nodes[leafIndex].m_isInTree = true;
+        
+        if (m_root == k_nullNode)
+        {
+            m_root = leafIndex;
+            m_nodes[leafIndex].m_parent = k_nullNode;
+            return;
+        }
+        
+        const Vector3 leafMin = m_nodes[leafIndex].m_min;
+        const Vector3 leafMax = m_nodes[leafIndex].m_max;
+        
+        //Descend the tree choosing the child which results in the smallest increase in surface
+        //area, stopping when it's cheaper to create a new parent for the current node.
+        s32 siblingIndex = m_root;
+        while (m_nodes[siblingIndex].m_left != k_nullNode)
+        {
+            const auto& node = m_nodes[siblingIndex];
+            f32 area = CalculateArea(node.m_min, node.m_max);
+            f32 combinedArea = CalculateArea(Vector3::Min(node.m_min, leafMin), Vector3::Max(node.m_max, leafMax));
+            
+            f32 parentCost = 2.0f * combinedArea;
+            f32 inheritedCost = 2.0f * (combinedArea - area);
+            
+            f32 childCosts[2];
+            s32 children[2] = { node.m_left, node.m_right };
+            for (u32 i = 0; i < 2; ++i)
+            {
+                const auto& child = m_nodes[children[i]];
+                f32 childCombinedArea = CalculateArea(Vector3::Min(child.m_min, leafMin), Vector3::Max(child.m_max, leafMax));
+                childCosts[i] = childCombinedArea + inheritedCost;
+                if (child.m_left != k_nullNode)
+                {
+                    childCosts[i] -= CalculateArea(child.m_min, child.m_max);
+                }
+            }
+            
+            if (parentCost < childCosts[0] && parentCost < childCosts[1])
+            {
+                break;
+            }
+            
+            siblingIndex = (childCosts[0] < childCosts[1]) ? children[0] : children[1];
+        }
+        
+        s32 oldParentIndex = m_nodes[siblingIndex].m_parent;
+        s32 newParentIndex = AllocateNode();
+        
+        auto& newParent = m_nodes[newParentIndex];
+        newParent.m_parent = oldParentIndex;
+        newParent.m_left = siblingIndex;
+        newParent.m_right = leafIndex;
+        newParent.m_isInTree = true;
+        SetNodeBounds(newParentIndex, Vector3::Min(m_nodes[siblingIndex].m_min, leafMin), Vector3::Max(m_nodes[siblingIndex].m_max, leafMax));
+        
+        m_nodes[siblingIndex].m_parent = newParentIndex;
+        m_nodes[leafIndex].m_parent = newParentIndex;
+        
+        if (oldParentIndex == k_nullNode)
+        {
+            m_root = newParentIndex;
+        }
+        else
+        {
+            auto& oldParent = m_nodes[oldParentIndex];
+            if (oldParent.m_left == siblingIndex)
+            {
+                oldParent.m_left = newParentIndex;
+            }
+            else
+            {
+                oldParent.m_right = newParentIndex;
+            }
+            
+            RefitAncestors(oldParentIndex);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::RemoveLeaf(s32 leafIndex) noexcept
+    {
+        m_nodes[leafIndex].m_isInTree = false;
+        
+        if (leafIndex == m_root)
+        {
+            m_root = k_nullNode;
+            return;
+        }
+        
+        s32 parentIndex = m_nodes[leafIndex].m_parent;
+        s32 grandParentIndex = m_nodes[parentIndex].m_parent;
+        s32 siblingIndex = (m_nodes[parentIndex].m_left == leafIndex) ? m_nodes[parentIndex].m_right : m_nodes[parentIndex].m_left;
+        
+        m_nodes[siblingIndex].m_parent = grandParentIndex;
+        FreeNode(parentIndex);
+        
+        if (grandParentIndex == k_nullNode)
+        {
+            m_root = siblingIndex;
+        }
+        else
+        {
+            auto& grandParent = m_nodes[grandParentIndex];
+            if (grandParent.m_left == parentIndex)
+            {
+                grandParent.m_left = siblingIndex;
+            }
+            else
+            {
+                grandParent.m_right = siblingIndex;
+            }
+            
+            RefitAncestors(grandParentIndex);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::RefitAncestors(s32 nodeIndex) noexcept
+    {
+        while (nodeIndex != k_nullNode)
+        {
+            const auto& node = m_nodes[nodeIndex];
+            const auto& left = m_nodes[node.m_left];
+            const auto& right = m_nodes[node.m_right];
+            
+            Vector3 min = Vector3::Min(left.m_min, right.m_min);
+            Vector3 max = Vector3::Max(left.m_max, right.m_max);
+            if (min == node.m_min && max == node.m_max)
+            {
+                break;
+            }
+            
+            SetNodeBounds(nodeIndex, min, max);
+            nodeIndex = node.m_parent;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::Rebuild() noexcept
+    {
+        m_buildLeaves.clear();
+        for (u32 i = 0; i < m_nodes.size(); ++i)
+        {
+            auto& node = m_nodes[i];
+            if (node.m_volumeComponent)
+            {
+                node.m_isInTree = true;
+                m_buildLeaves.push_back(s32(i));
+            }
+            else if (node.m_isInTree)
+            {
+                FreeNode(s32(i));
+            }
+        }
+        
+        m_internalArea = 0.0;
+        m_numPendingLeaves = 0;
+        m_root = m_buildLeaves.empty() ? k_nullNode : Build(0, u32(m_buildLeaves.size()));
+        if (m_root != k_nullNode)
+        {
+            m_nodes[m_root].m_parent = k_nullNode;
+        }
+        
+        m_rebuildCost = CalculateCost() * k_rebuildCostRatio;
+    }
+    
+    //------------------------------------------------------------------------------
+    s32 VolumeHierarchy::Build(u32 first, u32 last) noexcept
+    {
+        if (last - first == 1)
+        {
+            return m_buildLeaves[first];
+        }
+        
+        const f32 infinity = std::numeric_limits<f32>::infinity();
+        Vector3 centreMin(infinity, infinity, infinity);
+        Vector3 centreMax(-infinity, -infinity, -infinity);
+        for (u32 i = first; i < last; ++i)
+        {
+            const auto& leaf = m_nodes[m_buildLeaves[i]];
+            Vector3 centre = leaf.m_min + leaf.m_max;
+            centreMin = Vector3::Min(centreMin, centre);
+            centreMax = Vector3::Max(centreMax, centre);
+        }
+        
+        Vector3 centreExtents = centreMax - centreMin;
+        u32 axis = (centreExtents.x >= centreExtents.y && centreExtents.x >= centreExtents.z) ? 0 : (centreExtents.y >= centreExtents.z) ? 1 : 2;
+        
+        u32 middle = first + (last - first) / 2;
+        std::nth_element(m_buildLeaves.begin() + first, m_buildLeaves.begin() + middle, m_buildLeaves.begin() + last, [this, axis](s32 a, s32 b)
+        {
+            const auto& leafA = m_nodes[a];
+            const auto& leafB = m_nodes[b];
+            return (&leafA.m_min.x)[axis] + (&leafA.m_max.x)[axis] < (&leafB.m_min.x)[axis] + (&leafB.m_max.x)[axis];
+        });
+        
+        s32 nodeIndex = AllocateNode();
+        s32 leftIndex = Build(first, middle);
+        s32 rightIndex = Build(middle, last);
+        
+        auto& node = m_nodes[nodeIndex];
+        node.m_left = leftIndex;
+        node.m_right = rightIndex;
+        node.m_isInTree = true;
+        m_nodes[leftIndex].m_parent = nodeIndex;
+        m_nodes[rightIndex].m_parent = nodeIndex;
+        
+        SetNodeBounds(nodeIndex, Vector3::Min(m_nodes[leftIndex].m_min, m_nodes[rightIndex].m_min), Vector3::Max(m_nodes[leftIndex].m_max, m_nodes[rightIndex].m_max));
+        
+        return nodeIndex;
+    }
+    
+    //------------------------------------------------------------------------------
+    void VolumeHierarchy::Update() noexcept
+    {
+        if (m_dirtyLeaves.empty())
+        {
+            return;
+        }
+        
+        //Calculating the bounds can cause the volume to be invalidated again, so the dirty flag is
+        //only cleared afterwards to avoid the dirty list being modified while it's iterated.
+        for (auto leafIndex : m_dirtyLeaves)
+        {
+            UpdateLeafBounds(leafIndex);
+            m_nodes[leafIndex].m_isDirty = false;
+        }
+        
+        //If a large number of volumes have been added, such as when a level is loaded, building
+        //from scratch is both faster and results in a better tree than inserting individually.
+        if (m_numPendingLeaves > m_numLeaves - m_numPendingLeaves)
+        {
+            m_dirtyLeaves.clear();
+            Rebuild();
+            return;
+        }
+        
+        for (auto leafIndex : m_dirtyLeaves)
+        {
+            if (m_nodes[leafIndex].m_isInTree)
+            {
+                RefitAncestors(m_nodes[leafIndex].m_parent);
+            }
+            else
+            {
+                InsertLeaf(leafIndex);
+                --m_numPendingLeaves;
+            }
+        }
+        m_dirtyLeaves.clear();
+        
+        if (CalculateCost() > m_rebuildCost)
+        {
+            Rebuild();
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    f64 VolumeHierarchy::CalculateCost() const noexcept
+    {
+        if (m_root == k_nullNode)
+        {
+            return 0.0;
+        }
+        
+        f64 rootArea = CalculateArea(m_nodes[m_root].m_min, m_nodes[m_root].m_max);
+        return (rootArea > 0.0) ? m_internalArea / rootArea : 0.0;
+    }
+}
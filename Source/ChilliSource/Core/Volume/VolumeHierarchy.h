@@ -0,0 +1,247 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_CORE_VOLUME_VOLUMEHIERARCHY_H_
+#define _CHILLISOURCE_CORE_VOLUME_VOLUMEHIERARCHY_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Event/EventConnection.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// A dynamic bounding volume hierarchy containing the volume components in a scene, used to
+    /// accelerate ray, sphere, box and frustum queries.
+    ///
+    /// Each volume component is stored in a leaf with a world space box enclosing its OOBB. When
+    /// the transform of the owning entity changes, or the volume is invalidated, the leaf is
+    /// refitted prior to the next query. Refitting doesn't change the structure of the tree, so
+    /// the quality of the tree is tracked using the surface area heuristic, and the tree is
+    /// rebuilt once it has degraded too far relative to the last build.
+    ///
+    /// Query results are appended to the output list, and the appended range is sorted nearest
+    /// first. The value used for sorting is also stored in the query intersection value of each
+    /// volume component.
+    ///
+    /// This is not thread-safe and should only be used on the main thread.
+    ///
+    class VolumeHierarchy final
+    {
+    public:
+        CS_DECLARE_NOCOPY(VolumeHierarchy);
+        
+        VolumeHierarchy() = default;
+        
+        /// @return The number of volume components in the hierarchy.
+        ///
+        u32 GetNumVolumes() const noexcept { return m_numLeaves; }
+        
+        /// Adds the given volume component to the hierarchy. The bounds of the volume are not
+        /// calculated until the next query. The volume component must be attached to an entity.
+        ///
+        /// @param volumeComponent
+        ///     The volume component to add. Must not already be in a hierarchy.
+        ///
+        void Add(VolumeComponent* volumeComponent) noexcept;
+        
+        /// Removes the given volume component from the hierarchy.
+        ///
+        /// @param volumeComponent
+        ///     The volume component to remove. Must be in this hierarchy.
+        ///
+        void Remove(VolumeComponent* volumeComponent) noexcept;
+        
+        /// Flags the bounds of the given volume component as having changed, so that they will be
+        /// refitted prior to the next query. This is called automatically when the transform of
+        /// the owning entity changes.
+        ///
+        /// @param volumeComponent
+        ///     The volume component which has changed. Must be in this hierarchy.
+        ///
+        void Invalidate(VolumeComponent* volumeComponent) noexcept;
+        
+        /// Finds all volume components whose OOBB is intersected by the given ray. Results are
+        /// sorted by the distance along the ray to the near intersection.
+        ///
+        /// @param ray
+        ///     The ray.
+        /// @param outVolumeComponents
+        ///     (Out) The list to append the intersecting volume components to.
+        ///
+        void QueryRay(const Ray& ray, std::vector<VolumeComponent*>& outVolumeComponents) noexcept;
+        
+        /// Finds all volume components whose OOBB intersects the given sphere. Results are sorted
+        /// by the distance from the centre of the sphere to the centre of the OOBB.
+        ///
+        /// @param sphere
+        ///     The sphere.
+        /// @param outVolumeComponents
+        ///     (Out) The list to append the intersecting volume components to.
+        ///
+        void QuerySphere(const Sphere& sphere, std::vector<VolumeComponent*>& outVolumeComponents) noexcept;
+        
+        /// Finds all volume components whose OOBB intersects the given box. Results are sorted
+        /// by the distance from the centre of the box to the centre of the OOBB.
+        ///
+        /// @param aabb
+        ///     The box.
+        /// @param outVolumeComponents
+        ///     (Out) The list to append the intersecting volume components to.
+        ///
+        void QueryAABB(const AABB& aabb, std::vector<VolumeComponent*>& outVolumeComponents) noexcept;
+        
+        /// Finds all volume components whose OOBB is at least partially inside the given
+        /// frustum. Results are sorted by the distance from the near plane to the centre of the
+        /// OOBB.
+        ///
+        /// As with frustum culling, an OOBB is only rejected if it is entirely behind one of the
+        /// planes, so an OOBB near a corner of the frustum may be returned despite lying outside it.
+        ///
+        /// @param frustum
+        ///     The frustum.
+        /// @param outVolumeComponents
+        ///     (Out) The list to append the intersecting volume components to.
+        ///
+        void QueryFrustum(const Frustum& frustum, std::vector<VolumeComponent*>& outVolumeComponents) noexcept;
+        
+    private:
+        /// A single node in the tree. Leaf nodes have no children and reference a volume
+        /// component, while internal nodes always have two children.
+        ///
+        struct Node
+        {
+            Vector3 m_min;
+            Vector3 m_max;
+            s32 m_parent = -1;
+            s32 m_left = -1;
+            s32 m_right = -1;
+            VolumeComponent* m_volumeComponent = nullptr;
+            EventConnectionUPtr m_transformChangedConnection;
+            bool m_isDirty = false;
+            bool m_isInTree = false;
+        };
+        
+        /// @return The index of a new node, which may have been recycled from the free list.
+        ///
+        s32 AllocateNode() noexcept;
+        
+        /// Returns the given node to the free list.
+        ///
+        /// @param nodeIndex
+        ///     The index of the node to free.
+        ///
+        void FreeNode(s32 nodeIndex) noexcept;
+        
+        /// Sets the bounds of the given node, keeping the total surface area of the internal
+        /// nodes up to date.
+        ///
+        /// @param nodeIndex
+        ///     The index of the node.
+        /// @param min
+        ///     The minimum of the bounds.
+        /// @param max
+        ///     The maximum of the bounds.
+        ///
+        void SetNodeBounds(s32 nodeIndex, const Vector3& min, const Vector3& max) noexcept;
+        
+        /// Recalculates the bounds of the given leaf from the OOBB of its volume component.
+        ///
+        /// @param leafIndex
+        ///     The index of the leaf.
+        ///
+        void UpdateLeafBounds(s32 leafIndex) noexcept;
+        
+        /// Inserts the given leaf into the tree, beside the sibling that results in the smallest
+        /// increase in surface area.
+        ///
+        /// @param leafIndex
+        ///     The index of the leaf.
+        ///
+        void InsertLeaf(s32 leafIndex) noexcept;
+        
+        /// Removes the given leaf from the tree, replacing its parent with its sibling.
+        ///
+        /// @param leafIndex
+        ///     The index of the leaf.
+        ///
+        void RemoveLeaf(s32 leafIndex) noexcept;
+        
+        /// Recalculates the bounds of the given node and its ancestors from their children,
+        /// stopping as soon as a node's bounds are unchanged.
+        ///
+        /// @param nodeIndex
+        ///     The index of the first node to refit.
+        ///
+        void RefitAncestors(s32 nodeIndex) noexcept;
+        
+        /// Rebuilds the tree from scratch over all leaves, top down, splitting each node at the
+        /// median of its leaves along the longest axis.
+        ///
+        void Rebuild() noexcept;
+        
+        /// Recursively builds the sub-tree containing the given range of build leaves.
+        ///
+        /// @param first
+        ///     The index of the first build leaf in the range.
+        /// @param last
+        ///     One past the index of the last build leaf in the range.
+        ///
+        /// @return The index of the root of the sub-tree.
+        ///
+        s32 Build(u32 first, u32 last) noexcept;
+        
+        /// Refits or inserts any dirty leaves, then rebuilds the tree if its quality has degraded
+        /// too far.
+        ///
+        void Update() noexcept;
+        
+        /// @return The surface area heuristic cost of the tree relative to the root.
+        ///
+        f64 CalculateCost() const noexcept;
+        
+        /// Traverses the tree, collecting the leaves whose bounds pass the given overlap test.
+        ///
+        /// @param overlapTest
+        ///     The test, which takes the minimum and maximum of a node's bounds.
+        ///
+        template <typename TOverlapTest> void CollectLeaves(const TOverlapTest& overlapTest) noexcept;
+        
+        std::vector<Node> m_nodes;
+        std::vector<s32> m_freeNodes;
+        std::vector<s32> m_dirtyLeaves;
+        std::vector<s32> m_buildLeaves;
+        std::vector<s32> m_traversalStack;
+        std::vector<s32> m_queryLeaves;
+        s32 m_root = -1;
+        u32 m_numLeaves = 0;
+        u32 m_numPendingLeaves = 0;
+        f64 m_internalArea = 0.0;
+        f64 m_rebuildCost = 0.0;
+    };
+}
+
+#endif
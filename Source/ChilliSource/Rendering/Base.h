@@ -45,6 +45,7 @@
 #include <ChilliSource/Rendering/Base/HorizontalTextJustification.h>
 #include <ChilliSource/Rendering/Base/IRenderCommandProcessor.h>
 #include <ChilliSource/Rendering/Base/IRenderPassCompiler.h>
+#include <ChilliSource/Rendering/Base/PointLightClusterer.h>
 #include <ChilliSource/Rendering/Base/RenderCapabilities.h>
 #include <ChilliSource/Rendering/Base/RenderCommandCompiler.h>
 #include <ChilliSource/Rendering/Base/Renderer.h>
@@ -58,12 +59,15 @@
 #include <ChilliSource/Rendering/Base/RenderPassObjectSorter.h>
 #include <ChilliSource/Rendering/Base/RenderPassVisibilityChecker.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/RenderUploadPriority.h>
+#include <ChilliSource/Rendering/Base/RenderUploadScheduler.h>
 #include <ChilliSource/Rendering/Base/SizePolicy.h>
 #include <ChilliSource/Rendering/Base/StencilOp.h>
 #include <ChilliSource/Rendering/Base/SurfaceFormat.h>
 #include <ChilliSource/Rendering/Base/TargetRenderPassGroup.h>
 #include <ChilliSource/Rendering/Base/TargetType.h>
 #include <ChilliSource/Rendering/Base/TestFunc.h>
+#include <ChilliSource/Rendering/Base/TextLayoutCache.h>
 #include <ChilliSource/Rendering/Base/VerticalTextJustification.h>
 
 #endif
@@ -37,18 +37,24 @@
 #include <ChilliSource/Core/String/UTF8StringUtils.h>
 #include <ChilliSource/Rendering/Base/CanvasDrawMode.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/TextLayoutCache.h>
 #include <ChilliSource/Rendering/Base/StencilOp.h>
 #include <ChilliSource/Rendering/Base/TargetType.h>
 #include <ChilliSource/Rendering/Base/TestFunc.h>
 #include <ChilliSource/Rendering/Font/Font.h>
 #include <ChilliSource/Rendering/Material/Material.h>
 #include <ChilliSource/Rendering/Material/MaterialFactory.h>
+#include <ChilliSource/Rendering/Model/IndexFormat.h>
+#include <ChilliSource/Rendering/Model/PolygonType.h>
+#include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
 #include <ChilliSource/Rendering/Shader/Shader.h>
 #include <ChilliSource/Rendering/Sprite/SpriteMeshBuilder.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/UI/Base/Canvas.h>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace ChilliSource
 {
@@ -58,6 +64,14 @@ namespace ChilliSource
         const f32 k_autoScaleTolerance = 0.01f;//Min difference in max/min scaling to warrant further recursion for AutoScaled text
         const u32 k_uiStencilMaskChannel = 0x0000000f; //The "channel" of the stencil buffer used by the UI. If other systems use the stencil buffer they must use an alternate channel
         
+        constexpr u32 k_verticesPerCharacter = 4;
+        constexpr u32 k_indicesPerCharacter = 6;
+        constexpr u32 k_maxCharactersByVertexData = RenderDynamicMesh::k_maxVertexDataSize / (k_verticesPerCharacter * sizeof(SpriteVertex));
+        constexpr u32 k_maxCharactersByIndexData = RenderDynamicMesh::k_maxIndexDataSize / (k_indicesPerCharacter * sizeof(u16));
+        constexpr u32 k_maxCharactersPerMesh = (k_maxCharactersByVertexData < k_maxCharactersByIndexData) ? k_maxCharactersByVertexData : k_maxCharactersByIndexData;
+        
+        const u16 k_characterIndices[k_indicesPerCharacter] { 0, 1, 2, 1, 3, 2 };
+        
         //------------------------------------------------------
         /// Converts a 2D transformation matrix to a 3D
         /// Transformation matrix. This will only work for
@@ -682,6 +696,16 @@ namespace ChilliSource
         auto materialFactory = Application::Get()->GetSystem<MaterialFactory>();
         CS_ASSERT(materialFactory != nullptr, "Must have a material factory");
         
+        //The indices for every text mesh follow the same pattern, so they are built once for the largest possible mesh.
+        m_textIndices.resize(k_maxCharactersPerMesh * k_indicesPerCharacter);
+        for (u32 character = 0; character < k_maxCharactersPerMesh; ++character)
+        {
+            for (u32 i = 0; i < k_indicesPerCharacter; ++i)
+            {
+                m_textIndices[character * k_indicesPerCharacter + i] = u16(character * k_verticesPerCharacter + k_characterIndices[i]);
+            }
+        }
+        
         // Masking works as follows:
         // 1. When drawing a masked shape as well as writing to the colour buffer the shape also writes the current clip mask value to the stencil buffer
         // 2. When rendering to colour buffer, both stencil and colour material are stencil tested using the current clip mask agains the value currently in the stencil buffer.
@@ -763,6 +787,8 @@ namespace ChilliSource
             material->SetStencilPostTestOps(StencilOp::k_keep, StencilOp::k_keep, StencilOp::k_increment);
             material->SetStencilTestFunc(TestFunc::k_equal, 0, k_uiStencilMaskChannel);
         }));
+        
+        m_textLayoutCache = TextLayoutCacheUPtr(new TextLayoutCache());
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
@@ -801,6 +827,11 @@ namespace ChilliSource
             return result;
         }
         
+        if(m_textLayoutCache->TryGet(in_text, in_font, in_bounds, in_properties, result, out_textScale))
+        {
+            return result;
+        }
+        
         f32 lineHeight = in_properties.m_lineSpacingScale * ((in_font->GetLineHeight() + in_properties.m_absLineSpacingOffset) * textScale);
         
         result.m_characters.reserve(in_text.size());
@@ -848,21 +879,97 @@ namespace ChilliSource
         //Carry out the building of the text with the resolved scale
         ChilliSource::BuildText(in_text, textScale, in_font, in_bounds, in_properties, result);
         
+        m_textLayoutCache->Add(in_text, in_font, in_bounds, in_properties, result, textScale);
+        
+        return result;
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    CanvasRenderer::BuiltTextMesh CanvasRenderer::BuildTextMesh(const std::vector<DisplayCharacterInfo>& characters, const Colour& colour) const noexcept
+    {
+        BuiltTextMesh result;
+        result.m_vertices.resize(characters.size() * k_verticesPerCharacter);
+        
+        ByteColour byteColour = ColourUtils::ColourToByteColour(colour);
+        Vector2 min(std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max());
+        Vector2 max(-std::numeric_limits<f32>::max(), -std::numeric_limits<f32>::max());
+        
+        for (u32 i = 0; i < characters.size(); ++i)
+        {
+            const auto& character = characters[i];
+            const auto& uvs = character.m_UVs;
+            
+            //Each character is anchored at its top left, with vertices in the same order as SpriteMeshBuilder.
+            Vector2 topLeft = character.m_position;
+            Vector2 bottomRight = character.m_position + Vector2(character.m_packedImageSize.x, -character.m_packedImageSize.y);
+            
+            SpriteVertex* vertices = &result.m_vertices[i * k_verticesPerCharacter];
+            vertices[0].m_position = Vector4(topLeft.x, topLeft.y, 0.0f, 1.0f);
+            vertices[0].m_texCoord = Vector2(uvs.m_u, uvs.m_v);
+            vertices[1].m_position = Vector4(topLeft.x, bottomRight.y, 0.0f, 1.0f);
+            vertices[1].m_texCoord = Vector2(uvs.m_u, uvs.m_v + uvs.m_t);
+            vertices[2].m_position = Vector4(bottomRight.x, topLeft.y, 0.0f, 1.0f);
+            vertices[2].m_texCoord = Vector2(uvs.m_u + uvs.m_s, uvs.m_v);
+            vertices[3].m_position = Vector4(bottomRight.x, bottomRight.y, 0.0f, 1.0f);
+            vertices[3].m_texCoord = Vector2(uvs.m_u + uvs.m_s, uvs.m_v + uvs.m_t);
+            for (u32 j = 0; j < k_verticesPerCharacter; ++j)
+            {
+                vertices[j].m_colour = byteColour;
+            }
+            
+            min = Vector2::Min(min, Vector2(topLeft.x, bottomRight.y));
+            max = Vector2::Max(max, Vector2(bottomRight.x, topLeft.y));
+        }
+        
+        if (characters.empty() == false)
+        {
+            Vector2 halfSize = 0.5f * (max - min);
+            result.m_boundingSphere = Sphere(Vector3(min + halfSize, 0.0f), halfSize.Length());
+        }
+        
         return result;
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
     void CanvasRenderer::DrawText(const std::vector<DisplayCharacterInfo>& characters, const Matrix3& transform, const Colour& colour, const TextureCSPtr& texture)
     {
+        DrawText(BuildTextMesh(characters, colour), transform, texture);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void CanvasRenderer::DrawText(const BuiltTextMesh& textMesh, const Matrix3& transform, const TextureCSPtr& texture)
+    {
+        u32 numCharacters = u32(textMesh.m_vertices.size()) / k_verticesPerCharacter;
+        if (numCharacters == 0)
+        {
+            return;
+        }
+        
         auto material = m_screenMaterialPool->GetMaterial(texture, m_clipMaskCount);
-
-        Matrix4 matTransform = Convert2DTransformTo3D(transform);
-        Matrix4 matTransformedLocal;
-
-        for (const auto& character : characters)
+        Matrix4 worldMatrix = Convert2DTransformTo3D(transform);
+        
+        f32 maxScale = std::max(Vector2(transform.m[0], transform.m[1]).Length(), Vector2(transform.m[3], transform.m[4]).Length());
+        Sphere worldBoundingSphere(textMesh.m_boundingSphere.vOrigin * worldMatrix, textMesh.m_boundingSphere.fRadius * maxScale);
+        
+        //Text is split over multiple meshes only if it contains more characters than a single dynamic mesh can index.
+        for (u32 firstCharacter = 0; firstCharacter < numCharacters; firstCharacter += k_maxCharactersPerMesh)
         {
-            matTransformedLocal = Matrix4::CreateTranslation(Vector3(character.m_position, 0.0f)) * matTransform;
-            AddSpriteRenderObject(m_currentRenderSnapshot, m_currentFrameAllocator, Vector3::k_zero, character.m_packedImageSize, character.m_UVs, colour, AlignmentAnchor::k_topLeft, matTransformedLocal, material, m_nextPriority++);
+            u32 numMeshCharacters = std::min(numCharacters - firstCharacter, k_maxCharactersPerMesh);
+            u32 numVertices = numMeshCharacters * k_verticesPerCharacter;
+            u32 numIndices = numMeshCharacters * k_indicesPerCharacter;
+            u32 vertexDataSize = numVertices * sizeof(SpriteVertex);
+            u32 indexDataSize = numIndices * sizeof(u16);
+            
+            auto vertexData = MakeUniqueArray<u8>(*m_currentFrameAllocator, vertexDataSize);
+            auto indexData = MakeUniqueArray<u8>(*m_currentFrameAllocator, indexDataSize);
+            std::memcpy(vertexData.get(), &textMesh.m_vertices[firstCharacter * k_verticesPerCharacter], vertexDataSize);
+            std::memcpy(indexData.get(), m_textIndices.data(), indexDataSize);
+            
+            auto renderDynamicMesh = MakeUnique<RenderDynamicMesh>(*m_currentFrameAllocator, PolygonType::k_triangle, VertexFormat::k_sprite, IndexFormat::k_short, numVertices, numIndices,
+                                                                   textMesh.m_boundingSphere, std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize);
+            
+            m_currentRenderSnapshot->AddRenderObject(RenderObject(material->GetRenderMaterialGroup(), renderDynamicMesh.get(), worldMatrix, worldBoundingSphere, false, RenderLayer::k_ui, m_nextPriority++));
+            m_currentRenderSnapshot->AddRenderDynamicMesh(std::move(renderDynamicMesh));
         }
     }
     //----------------------------------------------------------------------------
@@ -881,6 +988,7 @@ namespace ChilliSource
             m_currentRenderSnapshot = &renderSnapshot;
             m_nextPriority = 0;
             
+            activeUICanvas->UpdateLayout();
             activeUICanvas->Draw(this);
             
             m_currentRenderSnapshot = nullptr;
@@ -902,5 +1010,12 @@ namespace ChilliSource
         
         m_maskMaterialPool->Clear();
         m_maskMaterialPool.reset();
+        
+        m_textLayoutCache.reset();
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    CanvasRenderer::~CanvasRenderer()
+    {
     }
 }
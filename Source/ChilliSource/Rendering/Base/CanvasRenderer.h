@@ -35,8 +35,11 @@
 #include <ChilliSource/Rendering/Base/CanvasMaterialPool.h>
 #include <ChilliSource/Rendering/Base/HorizontalTextJustification.h>
 #include <ChilliSource/Rendering/Base/VerticalTextJustification.h>
+#include <ChilliSource/Rendering/Model/VertexFormat.h>
 #include <ChilliSource/Rendering/Texture/UVs.h>
 
+#include <vector>
+
 namespace ChilliSource
 {
     //----------------------------------------------------------------------------
@@ -94,6 +97,17 @@ namespace ChilliSource
             f32 m_width;
             f32 m_height;
         };
+        
+        /// Holds the vertices for a block of built text, with a quad for every character
+        /// positioned in text space. This can be retained and drawn each frame with only
+        /// the transform changing, and only needs to be rebuilt if the characters or
+        /// colour change.
+        ///
+        struct BuiltTextMesh
+        {
+            std::vector<SpriteVertex> m_vertices;
+            Sphere m_boundingSphere;
+        };
         //----------------------------------------------------------------------------
         /// Defines a type for a vector of bounded lines
         ///
@@ -155,11 +169,28 @@ namespace ChilliSource
         /// @param in_textProperties - The text properties used to build.
         /// @param [Out] out_textScale - Final scale that should be used
         ///
+        /// Built text is cached, so building the same text with the same font, bounds
+        /// and properties again returns the previous result without repeating the work.
+        ///
         /// @return Built text struct containing all the character infos
         //----------------------------------------------------------------------------
         BuiltText BuildText(const std::string& in_text, const FontCSPtr& in_font, const Vector2& in_bounds, const TextProperties& in_textProperties, f32& out_textScale) const;
 
-        /// Build the sprites for each given character and render them to screen.
+        /// Builds a single mesh containing a quad for each of the given characters. The
+        /// result can be retained and passed to DrawText() each frame.
+        ///
+        /// @param characters
+        ///     List of character display infos in text space
+        /// @param colour
+        ///     Tint colour to apply to the characters
+        ///
+        /// @return The built text mesh.
+        ///
+        BuiltTextMesh BuildTextMesh(const std::vector<DisplayCharacterInfo>& characters, const Colour& colour) const noexcept;
+        
+        /// Build a mesh for the given characters and render it to screen. If the
+        /// characters are unchanged between frames prefer retaining the result of
+        /// BuildTextMesh() instead.
         ///
         /// @param characters
         ///     List of character display infos in text space
@@ -171,6 +202,29 @@ namespace ChilliSource
         ///     Font texture
         ///
         void DrawText(const std::vector<DisplayCharacterInfo>& characters, const Matrix3& transform, const Colour& colour, const TextureCSPtr& texture);
+        
+        /// Renders the given pre-built text mesh to screen. The text is rendered as a
+        /// single render object unless it contains more characters than can fit in
+        /// one dynamic mesh.
+        ///
+        /// @param textMesh
+        ///     The text mesh built with BuildTextMesh().
+        /// @param transform
+        ///     2D transform to screen space
+        /// @param texture
+        ///     Font texture
+        ///
+        void DrawText(const BuiltTextMesh& textMesh, const Matrix3& transform, const TextureCSPtr& texture);
+        
+        /// @return The cache of built text, through which the memory budget can be changed
+        ///     and the cache statistics queried.
+        ///
+        TextLayoutCache& GetTextLayoutCache() noexcept { return *m_textLayoutCache; }
+        
+        /// Destructor. This is defined out of line as TextLayoutCache is only forward declared
+        /// here.
+        ///
+        ~CanvasRenderer();
 
     private:
 
@@ -222,10 +276,14 @@ namespace ChilliSource
         u32 m_nextPriority = 0;
         
         s32 m_clipMaskCount = 0;
+        
+        std::vector<u16> m_textIndices;
 
         CanvasMaterialPoolUPtr m_screenMaterialPool;
         CanvasMaterialPoolUPtr m_screenMaskMaterialPool;
         CanvasMaterialPoolUPtr m_maskMaterialPool;
+        
+        TextLayoutCacheUPtr m_textLayoutCache;
 
         ResourcePool* m_resourcePool;
         Screen* m_screen;
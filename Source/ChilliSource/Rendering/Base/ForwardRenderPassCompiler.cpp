@@ -26,6 +26,8 @@
 
 #include <ChilliSource/Core/Math/Geometry/ShapeIntersection.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Time/Profiler.h>
+#include <ChilliSource/Rendering/Base/PointLightClusterer.h>
 #include <ChilliSource/Rendering/Base/RenderPasses.h>
 #include <ChilliSource/Rendering/Base/RenderFrame.h>
 #include <ChilliSource/Rendering/Base/RenderObject.h>
@@ -276,28 +278,59 @@ namespace ChilliSource
             return renderPassObjects;
         }
         
-        /// Parses a list of RenderObjects and generates a list of RenderPassObjects for
-        /// each RenderObject that has a PointLight pass defined, and is within the range
-        /// of influence of the given light.
+        /// Assigns each RenderObject to the point lights whose range of influence it is
+        /// within, using PointLightClusterer rather than testing every object against every
+        /// light. Whether or not an object has a PointLight pass defined is not checked here,
+        /// so that the material lookups can be performed in the per-light tasks.
         ///
         /// @param renderObjects
         ///     A list of RenderObjects to parse
-        /// @param pointRenderLight
-        ///     The render light to get objects for.
+        /// @param pointRenderLights
+        ///     The point lights.
         ///
-        /// @return A collection of RenderPassObjects for the render light pass.
+        /// @return The indices of the objects influenced by each light. This is empty if
+        ///     there are no point lights.
         ///
-        std::vector<RenderPassObject> GetPointLightRenderPassObjects(const std::vector<RenderObject>& renderObjects, const PointRenderLight& pointRenderLight) noexcept
+        std::vector<std::vector<u32>> GetPointLightObjectIndices(const std::vector<RenderObject>& renderObjects, const std::vector<PointRenderLight>& pointRenderLights) noexcept
         {
-            Sphere pointLightBoundingSphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence());
+            if (pointRenderLights.empty())
+            {
+                return std::vector<std::vector<u32>>();
+            }
             
-            std::vector<RenderPassObject> renderPassObjects;
+            std::vector<Sphere> boundingSpheres;
+            boundingSpheres.reserve(renderObjects.size());
             
             for (const auto& renderObject : renderObjects)
             {
+                boundingSpheres.push_back(renderObject.GetBoundingSphere());
+            }
+            
+            return PointLightClusterer::CalculateLitObjects(boundingSpheres, pointRenderLights);
+        }
+        
+        /// Generates a list of RenderPassObjects for each of the given RenderObjects which
+        /// has a PointLight pass defined.
+        ///
+        /// @param renderObjects
+        ///     A list of RenderObjects.
+        /// @param objectIndices
+        ///     The indices of the objects within range of the light, as returned by
+        ///     GetPointLightObjectIndices().
+        ///
+        /// @return A collection of RenderPassObjects for the render light pass.
+        ///
+        std::vector<RenderPassObject> GetPointLightRenderPassObjects(const std::vector<RenderObject>& renderObjects, const std::vector<u32>& objectIndices) noexcept
+        {
+            std::vector<RenderPassObject> renderPassObjects;
+            renderPassObjects.reserve(objectIndices.size());
+            
+            for (auto objectIndex : objectIndices)
+            {
+                const auto& renderObject = renderObjects[objectIndex];
                 auto renderMaterial = renderObject.GetRenderMaterialGroup()->GetRenderMaterial(GetVertexFormat(renderObject), static_cast<u32>(RenderPasses::k_pointLight));
                 
-                if (renderMaterial && pointLightBoundingSphere.Contains(renderObject.GetBoundingSphere()))
+                if (renderMaterial)
                 {
                     renderPassObjects.push_back(ConvertToRenderPassObject(renderObject, renderMaterial));
                 }
@@ -357,7 +390,7 @@ namespace ChilliSource
             tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects](const TaskContext& innerTaskContext)
             {
                 auto renderPassObjects = GetBaseRenderPassObjects(visibleStandardRenderObjects);
-                RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
+                RenderPassObjectSorter::OpaqueSort(innerTaskContext, renderFrame.GetRenderCamera(), renderPassObjects);
                 renderPasses[basePassIndex] = RenderPass(renderFrame.GetAmbientRenderLight(), std::move(renderPassObjects));
             });
             
@@ -368,19 +401,24 @@ namespace ChilliSource
                 tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects, &directionalLight](const TaskContext& innerTaskContext)
                 {
                     auto renderPassObjects = GetDirectionalLightRenderPassObjects(visibleStandardRenderObjects, directionalLight);
-                    RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
+                    RenderPassObjectSorter::OpaqueSort(innerTaskContext, renderFrame.GetRenderCamera(), renderPassObjects);
                     renderPasses[directionLightPassIndex] = RenderPass(directionalLight, std::move(renderPassObjects));
                 });
             }
             
             // Point light pass
-            for (const auto& pointLight : renderFrame.GetPointRenderLights())
+            const auto& pointLights = renderFrame.GetPointRenderLights();
+            auto pointLightObjectIndices = GetPointLightObjectIndices(visibleStandardRenderObjects, pointLights);
+            
+            for (u32 pointLightIndex = 0; pointLightIndex < pointLights.size(); ++pointLightIndex)
             {
+                const auto& pointLight = pointLights[pointLightIndex];
+                const auto& objectIndices = pointLightObjectIndices[pointLightIndex];
                 u32 pointLightPassIndex = nextPassIndex++;
-                tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects, &pointLight](const TaskContext& innerTaskContext)
+                tasks.push_back([=, &renderPasses, &renderFrame, &visibleStandardRenderObjects, &objectIndices, &pointLight](const TaskContext& innerTaskContext)
                 {
-                    auto renderPassObjects = GetPointLightRenderPassObjects(visibleStandardRenderObjects, pointLight);
-                    RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
+                    auto renderPassObjects = GetPointLightRenderPassObjects(visibleStandardRenderObjects, objectIndices);
+                    RenderPassObjectSorter::OpaqueSort(innerTaskContext, renderFrame.GetRenderCamera(), renderPassObjects);
                     renderPasses[pointLightPassIndex] = RenderPass(pointLight, std::move(renderPassObjects));
                 });
             }
@@ -411,7 +449,7 @@ namespace ChilliSource
                 auto visibleStandardRenderObjects = RenderPassVisibilityChecker::CalculateVisibleObjects(taskContext, renderFrame.GetRenderCamera(), standardRenderObjects);
                 
                 auto renderPassObjects = GetTransparentRenderPassObjects(visibleStandardRenderObjects);
-                RenderPassObjectSorter::TransparentSort(renderFrame.GetRenderCamera(), renderPassObjects);
+                RenderPassObjectSorter::TransparentSort(innerTaskContext, renderFrame.GetRenderCamera(), renderPassObjects);
                 renderPasses[0] = RenderPass(renderFrame.GetAmbientRenderLight(), std::move(renderPassObjects));
             });
             
@@ -476,7 +514,7 @@ namespace ChilliSource
             auto uiRenderPassObjects = GetTransparentRenderPassObjects(visibleUIRenderObjects);
             CS_ASSERT(visibleUIRenderObjects.size() == uiRenderPassObjects.size(), "Invalid number of render pass objects in transparent pass. All render objects in the UI layer should have a transparent material.");
             
-            RenderPassObjectSorter::PrioritySort(uiRenderPassObjects);
+            RenderPassObjectSorter::PrioritySort(taskContext, uiRenderPassObjects);
             
             std::vector<RenderPass> renderPasses;
             if (uiRenderPassObjects.size() > 0)
@@ -567,7 +605,7 @@ namespace ChilliSource
             auto standardRenderObjects = GetLayerRenderObjects(RenderLayer::k_standard, renderFrame.GetRenderObjects());
             auto visibleStandardRenderObjects = RenderPassVisibilityChecker::CalculateVisibleObjects(taskContext, renderFrame.GetRenderCamera(), standardRenderObjects);
             auto renderPassObjects = GetShadowMapRenderPassObjects(visibleStandardRenderObjects);
-            RenderPassObjectSorter::OpaqueSort(renderFrame.GetRenderCamera(), renderPassObjects);
+            RenderPassObjectSorter::OpaqueSort(taskContext, renderFrame.GetRenderCamera(), renderPassObjects);
             RenderPass renderPass(std::move(renderPassObjects));
             
             std::vector<RenderPass> renderPasses;
@@ -583,6 +621,8 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     std::vector<TargetRenderPassGroup> ForwardRenderPassCompiler::CompileTargetRenderPassGroups(const TaskContext& taskContext, std::vector<RenderFrame>&& renderFrames) noexcept
     {
+        CS_PROFILE_ZONE("ForwardRenderPassCompiler::CompileTargetRenderPassGroups");
+        
         u32 numTargets = 0;
         for(const auto& renderFrame : renderFrames)
         {
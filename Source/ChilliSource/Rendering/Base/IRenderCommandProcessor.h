@@ -26,6 +26,7 @@
 #define _CHILLISOURCE_RENDERING_BASE_IRENDERCOMMANDPROCESSOR_H_
 
 #include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Rendering/Base/RenderFrameStats.h>
 
 #include <vector>
 
@@ -60,6 +61,11 @@ namespace ChilliSource
         ///
         virtual void Process(const ChilliSource::RenderCommandBuffer* renderCommandBuffer) noexcept = 0;
         
+        /// @return The statistics gathered while processing the most recent render command
+        ///     buffer.
+        ///
+        virtual RenderFrameStats GetFrameStats() const noexcept = 0;
+        
         /// Called when the GL context is lost, iterate any GL resources and place
         /// them in an invalid state
         ///
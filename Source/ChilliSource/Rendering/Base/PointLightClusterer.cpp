@@ -0,0 +1,244 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Base/PointLightClusterer.h>
+
+#include <ChilliSource/Rendering/Lighting/PointRenderLight.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        constexpr f32 k_targetObjectsPerCell = 4.0f;
+        constexpr u32 k_maxCellsPerAxis = 16;
+        constexpr u32 k_numAxes = 3;
+        
+        /// Lights are binned with a small amount of padding, so that rounding can't cause an
+        /// object which is in range of a light to be missed.
+        ///
+        constexpr f32 k_binningPadding = 1.001f;
+        
+        /// A uniform grid of cells covering the centres of the objects.
+        ///
+        struct Grid
+        {
+            f32 m_min[k_numAxes];
+            f32 m_max[k_numAxes];
+            f32 m_cellSize[k_numAxes];
+            u32 m_cellsPerAxis = 1;
+        };
+        
+        /// @param grid
+        ///     The grid.
+        /// @param axis
+        ///     The axis of the coordinate.
+        /// @param value
+        ///     The value along the axis.
+        ///
+        /// @return The cell coordinate along the given axis which contains the value, clamped
+        ///     to the grid.
+        ///
+        u32 CalcCellCoord(const Grid& grid, u32 axis, f32 value) noexcept
+        {
+            f32 coord = std::floor((value - grid.m_min[axis]) / grid.m_cellSize[axis]);
+            return u32(std::min(std::max(coord, 0.0f), f32(grid.m_cellsPerAxis - 1)));
+        }
+        
+        /// @param grid
+        ///     The grid.
+        /// @param coords
+        ///     The cell coordinates.
+        ///
+        /// @return The index of the cell at the given coordinates.
+        ///
+        u32 CalcCellIndex(const Grid& grid, const u32 (&coords)[k_numAxes]) noexcept
+        {
+            return (coords[2] * grid.m_cellsPerAxis + coords[1]) * grid.m_cellsPerAxis + coords[0];
+        }
+        
+        /// Builds a grid which covers the centres of all the given spheres, with a number of
+        /// cells proportional to the number of spheres.
+        ///
+        /// @param spheres
+        ///     The spheres. Must not be empty.
+        ///
+        /// @return The grid.
+        ///
+        Grid BuildGrid(const std::vector<Sphere>& spheres) noexcept
+        {
+            Grid grid;
+            for (u32 axis = 0; axis < k_numAxes; ++axis)
+            {
+                grid.m_min[axis] = std::numeric_limits<f32>::max();
+                grid.m_max[axis] = -std::numeric_limits<f32>::max();
+            }
+            
+            for (const auto& sphere : spheres)
+            {
+                const f32 centre[k_numAxes] { sphere.vOrigin.x, sphere.vOrigin.y, sphere.vOrigin.z };
+                for (u32 axis = 0; axis < k_numAxes; ++axis)
+                {
+                    grid.m_min[axis] = std::min(grid.m_min[axis], centre[axis]);
+                    grid.m_max[axis] = std::max(grid.m_max[axis], centre[axis]);
+                }
+            }
+            
+            f32 cellsPerAxis = std::ceil(std::cbrt(f32(spheres.size()) / k_targetObjectsPerCell));
+            grid.m_cellsPerAxis = u32(std::min(std::max(cellsPerAxis, 1.0f), f32(k_maxCellsPerAxis)));
+            
+            for (u32 axis = 0; axis < k_numAxes; ++axis)
+            {
+                f32 extent = grid.m_max[axis] - grid.m_min[axis];
+                grid.m_cellSize[axis] = (extent > 0.0f) ? extent / f32(grid.m_cellsPerAxis) : 1.0f;
+            }
+            
+            return grid;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    std::vector<std::vector<u32>> PointLightClusterer::CalculateLitObjects(const std::vector<Sphere>& objectBoundingSpheres, const std::vector<PointRenderLight>& pointRenderLights) noexcept
+    {
+        std::vector<std::vector<u32>> litObjects(pointRenderLights.size());
+        if (objectBoundingSpheres.empty() || pointRenderLights.empty())
+        {
+            return litObjects;
+        }
+        
+        auto grid = BuildGrid(objectBoundingSpheres);
+        u32 numCells = grid.m_cellsPerAxis * grid.m_cellsPerAxis * grid.m_cellsPerAxis;
+        
+        f32 maxObjectRadius = 0.0f;
+        for (const auto& sphere : objectBoundingSpheres)
+        {
+            maxObjectRadius = std::max(maxObjectRadius, sphere.fRadius);
+        }
+        
+        //Each light is binned into every cell that could contain the centre of an object it influences. The ranges
+        //are stored so the cells only need to be calculated once for both counting and filling the bins.
+        std::vector<u32> lightCellRanges(pointRenderLights.size() * k_numAxes * 2);
+        std::vector<bool> isLightInGrid(pointRenderLights.size(), false);
+        std::vector<u32> cellLightStarts(numCells + 1, 0);
+        
+        for (u32 lightIndex = 0; lightIndex < pointRenderLights.size(); ++lightIndex)
+        {
+            const auto& pointRenderLight = pointRenderLights[lightIndex];
+            const f32 position[k_numAxes] { pointRenderLight.GetPosition().x, pointRenderLight.GetPosition().y, pointRenderLight.GetPosition().z };
+            f32 reach = (pointRenderLight.GetRangeOfInfluence() + maxObjectRadius) * k_binningPadding;
+            
+            bool isInGrid = true;
+            for (u32 axis = 0; axis < k_numAxes; ++axis)
+            {
+                isInGrid = isInGrid && (position[axis] + reach >= grid.m_min[axis]) && (position[axis] - reach <= grid.m_max[axis]);
+            }
+            
+            if (isInGrid == false)
+            {
+                continue;
+            }
+            
+            isLightInGrid[lightIndex] = true;
+            
+            u32* range = &lightCellRanges[lightIndex * k_numAxes * 2];
+            for (u32 axis = 0; axis < k_numAxes; ++axis)
+            {
+                range[axis] = CalcCellCoord(grid, axis, position[axis] - reach);
+                range[k_numAxes + axis] = CalcCellCoord(grid, axis, position[axis] + reach);
+            }
+            
+            u32 coords[k_numAxes];
+            for (coords[2] = range[2]; coords[2] <= range[5]; ++coords[2])
+            {
+                for (coords[1] = range[1]; coords[1] <= range[4]; ++coords[1])
+                {
+                    for (coords[0] = range[0]; coords[0] <= range[3]; ++coords[0])
+                    {
+                        ++cellLightStarts[CalcCellIndex(grid, coords) + 1];
+                    }
+                }
+            }
+        }
+        
+        for (u32 cellIndex = 0; cellIndex < numCells; ++cellIndex)
+        {
+            cellLightStarts[cellIndex + 1] += cellLightStarts[cellIndex];
+        }
+        
+        std::vector<u32> cellLights(cellLightStarts[numCells]);
+        std::vector<u32> cellFillPositions(cellLightStarts.begin(), cellLightStarts.end() - 1);
+        
+        for (u32 lightIndex = 0; lightIndex < pointRenderLights.size(); ++lightIndex)
+        {
+            if (isLightInGrid[lightIndex] == false)
+            {
+                continue;
+            }
+            
+            const u32* range = &lightCellRanges[lightIndex * k_numAxes * 2];
+            u32 coords[k_numAxes];
+            for (coords[2] = range[2]; coords[2] <= range[5]; ++coords[2])
+            {
+                for (coords[1] = range[1]; coords[1] <= range[4]; ++coords[1])
+                {
+                    for (coords[0] = range[0]; coords[0] <= range[3]; ++coords[0])
+                    {
+                        cellLights[cellFillPositions[CalcCellIndex(grid, coords)]++] = lightIndex;
+                    }
+                }
+            }
+        }
+        
+        //Each object only needs testing against the lights binned into the cell containing its centre. Objects are
+        //visited in order so each light's list is in ascending order.
+        std::vector<Sphere> lightBoundingSpheres;
+        lightBoundingSpheres.reserve(pointRenderLights.size());
+        for (const auto& pointRenderLight : pointRenderLights)
+        {
+            lightBoundingSpheres.push_back(Sphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence()));
+        }
+        
+        for (u32 objectIndex = 0; objectIndex < objectBoundingSpheres.size(); ++objectIndex)
+        {
+            const auto& objectBoundingSphere = objectBoundingSpheres[objectIndex];
+            const u32 coords[k_numAxes] { CalcCellCoord(grid, 0, objectBoundingSphere.vOrigin.x), CalcCellCoord(grid, 1, objectBoundingSphere.vOrigin.y),
+                CalcCellCoord(grid, 2, objectBoundingSphere.vOrigin.z) };
+            u32 cellIndex = CalcCellIndex(grid, coords);
+            
+            for (u32 i = cellLightStarts[cellIndex]; i < cellLightStarts[cellIndex + 1]; ++i)
+            {
+                u32 lightIndex = cellLights[i];
+                if (lightBoundingSpheres[lightIndex].Contains(objectBoundingSphere))
+                {
+                    litObjects[lightIndex].push_back(objectIndex);
+                }
+            }
+        }
+        
+        return litObjects;
+    }
+}
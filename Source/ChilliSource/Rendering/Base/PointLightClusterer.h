@@ -0,0 +1,59 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_POINTLIGHTCLUSTERER_H_
+#define _CHILLISOURCE_RENDERING_BASE_POINTLIGHTCLUSTERER_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// A collection of functions for assigning objects to the point lights which influence
+    /// them, without testing every object against every light.
+    ///
+    /// The lights are binned into a uniform grid covering the objects, then each object
+    /// gathers its lights from the grid cell which contains it in a single sweep. Lights are
+    /// binned conservatively so the result is identical to testing each light's range of
+    /// influence against every object.
+    ///
+    namespace PointLightClusterer
+    {
+        /// Calculates which objects are influenced by each of the given point lights.
+        ///
+        /// @param objectBoundingSpheres
+        ///     The bounding spheres of the objects which can be lit.
+        /// @param pointRenderLights
+        ///     The point lights.
+        ///
+        /// @return A list for each point light, in the same order as the lights, of the indices
+        ///     of the objects it influences. The indices are in ascending order.
+        ///
+        std::vector<std::vector<u32>> CalculateLitObjects(const std::vector<Sphere>& objectBoundingSpheres, const std::vector<PointRenderLight>& pointRenderLights) noexcept;
+    }
+}
+
+#endif
@@ -175,10 +175,10 @@ namespace ChilliSource
     {
         std::unique_lock<std::mutex>(m_commandBufferMutex);
         
-        for(u32 i = 0; i < renderCommandList->GetNumCommands(); ++i)
+        renderCommandList->ForEachOwningCommand([this](RenderCommand* renderCommand)
         {
-            RecycleCommand(renderCommandList->GetCommand(i));
-        }
+            RecycleCommand(renderCommand);
+        });
     }
     //------------------------------------------------------------------------------
     void RenderCommandBufferManager::RecycleCommand(RenderCommand* renderCommand) noexcept
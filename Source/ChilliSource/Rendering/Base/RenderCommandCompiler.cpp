@@ -24,17 +24,31 @@
 
 #include <ChilliSource/Rendering/Base/RenderCommandCompiler.h>
 
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Memory/UniquePtr.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Time/Profiler.h>
 #include <ChilliSource/Rendering/Base/CameraRenderPassGroup.h>
 #include <ChilliSource/Rendering/Base/RenderPass.h>
 #include <ChilliSource/Rendering/Base/TargetRenderPassGroup.h>
+#include <ChilliSource/Rendering/Material/RenderMaterial.h>
+#include <ChilliSource/Rendering/Model/RenderMesh.h>
 #include <ChilliSource/Rendering/Model/SmallMeshBatcher.h>
 #include <ChilliSource/Rendering/Target/RenderTargetGroup.h>
+#include <ChilliSource/Rendering/Texture/RenderTexture.h>
+
+#include <algorithm>
+#include <limits>
 
 namespace ChilliSource
 {
     namespace
     {
+        /// The minimum number of consecutive instances of the same mesh and material which will be
+        /// rendered as a single render instances command rather than individually.
+        ///
+        constexpr u32 k_minInstances = 2;
+        
         /// An container for the current cached state of a render command list.
         ///
         struct RenderCommandListStateCache final
@@ -84,7 +98,7 @@ namespace ChilliSource
         {
             u32 count = 0;
             
-            if (preRenderCommandList->GetOrderedList().size() > 0)
+            if (preRenderCommandList->GetNumCommands() > 0)
             {
                 ++count;
             }
@@ -107,7 +121,7 @@ namespace ChilliSource
                 ++count; // target cleanup
             }
             
-            if (postRenderCommandList->GetOrderedList().size() > 0)
+            if (postRenderCommandList->GetNumCommands() > 0)
             {
                 ++count;
             }
@@ -187,6 +201,41 @@ namespace ChilliSource
             }
         }
         
+        /// Uploads are time-sliced, so a render pass object can reference a mesh or texture which
+        /// hasn't been uploaded yet. These objects are skipped until everything they use has been.
+        ///
+        /// @param renderPassObject
+        ///     The render pass object.
+        ///
+        /// @return Whether or not the object's mesh and material textures have been uploaded.
+        ///
+        bool IsUploaded(const RenderPassObject& renderPassObject) noexcept
+        {
+            auto renderMesh = renderPassObject.GetRenderMesh();
+            if (renderMesh && !renderMesh->IsUploaded())
+            {
+                return false;
+            }
+            
+            auto renderMaterial = renderPassObject.GetRenderMaterial();
+            for (auto renderTexture : renderMaterial->GetRenderTextures2D())
+            {
+                if (!renderTexture->IsUploaded())
+                {
+                    return false;
+                }
+            }
+            for (auto renderTexture : renderMaterial->GetRenderTexturesCubemap())
+            {
+                if (!renderTexture->IsUploaded())
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        
         /// Adds a new apply material command.
         ///
         /// If the cache already contains the material the no command will be generated.
@@ -286,6 +335,81 @@ namespace ChilliSource
             }
         }
         
+        /// Calculates the number of consecutive render pass objects, starting at the given index,
+        /// which can be rendered as instances of the same static mesh with the same material. If
+        /// the object at the given index cannot be instanced this will be 1.
+        ///
+        /// @param renderPassObjects
+        ///     The list of render pass objects.
+        /// @param startIndex
+        ///     The index of the first object in the run.
+        /// @param maxInstances
+        ///     The maximum length of the run. Longer runs are split, with the remainder starting
+        ///     a new run.
+        ///
+        /// @return The number of objects in the run.
+        ///
+        u32 CalcNumInstances(const std::vector<RenderPassObject>& renderPassObjects, u32 startIndex, u32 maxInstances) noexcept
+        {
+            const auto& first = renderPassObjects[startIndex];
+            if (first.GetType() != RenderPassObject::Type::k_static)
+            {
+                return 1;
+            }
+            
+            u32 endIndex = startIndex + 1;
+            u32 maxEndIndex = u32(std::min(std::size_t(startIndex) + maxInstances, renderPassObjects.size()));
+            while (endIndex < maxEndIndex)
+            {
+                const auto& renderPassObject = renderPassObjects[endIndex];
+                if (renderPassObject.GetType() != RenderPassObject::Type::k_static || renderPassObject.GetRenderMesh() != first.GetRenderMesh() ||
+                    renderPassObject.GetRenderMaterial() != first.GetRenderMaterial())
+                {
+                    break;
+                }
+                
+                ++endIndex;
+            }
+            
+            return endIndex - startIndex;
+        }
+        
+        /// Adds either a render instance command, or if there is a run of objects which share the
+        /// same static mesh and material, a single render instances command for the run. The run
+        /// is limited to the number of world matrices which fit in a single allocation from the
+        /// frame allocator; any remaining objects are rendered by subsequent calls.
+        ///
+        /// @param renderPassObjects
+        ///     The list of render pass objects.
+        /// @param startIndex
+        ///     The index of the first object to render.
+        /// @param renderCommandList
+        ///     The render command list to add the command to.
+        /// @param frameAllocator
+        ///     The allocator from which the instance data will be allocated. Must be thread-safe.
+        ///
+        /// @return The number of render pass objects which were rendered.
+        ///
+        u32 AddRenderInstanceCommands(const std::vector<RenderPassObject>& renderPassObjects, u32 startIndex, RenderCommandList* renderCommandList, IAllocator* frameAllocator) noexcept
+        {
+            u32 maxInstances = u32(std::min(frameAllocator->GetMaxAllocationSize() / sizeof(Matrix4), std::size_t(std::numeric_limits<u32>::max())));
+            u32 numInstances = CalcNumInstances(renderPassObjects, startIndex, maxInstances);
+            if (numInstances < k_minInstances)
+            {
+                renderCommandList->AddRenderInstanceCommand(renderPassObjects[startIndex].GetWorldMatrix());
+                return 1;
+            }
+            
+            auto worldMatrices = MakeUniqueArray<Matrix4>(*frameAllocator, numInstances);
+            for (u32 i = 0; i < numInstances; ++i)
+            {
+                worldMatrices[i] = renderPassObjects[startIndex + i].GetWorldMatrix();
+            }
+            
+            renderCommandList->AddRenderInstancesCommand(std::move(worldMatrices), numInstances);
+            return numInstances;
+        }
+        
         /// Compiles the render commands for the given render pass. The render pass must contain
         /// render pass objects otherwise this will assert.
         ///
@@ -293,10 +417,11 @@ namespace ChilliSource
         ///     The render pass.
         /// @param renderCommandList
         ///     The render command list to add the commands to.
-        /// @param renderFrameData
-        ///     Container for all allocations which must live until the end of the frame.
+        /// @param frameAllocator
+        ///     The allocator from which any data which must live until the end of the frame, such
+        ///     as batched mesh data, should be allocated. Must be thread-safe.
         ///
-        void CompileRenderCommandsForPass(const RenderPass& renderPass, RenderCommandList* renderCommandList) noexcept
+        void CompileRenderCommandsForPass(const RenderPass& renderPass, RenderCommandList* renderCommandList, IAllocator* frameAllocator) noexcept
         {
             AddApplyLightCommand(renderPass, renderCommandList);
             
@@ -304,10 +429,19 @@ namespace ChilliSource
             CS_ASSERT(renderPassObjects.size() > 0, "Cannot compile a pass with no objects.");
             
             RenderCommandListStateCache cache;
-            SmallMeshBatcher batcher(renderCommandList);
+            SmallMeshBatcher batcher(renderCommandList, frameAllocator);
             
-            for (const auto& renderPassObject : renderPassObjects)
+            u32 index = 0;
+            while (index < renderPassObjects.size())
             {
+                const auto& renderPassObject = renderPassObjects[index];
+                
+                if (!IsUploaded(renderPassObject))
+                {
+                    ++index;
+                    continue;
+                }
+                
                 AddApplyMaterialCommand(renderPassObject, renderCommandList, cache, batcher);
                 
                 if (SmallMeshBatcher::CanBatch(renderPassObject))
@@ -316,6 +450,7 @@ namespace ChilliSource
                     cache.m_dynamicMesh = nullptr;
                 
                     batcher.Batch(renderPassObject);
+                    ++index;
                 }
                 else
                 {
@@ -323,9 +458,8 @@ namespace ChilliSource
                     
                     AddApplyMeshCommand(renderPassObject, renderCommandList, cache);
                     AddApplySkinnedAnimationCommand(renderPassObject, renderCommandList, cache);
-                    renderCommandList->AddRenderInstanceCommand(renderPassObject.GetWorldMatrix());
+                    index += AddRenderInstanceCommands(renderPassObjects, index, renderCommandList, frameAllocator);
                 }
-                
             }
             
             batcher.Flush();
@@ -336,12 +470,14 @@ namespace ChilliSource
     RenderCommandBufferUPtr RenderCommandCompiler::CompileRenderCommands(const TaskContext& taskContext, IAllocator* frameAllocator, const std::vector<TargetRenderPassGroup>& targetRenderPassGroups, RenderCommandListUPtr preRenderCommandList,
                                                                          RenderCommandListUPtr postRenderCommandList, std::vector<RenderFrameData> renderFramesData) noexcept
     {
+        CS_PROFILE_ZONE("RenderCommandCompiler::CompileRenderCommands");
+        
         u32 numLists = CalcNumRenderCommandLists(targetRenderPassGroups, preRenderCommandList.get(), postRenderCommandList.get());
         RenderCommandBufferUPtr renderCommandBuffer(new RenderCommandBuffer(numLists, frameAllocator, std::move(renderFramesData)));
         std::vector<Task> tasks;
         u32 currentList = 0;
         
-        if (preRenderCommandList->GetOrderedList().size() > 0)
+        if (preRenderCommandList->GetNumCommands() > 0)
         {
             *renderCommandBuffer->GetRenderCommandList(currentList++) = std::move(*preRenderCommandList);
         }
@@ -364,7 +500,7 @@ namespace ChilliSource
                             auto renderCommandList = renderCommandBuffer->GetRenderCommandList(currentList++);
                             tasks.push_back([=, &renderPass, &renderCommandBuffer](const TaskContext& innerTaskContext)
                             {
-                                CompileRenderCommandsForPass(renderPass, renderCommandList);
+                                CompileRenderCommandsForPass(renderPass, renderCommandList, frameAllocator);
                             });
                         }
                     }
@@ -374,7 +510,7 @@ namespace ChilliSource
             renderCommandBuffer->GetRenderCommandList(currentList++)->AddEndCommand();
         }
         
-        if (postRenderCommandList->GetOrderedList().size() > 0)
+        if (postRenderCommandList->GetNumCommands() > 0)
         {
             *renderCommandBuffer->GetRenderCommandList(currentList++) = std::move(*postRenderCommandList);
         }
@@ -24,6 +24,8 @@
 
 #include <ChilliSource/Rendering/Base/RenderFrameCompiler.h>
 
+#include <ChilliSource/Core/Time/Profiler.h>
+
 #include <vector>
 
 namespace ChilliSource
@@ -59,6 +61,8 @@ namespace ChilliSource
                                                         const std::vector<DirectionalRenderLight>& renderDirectionalLights, const std::vector<PointRenderLight>& renderPointLights,
                                                         const std::vector<RenderObject>& renderObjects) noexcept
     {
+        CS_PROFILE_ZONE("RenderFrameCompiler::CompileRenderFrame");
+        
         //TODO: Perform all render jobs in background tasks prior to building the complete render frame.
         
         auto renderAmbientLight = MergeAmbientRenderLights(renderAmbientLights);
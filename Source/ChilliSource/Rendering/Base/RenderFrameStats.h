@@ -0,0 +1,47 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_RENDERFRAMESTATS_H_
+#define _CHILLISOURCE_RENDERING_BASE_RENDERFRAMESTATS_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+namespace ChilliSource
+{
+    /// Statistics gathered by the render command processor while processing a single frame.
+    ///
+    struct RenderFrameStats final
+    {
+        /// The number of render API state changes which were issued.
+        ///
+        u32 m_numStateChangesIssued = 0;
+        
+        /// The number of render API state changes which were skipped because the state was
+        /// already set.
+        ///
+        u32 m_numStateChangesElided = 0;
+    };
+}
+
+#endif
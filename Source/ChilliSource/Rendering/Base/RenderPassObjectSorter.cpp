@@ -22,73 +22,391 @@
 //  THE SOFTWARE.
 //
 
+
 #include <ChilliSource/Rendering/Base/RenderPassObjectSorter.h>
 
+#include <ChilliSource/Core/Threading/TaskContext.h>
 #include <ChilliSource/Rendering/Camera/RenderCamera.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unordered_map>
+
 namespace ChilliSource
 {
-    //------------------------------------------------------------------------------
-    void RenderPassObjectSorter::OpaqueSort(const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept
+    namespace
     {
-        //The tile base deferred renderer on all iOS hardware does not benefit from front to back sorting https://developer.apple.com/library/content/documentation/3DDrawing/Conceptual/OpenGLES_ProgrammingGuide/Performance/Performance.html
-#ifndef CS_TARGETPLATFORM_IOS
-        std::sort(renderPassObjects.begin(), renderPassObjects.end(), [&camera](const RenderPassObject& a, const RenderPassObject& b)
+        constexpr u32 k_itemsPerSortTask = 4096;
+        constexpr u32 k_radixBits = 8;
+        constexpr u32 k_radixSize = 1 << k_radixBits;
+        constexpr u32 k_radixMask = k_radixSize - 1;
+        constexpr u32 k_numRadixPasses = 64 / k_radixBits;
+        
+        /// A packed 64-bit sort key and the index of the render pass object it describes.
+        ///
+        struct SortItem final
+        {
+            u64 m_key;
+            u32 m_index;
+        };
+        
+        using Histogram = std::array<u32, k_radixSize>;
+        
+        /// A lookup from each unique pointer in a collection to its rank when the unique pointers
+        /// are ordered by address. This allows pointer ordering to be packed into a sort key
+        /// using only as many bits as there are unique pointers.
+        ///
+        struct RankLookup final
+        {
+            std::unordered_map<const void*, u32> m_ranks;
+            u32 m_numBits = 0;
+        };
+        
+        /// @param numItems
+        ///     The number of items to be processed.
+        ///
+        /// @return The number of chunks the given number of items will be split into when processing.
+        ///
+        u32 CalcNumChunks(u32 numItems) noexcept
         {
-            if (a.GetRenderMaterial() == b.GetRenderMaterial())
+            return std::max(1u, (numItems + k_itemsPerSortTask - 1) / k_itemsPerSortTask);
+        }
+        
+        /// @param numValues
+        ///     The number of distinct values which need to be represented.
+        ///
+        /// @return The number of bits required to represent the given number of distinct values.
+        ///
+        u32 CalcNumBits(u32 numValues) noexcept
+        {
+            u32 numBits = 0;
+            while (numBits < 32 && (u64(1) << numBits) < u64(numValues))
+            {
+                ++numBits;
+            }
+            return numBits;
+        }
+        
+        /// Calls the given function for each chunk of the range [0, numItems). If there is more
+        /// than one chunk then each is processed in a separate child task.
+        ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks.
+        /// @param numItems
+        ///     The number of items in the range.
+        /// @param function
+        ///     The function to call for each chunk. This is passed the chunk index, and the
+        ///     first and one-past-last item index of the chunk.
+        ///
+        template <typename TFunction> void ForEachChunk(const TaskContext& taskContext, u32 numItems, const TFunction& function) noexcept
+        {
+            u32 numChunks = CalcNumChunks(numItems);
+            if (numChunks == 1)
+            {
+                function(0, 0, numItems);
+                return;
+            }
+            
+            std::vector<Task> tasks;
+            tasks.reserve(numChunks);
+            for (u32 chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+            {
+                tasks.push_back([=, &function](const TaskContext& innerTaskContext)
+                {
+                    u32 begin = chunkIndex * k_itemsPerSortTask;
+                    u32 end = std::min(begin + k_itemsPerSortTask, numItems);
+                    function(chunkIndex, begin, end);
+                });
+            }
+            
+            taskContext.ProcessChildTasks(tasks);
+        }
+        
+        /// Sorts the given items by key using a stable least significant digit radix sort. Each
+        /// pass builds per-chunk histograms and scatters each chunk in parallel. Passes where every
+        /// key shares the same digit are skipped.
+        ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks.
+        /// @param sortItems
+        ///     The items to sort.
+        ///
+        void RadixSort(const TaskContext& taskContext, std::vector<SortItem>& sortItems) noexcept
+        {
+            u32 numItems = u32(sortItems.size());
+            std::vector<SortItem> scratch(numItems);
+            std::vector<Histogram> histograms(CalcNumChunks(numItems));
+            
+            auto source = &sortItems;
+            auto destination = &scratch;
+            
+            for (u32 pass = 0; pass < k_numRadixPasses; ++pass)
             {
-                Matrix4 wvpA = a.GetWorldMatrix() * camera.GetViewProjectionMatrix();
-                Matrix4 wvpB = b.GetWorldMatrix() * camera.GetViewProjectionMatrix();
+                u32 shift = pass * k_radixBits;
                 
-                if (wvpA.GetTranslation().z == wvpB.GetTranslation().z)
+                ForEachChunk(taskContext, numItems, [&](u32 chunkIndex, u32 begin, u32 end)
                 {
-                    return (a.GetRenderMesh() < b.GetRenderMesh());
+                    auto& histogram = histograms[chunkIndex];
+                    histogram.fill(0);
+                    for (u32 i = begin; i < end; ++i)
+                    {
+                        ++histogram[((*source)[i].m_key >> shift) & k_radixMask];
+                    }
+                });
+                
+                //If every key shares the same digit then this pass wouldn't change the order.
+                bool isPassRequired = true;
+                for (u32 digit = 0; digit < k_radixSize; ++digit)
+                {
+                    u32 count = 0;
+                    for (const auto& histogram : histograms)
+                    {
+                        count += histogram[digit];
+                    }
+                    
+                    if (count > 0)
+                    {
+                        isPassRequired = (count < numItems);
+                        break;
+                    }
                 }
-                else
+                
+                if (!isPassRequired)
                 {
-                    return (wvpA.GetTranslation().z > wvpB.GetTranslation().z);
+                    continue;
                 }
+                
+                //Convert the histograms to the offset each chunk should start writing each digit to.
+                u32 offset = 0;
+                for (u32 digit = 0; digit < k_radixSize; ++digit)
+                {
+                    for (auto& histogram : histograms)
+                    {
+                        u32 count = histogram[digit];
+                        histogram[digit] = offset;
+                        offset += count;
+                    }
+                }
+                
+                ForEachChunk(taskContext, numItems, [&](u32 chunkIndex, u32 begin, u32 end)
+                {
+                    auto& offsets = histograms[chunkIndex];
+                    for (u32 i = begin; i < end; ++i)
+                    {
+                        const auto& sortItem = (*source)[i];
+                        (*destination)[offsets[(sortItem.m_key >> shift) & k_radixMask]++] = sortItem;
+                    }
+                });
+                
+                std::swap(source, destination);
             }
-            else
+            
+            if (source != &sortItems)
             {
-                return (a.GetRenderMaterial() < b.GetRenderMaterial());
+                sortItems.swap(scratch);
             }
-        });
-#endif
-    }
-    
-    //------------------------------------------------------------------------------
-    void RenderPassObjectSorter::TransparentSort(const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept
-    {
-        std::sort(renderPassObjects.begin(), renderPassObjects.end(), [&camera](const RenderPassObject& a, const RenderPassObject& b)
+        }
+        
+        /// Builds a rank lookup for the pointers returned by the given getter for each render
+        /// pass object.
+        ///
+        /// @param renderPassObjects
+        ///     The render pass objects.
+        /// @param getter
+        ///     Function which returns the pointer to rank for a render pass object.
+        ///
+        /// @return The rank lookup.
+        ///
+        template <typename TGetter> RankLookup CalcRankLookup(const std::vector<RenderPassObject>& renderPassObjects, const TGetter& getter) noexcept
+        {
+            RankLookup rankLookup;
+            for (const auto& renderPassObject : renderPassObjects)
+            {
+                rankLookup.m_ranks.emplace(getter(renderPassObject), 0);
+            }
+            
+            std::vector<const void*> uniquePointers;
+            uniquePointers.reserve(rankLookup.m_ranks.size());
+            for (const auto& entry : rankLookup.m_ranks)
+            {
+                uniquePointers.push_back(entry.first);
+            }
+            std::sort(uniquePointers.begin(), uniquePointers.end(), std::less<const void*>());
+            
+            for (u32 i = 0; i < u32(uniquePointers.size()); ++i)
+            {
+                rankLookup.m_ranks[uniquePointers[i]] = i;
+            }
+            
+            rankLookup.m_numBits = CalcNumBits(u32(uniquePointers.size()));
+            return rankLookup;
+        }
+        
+        /// @param renderPassObject
+        ///     The render pass object.
+        ///
+        /// @return The material of the given object as an opaque pointer.
+        ///
+        const void* GetMaterial(const RenderPassObject& renderPassObject) noexcept
+        {
+            return renderPassObject.GetRenderMaterial();
+        }
+        
+        /// @param renderPassObject
+        ///     The render pass object.
+        ///
+        /// @return The static or dynamic mesh of the given object as an opaque pointer.
+        ///
+        const void* GetMesh(const RenderPassObject& renderPassObject) noexcept
         {
-            Matrix4 wvpA = a.GetWorldMatrix() * camera.GetViewProjectionMatrix();
-            Matrix4 wvpB = b.GetWorldMatrix() * camera.GetViewProjectionMatrix();
+            if (renderPassObject.GetRenderMesh())
+            {
+                return renderPassObject.GetRenderMesh();
+            }
+            return renderPassObject.GetRenderDynamicMesh();
+        }
+        
+        /// Calculates the clip space z of the given object's origin. This is the z translation of
+        /// world * viewProjection, without calculating the rest of the matrix.
+        ///
+        /// @param renderPassObject
+        ///     The render pass object.
+        /// @param viewProjection
+        ///     The view projection matrix of the camera.
+        ///
+        /// @return The depth of the object.
+        ///
+        f32 CalcDepth(const RenderPassObject& renderPassObject, const Matrix4& viewProjection) noexcept
+        {
+            const auto& world = renderPassObject.GetWorldMatrix();
+            return world.m[12] * viewProjection.m[2] + world.m[13] * viewProjection.m[6] + world.m[14] * viewProjection.m[10] + world.m[15] * viewProjection.m[14];
+        }
+        
+        /// Converts the given depth to an unsigned integer which decreases as the depth increases,
+        /// so that objects furthest away are sorted first.
+        ///
+        /// @param depth
+        ///     The depth.
+        ///
+        /// @return The depth as an unsigned integer.
+        ///
+        u32 ToDescendingBits(f32 depth) noexcept
+        {
+            u32 bits;
+            std::memcpy(&bits, &depth, sizeof(bits));
             
-            if (wvpA.GetTranslation().z == wvpB.GetTranslation().z)
+            //Flip the sign bit of positive values and all bits of negative values so the integer order matches the float order.
+            u32 ascending = (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+            return ~ascending;
+        }
+        
+        /// Appends the given value to the least significant end of the given key.
+        ///
+        /// @param key
+        ///     The key so far.
+        /// @param value
+        ///     The value to append. Must fit within the given number of bits.
+        /// @param numBits
+        ///     The number of bits the value occupies. Must be no more than 32.
+        ///
+        /// @return The new key.
+        ///
+        u64 AppendToKey(u64 key, u32 value, u32 numBits) noexcept
+        {
+            return (numBits > 0) ? ((key << numBits) | u64(value)) : key;
+        }
+        
+        /// Sorts the given render pass objects in ascending order of the key calculated for each.
+        ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks.
+        /// @param renderPassObjects
+        ///     The render pass objects to sort.
+        /// @param calcKey
+        ///     Function which calculates the sort key for a render pass object.
+        ///
+        template <typename TKeyFunction> void SortByKey(const TaskContext& taskContext, std::vector<RenderPassObject>& renderPassObjects, const TKeyFunction& calcKey) noexcept
+        {
+            u32 numItems = u32(renderPassObjects.size());
+            if (numItems < 2)
             {
-                return (a.GetRenderMesh() < b.GetRenderMesh());
+                return;
             }
-            else
+            
+            std::vector<SortItem> sortItems(numItems);
+            ForEachChunk(taskContext, numItems, [&](u32 chunkIndex, u32 begin, u32 end)
             {
-                return (wvpA.GetTranslation().z > wvpB.GetTranslation().z);
+                for (u32 i = begin; i < end; ++i)
+                {
+                    sortItems[i].m_key = calcKey(renderPassObjects[i]);
+                    sortItems[i].m_index = i;
+                }
+            });
+            
+            RadixSort(taskContext, sortItems);
+            
+            std::vector<RenderPassObject> sortedRenderPassObjects;
+            sortedRenderPassObjects.reserve(numItems);
+            for (const auto& sortItem : sortItems)
+            {
+                sortedRenderPassObjects.push_back(renderPassObjects[sortItem.m_index]);
             }
-        });
+            
+            renderPassObjects.swap(sortedRenderPassObjects);
+        }
     }
     
     //------------------------------------------------------------------------------
-    void RenderPassObjectSorter::PrioritySort(std::vector<RenderPassObject>& renderPassObjects) noexcept
+    void RenderPassObjectSorter::OpaqueSort(const TaskContext& taskContext, const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept
     {
-        std::sort(renderPassObjects.begin(), renderPassObjects.end(), [](const RenderPassObject& a, const RenderPassObject& b)
+        auto materialRanks = CalcRankLookup(renderPassObjects, GetMaterial);
+        auto meshRanks = CalcRankLookup(renderPassObjects, GetMesh);
+        u32 numDepthBits = std::min(32u, 64 - materialRanks.m_numBits - meshRanks.m_numBits);
+        const auto& viewProjection = camera.GetViewProjectionMatrix();
+        
+        SortByKey(taskContext, renderPassObjects, [&](const RenderPassObject& renderPassObject)
         {
-            if (a.GetPriority() == b.GetPriority())
-            {
-                return (a.GetRenderMaterial() < b.GetRenderMaterial());
-            }
-            else
+            u32 depth = ToDescendingBits(CalcDepth(renderPassObject, viewProjection));
+            if (numDepthBits < 32)
             {
-                return (a.GetPriority() < b.GetPriority());
+                depth = (numDepthBits > 0) ? (depth >> (32 - numDepthBits)) : 0;
             }
+            
+            u64 key = 0;
+            key = AppendToKey(key, materialRanks.m_ranks.find(GetMaterial(renderPassObject))->second, materialRanks.m_numBits);
+            key = AppendToKey(key, depth, numDepthBits);
+            key = AppendToKey(key, meshRanks.m_ranks.find(GetMesh(renderPassObject))->second, meshRanks.m_numBits);
+            return key;
+        });
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderPassObjectSorter::TransparentSort(const TaskContext& taskContext, const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept
+    {
+        auto meshRanks = CalcRankLookup(renderPassObjects, GetMesh);
+        const auto& viewProjection = camera.GetViewProjectionMatrix();
+        
+        SortByKey(taskContext, renderPassObjects, [&](const RenderPassObject& renderPassObject)
+        {
+            u64 key = 0;
+            key = AppendToKey(key, ToDescendingBits(CalcDepth(renderPassObject, viewProjection)), 32);
+            key = AppendToKey(key, meshRanks.m_ranks.find(GetMesh(renderPassObject))->second, meshRanks.m_numBits);
+            return key;
+        });
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderPassObjectSorter::PrioritySort(const TaskContext& taskContext, std::vector<RenderPassObject>& renderPassObjects) noexcept
+    {
+        auto materialRanks = CalcRankLookup(renderPassObjects, GetMaterial);
+        
+        SortByKey(taskContext, renderPassObjects, [&](const RenderPassObject& renderPassObject)
+        {
+            u64 key = 0;
+            key = AppendToKey(key, renderPassObject.GetPriority(), 32);
+            key = AppendToKey(key, materialRanks.m_ranks.find(GetMaterial(renderPassObject))->second, materialRanks.m_numBits);
+            return key;
         });
     }
 }
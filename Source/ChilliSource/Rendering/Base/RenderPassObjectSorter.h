@@ -30,7 +30,6 @@
 #include <ChilliSource/Rendering/Base/RenderPassObject.h>
 #include <ChilliSource/Rendering/ForwardDeclarations.h>
 
-#include <functional>
 #include <vector>
 
 namespace ChilliSource
@@ -40,31 +39,40 @@ namespace ChilliSource
     namespace RenderPassObjectSorter
     {
         /// Sorts a collection of opaque RenderPassObjects based on if they share a material
-        /// and then by z position (Front to back)
+        /// and then by z position (Front to back). Large collections are sorted across
+        /// multiple child tasks.
         ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks.
         /// @param camera
         ///     The camera to use to determine z-distance.
         /// @param renderPassObjects
         ///     The list of render pass objects to sort.
         ///
-        void OpaqueSort(const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept;
+        void OpaqueSort(const TaskContext& taskContext, const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept;
         
-        /// Sorts a collection of transparent RenderPassObjects based on their z position (Back to front)
+        /// Sorts a collection of transparent RenderPassObjects based on their z position (Back to front).
+        /// Large collections are sorted across multiple child tasks.
         ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks.
         /// @param camera
         ///     The camera to use to determine z-distance
         /// @param renderPassObjects
         ///     The list of render pass objects to sort.
         ///
-        void TransparentSort(const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept;
+        void TransparentSort(const TaskContext& taskContext, const RenderCamera& camera, std::vector<RenderPassObject>& renderPassObjects) noexcept;
         
         /// Sorts a collection of RenderPassObjects based on their priority value. Lower priority values
         /// will be rendered first. If objects have the same priority then they will be ordered by material.
+        /// Large collections are sorted across multiple child tasks.
         ///
+        /// @param taskContext
+        ///     Context to manage any spawned tasks.
         /// @param renderPassObjects
         ///     The list of render pass objects to sort.
         ///
-        void PrioritySort(std::vector<RenderPassObject>& renderPassObjects) noexcept;
+        void PrioritySort(const TaskContext& taskContext, std::vector<RenderPassObject>& renderPassObjects) noexcept;
     };
 }
 
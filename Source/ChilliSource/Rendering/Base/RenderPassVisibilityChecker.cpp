@@ -24,6 +24,7 @@
 
 #include <ChilliSource/Rendering/Base/RenderPassVisibilityChecker.h>
 
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Rendering/Base/RenderPasses.h>
 #include <ChilliSource/Rendering/Base/RenderFrame.h>
@@ -31,49 +32,260 @@
 #include <ChilliSource/Rendering/Base/RenderObject.h>
 #include <ChilliSource/Rendering/Base/RenderPassObject.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#   define CS_VISIBILITYCHECKER_USE_SSE
+#   include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define CS_VISIBILITYCHECKER_USE_NEON
+#   include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <array>
+
 namespace ChilliSource
 {
     namespace
     {
-        constexpr u32 k_objectsPerVisibilityBatch = 50;
+        constexpr u32 k_objectsPerVisibilityBatch = 256;
+        constexpr u32 k_spheresPerTest = 4;
+        constexpr u32 k_numFrustumPlanes = 6;
+        constexpr u32 k_maskWordsPerBatch = k_objectsPerVisibilityBatch / 32;
+        
+        static_assert(k_objectsPerVisibilityBatch % 32 == 0, "Visibility batches must fill whole mask words.");
+        
+        /// The result of culling a single batch of objects. Bit n of the mask is set if
+        /// object n in the batch is visible.
+        ///
+        struct VisibilityBatch
+        {
+            std::array<u32, k_maskWordsPerBatch> m_visibilityMask;
+            u32 m_numVisible = 0;
+        };
+        
+        /// Bounding spheres packed into separate component arrays so that multiple spheres
+        /// can be tested against a plane at once. The arrays are padded to a multiple of
+        /// the number of spheres per test.
+        ///
+        struct PackedSpheres
+        {
+            alignas(16) f32 m_x[k_objectsPerVisibilityBatch];
+            alignas(16) f32 m_y[k_objectsPerVisibilityBatch];
+            alignas(16) f32 m_z[k_objectsPerVisibilityBatch];
+            alignas(16) f32 m_radius[k_objectsPerVisibilityBatch];
+        };
+        
+        /// @param value
+        ///     The value to count the bits of.
+        ///
+        /// @return The number of set bits in the given value.
+        ///
+        u32 CountBits(u32 value) noexcept
+        {
+            value = value - ((value >> 1) & 0x55555555);
+            value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+            return (((value + (value >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+        }
+        
+        /// Tests 4 packed spheres against the frustum planes. A sphere is visible if it
+        /// isn't entirely behind any plane, matching Frustum::SphereCullTest().
+        ///
+        /// @param planes
+        ///     The frustum planes.
+        /// @param spheres
+        ///     The packed spheres.
+        /// @param first
+        ///     The index of the first of the 4 spheres to test. Must be a multiple of 4.
+        ///
+        /// @return A 4 bit mask with bit n set if sphere (first + n) is visible.
+        ///
+        u32 TestSpheres(const std::array<const Plane*, k_numFrustumPlanes>& planes, const PackedSpheres& spheres, u32 first) noexcept
+        {
+#if defined(CS_VISIBILITYCHECKER_USE_SSE)
+            const __m128 x = _mm_load_ps(&spheres.m_x[first]);
+            const __m128 y = _mm_load_ps(&spheres.m_y[first]);
+            const __m128 z = _mm_load_ps(&spheres.m_z[first]);
+            const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_load_ps(&spheres.m_radius[first]));
+            
+            __m128 visible = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+            for (const auto plane : planes)
+            {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane->mvNormal.x)), _mm_set1_ps(plane->mfD));
+                distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane->mvNormal.y)));
+                distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane->mvNormal.z)));
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negRadius));
+            }
+            
+            return u32(_mm_movemask_ps(visible));
+#elif defined(CS_VISIBILITYCHECKER_USE_NEON)
+            const float32x4_t x = vld1q_f32(&spheres.m_x[first]);
+            const float32x4_t y = vld1q_f32(&spheres.m_y[first]);
+            const float32x4_t z = vld1q_f32(&spheres.m_z[first]);
+            const float32x4_t negRadius = vnegq_f32(vld1q_f32(&spheres.m_radius[first]));
+            
+            uint32x4_t visible = vdupq_n_u32(0xffffffff);
+            for (const auto plane : planes)
+            {
+                float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(plane->mfD), x, plane->mvNormal.x);
+                distance = vmlaq_n_f32(distance, y, plane->mvNormal.y);
+                distance = vmlaq_n_f32(distance, z, plane->mvNormal.z);
+                visible = vandq_u32(visible, vcgeq_f32(distance, negRadius));
+            }
+            
+            const uint32x4_t laneBits = { 1, 2, 4, 8 };
+            const uint32x2_t pairs = vpadd_u32(vget_low_u32(vandq_u32(visible, laneBits)), vget_high_u32(vandq_u32(visible, laneBits)));
+            return vget_lane_u32(vpadd_u32(pairs, pairs), 0);
+#else
+            u32 mask = 0;
+            for (u32 lane = 0; lane < k_spheresPerTest; ++lane)
+            {
+                u32 index = first + lane;
+                
+                bool visible = true;
+                for (const auto plane : planes)
+                {
+                    f32 distance = spheres.m_x[index] * plane->mvNormal.x + spheres.m_y[index] * plane->mvNormal.y + spheres.m_z[index] * plane->mvNormal.z + plane->mfD;
+                    visible = visible && (distance >= -spheres.m_radius[index]);
+                }
+                
+                mask |= (visible ? 1u : 0u) << lane;
+            }
+            
+            return mask;
+#endif
+        }
+        
+        /// Culls a single batch of render objects against the frustum, writing the
+        /// visibility of each to the batch mask.
+        ///
+        /// @param planes
+        ///     The frustum planes.
+        /// @param renderObjects
+        ///     The full list of render objects.
+        /// @param firstObject
+        ///     The index of the first object in the batch.
+        /// @param outBatch
+        ///     [Out] The batch to write the result to.
+        ///
+        void CullBatch(const std::array<const Plane*, k_numFrustumPlanes>& planes, const std::vector<RenderObject>& renderObjects, u32 firstObject, VisibilityBatch& outBatch) noexcept
+        {
+            u32 numObjects = std::min(k_objectsPerVisibilityBatch, u32(renderObjects.size()) - firstObject);
+            u32 numPacked = ((numObjects + k_spheresPerTest - 1) / k_spheresPerTest) * k_spheresPerTest;
+            
+            PackedSpheres spheres;
+            for (u32 i = 0; i < numPacked; ++i)
+            {
+                if (i < numObjects)
+                {
+                    const auto& boundingSphere = renderObjects[firstObject + i].GetBoundingSphere();
+                    spheres.m_x[i] = boundingSphere.vOrigin.x;
+                    spheres.m_y[i] = boundingSphere.vOrigin.y;
+                    spheres.m_z[i] = boundingSphere.vOrigin.z;
+                    spheres.m_radius[i] = boundingSphere.fRadius;
+                }
+                else
+                {
+                    spheres.m_x[i] = 0.0f;
+                    spheres.m_y[i] = 0.0f;
+                    spheres.m_z[i] = 0.0f;
+                    spheres.m_radius[i] = 0.0f;
+                }
+            }
+            
+            outBatch.m_visibilityMask.fill(0);
+            for (u32 first = 0; first < numPacked; first += k_spheresPerTest)
+            {
+                outBatch.m_visibilityMask[first / 32] |= TestSpheres(planes, spheres, first) << (first % 32);
+            }
+            
+            //Clear the padding so it isn't counted as visible.
+            if (numObjects % 32 != 0)
+            {
+                outBatch.m_visibilityMask[numObjects / 32] &= (1u << (numObjects % 32)) - 1;
+            }
+            
+            outBatch.m_numVisible = 0;
+            for (auto word : outBatch.m_visibilityMask)
+            {
+                outBatch.m_numVisible += CountBits(word);
+            }
+        }
     }
     
     //------------------------------------------------------------------------------
     std::vector<RenderObject> RenderPassVisibilityChecker::CalculateVisibleObjects(const TaskContext& taskContext, const RenderCamera& camera, const std::vector<RenderObject>& renderObjects) noexcept
     {
-        std::mutex visibleObjectsMutex;
-        std::vector<RenderObject> visibleRenderObjects;
+        if (renderObjects.empty())
+        {
+            return std::vector<RenderObject>();
+        }
+        
+        const auto& frustum = camera.GetFrustrum();
+        const std::array<const Plane*, k_numFrustumPlanes> planes {{ &frustum.mLeftClipPlane, &frustum.mRightClipPlane, &frustum.mTopClipPlane, &frustum.mBottomClipPlane,
+            &frustum.mNearClipPlane, &frustum.mFarClipPlane }};
+        
+        u32 numBatches = (u32(renderObjects.size()) + k_objectsPerVisibilityBatch - 1) / k_objectsPerVisibilityBatch;
+        std::vector<VisibilityBatch> batches(numBatches);
         
-        u32 numTasks = 1 + (u32(renderObjects.size()) / k_objectsPerVisibilityBatch);
         std::vector<Task> tasks;
-        for (u32 taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        tasks.reserve(numBatches);
+        for (u32 batchIndex = 0; batchIndex < numBatches; ++batchIndex)
         {
-            tasks.push_back([=, &camera, &renderObjects, &visibleObjectsMutex, &visibleRenderObjects](const TaskContext& innerTaskContext)
+            tasks.push_back([=, &planes, &renderObjects, &batches](const TaskContext& innerTaskContext)
             {
-                std::vector<RenderObject> taskVisibleObjects;
-                for(u32 objectIndex = 0; objectIndex < k_objectsPerVisibilityBatch; ++objectIndex)
+                CullBatch(planes, renderObjects, batchIndex * k_objectsPerVisibilityBatch, batches[batchIndex]);
+            });
+        }
+        taskContext.ProcessChildTasks(tasks);
+        
+        //A prefix sum over the visible count of each batch gives the output offset for the batch, allowing the visible
+        //objects to be written in parallel while keeping them in the same order as the input.
+        std::vector<u32> batchOffsets(numBatches);
+        u32 numVisible = 0;
+        for (u32 batchIndex = 0; batchIndex < numBatches; ++batchIndex)
+        {
+            batchOffsets[batchIndex] = numVisible;
+            numVisible += batches[batchIndex].m_numVisible;
+        }
+        
+        if (numVisible == 0)
+        {
+            return std::vector<RenderObject>();
+        }
+        
+        //Render objects cannot be default constructed so the output is filled with copies of the first object before
+        //being overwritten.
+        std::vector<RenderObject> visibleRenderObjects(numVisible, renderObjects.front());
+        
+        tasks.clear();
+        for (u32 batchIndex = 0; batchIndex < numBatches; ++batchIndex)
+        {
+            if (batches[batchIndex].m_numVisible == 0)
+            {
+                continue;
+            }
+            
+            tasks.push_back([=, &renderObjects, &batches, &batchOffsets, &visibleRenderObjects](const TaskContext& innerTaskContext)
+            {
+                const auto& batch = batches[batchIndex];
+                u32 outputIndex = batchOffsets[batchIndex];
+                u32 firstObject = batchIndex * k_objectsPerVisibilityBatch;
+                
+                for (u32 wordIndex = 0; wordIndex < k_maskWordsPerBatch; ++wordIndex)
                 {
-                    u32 index = taskIndex * k_objectsPerVisibilityBatch + objectIndex;
-                    if (index >= renderObjects.size())
-                    {
-                        break;
-                    }
-                    
-                    const auto& renderPassObject = renderObjects[index];
-                    
-                    if (camera.GetFrustrum().SphereCullTest(renderPassObject.GetBoundingSphere()))
+                    u32 word = batch.m_visibilityMask[wordIndex];
+                    for (u32 bit = 0; word != 0; ++bit, word >>= 1)
                     {
-                        taskVisibleObjects.push_back(renderPassObject);
+                        if ((word & 1) != 0)
+                        {
+                            visibleRenderObjects[outputIndex++] = renderObjects[firstObject + wordIndex * 32 + bit];
+                        }
                     }
                 }
-                
-                std::unique_lock<std::mutex> lock(visibleObjectsMutex);
-                visibleRenderObjects.insert(visibleRenderObjects.end(), taskVisibleObjects.begin(), taskVisibleObjects.end());
             });
         }
-        
         taskContext.ProcessChildTasks(tasks);
         
         return visibleRenderObjects;
     }
-} 
+}
@@ -0,0 +1,50 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_RENDERUPLOADPRIORITY_H_
+#define _CHILLISOURCE_RENDERING_BASE_RENDERUPLOADPRIORITY_H_
+
+#include <ChilliSource/ChilliSource.h>
+
+namespace ChilliSource
+{
+    /// An enum describing the priority of a pending GPU resource upload. Higher priority
+    /// uploads are always processed before lower priority ones, while uploads of the same
+    /// priority are processed in the order they were requested.
+    ///
+    /// "UI": Resources required by the UI, which will be very noticable if missing.
+    ///
+    /// "Visible": Resources which are expected to be visible in the scene.
+    ///
+    /// "Prefetch": Resources which are not yet needed but will be soon.
+    ///
+    enum class RenderUploadPriority
+    {
+        k_ui,
+        k_visible,
+        k_prefetch
+    };
+}
+
+#endif
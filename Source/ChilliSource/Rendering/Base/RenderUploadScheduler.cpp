@@ -0,0 +1,256 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Base/RenderUploadScheduler.h>
+
+#include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/TargetType.h>
+#include <ChilliSource/Rendering/Model/RenderMesh.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
+#include <ChilliSource/Rendering/Texture/RenderTexture.h>
+
+namespace ChilliSource
+{
+    CS_DEFINE_NAMEDTYPE(RenderUploadScheduler);
+    
+    constexpr u32 RenderUploadScheduler::k_defaultMaxBytesPerFrame;
+    constexpr u32 RenderUploadScheduler::k_defaultMaxUploadsPerFrame;
+    
+    //------------------------------------------------------------------------------
+    RenderUploadSchedulerUPtr RenderUploadScheduler::Create() noexcept
+    {
+        return RenderUploadSchedulerUPtr(new RenderUploadScheduler());
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderUploadScheduler::IsA(InterfaceIDType interfaceId) const noexcept
+    {
+        return (RenderUploadScheduler::InterfaceID == interfaceId);
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderUploadScheduler::GetMaxBytesPerFrame() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_maxBytesPerFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::SetMaxBytesPerFrame(u32 maxBytesPerFrame) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_maxBytesPerFrame = maxBytesPerFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderUploadScheduler::GetMaxUploadsPerFrame() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_maxUploadsPerFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::SetMaxUploadsPerFrame(u32 maxUploadsPerFrame) noexcept
+    {
+        CS_ASSERT(maxUploadsPerFrame > 0, "At least one upload must be allowed per frame.");
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_maxUploadsPerFrame = maxUploadsPerFrame;
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 RenderUploadScheduler::GetNumPendingUploads() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return u32(m_pendingResources.size());
+    }
+    
+    //------------------------------------------------------------------------------
+    u64 RenderUploadScheduler::GetNumPendingBytes() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_numPendingBytes;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::AddTextureUpload(RenderTexture* renderTexture, std::unique_ptr<const u8[]> textureData, u32 textureDataSize, RenderUploadPriority priority) noexcept
+    {
+        PendingUpload pendingUpload;
+        pendingUpload.m_type = UploadType::k_texture;
+        pendingUpload.m_resource = renderTexture;
+        pendingUpload.m_renderTexture = renderTexture;
+        pendingUpload.m_data = std::move(textureData);
+        pendingUpload.m_dataSize = textureDataSize;
+        pendingUpload.m_totalSize = textureDataSize;
+        
+        AddUpload(std::move(pendingUpload), priority);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::AddCubemapUpload(RenderTexture* renderTexture, std::array<std::unique_ptr<const u8[]>, 6> textureData, u32 textureDataSize, RenderUploadPriority priority) noexcept
+    {
+        PendingUpload pendingUpload;
+        pendingUpload.m_type = UploadType::k_cubemap;
+        pendingUpload.m_resource = renderTexture;
+        pendingUpload.m_renderTexture = renderTexture;
+        pendingUpload.m_cubemapData = std::move(textureData);
+        pendingUpload.m_dataSize = textureDataSize;
+        pendingUpload.m_totalSize = u64(textureDataSize) * pendingUpload.m_cubemapData.size();
+        
+        AddUpload(std::move(pendingUpload), priority);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::AddMeshUpload(RenderMesh* renderMesh, std::unique_ptr<const u8[]> vertexData, u32 vertexDataSize, std::unique_ptr<const u8[]> indexData, u32 indexDataSize, RenderUploadPriority priority) noexcept
+    {
+        PendingUpload pendingUpload;
+        pendingUpload.m_type = UploadType::k_mesh;
+        pendingUpload.m_resource = renderMesh;
+        pendingUpload.m_renderMesh = renderMesh;
+        pendingUpload.m_data = std::move(vertexData);
+        pendingUpload.m_dataSize = vertexDataSize;
+        pendingUpload.m_indexData = std::move(indexData);
+        pendingUpload.m_indexDataSize = indexDataSize;
+        pendingUpload.m_totalSize = u64(vertexDataSize) + u64(indexDataSize);
+        
+        AddUpload(std::move(pendingUpload), priority);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderUploadScheduler::CancelTextureUpload(const RenderTexture* renderTexture) noexcept
+    {
+        return CancelUpload(renderTexture);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderUploadScheduler::CancelMeshUpload(const RenderMesh* renderMesh) noexcept
+    {
+        return CancelUpload(renderMesh);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderUploadScheduler::IsTextureUploadPending(const RenderTexture* renderTexture) const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_pendingResources.count(renderTexture) > 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderUploadScheduler::IsMeshUploadPending(const RenderMesh* renderMesh) const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_pendingResources.count(renderMesh) > 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::AddUpload(PendingUpload pendingUpload, RenderUploadPriority priority) noexcept
+    {
+        CS_ASSERT(pendingUpload.m_resource, "Cannot upload a null resource.");
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        CS_ASSERT(m_pendingResources.count(pendingUpload.m_resource) == 0, "Resource is already waiting to be uploaded.");
+        
+        m_pendingResources.insert(pendingUpload.m_resource);
+        m_numPendingBytes += pendingUpload.m_totalSize;
+        m_pendingUploads[u32(priority)].push_back(std::move(pendingUpload));
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderUploadScheduler::CancelUpload(const void* resource) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        if (m_pendingResources.erase(resource) == 0)
+        {
+            return false;
+        }
+        
+        for (auto& queue : m_pendingUploads)
+        {
+            for (auto it = queue.begin(); it != queue.end(); ++it)
+            {
+                if (it->m_resource == resource)
+                {
+                    m_numPendingBytes -= it->m_totalSize;
+                    queue.erase(it);
+                    return true;
+                }
+            }
+        }
+        
+        CS_LOG_FATAL("Pending upload could not be found.");
+        return false;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderUploadScheduler::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    {
+        if (targetType != TargetType::k_main)
+        {
+            return;
+        }
+        
+        auto preRenderCommandList = renderSnapshot.GetPreRenderCommandList();
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        u64 numBytes = 0;
+        u32 numUploads = 0;
+        for (auto& queue : m_pendingUploads)
+        {
+            while (!queue.empty() && numUploads < m_maxUploadsPerFrame)
+            {
+                auto& pendingUpload = queue.front();
+                
+                // Lower priority uploads are not allowed to skip ahead once the budget is used up, so
+                // the first upload which doesn't fit ends the frame's uploads.
+                if (numUploads > 0 && numBytes + pendingUpload.m_totalSize > m_maxBytesPerFrame)
+                {
+                    return;
+                }
+                
+                switch (pendingUpload.m_type)
+                {
+                    case UploadType::k_texture:
+                        preRenderCommandList->AddLoadTextureCommand(pendingUpload.m_renderTexture, std::move(pendingUpload.m_data), pendingUpload.m_dataSize);
+                        break;
+                    case UploadType::k_cubemap:
+                        preRenderCommandList->AddLoadCubemapCommand(pendingUpload.m_renderTexture, std::move(pendingUpload.m_cubemapData), pendingUpload.m_dataSize);
+                        break;
+                    case UploadType::k_mesh:
+                        preRenderCommandList->AddLoadMeshCommand(pendingUpload.m_renderMesh, std::move(pendingUpload.m_data), pendingUpload.m_dataSize, std::move(pendingUpload.m_indexData), pendingUpload.m_indexDataSize);
+                        break;
+                }
+                
+                numBytes += pendingUpload.m_totalSize;
+                ++numUploads;
+                
+                m_numPendingBytes -= pendingUpload.m_totalSize;
+                m_pendingResources.erase(pendingUpload.m_resource);
+                queue.pop_front();
+            }
+        }
+    }
+}
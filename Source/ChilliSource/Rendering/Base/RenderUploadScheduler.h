@@ -0,0 +1,261 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_RENDERUPLOADSCHEDULER_H_
+#define _CHILLISOURCE_RENDERING_BASE_RENDERUPLOADSCHEDULER_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/System/AppSystem.h>
+#include <ChilliSource/Rendering/Base/RenderUploadPriority.h>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace ChilliSource
+{
+    /// Time-slices the upload of texture, cubemap and mesh data to the GPU. Rather than adding
+    /// every pending load command to the next frame, uploads are queued by priority and only
+    /// as many as fit in the per-frame byte and upload count budgets are added to each render
+    /// snapshot. This prevents large numbers of resources which are created at the same time,
+    /// for example when entering a new level, from stalling the render thread.
+    ///
+    /// At least one upload is always performed each frame if any are pending, so resources
+    /// which are larger than the byte budget will still be uploaded.
+    ///
+    /// Uploads can be cancelled if the resource is destroyed before it has been uploaded. The
+    /// resource must still be unloaded as normal, as render snapshots which are in flight can
+    /// reference it.
+    ///
+    /// Objects are not rendered until the textures and mesh they use have been uploaded, so
+    /// they may be missing from rendering for a number of frames after being created.
+    ///
+    /// This is thread-safe.
+    ///
+    class RenderUploadScheduler final : public AppSystem
+    {
+    public:
+        CS_DECLARE_NAMEDTYPE(RenderUploadScheduler);
+        
+        static constexpr u32 k_defaultMaxBytesPerFrame = 8 * 1024 * 1024;
+        static constexpr u32 k_defaultMaxUploadsPerFrame = 32;
+        
+        /// Allows querying of whether or not this system implements the interface described by the
+        /// given interface Id. Typically this is not called directly as the templated equivalent
+        /// IsA<Interface>() is preferred.
+        ///
+        /// @param interfaceId
+        ///     The Id of the interface.
+        ///
+        /// @return Whether or not the interface is implemented.
+        ///
+        bool IsA(InterfaceIDType interfaceId) const noexcept override;
+        
+        /// @return The maximum number of bytes which will be uploaded each frame.
+        ///
+        u32 GetMaxBytesPerFrame() const noexcept;
+        
+        /// Sets the maximum number of bytes which will be uploaded each frame. This is a soft
+        /// limit: the first upload each frame is always performed regardless of its size.
+        ///
+        /// @param maxBytesPerFrame
+        ///     The maximum number of bytes.
+        ///
+        void SetMaxBytesPerFrame(u32 maxBytesPerFrame) noexcept;
+        
+        /// @return The maximum number of uploads which will be performed each frame.
+        ///
+        u32 GetMaxUploadsPerFrame() const noexcept;
+        
+        /// Sets the maximum number of uploads which will be performed each frame.
+        ///
+        /// @param maxUploadsPerFrame
+        ///     The maximum number of uploads. Must be greater than zero.
+        ///
+        void SetMaxUploadsPerFrame(u32 maxUploadsPerFrame) noexcept;
+        
+        /// @return The number of uploads which are waiting to be performed.
+        ///
+        u32 GetNumPendingUploads() const noexcept;
+        
+        /// @return The total size of all uploads which are waiting to be performed, in bytes.
+        ///
+        u64 GetNumPendingBytes() const noexcept;
+        
+        /// Queues the upload of the given texture.
+        ///
+        /// @param renderTexture
+        ///     The render texture which should be uploaded.
+        /// @param textureData
+        ///     The data describing the texture. Must be moved.
+        /// @param textureDataSize
+        ///     The size of the texture data in bytes.
+        /// @param priority
+        ///     The priority of the upload.
+        ///
+        void AddTextureUpload(RenderTexture* renderTexture, std::unique_ptr<const u8[]> textureData, u32 textureDataSize, RenderUploadPriority priority) noexcept;
+        
+        /// Queues the upload of the given cubemap.
+        ///
+        /// @param renderTexture
+        ///     The render texture which should be uploaded.
+        /// @param textureData
+        ///     The data describing the texture for each face. Must be moved.
+        /// @param textureDataSize
+        ///     The size of the texture data for each face in bytes.
+        /// @param priority
+        ///     The priority of the upload.
+        ///
+        void AddCubemapUpload(RenderTexture* renderTexture, std::array<std::unique_ptr<const u8[]>, 6> textureData, u32 textureDataSize, RenderUploadPriority priority) noexcept;
+        
+        /// Queues the upload of the given mesh.
+        ///
+        /// @param renderMesh
+        ///     The render mesh which should be uploaded.
+        /// @param vertexData
+        ///     The vertex data buffer. Must be moved.
+        /// @param vertexDataSize
+        ///     The size of the vertex data buffer.
+        /// @param indexData
+        ///     The index data buffer. Must be moved.
+        /// @param indexDataSize
+        ///     The size of the index data buffer.
+        /// @param priority
+        ///     The priority of the upload.
+        ///
+        void AddMeshUpload(RenderMesh* renderMesh, std::unique_ptr<const u8[]> vertexData, u32 vertexDataSize, std::unique_ptr<const u8[]> indexData, u32 indexDataSize, RenderUploadPriority priority) noexcept;
+        
+        /// Cancels the pending upload of the given texture or cubemap, discarding its data.
+        ///
+        /// @param renderTexture
+        ///     The render texture.
+        ///
+        /// @return Whether or not an upload was cancelled. Either way the texture should still be
+        ///     unloaded as normal.
+        ///
+        bool CancelTextureUpload(const RenderTexture* renderTexture) noexcept;
+        
+        /// Cancels the pending upload of the given mesh, discarding its data.
+        ///
+        /// @param renderMesh
+        ///     The render mesh.
+        ///
+        /// @return Whether or not an upload was cancelled. Either way the mesh should still be
+        ///     unloaded as normal.
+        ///
+        bool CancelMeshUpload(const RenderMesh* renderMesh) noexcept;
+        
+        /// @param renderTexture
+        ///     The render texture or cubemap.
+        ///
+        /// @return Whether or not the upload of the given texture is still waiting to be performed.
+        ///
+        bool IsTextureUploadPending(const RenderTexture* renderTexture) const noexcept;
+        
+        /// @param renderMesh
+        ///     The render mesh.
+        ///
+        /// @return Whether or not the upload of the given mesh is still waiting to be performed.
+        ///
+        bool IsMeshUploadPending(const RenderMesh* renderMesh) const noexcept;
+        
+    private:
+        friend class Application;
+        
+        /// The type of resource a pending upload is for.
+        ///
+        enum class UploadType
+        {
+            k_texture,
+            k_cubemap,
+            k_mesh
+        };
+        
+        /// A container for the data relating to a single pending upload.
+        ///
+        struct PendingUpload final
+        {
+            UploadType m_type = UploadType::k_texture;
+            const void* m_resource = nullptr;
+            RenderTexture* m_renderTexture = nullptr;
+            RenderMesh* m_renderMesh = nullptr;
+            std::unique_ptr<const u8[]> m_data;
+            std::array<std::unique_ptr<const u8[]>, 6> m_cubemapData;
+            u32 m_dataSize = 0;
+            std::unique_ptr<const u8[]> m_indexData;
+            u32 m_indexDataSize = 0;
+            u64 m_totalSize = 0;
+        };
+        
+        /// A factory method for creating new instances of the system. This must be called by
+        /// Application.
+        ///
+        /// @return The new instance of the system.
+        ///
+        static RenderUploadSchedulerUPtr Create() noexcept;
+        
+        RenderUploadScheduler() = default;
+        
+        /// Adds the given upload to the queue for its priority.
+        ///
+        /// @param pendingUpload
+        ///     The upload. Must be moved.
+        /// @param priority
+        ///     The priority of the upload.
+        ///
+        void AddUpload(PendingUpload pendingUpload, RenderUploadPriority priority) noexcept;
+        
+        /// Cancels the pending upload for the given resource, if there is one.
+        ///
+        /// @param resource
+        ///     The render texture or render mesh.
+        ///
+        /// @return Whether or not an upload was cancelled.
+        ///
+        bool CancelUpload(const void* resource) noexcept;
+        
+        /// Called during the Render Snapshot stage of the render pipeline. As many pending uploads
+        /// as fit in the budget are added to the render snapshot as load commands, in priority order.
+        ///
+        /// @param targetType
+        ///     Whether the snapshot is for the main screen or an offscreen render target
+        /// @param renderSnapshot
+        ///     The render shapshot for storing snapshotted data.
+        /// @param frameAllocator
+        ///     Allocate memory for this render frame from here
+        ///
+        void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept override;
+        
+        mutable std::mutex m_mutex;
+        u32 m_maxBytesPerFrame = k_defaultMaxBytesPerFrame;
+        u32 m_maxUploadsPerFrame = k_defaultMaxUploadsPerFrame;
+        std::array<std::deque<PendingUpload>, 3> m_pendingUploads;
+        std::unordered_set<const void*> m_pendingResources;
+        u64 m_numPendingBytes = 0;
+    };
+}
+
+#endif
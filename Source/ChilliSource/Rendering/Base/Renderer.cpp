@@ -26,10 +26,20 @@
 
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Time/Profiler.h>
 #include <ChilliSource/Rendering/Base/ForwardRenderPassCompiler.h>
 #include <ChilliSource/Rendering/Base/RenderCommandCompiler.h>
 #include <ChilliSource/Rendering/Base/RenderCommandBufferManager.h>
 #include <ChilliSource/Rendering/Base/RenderFrameCompiler.h>
+#include <ChilliSource/Rendering/Model/RenderMesh.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/LoadCubemapRenderCommand.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/LoadMeshRenderCommand.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/LoadTextureRenderCommand.h>
+#include <ChilliSource/Rendering/Texture/RenderTexture.h>
+
+#include <algorithm>
+#include <iterator>
 
 namespace ChilliSource
 {
@@ -56,6 +66,35 @@ namespace ChilliSource
             
             return RenderFrameCompiler::CompileRenderFrame(offscreenTarget, resolution, clearColour, renderCamera, renderAmbientLights, renderDirectionalLights, renderPointLights, renderObjects);
         }
+        
+        /// Flags every texture, cubemap and mesh which is loaded by the given pre-render commands
+        /// as uploaded. Uploads are time-sliced, so this is what allows objects using them to be
+        /// rendered from this frame onwards. Render prep is never run concurrently, so this is
+        /// safe to call before the frame is compiled.
+        ///
+        /// @param preRenderCommandList
+        ///     The pre-render command list for the frame.
+        ///
+        void FlagUploadedResources(const RenderCommandList* preRenderCommandList) noexcept
+        {
+            for (const auto renderCommand : *preRenderCommandList)
+            {
+                switch (renderCommand->GetType())
+                {
+                    case RenderCommand::Type::k_loadTexture:
+                        static_cast<const LoadTextureRenderCommand*>(renderCommand)->GetRenderTexture()->SetUploaded();
+                        break;
+                    case RenderCommand::Type::k_loadCubemap:
+                        static_cast<const LoadCubemapRenderCommand*>(renderCommand)->GetRenderTexture()->SetUploaded();
+                        break;
+                    case RenderCommand::Type::k_loadMesh:
+                        static_cast<const LoadMeshRenderCommand*>(renderCommand)->GetRenderMesh()->SetUploaded();
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
     }
     
     //------------------------------------------------------------------------------
@@ -96,30 +135,57 @@ namespace ChilliSource
         
         taskScheduler->ScheduleTask(TaskType::k_small, [=](const TaskContext& taskContext)
         {
-            std::vector<RenderFrame> renderFrames(m_currentOffscreenSnapshots.size());
-            std::vector<RenderFrameData> renderFramesData(m_currentOffscreenSnapshots.size());
+            CS_PROFILE_ZONE("Renderer::RenderPrep");
+            
+            //The main snapshot is placed after the offscreen snapshots so it is rendered last.
+            u32 numSnapshots = u32(m_currentOffscreenSnapshots.size()) + 1;
             
-            for(auto i=0; i<m_currentOffscreenSnapshots.size(); ++i)
+            std::vector<RenderSnapshot*> snapshots;
+            snapshots.reserve(numSnapshots);
+            for (auto& offscreenSnapshot : m_currentOffscreenSnapshots)
             {
-                CS_ASSERT(m_currentOffscreenSnapshots[i].GetPreRenderCommandList()->GetOrderedList().size() == 0 && m_currentOffscreenSnapshots[i].GetPostRenderCommandList()->GetOrderedList().size() == 0, "Offscreen render snapshots cannot have pre or post render commands");
-                
-                auto renderFrameData = m_currentOffscreenSnapshots[i].ClaimRenderFrameData();
-                renderFramesData.push_back(std::move(renderFrameData));
-                
-                auto renderFrame = CompileRenderFrame(m_currentOffscreenSnapshots[i]);
-                renderFrames.push_back(std::move(renderFrame));
+                CS_ASSERT(offscreenSnapshot.GetPreRenderCommandList()->GetNumCommands() == 0 && offscreenSnapshot.GetPostRenderCommandList()->GetNumCommands() == 0, "Offscreen render snapshots cannot have pre or post render commands");
+                snapshots.push_back(&offscreenSnapshot);
             }
+            snapshots.push_back(&m_currentMainSnapshot);
             
             auto preRenderCommandList = m_currentMainSnapshot.ClaimPreRenderCommandList();
             auto postRenderCommandList = m_currentMainSnapshot.ClaimPostRenderCommandList();
             
-            auto renderFrameData = m_currentMainSnapshot.ClaimRenderFrameData();
-            renderFramesData.push_back(std::move(renderFrameData));
+            FlagUploadedResources(preRenderCommandList.get());
+            
+            std::vector<RenderFrameData> renderFramesData;
+            renderFramesData.reserve(numSnapshots);
+            for (auto snapshot : snapshots)
+            {
+                renderFramesData.push_back(snapshot->ClaimRenderFrameData());
+            }
+            
+            //Each snapshot is independent, so its render frame and target render pass groups are compiled in a
+            //separate task. The results are only joined when compiling the render commands.
+            std::vector<std::vector<RenderFrame>> renderFrames(numSnapshots);
+            std::vector<std::vector<TargetRenderPassGroup>> snapshotTargetRenderPassGroups(numSnapshots);
+            
+            std::vector<Task> tasks;
+            tasks.reserve(numSnapshots);
+            for (u32 i = 0; i < numSnapshots; ++i)
+            {
+                tasks.push_back([=, &snapshots, &renderFrames, &snapshotTargetRenderPassGroups](const TaskContext& innerTaskContext)
+                {
+                    CS_PROFILE_ZONE("Renderer::CompileSnapshot");
+
+                    renderFrames[i].push_back(CompileRenderFrame(*snapshots[i]));
+                    snapshotTargetRenderPassGroups[i] = m_renderPassCompiler->CompileTargetRenderPassGroups(innerTaskContext, std::move(renderFrames[i]));
+                });
+            }
+            taskContext.ProcessChildTasks(tasks);
             
-            auto renderFrame = CompileRenderFrame(m_currentMainSnapshot);
-            renderFrames.push_back(std::move(renderFrame));
+            std::vector<TargetRenderPassGroup> targetRenderPassGroups;
+            for (auto& groups : snapshotTargetRenderPassGroups)
+            {
+                std::move(groups.begin(), groups.end(), std::back_inserter(targetRenderPassGroups));
+            }
             
-            auto targetRenderPassGroups = m_renderPassCompiler->CompileTargetRenderPassGroups(taskContext, std::move(renderFrames));
             auto renderCommandBuffer = RenderCommandCompiler::CompileRenderCommands(taskContext, std::move(frameAllocator), targetRenderPassGroups, std::move(preRenderCommandList), std::move(postRenderCommandList), std::move(renderFramesData));
             
             m_commandRecycleSystem->WaitThenPushCommandBuffer(std::move(renderCommandBuffer));
@@ -131,18 +197,34 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void Renderer::ProcessRenderCommandBuffer() noexcept
     {
+        CS_PROFILE_ZONE("Renderer::ProcessRenderCommandBuffer");
+        
         auto renderCommandBuffer = m_commandRecycleSystem->WaitThenPopCommandBuffer();
         m_renderCommandProcessor->Process(renderCommandBuffer.get());
         
+        {
+            std::unique_lock<std::mutex> lock(m_frameStatsMutex);
+            m_frameStats = m_renderCommandProcessor->GetFrameStats();
+        }
+        
         auto allocator = renderCommandBuffer->GetFrameAllocator();
         renderCommandBuffer.reset();
         
         m_frameAllocatorQueue.Push(allocator);
     }
     
+    //------------------------------------------------------------------------------
+    RenderFrameStats Renderer::GetFrameStats() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_frameStatsMutex);
+        return m_frameStats;
+    }
+    
     //------------------------------------------------------------------------------
     void Renderer::WaitThenStartRenderPrep() noexcept
     {
+        CS_PROFILE_ZONE("Renderer::WaitThenStartRenderPrep");
+        
         std::unique_lock<std::mutex> lock(m_renderPrepMutex);
         
         while (m_renderPrepActive)
@@ -130,6 +130,12 @@ namespace ChilliSource
         ///
         void ProcessRenderCommandBuffer() noexcept;
         
+        /// This is thread-safe.
+        ///
+        /// @return The statistics gathered while processing the most recently rendered frame.
+        ///
+        RenderFrameStats GetFrameStats() const noexcept;
+        
         /// @return The renderers frame allocator queue
         ///
         FrameAllocatorQueue& GetFrameAllocatorQueue() noexcept { return m_frameAllocatorQueue; }
@@ -189,6 +195,9 @@ namespace ChilliSource
         std::vector<RenderSnapshot> m_currentOffscreenSnapshots;
         
         RenderCommandBufferManager* m_commandRecycleSystem = nullptr;
+        
+        mutable std::mutex m_frameStatsMutex;
+        RenderFrameStats m_frameStats;
     };
 }
 
@@ -0,0 +1,251 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Base/TextLayoutCache.h>
+
+#include <ChilliSource/Rendering/Font/Font.h>
+
+#include <functional>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        /// Combines the hash of the given value into the given seed.
+        ///
+        /// @param seed
+        ///     The hash to combine into.
+        /// @param value
+        ///     The value to hash.
+        ///
+        template <typename TType> void HashCombine(std::size_t& seed, const TType& value) noexcept
+        {
+            seed ^= std::hash<TType>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        
+        /// @return The hash of the given cache key.
+        ///
+        std::size_t CalculateHash(const std::string& text, const FontCSPtr& font, const Vector2& bounds, const CanvasRenderer::TextProperties& textProperties) noexcept
+        {
+            std::size_t hash = std::hash<std::string>()(text);
+            HashCombine(hash, font.get());
+            HashCombine(hash, font->GetGeneration());
+            HashCombine(hash, bounds.x);
+            HashCombine(hash, bounds.y);
+            HashCombine(hash, textProperties.m_textScale);
+            HashCombine(hash, textProperties.m_minTextScale);
+            HashCombine(hash, textProperties.m_absCharSpacingOffset);
+            HashCombine(hash, textProperties.m_absLineSpacingOffset);
+            HashCombine(hash, textProperties.m_lineSpacingScale);
+            HashCombine(hash, textProperties.m_maxNumLines);
+            HashCombine(hash, textProperties.m_shouldAutoScale);
+            HashCombine(hash, u32(textProperties.m_horizontalJustification));
+            HashCombine(hash, u32(textProperties.m_verticalJustification));
+            return hash;
+        }
+        
+        /// @return Whether or not the two sets of text properties are identical.
+        ///
+        bool AreEqual(const CanvasRenderer::TextProperties& a, const CanvasRenderer::TextProperties& b) noexcept
+        {
+            return a.m_textScale == b.m_textScale && a.m_minTextScale == b.m_minTextScale && a.m_absCharSpacingOffset == b.m_absCharSpacingOffset &&
+                a.m_absLineSpacingOffset == b.m_absLineSpacingOffset && a.m_lineSpacingScale == b.m_lineSpacingScale && a.m_maxNumLines == b.m_maxNumLines &&
+                a.m_shouldAutoScale == b.m_shouldAutoScale && a.m_horizontalJustification == b.m_horizontalJustification && a.m_verticalJustification == b.m_verticalJustification;
+        }
+        
+        /// @return The approximate memory used by an entry with the given text and built text.
+        ///
+        template <typename TEntry> u32 CalculateMemoryUsage(const std::string& text, const CanvasRenderer::BuiltText& builtText) noexcept
+        {
+            return u32(sizeof(TEntry) + text.size() + builtText.m_characters.size() * sizeof(CanvasRenderer::DisplayCharacterInfo));
+        }
+    }
+    
+    constexpr u32 TextLayoutCache::k_defaultMemoryBudget;
+    
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    TextLayoutCache::TextLayoutCache(u32 memoryBudget) noexcept
+        : m_memoryBudget(memoryBudget)
+    {
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    bool TextLayoutCache::TryGet(const std::string& text, const FontCSPtr& font, const Vector2& bounds, const CanvasRenderer::TextProperties& textProperties,
+                                 CanvasRenderer::BuiltText& out_builtText, f32& out_textScale) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        if (m_memoryBudget == 0)
+        {
+            return false;
+        }
+        
+        auto it = Find(CalculateHash(text, font, bounds, textProperties), text, font, bounds, textProperties);
+        if (it == m_lookup.end())
+        {
+            ++m_stats.m_numMisses;
+            return false;
+        }
+        
+        ++m_stats.m_numHits;
+        
+        auto entryIt = it->second;
+        m_entries.splice(m_entries.begin(), m_entries, entryIt);
+        
+        out_builtText = entryIt->m_builtText;
+        out_textScale = entryIt->m_textScale;
+        return true;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TextLayoutCache::Add(const std::string& text, const FontCSPtr& font, const Vector2& bounds, const CanvasRenderer::TextProperties& textProperties,
+                              const CanvasRenderer::BuiltText& builtText, f32 textScale) noexcept
+    {
+        u32 memoryUsage = CalculateMemoryUsage<Entry>(text, builtText);
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        if (memoryUsage > m_memoryBudget)
+        {
+            return;
+        }
+        
+        std::size_t hash = CalculateHash(text, font, bounds, textProperties);
+        if (Find(hash, text, font, bounds, textProperties) != m_lookup.end())
+        {
+            return;
+        }
+        
+        EvictToBudget(m_memoryBudget - memoryUsage);
+        
+        Entry entry;
+        entry.m_hash = hash;
+        entry.m_text = text;
+        entry.m_fontKey = font.get();
+        entry.m_fontGeneration = font->GetGeneration();
+        entry.m_font = font;
+        entry.m_bounds = bounds;
+        entry.m_textProperties = textProperties;
+        entry.m_builtText = builtText;
+        entry.m_textScale = textScale;
+        entry.m_memoryUsage = memoryUsage;
+        
+        m_entries.push_front(std::move(entry));
+        m_lookup.insert(std::make_pair(hash, m_entries.begin()));
+        
+        m_stats.m_memoryUsage += memoryUsage;
+        ++m_stats.m_numEntries;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    u32 TextLayoutCache::GetMemoryBudget() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_memoryBudget;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TextLayoutCache::SetMemoryBudget(u32 memoryBudget) noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        m_memoryBudget = memoryBudget;
+        EvictToBudget(m_memoryBudget);
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    TextLayoutCache::Stats TextLayoutCache::GetStats() const noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TextLayoutCache::ResetStats() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        m_stats.m_numHits = 0;
+        m_stats.m_numMisses = 0;
+        m_stats.m_numEvictions = 0;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TextLayoutCache::Clear() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        
+        m_lookup.clear();
+        m_entries.clear();
+        m_stats.m_numEntries = 0;
+        m_stats.m_memoryUsage = 0;
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    void TextLayoutCache::EvictToBudget(u32 memoryBudget) noexcept
+    {
+        while (m_stats.m_memoryUsage > memoryBudget && m_entries.empty() == false)
+        {
+            auto entryIt = std::prev(m_entries.end());
+            
+            auto range = m_lookup.equal_range(entryIt->m_hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == entryIt)
+                {
+                    m_lookup.erase(it);
+                    break;
+                }
+            }
+            
+            m_stats.m_memoryUsage -= entryIt->m_memoryUsage;
+            --m_stats.m_numEntries;
+            ++m_stats.m_numEvictions;
+            
+            m_entries.erase(entryIt);
+        }
+    }
+    //------------------------------------------------------------------------------
+    //------------------------------------------------------------------------------
+    std::unordered_multimap<std::size_t, TextLayoutCache::EntryList::iterator>::iterator TextLayoutCache::Find(std::size_t hash, const std::string& text, const FontCSPtr& font, const Vector2& bounds,
+                                                                                                                const CanvasRenderer::TextProperties& textProperties) noexcept
+    {
+        auto range = m_lookup.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const auto& entry = *it->second;
+            
+            //The font is compared through the weak pointer as well as the address, so a different font which happens
+            //to be allocated at the address of a released one is never matched. The generation changes when a font
+            //is reloaded in place, so text built with the old glyphs is never matched either.
+            if (entry.m_fontKey == font.get() && entry.m_fontGeneration == font->GetGeneration() && entry.m_font.lock() == font && entry.m_bounds == bounds && entry.m_text == text && AreEqual(entry.m_textProperties, textProperties))
+            {
+                return it;
+            }
+        }
+        
+        return m_lookup.end();
+    }
+}
@@ -0,0 +1,179 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_BASE_TEXTLAYOUTCACHE_H_
+#define _CHILLISOURCE_RENDERING_BASE_TEXTLAYOUTCACHE_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Rendering/Base/CanvasRenderer.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace ChilliSource
+{
+    /// A least recently used cache of text built by the canvas renderer. Building text
+    /// requires line wrapping and, if auto scaling, a binary search over text scale
+    /// which re-lays out the whole string at each step. Labels are frequently rebuilt
+    /// with the same text, font, bounds and properties, particularly on localised
+    /// screens when the layout changes, so the result is kept and re-used.
+    ///
+    /// Entries are evicted in least recently used order when the approximate memory
+    /// used by the cache exceeds the memory budget. Entries built with a font which has
+    /// since been reloaded are never matched, and are left to be evicted.
+    ///
+    /// This is thread-safe.
+    ///
+    class TextLayoutCache final
+    {
+    public:
+        CS_DECLARE_NOCOPY(TextLayoutCache);
+        
+        static constexpr u32 k_defaultMemoryBudget = 512 * 1024;
+        
+        /// Counters describing the use of the cache since it was created or the stats
+        /// were last reset.
+        ///
+        struct Stats
+        {
+            u64 m_numHits = 0;
+            u64 m_numMisses = 0;
+            u64 m_numEvictions = 0;
+            u32 m_numEntries = 0;
+            u32 m_memoryUsage = 0;
+        };
+        
+        /// @param memoryBudget
+        ///     The approximate maximum amount of memory, in bytes, used by cached entries.
+        ///
+        TextLayoutCache(u32 memoryBudget = k_defaultMemoryBudget) noexcept;
+        
+        /// Looks up previously built text. If found, the entry becomes the most recently
+        /// used.
+        ///
+        /// @param text
+        ///     The text (UTF-8).
+        /// @param font
+        ///     The font the text was built with.
+        /// @param bounds
+        ///     The bounds the text was built within.
+        /// @param textProperties
+        ///     The properties the text was built with.
+        /// @param out_builtText
+        ///     (Out) The cached built text. Unchanged if there is no entry.
+        /// @param out_textScale
+        ///     (Out) The cached final text scale. Unchanged if there is no entry.
+        ///
+        /// @return Whether or not an entry was found.
+        ///
+        bool TryGet(const std::string& text, const FontCSPtr& font, const Vector2& bounds, const CanvasRenderer::TextProperties& textProperties,
+                    CanvasRenderer::BuiltText& out_builtText, f32& out_textScale) noexcept;
+        
+        /// Adds built text to the cache as the most recently used entry, evicting the
+        /// least recently used entries if this takes the cache over its memory budget.
+        /// Text which is larger than the entire budget is not cached.
+        ///
+        /// @param text
+        ///     The text (UTF-8).
+        /// @param font
+        ///     The font the text was built with.
+        /// @param bounds
+        ///     The bounds the text was built within.
+        /// @param textProperties
+        ///     The properties the text was built with.
+        /// @param builtText
+        ///     The built text.
+        /// @param textScale
+        ///     The final text scale.
+        ///
+        void Add(const std::string& text, const FontCSPtr& font, const Vector2& bounds, const CanvasRenderer::TextProperties& textProperties,
+                 const CanvasRenderer::BuiltText& builtText, f32 textScale) noexcept;
+        
+        /// @return The approximate maximum amount of memory, in bytes, used by cached entries.
+        ///
+        u32 GetMemoryBudget() const noexcept;
+        
+        /// Sets the memory budget, evicting entries if the cache is now over budget. A
+        /// budget of zero disables the cache.
+        ///
+        /// @param memoryBudget
+        ///     The approximate maximum amount of memory, in bytes, used by cached entries.
+        ///
+        void SetMemoryBudget(u32 memoryBudget) noexcept;
+        
+        /// @return The current cache statistics.
+        ///
+        Stats GetStats() const noexcept;
+        
+        /// Resets the hit, miss and eviction counters.
+        ///
+        void ResetStats() noexcept;
+        
+        /// Removes all entries from the cache.
+        ///
+        void Clear() noexcept;
+        
+    private:
+        struct Entry
+        {
+            std::size_t m_hash = 0;
+            std::string m_text;
+            const Font* m_fontKey = nullptr;
+            u32 m_fontGeneration = 0;
+            std::weak_ptr<const Font> m_font;
+            Vector2 m_bounds;
+            CanvasRenderer::TextProperties m_textProperties;
+            CanvasRenderer::BuiltText m_builtText;
+            f32 m_textScale = 1.0f;
+            u32 m_memoryUsage = 0;
+        };
+        
+        using EntryList = std::list<Entry>;
+        
+        /// Evicts least recently used entries until the memory usage is within the
+        /// given budget. The mutex must be locked prior to calling this.
+        ///
+        /// @param memoryBudget
+        ///     The memory budget to fit within.
+        ///
+        void EvictToBudget(u32 memoryBudget) noexcept;
+        
+        /// @return The entry in the lookup table which matches the given key, or the end
+        ///     of the table if there isn't one. The mutex must be locked prior to calling
+        ///     this.
+        ///
+        std::unordered_multimap<std::size_t, EntryList::iterator>::iterator Find(std::size_t hash, const std::string& text, const FontCSPtr& font, const Vector2& bounds,
+                                                                                  const CanvasRenderer::TextProperties& textProperties) noexcept;
+        
+        mutable std::mutex m_mutex;
+        u32 m_memoryBudget;
+        EntryList m_entries;
+        std::unordered_multimap<std::size_t, EntryList::iterator> m_lookup;
+        Stats m_stats;
+    };
+}
+
+#endif
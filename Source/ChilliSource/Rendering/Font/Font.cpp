@@ -62,6 +62,7 @@ namespace ChilliSource
         m_characterInfos.clear();
         m_characters = in_desc.m_supportedCharacters;
         m_texture = in_desc.m_texture;
+        ++m_generation;
         
         const f32 textureAtlasWidth = (f32)in_desc.m_textureAtlasWidth;
         const f32 textureAtlasHeight = (f32)in_desc.m_textureAtlasHeight;
@@ -132,6 +133,12 @@ namespace ChilliSource
     {
         return m_texture;
     }
+    //-------------------------------------------
+    //-------------------------------------------
+    u32 Font::GetGeneration() const
+    {
+        return m_generation;
+    }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     u32 Font::GetPointSize() const
@@ -176,6 +176,12 @@ namespace ChilliSource
         /// @return Whether the character exists in the font
         //---------------------------------------------------------------------
         bool TryGetCharacterInfo(UTF8Char in_char, CharacterInfo& out_info) const;
+        //---------------------------------------------------------------------
+        /// @return The number of times the font has been built. This changes
+        /// whenever the font is reloaded in place, so can be used to detect
+        /// that anything derived from the font is out of date.
+        //---------------------------------------------------------------------
+        u32 GetGeneration() const;
     
     private:
         
@@ -205,6 +211,7 @@ namespace ChilliSource
         f32 m_lineHeight = 0.0f;
         f32 m_descent = 0.0f;
         f32 m_verticalPadding;
+        u32 m_generation = 0;
         
         static f32 s_globalKerningOffset;
     };
@@ -37,6 +37,7 @@
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Rendering/Font/Font.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
+#include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 
 namespace ChilliSource
 {
@@ -47,6 +48,14 @@ namespace ChilliSource
         const u32 k_fileFormatId = 1;
         const u32 k_fileFormatVersion = 2;
         //----------------------------------------------------------------------------
+        /// @return The options used to load font textures. Text is part of the UI,
+        /// so font textures are uploaded with UI priority.
+        //----------------------------------------------------------------------------
+        IResourceOptionsCSPtr<Texture> GetTextureOptions()
+        {
+            return std::make_shared<TextureResourceOptions>(RenderUploadPriority::k_ui);
+        }
+        //----------------------------------------------------------------------------
         /// Reads the contents of the INFO chunk in a CSFont file. This contains
         /// information relating to the source font, and data that applies to all
         /// glyphs.
@@ -258,7 +267,7 @@ namespace ChilliSource
         if(in_delegate == nullptr)
         {
             Font::Descriptor desc;
-            desc.m_texture = Application::Get()->GetResourcePool()->LoadResource<Texture>(in_location, textureFilePath);
+            desc.m_texture = Application::Get()->GetResourcePool()->LoadResource<Texture>(in_location, textureFilePath, GetTextureOptions());
             if(desc.m_texture == nullptr)
             {
                 out_resource->SetLoadState(Resource::LoadState::k_failed);
@@ -277,7 +286,7 @@ namespace ChilliSource
         }
         else
         {
-            Application::Get()->GetResourcePool()->LoadResourceAsync<Texture>(in_location, textureFilePath, [=](const TextureCSPtr& in_texture)
+            Application::Get()->GetResourcePool()->LoadResourceAsync<Texture>(in_location, textureFilePath, GetTextureOptions(), [=](const TextureCSPtr& in_texture)
             {
                 if(in_texture != nullptr)
                 {
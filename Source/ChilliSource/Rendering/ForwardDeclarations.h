@@ -48,11 +48,14 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(Renderer);
     CS_FORWARDDECLARE_CLASS(RenderFrame);
     CS_FORWARDDECLARE_CLASS(RenderFrameData);
+    CS_FORWARDDECLARE_STRUCT(RenderFrameStats);
     CS_FORWARDDECLARE_CLASS(RenderObject);
     CS_FORWARDDECLARE_CLASS(RenderPass);
     CS_FORWARDDECLARE_CLASS(RenderPassObject);
     CS_FORWARDDECLARE_CLASS(RenderSnapshot);
+    CS_FORWARDDECLARE_CLASS(RenderUploadScheduler);
     CS_FORWARDDECLARE_CLASS(TargetRenderPassGroup);
+    CS_FORWARDDECLARE_CLASS(TextLayoutCache);
     CS_FORWARDDECLARE_CLASS(CameraRenderPassGroup);
     enum class AlignmentAnchor;
     enum class BlendEqn;
@@ -63,6 +66,7 @@ namespace ChilliSource
     enum class HorizontalTextJustification;
     enum class RenderLayer;
     enum class RenderPasses;
+    enum class RenderUploadPriority;
     enum class SizePolicy;
     enum class StencilOp;
     enum class SurfaceFormat;
@@ -106,6 +110,8 @@ namespace ChilliSource
     /// Model
     //------------------------------------------------------------
     CS_FORWARDDECLARE_CLASS(AnimatedModelComponent);
+    CS_FORWARDDECLARE_CLASS(AnimationUpdateScheduler);
+    CS_FORWARDDECLARE_CLASS(CompressedKeyFrames);
     CS_FORWARDDECLARE_CLASS(CSAnimProvider);
     CS_FORWARDDECLARE_CLASS(CSModelProvider);
     CS_FORWARDDECLARE_CLASS(MeshDesc);
@@ -122,6 +128,8 @@ namespace ChilliSource
     CS_FORWARDDECLARE_STRUCT(SkeletonNode);
     CS_FORWARDDECLARE_CLASS(SkinnedAnimation);
     CS_FORWARDDECLARE_CLASS(SkinnedAnimationGroup);
+    CS_FORWARDDECLARE_CLASS(SkinnedAnimationPose);
+    CS_FORWARDDECLARE_CLASS(SkinnedAnimationResourceOptions);
     CS_FORWARDDECLARE_CLASS(SmallMeshBatcher);
     CS_FORWARDDECLARE_CLASS(StaticModelComponent);
     CS_FORWARDDECLARE_CLASS(VertexFormat);
@@ -134,7 +142,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(CSParticleProvider);
     CS_FORWARDDECLARE_CLASS(ParticleEffect);
     CS_FORWARDDECLARE_CLASS(ParticleEffectComponent);
-    CS_FORWARDDECLARE_STRUCT(Particle);
+    CS_FORWARDDECLARE_CLASS(ParticleArray);
     CS_FORWARDDECLARE_CLASS(ParticleDrawable);
     CS_FORWARDDECLARE_CLASS(ParticleDrawableDef);
     CS_FORWARDDECLARE_CLASS(ParticleDrawableDefFactory);
@@ -144,6 +152,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(ParticleAffector);
     CS_FORWARDDECLARE_CLASS(ParticleAffectorDef);
     CS_FORWARDDECLARE_CLASS(ParticleAffectorDefFactory);
+    CS_FORWARDDECLARE_CLASS(ParticleUpdateScheduler);
     CS_FORWARDDECLARE_CLASS(StaticBillboardParticleDrawable);
     CS_FORWARDDECLARE_CLASS(StaticBillboardParticleDrawableDef);
     CS_FORWARDDECLARE_CLASS(AccelerationParticleAffector);
@@ -203,6 +212,7 @@ namespace ChilliSource
     CS_FORWARDDECLARE_CLASS(RenderCommandBufferManager);
     CS_FORWARDDECLARE_CLASS(RenderCommandList);
     CS_FORWARDDECLARE_CLASS(RenderInstanceRenderCommand);
+    CS_FORWARDDECLARE_CLASS(RenderInstancesRenderCommand);
     CS_FORWARDDECLARE_CLASS(UnloadMaterialGroupRenderCommand);
     CS_FORWARDDECLARE_CLASS(UnloadMeshRenderCommand);
     CS_FORWARDDECLARE_CLASS(UnloadShaderRenderCommand);
@@ -28,6 +28,7 @@
 #include <ChilliSource/Core/Entity/Entity.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
 #include <ChilliSource/Rendering/Material/Material.h>
+#include <ChilliSource/Rendering/Model/AnimationUpdateScheduler.h>
 #include <ChilliSource/Rendering/Model/Skeleton.h>
 
 #include <algorithm>
@@ -202,6 +203,7 @@ namespace ChilliSource
         
         m_oobb.SetSize(m_model->GetAABB().GetSize());
         m_oobb.SetOrigin(m_model->GetAABB().GetOrigin());
+        InvalidateVolume();
         
         SetMaterial(GetMaterialForMesh(0));
         
@@ -221,6 +223,7 @@ namespace ChilliSource
         
         m_oobb.SetSize(m_model->GetAABB().GetSize());
         m_oobb.SetOrigin(m_model->GetAABB().GetOrigin());
+        InvalidateVolume();
         
         SetMaterial(material);
         
@@ -246,6 +249,7 @@ namespace ChilliSource
         
         m_oobb.SetSize(m_model->GetAABB().GetSize());
         m_oobb.SetOrigin(m_model->GetAABB().GetOrigin());
+        InvalidateVolume();
         
         Reset();
     }
@@ -518,29 +522,46 @@ namespace ChilliSource
         CS_ASSERT(m_activeAnimationGroup->GetAnimationCount() > 0, "Must have at least one attached animation.");
         
         UpdateAnimationTimer(deltaTime);
+        EvaluateAnimation();
+        ApplyAnimation();
+    }
+    
+    //------------------------------------------------------------------------------
+    void AnimatedModelComponent::EvaluateAnimation() noexcept
+    {
+        CS_ASSERT(m_activeAnimationGroup, "Must have an active animation group.");
+        CS_ASSERT(m_activeAnimationGroup->GetAnimationCount() > 0, "Must have at least one attached animation.");
+        
         m_activeAnimationGroup->BuildAnimationData(m_animationBlendType, m_playbackPosition, m_blendlinePosition);
         
         //if there is a group fading out, then apply this to the active data.
-        if (m_fadingAnimationGroup)
+        if (m_fadingAnimationGroup && m_maxFadeTime > 0.0f && m_fadeTimer < m_maxFadeTime)
         {
-            if (m_maxFadeTime > 0.0f && m_fadeTimer < m_maxFadeTime)
-            {
-                m_fadingAnimationGroup->BuildAnimationData(m_animationBlendType, m_fadePlaybackPosition, m_fadeBlendlinePosition);
-                f32 fGroupBlendFactor = 1.0f - (m_fadeTimer / m_maxFadeTime);
-                m_activeAnimationGroup->BlendGroup(m_animationBlendType, m_fadingAnimationGroup, fGroupBlendFactor);
-            }
-            else
-            {
-                m_fadingAnimationGroup.reset();
-            }
+            m_fadingAnimationGroup->BuildAnimationData(m_animationBlendType, m_fadePlaybackPosition, m_fadeBlendlinePosition);
+            f32 fGroupBlendFactor = 1.0f - (m_fadeTimer / m_maxFadeTime);
+            m_activeAnimationGroup->BlendGroup(m_animationBlendType, m_fadingAnimationGroup, fGroupBlendFactor);
         }
         
         m_activeAnimationGroup->BuildMatrices();
+    }
+    
+    //------------------------------------------------------------------------------
+    void AnimatedModelComponent::ApplyAnimation() noexcept
+    {
         UpdateAttachedEntities();
         
         m_animationDataDirty = false;
     }
     
+    //------------------------------------------------------------------------------
+    void AnimatedModelComponent::CompleteQueuedAnimationUpdate() noexcept
+    {
+        CS_ASSERT(m_isAnimationUpdateQueued, "No animation update was queued.");
+        
+        m_isAnimationUpdateQueued = false;
+        ApplyAnimation();
+    }
+    
     //------------------------------------------------------------------------------
     void AnimatedModelComponent::UpdateAnimationTimer(f32 deltaTime) noexcept
     {
@@ -572,10 +593,15 @@ namespace ChilliSource
             }
         }
         
-        //update the fade timer
+        //update the fade timer, discarding the fading group once the fade has finished.
         if (m_fadingAnimationGroup)
         {
             m_fadeTimer += deltaTime;
+            
+            if (m_maxFadeTime <= 0.0f || m_fadeTimer >= m_maxFadeTime)
+            {
+                m_fadingAnimationGroup.reset();
+            }
         }
     }
     
@@ -615,13 +641,25 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void AnimatedModelComponent::OnAddedToScene() noexcept
     {
+        m_animationUpdateScheduler = Application::Get()->GetSystem<AnimationUpdateScheduler>();
+        CS_ASSERT(m_animationUpdateScheduler, "Animated model component requires the AnimationUpdateScheduler system.");
+        
         SetPlaybackPosition(0.0f);
     }
     
     //------------------------------------------------------------------------------
     void AnimatedModelComponent::OnUpdate(f32 deltaTime) noexcept
     {
-        UpdateAnimation(deltaTime);
+        CS_ASSERT(m_activeAnimationGroup, "Must have an active animation group.");
+        CS_ASSERT(m_activeAnimationGroup->GetAnimationCount() > 0, "Must have at least one attached animation.");
+        
+        UpdateAnimationTimer(deltaTime);
+        
+        if (!m_isAnimationUpdateQueued)
+        {
+            m_isAnimationUpdateQueued = true;
+            m_animationUpdateScheduler->QueueUpdate(this);
+        }
     }
     
     //------------------------------------------------------------------------------
@@ -666,6 +704,12 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void AnimatedModelComponent::OnRemovedFromScene() noexcept
     {
+        if (m_isAnimationUpdateQueued)
+        {
+            m_isAnimationUpdateQueued = false;
+            m_animationUpdateScheduler->CancelUpdate(this);
+        }
+        
         DetatchAllEntities();
     }
 }
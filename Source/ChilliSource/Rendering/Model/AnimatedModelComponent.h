@@ -492,12 +492,30 @@ namespace ChilliSource
         Event<AnimationLoopedDelegate>& GetAnimationLoopedEvent() noexcept { return m_animationLoopedEvent; }
         
     private:
+        friend class AnimationUpdateScheduler;
+        
         /// Updates the animation, rebuilding the animation matrices.
         ///
         /// @param deltaTime
         ///     The delta time.
         ///
         void UpdateAnimation(f32 deltaTime) noexcept;
+        
+        /// Samples and blends the current animations, then rebuilds the animation matrices.
+        /// This only touches data owned by this component, so components can be evaluated
+        /// on background threads in parallel, as long as nothing else modifies them.
+        ///
+        void EvaluateAnimation() noexcept;
+        
+        /// Applies the result of the last evaluation to any attached entities. This must be
+        /// called on the main thread.
+        ///
+        void ApplyAnimation() noexcept;
+        
+        /// Called by the animation update scheduler once a queued update has been evaluated.
+        /// Applies the result of the evaluation. This must be called on the main thread.
+        ///
+        void CompleteQueuedAnimationUpdate() noexcept;
 
         /// Updates the animation timer.
         ///
@@ -518,7 +536,8 @@ namespace ChilliSource
         ///
         void OnAddedToScene() noexcept override;
 
-        /// Updates the animation.
+        /// Updates the animation timer, then queues the rest of the animation update with the
+        /// animation update scheduler.
         ///
         /// @param deltaTime
         ///     The delta time.
@@ -547,6 +566,8 @@ namespace ChilliSource
         std::vector<MaterialCSPtr> m_materials;
         SkinnedAnimationGroupSPtr m_activeAnimationGroup;
         SkinnedAnimationGroupSPtr m_fadingAnimationGroup;
+        AnimationUpdateScheduler* m_animationUpdateScheduler = nullptr;
+        bool m_isAnimationUpdateQueued = false;
         f32 m_playbackPosition = 0.0f;
         f32 m_playbackSpeedMultiplier = 1.0f;
         f32 m_blendlinePosition = 0.0f;
@@ -0,0 +1,198 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Model/AnimationUpdateScheduler.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Time/Profiler.h>
+#include <ChilliSource/Rendering/Model/AnimatedModelComponent.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace ChilliSource
+{
+    CS_DEFINE_NAMEDTYPE(AnimationUpdateScheduler);
+    
+    namespace
+    {
+        /// The state shared by everything evaluating the batches of a single update. Small
+        /// tasks can start after all batches are complete, so this is shared rather than
+        /// owned by the main thread.
+        ///
+        struct BatchState final
+        {
+            std::atomic<u32> m_nextBatch{0};
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            u32 m_numCompleted = 0;
+        };
+    }
+    
+    constexpr u32 AnimationUpdateScheduler::k_componentsPerTask;
+    
+    //------------------------------------------------------------------------------
+    AnimationUpdateSchedulerUPtr AnimationUpdateScheduler::Create() noexcept
+    {
+        return AnimationUpdateSchedulerUPtr(new AnimationUpdateScheduler());
+    }
+    
+    //------------------------------------------------------------------------------
+    bool AnimationUpdateScheduler::IsA(InterfaceIDType interfaceId) const noexcept
+    {
+        return (AnimationUpdateScheduler::InterfaceID == interfaceId);
+    }
+    
+    //------------------------------------------------------------------------------
+    void AnimationUpdateScheduler::QueueUpdate(AnimatedModelComponent* component) noexcept
+    {
+        CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread(), "Animation updates must be queued on the main thread.");
+        CS_ASSERT(component, "Cannot queue a null component.");
+        CS_ASSERT(std::find(m_queuedComponents.begin(), m_queuedComponents.end(), component) == m_queuedComponents.end(), "Component is already queued.");
+        
+        m_queuedComponents.push_back(component);
+        
+        //Main thread tasks are executed once all game logic for the frame is complete, so nothing else
+        //can modify the queued components while they are being evaluated.
+        if (!m_isProcessScheduled)
+        {
+            m_isProcessScheduled = true;
+            Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
+            {
+                ProcessUpdates();
+            });
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void AnimationUpdateScheduler::CancelUpdate(AnimatedModelComponent* component) noexcept
+    {
+        CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread(), "Animation updates must be cancelled on the main thread.");
+        
+        m_queuedComponents.erase(std::remove(m_queuedComponents.begin(), m_queuedComponents.end(), component), m_queuedComponents.end());
+        
+        //Applying results can trigger events which remove components from the scene, so the entry is
+        //cleared rather than removed to avoid disturbing the iteration.
+        std::replace(m_processingComponents.begin(), m_processingComponents.end(), component, static_cast<AnimatedModelComponent*>(nullptr));
+    }
+    
+    //------------------------------------------------------------------------------
+    void AnimationUpdateScheduler::ProcessUpdates() noexcept
+    {
+        CS_PROFILE_ZONE("AnimationUpdateScheduler::ProcessUpdates");
+        
+        m_isProcessScheduled = false;
+        if (m_queuedComponents.empty())
+        {
+            return;
+        }
+        
+        std::swap(m_processingComponents, m_queuedComponents);
+        
+        u32 numComponents = u32(m_processingComponents.size());
+        u32 numBatches = (numComponents + k_componentsPerTask - 1) / k_componentsPerTask;
+        
+        auto evaluateBatch = [=](u32 batchIndex) noexcept
+        {
+            CS_PROFILE_ZONE("AnimationUpdateScheduler::EvaluateBatch");
+            
+            u32 start = batchIndex * k_componentsPerTask;
+            u32 end = std::min(start + k_componentsPerTask, numComponents);
+            for (u32 i = start; i < end; ++i)
+            {
+                m_processingComponents[i]->EvaluateAnimation();
+            }
+        };
+        
+        //Small tasks and the main thread claim batches from the same counter until none are left. The main thread
+        //therefore never waits on a batch which hasn't been started, and never runs unrelated small tasks.
+        if (numBatches > 1)
+        {
+            auto batchState = std::make_shared<BatchState>();
+            auto evaluateClaimedBatches = [=]() noexcept
+            {
+                u32 numEvaluated = 0;
+                for (u32 batchIndex = batchState->m_nextBatch++; batchIndex < numBatches; batchIndex = batchState->m_nextBatch++)
+                {
+                    evaluateBatch(batchIndex);
+                    ++numEvaluated;
+                }
+                
+                if (numEvaluated > 0)
+                {
+                    std::unique_lock<std::mutex> lock(batchState->m_mutex);
+                    batchState->m_numCompleted += numEvaluated;
+                    if (batchState->m_numCompleted == numBatches)
+                    {
+                        batchState->m_condition.notify_all();
+                    }
+                }
+            };
+            
+            std::vector<Task> tasks;
+            tasks.reserve(numBatches - 1);
+            for (u32 i = 0; i < numBatches - 1; ++i)
+            {
+                tasks.push_back([=](const TaskContext&) noexcept
+                {
+                    evaluateClaimedBatches();
+                });
+            }
+            
+            Application::Get()->GetTaskScheduler()->ScheduleTasks(TaskType::k_small, tasks);
+            evaluateClaimedBatches();
+            
+            std::unique_lock<std::mutex> lock(batchState->m_mutex);
+            while (batchState->m_numCompleted < numBatches)
+            {
+                batchState->m_condition.wait(lock);
+            }
+        }
+        else
+        {
+            evaluateBatch(0);
+        }
+        
+        for (u32 i = 0; i < m_processingComponents.size(); ++i)
+        {
+            if (m_processingComponents[i])
+            {
+                m_processingComponents[i]->CompleteQueuedAnimationUpdate();
+            }
+        }
+        
+        m_processingComponents.clear();
+    }
+    
+    //------------------------------------------------------------------------------
+    void AnimationUpdateScheduler::OnDestroy() noexcept
+    {
+        m_queuedComponents.clear();
+        m_processingComponents.clear();
+    }
+}
@@ -0,0 +1,109 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_MODEL_ANIMATIONUPDATESCHEDULER_H_
+#define _CHILLISOURCE_RENDERING_MODEL_ANIMATIONUPDATESCHEDULER_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/System/AppSystem.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// Evaluates the poses of all animated model components in parallel.
+    ///
+    /// Animated model components update their playback timers during the update phase, as
+    /// this can trigger events, then queue the rest of their update with this system. Once
+    /// all game logic for the frame has completed, the queued components have their poses
+    /// sampled, blended and converted to matrices in batched small tasks. The results are
+    /// then applied to any attached entities on the main thread, prior to the render
+    /// snapshot phase.
+    ///
+    /// This must only be used on the main thread.
+    ///
+    class AnimationUpdateScheduler final : public AppSystem
+    {
+    public:
+        CS_DECLARE_NAMEDTYPE(AnimationUpdateScheduler);
+        
+        /// The number of components evaluated in each task.
+        ///
+        static constexpr u32 k_componentsPerTask = 16;
+        
+        /// Allows querying of whether or not this system implements the interface described by
+        /// the given interface Id.
+        ///
+        /// @param interfaceId
+        ///     The interface Id.
+        ///
+        /// @return Whether or not the interface is implemented.
+        ///
+        bool IsA(InterfaceIDType interfaceId) const noexcept override;
+        
+        /// Queues the animation update for the given component. This will be performed after
+        /// the game logic for the current frame has completed.
+        ///
+        /// @param component
+        ///     The component to update. This must not already be queued, and must remain in the
+        ///     scene until the update has been performed or cancelled with CancelUpdate().
+        ///
+        void QueueUpdate(AnimatedModelComponent* component) noexcept;
+        
+        /// Cancels the queued update for the given component, if there is one.
+        ///
+        /// @param component
+        ///     The component.
+        ///
+        void CancelUpdate(AnimatedModelComponent* component) noexcept;
+        
+    private:
+        friend class Application;
+        
+        /// A factory method for creating new instances of the system.
+        ///
+        /// @return The new instance.
+        ///
+        static AnimationUpdateSchedulerUPtr Create() noexcept;
+        
+        AnimationUpdateScheduler() = default;
+        
+        /// Evaluates all queued components in parallel, then applies the results on the main
+        /// thread. Batches are claimed from a shared counter by both small tasks and the main
+        /// thread, so the main thread evaluates any batch which no worker has started, and
+        /// only waits for batches which workers have already claimed.
+        ///
+        void ProcessUpdates() noexcept;
+        
+        /// Discards any queued updates.
+        ///
+        void OnDestroy() noexcept override;
+        
+        std::vector<AnimatedModelComponent*> m_queuedComponents;
+        std::vector<AnimatedModelComponent*> m_processingComponents;
+        bool m_isProcessScheduled = false;
+    };
+}
+
+#endif
@@ -0,0 +1,343 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Model/CompressedKeyFrames.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        constexpr u32 k_valuesPerVector = 3;
+        constexpr u32 k_valuesPerOrientation = 3;
+        constexpr f32 k_constantTolerance = 0.00001f;
+        constexpr f32 k_maxQuantisedValue = 65535.0f;
+        constexpr f32 k_maxSmallestThreeValue = 32767.0f;
+        constexpr u16 k_smallestThreeValueMask = 0x7fff;
+        
+        /// The range of values the three smallest components of a normalised quaternion can have
+        /// is +/- 1 / sqrt(2).
+        ///
+        constexpr f32 k_smallestThreeRange = 0.70710678f;
+        
+        /// The indices of the three components which are stored for each possible index of the
+        /// dropped component.
+        ///
+        const u32 k_smallestThreeComponents[4][3] = { { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 3 }, { 0, 1, 2 } };
+        
+        /// @param value
+        ///     The value to quantise.
+        /// @param min
+        ///     The minimum of the range the value is within.
+        /// @param extent
+        ///     The extent of the range the value is within.
+        ///
+        /// @return The value quantised to 16-bits relative to the given range.
+        ///
+        u16 QuantiseValue(f32 value, f32 min, f32 extent) noexcept
+        {
+            if (extent <= 0.0f)
+            {
+                return 0;
+            }
+            
+            f32 normalised = std::min(std::max((value - min) / extent, 0.0f), 1.0f);
+            return u16(normalised * k_maxQuantisedValue + 0.5f);
+        }
+        
+        /// Quantises each component of the given vector relative to the given bounds and writes
+        /// them to the output.
+        ///
+        /// @param value
+        ///     The vector to quantise.
+        /// @param min
+        ///     The minimum of the bounds.
+        /// @param extents
+        ///     The extents of the bounds.
+        /// @param outData
+        ///     (Out) The location to write the quantised values to.
+        ///
+        void EncodeVector(const Vector3& value, const Vector3& min, const Vector3& extents, u16* outData) noexcept
+        {
+            outData[0] = QuantiseValue(value.x, min.x, extents.x);
+            outData[1] = QuantiseValue(value.y, min.y, extents.y);
+            outData[2] = QuantiseValue(value.z, min.z, extents.z);
+        }
+        
+        /// Packs the given orientation into 48-bits using the smallest three encoding. The
+        /// largest component is dropped, and the remaining three are each quantised to 15-bits.
+        /// The index of the dropped component is stored in the top bit of the first two values.
+        ///
+        /// @param orientation
+        ///     The orientation to encode.
+        /// @param outData
+        ///     (Out) The location to write the three packed values to.
+        ///
+        void EncodeOrientation(const Quaternion& orientation, u16* outData) noexcept
+        {
+            Quaternion normalised = Quaternion::Normalise(orientation);
+            f32 components[4] = { normalised.x, normalised.y, normalised.z, normalised.w };
+            
+            u32 largestIndex = 0;
+            for (u32 i = 1; i < 4; ++i)
+            {
+                if (std::abs(components[i]) > std::abs(components[largestIndex]))
+                {
+                    largestIndex = i;
+                }
+            }
+            
+            //q and -q describe the same orientation, so the sign is chosen such that the dropped
+            //component is always positive.
+            f32 sign = (components[largestIndex] < 0.0f) ? -1.0f : 1.0f;
+            
+            u16 values[k_valuesPerOrientation];
+            for (u32 i = 0; i < k_valuesPerOrientation; ++i)
+            {
+                f32 component = sign * components[k_smallestThreeComponents[largestIndex][i]];
+                f32 unit = std::min(std::max((component / k_smallestThreeRange) * 0.5f + 0.5f, 0.0f), 1.0f);
+                values[i] = u16(unit * k_maxSmallestThreeValue + 0.5f);
+            }
+            
+            outData[0] = u16(values[0] | ((largestIndex & 1) << 15));
+            outData[1] = u16(values[1] | ((largestIndex >> 1) << 15));
+            outData[2] = values[2];
+        }
+        
+        /// @param frames
+        ///     The key frames.
+        /// @param nodeIndex
+        ///     The index of the node.
+        /// @param member
+        ///     The frame member containing the track.
+        /// @param outMin
+        ///     (Out) The minimum of the track bounds.
+        /// @param outExtents
+        ///     (Out) The extents of the track bounds.
+        ///
+        /// @return Whether or not the vector track changes over the course of the animation.
+        ///
+        bool CalculateVectorTrackBounds(const std::vector<SkinnedAnimation::FrameCUPtr>& frames, u32 nodeIndex, std::vector<Vector3> SkinnedAnimation::Frame::* member, Vector3& outMin, Vector3& outExtents) noexcept
+        {
+            Vector3 min = ((*frames[0]).*member)[nodeIndex];
+            Vector3 max = min;
+            for (const auto& frame : frames)
+            {
+                const auto& value = ((*frame).*member)[nodeIndex];
+                min = Vector3::Min(min, value);
+                max = Vector3::Max(max, value);
+            }
+            
+            outMin = min;
+            outExtents = max - min;
+            return outExtents.x > k_constantTolerance || outExtents.y > k_constantTolerance || outExtents.z > k_constantTolerance;
+        }
+        
+        /// @param frames
+        ///     The key frames.
+        /// @param nodeIndex
+        ///     The index of the node.
+        ///
+        /// @return Whether or not the orientation track changes over the course of the animation.
+        ///     The components are compared rather than the dot product, as the dot product of
+        ///     orientations a fraction of a degree apart is too close to 1 to be told apart.
+        ///
+        bool IsOrientationTrackAnimated(const std::vector<SkinnedAnimation::FrameCUPtr>& frames, u32 nodeIndex) noexcept
+        {
+            Quaternion first = Quaternion::Normalise(frames[0]->m_nodeOrientations[nodeIndex]);
+            for (const auto& frame : frames)
+            {
+                Quaternion orientation = Quaternion::Normalise(frame->m_nodeOrientations[nodeIndex]);
+                
+                //q and -q describe the same orientation.
+                f32 sign = (Quaternion::Dot(first, orientation) < 0.0f) ? -1.0f : 1.0f;
+                if (std::abs(sign * orientation.x - first.x) > k_constantTolerance || std::abs(sign * orientation.y - first.y) > k_constantTolerance ||
+                    std::abs(sign * orientation.z - first.z) > k_constantTolerance || std::abs(sign * orientation.w - first.w) > k_constantTolerance)
+                {
+                    return true;
+                }
+            }
+            
+            return false;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    CompressedKeyFrames::CompressedKeyFrames(const std::vector<SkinnedAnimation::FrameCUPtr>& frames) noexcept
+        : m_numFrames(u32(frames.size()))
+    {
+        if (frames.empty())
+        {
+            return;
+        }
+        
+        u32 numNodes = u32(frames[0]->m_nodeOrientations.size());
+        
+#ifdef CS_ENABLE_DEBUG
+        for (const auto& frame : frames)
+        {
+            CS_ASSERT(frame->m_nodeTranslations.size() == numNodes && frame->m_nodeOrientations.size() == numNodes && frame->m_nodeScales.size() == numNodes, "Cannot compress key frames with differing numbers of nodes.");
+        }
+#endif
+        
+        m_tracks.resize(numNodes);
+        for (u32 nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+        {
+            auto& track = m_tracks[nodeIndex];
+            
+            if (CalculateVectorTrackBounds(frames, nodeIndex, &SkinnedAnimation::Frame::m_nodeTranslations, track.m_translation, track.m_translationExtents))
+            {
+                track.m_animatedTracks |= k_translation;
+                m_frameStride += k_valuesPerVector;
+            }
+            else
+            {
+                track.m_translation = frames[0]->m_nodeTranslations[nodeIndex];
+            }
+            
+            if (IsOrientationTrackAnimated(frames, nodeIndex))
+            {
+                track.m_animatedTracks |= k_orientation;
+                m_frameStride += k_valuesPerOrientation;
+            }
+            else
+            {
+                track.m_orientation = Quaternion::Normalise(frames[0]->m_nodeOrientations[nodeIndex]);
+            }
+            
+            if (CalculateVectorTrackBounds(frames, nodeIndex, &SkinnedAnimation::Frame::m_nodeScales, track.m_scale, track.m_scaleExtents))
+            {
+                track.m_animatedTracks |= k_scale;
+                m_frameStride += k_valuesPerVector;
+            }
+            else
+            {
+                track.m_scale = frames[0]->m_nodeScales[nodeIndex];
+            }
+        }
+        
+        m_frameData.resize(m_numFrames * m_frameStride);
+        u16* data = m_frameData.data();
+        for (const auto& frame : frames)
+        {
+            for (u32 nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+            {
+                const auto& track = m_tracks[nodeIndex];
+                
+                if ((track.m_animatedTracks & k_translation) != 0)
+                {
+                    EncodeVector(frame->m_nodeTranslations[nodeIndex], track.m_translation, track.m_translationExtents, data);
+                    data += k_valuesPerVector;
+                }
+                
+                if ((track.m_animatedTracks & k_orientation) != 0)
+                {
+                    EncodeOrientation(frame->m_nodeOrientations[nodeIndex], data);
+                    data += k_valuesPerOrientation;
+                }
+                
+                if ((track.m_animatedTracks & k_scale) != 0)
+                {
+                    EncodeVector(frame->m_nodeScales[nodeIndex], track.m_scale, track.m_scaleExtents, data);
+                    data += k_valuesPerVector;
+                }
+            }
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 CompressedKeyFrames::GetMemoryUsage() const noexcept
+    {
+        return u32(sizeof(CompressedKeyFrames) + m_tracks.capacity() * sizeof(Track) + m_frameData.capacity() * sizeof(u16));
+    }
+    
+    //------------------------------------------------------------------------------
+    void CompressedKeyFrames::DecodeFrame(u32 frameIndex, u32 numNodes, f32* const outTranslations[3], f32* const outScales[3], f32* const outOrientations[4]) const noexcept
+    {
+        CS_ASSERT(frameIndex < m_numFrames, "Compressed key frame index out of bounds.");
+        
+        const f32 valueScale = 1.0f / k_maxQuantisedValue;
+        const f32 smallestThreeScale = (2.0f * k_smallestThreeRange) / k_maxSmallestThreeValue;
+        
+        const u16* data = m_frameData.data() + frameIndex * m_frameStride;
+        u32 numDecodedNodes = std::min(numNodes, u32(m_tracks.size()));
+        for (u32 nodeIndex = 0; nodeIndex < numDecodedNodes; ++nodeIndex)
+        {
+            const auto& track = m_tracks[nodeIndex];
+            
+            if ((track.m_animatedTracks & k_translation) != 0)
+            {
+                outTranslations[0][nodeIndex] = track.m_translation.x + track.m_translationExtents.x * (f32(data[0]) * valueScale);
+                outTranslations[1][nodeIndex] = track.m_translation.y + track.m_translationExtents.y * (f32(data[1]) * valueScale);
+                outTranslations[2][nodeIndex] = track.m_translation.z + track.m_translationExtents.z * (f32(data[2]) * valueScale);
+                data += k_valuesPerVector;
+            }
+            else
+            {
+                outTranslations[0][nodeIndex] = track.m_translation.x;
+                outTranslations[1][nodeIndex] = track.m_translation.y;
+                outTranslations[2][nodeIndex] = track.m_translation.z;
+            }
+            
+            if ((track.m_animatedTracks & k_orientation) != 0)
+            {
+                u32 largestIndex = u32(data[0] >> 15) | (u32(data[1] >> 15) << 1);
+                const u32* componentIndices = k_smallestThreeComponents[largestIndex];
+                
+                f32 a = f32(data[0] & k_smallestThreeValueMask) * smallestThreeScale - k_smallestThreeRange;
+                f32 b = f32(data[1] & k_smallestThreeValueMask) * smallestThreeScale - k_smallestThreeRange;
+                f32 c = f32(data[2]) * smallestThreeScale - k_smallestThreeRange;
+                
+                outOrientations[componentIndices[0]][nodeIndex] = a;
+                outOrientations[componentIndices[1]][nodeIndex] = b;
+                outOrientations[componentIndices[2]][nodeIndex] = c;
+                outOrientations[largestIndex][nodeIndex] = std::sqrt(std::max(1.0f - (a * a + b * b + c * c), 0.0f));
+                data += k_valuesPerOrientation;
+            }
+            else
+            {
+                outOrientations[0][nodeIndex] = track.m_orientation.x;
+                outOrientations[1][nodeIndex] = track.m_orientation.y;
+                outOrientations[2][nodeIndex] = track.m_orientation.z;
+                outOrientations[3][nodeIndex] = track.m_orientation.w;
+            }
+            
+            if ((track.m_animatedTracks & k_scale) != 0)
+            {
+                outScales[0][nodeIndex] = track.m_scale.x + track.m_scaleExtents.x * (f32(data[0]) * valueScale);
+                outScales[1][nodeIndex] = track.m_scale.y + track.m_scaleExtents.y * (f32(data[1]) * valueScale);
+                outScales[2][nodeIndex] = track.m_scale.z + track.m_scaleExtents.z * (f32(data[2]) * valueScale);
+                data += k_valuesPerVector;
+            }
+            else
+            {
+                outScales[0][nodeIndex] = track.m_scale.x;
+                outScales[1][nodeIndex] = track.m_scale.y;
+                outScales[2][nodeIndex] = track.m_scale.z;
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_MODEL_COMPRESSEDKEYFRAMES_H_
+#define _CHILLISOURCE_RENDERING_MODEL_COMPRESSEDKEYFRAMES_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// A compact, read-only representation of the key frames in a skinned animation.
+    ///
+    /// Each node in the animation has a translation, orientation and scale track. Tracks which
+    /// don't change over the course of the animation are stored once at full precision. The
+    /// remaining tracks are quantised to 16-bits per component: translations and scales relative
+    /// to the bounds of the track, and orientations using the "smallest three" encoding, which
+    /// packs a quaternion into 48-bits by dropping the largest component and reconstructing it
+    /// from the other three.
+    ///
+    /// Frames are decoded directly into the channels of a pose, so no intermediate frame data is
+    /// ever allocated.
+    ///
+    /// This is immutable and therefore thread-safe.
+    ///
+    class CompressedKeyFrames final
+    {
+    public:
+        CS_DECLARE_NOCOPY(CompressedKeyFrames);
+        
+        /// Compresses the given key frames. Every frame must describe the same number of nodes.
+        ///
+        /// @param frames
+        ///     The key frames to compress.
+        ///
+        CompressedKeyFrames(const std::vector<SkinnedAnimation::FrameCUPtr>& frames) noexcept;
+        
+        /// @return The number of frames.
+        ///
+        u32 GetNumFrames() const noexcept { return m_numFrames; }
+        
+        /// @return The number of nodes described by each frame.
+        ///
+        u32 GetNumNodes() const noexcept { return u32(m_tracks.size()); }
+        
+        /// @return The approximate number of bytes used to store the key frames.
+        ///
+        u32 GetMemoryUsage() const noexcept;
+        
+        /// Decodes the given frame into separate channels for each component of the translation,
+        /// scale and orientation. Nodes beyond the number described by the frames are left
+        /// untouched.
+        ///
+        /// @param frameIndex
+        ///     The index of the frame to decode.
+        /// @param numNodes
+        ///     The number of nodes in the output channels.
+        /// @param outTranslations
+        ///     (Out) The x, y and z translation channels.
+        /// @param outScales
+        ///     (Out) The x, y and z scale channels.
+        /// @param outOrientations
+        ///     (Out) The x, y, z and w orientation channels.
+        ///
+        void DecodeFrame(u32 frameIndex, u32 numNodes, f32* const outTranslations[3], f32* const outScales[3], f32* const outOrientations[4]) const noexcept;
+        
+    private:
+        /// Flags describing which of a node's tracks change over the course of the animation,
+        /// and therefore have quantised values stored in each frame.
+        ///
+        enum AnimatedTrack : u8
+        {
+            k_translation = 1 << 0,
+            k_orientation = 1 << 1,
+            k_scale = 1 << 2
+        };
+        
+        /// The per-node information required to decode each frame. For animated translation and
+        /// scale tracks the value is the minimum of the track bounds, otherwise it is the constant
+        /// value of the track.
+        ///
+        struct Track
+        {
+            Vector3 m_translation;
+            Vector3 m_translationExtents;
+            Vector3 m_scale;
+            Vector3 m_scaleExtents;
+            Quaternion m_orientation;
+            u8 m_animatedTracks = 0;
+        };
+        
+        u32 m_numFrames;
+        u32 m_frameStride = 0;
+        std::vector<Track> m_tracks;
+        std::vector<u16> m_frameData;
+    };
+}
+
+#endif
@@ -113,6 +113,18 @@ namespace ChilliSource
         ///
         void SetExtraData(void* extraData) noexcept { m_extraData = extraData; }
         
+        /// This is not thread safe and should only be called during render prep.
+        ///
+        /// @return Whether or not the load command for this mesh has been issued. Objects
+        ///     using the mesh are not rendered until it has.
+        ///
+        bool IsUploaded() const noexcept { return m_isUploaded; }
+        
+        /// Flags the mesh as uploaded. This is called during render prep for each mesh
+        /// which is loaded in the frame, and is not thread safe.
+        ///
+        void SetUploaded() noexcept { m_isUploaded = true; }
+        
     private:
         
         PolygonType m_polygonType;
@@ -125,6 +137,7 @@ namespace ChilliSource
         std::vector<Matrix4> m_inverseBindPoseMatrices;
         
         void* m_extraData = nullptr;
+        bool m_isUploaded = false;
     };
 }
 
@@ -27,30 +27,16 @@
 namespace ChilliSource
 {
     //------------------------------------------------------------------------------
-    RenderMeshBatch::Mesh::Mesh(const Matrix4& worldMatrix, u32 numVertices, u32 numIndices, const u8* vertexData, u32 vertexDataSize, const u8* indexData, u32 indexDataSize) noexcept
-        : m_worldMatrix(worldMatrix), m_numVertices(numVertices), m_numIndices(numIndices), m_vertexData(vertexData), m_vertexDataSize(vertexDataSize), m_indexData(indexData), m_indexDataSize(indexDataSize)
+    RenderMeshBatch::RenderMeshBatch(PolygonType polygonType, const VertexFormat& vertexFormat, IndexFormat indexFormat, u32 numVertices, u32 numIndices,
+                                     UniquePtr<u8[]> vertexData, u32 vertexDataSize, UniquePtr<u8[]> indexData, u32 indexDataSize) noexcept
+        : m_polygonType(polygonType), m_vertexFormat(vertexFormat), m_indexFormat(indexFormat), m_numVertices(numVertices), m_numIndices(numIndices), m_vertexData(std::move(vertexData)),
+          m_vertexDataSize(vertexDataSize), m_indexData(std::move(indexData)), m_indexDataSize(indexDataSize)
     {
-        CS_ASSERT(vertexData, "Must supply vertex data.");
-        CS_ASSERT(vertexDataSize > 0, "Vertex data must have a greater than zero size.");
+        CS_ASSERT(m_vertexData, "Must supply vertex data.");
+        CS_ASSERT(m_vertexDataSize > 0, "Vertex data must have a greater than zero size.");
         CS_ASSERT(m_numVertices > 0, "Must have some vertices.");
+        CS_ASSERT(m_numVertices * m_vertexFormat.GetSize() == m_vertexDataSize, "Vertex data size and number of vertices is out of sync.");
         CS_ASSERT((!m_indexData && m_indexDataSize == 0 && m_numIndices == 0) || (m_indexData && m_indexDataSize > 0 && m_numIndices > 0),
                   "If there is index data then the size must be greater than zero, other wise in must be zero.");
     }
-
-    //------------------------------------------------------------------------------
-    RenderMeshBatch::RenderMeshBatch(PolygonType polygonType, const VertexFormat& vertexFormat, IndexFormat indexFormat, std::vector<Mesh> meshes) noexcept
-        : m_polygonType(polygonType), m_vertexFormat(vertexFormat), m_indexFormat(indexFormat), m_meshes(std::move(meshes))
-    {
-        CS_ASSERT(m_meshes.size() > 0, "Cannot create a batch with zero size.");
-        
-        for (const auto& mesh : m_meshes)
-        {
-            CS_ASSERT((mesh.GetIndexDataSize() > 0) == (m_meshes[0].GetIndexDataSize() > 0), "Either all meshes must have indices, or all meshes must have no indices.");
-            
-            m_numVertices += mesh.GetNumVertices();
-            m_numIndices += mesh.GetNumIndices();
-            m_vertexDataSize += mesh.GetVertexDataSize();
-            m_indexDataSize += mesh.GetIndexDataSize();
-        }
-    }
 }
@@ -26,103 +26,51 @@
 #define _CHILLISOURCE_RENDERING_MODEL_RENDERMESHBATCH_H_
 
 #include <ChilliSource/ChilliSource.h>
-#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Memory/UniquePtr.h>
 #include <ChilliSource/Rendering/Model/IndexFormat.h>
 #include <ChilliSource/Rendering/Model/PolygonType.h>
 #include <ChilliSource/Rendering/Model/VertexFormat.h>
 
-#include <vector>
-
 namespace ChilliSource
 {
-    /// Contains the description of a series of meshes which can be combined in a single draw
-    /// call. All meshes must have the same polygon type, vertex and index format, and if one
+    /// Contains the combined mesh data for a series of meshes which can be rendered in a single
+    /// draw call. All meshes must have the same polygon type, vertex and index format, and if one
     /// mesh contains indices, then they all must.
     ///
-    /// A render mesh batch doesn't directly contain any mesh data, merely holding handles to
-    /// the data. This means that the described data must outlive the mesh batch.
+    /// The vertex data has already been converted into world space, and the index data has been
+    /// offset to the position of each mesh's vertices in the combined buffer, so the data can be
+    /// uploaded directly. The data is typically allocated from the frame allocator.
     ///
     /// This is immutable and therefore thread-safe.
     ///
     class RenderMeshBatch final
     {
     public:
-        /// A container for information on a single mesh within the mesh batch.
-        ///
-        /// This is immutable and therefore thread-safe.
-        ///
-        class Mesh final
-        {
-        public:
-            /// Creates a new mesh with the given mesh data.
-            ///
-            /// @param worldMatrix
-            ///     The world matrix of the mesh.
-            /// @param numVertices
-            ///     The number of vertices in the mesh.
-            /// @param numIndices
-            ///     The number of indicews in the mesh.
-            /// @param vertexData
-            ///     The vertex data of the mesh.
-            /// @param vertexDataSize
-            ///     The size of the vertex data in bytes.
-            /// @param indexData
-            ///     The index data of the mesh. May be null if the mesh has no indices.
-            /// @param indexDataSize
-            ///     The size of the index data in bytes. May be zero if the mesh has no indices.
-            ///
-            Mesh(const Matrix4& worldMatrix, u32 numVertices, u32 numIndices, const u8* vertexData, u32 vertexDataSize, const u8* indexData, u32 indexDataSize) noexcept;
-            
-            /// @return The world matrix of the mesh.
-            ///
-            const Matrix4& GetWorldMatrix() const noexcept { return m_worldMatrix; }
-            
-            /// @return The number of vertices.
-            ///
-            u32 GetNumVertices() const noexcept { return m_numVertices; }
-            
-            /// @return The number of indices.
-            ///
-            u32 GetNumIndices() const noexcept { return m_numIndices; }
-            
-            /// @return The vertex data of the mesh.
-            ///
-            const u8* GetVertexData() const noexcept { return m_vertexData; }
-            
-            /// @return The size of the vertex data in bytes.
-            ///
-            u32 GetVertexDataSize() const noexcept { return m_vertexDataSize; }
-            
-            /// @return The index data of the mesh. May be null if the mesh has no indices.
-            ///
-            const u8* GetIndexData() const noexcept { return m_indexData; }
-            
-            /// @return The size of the index data in bytes. May be zero if the mesh has no indices.
-            ///
-            u32 GetIndexDataSize() const noexcept { return m_indexDataSize; }
-            
-        private:
-            Matrix4 m_worldMatrix;
-            u32 m_numVertices;
-            u32 m_numIndices;
-            const u8* m_vertexData;
-            u32 m_vertexDataSize;
-            const u8* m_indexData;
-            u32 m_indexDataSize;
-        };
+        CS_DECLARE_NOCOPY(RenderMeshBatch);
         
-        /// Creates a new batch with the given mesh type info and meshes to batch.
+        /// Creates a new batch with the given mesh type info and combined mesh data.
         ///
         /// @param polygonType
         ///     The polygonType of the batch.
         /// @param vertexFormat
-        ////    The vertex format of the batch.
+        ///     The vertex format of the batch.
         /// @param indexFormat
         ///     The index format of the batch.
-        /// @param meshes
-        ///     The meshes included in the batch. Should be moved.
+        /// @param numVertices
+        ///     The total number of vertices in the batch.
+        /// @param numIndices
+        ///     The total number of indices in the batch.
+        /// @param vertexData
+        ///     The combined world space vertex data. This must have been allocated from an IAllocator.
+        /// @param vertexDataSize
+        ///     The size of the vertex data in bytes.
+        /// @param indexData
+        ///     The combined index data. May be null if the batch has no indices.
+        /// @param indexDataSize
+        ///     The size of the index data in bytes. May be zero if the batch has no indices.
         ///
-        RenderMeshBatch(PolygonType polygonType, const VertexFormat& vertexFormat, IndexFormat indexFormat, std::vector<Mesh> meshes) noexcept;
+        RenderMeshBatch(PolygonType polygonType, const VertexFormat& vertexFormat, IndexFormat indexFormat, u32 numVertices, u32 numIndices,
+                        UniquePtr<u8[]> vertexData, u32 vertexDataSize, UniquePtr<u8[]> indexData, u32 indexDataSize) noexcept;
         
         /// @return The polygonType of the batch.
         ///
@@ -144,27 +92,32 @@ namespace ChilliSource
         ///
         u32 GetNumIndices() const noexcept { return m_numIndices; }
         
+        /// @return The combined world space vertex data.
+        ///
+        const u8* GetVertexData() const noexcept { return m_vertexData.get(); }
+        
         /// @return The total size of the vertex data in the batch.
         ///
         u32 GetVertexDataSize() const noexcept { return m_vertexDataSize; }
         
-        /// @return The total size of the index data in the batch.
+        /// @return The combined index data. May be null if the batch has no indices.
         ///
-        u32 GetIndexDataSize() const noexcept { return m_indexDataSize; }
+        const u8* GetIndexData() const noexcept { return m_indexData.get(); }
         
-        /// @return The meshes included in the batch.
+        /// @return The total size of the index data in the batch.
         ///
-        const std::vector<Mesh>& GetMeshes() const noexcept { return m_meshes; }
+        u32 GetIndexDataSize() const noexcept { return m_indexDataSize; }
         
     private:
         PolygonType m_polygonType;
         VertexFormat m_vertexFormat;
         IndexFormat m_indexFormat;
-        u32 m_numVertices = 0;
-        u32 m_numIndices = 0;
-        u32 m_vertexDataSize = 0;
-        u32 m_indexDataSize = 0;
-        std::vector<Mesh> m_meshes;
+        u32 m_numVertices;
+        u32 m_numIndices;
+        UniquePtr<u8[]> m_vertexData;
+        u32 m_vertexDataSize;
+        UniquePtr<u8[]> m_indexData;
+        u32 m_indexDataSize;
     };
 }
 
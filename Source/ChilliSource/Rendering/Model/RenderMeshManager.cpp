@@ -24,7 +24,9 @@
 
 #include <ChilliSource/Rendering/Model/RenderMeshManager.h>
 
+#include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/RenderUploadScheduler.h>
 #include <ChilliSource/Rendering/Base/TargetType.h>
 
 #include <mutex>
@@ -56,25 +58,22 @@ namespace ChilliSource
     {
         return (RenderMeshManager::InterfaceID == interfaceId);
     }
+    
+    //------------------------------------------------------------------------------
+    void RenderMeshManager::OnInit() noexcept
+    {
+        m_uploadScheduler = Application::Get()->GetSystem<RenderUploadScheduler>();
+        CS_ASSERT(m_uploadScheduler, "RenderMeshManager requires the RenderUploadScheduler system.");
+    }
 
     //------------------------------------------------------------------------------
     UniquePtr<RenderMesh> RenderMeshManager::CreateRenderMesh(PolygonType polygonType, const VertexFormat& vertexFormat, IndexFormat indexFormat, u32 numVertices, u32 numIndices, const Sphere& boundingSphere,
                                                           std::unique_ptr<const u8[]> vertexData, u32 vertexDataSize, std::unique_ptr<const u8[]> indexData, u32 indexDataSize, bool shouldBackupData,
-                                                          std::vector<Matrix4> inverseBindPoseMatrices) noexcept
+                                                          std::vector<Matrix4> inverseBindPoseMatrices, RenderUploadPriority uploadPriority) noexcept
     {
         UniquePtr<RenderMesh> renderMesh = MakeUnique<RenderMesh>(m_renderMeshPool, polygonType, vertexFormat, indexFormat, numVertices, numIndices, boundingSphere, shouldBackupData, std::move(inverseBindPoseMatrices));
 
-        auto rawRenderMesh = renderMesh.get();
-        
-        PendingLoadCommand loadCommand;
-        loadCommand.m_renderMesh = rawRenderMesh;
-        loadCommand.m_vertexData = std::move(vertexData);
-        loadCommand.m_vertexDataSize = vertexDataSize;
-        loadCommand.m_indexData = std::move(indexData);
-        loadCommand.m_indexDataSize = indexDataSize;
-        
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_pendingLoadCommands.push_back(std::move(loadCommand));
+        m_uploadScheduler->AddMeshUpload(renderMesh.get(), std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize, uploadPriority);
         
         return renderMesh;
     }
@@ -82,6 +81,10 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void RenderMeshManager::DestroyRenderMesh(UniquePtr<RenderMesh> renderMesh) noexcept
     {
+        // Render snapshots which are already in flight may still reference the mesh, so it is
+        // always released by an unload command, even if its upload never happened.
+        m_uploadScheduler->CancelMeshUpload(renderMesh.get());
+        
         std::unique_lock<std::mutex> lock(m_mutex);
         m_pendingUnloadCommands.push_back(std::move(renderMesh));
     }
@@ -91,17 +94,10 @@ namespace ChilliSource
     {
         if(targetType == TargetType::k_main)
         {
-            auto preRenderCommandList = renderSnapshot.GetPreRenderCommandList();
             auto postRenderCommandList = renderSnapshot.GetPostRenderCommandList();
             
             std::unique_lock<std::mutex> lock(m_mutex);
             
-            for (auto& loadCommand : m_pendingLoadCommands)
-            {
-                preRenderCommandList->AddLoadMeshCommand(loadCommand.m_renderMesh, std::move(loadCommand.m_vertexData), loadCommand.m_vertexDataSize, std::move(loadCommand.m_indexData), loadCommand.m_indexDataSize);
-            }
-            m_pendingLoadCommands.clear();
-            
             for (auto& unloadCommand : m_pendingUnloadCommands)
             {
                 postRenderCommandList->AddUnloadMeshCommand(std::move(unloadCommand));
@@ -29,6 +29,7 @@
 #include <ChilliSource/Core/Memory/ObjectPoolAllocator.h>
 #include <ChilliSource/Core/Memory/UniquePtr.h>
 #include <ChilliSource/Core/System/AppSystem.h>
+#include <ChilliSource/Rendering/Base/RenderUploadPriority.h>
 #include <ChilliSource/Rendering/Model/RenderMesh.h>
 
 #include <mutex>
@@ -37,12 +38,12 @@ namespace ChilliSource
 {
     /// Manages the lifecycle of all RenderMesh instances.
     ///
-    /// On creation of a RenderMesh a LoadMeshRenderCommand is queued for the next render
-    /// snapshot phase, ensuring that related mesh data is processed before the RenderMesh
-    /// is used.
+    /// On creation of a RenderMesh the upload of its data is queued with the RenderUploadScheduler,
+    /// which will issue the LoadMeshRenderCommand once it fits in the per-frame upload budget.
     ///
     /// On deletion an UnloadMeshRenderCommand is queued and given ownership of the
-    /// RenderMesh. The RenderMesh is then deleted once the command has been processed.
+    /// RenderMesh. The RenderMesh is then deleted once the command has been processed. If
+    /// the mesh hadn't yet been uploaded its upload is also cancelled.
     ///
     /// This is thread-safe and can be called from any thread. If it is called on a background
     /// thread, care needs to be taken to ensure any created RenderMeshes are not used prior
@@ -64,8 +65,7 @@ namespace ChilliSource
         ///
         bool IsA(InterfaceIDType interfaceId) const noexcept override;
         
-        /// Creates a new RenderMesh and queues a LoadMeshRenderCommand for the next Render Snapshot
-        /// stage in the render pipeline.
+        /// Creates a new RenderMesh and queues the upload of its data.
         ///
         /// @param polygonType
         ///     The type of polygon the mesh uses.
@@ -92,12 +92,14 @@ namespace ChilliSource
         /// @param inverseBindPoseMatrices
         ///     (Optional) The inverse bind pose matices for this mesh. Only applies to animated models.
         ///     Should be moved.
+        /// @param uploadPriority
+        ///     (Optional) The priority with which the mesh data is uploaded.
         ///
         /// @return The RenderMesh instance.
         ///
         UniquePtr<RenderMesh> CreateRenderMesh(PolygonType polygonType, const VertexFormat& vertexFormat, IndexFormat indexFormat, u32 numVertices, u32 numIndices, const Sphere& boundingSphere,
                                            std::unique_ptr<const u8[]> vertexData, u32 vertexDataSize, std::unique_ptr<const u8[]> indexData, u32 indexDataSize, bool shouldBackupData,
-                                           std::vector<Matrix4> inverseBindPoseMatrices = std::vector<Matrix4>()) noexcept;
+                                           std::vector<Matrix4> inverseBindPoseMatrices = std::vector<Matrix4>(), RenderUploadPriority uploadPriority = RenderUploadPriority::k_visible) noexcept;
         
         /// Removes the RenderMesh from the manager and queues an UnloadMeshRenderCommand for the
         /// next Render Snapshot stage in the render pipeline. The render command is given ownership
@@ -112,18 +114,6 @@ namespace ChilliSource
     private:
         friend class Application;
         
-        /// A container for information relating to pending LoadMeshRenderCommands, such as the
-        /// index and vertex buffers and the related RenderMesh.
-        ///
-        struct PendingLoadCommand final
-        {
-            RenderMesh* m_renderMesh = nullptr;
-            std::unique_ptr<const u8[]> m_vertexData;
-            u32 m_vertexDataSize = 0;
-            std::unique_ptr<const u8[]> m_indexData;
-            u32 m_indexDataSize = 0;
-        };
-        
         /// A factory method for creating new instances of the system. This must be called by
         /// Application.
         ///
@@ -133,8 +123,12 @@ namespace ChilliSource
         
         RenderMeshManager();
         
-        /// Called during the Render Snapshot stage of the render pipeline. All pending load and
-        /// unload commands are added to the render snapshot.
+        /// Called when the system is initialised.
+        ///
+        void OnInit() noexcept override;
+        
+        /// Called during the Render Snapshot stage of the render pipeline. All pending unload
+        /// commands are added to the render snapshot.
         ///
         /// @param targetType
         ///     Whether the snapshot is for the main screen or an offscreen render target
@@ -145,9 +139,9 @@ namespace ChilliSource
         ///
         void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept override;
         
+        RenderUploadScheduler* m_uploadScheduler = nullptr;
         std::mutex m_mutex;
         ObjectPoolAllocator<RenderMesh> m_renderMeshPool;
-        std::vector<PendingLoadCommand> m_pendingLoadCommands;
         std::vector<UniquePtr<RenderMesh>> m_pendingUnloadCommands;
     };
 }
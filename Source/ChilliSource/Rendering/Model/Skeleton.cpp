@@ -49,6 +49,28 @@ namespace ChilliSource
         }
         
         madwJoints = in_desc.GetJointIndices();
+        
+        //Build the hierarchy order breadth first from the root nodes. Nodes which can't be reached from a root are omitted.
+        m_hierarchyOrder.reserve(mapNodes.size());
+        for (u32 i = 0; i < mapNodes.size(); ++i)
+        {
+            if (mapNodes[i]->mdwParentIndex < 0)
+            {
+                m_hierarchyOrder.push_back(i);
+            }
+        }
+        
+        for (u32 orderIndex = 0; orderIndex < m_hierarchyOrder.size(); ++orderIndex)
+        {
+            s32 parentIndex = s32(m_hierarchyOrder[orderIndex]);
+            for (u32 i = 0; i < mapNodes.size(); ++i)
+            {
+                if (mapNodes[i]->mdwParentIndex == parentIndex)
+                {
+                    m_hierarchyOrder.push_back(i);
+                }
+            }
+        }
     }
     //-------------------------------------------------------------------------
     /// Get Node By Name
@@ -121,4 +143,10 @@ namespace ChilliSource
     {
         return madwJoints;
     }
+    //-------------------------------------------------------------------------
+    //-------------------------------------------------------------------------
+    const std::vector<u32>& Skeleton::GetHierarchyOrder() const
+    {
+        return m_hierarchyOrder;
+    }
 }
@@ -120,11 +120,20 @@ namespace ChilliSource
         /// @return the array of joint indices
         //-------------------------------------------------------------------------
         const std::vector<s32>& GetJointIndices() const;
+        //-------------------------------------------------------------------------
+        /// Returns the indices of every node which is connected to a root node,
+        /// ordered such that each node comes after its parent. This allows the
+        /// hierarchy to be traversed with a single flat loop.
+        ///
+        /// @return The node indices in hierarchy order.
+        //-------------------------------------------------------------------------
+        const std::vector<u32>& GetHierarchyOrder() const;
         
     private:
         
         std::vector<SkeletonNodeCUPtr> mapNodes;
         std::vector<s32> madwJoints;
+        std::vector<u32> m_hierarchyOrder;
     };
 }
 
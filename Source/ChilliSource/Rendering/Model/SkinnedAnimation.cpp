@@ -28,6 +28,8 @@
 
 #include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
 
+#include <ChilliSource/Rendering/Model/CompressedKeyFrames.h>
+
 namespace ChilliSource
 {
     CS_DEFINE_NAMEDTYPE(SkinnedAnimation);
@@ -53,6 +55,7 @@ namespace ChilliSource
     //---------------------------------------------------------------------
     const SkinnedAnimation::Frame* SkinnedAnimation::GetFrameAtIndex(u32 in_index) const
     {
+        CS_ASSERT(m_compressedKeyFrames == nullptr, "Cannot get individual frames from a compressed skinned animation.");
         CS_ASSERT(in_index < m_frames.size(), "Skinned animation frame out of bounds");
         return m_frames[in_index].get();
     }
@@ -66,12 +69,19 @@ namespace ChilliSource
     //---------------------------------------------------------------------
     u32 SkinnedAnimation::GetNumFrames() const
     {
+        if (m_compressedKeyFrames != nullptr)
+        {
+            return m_compressedKeyFrames->GetNumFrames();
+        }
+        
         return static_cast<u32>(m_frames.size());
     }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     void SkinnedAnimation::AddFrame(SkinnedAnimation::FrameCUPtr in_frame)
     {
+        CS_ASSERT(m_compressedKeyFrames == nullptr, "Cannot add frames to a compressed skinned animation.");
+        
         m_frames.push_back(std::move(in_frame));
     }
     //---------------------------------------------------------------------
@@ -80,5 +90,26 @@ namespace ChilliSource
     {
         m_frameTime = in_timeBetweenFrames;
     }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    void SkinnedAnimation::Compress()
+    {
+        CS_ASSERT(m_compressedKeyFrames == nullptr, "Skinned animation has already been compressed.");
+        
+        m_compressedKeyFrames = CompressedKeyFramesCUPtr(new CompressedKeyFrames(m_frames));
+        
+        m_frames.clear();
+        m_frames.shrink_to_fit();
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    const CompressedKeyFrames* SkinnedAnimation::GetCompressedKeyFrames() const
+    {
+        return m_compressedKeyFrames.get();
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    SkinnedAnimation::~SkinnedAnimation()
+    {
+    }
 }
-
@@ -74,6 +74,10 @@ namespace ChilliSource
         //---------------------------------------------------------------------
         bool IsA(InterfaceIDType in_interfaceId) const override;
         //---------------------------------------------------------------------
+        /// The frame data is not available once the animation has been
+        /// compressed; poses should be sampled directly from the animation
+        /// instead.
+        ///
         /// @author Ian Copland
         ///
         /// @param the index to the frame
@@ -110,6 +114,22 @@ namespace ChilliSource
         /// @param The time between frames in seconds
         //---------------------------------------------------------------------
         void SetFrameTime(f32 in_timeBetweenFrames);
+        //---------------------------------------------------------------------
+        /// Replaces the full precision key frames with a quantised
+        /// representation which typically uses a fraction of the memory.
+        /// Once compressed, frames can no longer be added or accessed
+        /// individually, and must instead be decoded into a pose.
+        //---------------------------------------------------------------------
+        void Compress();
+        //---------------------------------------------------------------------
+        /// @return The compressed key frames, or null if the animation has
+        /// not been compressed.
+        //---------------------------------------------------------------------
+        const CompressedKeyFrames* GetCompressedKeyFrames() const;
+        //---------------------------------------------------------------------
+        /// Destructor
+        //---------------------------------------------------------------------
+        ~SkinnedAnimation();
         
     private:
         
@@ -135,6 +155,7 @@ namespace ChilliSource
         
         f32 m_frameTime;
         std::vector<SkinnedAnimation::FrameCUPtr> m_frames;
+        CompressedKeyFramesCUPtr m_compressedKeyFrames;
     };
 }
 
@@ -39,12 +39,9 @@ namespace ChilliSource
     /// Constructor
     //-----------------------------------------------------------
     SkinnedAnimationGroup::SkinnedAnimationGroup(const Skeleton& inpSkeleton)
-    : mpSkeleton(inpSkeleton), mbAnimationLengthDirty(true), mfAnimationLength(0.0f), mbPrepared(false)
+    : mpSkeleton(inpSkeleton), mCurrentPose(u32(inpSkeleton.GetNumNodes())), mBlendPose(u32(inpSkeleton.GetNumNodes())), mKeyFramePose(u32(inpSkeleton.GetNumNodes())),
+    mCurrentAnimationMatrices(inpSkeleton.GetNumNodes()), mbAnimationLengthDirty(true), mfAnimationLength(0.0f), mbPrepared(false)
     {
-        for (s32 i = 0; i < mpSkeleton.GetNumNodes(); ++i)
-        {
-            mCurrentAnimationMatrices.push_back(Matrix4());
-        }
     }
     //----------------------------------------------------------
     /// Attach Animation
@@ -103,38 +100,31 @@ namespace ChilliSource
                 }
             }
             
-            //get the animation frames
-            SkinnedAnimation::FrameCUPtr pFrame1;
-            if (pAnimItem1 != nullptr)
-                pFrame1 = CalculateAnimationFrame(pAnimItem1->pSkinnedAnimation, infPlaybackPosition);
-            
-            SkinnedAnimation::FrameCUPtr pFrame2;
-            if (pAnimItem2 != nullptr)
-                pFrame2 = CalculateAnimationFrame(pAnimItem2->pSkinnedAnimation, infPlaybackPosition);
-            
-            //check that we do indeed have two animations to blend. if not, just return the frame we do have.
-            if (pFrame1 != nullptr && pFrame2 != nullptr && pAnimItem1.get() != pAnimItem2.get())
+            //check that we do indeed have two animations to blend. if not, just use the animation we do have.
+            if (pAnimItem1 != nullptr && pAnimItem2 != nullptr && pAnimItem1.get() != pAnimItem2.get())
             {
-                //get the interpolation factor and then apply the requested blend to the two frames.
+                CalculateAnimationPose(pAnimItem1->pSkinnedAnimation, infPlaybackPosition, mCurrentPose);
+                
+                //get the interpolation factor and then apply the requested blend to the two poses.
                 f32 fFactor = (infBlendlinePosition - pAnimItem1->fBlendlinePosition) / (pAnimItem2->fBlendlinePosition - pAnimItem1->fBlendlinePosition);
                 switch (ineBlendType)
                 {
                     case AnimationBlendType::k_linear:
-                        mCurrentAnimationData = LerpBetweenFrames(pFrame1.get(), pFrame2.get(), fFactor);
+                        CalculateAnimationPose(pAnimItem2->pSkinnedAnimation, infPlaybackPosition, mBlendPose);
+                        mCurrentPose.Blend(mBlendPose, fFactor);
                         break;
                     default:
                         CS_LOG_ERROR("Invalid animation blend type given.");
-                        mCurrentAnimationData = std::move(pFrame1);
                         break;
                 }
             }
-            else if (pFrame1 != nullptr)
+            else if (pAnimItem1 != nullptr)
             {
-                mCurrentAnimationData = std::move(pFrame1);
+                CalculateAnimationPose(pAnimItem1->pSkinnedAnimation, infPlaybackPosition, mCurrentPose);
             }
-            else if (pFrame2 != nullptr)
+            else if (pAnimItem2 != nullptr)
             {
-                mCurrentAnimationData = std::move(pFrame2);
+                CalculateAnimationPose(pAnimItem2->pSkinnedAnimation, infPlaybackPosition, mCurrentPose);
             }
             else 
             {
@@ -146,7 +136,7 @@ namespace ChilliSource
         else if (mAnimations.size() > 0) 
         {
             const SkinnedAnimationCSPtr& pAnim = mAnimations[0]->pSkinnedAnimation;
-            mCurrentAnimationData = CalculateAnimationFrame(pAnim, infPlaybackPosition);
+            CalculateAnimationPose(pAnim, infPlaybackPosition, mCurrentPose);
             mbPrepared = true;
         }
         else
@@ -163,7 +153,7 @@ namespace ChilliSource
         switch (ineBlendType)
         {
             case AnimationBlendType::k_linear:
-                mCurrentAnimationData = LerpBetweenFrames(mCurrentAnimationData.get(), inpAnimationGroup->mCurrentAnimationData.get(), infBlendFactor);
+                mCurrentPose.Blend(inpAnimationGroup->mCurrentPose, infBlendFactor);
                 break;
             default:
                 CS_LOG_ERROR("Invalid animation blend type given.");
@@ -173,30 +163,9 @@ namespace ChilliSource
     //----------------------------------------------------------
     /// Build Matrices
     //----------------------------------------------------------
-    void SkinnedAnimationGroup::BuildMatrices(s32 indwCurrentParent, const Matrix4& inParentMatrix)
+    void SkinnedAnimationGroup::BuildMatrices()
     {
-        const std::vector<SkeletonNodeCUPtr>& nodes = mpSkeleton.GetNodes();
-        u32 currIndex = 0;
-        for (auto it = nodes.begin(); it != nodes.end(); ++it)
-        {
-            if ((*it)->mdwParentIndex == indwCurrentParent)
-            {
-                //get the world translation and orientation
-                Matrix4 localMat;
-                if(mCurrentAnimationData->m_nodeTranslations.empty() == false)
-                {
-                    localMat = Matrix4::CreateTransform(mCurrentAnimationData->m_nodeTranslations[currIndex], mCurrentAnimationData->m_nodeScales[currIndex], mCurrentAnimationData->m_nodeOrientations[currIndex]);
-                }
-                
-                //convert to matrix and store
-                mCurrentAnimationMatrices[currIndex] =  localMat * inParentMatrix;
-                
-                //Apply to all children
-                BuildMatrices(currIndex, mCurrentAnimationMatrices[currIndex]);
-            }
-            
-            currIndex++;
-        }
+        mCurrentPose.BuildMatrices(mpSkeleton, mCurrentAnimationMatrices);
     }
     //----------------------------------------------------------
     /// Get Matrix At Index
@@ -298,9 +267,9 @@ namespace ChilliSource
         }
     }
     //----------------------------------------------------------
-    /// Calculate Animation Frame
+    /// Calculate Animation Pose
     //----------------------------------------------------------
-    SkinnedAnimation::FrameCUPtr SkinnedAnimationGroup::CalculateAnimationFrame(const SkinnedAnimationCSPtr& inpAnimation, f32 infPlaybackPosition)
+    void SkinnedAnimationGroup::CalculateAnimationPose(const SkinnedAnimationCSPtr& inpAnimation, f32 infPlaybackPosition, SkinnedAnimationPose& outPose)
     {
         //report errors if the playback position provided does not make sense
         if (infPlaybackPosition < 0.0f)
@@ -334,78 +303,15 @@ namespace ChilliSource
             dwFrameBIndex = inpAnimation->GetNumFrames() - 1;
         }
         
-        //get the frames
-        const SkinnedAnimation::Frame* frameA = inpAnimation->GetFrameAtIndex(dwFrameAIndex);
-        const SkinnedAnimation::Frame* frameB = inpAnimation->GetFrameAtIndex(dwFrameBIndex);
-        
         //get the ratio of one frame to the next
         f32 interpFactor = (infPlaybackPosition - (dwFrameAIndex * inpAnimation->GetFrameTime())) / inpAnimation->GetFrameTime();
         
-        //blend between frames
-        return LerpBetweenFrames(frameA, frameB, interpFactor);
-    }
-    //--------------------------------------------------------------
-    /// Lerp Between Frames
-    //--------------------------------------------------------------
-    SkinnedAnimation::FrameCUPtr SkinnedAnimationGroup::LerpBetweenFrames(const SkinnedAnimation::Frame* inFrameA, const SkinnedAnimation::Frame* inFrameB, f32 infInterpFactor)
-    {
-        SkinnedAnimation::FrameUPtr outFrame(new SkinnedAnimation::Frame());
-        
-        if(inFrameA != nullptr && inFrameB != nullptr)
+        //blend between frames, decoding them directly from the animation. If both are the same frame there is nothing to blend.
+        outPose.SetFrame(*inpAnimation, u32(dwFrameAIndex));
+        if (dwFrameAIndex != dwFrameBIndex)
         {
-            //iterate through each translation
-            outFrame->m_nodeTranslations.reserve(inFrameB->m_nodeTranslations.size());
-            std::vector<Vector3>::const_iterator transAIt = inFrameA->m_nodeTranslations.begin();
-            for (std::vector<Vector3>::const_iterator transBIt = inFrameB->m_nodeTranslations.begin();
-                 transAIt != inFrameA->m_nodeTranslations.end() && transBIt != inFrameB->m_nodeTranslations.end();)
-            {
-                //lerp
-                Vector3 newTrans = MathUtils::Lerp(infInterpFactor, *transAIt, *transBIt);
-                
-                //add to frame
-                outFrame->m_nodeTranslations.push_back(newTrans);
-                
-                //incriment the iterators
-                ++transAIt;
-                ++transBIt;
-            }
-            
-            //iterate through each orientation
-            outFrame->m_nodeOrientations.reserve(inFrameB->m_nodeOrientations.size());
-            std::vector<Quaternion>::const_iterator orientAIt = inFrameA->m_nodeOrientations.begin();
-            for (std::vector<Quaternion>::const_iterator orientBIt = inFrameB->m_nodeOrientations.begin();
-                 orientAIt != inFrameA->m_nodeOrientations.end() && orientBIt != inFrameB->m_nodeOrientations.end();)
-            {
-                //lerp
-                Quaternion newOrient = Quaternion::Slerp(*orientAIt, *orientBIt, infInterpFactor);
-                
-                //add to frame
-                outFrame->m_nodeOrientations.push_back(newOrient);
-                
-                //incriment the iterators
-                ++orientAIt;
-                ++orientBIt;
-            }
-            
-            //iterate through each scale
-            outFrame->m_nodeScales.reserve(inFrameB->m_nodeScales.size());
-            std::vector<Vector3>::const_iterator scaleAIt = inFrameA->m_nodeScales.begin();
-            for (std::vector<Vector3>::const_iterator scaleBIt = inFrameB->m_nodeScales.begin();
-                 scaleAIt != inFrameA->m_nodeScales.end() && scaleBIt != inFrameB->m_nodeScales.end();)
-            {
-                //lerp
-                Vector3 newScale = MathUtils::Lerp(infInterpFactor, *scaleAIt, *scaleBIt);
-                
-                //add to frame
-                outFrame->m_nodeScales.push_back(newScale);
-                
-                //incriment the iterators
-                ++scaleAIt;
-                ++scaleBIt;
-            }
+            mKeyFramePose.SetFrame(*inpAnimation, u32(dwFrameBIndex));
+            outPose.Blend(mKeyFramePose, interpFactor);
         }
-        
-        return SkinnedAnimation::FrameCUPtr(std::move(outFrame));
     }
 }
-
@@ -34,6 +34,7 @@
 #include <ChilliSource/Core/Math/Matrix4.h>
 #include <ChilliSource/Rendering/Model/RenderSkinnedAnimation.h>
 #include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimationPose.h>
 
 namespace ChilliSource
 {
@@ -88,7 +89,8 @@ namespace ChilliSource
         /// Build Animation Data
         ///
         /// Builds a new set of animation data with the given
-        /// parameters
+        /// parameters. The data is written into a pose which is
+        /// owned by the group, so this doesn't allocate.
         ///
         /// @param The blend type.
         /// @param the playback position.
@@ -110,11 +112,8 @@ namespace ChilliSource
         ///
         /// Builds the animation matrix data from the current
         /// animation data.
-        ///
-        /// @param the current parent.
-        /// @param the parent matrix.
         //----------------------------------------------------------
-        void BuildMatrices(s32 indwCurrentParent = -1, const Matrix4& inParentMatrix = Matrix4());
+        void BuildMatrices();
         //----------------------------------------------------------
         /// Get Matrix At Index
         ///
@@ -188,30 +187,23 @@ namespace ChilliSource
         //----------------------------------------------------------
         void CalculateAnimationLength();
         //----------------------------------------------------------
-        /// Calculate Animation Frame
+        /// Calculate Animation Pose
         ///
-        /// Gets the frame data from a single animation.
+        /// Samples a single animation at the given playback
+        /// position, interpolating between the two nearest key
+        /// frames.
         ///
-        /// @param The blend type.
         /// @param the animation.
         /// @param the playback position.
+        /// @param OUT: The pose the sample is written to.
         //----------------------------------------------------------
-        SkinnedAnimation::FrameCUPtr CalculateAnimationFrame(const SkinnedAnimationCSPtr& inpAnimation, f32 infPlaybackPosition);
-        //--------------------------------------------------------------
-        /// Lerp Between Frames
-        ///
-        /// Linearly interpolates between two animation frames.
-        ///
-        /// @param frame 1
-        /// @param frame 2
-        /// @param the interpolation factor
-        /// @return output interpolated frame.
-        //--------------------------------------------------------------
-        SkinnedAnimation::FrameCUPtr LerpBetweenFrames(const SkinnedAnimation::Frame* inFrameA, const SkinnedAnimation::Frame* inFrameB, f32 infInterpFactor);
+        void CalculateAnimationPose(const SkinnedAnimationCSPtr& inpAnimation, f32 infPlaybackPosition, SkinnedAnimationPose& outPose);
         
         const Skeleton& mpSkeleton;
         std::vector<AnimationItemPtr> mAnimations;
-        SkinnedAnimation::FrameCUPtr mCurrentAnimationData;
+        SkinnedAnimationPose mCurrentPose;
+        SkinnedAnimationPose mBlendPose;
+        SkinnedAnimationPose mKeyFramePose;
         std::vector<Matrix4> mCurrentAnimationMatrices;
         bool mbAnimationLengthDirty;
         f32 mfAnimationLength;
@@ -0,0 +1,329 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Model/SkinnedAnimationPose.h>
+
+#include <ChilliSource/Rendering/Model/CompressedKeyFrames.h>
+#include <ChilliSource/Rendering/Model/Skeleton.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#   define CS_SKINNEDANIMATIONPOSE_USE_SSE
+#   include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define CS_SKINNEDANIMATIONPOSE_USE_NEON
+#   include <arm_neon.h>
+#endif
+
+namespace ChilliSource
+{
+    namespace
+    {
+        constexpr u32 k_laneWidth = 4;
+        
+        /// Linearly interpolates each value in the output range towards the equivalent value
+        /// in the target range.
+        ///
+        /// @param outValues
+        ///     (In/Out) The values which will be interpolated.
+        /// @param targetValues
+        ///     The values to interpolate towards.
+        /// @param numValues
+        ///     The number of values. Must be a multiple of the lane width.
+        /// @param factor
+        ///     The interpolation factor.
+        ///
+        void LerpValues(f32* outValues, const f32* targetValues, u32 numValues, f32 factor) noexcept
+        {
+#if defined(CS_SKINNEDANIMATIONPOSE_USE_SSE)
+            const __m128 t = _mm_set1_ps(factor);
+            for (u32 i = 0; i < numValues; i += k_laneWidth)
+            {
+                __m128 a = _mm_loadu_ps(outValues + i);
+                __m128 b = _mm_loadu_ps(targetValues + i);
+                _mm_storeu_ps(outValues + i, _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a))));
+            }
+#elif defined(CS_SKINNEDANIMATIONPOSE_USE_NEON)
+            const float32x4_t t = vdupq_n_f32(factor);
+            for (u32 i = 0; i < numValues; i += k_laneWidth)
+            {
+                float32x4_t a = vld1q_f32(outValues + i);
+                float32x4_t b = vld1q_f32(targetValues + i);
+                vst1q_f32(outValues + i, vmlaq_f32(a, t, vsubq_f32(b, a)));
+            }
+#else
+            for (u32 i = 0; i < numValues; ++i)
+            {
+                outValues[i] += factor * (targetValues[i] - outValues[i]);
+            }
+#endif
+        }
+        
+        /// Interpolates each of the output quaternions towards the equivalent target quaternion
+        /// along the shortest path, then re-normalises them. The quaternions are stored as
+        /// separate x, y, z and w channels.
+        ///
+        /// @param outChannels
+        ///     (In/Out) The x, y, z and w channels of the quaternions which will be interpolated.
+        /// @param targetChannels
+        ///     The x, y, z and w channels of the quaternions to interpolate towards.
+        /// @param numValues
+        ///     The number of quaternions. Must be a multiple of the lane width.
+        /// @param factor
+        ///     The interpolation factor.
+        ///
+        void NlerpQuaternions(f32* const outChannels[4], const f32* const targetChannels[4], u32 numValues, f32 factor) noexcept
+        {
+#if defined(CS_SKINNEDANIMATIONPOSE_USE_SSE)
+            const __m128 t = _mm_set1_ps(factor);
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            for (u32 i = 0; i < numValues; i += k_laneWidth)
+            {
+                __m128 a[4], b[4];
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    a[c] = _mm_loadu_ps(outChannels[c] + i);
+                    b[c] = _mm_loadu_ps(targetChannels[c] + i);
+                }
+                
+                //flip the target wherever the dot product is negative so the shortest path is taken.
+                __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+                __m128 sign = _mm_and_ps(dot, signMask);
+                
+                __m128 r[4];
+                __m128 lengthSquared = _mm_setzero_ps();
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    r[c] = _mm_add_ps(a[c], _mm_mul_ps(t, _mm_sub_ps(_mm_xor_ps(b[c], sign), a[c])));
+                    lengthSquared = _mm_add_ps(lengthSquared, _mm_mul_ps(r[c], r[c]));
+                }
+                
+                __m128 length = _mm_sqrt_ps(lengthSquared);
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    _mm_storeu_ps(outChannels[c] + i, _mm_div_ps(r[c], length));
+                }
+            }
+#elif defined(CS_SKINNEDANIMATIONPOSE_USE_NEON)
+            const float32x4_t t = vdupq_n_f32(factor);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            for (u32 i = 0; i < numValues; i += k_laneWidth)
+            {
+                float32x4_t a[4], b[4];
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    a[c] = vld1q_f32(outChannels[c] + i);
+                    b[c] = vld1q_f32(targetChannels[c] + i);
+                }
+                
+                //flip the target wherever the dot product is negative so the shortest path is taken.
+                float32x4_t dot = vmulq_f32(a[0], b[0]);
+                dot = vmlaq_f32(dot, a[1], b[1]);
+                dot = vmlaq_f32(dot, a[2], b[2]);
+                dot = vmlaq_f32(dot, a[3], b[3]);
+                uint32x4_t negative = vcltq_f32(dot, zero);
+                
+                float32x4_t r[4];
+                float32x4_t lengthSquared = zero;
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    float32x4_t target = vbslq_f32(negative, vnegq_f32(b[c]), b[c]);
+                    r[c] = vmlaq_f32(a[c], t, vsubq_f32(target, a[c]));
+                    lengthSquared = vmlaq_f32(lengthSquared, r[c], r[c]);
+                }
+                
+                //refine the reciprocal square root estimate with two Newton-Raphson steps.
+                float32x4_t invLength = vrsqrteq_f32(lengthSquared);
+                invLength = vmulq_f32(invLength, vrsqrtsq_f32(vmulq_f32(lengthSquared, invLength), invLength));
+                invLength = vmulq_f32(invLength, vrsqrtsq_f32(vmulq_f32(lengthSquared, invLength), invLength));
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    vst1q_f32(outChannels[c] + i, vmulq_f32(r[c], invLength));
+                }
+            }
+#else
+            for (u32 i = 0; i < numValues; ++i)
+            {
+                f32 dot = outChannels[0][i] * targetChannels[0][i] + outChannels[1][i] * targetChannels[1][i] + outChannels[2][i] * targetChannels[2][i] + outChannels[3][i] * targetChannels[3][i];
+                f32 sign = (dot < 0.0f) ? -1.0f : 1.0f;
+                
+                f32 lengthSquared = 0.0f;
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    outChannels[c][i] += factor * (sign * targetChannels[c][i] - outChannels[c][i]);
+                    lengthSquared += outChannels[c][i] * outChannels[c][i];
+                }
+                
+                f32 invLength = 1.0f / std::sqrt(lengthSquared);
+                for (u32 c = 0; c < 4; ++c)
+                {
+                    outChannels[c][i] *= invLength;
+                }
+            }
+#endif
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    SkinnedAnimationPose::SkinnedAnimationPose(u32 numNodes) noexcept
+        : m_numNodes(numNodes), m_channelSize(((numNodes + k_laneWidth - 1) / k_laneWidth) * k_laneWidth), m_data(k_total * m_channelSize, 0.0f)
+    {
+        //The padding at the end of each channel is also given the identity transform so that it
+        //can be safely blended along with the real nodes.
+        std::fill(GetChannel(k_scaleX), GetChannel(k_orientationX), 1.0f);
+        std::fill(GetChannel(k_orientationW), GetChannel(k_orientationW) + m_channelSize, 1.0f);
+    }
+    
+    //------------------------------------------------------------------------------
+    Vector3 SkinnedAnimationPose::GetTranslation(u32 nodeIndex) const noexcept
+    {
+        CS_ASSERT(nodeIndex < m_numNodes, "Node index out of bounds.");
+        
+        return Vector3(GetChannel(k_translationX)[nodeIndex], GetChannel(k_translationY)[nodeIndex], GetChannel(k_translationZ)[nodeIndex]);
+    }
+    
+    //------------------------------------------------------------------------------
+    Vector3 SkinnedAnimationPose::GetScale(u32 nodeIndex) const noexcept
+    {
+        CS_ASSERT(nodeIndex < m_numNodes, "Node index out of bounds.");
+        
+        return Vector3(GetChannel(k_scaleX)[nodeIndex], GetChannel(k_scaleY)[nodeIndex], GetChannel(k_scaleZ)[nodeIndex]);
+    }
+    
+    //------------------------------------------------------------------------------
+    Quaternion SkinnedAnimationPose::GetOrientation(u32 nodeIndex) const noexcept
+    {
+        CS_ASSERT(nodeIndex < m_numNodes, "Node index out of bounds.");
+        
+        return Quaternion(GetChannel(k_orientationX)[nodeIndex], GetChannel(k_orientationY)[nodeIndex], GetChannel(k_orientationZ)[nodeIndex], GetChannel(k_orientationW)[nodeIndex]);
+    }
+    
+    //------------------------------------------------------------------------------
+    void SkinnedAnimationPose::SetFrame(const SkinnedAnimation::Frame& frame) noexcept
+    {
+        f32* translationX = GetChannel(k_translationX);
+        f32* translationY = GetChannel(k_translationY);
+        f32* translationZ = GetChannel(k_translationZ);
+        u32 numTranslations = std::min(m_numNodes, u32(frame.m_nodeTranslations.size()));
+        for (u32 i = 0; i < m_numNodes; ++i)
+        {
+            const auto& translation = (i < numTranslations) ? frame.m_nodeTranslations[i] : Vector3::k_zero;
+            translationX[i] = translation.x;
+            translationY[i] = translation.y;
+            translationZ[i] = translation.z;
+        }
+        
+        f32* scaleX = GetChannel(k_scaleX);
+        f32* scaleY = GetChannel(k_scaleY);
+        f32* scaleZ = GetChannel(k_scaleZ);
+        u32 numScales = std::min(m_numNodes, u32(frame.m_nodeScales.size()));
+        for (u32 i = 0; i < m_numNodes; ++i)
+        {
+            const auto& scale = (i < numScales) ? frame.m_nodeScales[i] : Vector3::k_one;
+            scaleX[i] = scale.x;
+            scaleY[i] = scale.y;
+            scaleZ[i] = scale.z;
+        }
+        
+        f32* orientationX = GetChannel(k_orientationX);
+        f32* orientationY = GetChannel(k_orientationY);
+        f32* orientationZ = GetChannel(k_orientationZ);
+        f32* orientationW = GetChannel(k_orientationW);
+        u32 numOrientations = std::min(m_numNodes, u32(frame.m_nodeOrientations.size()));
+        for (u32 i = 0; i < m_numNodes; ++i)
+        {
+            const auto& orientation = (i < numOrientations) ? frame.m_nodeOrientations[i] : Quaternion::k_identity;
+            orientationX[i] = orientation.x;
+            orientationY[i] = orientation.y;
+            orientationZ[i] = orientation.z;
+            orientationW[i] = orientation.w;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void SkinnedAnimationPose::SetFrame(const SkinnedAnimation& animation, u32 frameIndex) noexcept
+    {
+        const auto compressedKeyFrames = animation.GetCompressedKeyFrames();
+        if (compressedKeyFrames == nullptr)
+        {
+            SetFrame(*animation.GetFrameAtIndex(frameIndex));
+            return;
+        }
+        
+        f32* const translationChannels[3] = { GetChannel(k_translationX), GetChannel(k_translationY), GetChannel(k_translationZ) };
+        f32* const scaleChannels[3] = { GetChannel(k_scaleX), GetChannel(k_scaleY), GetChannel(k_scaleZ) };
+        f32* const orientationChannels[4] = { GetChannel(k_orientationX), GetChannel(k_orientationY), GetChannel(k_orientationZ), GetChannel(k_orientationW) };
+        compressedKeyFrames->DecodeFrame(frameIndex, m_numNodes, translationChannels, scaleChannels, orientationChannels);
+        
+        for (u32 i = compressedKeyFrames->GetNumNodes(); i < m_numNodes; ++i)
+        {
+            for (u32 c = 0; c < 3; ++c)
+            {
+                translationChannels[c][i] = 0.0f;
+                scaleChannels[c][i] = 1.0f;
+                orientationChannels[c][i] = 0.0f;
+            }
+            orientationChannels[3][i] = 1.0f;
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void SkinnedAnimationPose::Blend(const SkinnedAnimationPose& pose, f32 factor) noexcept
+    {
+        CS_ASSERT(pose.m_numNodes == m_numNodes, "Cannot blend poses with different numbers of nodes.");
+        
+        LerpValues(GetChannel(k_translationX), pose.GetChannel(k_translationX), (k_orientationX - k_translationX) * m_channelSize, factor);
+        
+        f32* const orientationChannels[4] = { GetChannel(k_orientationX), GetChannel(k_orientationY), GetChannel(k_orientationZ), GetChannel(k_orientationW) };
+        const f32* const targetOrientationChannels[4] = { pose.GetChannel(k_orientationX), pose.GetChannel(k_orientationY), pose.GetChannel(k_orientationZ), pose.GetChannel(k_orientationW) };
+        NlerpQuaternions(orientationChannels, targetOrientationChannels, m_channelSize, factor);
+    }
+    
+    //------------------------------------------------------------------------------
+    void SkinnedAnimationPose::BuildMatrices(const Skeleton& skeleton, std::vector<Matrix4>& outMatrices) const noexcept
+    {
+        CS_ASSERT(u32(skeleton.GetNumNodes()) == m_numNodes, "Pose and skeleton have different numbers of nodes.");
+        CS_ASSERT(outMatrices.size() == m_numNodes, "Output matrices must be the same size as the pose.");
+        
+        const auto& nodes = skeleton.GetNodes();
+        
+        //The hierarchy order guarantees that each parent's matrix is built before any of its children.
+        for (auto nodeIndex : skeleton.GetHierarchyOrder())
+        {
+            Matrix4 localMatrix = Matrix4::CreateTransform(GetTranslation(nodeIndex), GetScale(nodeIndex), GetOrientation(nodeIndex));
+            
+            s32 parentIndex = nodes[nodeIndex]->mdwParentIndex;
+            if (parentIndex >= 0)
+            {
+                outMatrices[nodeIndex] = localMatrix * outMatrices[parentIndex];
+            }
+            else
+            {
+                outMatrices[nodeIndex] = localMatrix;
+            }
+        }
+    }
+}
@@ -0,0 +1,161 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_MODEL_SKINNEDANIMATIONPOSE_H_
+#define _CHILLISOURCE_RENDERING_MODEL_SKINNEDANIMATIONPOSE_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    /// The local transform of every node in a skeleton at a single point in an animation.
+    ///
+    /// The pose is stored as a structure of arrays, with a separate channel for each component
+    /// of the translation, scale and orientation, so that poses can be sampled and blended four
+    /// nodes at a time using SSE or NEON where available. The channels are allocated when the
+    /// pose is created, so sampling and blending never allocates.
+    ///
+    /// This is not thread-safe.
+    ///
+    class SkinnedAnimationPose final
+    {
+    public:
+        /// Creates a new pose in which every node has the identity transform.
+        ///
+        /// @param numNodes
+        ///     The number of nodes in the pose.
+        ///
+        SkinnedAnimationPose(u32 numNodes = 0) noexcept;
+        
+        /// @return The number of nodes in the pose.
+        ///
+        u32 GetNumNodes() const noexcept { return m_numNodes; }
+        
+        /// @param nodeIndex
+        ///     The index of the node.
+        ///
+        /// @return The local translation of the node.
+        ///
+        Vector3 GetTranslation(u32 nodeIndex) const noexcept;
+        
+        /// @param nodeIndex
+        ///     The index of the node.
+        ///
+        /// @return The local scale of the node.
+        ///
+        Vector3 GetScale(u32 nodeIndex) const noexcept;
+        
+        /// @param nodeIndex
+        ///     The index of the node.
+        ///
+        /// @return The local orientation of the node.
+        ///
+        Quaternion GetOrientation(u32 nodeIndex) const noexcept;
+        
+        /// Sets the pose to the given key frame. Any nodes which are not described by the frame
+        /// are given the identity transform.
+        ///
+        /// @param frame
+        ///     The key frame.
+        ///
+        void SetFrame(const SkinnedAnimation::Frame& frame) noexcept;
+        
+        /// Sets the pose to the given key frame in the given animation. If the animation is
+        /// compressed the frame is decoded directly into the pose. Any nodes which are not
+        /// described by the animation are given the identity transform.
+        ///
+        /// @param animation
+        ///     The animation.
+        /// @param frameIndex
+        ///     The index of the key frame.
+        ///
+        void SetFrame(const SkinnedAnimation& animation, u32 frameIndex) noexcept;
+        
+        /// Blends the pose towards the given pose. Translations and scales are linearly
+        /// interpolated, while orientations are interpolated along the shortest path and
+        /// re-normalised.
+        ///
+        /// @param pose
+        ///     The pose to blend towards. Must have the same number of nodes as this.
+        /// @param factor
+        ///     The blend factor, where 0 leaves this pose unchanged and 1 results in the
+        ///     given pose.
+        ///
+        void Blend(const SkinnedAnimationPose& pose, f32 factor) noexcept;
+        
+        /// Calculates the transform of each node relative to the root of the skeleton.
+        ///
+        /// @param skeleton
+        ///     The skeleton the pose is for.
+        /// @param outMatrices
+        ///     (Out) The output matrices. This must already be the same size as the pose.
+        ///
+        void BuildMatrices(const Skeleton& skeleton, std::vector<Matrix4>& outMatrices) const noexcept;
+        
+    private:
+        /// The channels which make up the pose. Those which are linearly interpolated are
+        /// placed first so they can be blended in a single pass.
+        ///
+        enum Channel
+        {
+            k_translationX,
+            k_translationY,
+            k_translationZ,
+            k_scaleX,
+            k_scaleY,
+            k_scaleZ,
+            k_orientationX,
+            k_orientationY,
+            k_orientationZ,
+            k_orientationW,
+            k_total
+        };
+        
+        /// @param channel
+        ///     The channel.
+        ///
+        /// @return The start of the given channel.
+        ///
+        f32* GetChannel(Channel channel) noexcept { return m_data.data() + channel * m_channelSize; }
+        
+        /// @param channel
+        ///     The channel.
+        ///
+        /// @return The start of the given channel.
+        ///
+        const f32* GetChannel(Channel channel) const noexcept { return m_data.data() + channel * m_channelSize; }
+        
+        u32 m_numNodes;
+        u32 m_channelSize;
+        std::vector<f32> m_data;
+    };
+}
+
+#endif
@@ -0,0 +1,82 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_MODEL_SKINNEDANIMATIONRESOURCEOPTIONS_H_
+#define _CHILLISOURCE_RENDERING_MODEL_SKINNEDANIMATIONRESOURCEOPTIONS_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Resource/IResourceOptions.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+
+namespace ChilliSource
+{
+    //-------------------------------------------------------
+    /// Custom options for loading a skinned animation.
+    //-------------------------------------------------------
+    class SkinnedAnimationResourceOptions final : public IResourceOptions<SkinnedAnimation>
+    {
+    public:
+        //-------------------------------------------------------
+        /// Constructor
+        //-------------------------------------------------------
+        SkinnedAnimationResourceOptions() = default;
+        //-------------------------------------------------------
+        /// Constructor
+        ///
+        /// @param Whether or not the key frames should be
+        /// compressed after loading. Compressed animations use
+        /// significantly less memory at the cost of a small loss
+        /// of precision.
+        //-------------------------------------------------------
+        SkinnedAnimationResourceOptions(bool in_compressKeyFrames);
+        //-------------------------------------------------------
+        /// Generate a unique hash based on the
+        /// currently set options
+        ///
+        /// @return Hash of the options contents
+        //-------------------------------------------------------
+        u32 GenerateHash() const override;
+        //-------------------------------------------------------
+        /// @return Whether the key frames should be compressed
+        /// after loading.
+        //-------------------------------------------------------
+        bool IsKeyFrameCompressionEnabled() const;
+        
+    private:
+        
+        //-------------------------------------------------------
+        /// The options for loading skinned animations. These are
+        /// held in a struct to more easily allow hashing of the
+        /// data
+        //-------------------------------------------------------
+        struct Options
+        {
+            bool m_compressKeyFrames = false;
+        };
+        
+        Options m_options;
+    };
+}
+
+#endif
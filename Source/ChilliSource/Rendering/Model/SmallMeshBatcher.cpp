@@ -24,6 +24,7 @@
 
 #include <ChilliSource/Rendering/Model/SmallMeshBatcher.h>
 
+#include <ChilliSource/Core/Memory/UniquePtr.h>
 #include <ChilliSource/Rendering/Base/RenderFrameData.h>
 #include <ChilliSource/Rendering/Base/RenderPassObject.h>
 #include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
@@ -31,11 +32,101 @@
 #include <ChilliSource/Rendering/Model/RenderMesh.h>
 #include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
 
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#   define CS_SMALLMESHBATCHER_USE_SSE
+#   include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define CS_SMALLMESHBATCHER_USE_NEON
+#   include <arm_neon.h>
+#endif
+
 namespace ChilliSource
 {
     namespace
     {
         constexpr u32 k_batchVertexCountThreshold = 100;
+        
+        /// Copies the given sprite vertices to the output buffer, transforming the position of each into
+        /// world space with the given matrix. The position is transformed as a row vector, matching
+        /// Vector4::operator*=(const Matrix4&). Where SSE or NEON is available the four matrix rows are
+        /// held in registers and each position is transformed with four vector multiply-adds.
+        ///
+        /// @param inVertices
+        ///     The local space vertices.
+        /// @param numVertices
+        ///     The number of vertices.
+        /// @param worldMatrix
+        ///     The world matrix to transform by.
+        /// @param outVertices
+        ///     [Out] The output buffer. Must not overlap the input.
+        ///
+        void TransformSpriteVertices(const SpriteVertex* inVertices, u32 numVertices, const Matrix4& worldMatrix, SpriteVertex* outVertices) noexcept
+        {
+            std::memcpy(outVertices, inVertices, numVertices * sizeof(SpriteVertex));
+            
+#if defined(CS_SMALLMESHBATCHER_USE_SSE)
+            const __m128 row0 = _mm_loadu_ps(&worldMatrix.m[0]);
+            const __m128 row1 = _mm_loadu_ps(&worldMatrix.m[4]);
+            const __m128 row2 = _mm_loadu_ps(&worldMatrix.m[8]);
+            const __m128 row3 = _mm_loadu_ps(&worldMatrix.m[12]);
+            
+            for (u32 i = 0; i < numVertices; ++i)
+            {
+                const Vector4& position = inVertices[i].m_position;
+                
+                __m128 result = _mm_mul_ps(_mm_set1_ps(position.x), row0);
+                result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(position.y), row1));
+                result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(position.z), row2));
+                result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(position.w), row3));
+                
+                _mm_storeu_ps(&outVertices[i].m_position.x, result);
+            }
+#elif defined(CS_SMALLMESHBATCHER_USE_NEON)
+            const float32x4_t row0 = vld1q_f32(&worldMatrix.m[0]);
+            const float32x4_t row1 = vld1q_f32(&worldMatrix.m[4]);
+            const float32x4_t row2 = vld1q_f32(&worldMatrix.m[8]);
+            const float32x4_t row3 = vld1q_f32(&worldMatrix.m[12]);
+            
+            for (u32 i = 0; i < numVertices; ++i)
+            {
+                const Vector4& position = inVertices[i].m_position;
+                
+                float32x4_t result = vmulq_n_f32(row0, position.x);
+                result = vmlaq_n_f32(result, row1, position.y);
+                result = vmlaq_n_f32(result, row2, position.z);
+                result = vmlaq_n_f32(result, row3, position.w);
+                
+                vst1q_f32(&outVertices[i].m_position.x, result);
+            }
+#else
+            for (u32 i = 0; i < numVertices; ++i)
+            {
+                outVertices[i].m_position = inVertices[i].m_position * worldMatrix;
+            }
+#endif
+        }
+        
+        /// Copies the given short indices to the output buffer, offsetting each by the given
+        /// amount.
+        ///
+        /// @param inIndices
+        ///     The source indices.
+        /// @param numIndices
+        ///     The number of indices.
+        /// @param vertexOffset
+        ///     The offset which should be applied to each index.
+        /// @param outIndices
+        ///     [Out] The output buffer. Must not overlap the input.
+        ///
+        void OffsetIndices(const u16* inIndices, u32 numIndices, u32 vertexOffset, u16* outIndices) noexcept
+        {
+            for (u32 i = 0; i < numIndices; ++i)
+            {
+                outIndices[i] = u16(inIndices[i] + vertexOffset);
+            }
+        }
     }
     
     //------------------------------------------------------------------------------
@@ -62,9 +153,11 @@ namespace ChilliSource
     }
 
     //------------------------------------------------------------------------------
-    SmallMeshBatcher::SmallMeshBatcher(RenderCommandList* renderCommandList) noexcept
-        : m_renderCommandList(renderCommandList)
+    SmallMeshBatcher::SmallMeshBatcher(RenderCommandList* renderCommandList, IAllocator* frameAllocator) noexcept
+        : m_renderCommandList(renderCommandList), m_frameAllocator(frameAllocator)
     {
+        CS_ASSERT(m_renderCommandList, "Must supply a render command list.");
+        CS_ASSERT(m_frameAllocator, "Must supply a frame allocator.");
     }
 
     //------------------------------------------------------------------------------
@@ -83,18 +176,54 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void SmallMeshBatcher::Flush() noexcept
     {
-        if (!m_currentMeshes.empty())
+        if (!m_currentObjects.empty())
         {
-            auto renderMeshBatch = RenderMeshBatchUPtr(new RenderMeshBatch(m_currentPolygonType, m_currentVertexFormat, m_currentIndexFormat, std::move(m_currentMeshes)));
+            CS_ASSERT(m_currentVertexFormat == VertexFormat::k_sprite, "Unsupported vertex format.");
+            CS_ASSERT(!m_hasIndices || m_currentIndexFormat == IndexFormat::k_short, "Only short indices are supported at the moment.");
+            
+            auto vertexData = MakeUniqueArray<u8>(*m_frameAllocator, m_currentVertexDataSize);
+            auto combinedVertices = reinterpret_cast<SpriteVertex*>(vertexData.get());
+            
+            UniquePtr<u8[]> indexData;
+            u16* combinedIndices = nullptr;
+            if (m_hasIndices)
+            {
+                indexData = MakeUniqueArray<u8>(*m_frameAllocator, m_currentIndexDataSize);
+                combinedIndices = reinterpret_cast<u16*>(indexData.get());
+            }
+            
+            u32 vertexOffset = 0;
+            u32 indexOffset = 0;
+            for (const auto renderPassObject : m_currentObjects)
+            {
+                auto renderDynamicMesh = renderPassObject->GetRenderDynamicMesh();
+                
+                auto meshVertices = reinterpret_cast<const SpriteVertex*>(renderDynamicMesh->GetVertexData());
+                TransformSpriteVertices(meshVertices, renderDynamicMesh->GetNumVertices(), renderPassObject->GetWorldMatrix(), combinedVertices + vertexOffset);
+                
+                if (m_hasIndices)
+                {
+                    auto meshIndices = reinterpret_cast<const u16*>(renderDynamicMesh->GetIndexData());
+                    OffsetIndices(meshIndices, renderDynamicMesh->GetNumIndices(), vertexOffset, combinedIndices + indexOffset);
+                    indexOffset += renderDynamicMesh->GetNumIndices();
+                }
+                
+                vertexOffset += renderDynamicMesh->GetNumVertices();
+            }
+            
+            auto renderMeshBatch = RenderMeshBatchUPtr(new RenderMeshBatch(m_currentPolygonType, m_currentVertexFormat, m_currentIndexFormat, m_currentNumVertices, m_currentNumIndices,
+                                                                           std::move(vertexData), m_currentVertexDataSize, std::move(indexData), m_currentIndexDataSize));
             
             m_renderCommandList->AddApplyMeshBatchCommand(std::move(renderMeshBatch));
             m_renderCommandList->AddRenderInstanceCommand(Matrix4::k_identity);
             
+            m_currentObjects.clear();
+            m_currentNumVertices = 0;
+            m_currentNumIndices = 0;
             m_currentVertexDataSize = 0;
             m_currentIndexDataSize = 0;
         }
     }
-    
     //------------------------------------------------------------------------------
     bool SmallMeshBatcher::TryUpdateRenderState(const RenderPassObject& renderPassObject) noexcept
     {
@@ -145,9 +274,7 @@ namespace ChilliSource
         
         u32 numVertices = 0;
         u32 numIndices = 0;
-        const u8* vertexData = nullptr;
         u32 vertexDataSize = 0;
-        const u8* indexData = nullptr;
         u32 indexDataSize = 0;
         
         switch (renderPassObject.GetType())
@@ -159,9 +286,7 @@ namespace ChilliSource
                 
                 numVertices = renderDynamicMesh->GetNumVertices();
                 numIndices = renderDynamicMesh->GetNumIndices();
-                vertexData = renderDynamicMesh->GetVertexData();
                 vertexDataSize = renderDynamicMesh->GetVertexDataSize();
-                indexData = renderDynamicMesh->GetIndexData();
                 indexDataSize = renderDynamicMesh->GetIndexDataSize();
                 break;
             }
@@ -175,14 +300,16 @@ namespace ChilliSource
             Flush();
         }
         
+        m_currentNumVertices += numVertices;
+        m_currentNumIndices += numIndices;
         m_currentVertexDataSize += vertexDataSize;
         m_currentIndexDataSize += indexDataSize;
-        m_currentMeshes.push_back(RenderMeshBatch::Mesh(renderPassObject.GetWorldMatrix(), numVertices, numIndices, vertexData, vertexDataSize, indexData, indexDataSize));
+        m_currentObjects.push_back(&renderPassObject);
     }
 
     //------------------------------------------------------------------------------
     SmallMeshBatcher::~SmallMeshBatcher() noexcept
     {
-        CS_ASSERT(m_currentMeshes.empty(), "Deleting small mesh batcher without flushing.");
+        CS_ASSERT(m_currentObjects.empty(), "Deleting small mesh batcher without flushing.");
     }
 }
\ No newline at end of file
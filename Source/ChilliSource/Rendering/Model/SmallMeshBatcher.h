@@ -39,10 +39,12 @@ namespace ChilliSource
     /// that are performed. This is primarily for sprites and UI elements, but it will also batch
     /// static meshes under a certain vertex count.
     ///
-    /// This works by converting combining all of the meshes together into a single vertex and index
-    /// buffer. The vertex data will be converted into world space, and the index data will be offset
-    /// to the updated position of the vertex data in the buffer. This is an expensive operation, so
-    /// it should only be applied to small meshes.
+    /// This works by combining all of the meshes together into a single vertex and index buffer,
+    /// allocated from the frame allocator. The vertex data will be converted into world space, and
+    /// the index data will be offset to the updated position of the vertex data in the buffer. This
+    /// happens when the batch is flushed, during render command compilation on the worker threads,
+    /// so the render thread only has to upload the combined buffers. This is an expensive operation,
+    /// so it should only be applied to small meshes.
     ///
     /// Only objects of the same mesh type can be batched. When a new mesh type is encountered the
     /// current mesh batch is flushed and a new batch started. Flushing applies the dynamic mesh and
@@ -70,8 +72,11 @@ namespace ChilliSource
         ///
         /// @param renderCommandList
         ///     The render command list commands should be added to.
+        /// @param frameAllocator
+        ///     The allocator from which the combined mesh data will be allocated. This must be thread-safe
+        ///     and must outlive the render command list.
         ///
-        SmallMeshBatcher(RenderCommandList* renderCommandList) noexcept;
+        SmallMeshBatcher(RenderCommandList* renderCommandList, IAllocator* frameAllocator) noexcept;
         
         /// Adds the given render pass object to the batch. If the object contains a different mesh type
         /// than the current batch, the batch will first be flushed. If the render pass object cannot be
@@ -82,7 +87,8 @@ namespace ChilliSource
         ///
         void Batch(const RenderPassObject& renderPassObject) noexcept;
         
-        /// Flushes the batch, adding the appropriate commands to the renderCommandList.
+        /// Flushes the batch, combining the batched meshes into a single world space mesh and adding the
+        /// appropriate commands to the renderCommandList.
         ///
         void Flush() noexcept;
         
@@ -107,12 +113,15 @@ namespace ChilliSource
         void AddToBatch(const RenderPassObject& renderPassObject) noexcept;
         
         RenderCommandList* m_renderCommandList;
+        IAllocator* m_frameAllocator;
         
         PolygonType m_currentPolygonType = PolygonType::k_triangle;
         VertexFormat m_currentVertexFormat = VertexFormat::k_staticMesh;
         IndexFormat m_currentIndexFormat = IndexFormat::k_short;
         bool m_hasIndices = false;
-        std::vector<RenderMeshBatch::Mesh> m_currentMeshes;
+        std::vector<const RenderPassObject*> m_currentObjects;
+        u32 m_currentNumVertices = 0;
+        u32 m_currentNumIndices = 0;
         u32 m_currentVertexDataSize = 0;
         u32 m_currentIndexDataSize = 0;
     };
@@ -209,6 +209,7 @@ namespace ChilliSource
         
         m_oobb.SetSize(m_model->GetAABB().GetSize());
         m_oobb.SetOrigin(m_model->GetAABB().GetOrigin());
+        InvalidateVolume();
         
         SetMaterial(GetMaterialForMesh(0));
     }
@@ -226,6 +227,7 @@ namespace ChilliSource
         
         m_oobb.SetSize(m_model->GetAABB().GetSize());
         m_oobb.SetOrigin(m_model->GetAABB().GetOrigin());
+        InvalidateVolume();
         
         SetMaterial(material);
     }
@@ -250,6 +252,7 @@ namespace ChilliSource
         
         m_oobb.SetSize(m_model->GetAABB().GetSize());
         m_oobb.SetOrigin(m_model->GetAABB().GetOrigin());
+        InvalidateVolume();
     }
     
     //------------------------------------------------------------------------------
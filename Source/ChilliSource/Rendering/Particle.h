@@ -32,9 +32,10 @@
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Rendering/Particle/CSParticleProvider.h>
 #include <ChilliSource/Rendering/Particle/ConcurrentParticleData.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffectComponent.h>
+#include <ChilliSource/Rendering/Particle/ParticleUpdateScheduler.h>
 #include <ChilliSource/Rendering/Particle/Affector/AccelerationParticleAffector.h>
 #include <ChilliSource/Rendering/Particle/Affector/AccelerationParticleAffectorDef.h>
 #include <ChilliSource/Rendering/Particle/Affector/AngularAccelerationParticleAffector.h>
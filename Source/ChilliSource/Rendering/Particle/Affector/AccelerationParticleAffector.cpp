@@ -29,7 +29,7 @@
 #include <ChilliSource/Rendering/Particle/Affector/AccelerationParticleAffector.h>
 
 #include <ChilliSource/Core/Math/MathUtils.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
 #include <ChilliSource/Rendering/Particle/Affector/AccelerationParticleAffectorDef.h>
 
@@ -37,8 +37,9 @@ namespace ChilliSource
 {
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    AccelerationParticleAffector::AccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray)
-        : ParticleAffector(in_affectorDef, in_particleArray), m_particleAcceleration(in_particleArray->size())
+    AccelerationParticleAffector::AccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray)
+        : ParticleAffector(in_affectorDef, in_particleArray), m_particleAccelerationX(in_particleArray->GetCapacity()),
+        m_particleAccelerationY(in_particleArray->GetCapacity()), m_particleAccelerationZ(in_particleArray->GetCapacity())
     {
         //This can only be created by the AccelerationParticleAffectorDef so this is safe.
         m_accelerationAffectorDef = static_cast<const AccelerationParticleAffectorDef*>(in_affectorDef);
@@ -47,21 +48,44 @@ namespace ChilliSource
     //----------------------------------------------------------------
     void AccelerationParticleAffector::ActivateParticle(u32 in_index, f32 in_effectProgress)
     {
-        CS_ASSERT(in_index >= 0 && in_index < m_particleAcceleration.size(), "Index out of bounds!");
+        CS_ASSERT(in_index >= 0 && in_index < m_particleAccelerationX.size(), "Index out of bounds!");
 
-        m_particleAcceleration[in_index] = m_accelerationAffectorDef->GetAccelerationProperty()->GenerateValue(in_effectProgress);
+        auto acceleration = m_accelerationAffectorDef->GetAccelerationProperty()->GenerateValue(in_effectProgress);
+        m_particleAccelerationX[in_index] = acceleration.x;
+        m_particleAccelerationY[in_index] = acceleration.y;
+        m_particleAccelerationZ[in_index] = acceleration.z;
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void AccelerationParticleAffector::AffectParticles(f32 in_deltaTime, f32 in_effectProgress)
+    void AccelerationParticleAffector::MoveParticle(u32 in_fromIndex, u32 in_toIndex)
     {
-        dynamic_array<Particle>* particleArray = GetParticleArray();
-        for (u32 i = 0; i < particleArray->size(); ++i)
-        {
-            Particle& particle = particleArray->at(i);
-            Vector3& acceleration = m_particleAcceleration[i];
+        m_particleAccelerationX[in_toIndex] = m_particleAccelerationX[in_fromIndex];
+        m_particleAccelerationY[in_toIndex] = m_particleAccelerationY[in_fromIndex];
+        m_particleAccelerationZ[in_toIndex] = m_particleAccelerationZ[in_fromIndex];
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void AccelerationParticleAffector::AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress)
+    {
+        ParticleArray* particleArray = GetParticleArray();
+        f32* velocitiesX = particleArray->GetVelocitiesX();
+        f32* velocitiesY = particleArray->GetVelocitiesY();
+        f32* velocitiesZ = particleArray->GetVelocitiesZ();
+        const f32* accelerationsX = m_particleAccelerationX.data();
+        const f32* accelerationsY = m_particleAccelerationY.data();
+        const f32* accelerationsZ = m_particleAccelerationZ.data();
 
-            particle.m_velocity += acceleration * in_deltaTime;
+        for (u32 i = in_startIndex; i < in_endIndex; ++i)
+        {
+            velocitiesX[i] += accelerationsX[i] * in_deltaTime;
+        }
+        for (u32 i = in_startIndex; i < in_endIndex; ++i)
+        {
+            velocitiesY[i] += accelerationsY[i] * in_deltaTime;
+        }
+        for (u32 i = in_startIndex; i < in_endIndex; ++i)
+        {
+            velocitiesZ[i] += accelerationsZ[i] * in_deltaTime;
         }
     }
 }
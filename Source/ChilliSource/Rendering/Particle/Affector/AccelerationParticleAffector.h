@@ -56,15 +56,25 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void ActivateParticle(u32 in_index, f32 in_effectProgress) override;
         //----------------------------------------------------------------
+        /// Moves the acceleration of the particle at the given index to
+        /// another index.
+        ///
+        /// @param The index to move from.
+        /// @param The index to move to.
+        //----------------------------------------------------------------
+        void MoveParticle(u32 in_fromIndex, u32 in_toIndex) override;
+        //----------------------------------------------------------------
         /// Accelerates all active particles.
         ///
         /// @author Ian Copland
         ///
+        /// @param The index of the first particle to affect.
+        /// @param The index one past the last particle to affect.
         /// @param The delta time.
         /// @param The current normalised (0.0 to 1.0) progress through
         /// playback of the particle effect.
         //----------------------------------------------------------------
-        void AffectParticles(f32 in_deltaTime, f32 in_effectProgress) override;
+        void AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress) override;
         //----------------------------------------------------------------
         /// Destructor
         ///
@@ -81,10 +91,12 @@ namespace ChilliSource
         /// @param The particle affector definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        AccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray);
+        AccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray);
 
         const AccelerationParticleAffectorDef* m_accelerationAffectorDef = nullptr;
-        dynamic_array<Vector3> m_particleAcceleration;
+        dynamic_array<f32> m_particleAccelerationX;
+        dynamic_array<f32> m_particleAccelerationY;
+        dynamic_array<f32> m_particleAccelerationZ;
     };
 }
 
@@ -63,7 +63,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ParticleAffectorUPtr AccelerationParticleAffectorDef::CreateInstance(dynamic_array<Particle>* in_particleArray) const
+    ParticleAffectorUPtr AccelerationParticleAffectorDef::CreateInstance(ParticleArray* in_particleArray) const
     {
         return ParticleAffectorUPtr(new AccelerationParticleAffector(this, in_particleArray));
     }
@@ -29,7 +29,7 @@
 #include <ChilliSource/Rendering/Particle/Affector/AngularAccelerationParticleAffector.h>
 
 #include <ChilliSource/Core/Math/MathUtils.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
 #include <ChilliSource/Rendering/Particle/Affector/AngularAccelerationParticleAffectorDef.h>
 
@@ -37,8 +37,8 @@ namespace ChilliSource
 {
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    AngularAccelerationParticleAffector::AngularAccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray)
-        : ParticleAffector(in_affectorDef, in_particleArray), m_particleAngularAcceleration(in_particleArray->size())
+    AngularAccelerationParticleAffector::AngularAccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray)
+        : ParticleAffector(in_affectorDef, in_particleArray), m_particleAngularAcceleration(in_particleArray->GetCapacity())
     {
         //This can only be created by the AngularAccelerationParticleAffectorDef so this is safe.
         m_angularAccelerationAffectorDef = static_cast<const AngularAccelerationParticleAffectorDef*>(in_affectorDef);
@@ -53,14 +53,21 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void AngularAccelerationParticleAffector::AffectParticles(f32 in_deltaTime, f32 in_effectProgress)
+    void AngularAccelerationParticleAffector::MoveParticle(u32 in_fromIndex, u32 in_toIndex)
     {
-        dynamic_array<Particle>* particleArray = GetParticleArray();
-        for (u32 i = 0; i < particleArray->size(); ++i)
+        m_particleAngularAcceleration[in_toIndex] = m_particleAngularAcceleration[in_fromIndex];
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void AngularAccelerationParticleAffector::AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress)
+    {
+        ParticleArray* particleArray = GetParticleArray();
+        f32* angularVelocities = particleArray->GetAngularVelocities();
+        const f32* angularAccelerations = m_particleAngularAcceleration.data();
+
+        for (u32 i = in_startIndex; i < in_endIndex; ++i)
         {
-            Particle& particle = particleArray->at(i);
-            f32 angularAcceleration = m_particleAngularAcceleration[i];
-            particle.m_angularVelocity += angularAcceleration * in_deltaTime;
+            angularVelocities[i] += angularAccelerations[i] * in_deltaTime;
         }
     }
 }
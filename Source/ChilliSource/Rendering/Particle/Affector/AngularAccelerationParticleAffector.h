@@ -56,15 +56,25 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void ActivateParticle(u32 in_index, f32 in_effectProgress) override;
         //----------------------------------------------------------------
+        /// Moves the angular acceleration of the particle at the given index to
+        /// another index.
+        ///
+        /// @param The index to move from.
+        /// @param The index to move to.
+        //----------------------------------------------------------------
+        void MoveParticle(u32 in_fromIndex, u32 in_toIndex) override;
+        //----------------------------------------------------------------
         /// Angularly accelerates each active particle.
         ///
         /// @author Ian Copland
         ///
+        /// @param The index of the first particle to affect.
+        /// @param The index one past the last particle to affect.
         /// @param The delta time.
         /// @param The current normalised (0.0 to 1.0) progress through
         /// playback of the particle effect.
         //----------------------------------------------------------------
-        void AffectParticles(f32 in_deltaTime, f32 in_effectProgress) override;
+        void AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress) override;
         //----------------------------------------------------------------
         /// Destructor
         ///
@@ -81,7 +91,7 @@ namespace ChilliSource
         /// @param The particle affector definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        AngularAccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray);
+        AngularAccelerationParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray);
 
         const AngularAccelerationParticleAffectorDef* m_angularAccelerationAffectorDef = nullptr;
         dynamic_array<f32> m_particleAngularAcceleration;
@@ -63,7 +63,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ParticleAffectorUPtr AngularAccelerationParticleAffectorDef::CreateInstance(dynamic_array<Particle>* in_particleArray) const
+    ParticleAffectorUPtr AngularAccelerationParticleAffectorDef::CreateInstance(ParticleArray* in_particleArray) const
     {
         return ParticleAffectorUPtr(new AngularAccelerationParticleAffector(this, in_particleArray));
     }
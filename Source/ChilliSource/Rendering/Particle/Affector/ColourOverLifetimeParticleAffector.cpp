@@ -29,7 +29,7 @@
 #include <ChilliSource/Rendering/Particle/Affector/ColourOverLifetimeParticleAffector.h>
 
 #include <ChilliSource/Core/Math/MathUtils.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
 #include <ChilliSource/Rendering/Particle/Affector/ColourOverLifetimeParticleAffectorDef.h>
 
@@ -52,13 +52,13 @@ namespace ChilliSource
     
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ColourOverLifetimeParticleAffector::ColourOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray)
+    ColourOverLifetimeParticleAffector::ColourOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray)
     :ParticleAffector(in_affectorDef, in_particleArray)
     ,m_particleColourData(0)
     {
         m_colourOverLifetimeAffectorDef = static_cast<const ColourOverLifetimeParticleAffectorDef*>(in_affectorDef);
         m_intermediateParticles = static_cast<u32>(m_colourOverLifetimeAffectorDef->GetIntermediateColours().size());
-        m_particleColourData = dynamic_array<ColourData>(in_particleArray->size() * (2 + m_intermediateParticles));
+        m_particleColourData = dynamic_array<ColourData>(in_particleArray->GetCapacity() * (2 + m_intermediateParticles));
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
@@ -68,10 +68,9 @@ namespace ChilliSource
         CS_ASSERT(colourDataIndex >= 0 && colourDataIndex < m_particleColourData.size(), "colourDataIndex out of bounds!");
         
         ColourData& colourDataInitial = m_particleColourData[colourDataIndex];
-        const Particle& particle = GetParticleArray()->at(in_index);
         
         colourDataInitial.m_time = 0.0f;
-        colourDataInitial.m_colour = particle.m_colour;
+        colourDataInitial.m_colour = GetParticleArray()->GetColour(in_index);
         ++colourDataIndex;
         
         // Get the intermediate colours
@@ -104,34 +103,46 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void ColourOverLifetimeParticleAffector::AffectParticles(f32 in_deltaTime, f32 in_effectProgress)
+    void ColourOverLifetimeParticleAffector::MoveParticle(u32 in_fromIndex, u32 in_toIndex)
+    {
+        u32 stride = 2 + m_intermediateParticles;
+        std::copy(m_particleColourData.begin() + in_fromIndex * stride, m_particleColourData.begin() + (in_fromIndex + 1) * stride, m_particleColourData.begin() + in_toIndex * stride);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ColourOverLifetimeParticleAffector::AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress)
     {
         const auto& interpolation = m_colourOverLifetimeAffectorDef->GetInterpolation();
         
-        dynamic_array<Particle>* particleArray = GetParticleArray();
-        for (u32 i = 0; i < particleArray->size(); ++i)
+        ParticleArray* particleArray = GetParticleArray();
+        const f32* energies = particleArray->GetEnergies();
+        const f32* lifetimes = particleArray->GetLifetimes();
+        f32* coloursR = particleArray->GetColoursR();
+        f32* coloursG = particleArray->GetColoursG();
+        f32* coloursB = particleArray->GetColoursB();
+        f32* coloursA = particleArray->GetColoursA();
+
+        for (u32 i = in_startIndex; i < in_endIndex; ++i)
         {
-            Particle& particle = particleArray->at(i);
-            
-            if(particle.m_isActive == false)
-            {
-                continue;
-            }
-            
             u32 colourIndex = i * (2 + m_intermediateParticles);
             ColourData& colourDataInitial = m_particleColourData[colourIndex];
 
-            f32 normalisedLifeProgress = 1.0f - (particle.m_energy / particle.m_lifetime);
+            f32 normalisedLifeProgress = 1.0f - (energies[i] / lifetimes[i]);
             f32 progress = interpolation(normalisedLifeProgress);
             
-            particle.m_colour = colourDataInitial.m_colour;
+            Colour colour = colourDataInitial.m_colour;
             for(u32 offset = 0; offset < m_intermediateParticles + 1; ++offset)
             {
                 ColourData& colourData = m_particleColourData[colourIndex + offset];
                 ColourData& colourDataNext = m_particleColourData[colourIndex + offset + 1];
                 f32 timeProgress = Clamp(Clamp(progress - colourData.m_time) / (colourDataNext.m_time - colourData.m_time));
-                particle.m_colour += (colourDataNext.m_colour - colourData.m_colour) * timeProgress;
+                colour += (colourDataNext.m_colour - colourData.m_colour) * timeProgress;
             }
+
+            coloursR[i] = colour.r;
+            coloursG[i] = colour.g;
+            coloursB[i] = colour.b;
+            coloursA[i] = colour.a;
         }
     }
 }
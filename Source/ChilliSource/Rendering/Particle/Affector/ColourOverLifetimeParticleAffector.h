@@ -58,15 +58,25 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void ActivateParticle(u32 in_index, f32 in_effectProgress) override;
         //----------------------------------------------------------------
+        /// Moves the colour data of the particle at the given index to
+        /// another index.
+        ///
+        /// @param The index to move from.
+        /// @param The index to move to.
+        //----------------------------------------------------------------
+        void MoveParticle(u32 in_fromIndex, u32 in_toIndex) override;
+        //----------------------------------------------------------------
         /// Updates the colour of each particle.
         ///
         /// @author Ian Copland
         ///
+        /// @param The index of the first particle to affect.
+        /// @param The index one past the last particle to affect.
         /// @param The delta time.
         /// @param The current normalised (0.0 to 1.0) progress through
         /// playback of the particle effect.
         //----------------------------------------------------------------
-        void AffectParticles(f32 in_deltaTime, f32 in_effectProgress) override;
+        void AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress) override;
         //----------------------------------------------------------------
         /// Destructor
         ///
@@ -94,7 +104,7 @@ namespace ChilliSource
         /// @param The particle affector definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        ColourOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray);
+        ColourOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray);
         
     private:
         const ColourOverLifetimeParticleAffectorDef* m_colourOverLifetimeAffectorDef = nullptr;
@@ -109,7 +109,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ParticleAffectorUPtr ColourOverLifetimeParticleAffectorDef::CreateInstance(dynamic_array<Particle>* in_particleArray) const
+    ParticleAffectorUPtr ColourOverLifetimeParticleAffectorDef::CreateInstance(ParticleArray* in_particleArray) const
     {
         return ParticleAffectorUPtr(new ColourOverLifetimeParticleAffector(this, in_particleArray));
     }
@@ -53,7 +53,7 @@ namespace ChilliSource
         /// @param The particle affector definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        ParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray);
+        ParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray);
         //----------------------------------------------------------------
         /// Activates the particle with the given index.
         ///
@@ -67,17 +67,35 @@ namespace ChilliSource
         //----------------------------------------------------------------
         virtual void ActivateParticle(u32 in_index, f32 in_effectProgress) = 0;
         //----------------------------------------------------------------
-        /// Applies the affect to each of the active particles.
+        /// Moves any per particle data for the particle at the given index
+        /// to another, lower, index. This is called when particles die and
+        /// the remaining particles are moved down to close the gaps, so
+        /// that affector data stays in step with the particle array.
         ///
         /// This will be called on a background thread.
         ///
+        /// @param The index of the particle being moved.
+        /// @param The index it is being moved to.
+        //----------------------------------------------------------------
+        virtual void MoveParticle(u32 in_fromIndex, u32 in_toIndex) = 0;
+        //----------------------------------------------------------------
+        /// Applies the affect to each of the live particles in the given
+        /// range.
+        ///
+        /// This will be called on a background thread. Large effects are
+        /// split across multiple tasks, so this can be called concurrently
+        /// for different ranges of the same particle array. Only data for
+        /// particles within the range should be touched.
+        ///
         /// @author Ian Copland
         ///
+        /// @param The index of the first particle to affect.
+        /// @param The index one past the last particle to affect.
         /// @param The delta time.
         /// @param The current normalised (0.0 to 1.0) progress through
         /// playback of the particle effect.
         //----------------------------------------------------------------
-        virtual void AffectParticles(f32 in_deltaTime, f32 in_effectProgress) = 0;
+        virtual void AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress) = 0;
         //----------------------------------------------------------------
         /// Destructor
         ///
@@ -96,11 +114,11 @@ namespace ChilliSource
         ///
         /// @return The particle array.
         //----------------------------------------------------------------
-        dynamic_array<Particle>* GetParticleArray() const;
+        ParticleArray* GetParticleArray() const;
     private:
 
         const ParticleAffectorDef* m_affectorDef = nullptr;
-        dynamic_array<Particle>* m_particleArray = nullptr;
+        ParticleArray* m_particleArray = nullptr;
     };
 }
 
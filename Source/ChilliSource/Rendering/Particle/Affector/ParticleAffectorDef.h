@@ -79,7 +79,7 @@ namespace ChilliSource
         ///
         /// @return the instance.
         //----------------------------------------------------------------
-        virtual ParticleAffectorUPtr CreateInstance(dynamic_array<Particle>* in_particleArray) const = 0;
+        virtual ParticleAffectorUPtr CreateInstance(ParticleArray* in_particleArray) const = 0;
         //----------------------------------------------------------------
         /// @author Ian Copland
         ///
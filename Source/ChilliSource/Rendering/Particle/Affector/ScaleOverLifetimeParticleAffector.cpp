@@ -29,7 +29,7 @@
 #include <ChilliSource/Rendering/Particle/Affector/ScaleOverLifetimeParticleAffector.h>
 
 #include <ChilliSource/Core/Math/MathUtils.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
 #include <ChilliSource/Rendering/Particle/Affector/ScaleOverLifetimeParticleAffectorDef.h>
 
@@ -37,8 +37,9 @@ namespace ChilliSource
 {
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ScaleOverLifetimeParticleAffector::ScaleOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray)
-        : ParticleAffector(in_affectorDef, in_particleArray), m_particleScaleData(in_particleArray->size())
+    ScaleOverLifetimeParticleAffector::ScaleOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray)
+        : ParticleAffector(in_affectorDef, in_particleArray), m_particleInitialScalesX(in_particleArray->GetCapacity()),
+        m_particleInitialScalesY(in_particleArray->GetCapacity()), m_particleScaleDeltasX(in_particleArray->GetCapacity()), m_particleScaleDeltasY(in_particleArray->GetCapacity())
     {
         //This can only be created by the ScaleOverLifetimeParticleAffectorDef so this is safe.
         m_scaleOverLifetimeAffectorDef = static_cast<const ScaleOverLifetimeParticleAffectorDef*>(in_affectorDef);
@@ -47,27 +48,44 @@ namespace ChilliSource
     //----------------------------------------------------------------
     void ScaleOverLifetimeParticleAffector::ActivateParticle(u32 in_index, f32 in_effectProgress)
     {
-        CS_ASSERT(in_index >= 0 && in_index < m_particleScaleData.size(), "Index out of bounds!");
+        CS_ASSERT(in_index >= 0 && in_index < m_particleInitialScalesX.size(), "Index out of bounds!");
 
-        ScaleData& scaleData = m_particleScaleData[in_index];
-        const Particle& particle = GetParticleArray()->at(in_index);
-        
-        scaleData.m_initialScale = particle.m_scale;
+        auto initialScale = GetParticleArray()->GetScale(in_index);
+        auto targetScale = initialScale * m_scaleOverLifetimeAffectorDef->GetScaleProperty()->GenerateValue(in_effectProgress);
 
-        scaleData.m_targetScale = scaleData.m_initialScale * m_scaleOverLifetimeAffectorDef->GetScaleProperty()->GenerateValue(in_effectProgress);
+        m_particleInitialScalesX[in_index] = initialScale.x;
+        m_particleInitialScalesY[in_index] = initialScale.y;
+        m_particleScaleDeltasX[in_index] = targetScale.x - initialScale.x;
+        m_particleScaleDeltasY[in_index] = targetScale.y - initialScale.y;
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void ScaleOverLifetimeParticleAffector::AffectParticles(f32 in_deltaTime, f32 in_effectProgress)
+    void ScaleOverLifetimeParticleAffector::MoveParticle(u32 in_fromIndex, u32 in_toIndex)
     {
-        dynamic_array<Particle>* particleArray = GetParticleArray();
-        for (u32 i = 0; i < particleArray->size(); ++i)
-        {
-            Particle& particle = particleArray->at(i);
-            ScaleData& scaleData = m_particleScaleData[i];
+        m_particleInitialScalesX[in_toIndex] = m_particleInitialScalesX[in_fromIndex];
+        m_particleInitialScalesY[in_toIndex] = m_particleInitialScalesY[in_fromIndex];
+        m_particleScaleDeltasX[in_toIndex] = m_particleScaleDeltasX[in_fromIndex];
+        m_particleScaleDeltasY[in_toIndex] = m_particleScaleDeltasY[in_fromIndex];
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ScaleOverLifetimeParticleAffector::AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress)
+    {
+        ParticleArray* particleArray = GetParticleArray();
+        const f32* energies = particleArray->GetEnergies();
+        const f32* lifetimes = particleArray->GetLifetimes();
+        f32* scalesX = particleArray->GetScalesX();
+        f32* scalesY = particleArray->GetScalesY();
+        const f32* initialScalesX = m_particleInitialScalesX.data();
+        const f32* initialScalesY = m_particleInitialScalesY.data();
+        const f32* scaleDeltasX = m_particleScaleDeltasX.data();
+        const f32* scaleDeltasY = m_particleScaleDeltasY.data();
 
-            f32 normalisedLifeProgress = 1.0f - (particle.m_energy / particle.m_lifetime);
-            particle.m_scale = scaleData.m_initialScale + (scaleData.m_targetScale - scaleData.m_initialScale) * normalisedLifeProgress;
+        for (u32 i = in_startIndex; i < in_endIndex; ++i)
+        {
+            f32 normalisedLifeProgress = 1.0f - (energies[i] / lifetimes[i]);
+            scalesX[i] = initialScalesX[i] + scaleDeltasX[i] * normalisedLifeProgress;
+            scalesY[i] = initialScalesY[i] + scaleDeltasY[i] * normalisedLifeProgress;
         }
     }
 }
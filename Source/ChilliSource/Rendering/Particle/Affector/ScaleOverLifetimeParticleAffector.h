@@ -30,7 +30,6 @@
 #define _CHILLISOURCE_RENDERING_PARTICLE_AFFECTOR_SCALEOVERLIFETIMEPARTICLEAFFECTOR_H_
 
 #include <ChilliSource/ChilliSource.h>
-#include <ChilliSource/Core/Math/Vector2.h>
 #include <ChilliSource/Core/Container/dynamic_array.h>
 #include <ChilliSource/Rendering/Particle/Affector/ParticleAffector.h>
 
@@ -58,15 +57,25 @@ namespace ChilliSource
         //----------------------------------------------------------------
         void ActivateParticle(u32 in_index, f32 in_effectProgress) override;
         //----------------------------------------------------------------
+        /// Moves the scale data of the particle at the given index to
+        /// another index.
+        ///
+        /// @param The index to move from.
+        /// @param The index to move to.
+        //----------------------------------------------------------------
+        void MoveParticle(u32 in_fromIndex, u32 in_toIndex) override;
+        //----------------------------------------------------------------
         /// Updates the size of each particle.
         ///
         /// @author Ian Copland
         ///
+        /// @param The index of the first particle to affect.
+        /// @param The index one past the last particle to affect.
         /// @param The delta time.
         /// @param The current normalised (0.0 to 1.0) progress through
         /// playback of the particle effect.
         //----------------------------------------------------------------
-        void AffectParticles(f32 in_deltaTime, f32 in_effectProgress) override;
+        void AffectParticles(u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime, f32 in_effectProgress) override;
         //----------------------------------------------------------------
         /// Destructor
         ///
@@ -83,21 +92,13 @@ namespace ChilliSource
         /// @param The particle affector definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        ScaleOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, dynamic_array<Particle>* in_particleArray);
-        //----------------------------------------------------------------
-        /// A container for the initial scale and scale factor of a single 
-        /// particle.
-        ///
-        /// @author Ian Copland.
-        //----------------------------------------------------------------
-        struct ScaleData
-        {
-            Vector2 m_initialScale;
-            Vector2 m_targetScale;
-        };
+        ScaleOverLifetimeParticleAffector(const ParticleAffectorDef* in_affectorDef, ParticleArray* in_particleArray);
 
         const ScaleOverLifetimeParticleAffectorDef* m_scaleOverLifetimeAffectorDef = nullptr;
-        dynamic_array<ScaleData> m_particleScaleData;
+        dynamic_array<f32> m_particleInitialScalesX;
+        dynamic_array<f32> m_particleInitialScalesY;
+        dynamic_array<f32> m_particleScaleDeltasX;
+        dynamic_array<f32> m_particleScaleDeltasY;
     };
 }
 
@@ -28,8 +28,6 @@
 
 #include <ChilliSource/Rendering/Particle/ConcurrentParticleData.h>
 
-#include <ChilliSource/Rendering/Particle/Particle.h>
-
 namespace ChilliSource
 {
     //-----------------------------------------------------------------
@@ -80,17 +78,17 @@ namespace ChilliSource
     }
     //-----------------------------------------------------------------
     //-----------------------------------------------------------------
-    std::vector<u32> ConcurrentParticleData::TakeNewIndices()
+    std::vector<u32> ConcurrentParticleData::TakeNewIds()
     {
-        CS_ASSERT(m_lock.owns_lock() == true, "Must be locked when taking new indices!")
+        CS_ASSERT(m_lock.owns_lock() == true, "Must be locked when taking new ids!")
 
-        std::vector<u32> output = m_newParticleIndices;
-        m_newParticleIndices.clear();
+        std::vector<u32> output = m_newParticleIds;
+        m_newParticleIds.clear();
         return output;
     }
     //-----------------------------------------------------------------
     //-----------------------------------------------------------------
-    const dynamic_array<ConcurrentParticleData::Particle>& ConcurrentParticleData::GetParticles() const
+    const ParticleArray& ConcurrentParticleData::GetParticles() const
     {
         CS_ASSERT(m_lock.owns_lock() == true, "Must be locked when getting particles!");
 
@@ -104,31 +102,14 @@ namespace ChilliSource
     }
     //-----------------------------------------------------------------
     //-----------------------------------------------------------------
-    void ConcurrentParticleData::CommitParticleData(const dynamic_array<ChilliSource::Particle>* in_particles, const std::vector<u32>& in_newIndices, const AABB& in_aabb, const Sphere& in_boundingSphere)
+    void ConcurrentParticleData::CommitParticleData(const ParticleArray* in_particles, const std::vector<u32>& in_newIds, const AABB& in_aabb, const Sphere& in_boundingSphere)
     {
         std::unique_lock<std::recursive_mutex> lock(m_mutex);
 
-        CS_ASSERT(in_particles->size() == m_particles.size(), "Particle data lists must be the same size.");
-
-        m_activeParticles = false;
-        for (u32 i = 0; i < m_particles.size(); ++i)
-        {
-            Particle& concurrentParticle = m_particles[i];
-            const ChilliSource::Particle& particle = (*in_particles)[i];
-
-            concurrentParticle.m_isActive = particle.m_isActive;
-            concurrentParticle.m_position = particle.m_position;
-            concurrentParticle.m_rotation = particle.m_rotation;
-            concurrentParticle.m_scale = particle.m_scale;
-            concurrentParticle.m_colour = particle.m_colour;
-
-            if (concurrentParticle.m_isActive == true)
-            {
-                m_activeParticles = true;
-            }
-        }
+        m_particles.CopyFrom(*in_particles);
+        m_activeParticles = (m_particles.GetSize() > 0);
 
-        m_newParticleIndices.insert(m_newParticleIndices.end(), in_newIndices.begin(), in_newIndices.end());
+        m_newParticleIds.insert(m_newParticleIds.end(), in_newIds.begin(), in_newIds.end());
         m_aabb = in_aabb;
         m_boundingSphere = in_boundingSphere;
         m_updating = false;
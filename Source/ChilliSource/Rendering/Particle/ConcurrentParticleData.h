@@ -30,11 +30,8 @@
 #define _CHILLISOURCE_RENDERING_PARTICLE_CONCURRENTPARTICLEDATA_H_
 
 #include <ChilliSource/ChilliSource.h>
-#include <ChilliSource/Core/Base/Colour.h>
-#include <ChilliSource/Core/Container/dynamic_array.h>
-#include <ChilliSource/Core/Math/Vector2.h>
-#include <ChilliSource/Core/Math/Vector3.h>
 #include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 
 #include <mutex>
 #include <vector>
@@ -52,20 +49,6 @@ namespace ChilliSource
     class ConcurrentParticleData final
     {
     public:
-        //-----------------------------------------------------------------
-        /// A struct containing just the information required for drawing a
-        /// particle.
-        ///
-        /// @author Ian Copland
-        //-----------------------------------------------------------------
-        struct Particle final
-        {
-            bool m_isActive = false;
-            Vector3 m_position;
-            Vector2 m_scale = Vector2::k_zero;
-            f32 m_rotation = 0.0f;
-            Colour m_colour = Colour::k_white;
-        };
         //-----------------------------------------------------------------
         /// Constructor
         ///
@@ -116,14 +99,14 @@ namespace ChilliSource
         Sphere GetBoundingSphere() const;
         //-----------------------------------------------------------------
         /// Locks the container so other threads cannot update it while
-        /// accessing the new indices and particle list.
+        /// accessing the new Ids and particle list.
         ///
         /// @author Ian Copland
         //-----------------------------------------------------------------
         void Lock() const;
         //-----------------------------------------------------------------
-        /// Returns the list of indices that have changed since the last
-        /// time this was called. The list will be cleared when called.
+        /// Returns the Ids of particles that have been emitted since the
+        /// last time this was called. The list will be cleared when called.
         /// Before this is called the container must be locked to ensure
         /// that new particles are not activated prior to being rendered.
         /// If the container is not locked the app is considered to be
@@ -131,9 +114,9 @@ namespace ChilliSource
         /// 
         /// @author Ian Copland
         ///
-        /// @author A vector of particle indices.
+        /// @author A vector of particle Ids.
         //-----------------------------------------------------------------
-        std::vector<u32> TakeNewIndices();
+        std::vector<u32> TakeNewIds();
         //-----------------------------------------------------------------
         /// Before this is called the container must be locked to ensure
         /// that any iteration over the particle data is safe. If not the
@@ -142,9 +125,10 @@ namespace ChilliSource
         ///
         /// @author Ian Copland
         ///
-        /// @param The particle list.
+        /// @param The particle array. Only the live range contains valid
+        /// data.
         //-----------------------------------------------------------------
-        const dynamic_array<ConcurrentParticleData::Particle>& GetParticles() const;
+        const ParticleArray& GetParticles() const;
         //-----------------------------------------------------------------
         /// Unlocks the container. This should be called as soon as possible
         /// after dealing with data that needs to be locked.
@@ -153,23 +137,23 @@ namespace ChilliSource
         //-----------------------------------------------------------------
         void Unlock() const;
         //-----------------------------------------------------------------
-        /// Updates the particle data.
+        /// Updates the particle data. The live range of the given
+        /// particle array is copied in bulk.
         ///
         /// This is thread-safe, lock doesn't need to be called first.
         ///
         /// @author Ian Copland
         ///
-        /// @param The list of particles.
-        /// @param The new indices.
+        /// @param The particle array.
+        /// @param The Ids of newly emitted particles.
         /// @param The aabb.
-        /// @param The obb.
         /// @param The bounding sphere.
         //-----------------------------------------------------------------
-        void CommitParticleData(const dynamic_array<ChilliSource::Particle>* in_particles, const std::vector<u32>& in_newIndices, const AABB& in_aabb, const Sphere& in_boundingSphere);
+        void CommitParticleData(const ParticleArray* in_particles, const std::vector<u32>& in_newIds, const AABB& in_aabb, const Sphere& in_boundingSphere);
     private:
 
-        dynamic_array<ConcurrentParticleData::Particle> m_particles;
-        std::vector<u32> m_newParticleIndices;
+        ParticleArray m_particles;
+        std::vector<u32> m_newParticleIds;
         AABB m_aabb;
         Sphere m_boundingSphere;
         bool m_updating = false;
@@ -95,18 +95,22 @@ namespace ChilliSource
         //----------------------------------------------------------------
         const ParticleDrawableDef* GetDrawableDef() const;
         //----------------------------------------------------------------
-        /// Activates the particle with the given index.
+        /// @return The concurrent particle data for the effect. This
+        /// provides the bounding shapes of the effect.
+        //----------------------------------------------------------------
+        const ConcurrentParticleData* GetConcurrentParticleData() const;
+        //----------------------------------------------------------------
+        /// Activates the particle with the given Id. Particles are moved
+        /// around within the particle array as others die, so any per
+        /// particle data a drawable keeps should be indexed by Id.
         ///
-        /// This is called on the main thread, but the particle data can 
-        /// be modified on other threads so make sure to lock it prior to 
-        /// use.
+        /// This is always called on the main thread.
         ///
         /// @author Ian Copland
         ///
-        /// @param The particle draw data.
-        /// @param The index of the particle to activate.
+        /// @param The Id of the particle to activate.
         //----------------------------------------------------------------
-        virtual void ActivateParticle(const dynamic_array<ConcurrentParticleData::Particle>& in_particleData, u32 in_index) = 0;
+        virtual void ActivateParticle(u32 in_particleId) = 0;
         //----------------------------------------------------------------
         /// Renders all active particles in the effect. 
         ///
@@ -114,13 +118,14 @@ namespace ChilliSource
         ///
         /// @author Ian Copland
         ///
-        /// @param in_particleData - The particle draw data.
+        /// @param in_particleData - The particle data. Only particles in
+        /// the range [0, GetSize()) are alive.
         /// @param in_renderSnapshot - The render snapshot that particles
         /// will be added to.
         /// @param frameAllocator - Allocate memory for this render frame
         /// from here
         //----------------------------------------------------------------
-        virtual void DrawParticles(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) = 0;
+        virtual void DrawParticles(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) = 0;
         
     private:
         const Entity* m_entity = nullptr;
@@ -45,6 +45,10 @@
 #include <ChilliSource/Rendering/Base/AspectRatioUtils.h>
 #include <ChilliSource/Rendering/Camera/CameraComponent.h>
 #include <ChilliSource/Rendering/Material/Material.h>
+#include <ChilliSource/Rendering/Model/IndexFormat.h>
+#include <ChilliSource/Rendering/Model/PolygonType.h>
+#include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
+#include <ChilliSource/Rendering/Model/VertexFormat.h>
 #include <ChilliSource/Rendering/Sprite/SpriteMeshBuilder.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureAtlas.h>
@@ -53,6 +57,14 @@ namespace ChilliSource
 {
     namespace
     {
+        constexpr u32 k_verticesPerBillboard = 4;
+        constexpr u32 k_indicesPerBillboard = 6;
+        constexpr u32 k_maxBillboardsByVertexData = RenderDynamicMesh::k_maxVertexDataSize / (k_verticesPerBillboard * sizeof(SpriteVertex));
+        constexpr u32 k_maxBillboardsByIndexData = RenderDynamicMesh::k_maxIndexDataSize / (k_indicesPerBillboard * sizeof(u16));
+        constexpr u32 k_maxBillboardsPerMesh = (k_maxBillboardsByVertexData < k_maxBillboardsByIndexData) ? k_maxBillboardsByVertexData : k_maxBillboardsByIndexData;
+
+        const u16 k_billboardIndices[k_indicesPerBillboard] { 0, 1, 2, 1, 3, 2 };
+
         //-----------------------------------------------------------------------------
         /// Returns the billboard size for the given size of image with the given 
         /// size policy
@@ -98,21 +110,21 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void StaticBillboardParticleDrawable::ActivateParticle(const dynamic_array<ConcurrentParticleData::Particle>& in_particleData, u32 in_index)
+    void StaticBillboardParticleDrawable::ActivateParticle(u32 in_particleId)
     {
-        CS_ASSERT(in_index >= 0 && in_index < m_particleBillboardIndices.size(), "Index out of bounds!");
+        CS_ASSERT(in_particleId < m_particleBillboardIndices.size(), "Id out of bounds!");
 
         switch (m_billboardDrawableDef->GetImageSelectionType())
         {
         case StaticBillboardParticleDrawableDef::ImageSelectionType::k_cycle:
-            m_particleBillboardIndices[in_index] = m_nextBillboardIndex++;
+            m_particleBillboardIndices[in_particleId] = m_nextBillboardIndex++;
             if (m_nextBillboardIndex >= m_billboards->size())
             {
                 m_nextBillboardIndex = 0;
             }
             break;
         case StaticBillboardParticleDrawableDef::ImageSelectionType::k_random:
-            m_particleBillboardIndices[in_index] = Random::Generate<u32>(0, static_cast<s32>(m_billboards->size()) - 1);
+            m_particleBillboardIndices[in_particleId] = Random::Generate<u32>(0, static_cast<s32>(m_billboards->size()) - 1);
             break;
         default:
             CS_LOG_FATAL("Invalid image selection type.");
@@ -121,8 +133,14 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void StaticBillboardParticleDrawable::DrawParticles(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator)
+    void StaticBillboardParticleDrawable::DrawParticles(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator)
     {
+        if (m_billboardDrawableDef->GetDrawMode() == StaticBillboardParticleDrawableDef::DrawMode::k_batched)
+        {
+            DrawBatched(particleData, renderSnapshot, frameAllocator);
+            return;
+        }
+
         switch (GetDrawableDef()->GetParticleEffect()->GetSimulationSpace())
         {
         case ParticleEffect::SimulationSpace::k_local:
@@ -183,7 +201,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void StaticBillboardParticleDrawable::DrawLocalSpace(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const
+    void StaticBillboardParticleDrawable::DrawLocalSpace(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const
     {
         auto renderMaterialGroup = m_billboardDrawableDef->GetMaterial()->GetRenderMaterialGroup();
         auto entityWorldTransform = GetEntity()->GetTransform().GetWorldTransform();
@@ -197,21 +215,23 @@ namespace ChilliSource
         //billboard by applying the inverse of the view orientation. The view orientation is the inverse of the camera entity orientation.
         auto inverseView = renderSnapshot.GetRenderCamera().GetOrientation();
 
-        for (u32 i = 0; i < particleData.size(); ++i)
-        {
-            const auto& particle = particleData[i];
+        const auto ids = particleData.GetIds();
+        const auto rotations = particleData.GetRotations();
 
-            if (particle.m_isActive == true && particle.m_colour != Colour::k_transparent)
+        for (u32 i = 0; i < particleData.GetSize(); ++i)
+        {
+            auto colour = particleData.GetColour(i);
+            if (colour != Colour::k_transparent)
             {
-                const auto& billboardData = m_billboards->at(m_particleBillboardIndices[i]);
+                const auto& billboardData = m_billboards->at(m_particleBillboardIndices[ids[i]]);
                 
-                auto worldPosition = particle.m_position * entityWorldTransform;
-                auto worldScale = Vector3(particle.m_scale * particleScaleFactor, 1.0f);
-                auto worldOrientation = Quaternion(Vector3::k_unitPositiveZ, particle.m_rotation) * inverseView; //rotate locally in the XY plane before rotating to face the camera.
+                auto worldPosition = particleData.GetPosition(i) * entityWorldTransform;
+                auto worldScale = Vector3(particleData.GetScale(i) * particleScaleFactor, 1.0f);
+                auto worldOrientation = Quaternion(Vector3::k_unitPositiveZ, rotations[i]) * inverseView; //rotate locally in the XY plane before rotating to face the camera.
                 auto worldMatrix = Matrix4::CreateTransform(worldPosition, worldScale, worldOrientation);
                 
                 auto renderDynamicMesh = SpriteMeshBuilder::Build(frameAllocator, Vector3(billboardData.m_localCentre, 0.0f), billboardData.m_localSize, billboardData.m_uvs,
-                                                                  particle.m_colour, AlignmentAnchor::k_middleCentre);
+                                                                  colour, AlignmentAnchor::k_middleCentre);
                 auto worldBoundingSphere = Sphere::Transform(renderDynamicMesh->GetBoundingSphere(), worldPosition, worldOrientation, worldScale);
                 
                 renderSnapshot.AddRenderObject(RenderObject(renderMaterialGroup, renderDynamicMesh.get(), worldMatrix, worldBoundingSphere, false, RenderLayer::k_standard));
@@ -221,28 +241,30 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    void StaticBillboardParticleDrawable::DrawWorldSpace(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const
+    void StaticBillboardParticleDrawable::DrawWorldSpace(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const
     {
         auto renderMaterialGroup = m_billboardDrawableDef->GetMaterial()->GetRenderMaterialGroup();
 
         //billboard by applying the inverse of the view orientation. The view orientation is the inverse of the camera entity orientation.
         auto inverseView = renderSnapshot.GetRenderCamera().GetOrientation();
 
-        for (u32 i = 0; i < particleData.size(); ++i)
-        {
-            const auto& particle = particleData[i];
+        const auto ids = particleData.GetIds();
+        const auto rotations = particleData.GetRotations();
 
-            if (particle.m_isActive == true && particle.m_colour != Colour::k_transparent)
+        for (u32 i = 0; i < particleData.GetSize(); ++i)
+        {
+            auto colour = particleData.GetColour(i);
+            if (colour != Colour::k_transparent)
             {
-                const auto& billboardData = m_billboards->at(m_particleBillboardIndices[i]);
+                const auto& billboardData = m_billboards->at(m_particleBillboardIndices[ids[i]]);
                 
-                auto worldPosition = particle.m_position;
-                auto worldScale = Vector3(particle.m_scale, 1.0f);
-                auto worldOrientation = Quaternion(Vector3::k_unitPositiveZ, particle.m_rotation) * inverseView;  //rotate locally in the XY plane before rotating to face the camera.
+                auto worldPosition = particleData.GetPosition(i);
+                auto worldScale = Vector3(particleData.GetScale(i), 1.0f);
+                auto worldOrientation = Quaternion(Vector3::k_unitPositiveZ, rotations[i]) * inverseView;  //rotate locally in the XY plane before rotating to face the camera.
                 auto worldMatrix = Matrix4::CreateTransform(worldPosition, worldScale, worldOrientation);
 
                 auto renderDynamicMesh = SpriteMeshBuilder::Build(frameAllocator, Vector3(billboardData.m_localCentre, 0.0f), billboardData.m_localSize, billboardData.m_uvs,
-                                                                  particle.m_colour, AlignmentAnchor::k_middleCentre);
+                                                                  colour, AlignmentAnchor::k_middleCentre);
                 auto worldBoundingSphere = Sphere::Transform(renderDynamicMesh->GetBoundingSphere(), worldPosition, worldOrientation, worldScale);
                 
                 renderSnapshot.AddRenderObject(RenderObject(renderMaterialGroup, renderDynamicMesh.get(), worldMatrix, worldBoundingSphere, false, RenderLayer::k_standard));
@@ -250,4 +272,128 @@ namespace ChilliSource
             }
         }
     }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void StaticBillboardParticleDrawable::DrawBatched(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const
+    {
+        auto renderMaterialGroup = m_billboardDrawableDef->GetMaterial()->GetRenderMaterialGroup();
+
+        //local space particles are transformed into world space here so the batch can be rendered with an identity transform.
+        //See DrawLocalSpace() for why the entity scale is made uniform.
+        auto effectBoundingSphere = GetConcurrentParticleData()->GetBoundingSphere();
+        Matrix4 entityWorldTransform = Matrix4::k_identity;
+        f32 particleScaleFactor = 1.0f;
+        if (GetDrawableDef()->GetParticleEffect()->GetSimulationSpace() == ParticleEffect::SimulationSpace::k_local)
+        {
+            entityWorldTransform = GetEntity()->GetTransform().GetWorldTransform();
+
+            auto entityScale = GetEntity()->GetTransform().GetWorldScale();
+            particleScaleFactor = (entityScale.x + entityScale.y + entityScale.z) / 3.0f;
+
+            f32 maxEntityScale = std::max(std::max(std::abs(entityScale.x), std::abs(entityScale.y)), std::abs(entityScale.z));
+            effectBoundingSphere = Sphere(effectBoundingSphere.vOrigin * entityWorldTransform, effectBoundingSphere.fRadius * maxEntityScale);
+        }
+
+        //billboard by building each quad from the camera's right and up vectors. The view orientation is the inverse of the camera entity orientation.
+        auto inverseView = renderSnapshot.GetRenderCamera().GetOrientation();
+        auto cameraRight = Vector3::Rotate(Vector3::k_unitPositiveX, inverseView);
+        auto cameraUp = Vector3::Rotate(Vector3::k_unitPositiveY, inverseView);
+
+        const auto ids = particleData.GetIds();
+        const auto rotations = particleData.GetRotations();
+
+        //the effect bounds only contain the particle positions, so they are expanded by the largest billboard.
+        u32 numBillboards = 0;
+        f32 maxBillboardRadius = 0.0f;
+        for (u32 i = 0; i < particleData.GetSize(); ++i)
+        {
+            auto colour = particleData.GetColour(i);
+            if (colour != Colour::k_transparent)
+            {
+                const auto& billboardData = m_billboards->at(m_particleBillboardIndices[ids[i]]);
+                f32 billboardRadius = (billboardData.m_localCentre.Length() + 0.5f * billboardData.m_localSize.Length()) * std::max(std::abs(particleData.GetScalesX()[i]), std::abs(particleData.GetScalesY()[i]));
+                maxBillboardRadius = std::max(maxBillboardRadius, billboardRadius);
+                ++numBillboards;
+            }
+        }
+
+        if (numBillboards == 0)
+        {
+            return;
+        }
+
+        Sphere worldBoundingSphere(effectBoundingSphere.vOrigin, effectBoundingSphere.fRadius + maxBillboardRadius * particleScaleFactor);
+
+        u32 particleIndex = 0;
+        while (numBillboards > 0)
+        {
+            u32 numMeshBillboards = std::min(numBillboards, k_maxBillboardsPerMesh);
+            numBillboards -= numMeshBillboards;
+
+            u32 numVertices = numMeshBillboards * k_verticesPerBillboard;
+            u32 numIndices = numMeshBillboards * k_indicesPerBillboard;
+            u32 vertexDataSize = numVertices * sizeof(SpriteVertex);
+            u32 indexDataSize = numIndices * sizeof(u16);
+            auto vertexData = MakeUniqueArray<u8>(*frameAllocator, vertexDataSize);
+            auto indexData = MakeUniqueArray<u8>(*frameAllocator, indexDataSize);
+            auto vertices = reinterpret_cast<SpriteVertex*>(vertexData.get());
+            auto indices = reinterpret_cast<u16*>(indexData.get());
+
+            for (u32 billboardIndex = 0; billboardIndex < numMeshBillboards; ++particleIndex)
+            {
+                auto particleColour = particleData.GetColour(particleIndex);
+                if (particleColour == Colour::k_transparent)
+                {
+                    continue;
+                }
+
+                const auto& billboardData = m_billboards->at(m_particleBillboardIndices[ids[particleIndex]]);
+
+                //rotate locally in the XY plane before orientating the quad to face the camera.
+                f32 cosRotation = std::cos(rotations[particleIndex]);
+                f32 sinRotation = std::sin(rotations[particleIndex]);
+                Vector2 scale = particleData.GetScale(particleIndex) * particleScaleFactor;
+                Vector3 right = (cosRotation * cameraRight + sinRotation * cameraUp) * scale.x;
+                Vector3 up = (cosRotation * cameraUp - sinRotation * cameraRight) * scale.y;
+
+                Vector2 halfSize = 0.5f * billboardData.m_localSize;
+                Vector3 centre = particleData.GetPosition(particleIndex) * entityWorldTransform + billboardData.m_localCentre.x * right + billboardData.m_localCentre.y * up;
+                Vector3 halfRight = halfSize.x * right;
+                Vector3 halfUp = halfSize.y * up;
+
+                const auto& uvs = billboardData.m_uvs;
+                ByteColour colour = ColourUtils::ColourToByteColour(particleColour);
+
+                //vertices are ordered top left, bottom left, top right and bottom right to match SpriteMeshBuilder.
+                SpriteVertex* billboardVertices = vertices + billboardIndex * k_verticesPerBillboard;
+                billboardVertices[0].m_position = Vector4(centre - halfRight + halfUp, 1.0f);
+                billboardVertices[0].m_texCoord = Vector2(uvs.m_u, uvs.m_v);
+                billboardVertices[1].m_position = Vector4(centre - halfRight - halfUp, 1.0f);
+                billboardVertices[1].m_texCoord = Vector2(uvs.m_u, uvs.m_v + uvs.m_t);
+                billboardVertices[2].m_position = Vector4(centre + halfRight + halfUp, 1.0f);
+                billboardVertices[2].m_texCoord = Vector2(uvs.m_u + uvs.m_s, uvs.m_v);
+                billboardVertices[3].m_position = Vector4(centre + halfRight - halfUp, 1.0f);
+                billboardVertices[3].m_texCoord = Vector2(uvs.m_u + uvs.m_s, uvs.m_v + uvs.m_t);
+                for (u32 i = 0; i < k_verticesPerBillboard; ++i)
+                {
+                    billboardVertices[i].m_colour = colour;
+                }
+
+                u16 firstVertex = u16(billboardIndex * k_verticesPerBillboard);
+                u16* billboardIndices = indices + billboardIndex * k_indicesPerBillboard;
+                for (u32 i = 0; i < k_indicesPerBillboard; ++i)
+                {
+                    billboardIndices[i] = firstVertex + k_billboardIndices[i];
+                }
+
+                ++billboardIndex;
+            }
+
+            auto renderDynamicMesh = MakeUnique<RenderDynamicMesh>(*frameAllocator, PolygonType::k_triangle, VertexFormat::k_sprite, IndexFormat::k_short, numVertices, numIndices, worldBoundingSphere,
+                                                                   std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize);
+
+            renderSnapshot.AddRenderObject(RenderObject(renderMaterialGroup, renderDynamicMesh.get(), Matrix4::k_identity, worldBoundingSphere, false, RenderLayer::k_standard));
+            renderSnapshot.AddRenderDynamicMesh(std::move(renderDynamicMesh));
+        }
+    }
 }
@@ -69,14 +69,13 @@ namespace ChilliSource
         //----------------------------------------------------------------
         StaticBillboardParticleDrawable(const Entity* in_entity, const ParticleDrawableDef* in_drawableDef, ConcurrentParticleData* in_concurrentParticleData);
         //----------------------------------------------------------------
-        /// Activates the particle with the given index.
+        /// Activates the particle with the given Id.
         ///
         /// @author Ian Copland
         ///
-        /// @param The particle draw data.
-        /// @param The index of the particle to activate.
+        /// @param The Id of the particle to activate.
         //----------------------------------------------------------------
-        void ActivateParticle(const dynamic_array<ConcurrentParticleData::Particle>& in_particleData, u32 in_index) override;
+        void ActivateParticle(u32 in_particleId) override;
         //----------------------------------------------------------------
         /// Renders all active particles in the effect.
         ///
@@ -88,7 +87,7 @@ namespace ChilliSource
         /// @param frameAllocator - Allocate memory for this render frame
         /// from here
         //----------------------------------------------------------------
-        void DrawParticles(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) override;
+        void DrawParticles(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) override;
         //----------------------------------------------------------------
         /// Builds the billboard image data from the provided texture
         /// or texture atlas.
@@ -116,7 +115,7 @@ namespace ChilliSource
         /// @param frameAllocator - Allocate memory for this render frame
         /// from here
         //----------------------------------------------------------------
-        void DrawLocalSpace(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const;
+        void DrawLocalSpace(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const;
         //----------------------------------------------------------------
         /// Draws the particles without taking into account the world
         /// space transform of the owning entity as the particles are
@@ -130,7 +129,21 @@ namespace ChilliSource
         /// @param frameAllocator - Allocate memory for this render frame
         /// from here
         //----------------------------------------------------------------
-        void DrawWorldSpace(const dynamic_array<ConcurrentParticleData::Particle>& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const;
+        void DrawWorldSpace(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const;
+        //----------------------------------------------------------------
+        /// Draws all particles in the effect as camera facing quads in
+        /// a single world space mesh, which is submitted as a single
+        /// render object using the bounds of the effect. If the effect
+        /// has more particles than can fit in a single dynamic mesh then
+        /// the particles are split across as few meshes as possible.
+        ///
+        /// @param particleData - The particle draw data.
+        /// @param renderSnapshot - The render snapshot that particles
+        /// will be added to.
+        /// @param frameAllocator - Allocate memory for this render frame
+        /// from here
+        //----------------------------------------------------------------
+        void DrawBatched(const ParticleArray& particleData, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) const;
 
         const StaticBillboardParticleDrawableDef* m_billboardDrawableDef;
         std::unique_ptr <dynamic_array<BillboardData>> m_billboards;
@@ -112,7 +112,7 @@ namespace ChilliSource
 
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    Cone2DParticleEmitter::Cone2DParticleEmitter(const ParticleEmitterDef* in_particleEmitter, dynamic_array<Particle>* in_particleArray)
+    Cone2DParticleEmitter::Cone2DParticleEmitter(const ParticleEmitterDef* in_particleEmitter, ParticleArray* in_particleArray)
         : ParticleEmitter(in_particleEmitter, in_particleArray)
     {
         //Only the sphere emitter def can create this, so this is safe.
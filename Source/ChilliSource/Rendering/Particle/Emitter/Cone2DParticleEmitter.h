@@ -69,7 +69,7 @@ namespace ChilliSource
         /// @param The particle emitter definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        Cone2DParticleEmitter(const ParticleEmitterDef* in_particleEmitter, dynamic_array<Particle>* in_particleArray);
+        Cone2DParticleEmitter(const ParticleEmitterDef* in_particleEmitter, ParticleArray* in_particleArray);
 
         const Cone2DParticleEmitterDef* m_coneParticleEmitterDef = nullptr;
     };
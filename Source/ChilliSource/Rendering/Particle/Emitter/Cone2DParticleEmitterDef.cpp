@@ -157,7 +157,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ParticleEmitterUPtr Cone2DParticleEmitterDef::CreateInstance(dynamic_array<Particle>* in_particleArray) const
+    ParticleEmitterUPtr Cone2DParticleEmitterDef::CreateInstance(ParticleArray* in_particleArray) const
     {
         return ParticleEmitterUPtr(new Cone2DParticleEmitter(this, in_particleArray));
     }
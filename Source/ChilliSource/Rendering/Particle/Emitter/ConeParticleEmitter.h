@@ -69,7 +69,7 @@ namespace ChilliSource
         /// @param The particle emitter definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        ConeParticleEmitter(const ParticleEmitterDef* in_particleEmitter, dynamic_array<Particle>* in_particleArray);
+        ConeParticleEmitter(const ParticleEmitterDef* in_particleEmitter, ParticleArray* in_particleArray);
 
         const ConeParticleEmitterDef* m_coneParticleEmitterDef = nullptr;
     };
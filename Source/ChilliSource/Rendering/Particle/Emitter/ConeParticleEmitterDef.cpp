@@ -157,7 +157,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ParticleEmitterUPtr ConeParticleEmitterDef::CreateInstance(dynamic_array<Particle>* in_particleArray) const
+    ParticleEmitterUPtr ConeParticleEmitterDef::CreateInstance(ParticleArray* in_particleArray) const
     {
         return ParticleEmitterUPtr(new ConeParticleEmitter(this, in_particleArray));
     }
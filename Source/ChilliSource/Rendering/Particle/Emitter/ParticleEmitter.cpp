@@ -32,7 +32,7 @@
 #include <ChilliSource/Core/Entity/Entity.h>
 #include <ChilliSource/Core/Entity/Transform.h>
 #include <ChilliSource/Core/Math/Random.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
 #include <ChilliSource/Rendering/Particle/Emitter/ParticleEmitterDef.h>
 
@@ -42,7 +42,7 @@ namespace ChilliSource
 {
     //----------------------------------------------
     //----------------------------------------------
-    ParticleEmitter::ParticleEmitter(const ParticleEmitterDef* in_emitterDef, dynamic_array<Particle>* in_particleArray)
+    ParticleEmitter::ParticleEmitter(const ParticleEmitterDef* in_emitterDef, ParticleArray* in_particleArray)
         : m_emitterDef(in_emitterDef), m_particleArray(in_particleArray)
     {
         CS_ASSERT(m_emitterDef != nullptr, "Cannot create particle emitter with null emitter def.");
@@ -176,15 +176,11 @@ namespace ChilliSource
     {
         const ParticleEffect* particleEffect = m_emitterDef->GetParticleEffect();
 
-        u32 particleIndex = m_nextParticleIndex++;
-        Particle& particle = m_particleArray->at(particleIndex);
-        if (m_nextParticleIndex >= particleEffect->GetMaxParticles())
-        {
-            m_nextParticleIndex = 0;
-        }
-
-        if (particle.m_isActive == false)
+        //A particle is emitted whenever there is room in the array. Particles no longer have fixed slots, so an
+        //emission is only dropped once the effect has reached its maximum number of particles.
+        if (m_particleArray->IsFull() == false)
         {
+            u32 particleIndex = m_particleArray->Add();
             inout_emittedParticles.push_back(particleIndex);
 
             //Get the emission position and direction.
@@ -204,23 +200,23 @@ namespace ChilliSource
                 {
                     //transform the position into world space.
                     const Matrix4 worldTransform = Matrix4::CreateTransform(in_emissionPosition, in_emissionScale, in_emissionOrientation);
-                    particle.m_position = localPosition * worldTransform;
+                    m_particleArray->SetPosition(particleIndex, localPosition * worldTransform);
 
                     //we can't directly apply the emission scale to the particles as this would look strange as
                     //the camera moved around an emitting entity with a non-uniform scale, so this works out a uniform
                     //scale from the average of the components.
                     f32 particleScaleFactor = (in_emissionScale.x + in_emissionScale.y + in_emissionScale.z) / 3.0f;
-                    particle.m_scale = localScale * particleScaleFactor;
+                    m_particleArray->SetScale(particleIndex, localScale * particleScaleFactor);
 
                     //transform the velocity into world space.
-                    particle.m_velocity = Vector3::Rotate(((localDirection * localSpeed) * in_emissionScale), in_emissionOrientation);
+                    m_particleArray->SetVelocity(particleIndex, Vector3::Rotate(((localDirection * localSpeed) * in_emissionScale), in_emissionOrientation));
                     break;
                 }
                 case ParticleEffect::SimulationSpace::k_local:
                 {
-                    particle.m_position = localPosition;
-                    particle.m_scale = localScale;
-                    particle.m_velocity = localDirection * localSpeed;
+                    m_particleArray->SetPosition(particleIndex, localPosition);
+                    m_particleArray->SetScale(particleIndex, localScale);
+                    m_particleArray->SetVelocity(particleIndex, localDirection * localSpeed);
                     break;
                 }
                 default:
@@ -231,12 +227,12 @@ namespace ChilliSource
             }
 
             //apply the remaining properties.
-            particle.m_lifetime = particleEffect->GetLifetimeProperty()->GenerateValue(in_normalisedEmissionTime);
-            particle.m_energy = particle.m_lifetime;
-            particle.m_colour = particleEffect->GetInitialColourProperty()->GenerateValue(in_normalisedEmissionTime);
-            particle.m_rotation = localRotation;
-            particle.m_angularVelocity = particleEffect->GetInitialAngularVelocityProperty()->GenerateValue(in_normalisedEmissionTime);
-            particle.m_isActive = true;
+            f32 lifetime = particleEffect->GetLifetimeProperty()->GenerateValue(in_normalisedEmissionTime);
+            m_particleArray->GetLifetimes()[particleIndex] = lifetime;
+            m_particleArray->GetEnergies()[particleIndex] = lifetime;
+            m_particleArray->SetColour(particleIndex, particleEffect->GetInitialColourProperty()->GenerateValue(in_normalisedEmissionTime));
+            m_particleArray->GetRotations()[particleIndex] = localRotation;
+            m_particleArray->GetAngularVelocities()[particleIndex] = particleEffect->GetInitialAngularVelocityProperty()->GenerateValue(in_normalisedEmissionTime);
         }
     }
 }
@@ -60,7 +60,7 @@ namespace ChilliSource
         /// @param The particle emitter definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        ParticleEmitter(const ParticleEmitterDef* in_particleEmitter, dynamic_array<Particle>* in_particleArray);
+        ParticleEmitter(const ParticleEmitterDef* in_particleEmitter, ParticleArray* in_particleArray);
         //----------------------------------------------------------------
         /// Tries to emit new particles if required. This will be called 
         /// as part of a background task.
@@ -126,8 +126,7 @@ namespace ChilliSource
         //----------------------------------------------------------------
         std::vector<u32> TryEmitBurst(f32 in_playbackTime, const Vector3& in_emitterPosition, const Vector3& in_emitterScale, const Quaternion& in_emitterOrientation);
         //----------------------------------------------------------------
-        /// Emits a new particle if the next particle in the list is free
-        /// to be emitted. 
+        /// Emits a new particle if the particle array isn't full.
         ///
         /// @author Ian Copland
         /// 
@@ -138,22 +137,19 @@ namespace ChilliSource
         /// of emission.
         /// @param The world orientation of the emitter at the time of
         /// emission.
-        /// @param [In/Out] The list of emitted particles, will add to the
-        /// list if a particle is successfully emitted.
-        ///
-        /// @param The index of the emitted particle. 
+        /// @param [In/Out] The list of emitted particle indices, will add
+        /// to the list if a particle is successfully emitted.
         //----------------------------------------------------------------
         void Emit(f32 in_normalisedEmissionTime, const Vector3& in_emissionPosition, const Vector3& in_emissionScale, const Quaternion& in_emissionOrientation, std::vector<u32>& inout_emittedParticles);
 
         const ParticleEmitterDef* m_emitterDef = nullptr;
-        dynamic_array<Particle>* m_particleArray = nullptr;
+        ParticleArray* m_particleArray = nullptr;
 
         Vector3 m_emissionPosition;
         Vector3 m_emissionScale;
         Quaternion m_emissionOrientation;
         f32 m_emissionTime = 0.0f;
         bool m_hasEmitted = false;
-        u32 m_nextParticleIndex = 0;
     };
 }
 
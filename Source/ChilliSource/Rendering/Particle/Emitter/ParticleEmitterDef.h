@@ -134,7 +134,7 @@ namespace ChilliSource
         ///
         /// @return the instance.
         //----------------------------------------------------------------
-        virtual ParticleEmitterUPtr CreateInstance(dynamic_array<Particle>* in_particleArray) const = 0;
+        virtual ParticleEmitterUPtr CreateInstance(ParticleArray* in_particleArray) const = 0;
         //----------------------------------------------------------------
         /// @author Ian Copland
         ///
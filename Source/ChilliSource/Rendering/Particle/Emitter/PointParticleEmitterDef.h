@@ -105,7 +105,7 @@ namespace ChilliSource
         ///
         /// @return the instance.
         //----------------------------------------------------------------
-        ParticleEmitterUPtr CreateInstance(dynamic_array<Particle>* in_particleArray) const override;
+        ParticleEmitterUPtr CreateInstance(ParticleArray* in_particleArray) const override;
     };
 }
 
@@ -69,7 +69,7 @@ namespace ChilliSource
         /// @param The particle emitter definition.
         /// @param The particle array.
         //----------------------------------------------------------------
-        SphereParticleEmitter(const ParticleEmitterDef* in_particleEmitter, dynamic_array<Particle>* in_particleArray);
+        SphereParticleEmitter(const ParticleEmitterDef* in_particleEmitter, ParticleArray* in_particleArray);
 
         const SphereParticleEmitterDef* m_sphereParticleEmitterDef = nullptr;
     };
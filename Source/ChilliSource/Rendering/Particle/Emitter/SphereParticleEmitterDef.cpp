@@ -145,7 +145,7 @@ namespace ChilliSource
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
-    ParticleEmitterUPtr SphereParticleEmitterDef::CreateInstance(dynamic_array<Particle>* in_particleArray) const
+    ParticleEmitterUPtr SphereParticleEmitterDef::CreateInstance(ParticleArray* in_particleArray) const
     {
         return ParticleEmitterUPtr(new SphereParticleEmitter(this, in_particleArray));
     }
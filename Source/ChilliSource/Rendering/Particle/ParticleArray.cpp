@@ -0,0 +1,219 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
+
+#include <cstring>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        //----------------------------------------------------------------
+        /// @param The particle capacity.
+        ///
+        /// @return The number of elements reserved for each stream. This
+        /// is the capacity rounded up to a multiple of 4 so that every
+        /// stream is 16 byte aligned if the first is.
+        //----------------------------------------------------------------
+        u32 CalcStreamStride(u32 in_capacity)
+        {
+            return (in_capacity + 3) & ~u32(3);
+        }
+    }
+
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    ParticleArray::ParticleArray(u32 in_capacity)
+        : m_capacity(in_capacity), m_streamStride(CalcStreamStride(in_capacity)), m_freeIds(in_capacity), m_numFreeIds(in_capacity), m_ids(in_capacity), m_keptIndices(in_capacity),
+        m_streamData(m_streamStride * u32(Stream::k_total))
+    {
+        //Ids are taken from the back of the free list so that they are handed out in ascending order.
+        for (u32 i = 0; i < m_capacity; ++i)
+        {
+            m_freeIds[i] = m_capacity - 1 - i;
+        }
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    u32 ParticleArray::Add()
+    {
+        CS_ASSERT(IsFull() == false, "Cannot add a particle to a full particle array.");
+
+        u32 index = m_size++;
+        m_ids[index] = m_freeIds[--m_numFreeIds];
+        return index;
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::RemoveExpired(const std::function<void(u32, u32)>& in_moveDelegate)
+    {
+        const f32* energies = GetEnergies();
+
+        //Find the first expired particle. Nothing before it needs to move.
+        u32 firstExpired = 0;
+        while (firstExpired < m_size && energies[firstExpired] > 0.0f)
+        {
+            ++firstExpired;
+        }
+
+        if (firstExpired == m_size)
+        {
+            return;
+        }
+
+        //Ids are compacted first, noting which particles are kept, as the energy stream is compacted along with the others.
+        u32 newSize = firstExpired;
+        for (u32 i = firstExpired; i < m_size; ++i)
+        {
+            if (energies[i] > 0.0f)
+            {
+                m_ids[newSize] = m_ids[i];
+                m_keptIndices[newSize] = i;
+                in_moveDelegate(i, newSize);
+                ++newSize;
+            }
+            else
+            {
+                m_freeIds[m_numFreeIds++] = m_ids[i];
+            }
+        }
+
+        f32* stream = m_streamData.data();
+        for (u32 i = 0; i < u32(Stream::k_total); ++i, stream += m_streamStride)
+        {
+            for (u32 j = firstExpired; j < newSize; ++j)
+            {
+                stream[j] = stream[m_keptIndices[j]];
+            }
+        }
+
+        m_size = newSize;
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::Clear()
+    {
+        while (m_size > 0)
+        {
+            m_freeIds[m_numFreeIds++] = m_ids[--m_size];
+        }
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::CopyFrom(const ParticleArray& in_particleArray)
+    {
+        CS_ASSERT(m_capacity == in_particleArray.m_capacity, "Particle arrays must have the same capacity.");
+
+        m_size = in_particleArray.m_size;
+        m_numFreeIds = in_particleArray.m_numFreeIds;
+
+        if (m_numFreeIds > 0)
+        {
+            std::memcpy(m_freeIds.data(), in_particleArray.m_freeIds.data(), sizeof(u32) * m_numFreeIds);
+        }
+
+        if (m_size > 0)
+        {
+            std::memcpy(m_ids.data(), in_particleArray.m_ids.data(), sizeof(u32) * m_size);
+
+            for (u32 i = 0; i < u32(Stream::k_total); ++i)
+            {
+                std::memcpy(m_streamData.data() + i * m_streamStride, in_particleArray.m_streamData.data() + i * m_streamStride, sizeof(f32) * m_size);
+            }
+        }
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    Vector3 ParticleArray::GetPosition(u32 in_index) const
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        return Vector3(GetPositionsX()[in_index], GetPositionsY()[in_index], GetPositionsZ()[in_index]);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::SetPosition(u32 in_index, const Vector3& in_position)
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        GetPositionsX()[in_index] = in_position.x;
+        GetPositionsY()[in_index] = in_position.y;
+        GetPositionsZ()[in_index] = in_position.z;
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    Vector3 ParticleArray::GetVelocity(u32 in_index) const
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        return Vector3(GetVelocitiesX()[in_index], GetVelocitiesY()[in_index], GetVelocitiesZ()[in_index]);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::SetVelocity(u32 in_index, const Vector3& in_velocity)
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        GetVelocitiesX()[in_index] = in_velocity.x;
+        GetVelocitiesY()[in_index] = in_velocity.y;
+        GetVelocitiesZ()[in_index] = in_velocity.z;
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    Vector2 ParticleArray::GetScale(u32 in_index) const
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        return Vector2(GetScalesX()[in_index], GetScalesY()[in_index]);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::SetScale(u32 in_index, const Vector2& in_scale)
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        GetScalesX()[in_index] = in_scale.x;
+        GetScalesY()[in_index] = in_scale.y;
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    Colour ParticleArray::GetColour(u32 in_index) const
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        return Colour(GetColoursR()[in_index], GetColoursG()[in_index], GetColoursB()[in_index], GetColoursA()[in_index]);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleArray::SetColour(u32 in_index, const Colour& in_colour)
+    {
+        CS_ASSERT(in_index < m_capacity, "Index out of bounds!");
+
+        GetColoursR()[in_index] = in_colour.r;
+        GetColoursG()[in_index] = in_colour.g;
+        GetColoursB()[in_index] = in_colour.b;
+        GetColoursA()[in_index] = in_colour.a;
+    }
+}
@@ -0,0 +1,298 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_PARTICLE_PARTICLEARRAY_H_
+#define _CHILLISOURCE_RENDERING_PARTICLE_PARTICLEARRAY_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/Container/dynamic_array.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+
+#include <functional>
+
+namespace ChilliSource
+{
+    //-----------------------------------------------------------------------
+    /// A fixed capacity, structure-of-arrays container for the properties
+    /// of all particles in an effect.
+    ///
+    /// Live particles are always packed into the range [0, GetSize()), in
+    /// the order they were added. When particles are removed the remaining
+    /// particles are moved down to close the gaps, so a particle's index
+    /// can change from update to update. Each particle
+    /// is also given an Id when added which doesn't change for its lifetime,
+    /// allowing data that needs to outlive compaction to be associated with
+    /// a particle. Ids are in the range [0, GetCapacity()).
+    ///
+    /// Each scalar property, and each component of each vector or colour
+    /// property, is stored in its own contiguous stream of floats so that
+    /// updates can be written as simple loops the compiler can vectorise.
+    /// Streams are padded to a multiple of 4 elements so each starts on
+    /// a 16 byte boundary relative to the first. Get and Set methods are
+    /// provided for reading or writing a whole vector for one particle.
+    ///
+    /// This is not thread-safe.
+    //-----------------------------------------------------------------------
+    class ParticleArray final
+    {
+    public:
+        CS_DECLARE_NOCOPY(ParticleArray);
+        //----------------------------------------------------------------
+        /// Constructor.
+        ///
+        /// @param The maximum number of particles.
+        //----------------------------------------------------------------
+        ParticleArray(u32 in_capacity);
+        //----------------------------------------------------------------
+        /// @return The maximum number of particles.
+        //----------------------------------------------------------------
+        u32 GetCapacity() const { return m_capacity; }
+        //----------------------------------------------------------------
+        /// @return The number of live particles.
+        //----------------------------------------------------------------
+        u32 GetSize() const { return m_size; }
+        //----------------------------------------------------------------
+        /// @return Whether or not there is room for another particle.
+        //----------------------------------------------------------------
+        bool IsFull() const { return m_size == m_capacity; }
+        //----------------------------------------------------------------
+        /// Adds a new particle to the end of the live range and assigns it
+        /// a free Id. The particle's properties are left uninitialised.
+        /// The array must not be full.
+        ///
+        /// @return The index of the new particle.
+        //----------------------------------------------------------------
+        u32 Add();
+        //----------------------------------------------------------------
+        /// Removes every particle which has run out of energy. The remaining
+        /// particles are moved down to close the gaps, keeping them in the
+        /// order they were added. Any other data stored per particle index
+        /// should be moved in the same way, so the given delegate is called
+        /// for each particle which moves, in ascending index order.
+        ///
+        /// @param The delegate called with the old and new index of each
+        /// particle which moves.
+        //----------------------------------------------------------------
+        void RemoveExpired(const std::function<void(u32, u32)>& in_moveDelegate);
+        //----------------------------------------------------------------
+        /// Removes all particles.
+        //----------------------------------------------------------------
+        void Clear();
+        //----------------------------------------------------------------
+        /// Copies the live range of the given particle array into this.
+        /// The arrays must have the same capacity.
+        ///
+        /// @param The array to copy.
+        //----------------------------------------------------------------
+        void CopyFrom(const ParticleArray& in_particleArray);
+        //----------------------------------------------------------------
+        /// @return The Id stream.
+        //----------------------------------------------------------------
+        const u32* GetIds() const { return m_ids.data(); }
+        //----------------------------------------------------------------
+        /// @return The lifetime stream.
+        //----------------------------------------------------------------
+        f32* GetLifetimes() { return GetStream(Stream::k_lifetime); }
+        const f32* GetLifetimes() const { return GetStream(Stream::k_lifetime); }
+        //----------------------------------------------------------------
+        /// @return The energy stream. This is the remaining lifetime of
+        /// each particle.
+        //----------------------------------------------------------------
+        f32* GetEnergies() { return GetStream(Stream::k_energy); }
+        const f32* GetEnergies() const { return GetStream(Stream::k_energy); }
+        //----------------------------------------------------------------
+        /// @return The x component stream of the particle positions.
+        //----------------------------------------------------------------
+        f32* GetPositionsX() { return GetStream(Stream::k_positionX); }
+        const f32* GetPositionsX() const { return GetStream(Stream::k_positionX); }
+        //----------------------------------------------------------------
+        /// @return The y component stream of the particle positions.
+        //----------------------------------------------------------------
+        f32* GetPositionsY() { return GetStream(Stream::k_positionY); }
+        const f32* GetPositionsY() const { return GetStream(Stream::k_positionY); }
+        //----------------------------------------------------------------
+        /// @return The z component stream of the particle positions.
+        //----------------------------------------------------------------
+        f32* GetPositionsZ() { return GetStream(Stream::k_positionZ); }
+        const f32* GetPositionsZ() const { return GetStream(Stream::k_positionZ); }
+        //----------------------------------------------------------------
+        /// @return The x component stream of the particle velocities.
+        //----------------------------------------------------------------
+        f32* GetVelocitiesX() { return GetStream(Stream::k_velocityX); }
+        const f32* GetVelocitiesX() const { return GetStream(Stream::k_velocityX); }
+        //----------------------------------------------------------------
+        /// @return The y component stream of the particle velocities.
+        //----------------------------------------------------------------
+        f32* GetVelocitiesY() { return GetStream(Stream::k_velocityY); }
+        const f32* GetVelocitiesY() const { return GetStream(Stream::k_velocityY); }
+        //----------------------------------------------------------------
+        /// @return The z component stream of the particle velocities.
+        //----------------------------------------------------------------
+        f32* GetVelocitiesZ() { return GetStream(Stream::k_velocityZ); }
+        const f32* GetVelocitiesZ() const { return GetStream(Stream::k_velocityZ); }
+        //----------------------------------------------------------------
+        /// @return The x component stream of the particle scales.
+        //----------------------------------------------------------------
+        f32* GetScalesX() { return GetStream(Stream::k_scaleX); }
+        const f32* GetScalesX() const { return GetStream(Stream::k_scaleX); }
+        //----------------------------------------------------------------
+        /// @return The y component stream of the particle scales.
+        //----------------------------------------------------------------
+        f32* GetScalesY() { return GetStream(Stream::k_scaleY); }
+        const f32* GetScalesY() const { return GetStream(Stream::k_scaleY); }
+        //----------------------------------------------------------------
+        /// @return The rotation stream.
+        //----------------------------------------------------------------
+        f32* GetRotations() { return GetStream(Stream::k_rotation); }
+        const f32* GetRotations() const { return GetStream(Stream::k_rotation); }
+        //----------------------------------------------------------------
+        /// @return The angular velocity stream.
+        //----------------------------------------------------------------
+        f32* GetAngularVelocities() { return GetStream(Stream::k_angularVelocity); }
+        const f32* GetAngularVelocities() const { return GetStream(Stream::k_angularVelocity); }
+        //----------------------------------------------------------------
+        /// @return The red component stream of the particle colours.
+        //----------------------------------------------------------------
+        f32* GetColoursR() { return GetStream(Stream::k_colourR); }
+        const f32* GetColoursR() const { return GetStream(Stream::k_colourR); }
+        //----------------------------------------------------------------
+        /// @return The green component stream of the particle colours.
+        //----------------------------------------------------------------
+        f32* GetColoursG() { return GetStream(Stream::k_colourG); }
+        const f32* GetColoursG() const { return GetStream(Stream::k_colourG); }
+        //----------------------------------------------------------------
+        /// @return The blue component stream of the particle colours.
+        //----------------------------------------------------------------
+        f32* GetColoursB() { return GetStream(Stream::k_colourB); }
+        const f32* GetColoursB() const { return GetStream(Stream::k_colourB); }
+        //----------------------------------------------------------------
+        /// @return The alpha component stream of the particle colours.
+        //----------------------------------------------------------------
+        f32* GetColoursA() { return GetStream(Stream::k_colourA); }
+        const f32* GetColoursA() const { return GetStream(Stream::k_colourA); }
+        //----------------------------------------------------------------
+        /// @param The index of the particle.
+        ///
+        /// @return The position of the particle, gathered from the
+        /// component streams.
+        //----------------------------------------------------------------
+        Vector3 GetPosition(u32 in_index) const;
+        //----------------------------------------------------------------
+        /// Scatters the given position into the component streams.
+        ///
+        /// @param The index of the particle.
+        /// @param The position.
+        //----------------------------------------------------------------
+        void SetPosition(u32 in_index, const Vector3& in_position);
+        //----------------------------------------------------------------
+        /// @param The index of the particle.
+        ///
+        /// @return The velocity of the particle, gathered from the
+        /// component streams.
+        //----------------------------------------------------------------
+        Vector3 GetVelocity(u32 in_index) const;
+        //----------------------------------------------------------------
+        /// Scatters the given velocity into the component streams.
+        ///
+        /// @param The index of the particle.
+        /// @param The velocity.
+        //----------------------------------------------------------------
+        void SetVelocity(u32 in_index, const Vector3& in_velocity);
+        //----------------------------------------------------------------
+        /// @param The index of the particle.
+        ///
+        /// @return The scale of the particle, gathered from the component
+        /// streams.
+        //----------------------------------------------------------------
+        Vector2 GetScale(u32 in_index) const;
+        //----------------------------------------------------------------
+        /// Scatters the given scale into the component streams.
+        ///
+        /// @param The index of the particle.
+        /// @param The scale.
+        //----------------------------------------------------------------
+        void SetScale(u32 in_index, const Vector2& in_scale);
+        //----------------------------------------------------------------
+        /// @param The index of the particle.
+        ///
+        /// @return The colour of the particle, gathered from the component
+        /// streams.
+        //----------------------------------------------------------------
+        Colour GetColour(u32 in_index) const;
+        //----------------------------------------------------------------
+        /// Scatters the given colour into the component streams.
+        ///
+        /// @param The index of the particle.
+        /// @param The colour.
+        //----------------------------------------------------------------
+        void SetColour(u32 in_index, const Colour& in_colour);
+
+    private:
+        //----------------------------------------------------------------
+        /// The f32 streams, each of which occupies its own stride-sized
+        /// range of m_streamData.
+        //----------------------------------------------------------------
+        enum class Stream
+        {
+            k_lifetime,
+            k_energy,
+            k_positionX,
+            k_positionY,
+            k_positionZ,
+            k_velocityX,
+            k_velocityY,
+            k_velocityZ,
+            k_scaleX,
+            k_scaleY,
+            k_rotation,
+            k_angularVelocity,
+            k_colourR,
+            k_colourG,
+            k_colourB,
+            k_colourA,
+            k_total
+        };
+        //----------------------------------------------------------------
+        /// @param The stream.
+        ///
+        /// @return A pointer to the first element in the stream.
+        //----------------------------------------------------------------
+        f32* GetStream(Stream in_stream) { return m_streamData.data() + u32(in_stream) * m_streamStride; }
+        const f32* GetStream(Stream in_stream) const { return m_streamData.data() + u32(in_stream) * m_streamStride; }
+
+        u32 m_capacity;
+        u32 m_streamStride;
+        u32 m_size = 0;
+        dynamic_array<u32> m_freeIds;
+        u32 m_numFreeIds;
+
+        dynamic_array<u32> m_ids;
+        dynamic_array<u32> m_keptIndices;
+        dynamic_array<f32> m_streamData;
+    };
+}
+
+#endif
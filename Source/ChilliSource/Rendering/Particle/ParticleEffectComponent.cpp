@@ -36,8 +36,9 @@
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Rendering/Camera/PerspectiveCameraComponent.h>
 #include <ChilliSource/Rendering/Particle/ConcurrentParticleData.h>
-#include <ChilliSource/Rendering/Particle/Particle.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
 #include <ChilliSource/Rendering/Particle/ParticleEffect.h>
+#include <ChilliSource/Rendering/Particle/ParticleUpdateScheduler.h>
 #include <ChilliSource/Rendering/Particle/Affector/ParticleAffector.h>
 #include <ChilliSource/Rendering/Particle/Affector/ParticleAffectorDef.h>
 #include <ChilliSource/Rendering/Particle/Drawable/ParticleDrawable.h>
@@ -52,26 +53,6 @@ namespace ChilliSource
 {
     namespace
     {
-        //----------------------------------------------------------------
-        /// A container for all information required by the background
-        /// particle update.
-        ///
-        /// @author Ian Copland
-        //----------------------------------------------------------------
-        struct ParticleUpdateDesc final
-        {
-            ParticleEffectCSPtr m_particleEffect;
-            ParticleEmitterSPtr m_particleEmitter;
-            std::vector<ParticleAffectorSPtr> m_particleAffectors;
-            std::shared_ptr<dynamic_array<Particle>> m_particleArray;
-            ConcurrentParticleDataSPtr m_concurrentParticleData;
-            f32 m_playbackTime = 0.0f;
-            f32 m_deltaTime = 0.0f; 
-            Vector3 m_entityPosition;
-            Vector3 m_entityScale;
-            Quaternion m_entityOrientation;
-            bool m_interpolateEmission = false;
-        };
         //----------------------------------------------------------------
         /// Performs a series of assertions to ensure the given particle 
         /// effect is ready for use.
@@ -91,119 +72,6 @@ namespace ChilliSource
             CS_ASSERT(in_particleEffect->GetInitialSpeedProperty() != nullptr, "Trying to use incomplete particle effect: Initial speed property missing.");
             CS_ASSERT(in_particleEffect->GetInitialAngularVelocityProperty() != nullptr, "Trying to use incomplete particle effect: Initial angular velocity property missing.");
         }
-        //----------------------------------------------------------------
-        /// Calculates the bounding shapes for the given set of particles.
-        ///
-        /// @author Ian Copland
-        ///
-        /// @param The particle effect.
-        /// @param The array of particles.
-        /// 
-        /// @return a pair containing the AABB and the Bounding Sphere.
-        //----------------------------------------------------------------
-        std::pair<AABB, Sphere> CalculateBoundingShapes(const ParticleEffect* in_particleEffect, const dynamic_array<Particle>* in_particleArray)
-        {
-            Vector3 min = Vector3(std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max(), std::numeric_limits<f32>::max());
-            Vector3 max = Vector3(-std::numeric_limits<f32>::max(), -std::numeric_limits<f32>::max(), -std::numeric_limits<f32>::max());
-
-            bool anyActive = false;
-            for (const auto& particle : *in_particleArray)
-            {
-                if (particle.m_isActive == true)
-                {
-                    anyActive = true;
-
-                    if (particle.m_position.x < min.x)
-                        min.x = particle.m_position.x;
-                    if (particle.m_position.y < min.y)
-                        min.y = particle.m_position.y;
-                    if (particle.m_position.z < min.z)
-                        min.z = particle.m_position.z;
-
-                    if (particle.m_position.x > max.x)
-                        max.x = particle.m_position.x;
-                    if (particle.m_position.y > max.y)
-                        max.y = particle.m_position.y;
-                    if (particle.m_position.z > max.z)
-                        max.z = particle.m_position.z;
-                }
-            }
-
-            if (anyActive == false)
-            {
-                min = Vector3::k_zero;
-                max = Vector3::k_zero;
-            }
-
-            Vector3 size = max - min;
-            Vector3 centre = min + 0.5f * size;
-
-            return std::make_pair(AABB(centre, size), Sphere(centre, size.Length() * 0.5f));
-        }
-        //----------------------------------------------------------------
-        /// Updates the particles on a background thread. This will emit
-        /// new particles, update existing particles and apply particle
-        /// affectors. These changes will then be committed to the 
-        /// draw data array to update the next render.
-        ///
-        /// @author Ian Copland
-        ///
-        /// @param in_desc - The particle update description. This contains
-        /// a snapshot of all data required to update the particle effect.
-        //----------------------------------------------------------------
-        void ParticleUpdateTask(const ParticleUpdateDesc& in_desc)
-        {
-            CS_ASSERT(in_desc.m_particleEffect != nullptr, "Cannot update particles with null particle effect.");
-            CS_ASSERT(in_desc.m_particleArray != nullptr, "Cannot update particles with null particle array.");
-            CS_ASSERT(in_desc.m_concurrentParticleData != nullptr, "Cannot update particles with null concurrent particle data.");
-
-            //update the particles
-            for (auto& particle : *in_desc.m_particleArray)
-            {
-                if (particle.m_isActive == true)
-                {
-                    particle.m_energy -= in_desc.m_deltaTime;
-                    if (particle.m_energy > 0.0f)
-                    {
-                        particle.m_position += particle.m_velocity * in_desc.m_deltaTime;
-                        particle.m_rotation += particle.m_angularVelocity * in_desc.m_deltaTime;
-                    }
-                    else
-                    {
-                        particle.m_energy = 0.0f;
-                        particle.m_isActive = false;
-                    }
-                }
-            }
-
-            //calculate the normalised playback progress.
-            const f32 effectProgress = in_desc.m_playbackTime / in_desc.m_particleEffect->GetDuration();
-            
-            //apply affectors
-            for (auto& affector : in_desc.m_particleAffectors)
-            {
-                affector->AffectParticles(in_desc.m_deltaTime, effectProgress);
-            }
-
-            //try to emit
-            std::vector<u32> newIndices;
-            if (in_desc.m_particleEmitter != nullptr)
-            {
-                newIndices = in_desc.m_particleEmitter->TryEmit(in_desc.m_playbackTime, in_desc.m_entityPosition, in_desc.m_entityScale, in_desc.m_entityOrientation, in_desc.m_interpolateEmission);
-            }
-
-            //Initialise any new particles in each affector.
-            for (u32 newIndex : newIndices)
-            {
-                for (auto& affector : in_desc.m_particleAffectors)
-                {
-                    affector->ActivateParticle(newIndex, effectProgress);
-                }
-            }
-
-            auto boundingShapes = CalculateBoundingShapes(in_desc.m_particleEffect.get(), in_desc.m_particleArray.get());
-            in_desc.m_concurrentParticleData->CommitParticleData(in_desc.m_particleArray.get(), newIndices, boundingShapes.first, boundingShapes.second);
-        }
     }
     CS_DEFINE_NAMEDTYPE(ParticleEffectComponent);
     //-------------------------------------------------------
@@ -325,6 +193,7 @@ namespace ChilliSource
         m_localAABB = AABB();
         m_localBoundingSphere = Sphere();
         m_invalidateBoundingShapeCache = true;
+        InvalidateVolume();
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
@@ -377,7 +246,7 @@ namespace ChilliSource
         {
             ValidateParticleEffect(m_particleEffect);
 
-            m_particleArray = std::make_shared<dynamic_array<Particle>>(m_particleEffect->GetMaxParticles());
+            m_particleArray = std::make_shared<ParticleArray>(m_particleEffect->GetMaxParticles());
             m_concurrentParticleData = std::make_shared<ConcurrentParticleData>(m_particleEffect->GetMaxParticles());
 
             m_drawable = m_particleEffect->GetDrawableDef()->CreateInstance(GetEntity(), m_concurrentParticleData.get());
@@ -401,6 +270,7 @@ namespace ChilliSource
             m_localAABB = AABB();
             m_localBoundingSphere = Sphere();
             m_invalidateBoundingShapeCache = true;
+            InvalidateVolume();
         }
     }
     //-------------------------------------------------------
@@ -422,6 +292,7 @@ namespace ChilliSource
         m_localAABB = m_concurrentParticleData->GetAABB();
         m_localBoundingSphere = m_concurrentParticleData->GetBoundingSphere();
         m_invalidateBoundingShapeCache = true;
+        InvalidateVolume();
     }
     //----------------------------------------------------------------
     //----------------------------------------------------------------
@@ -500,6 +371,9 @@ namespace ChilliSource
     //-------------------------------------------------------
     void ParticleEffectComponent::OnAddedToScene()
     {
+        m_particleUpdateScheduler = Application::Get()->GetSystem<ParticleUpdateScheduler>();
+        CS_ASSERT(m_particleUpdateScheduler != nullptr, "Particle effect component requires the ParticleUpdateScheduler system.");
+
         Play();
     }
     //-------------------------------------------------------
@@ -534,11 +408,8 @@ namespace ChilliSource
     {
         if (m_concurrentParticleData->StartUpdate() == true)
         {
-            //intialise the particles by disabling them all.
-            for (auto& particle : *m_particleArray)
-            {
-                particle.m_isActive = false;
-            }
+            //intialise the particles by removing them all.
+            m_particleArray->Clear();
             m_concurrentParticleData->CommitParticleData(m_particleArray.get(), std::vector<u32>(), AABB(), Sphere());
 
             m_playbackState = PlaybackState::k_playing;
@@ -576,7 +447,7 @@ namespace ChilliSource
         {
             StoreLocalBoundingShapes();
 
-            ParticleUpdateDesc desc;
+            ParticleUpdateScheduler::UpdateDesc desc;
             desc.m_particleEffect = m_particleEffect;
             desc.m_particleEmitter = m_emitter;
             desc.m_particleAffectors = m_affectors;
@@ -588,10 +459,7 @@ namespace ChilliSource
             desc.m_entityScale = GetEntity()->GetTransform().GetWorldScale();
             desc.m_entityOrientation = GetEntity()->GetTransform().GetWorldOrientation();
             desc.m_interpolateEmission = (m_firstFrame == false);
-            Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_small, [=](const TaskContext&) noexcept
-            {
-                ParticleUpdateTask(desc);
-            });
+            m_particleUpdateScheduler->QueueUpdate(desc);
 
             m_firstFrame = false;
             m_accumulatedDeltaTime = 0.0f;
@@ -612,7 +480,7 @@ namespace ChilliSource
             {
                 StoreLocalBoundingShapes();
 
-                ParticleUpdateDesc desc;
+                ParticleUpdateScheduler::UpdateDesc desc;
                 desc.m_particleEffect = m_particleEffect;
                 desc.m_particleEmitter = nullptr;
                 desc.m_particleAffectors = m_affectors;
@@ -624,10 +492,7 @@ namespace ChilliSource
                 desc.m_entityScale = GetEntity()->GetTransform().GetWorldScale();
                 desc.m_entityOrientation = GetEntity()->GetTransform().GetWorldOrientation();
                 desc.m_interpolateEmission = (m_firstFrame == false);
-                Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_small, [=](const TaskContext&) noexcept
-                {
-                    ParticleUpdateTask(desc);
-                });
+                m_particleUpdateScheduler->QueueUpdate(desc);
 
                 m_firstFrame = false;
                 m_accumulatedDeltaTime = 0.0f;
@@ -392,8 +392,9 @@ namespace ChilliSource
         ParticleDrawableUPtr m_drawable;
         ParticleEmitterSPtr m_emitter;
         std::vector<ParticleAffectorSPtr> m_affectors;
-        std::shared_ptr<dynamic_array<Particle>> m_particleArray;
+        std::shared_ptr<ParticleArray> m_particleArray;
         ConcurrentParticleDataSPtr m_concurrentParticleData;
+        ParticleUpdateScheduler* m_particleUpdateScheduler = nullptr;
 
         PlaybackType m_playbackType = PlaybackType::k_once;
         PlaybackState m_playbackState = PlaybackState::k_notPlaying;
@@ -0,0 +1,346 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Rendering/Particle/ParticleUpdateScheduler.h>
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Rendering/Particle/ConcurrentParticleData.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
+#include <ChilliSource/Rendering/Particle/ParticleEffect.h>
+#include <ChilliSource/Rendering/Particle/Affector/ParticleAffector.h>
+#include <ChilliSource/Rendering/Particle/Emitter/ParticleEmitter.h>
+
+#include <algorithm>
+
+namespace ChilliSource
+{
+    namespace
+    {
+        //----------------------------------------------------------------
+        /// The number of particles processed per task. Effects with fewer
+        /// particles than this are coalesced into shared tasks, while
+        /// effects with more are split into chunks of this size.
+        //----------------------------------------------------------------
+        constexpr u32 k_particlesPerTask = 2048;
+        //----------------------------------------------------------------
+        /// @param The number of particles.
+        ///
+        /// @return The number of chunks the given number of particles will
+        /// be split into. This is always at least 1.
+        //----------------------------------------------------------------
+        u32 CalcNumChunks(u32 in_numParticles)
+        {
+            return std::max(1u, (in_numParticles + k_particlesPerTask - 1) / k_particlesPerTask);
+        }
+        //----------------------------------------------------------------
+        /// Calls the given function for each chunk of the range
+        /// [0, in_numParticles). If there is more than one chunk then each
+        /// is processed in a separate child task.
+        ///
+        /// @param The task context used to spawn child tasks.
+        /// @param The number of particles.
+        /// @param The function to call for each chunk. This is passed the
+        /// chunk index, and the first and one-past-last particle index of
+        /// the chunk.
+        //----------------------------------------------------------------
+        template <typename TFunction> void ForEachChunk(const TaskContext& in_taskContext, u32 in_numParticles, const TFunction& in_function)
+        {
+            u32 numChunks = CalcNumChunks(in_numParticles);
+            if (numChunks == 1)
+            {
+                in_function(0, 0, in_numParticles);
+                return;
+            }
+
+            std::vector<Task> tasks;
+            tasks.reserve(numChunks);
+            for (u32 chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+            {
+                tasks.push_back([=, &in_function](const TaskContext& in_innerTaskContext) noexcept
+                {
+                    u32 startIndex = chunkIndex * k_particlesPerTask;
+                    u32 endIndex = std::min(startIndex + k_particlesPerTask, in_numParticles);
+                    in_function(chunkIndex, startIndex, endIndex);
+                });
+            }
+
+            in_taskContext.ProcessChildTasks(tasks);
+        }
+        //----------------------------------------------------------------
+        /// Adds the given rate of change multiplied by the time step to
+        /// each value in the range. This is kept as a plain loop over
+        /// float streams so it can be auto-vectorised.
+        ///
+        /// @param [Out] The stream of values to integrate.
+        /// @param The stream of rates of change.
+        /// @param The first index in the range.
+        /// @param The one-past-last index in the range.
+        /// @param The time step.
+        //----------------------------------------------------------------
+        void IntegrateStream(f32* out_values, const f32* in_rates, u32 in_startIndex, u32 in_endIndex, f32 in_deltaTime)
+        {
+            for (u32 i = in_startIndex; i < in_endIndex; ++i)
+            {
+                out_values[i] += in_rates[i] * in_deltaTime;
+            }
+        }
+        //----------------------------------------------------------------
+        /// Calculates the min and max of the given non-empty range of a
+        /// float stream. Explicit comparisons are used rather than
+        /// std::min() and std::max() as these map directly to SIMD min
+        /// and max instructions without requiring relaxed float semantics.
+        ///
+        /// @param The stream.
+        /// @param The first index in the range.
+        /// @param The one-past-last index in the range.
+        /// @param [Out] The minimum value.
+        /// @param [Out] The maximum value.
+        //----------------------------------------------------------------
+        void CalcStreamRange(const f32* in_values, u32 in_startIndex, u32 in_endIndex, f32& out_min, f32& out_max)
+        {
+            f32 min = in_values[in_startIndex];
+            f32 max = in_values[in_startIndex];
+            for (u32 i = in_startIndex + 1; i < in_endIndex; ++i)
+            {
+                min = in_values[i] < min ? in_values[i] : min;
+                max = in_values[i] > max ? in_values[i] : max;
+            }
+
+            out_min = min;
+            out_max = max;
+        }
+        //----------------------------------------------------------------
+        /// Calculates the bounding shapes for the given set of particles.
+        /// The min and max of each chunk is calculated in parallel, then
+        /// the results are merged in chunk order.
+        ///
+        /// @param The task context used to spawn child tasks.
+        /// @param The array of particles.
+        /// 
+        /// @return a pair containing the AABB and the Bounding Sphere.
+        //----------------------------------------------------------------
+        std::pair<AABB, Sphere> CalculateBoundingShapes(const TaskContext& in_taskContext, const ParticleArray* in_particleArray)
+        {
+            Vector3 min = Vector3::k_zero;
+            Vector3 max = Vector3::k_zero;
+
+            const u32 numParticles = in_particleArray->GetSize();
+            if (numParticles > 0)
+            {
+                std::vector<std::pair<Vector3, Vector3>> chunkBounds(CalcNumChunks(numParticles));
+                ForEachChunk(in_taskContext, numParticles, [&](u32 in_chunkIndex, u32 in_startIndex, u32 in_endIndex)
+                {
+                    Vector3 chunkMin;
+                    Vector3 chunkMax;
+                    CalcStreamRange(in_particleArray->GetPositionsX(), in_startIndex, in_endIndex, chunkMin.x, chunkMax.x);
+                    CalcStreamRange(in_particleArray->GetPositionsY(), in_startIndex, in_endIndex, chunkMin.y, chunkMax.y);
+                    CalcStreamRange(in_particleArray->GetPositionsZ(), in_startIndex, in_endIndex, chunkMin.z, chunkMax.z);
+
+                    chunkBounds[in_chunkIndex] = std::make_pair(chunkMin, chunkMax);
+                });
+
+                min = chunkBounds[0].first;
+                max = chunkBounds[0].second;
+                for (u32 i = 1; i < chunkBounds.size(); ++i)
+                {
+                    min = Vector3::Min(min, chunkBounds[i].first);
+                    max = Vector3::Max(max, chunkBounds[i].second);
+                }
+            }
+
+            Vector3 size = max - min;
+            Vector3 centre = min + 0.5f * size;
+
+            return std::make_pair(AABB(centre, size), Sphere(centre, size.Length() * 0.5f));
+        }
+        //----------------------------------------------------------------
+        /// Updates the particles of a single effect. This will emit new
+        /// particles, update existing particles and apply particle
+        /// affectors. These changes will then be committed to the
+        /// concurrent particle data to update the next render.
+        ///
+        /// Integration, affectors and bounds are processed in parallel
+        /// chunks. Removal of dead particles and emission are performed
+        /// serially.
+        ///
+        /// @param The task context used to spawn child tasks.
+        /// @param The particle update description. This contains a
+        /// snapshot of all data required to update the particle effect.
+        //----------------------------------------------------------------
+        void UpdateParticleEffect(const TaskContext& in_taskContext, const ParticleUpdateScheduler::UpdateDesc& in_desc)
+        {
+            CS_ASSERT(in_desc.m_particleEffect != nullptr, "Cannot update particles with null particle effect.");
+            CS_ASSERT(in_desc.m_particleArray != nullptr, "Cannot update particles with null particle array.");
+            CS_ASSERT(in_desc.m_concurrentParticleData != nullptr, "Cannot update particles with null concurrent particle data.");
+
+            ParticleArray* particleArray = in_desc.m_particleArray.get();
+            const f32 deltaTime = in_desc.m_deltaTime;
+
+            //update all particles. Particles which have run out of energy are also updated, but are removed below.
+            ForEachChunk(in_taskContext, particleArray->GetSize(), [&](u32 in_chunkIndex, u32 in_startIndex, u32 in_endIndex)
+            {
+                f32* energies = particleArray->GetEnergies();
+                for (u32 i = in_startIndex; i < in_endIndex; ++i)
+                {
+                    energies[i] -= deltaTime;
+                }
+
+                IntegrateStream(particleArray->GetPositionsX(), particleArray->GetVelocitiesX(), in_startIndex, in_endIndex, deltaTime);
+                IntegrateStream(particleArray->GetPositionsY(), particleArray->GetVelocitiesY(), in_startIndex, in_endIndex, deltaTime);
+                IntegrateStream(particleArray->GetPositionsZ(), particleArray->GetVelocitiesZ(), in_startIndex, in_endIndex, deltaTime);
+                IntegrateStream(particleArray->GetRotations(), particleArray->GetAngularVelocities(), in_startIndex, in_endIndex, deltaTime);
+            });
+
+            //remove any particles which have run out of energy. The remaining particles keep their emission order, so
+            //batched particles are drawn in a consistent order. The affectors are told to move their data in step.
+            particleArray->RemoveExpired([&](u32 in_fromIndex, u32 in_toIndex)
+            {
+                for (auto& affector : in_desc.m_particleAffectors)
+                {
+                    affector->MoveParticle(in_fromIndex, in_toIndex);
+                }
+            });
+
+            //calculate the normalised playback progress.
+            const f32 effectProgress = in_desc.m_playbackTime / in_desc.m_particleEffect->GetDuration();
+
+            //apply affectors
+            if (in_desc.m_particleAffectors.empty() == false)
+            {
+                ForEachChunk(in_taskContext, particleArray->GetSize(), [&](u32 in_chunkIndex, u32 in_startIndex, u32 in_endIndex)
+                {
+                    for (auto& affector : in_desc.m_particleAffectors)
+                    {
+                        affector->AffectParticles(in_startIndex, in_endIndex, deltaTime, effectProgress);
+                    }
+                });
+            }
+
+            //try to emit
+            std::vector<u32> newIndices;
+            if (in_desc.m_particleEmitter != nullptr)
+            {
+                newIndices = in_desc.m_particleEmitter->TryEmit(in_desc.m_playbackTime, in_desc.m_entityPosition, in_desc.m_entityScale, in_desc.m_entityOrientation, in_desc.m_interpolateEmission);
+            }
+
+            //Initialise any new particles in each affector. The drawable refers to particles by Id rather than index.
+            std::vector<u32> newIds;
+            newIds.reserve(newIndices.size());
+            for (u32 newIndex : newIndices)
+            {
+                for (auto& affector : in_desc.m_particleAffectors)
+                {
+                    affector->ActivateParticle(newIndex, effectProgress);
+                }
+
+                newIds.push_back(particleArray->GetIds()[newIndex]);
+            }
+
+            auto boundingShapes = CalculateBoundingShapes(in_taskContext, particleArray);
+            in_desc.m_concurrentParticleData->CommitParticleData(particleArray, newIds, boundingShapes.first, boundingShapes.second);
+        }
+    }
+
+    CS_DEFINE_NAMEDTYPE(ParticleUpdateScheduler);
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    ParticleUpdateSchedulerUPtr ParticleUpdateScheduler::Create()
+    {
+        return ParticleUpdateSchedulerUPtr(new ParticleUpdateScheduler());
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    bool ParticleUpdateScheduler::IsA(InterfaceIDType in_interfaceId) const
+    {
+        return (ParticleUpdateScheduler::InterfaceID == in_interfaceId);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleUpdateScheduler::QueueUpdate(const UpdateDesc& in_desc)
+    {
+        CS_ASSERT(Application::Get()->GetTaskScheduler()->IsMainThread() == true, "Particle updates must be queued on the main thread.");
+
+        m_queuedUpdates.push_back(in_desc);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleUpdateScheduler::FlushUpdates()
+    {
+        if (m_queuedUpdates.empty() == true)
+        {
+            return;
+        }
+
+        //Group consecutive updates until they contain enough particles to be worth a task. The particle arrays can
+        //safely be read here as none of the queued effects have an update in progress. Effects which are large
+        //enough to fill a task on their own will split their update into child tasks.
+        std::vector<Task> tasks;
+        u32 batchStart = 0;
+        u32 batchParticles = 0;
+        for (u32 i = 0; i < m_queuedUpdates.size(); ++i)
+        {
+            batchParticles += std::max(1u, m_queuedUpdates[i].m_particleArray->GetSize());
+
+            if (batchParticles >= k_particlesPerTask || i == m_queuedUpdates.size() - 1)
+            {
+                std::vector<UpdateDesc> batch(m_queuedUpdates.begin() + batchStart, m_queuedUpdates.begin() + i + 1);
+                tasks.push_back([=](const TaskContext& in_taskContext) noexcept
+                {
+                    for (const auto& desc : batch)
+                    {
+                        UpdateParticleEffect(in_taskContext, desc);
+                    }
+                });
+
+                batchStart = i + 1;
+                batchParticles = 0;
+            }
+        }
+
+        m_queuedUpdates.clear();
+
+        Application::Get()->GetTaskScheduler()->ScheduleTasks(TaskType::k_small, tasks);
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleUpdateScheduler::OnUpdate(f32 in_deltaTime)
+    {
+        FlushUpdates();
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleUpdateScheduler::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    {
+        FlushUpdates();
+    }
+    //----------------------------------------------------------------
+    //----------------------------------------------------------------
+    void ParticleUpdateScheduler::OnDestroy()
+    {
+        m_queuedUpdates.clear();
+    }
+}
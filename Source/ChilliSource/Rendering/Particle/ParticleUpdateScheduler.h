@@ -0,0 +1,132 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_RENDERING_PARTICLE_PARTICLEUPDATESCHEDULER_H_
+#define _CHILLISOURCE_RENDERING_PARTICLE_PARTICLEUPDATESCHEDULER_H_
+
+#include <ChilliSource/ChilliSource.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Core/System/AppSystem.h>
+
+#include <vector>
+
+namespace ChilliSource
+{
+    //-----------------------------------------------------------------------
+    /// Schedules the background updates for all particle effects.
+    ///
+    /// Particle effect components queue their updates with this system
+    /// during the update phase and they are flushed as a set of tasks prior
+    /// to the render snapshot phase. Effects with few particles are
+    /// coalesced into shared tasks to reduce scheduling overhead, while
+    /// effects with many particles are split into chunks which are
+    /// processed in parallel. New particles are always emitted in a single
+    /// task and bounds are merged in chunk order, so the result of an
+    /// update doesn't depend on the number of threads.
+    ///
+    /// This must only be used on the main thread.
+    //-----------------------------------------------------------------------
+    class ParticleUpdateScheduler final : public AppSystem
+    {
+    public:
+        CS_DECLARE_NAMEDTYPE(ParticleUpdateScheduler);
+        //----------------------------------------------------------------
+        /// A container for all information required by the background
+        /// particle update.
+        //----------------------------------------------------------------
+        struct UpdateDesc final
+        {
+            ParticleEffectCSPtr m_particleEffect;
+            ParticleEmitterSPtr m_particleEmitter;
+            std::vector<ParticleAffectorSPtr> m_particleAffectors;
+            std::shared_ptr<ParticleArray> m_particleArray;
+            ConcurrentParticleDataSPtr m_concurrentParticleData;
+            f32 m_playbackTime = 0.0f;
+            f32 m_deltaTime = 0.0f;
+            Vector3 m_entityPosition;
+            Vector3 m_entityScale;
+            Quaternion m_entityOrientation;
+            bool m_interpolateEmission = false;
+        };
+        //----------------------------------------------------------------
+        /// Allows querying of whether or not this implements the interface
+        /// described by the given interface Id.
+        ///
+        /// @param The interface Id.
+        ///
+        /// @return Whether this implements the interface.
+        //----------------------------------------------------------------
+        bool IsA(InterfaceIDType in_interfaceId) const override;
+        //----------------------------------------------------------------
+        /// Queues a particle effect update. This will be started the next
+        /// time queued updates are flushed. The concurrent particle data
+        /// of the effect must have been successfully put in the updating
+        /// state prior to calling this.
+        ///
+        /// @param The update description.
+        //----------------------------------------------------------------
+        void QueueUpdate(const UpdateDesc& in_desc);
+    private:
+        friend class Application;
+        //----------------------------------------------------------------
+        /// Factory method for creating new instances of this system.
+        ///
+        /// @return The instance of this system.
+        //----------------------------------------------------------------
+        static ParticleUpdateSchedulerUPtr Create();
+        //----------------------------------------------------------------
+        /// Default constructor. Declared private to force the use of the
+        /// CreateSystem() method in Application.
+        //----------------------------------------------------------------
+        ParticleUpdateScheduler() = default;
+        //----------------------------------------------------------------
+        /// Groups all queued updates into tasks and schedules them.
+        //----------------------------------------------------------------
+        void FlushUpdates();
+        //----------------------------------------------------------------
+        /// Flushes any updates which were queued after the last render
+        /// snapshot, for example if no scene was rendered.
+        ///
+        /// @param The delta time.
+        //----------------------------------------------------------------
+        void OnUpdate(f32 in_deltaTime) override;
+        //----------------------------------------------------------------
+        /// Flushes all updates queued during the update phase.
+        ///
+        /// @param targetType - The type of target being rendered.
+        /// @param renderSnapshot - The render snapshot.
+        /// @param frameAllocator - The frame allocator.
+        //----------------------------------------------------------------
+        void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept override;
+        //----------------------------------------------------------------
+        /// Discards any queued updates.
+        //----------------------------------------------------------------
+        void OnDestroy() override;
+
+        std::vector<UpdateDesc> m_queuedUpdates;
+    };
+}
+
+#endif
@@ -33,8 +33,7 @@
 
 namespace ChilliSource
 {
-    /// A render command for batching the given set of meshes into a single mesh and applying
-    /// it to the context state.
+    /// A render command for applying a pre-combined batch of meshes to the context state.
     ///
     /// This must be instantiated via a RenderCommandList.
     ///
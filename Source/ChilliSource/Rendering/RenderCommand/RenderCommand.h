@@ -35,7 +35,9 @@ namespace ChilliSource
     /// a type, which can be used to safely cast down to the concrete type, without the need for
     /// virtual calls or RTTI.
     ///
-    /// Render commands should be instantiated within a RenderCommandList.
+    /// Render commands should be instantiated within a RenderCommandList. The base class has no
+    /// virtual destructor, allowing simple commands to be trivially destructible so they can be
+    /// discarded along with the memory they were written to.
     ///
     /// A render command should be immutable and therefore thread safe.
     ///
@@ -68,6 +70,7 @@ namespace ChilliSource
             k_applyMeshBatch,
             k_applySkinnedAnimation,
             k_renderInstance,
+            k_renderInstances,
             k_end,
             k_unloadTargetGroup,
             k_unloadMesh,
@@ -81,8 +84,6 @@ namespace ChilliSource
         ///
         Type GetType() const noexcept { return m_type; }
         
-        virtual ~RenderCommand() noexcept {}
-        
     protected:
         /// Constructs the RenderCommand with the given type.
         ///
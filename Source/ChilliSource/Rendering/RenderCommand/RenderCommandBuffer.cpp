@@ -33,7 +33,7 @@ namespace ChilliSource
         m_renderCommandLists.reserve(numSlots);
         for (u32 i = 0; i < numSlots; ++i)
         {
-            m_renderCommandLists.push_back(RenderCommandListUPtr(new RenderCommandList()));
+            m_renderCommandLists.push_back(RenderCommandListUPtr(new RenderCommandList(m_frameAllocator)));
         }
         
         m_queue.reserve(numSlots);
@@ -43,6 +43,7 @@
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadTextureRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/LoadCubemapRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstanceRenderCommand.h>
+#include <ChilliSource/Rendering/RenderCommand/Commands/RenderInstancesRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreMeshRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreRenderTargetGroupCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/RestoreTextureRenderCommand.h>
@@ -54,272 +55,441 @@
 #include <ChilliSource/Rendering/RenderCommand/Commands/UnloadTextureRenderCommand.h>
 #include <ChilliSource/Rendering/RenderCommand/Commands/UnloadCubemapRenderCommand.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
 namespace ChilliSource
 {
+    namespace
+    {
+        constexpr u32 k_maxPageSize = 16 * 1024;
+        
+        /// Records are aligned to the same boundary as allocations from the linear allocators.
+        ///
+        constexpr u32 k_recordAlignment = u32(sizeof(std::intptr_t));
+        constexpr u32 k_recordHeaderSize = k_recordAlignment;
+        
+        static_assert(sizeof(u32) <= k_recordHeaderSize, "The record header must fit the record size.");
+        
+        /// Calculates the offset of the first record in a page.
+        ///
+        /// @param pageHeaderSize
+        ///     The unaligned size of the page header.
+        ///
+        /// @return The aligned offset.
+        ///
+        constexpr u32 CalcFirstRecordOffset(std::size_t pageHeaderSize) noexcept
+        {
+            return u32((pageHeaderSize + k_recordAlignment - 1) & ~std::size_t(k_recordAlignment - 1));
+        }
+    }
+    
+    constexpr u32 RenderCommandList::k_owningCommandsPerBlock;
+    
     //------------------------------------------------------------------------------
-    void RenderCommandList::AddLoadShaderCommand(RenderShader* renderShader, const std::string& vertexShader, const std::string& fragmentShader) noexcept
+    const RenderCommand* RenderCommandList::const_iterator::operator*() const noexcept
     {
-        RenderCommandUPtr renderCommand(new LoadShaderRenderCommand(renderShader, vertexShader, fragmentShader));
+        CS_ASSERT(m_page, "Cannot dereference the end of a render command list.");
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        return reinterpret_cast<const RenderCommand*>(reinterpret_cast<const u8*>(m_page) + m_offset + k_recordHeaderSize);
     }
     
     //------------------------------------------------------------------------------
-    void RenderCommandList::AddLoadTextureCommand(RenderTexture* renderTexture, std::unique_ptr<const u8[]> textureData, u32 textureDataSize) noexcept
+    RenderCommandList::const_iterator& RenderCommandList::const_iterator::operator++() noexcept
     {
-        RenderCommandUPtr renderCommand(new LoadTextureRenderCommand(renderTexture, std::move(textureData), textureDataSize));
+        CS_ASSERT(m_page, "Cannot increment past the end of a render command list.");
+        
+        m_offset += *reinterpret_cast<const u32*>(reinterpret_cast<const u8*>(m_page) + m_offset);
+        if (m_offset >= m_page->m_size)
+        {
+            m_page = m_page->m_next;
+            m_offset = CalcFirstRecordOffset(sizeof(Page));
+        }
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        return *this;
     }
     
     //------------------------------------------------------------------------------
-    void RenderCommandList::AddLoadCubemapCommand(RenderTexture* renderTexture, std::array<std::unique_ptr<const u8[]>, 6> textureData, u32 textureDataSize) noexcept
+    RenderCommandList::RenderCommandList(IAllocator* allocator) noexcept
+        : m_allocator(allocator), m_pageSize(allocator ? u32(std::min(std::size_t(k_maxPageSize), allocator->GetMaxAllocationSize())) : k_maxPageSize)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandList::RenderCommandList(RenderCommandList&& other) noexcept
+        : m_allocator(other.m_allocator), m_pageSize(other.m_pageSize), m_firstPage(other.m_firstPage), m_lastPage(other.m_lastPage), m_numCommands(other.m_numCommands),
+          m_firstOwningCommandBlock(other.m_firstOwningCommandBlock), m_lastOwningCommandBlock(other.m_lastOwningCommandBlock), m_numOwningCommands(other.m_numOwningCommands)
     {
-        RenderCommandUPtr renderCommand(new LoadCubemapRenderCommand(renderTexture, std::move(textureData), textureDataSize));
+        other.m_firstPage = nullptr;
+        other.m_lastPage = nullptr;
+        other.m_numCommands = 0;
+        other.m_firstOwningCommandBlock = nullptr;
+        other.m_lastOwningCommandBlock = nullptr;
+        other.m_numOwningCommands = 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandList& RenderCommandList::operator=(RenderCommandList&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            
+            m_allocator = other.m_allocator;
+            m_pageSize = other.m_pageSize;
+            m_firstPage = other.m_firstPage;
+            m_lastPage = other.m_lastPage;
+            m_numCommands = other.m_numCommands;
+            m_firstOwningCommandBlock = other.m_firstOwningCommandBlock;
+            m_lastOwningCommandBlock = other.m_lastOwningCommandBlock;
+            m_numOwningCommands = other.m_numOwningCommands;
+            
+            other.m_firstPage = nullptr;
+            other.m_lastPage = nullptr;
+            other.m_numCommands = 0;
+            other.m_firstOwningCommandBlock = nullptr;
+            other.m_lastOwningCommandBlock = nullptr;
+            other.m_numOwningCommands = 0;
+        }
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        return *this;
     }
     
     //------------------------------------------------------------------------------
-    void RenderCommandList::AddLoadMaterialGroupCommand(RenderMaterialGroup* renderMaterialGroup) noexcept
+    template <typename TCommand, typename... TArgs> TCommand* RenderCommandList::CreateCommand(TArgs&&... args) noexcept
     {
-        RenderCommandUPtr renderCommand(new LoadMaterialGroupRenderCommand(renderMaterialGroup));
+        static_assert(std::is_base_of<RenderCommand, TCommand>::value, "Only render commands can be added to a render command list.");
+        static_assert(alignof(TCommand) <= k_recordAlignment, "Render commands cannot require a larger alignment than a record.");
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        constexpr u32 recordSize = u32((k_recordHeaderSize + sizeof(TCommand) + k_recordAlignment - 1) & ~std::size_t(k_recordAlignment - 1));
+        
+        auto record = AllocateRecord(recordSize);
+        ++m_numCommands;
+        
+        return new (record + k_recordHeaderSize) TCommand(std::forward<TArgs>(args)...);
     }
     
     //------------------------------------------------------------------------------
-    void RenderCommandList::AddLoadMeshCommand(RenderMesh* renderMesh, std::unique_ptr<const u8[]> vertexData, u32 vertexDataSize, std::unique_ptr<const u8[]> indexData, u32 indexDataSize) noexcept
+    template <typename TCommand, typename... TArgs> void RenderCommandList::AddCommand(TArgs&&... args) noexcept
     {
-        RenderCommandUPtr renderCommand(new LoadMeshRenderCommand(renderMesh, std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize));
+        static_assert(std::is_trivially_destructible<TCommand>::value, "Render commands which own resources must be added as owning commands.");
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        CreateCommand<TCommand>(std::forward<TArgs>(args)...);
     }
     
     //------------------------------------------------------------------------------
-    void RenderCommandList::AddRestoreTextureCommand(const RenderTexture* renderTexture) noexcept
+    template <typename TCommand, typename... TArgs> void RenderCommandList::AddOwningCommand(TArgs&&... args) noexcept
     {
-        RenderCommandUPtr renderCommand(new RestoreTextureRenderCommand(renderTexture));
+        auto renderCommand = CreateCommand<TCommand>(std::forward<TArgs>(args)...);
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        if (!m_lastOwningCommandBlock || m_lastOwningCommandBlock->m_size == k_owningCommandsPerBlock)
+        {
+            CS_ASSERT(sizeof(OwningCommandBlock) <= m_pageSize, "Owning command blocks must fit within a page.");
+            
+            auto block = new (AllocateMemory(sizeof(OwningCommandBlock))) OwningCommandBlock();
+            block->m_next = nullptr;
+            block->m_size = 0;
+            
+            if (m_lastOwningCommandBlock)
+            {
+                m_lastOwningCommandBlock->m_next = block;
+            }
+            else
+            {
+                m_firstOwningCommandBlock = block;
+            }
+            
+            m_lastOwningCommandBlock = block;
+        }
+        
+        m_lastOwningCommandBlock->m_owningCommands[m_lastOwningCommandBlock->m_size++] = OwningCommand { renderCommand, [](RenderCommand* command) { static_cast<TCommand*>(command)->~TCommand(); } };
+        ++m_numOwningCommands;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddLoadShaderCommand(RenderShader* renderShader, const std::string& vertexShader, const std::string& fragmentShader) noexcept
+    {
+        AddOwningCommand<LoadShaderRenderCommand>(renderShader, vertexShader, fragmentShader);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddLoadTextureCommand(RenderTexture* renderTexture, std::unique_ptr<const u8[]> textureData, u32 textureDataSize) noexcept
+    {
+        AddOwningCommand<LoadTextureRenderCommand>(renderTexture, std::move(textureData), textureDataSize);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddLoadCubemapCommand(RenderTexture* renderTexture, std::array<std::unique_ptr<const u8[]>, 6> textureData, u32 textureDataSize) noexcept
+    {
+        AddOwningCommand<LoadCubemapRenderCommand>(renderTexture, std::move(textureData), textureDataSize);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddLoadMaterialGroupCommand(RenderMaterialGroup* renderMaterialGroup) noexcept
+    {
+        AddOwningCommand<LoadMaterialGroupRenderCommand>(renderMaterialGroup);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddLoadMeshCommand(RenderMesh* renderMesh, std::unique_ptr<const u8[]> vertexData, u32 vertexDataSize, std::unique_ptr<const u8[]> indexData, u32 indexDataSize) noexcept
+    {
+        AddOwningCommand<LoadMeshRenderCommand>(renderMesh, std::move(vertexData), vertexDataSize, std::move(indexData), indexDataSize);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddRestoreTextureCommand(const RenderTexture* renderTexture) noexcept
+    {
+        AddCommand<RestoreTextureRenderCommand>(renderTexture);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddRestoreCubemapCommand(const RenderTexture* renderTexture) noexcept
     {
-        RenderCommandUPtr renderCommand(new RestoreCubemapRenderCommand(renderTexture));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<RestoreCubemapRenderCommand>(renderTexture);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddRestoreMeshCommand(const RenderMesh* renderMesh) noexcept
     {
-        RenderCommandUPtr renderCommand(new RestoreMeshRenderCommand(renderMesh));
-
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<RestoreMeshRenderCommand>(renderMesh);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddRestoreRenderTargetGroupCommand(const RenderTargetGroup* renderTargetGroup) noexcept
     {
-        RenderCommandUPtr renderCommand(new RestoreRenderTargetGroupCommand(renderTargetGroup));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<RestoreRenderTargetGroupCommand>(renderTargetGroup);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddLoadTargetGroupCommand(RenderTargetGroup* renderTargetGroup) noexcept
     {
-        RenderCommandUPtr renderCommand(new LoadTargetGroupRenderCommand(renderTargetGroup));
-
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<LoadTargetGroupRenderCommand>(renderTargetGroup);
     }
     //------------------------------------------------------------------------------
     void RenderCommandList::AddBeginCommand(const Integer2& resolution, const Colour& clearColour) noexcept
     {
-        RenderCommandUPtr renderCommand(new BeginRenderCommand(resolution, clearColour));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<BeginRenderCommand>(resolution, clearColour);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddBeginWithTargetGroupCommand(const RenderTargetGroup* renderTargetGroup, const Colour& clearColour) noexcept
     {
-        RenderCommandUPtr renderCommand(new BeginWithTargetGroupRenderCommand(renderTargetGroup, clearColour));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<BeginWithTargetGroupRenderCommand>(renderTargetGroup, clearColour);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyCameraCommand(const Vector3& position, const Matrix4& viewMatrix, const Matrix4& viewProjectionMatrix) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyCameraRenderCommand(position, viewMatrix, viewProjectionMatrix));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyCameraRenderCommand>(position, viewMatrix, viewProjectionMatrix);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyAmbientLightCommand(const Colour& colour) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyAmbientLightRenderCommand(colour));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyAmbientLightRenderCommand>(colour);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyDirectionalLightCommand(const Colour& colour, const Vector3& direction, const Matrix4& lightViewProjection, f32 shadowTolerance, const RenderTexture* shadowMapRenderTexture) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyDirectionalLightRenderCommand(colour, direction, lightViewProjection, shadowTolerance, shadowMapRenderTexture));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyDirectionalLightRenderCommand>(colour, direction, lightViewProjection, shadowTolerance, shadowMapRenderTexture);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyPointLightCommand(const Colour& colour, const Vector3& position, const Vector3& attenuation) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyPointLightRenderCommand(colour, position, attenuation));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyPointLightRenderCommand>(colour, position, attenuation);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyMaterialCommand(const RenderMaterial* renderMaterial) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyMaterialRenderCommand(renderMaterial));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyMaterialRenderCommand>(renderMaterial);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyMeshCommand(const RenderMesh* renderMesh) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyMeshRenderCommand(renderMesh));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyMeshRenderCommand>(renderMesh);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyDynamicMeshCommand(const RenderDynamicMesh* renderDynamicMesh) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyDynamicMeshRenderCommand(renderDynamicMesh));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplyDynamicMeshRenderCommand>(renderDynamicMesh);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplyMeshBatchCommand(RenderMeshBatchUPtr renderMeshBatch) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplyMeshBatchRenderCommand(std::move(renderMeshBatch)));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddOwningCommand<ApplyMeshBatchRenderCommand>(std::move(renderMeshBatch));
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddApplySkinnedAnimationCommand(const RenderSkinnedAnimation* renderSkinnedAnimation) noexcept
     {
-        RenderCommandUPtr renderCommand(new ApplySkinnedAnimationRenderCommand(renderSkinnedAnimation));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<ApplySkinnedAnimationRenderCommand>(renderSkinnedAnimation);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddRenderInstanceCommand(const Matrix4& worldMatrix) noexcept
     {
-        RenderCommandUPtr renderCommand(new RenderInstanceRenderCommand(worldMatrix));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<RenderInstanceRenderCommand>(worldMatrix);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::AddRenderInstancesCommand(UniquePtr<Matrix4[]> worldMatrices, u32 numInstances) noexcept
+    {
+        AddOwningCommand<RenderInstancesRenderCommand>(std::move(worldMatrices), numInstances);
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddEndCommand() noexcept
     {
-        RenderCommandUPtr renderCommand(new EndRenderCommand());
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddCommand<EndRenderCommand>();
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddUnloadTargetGroupCommand(UniquePtr<RenderTargetGroup> renderTargetGroup) noexcept
     {
-        RenderCommandUPtr renderCommand(new UnloadTargetGroupRenderCommand(std::move(renderTargetGroup)));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddOwningCommand<UnloadTargetGroupRenderCommand>(std::move(renderTargetGroup));
     }
 
     //------------------------------------------------------------------------------
     void RenderCommandList::AddUnloadMeshCommand(UniquePtr<RenderMesh> renderMesh) noexcept
     {
-        RenderCommandUPtr renderCommand(new UnloadMeshRenderCommand(std::move(renderMesh)));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddOwningCommand<UnloadMeshRenderCommand>(std::move(renderMesh));
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddUnloadMaterialGroupCommand(UniquePtr<RenderMaterialGroup> renderMaterialGroup) noexcept
     {
-        RenderCommandUPtr renderCommand(new UnloadMaterialGroupRenderCommand(std::move(renderMaterialGroup)));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddOwningCommand<UnloadMaterialGroupRenderCommand>(std::move(renderMaterialGroup));
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddUnloadTextureCommand(UniquePtr<RenderTexture> renderTexture) noexcept
     {
-        RenderCommandUPtr renderCommand(new UnloadTextureRenderCommand(std::move(renderTexture)));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddOwningCommand<UnloadTextureRenderCommand>(std::move(renderTexture));
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddUnloadCubemapCommand(UniquePtr<RenderTexture> renderTexture) noexcept
     {
-        RenderCommandUPtr renderCommand(new UnloadCubemapRenderCommand(std::move(renderTexture)));
-        
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        AddOwningCommand<UnloadCubemapRenderCommand>(std::move(renderTexture));
     }
     
     //------------------------------------------------------------------------------
     void RenderCommandList::AddUnloadShaderCommand(UniquePtr<RenderShader> renderShader) noexcept
     {
-        RenderCommandUPtr renderCommand(new UnloadShaderRenderCommand(std::move(renderShader)));
+        AddOwningCommand<UnloadShaderRenderCommand>(std::move(renderShader));
+    }
+    //------------------------------------------------------------------------------
+    RenderCommandList::const_iterator RenderCommandList::begin() const noexcept
+    {
+        return const_iterator(m_firstPage, CalcFirstRecordOffset(sizeof(Page)));
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandList::const_iterator RenderCommandList::end() const noexcept
+    {
+        return const_iterator(nullptr, CalcFirstRecordOffset(sizeof(Page)));
+    }
+    
+    //------------------------------------------------------------------------------
+    u8* RenderCommandList::AllocateRecord(u32 recordSize) noexcept
+    {
+        const u32 firstRecordOffset = CalcFirstRecordOffset(sizeof(Page));
+        
+        CS_ASSERT(firstRecordOffset + recordSize <= m_pageSize, "Render command is too large to fit in a render command list page.");
+        
+        if (!m_lastPage || m_lastPage->m_size + recordSize > m_pageSize)
+        {
+            auto page = new (AllocateMemory(m_pageSize)) Page();
+            page->m_next = nullptr;
+            page->m_size = firstRecordOffset;
+            
+            if (m_lastPage)
+            {
+                m_lastPage->m_next = page;
+            }
+            else
+            {
+                m_firstPage = page;
+            }
+            
+            m_lastPage = page;
+        }
         
-        m_orderedCommands.push_back(renderCommand.get());
-        m_renderCommands.push_back(std::move(renderCommand));
+        auto record = reinterpret_cast<u8*>(m_lastPage) + m_lastPage->m_size;
+        *reinterpret_cast<u32*>(record) = recordSize;
+        m_lastPage->m_size += recordSize;
+        
+        return record;
     }
+    
     //------------------------------------------------------------------------------
-    RenderCommand* RenderCommandList::GetCommand(u32 index) noexcept
+    void* RenderCommandList::AllocateMemory(std::size_t size) noexcept
     {
-        CS_ASSERT(index < GetNumCommands(), "Index out of bounds.");
+        return m_allocator ? m_allocator->Allocate(size) : new u8[size];
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::DeallocateMemory(void* memory, std::size_t size) noexcept
+    {
+        if (m_allocator)
+        {
+            m_allocator->Deallocate(memory, size);
+        }
+        else
+        {
+            delete[] reinterpret_cast<u8*>(memory);
+        }
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandList::Reset() noexcept
+    {
+        auto block = m_firstOwningCommandBlock;
+        while (block)
+        {
+            auto nextBlock = block->m_next;
+            
+            for (u32 i = 0; i < block->m_size; ++i)
+            {
+                block->m_owningCommands[i].m_destroy(block->m_owningCommands[i].m_renderCommand);
+            }
+            
+            static_assert(std::is_trivially_destructible<OwningCommandBlock>::value, "Owning command blocks must be trivially destructible.");
+            DeallocateMemory(block, sizeof(OwningCommandBlock));
+            
+            block = nextBlock;
+        }
         
-        return m_renderCommands[index].get();
+        m_firstOwningCommandBlock = nullptr;
+        m_lastOwningCommandBlock = nullptr;
+        m_numOwningCommands = 0;
+        
+        auto page = m_firstPage;
+        while (page)
+        {
+            auto nextPage = page->m_next;
+            
+            DeallocateMemory(page, m_pageSize);
+            
+            page = nextPage;
+        }
+        
+        m_firstPage = nullptr;
+        m_lastPage = nullptr;
+        m_numCommands = 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandList::~RenderCommandList() noexcept
+    {
+        Reset();
     }
 }
@@ -35,19 +35,67 @@
 namespace ChilliSource
 {
     /// Provides the ability to create an ordered list of render commands. Commands are
-    /// created contiguously in memory to improve cache locality and reduce fragmentation.
+    /// written as a linear stream of tagged, fixed size records into pages allocated
+    /// from the given allocator, typically the frame allocator. Each page holds many
+    /// commands, so adding a command doesn't usually require an allocation, and the
+    /// stream is read back sequentially when the commands are processed.
+    ///
+    /// Most commands are trivially destructible and are simply discarded with the pages
+    /// they live in. Commands which own resources, such as load and unload commands,
+    /// are also recorded in an ownership side table so that they can be recycled and
+    /// destroyed explicitly. The side table is stored in fixed size blocks taken from
+    /// the same allocator as the pages, so recording a frame of commands into a list
+    /// backed by the frame allocator doesn't touch the heap.
     ///
     /// This is not thread-safe and therefore should only be accessed from one thread
     /// at a time.
     ///
     class RenderCommandList final
     {
+    private:
+        struct Page;
+        
     public:
         CS_DECLARE_NOCOPY(RenderCommandList);
         
-        RenderCommandList() = default;
-        RenderCommandList(RenderCommandList&&) = default;
-        RenderCommandList& operator=(RenderCommandList&&) = default;
+        /// Iterates over the commands in the list in the order they were added.
+        ///
+        class const_iterator final
+        {
+        public:
+            /// @param page
+            ///     The page the current command is in, or null for the end of the list.
+            /// @param offset
+            ///     The offset of the current command's record within the page.
+            ///
+            const_iterator(const Page* page, u32 offset) noexcept : m_page(page), m_offset(offset) {}
+            
+            /// @return The current render command.
+            ///
+            const RenderCommand* operator*() const noexcept;
+            
+            /// Moves on to the next command in the list.
+            ///
+            const_iterator& operator++() noexcept;
+            
+            bool operator==(const const_iterator& other) const noexcept { return m_page == other.m_page && m_offset == other.m_offset; }
+            bool operator!=(const const_iterator& other) const noexcept { return !(*this == other); }
+            
+        private:
+            const Page* m_page;
+            u32 m_offset;
+        };
+        
+        /// Creates a new empty render command list.
+        ///
+        /// @param allocator
+        ///     (Optional) The allocator from which pages of commands will be allocated. This
+        ///     must outlive the list. If null the pages will be allocated from the free store.
+        ///
+        RenderCommandList(IAllocator* allocator = nullptr) noexcept;
+        
+        RenderCommandList(RenderCommandList&& other) noexcept;
+        RenderCommandList& operator=(RenderCommandList&& other) noexcept;
         
         /// Creates and adds a new load shader command to the render command list.
         ///
@@ -247,6 +295,16 @@ namespace ChilliSource
         ///
         void AddRenderInstanceCommand(const Matrix4& worldMatrix) noexcept;
         
+        /// Creates and adds a new render instances command to the render command list.
+        ///
+        /// @param worldMatrices
+        ///     The world matrix of each instance. This must have been allocated from an
+        ///     IAllocator which outlives the render command list. Must be moved.
+        /// @param numInstances
+        ///     The number of instances.
+        ///
+        void AddRenderInstancesCommand(UniquePtr<Matrix4[]> worldMatrices, u32 numInstances) noexcept;
+        
         /// Creates and adds a new end command to the render command list.
         ///
         void AddEndCommand() noexcept;
@@ -295,20 +353,140 @@ namespace ChilliSource
 
         /// @return The number of render commands in the list.
         ///
-        u32 GetNumCommands() const noexcept { return u32(m_renderCommands.size()); }
+        u32 GetNumCommands() const noexcept { return m_numCommands; }
+        
+        /// @return An iterator to the first command in the list.
+        ///
+        const_iterator begin() const noexcept;
         
-        /// @return The ordered list of render commands.
+        /// @return An iterator to the end of the list.
         ///
-        const std::vector<const RenderCommand*>& GetOrderedList() const noexcept { return m_orderedCommands; };
+        const_iterator end() const noexcept;
         
-        /// @return The RenderCommand at the given index
+        /// @return The number of commands in the list which own resources.
         ///
-        RenderCommand* GetCommand(u32 index) noexcept;
+        u32 GetNumOwningCommands() const noexcept { return m_numOwningCommands; }
+        
+        /// Calls the given function for each command which owns resources, in the order they
+        /// were added. This allows the resources to be reclaimed once the list has been
+        /// processed.
+        ///
+        /// @param function
+        ///     The function to call. This is passed a RenderCommand*.
+        ///
+        template <typename TFunction> void ForEachOwningCommand(const TFunction& function) noexcept;
+        
+        ~RenderCommandList() noexcept;
         
     private:
-        std::vector<const RenderCommand*> m_orderedCommands;
-        std::vector<RenderCommandUPtr> m_renderCommands; //TODO: This should be changed to a series of pools of individial render command types.
+        /// The header at the start of each page. Records follow it contiguously, each of
+        /// which is a u32 record size followed by the command itself.
+        ///
+        struct Page final
+        {
+            Page* m_next;
+            u32 m_size;
+        };
+        
+        /// A command which owns resources, along with the function which destroys it.
+        ///
+        struct OwningCommand final
+        {
+            RenderCommand* m_renderCommand;
+            void (*m_destroy)(RenderCommand*);
+        };
+        
+        /// The number of owning commands stored in each block of the ownership side table.
+        ///
+        static constexpr u32 k_owningCommandsPerBlock = 64;
+        
+        /// A block of the ownership side table.
+        ///
+        struct OwningCommandBlock final
+        {
+            OwningCommandBlock* m_next;
+            u32 m_size;
+            OwningCommand m_owningCommands[k_owningCommandsPerBlock];
+        };
+        
+        /// Constructs a new command of the given type at the end of the command stream.
+        ///
+        /// @param args
+        ///     The arguments passed to the command's constructor.
+        ///
+        /// @return The new command.
+        ///
+        template <typename TCommand, typename... TArgs> TCommand* CreateCommand(TArgs&&... args) noexcept;
+        
+        /// Adds a new command which doesn't own any resources. The command must be trivially
+        /// destructible as it will be discarded along with its page.
+        ///
+        /// @param args
+        ///     The arguments passed to the command's constructor.
+        ///
+        template <typename TCommand, typename... TArgs> void AddCommand(TArgs&&... args) noexcept;
+        
+        /// Adds a new command which owns resources, recording it in the ownership side table so
+        /// that it can be recycled and destroyed.
+        ///
+        /// @param args
+        ///     The arguments passed to the command's constructor.
+        ///
+        template <typename TCommand, typename... TArgs> void AddOwningCommand(TArgs&&... args) noexcept;
+        
+        /// Reserves a new record at the end of the command stream, allocating a new page
+        /// if the record will not fit in the current one.
+        ///
+        /// @param recordSize
+        ///     The size of the record, including its header.
+        ///
+        /// @return The memory for the record.
+        ///
+        u8* AllocateRecord(u32 recordSize) noexcept;
+        
+        /// Allocates memory from the allocator, or the free store if there isn't one.
+        ///
+        /// @param size
+        ///     The size of the allocation.
+        ///
+        /// @return The memory.
+        ///
+        void* AllocateMemory(std::size_t size) noexcept;
+        
+        /// Deallocates memory allocated with AllocateMemory().
+        ///
+        /// @param memory
+        ///     The memory.
+        /// @param size
+        ///     The size of the allocation.
+        ///
+        void DeallocateMemory(void* memory, std::size_t size) noexcept;
+        
+        /// Destroys all owning commands and deallocates all pages, leaving the list empty.
+        ///
+        void Reset() noexcept;
+        
+        IAllocator* m_allocator;
+        u32 m_pageSize;
+        Page* m_firstPage = nullptr;
+        Page* m_lastPage = nullptr;
+        u32 m_numCommands = 0;
+        OwningCommandBlock* m_firstOwningCommandBlock = nullptr;
+        OwningCommandBlock* m_lastOwningCommandBlock = nullptr;
+        u32 m_numOwningCommands = 0;
     };
+    
+    //------------------------------------------------------------------------------
+    template <typename TFunction> void RenderCommandList::ForEachOwningCommand(const TFunction& function) noexcept
+    {
+        for (auto block = m_firstOwningCommandBlock; block; block = block->m_next)
+        {
+            for (u32 i = 0; i < block->m_size; ++i)
+            {
+                function(block->m_owningCommands[i].m_renderCommand);
+            }
+        }
+    }
 }
 
 #endif
@@ -416,6 +416,8 @@ namespace ChilliSource
         m_isBSValid = false;
         m_isAABBValid = false;
         m_isOOBBValid = false;
+        
+        InvalidateVolume();
     }
     //-----------------------------------------------------------
     //-----------------------------------------------------------
@@ -117,6 +117,18 @@ namespace ChilliSource
         ///
         void SetExtraData(void* extraData) noexcept { m_extraData = extraData; }
         
+        /// This is not thread safe and should only be called during render prep.
+        ///
+        /// @return Whether or not the load command for this texture has been issued. Objects
+        ///     using the texture are not rendered until it has.
+        ///
+        bool IsUploaded() const noexcept { return m_isUploaded; }
+        
+        /// Flags the texture as uploaded. This is called during render prep for each texture
+        /// which is loaded in the frame, and is not thread safe.
+        ///
+        void SetUploaded() noexcept { m_isUploaded = true; }
+        
     private:
 
         Integer2 m_dimensions;
@@ -128,6 +140,7 @@ namespace ChilliSource
         bool m_isMipmapped;
         bool m_shouldBackupData = true;
         void* m_extraData = nullptr;
+        bool m_isUploaded = false;
     };
 }
 
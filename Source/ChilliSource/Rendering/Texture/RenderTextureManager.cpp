@@ -24,7 +24,9 @@
 
 #include <ChilliSource/Rendering/Texture/RenderTextureManager.h>
 
+#include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/RenderUploadScheduler.h>
 #include <ChilliSource/Rendering/Base/TargetType.h>
 
 namespace ChilliSource
@@ -54,14 +56,28 @@ namespace ChilliSource
     {
         return (RenderTextureManager::InterfaceID == interfaceId);
     }
+    
+    //------------------------------------------------------------------------------
+    void RenderTextureManager::OnInit() noexcept
+    {
+        m_uploadScheduler = Application::Get()->GetSystem<RenderUploadScheduler>();
+        CS_ASSERT(m_uploadScheduler, "RenderTextureManager requires the RenderUploadScheduler system.");
+    }
         
     //------------------------------------------------------------------------------
     UniquePtr<RenderTexture> RenderTextureManager::CreateTexture2D(std::unique_ptr<const u8[]> textureData, u32 textureDataSize, const Integer2& dimensions, ImageFormat imageFormat, ImageCompression imageCompression,
-                                                               TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData) noexcept
+                                                               TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData,
+                                                               RenderUploadPriority uploadPriority) noexcept
     {
         UniquePtr<RenderTexture> renderTexture(MakeUnique<RenderTexture>(m_renderTexturePool, dimensions, imageFormat, imageCompression, filterMode, wrapModeS, wrapModeT, isMipmapped, shouldBackupData));
         auto rawRenderTexture = renderTexture.get();
         
+        if (textureData)
+        {
+            m_uploadScheduler->AddTextureUpload(rawRenderTexture, std::move(textureData), textureDataSize, uploadPriority);
+            return renderTexture;
+        }
+        
         PendingLoadCommand2D loadCommand;
         loadCommand.m_textureData = std::move(textureData);
         loadCommand.m_textureDataSize = textureDataSize;
@@ -75,18 +91,11 @@ namespace ChilliSource
     
     //------------------------------------------------------------------------------
     UniquePtr<RenderTexture> RenderTextureManager::CreateCubemap(std::array<std::unique_ptr<const u8[]>, 6> textureData, u32 textureDataSize, const Integer2& dimensions, ImageFormat imageFormat, ImageCompression imageCompression,
-                                                             TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData) noexcept
+                                                             TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData,
+                                                             RenderUploadPriority uploadPriority) noexcept
     {
         UniquePtr<RenderTexture> renderTexture(MakeUnique<RenderTexture>(m_renderTexturePool, dimensions, imageFormat, imageCompression, filterMode, wrapModeS, wrapModeT, isMipmapped, shouldBackupData));
-        auto rawRenderTexture = renderTexture.get();
-        
-        PendingLoadCommandCubemap loadCommand;
-        loadCommand.m_textureData = std::move(textureData);
-        loadCommand.m_textureDataSize = textureDataSize;
-        loadCommand.m_renderTexture = rawRenderTexture;
-        
-        std::unique_lock<std::mutex> lock(m_mutex);
-        m_pendingLoadCommandsCubemap.push_back(std::move(loadCommand));
+        m_uploadScheduler->AddCubemapUpload(renderTexture.get(), std::move(textureData), textureDataSize, uploadPriority);
         
         return renderTexture;
     }
@@ -94,6 +103,10 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void RenderTextureManager::DestroyRenderTexture2D(UniquePtr<RenderTexture> renderTexture) noexcept
     {
+        // Render snapshots which are already in flight may still reference the texture, so it is
+        // always released by an unload command, even if its upload never happened.
+        m_uploadScheduler->CancelTextureUpload(renderTexture.get());
+        
         std::unique_lock<std::mutex> lock(m_mutex);
         m_pendingUnloadCommands2D.push_back(std::move(renderTexture));
     }
@@ -101,6 +114,8 @@ namespace ChilliSource
     //------------------------------------------------------------------------------
     void RenderTextureManager::DestroyRenderTextureCubemap(UniquePtr<RenderTexture> renderTexture) noexcept
     {
+        m_uploadScheduler->CancelTextureUpload(renderTexture.get());
+        
         std::unique_lock<std::mutex> lock(m_mutex);
         m_pendingUnloadCommandsCubemap.push_back(std::move(renderTexture));
     }
@@ -121,12 +136,6 @@ namespace ChilliSource
             }
             m_pendingLoadCommands2D.clear();
             
-            for (auto& loadCommand : m_pendingLoadCommandsCubemap)
-            {
-                preRenderCommandList->AddLoadCubemapCommand(loadCommand.m_renderTexture, std::move(loadCommand.m_textureData), loadCommand.m_textureDataSize);
-            }
-            m_pendingLoadCommandsCubemap.clear();
-            
             for (auto& unloadCommand : m_pendingUnloadCommands2D)
             {
                 postRenderCommandList->AddUnloadTextureCommand(std::move(unloadCommand));
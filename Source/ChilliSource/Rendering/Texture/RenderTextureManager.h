@@ -29,6 +29,7 @@
 #include <ChilliSource/Core/Memory/ObjectPoolAllocator.h>
 #include <ChilliSource/Core/Memory/UniquePtr.h>
 #include <ChilliSource/Core/System/AppSystem.h>
+#include <ChilliSource/Rendering/Base/RenderUploadPriority.h>
 #include <ChilliSource/Rendering/Texture/RenderTexture.h>
 
 #include <mutex>
@@ -38,12 +39,15 @@ namespace ChilliSource
 {
     /// Manages the lifecycle of all RenderTexture instances.
     ///
-    /// On creation of a RenderTexture a LoadTextureRenderCommand is queued for the next render
-    /// snapshot phase, ensuring that related textured data is processed before the RenderTexture
-    /// is used.
+    /// On creation of a RenderTexture with texture data, the upload of the data is queued with
+    /// the RenderUploadScheduler, which will issue the LoadTextureRenderCommand once it fits in
+    /// the per-frame upload budget. Textures without data, such as render targets, are queued
+    /// for the next render snapshot phase, ensuring that they are processed before the
+    /// RenderTexture is used.
     ///
     /// On deletion an UnloadTextureRenderCommand is queued and given ownership of the
     /// RenderTexture. The render texture is then deleted once the command has been processed.
+    /// If the texture hadn't yet been uploaded its upload is also cancelled.
     ///
     /// This is thread-safe and can be called from any thread. If it is called on a background
     /// thread, care needs to be taken to ensure any created RenderTextures are not used prior
@@ -65,8 +69,9 @@ namespace ChilliSource
         ///
         bool IsA(InterfaceIDType interfaceId) const noexcept override;
         
-        /// Creates a new render texture and queues a LoadTextureRenderCommand for the next
-        /// Render Snapshot stage in the render pipeline.
+        /// Creates a new render texture and queues the upload of its data. If there is no data
+        /// a LoadTextureRenderCommand is queued for the next Render Snapshot stage in the render
+        /// pipeline instead.
         ///
         /// @param textureData
         ///     The texture data buffer.
@@ -88,14 +93,16 @@ namespace ChilliSource
         ///     Whether or not mipmaps are generated for the texture.
         /// @param shouldBackupData
         ///     If the texture data should be backed up in main memory for restoring it later.
+        /// @param uploadPriority
+        ///     (Optional) The priority with which the texture data is uploaded.
         ///
         /// @return The new render texture instance.
         ///
         UniquePtr<RenderTexture> CreateTexture2D(std::unique_ptr<const u8[]> textureData, u32 textureDataSize, const Integer2& dimensions, ImageFormat imageFormat, ImageCompression imageCompression,
-                                             TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData) noexcept;
+                                             TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData,
+                                             RenderUploadPriority uploadPriority = RenderUploadPriority::k_visible) noexcept;
         
-        /// Creates a new render texture and queues a LoadCubemapRenderCommand for the next
-        /// Render Snapshot stage in the render pipeline.
+        /// Creates a new render texture and queues the upload of its data.
         ///
         /// @param textureData
         ///     The texture data buffer for all 6 faces.
@@ -117,11 +124,14 @@ namespace ChilliSource
         ///     Whether or not mipmaps are generated for the texture.
         /// @param shouldBackupData
         ///     If the texture data should be backed up in main memory for restoring it later.
+        /// @param uploadPriority
+        ///     (Optional) The priority with which the texture data is uploaded.
         ///
         /// @return The new render texture instance.
         ///
         UniquePtr<RenderTexture> CreateCubemap(std::array<std::unique_ptr<const u8[]>, 6> textureData, u32 textureDataSize, const Integer2& dimensions, ImageFormat imageFormat, ImageCompression imageCompression,
-                                           TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData) noexcept;
+                                           TextureFilterMode filterMode, TextureWrapMode wrapModeS, TextureWrapMode wrapModeT, bool isMipmapped, bool shouldBackupData,
+                                             RenderUploadPriority uploadPriority = RenderUploadPriority::k_visible) noexcept;
         
         /// Removes the render texture from the manager and queues an UnloadTextureRenderCommand for
         /// the next Render Snapshot stage in the render pipeline. The render command is given
@@ -156,16 +166,6 @@ namespace ChilliSource
             RenderTexture* m_renderTexture = nullptr;
         };
         
-        /// A container for information relating to pending cubemap load commands, such as the
-        /// texture data, data size and the related RenderTexture.
-        ///
-        struct PendingLoadCommandCubemap final
-        {
-            std::array<std::unique_ptr<const u8[]>, 6> m_textureData;
-            u32 m_textureDataSize = 0;
-            RenderTexture* m_renderTexture = nullptr;
-        };
-        
         /// A factory method for creating new instances of the system. This must be called by
         /// Application.
         ///
@@ -175,6 +175,10 @@ namespace ChilliSource
         
         RenderTextureManager();
         
+        /// Called when the system is initialised.
+        ///
+        void OnInit() noexcept override;
+        
         /// Called during the Render Snapshot stage of the render pipeline. All pending load and
         /// unload commands are added to the render snapshot.
         ///
@@ -187,10 +191,10 @@ namespace ChilliSource
         ///
         void OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept override;
         
+        RenderUploadScheduler* m_uploadScheduler = nullptr;
         std::mutex m_mutex;
         ObjectPoolAllocator<RenderTexture> m_renderTexturePool;
         std::vector<PendingLoadCommand2D> m_pendingLoadCommands2D;
-        std::vector<PendingLoadCommandCubemap> m_pendingLoadCommandsCubemap;
         std::vector<UniquePtr<RenderTexture>> m_pendingUnloadCommands2D;
         std::vector<UniquePtr<RenderTexture>> m_pendingUnloadCommandsCubemap;
     };
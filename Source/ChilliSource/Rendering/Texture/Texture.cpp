@@ -56,7 +56,8 @@ namespace ChilliSource
         m_restoreTextureDataEnabled = textureDesc.IsRestoreTextureDataEnabled();
         
         m_renderTexture = renderTextureManager->CreateTexture2D(std::move(textureData), textureDataSize, textureDesc.GetDimensions(), textureDesc.GetImageFormat(), textureDesc.GetImageCompression(),
-                                                                    textureDesc.GetFilterMode(), textureDesc.GetWrapModeS(), textureDesc.GetWrapModeT(), textureDesc.IsMipmappingEnabled(), m_restoreTextureDataEnabled);
+                                                                    textureDesc.GetFilterMode(), textureDesc.GetWrapModeS(), textureDesc.GetWrapModeT(), textureDesc.IsMipmappingEnabled(), m_restoreTextureDataEnabled,
+                                                                    textureDesc.GetUploadPriority());
     }
 
     //------------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 #include <ChilliSource/Core/Math/Vector2.h>
 #include <ChilliSource/Core/Image/ImageFormat.h>
 #include <ChilliSource/Core/Image/ImageCompression.h>
+#include <ChilliSource/Rendering/Base/RenderUploadPriority.h>
 #include <ChilliSource/Rendering/Texture/TextureFilterMode.h>
 #include <ChilliSource/Rendering/Texture/TextureWrapMode.h>
 
@@ -85,6 +86,13 @@ namespace ChilliSource
         ///
         void SetMipmappingEnabled(bool mipmappingEnabled) noexcept { m_mipmappingEnabled = mipmappingEnabled; };
         
+        /// Sets the priority with which the texture data is uploaded to the GPU.
+        ///
+        /// @param uploadPriority
+        ///     The upload priority.
+        ///
+        void SetUploadPriority(RenderUploadPriority uploadPriority) noexcept { m_uploadPriority = uploadPriority; };
+        
         /// @return The texture dimensions.
         ///
         const Integer2& GetDimensions() const noexcept { return m_dimensions; }
@@ -117,6 +125,10 @@ namespace ChilliSource
         ///
         bool IsRestoreTextureDataEnabled() const noexcept { return m_restoreTextureDataEnabled; }
         
+        /// @return The priority with which the texture data is uploaded to the GPU.
+        ///
+        RenderUploadPriority GetUploadPriority() const noexcept { return m_uploadPriority; }
+        
     private:
         
         /// Sets whether or not the texture data should be restored after a context loss. This involves
@@ -143,6 +155,7 @@ namespace ChilliSource
         TextureWrapMode m_wrapModeT = TextureWrapMode::k_clamp;
         bool m_mipmappingEnabled = false;
         bool m_restoreTextureDataEnabled = true;
+        RenderUploadPriority m_uploadPriority = RenderUploadPriority::k_visible;
     };
 }
 
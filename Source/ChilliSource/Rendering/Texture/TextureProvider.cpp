@@ -30,13 +30,47 @@
 
 #include <ChilliSource/Core/Base/Application.h>
 #include <ChilliSource/Core/Image/Image.h>
+#include <ChilliSource/Core/String/StringUtils.h>
+#include <ChilliSource/Core/String/ToString.h>
+#include <ChilliSource/Core/Threading/FileTaskPriority.h>
+#include <ChilliSource/Core/Threading/FileTaskQueue.h>
 #include <ChilliSource/Core/Threading/TaskScheduler.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureDesc.h>
 #include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 
+#include <cstring>
+
 namespace ChilliSource
 {
+    namespace
+    {
+        /// Converts the upload priority of a texture into the priority with which its file
+        /// is loaded. UI textures are noticeably missing until they load, so are treated as
+        /// blocking.
+        ///
+        /// @param uploadPriority
+        ///     The upload priority.
+        ///
+        /// @return The file task priority.
+        ///
+        FileTaskPriority ToFileTaskPriority(RenderUploadPriority uploadPriority) noexcept
+        {
+            switch (uploadPriority)
+            {
+                case RenderUploadPriority::k_ui:
+                    return FileTaskPriority::k_blocking;
+                case RenderUploadPriority::k_visible:
+                    return FileTaskPriority::k_visible;
+                case RenderUploadPriority::k_prefetch:
+                    return FileTaskPriority::k_prefetch;
+                default:
+                    CS_LOG_FATAL("Invalid upload priority.");
+                    return FileTaskPriority::k_visible;
+            }
+        }
+    }
+    
     CS_DEFINE_NAMEDTYPE(TextureProvider);
     
     const IResourceOptionsBaseCSPtr TextureProvider::s_defaultOptions(std::make_shared<TextureResourceOptions>());
@@ -97,22 +131,79 @@ namespace ChilliSource
     //----------------------------------------------------------------------------
     void TextureProvider::CreateResourceFromFile(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceSPtr& out_resource)
     {
+        //A synchronous load, such as a refresh, supersedes an async load of the same resource which has not yet started.
+        ResourceProvider::AsyncLoadDelegate cancelledDelegate;
+        bool wasCancelled = false;
+        {
+            std::unique_lock<std::mutex> lock(m_pendingLoadsMutex);
+            auto it = m_pendingLoads.find(out_resource.get());
+            if (it != m_pendingLoads.end() && Application::Get()->GetTaskScheduler()->GetFileTaskQueue()->Cancel(it->second.m_taskId))
+            {
+                cancelledDelegate = it->second.m_delegate;
+                wasCancelled = true;
+                ReleaseSharedRead(it->second.m_readKey, it->second.m_sharedRead);
+                m_pendingLoads.erase(it);
+            }
+        }
+        
         LoadTexture(in_location, in_filePath, in_options, nullptr, out_resource);
+        
+        if (wasCancelled && cancelledDelegate != nullptr)
+        {
+            Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
+            {
+                cancelledDelegate(out_resource);
+            });
+        }
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
     void TextureProvider::CreateResourceFromFileAsync(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
     {
-        Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_file, [=](const TaskContext&) noexcept
+        CS_ASSERT(in_options != nullptr, "Options for texture load cannot be null");
+        
+        auto options = static_cast<const TextureResourceOptions*>(in_options.get());
+        auto priority = ToFileTaskPriority(options->GetUploadPriority());
+        
+        //Loads of the same file share one read, which is also used as the coalescing key so
+        //that queued loads start together.
+        auto readKey = ToString(u32(in_location)) + ":" + in_filePath;
+        
+        //The lock is held until the load is recorded, so the task cannot start and look for it first.
+        std::unique_lock<std::mutex> lock(m_pendingLoadsMutex);
+        
+        auto& sharedRead = m_sharedReads[readKey];
+        if (sharedRead == nullptr)
+        {
+            sharedRead = std::make_shared<SharedRead>();
+        }
+        ++sharedRead->m_numLoads;
+        
+        auto taskSharedRead = sharedRead;
+        auto taskId = Application::Get()->GetTaskScheduler()->GetFileTaskQueue()->Add(priority, [=](const TaskContext&) noexcept
         {
-            LoadTexture(in_location, in_filePath, in_options, in_delegate, out_resource);
-        });
+            {
+                std::unique_lock<std::mutex> lock(m_pendingLoadsMutex);
+                m_pendingLoads.erase(out_resource.get());
+            }
+            
+            auto image = ClaimSharedImage(in_location, in_filePath, readKey, taskSharedRead);
+            BuildTexture(image, in_options, in_delegate, out_resource);
+        }, readKey);
+        
+        m_pendingLoads[out_resource.get()] = PendingLoad{taskId, in_delegate, readKey, taskSharedRead};
     }
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
     void TextureProvider::LoadTexture(StorageLocation in_location, const std::string& in_filePath, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
     {
-        CS_ASSERT(in_options != nullptr, "Options for texture load cannot be null");
+        BuildTexture(ReadImage(in_location, in_filePath), in_options, in_delegate, out_resource);
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    ImageSPtr TextureProvider::ReadImage(StorageLocation in_location, const std::string& in_filePath)
+    {
+        ImageSPtr image(Image::Create());
         
         std::string fileName;
         std::string fileExtension;
@@ -131,24 +222,87 @@ namespace ChilliSource
         if(imageProvider == nullptr)
         {
             CS_LOG_ERROR("Cannot find provider for " + in_filePath);
-            out_resource->SetLoadState(Resource::LoadState::k_failed);
-            if(in_delegate != nullptr)
-            {
-                Application::Get()->GetTaskScheduler()->ScheduleTask(TaskType::k_mainThread, [=](const TaskContext&) noexcept
-                {
-                    in_delegate(out_resource);
-                });
-            }
-            return;
+            image->SetLoadState(Resource::LoadState::k_failed);
+            return image;
         }
         
-        ResourceSPtr imageResource(Image::Create());
-        imageProvider->CreateResourceFromFile(in_location, in_filePath, nullptr, imageResource);
-        ImageSPtr image(std::static_pointer_cast<Image>(imageResource));
+        imageProvider->CreateResourceFromFile(in_location, in_filePath, nullptr, image);
         
         if(image->GetLoadState() == Resource::LoadState::k_failed)
         {
             CS_LOG_ERROR("Failed to load image " + in_filePath);
+        }
+        
+        return image;
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    ImageSPtr TextureProvider::ClaimSharedImage(StorageLocation in_location, const std::string& in_filePath, const std::string& in_readKey, const SharedReadSPtr& in_sharedRead)
+    {
+        //Loads of the same file which were not coalesced may run at once, so the first to start reads the
+        //image while any others wait for it.
+        std::unique_lock<std::mutex> readLock(in_sharedRead->m_mutex);
+        
+        if(in_sharedRead->m_image == nullptr)
+        {
+            in_sharedRead->m_image = ReadImage(in_location, in_filePath);
+        }
+        
+        auto image = in_sharedRead->m_image;
+        
+        bool isLastLoad = false;
+        {
+            std::unique_lock<std::mutex> lock(m_pendingLoadsMutex);
+            isLastLoad = ReleaseSharedRead(in_readKey, in_sharedRead);
+        }
+        
+        //The last load takes the data itself, while earlier loads take a copy, made before the read lock is
+        //released so the last load cannot move the data first.
+        if(!isLastLoad && image->GetLoadState() == Resource::LoadState::k_loaded)
+        {
+            Image::Descriptor desc;
+            desc.m_compression = image->GetCompression();
+            desc.m_format = image->GetFormat();
+            desc.m_width = image->GetWidth();
+            desc.m_height = image->GetHeight();
+            desc.m_dataSize = image->GetDataSize();
+            
+            Image::ImageDataUPtr data(new u8[desc.m_dataSize]);
+            std::memcpy(data.get(), image->GetData(), desc.m_dataSize);
+            
+            ImageSPtr copy(Image::Create());
+            copy->Build(desc, std::move(data));
+            copy->SetLoadState(Resource::LoadState::k_loaded);
+            return copy;
+        }
+        
+        return image;
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    bool TextureProvider::ReleaseSharedRead(const std::string& in_readKey, const SharedReadSPtr& in_sharedRead)
+    {
+        CS_ASSERT(in_sharedRead->m_numLoads > 0, "Shared read has already been released by every load.");
+        
+        if(--in_sharedRead->m_numLoads > 0)
+        {
+            return false;
+        }
+        
+        //Loads queued after this read a new copy of the file.
+        m_sharedReads.erase(in_readKey);
+        return true;
+    }
+    //----------------------------------------------------------------------------
+    //----------------------------------------------------------------------------
+    void TextureProvider::BuildTexture(const ImageSPtr& in_image, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource)
+    {
+        CS_ASSERT(in_options != nullptr, "Options for texture load cannot be null");
+        
+        auto image = in_image;
+        
+        if(image->GetLoadState() == Resource::LoadState::k_failed)
+        {
             out_resource->SetLoadState(Resource::LoadState::k_failed);
             if(in_delegate != nullptr)
             {
@@ -170,6 +324,7 @@ namespace ChilliSource
             desc.SetWrapModeS(options->GetWrapModeS());
             desc.SetWrapModeT(options->GetWrapModeT());
             desc.SetMipmappingEnabled(options->IsMipMapsEnabled());
+            desc.SetUploadPriority(options->GetUploadPriority());
 
             texture->Build(Texture::DataUPtr(image->MoveData()), image->GetDataSize(), desc);
             texture->SetLoadState(Resource::LoadState::k_loaded);
@@ -186,6 +341,7 @@ namespace ChilliSource
                 desc.SetWrapModeS(options->GetWrapModeS());
                 desc.SetWrapModeT(options->GetWrapModeT());
                 desc.SetMipmappingEnabled(options->IsMipMapsEnabled());
+                desc.SetUploadPriority(options->GetUploadPriority());
 
                 texture->Build(Texture::DataUPtr(image->MoveData()), image->GetDataSize(), desc);
                 texture->SetLoadState(Resource::LoadState::k_loaded);
@@ -31,6 +31,10 @@
 
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Resource/ResourceProvider.h>
+#include <ChilliSource/Core/Threading/FileTaskQueue.h>
+
+#include <mutex>
+#include <unordered_map>
 
 namespace ChilliSource
 {
@@ -78,7 +82,9 @@ namespace ChilliSource
         bool CanCreateResourceWithFileExtension(const std::string& in_extension) const override;
         //----------------------------------------------------------------------------
         /// Loads the image and generate the texture via the output resource.
-        /// Check the resource load state for success or failure.
+        /// Check the resource load state for success or failure. If the resource
+        /// has an async load which has not yet started, it is cancelled and its
+        /// delegate is called once this load is complete.
         ///
         /// @author S Downie
         ///
@@ -92,6 +98,11 @@ namespace ChilliSource
         /// Loads the image on a background thread and generate the texture via the output resource.
         /// Delegate is called on completion. Check the resource load state for success or failure
         ///
+        /// The file is loaded with the priority matching the texture's upload priority.
+        /// Loads of the same file which are waiting to start are merged, and started at
+        /// the higher of their priorities. The file is read once for all of the loads
+        /// queued while it is being read, and each builds its own texture from it.
+        ///
         /// @author S Downie
         ///
         /// @param Location to load from
@@ -140,7 +151,85 @@ namespace ChilliSource
         
     private:
         
+        /// An image which is read once and shared by each async load of the same file.
+        ///
+        struct SharedRead final
+        {
+            std::mutex m_mutex;
+            ImageSPtr m_image;
+            u32 m_numLoads = 0;
+        };
+        
+        using SharedReadSPtr = std::shared_ptr<SharedRead>;
+        
+        /// An async load which has been queued but not yet started.
+        ///
+        struct PendingLoad final
+        {
+            FileTaskQueue::TaskId m_taskId;
+            ResourceProvider::AsyncLoadDelegate m_delegate;
+            std::string m_readKey;
+            SharedReadSPtr m_sharedRead;
+        };
+        
+        /// Reads the given image file using the image provider for its extension.
+        ///
+        /// @param in_location
+        ///     The location to load from.
+        /// @param in_filePath
+        ///     The file path.
+        ///
+        /// @return The image. Check its load state for success or failure.
+        ///
+        ImageSPtr ReadImage(StorageLocation in_location, const std::string& in_filePath);
+        
+        /// Returns the image from the given shared read, reading it first if this is the
+        /// first load of the file to start. If other loads still need the image, a copy is
+        /// returned so the data can be moved into a texture.
+        ///
+        /// @param in_location
+        ///     The location to load from.
+        /// @param in_filePath
+        ///     The file path.
+        /// @param in_readKey
+        ///     The key of the shared read.
+        /// @param in_sharedRead
+        ///     The shared read.
+        ///
+        /// @return The image, which is owned by the caller.
+        ///
+        ImageSPtr ClaimSharedImage(StorageLocation in_location, const std::string& in_filePath, const std::string& in_readKey, const SharedReadSPtr& in_sharedRead);
+        
+        /// Releases a load's use of the given shared read, removing it once no loads remain.
+        /// The pending loads mutex must be held.
+        ///
+        /// @param in_readKey
+        ///     The key of the shared read.
+        /// @param in_sharedRead
+        ///     The shared read.
+        ///
+        /// @return Whether or not this was the last load using the shared read.
+        ///
+        bool ReleaseSharedRead(const std::string& in_readKey, const SharedReadSPtr& in_sharedRead);
+        
+        /// Builds the texture from the given image. This is done on the main thread if a
+        /// delegate is provided, otherwise it is done immediately.
+        ///
+        /// @param in_image
+        ///     The image, whose data is moved into the texture.
+        /// @param in_options
+        ///     The options to customise the creation.
+        /// @param in_delegate
+        ///     The completion delegate, which may be null.
+        /// @param out_resource
+        ///     The texture resource.
+        ///
+        void BuildTexture(const ImageSPtr& in_image, const IResourceOptionsBaseCSPtr& in_options, const ResourceProvider::AsyncLoadDelegate& in_delegate, const ResourceSPtr& out_resource);
+        
         std::vector<ResourceProvider*> m_imageProviders;
+        std::mutex m_pendingLoadsMutex;
+        std::unordered_map<const Resource*, PendingLoad> m_pendingLoads;
+        std::unordered_map<std::string, SharedReadSPtr> m_sharedReads;
         static const IResourceOptionsBaseCSPtr s_defaultOptions;
     };
 }
@@ -43,6 +43,12 @@ namespace ChilliSource
     }
     //-------------------------------------------------------
     //-------------------------------------------------------
+    TextureResourceOptions::TextureResourceOptions(RenderUploadPriority in_uploadPriority)
+        : m_uploadPriority(in_uploadPriority)
+    {
+    }
+    //-------------------------------------------------------
+    //-------------------------------------------------------
     u32 TextureResourceOptions::GenerateHash() const
     {
         return HashCRC32::GenerateHashCode((const s8*)&m_options, sizeof(Options));
@@ -71,5 +77,11 @@ namespace ChilliSource
     {
         return m_options.m_filterMode;
     }
+    //-------------------------------------------------------
+    //-------------------------------------------------------
+    RenderUploadPriority TextureResourceOptions::GetUploadPriority() const
+    {
+        return m_uploadPriority;
+    }
 }
 
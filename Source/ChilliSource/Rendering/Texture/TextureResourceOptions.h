@@ -32,6 +32,7 @@
 
 #include <ChilliSource/ChilliSource.h>
 #include <ChilliSource/Core/Resource/IResourceOptions.h>
+#include <ChilliSource/Rendering/Base/RenderUploadPriority.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureFilterMode.h>
 #include <ChilliSource/Rendering/Texture/TextureWrapMode.h>
@@ -73,6 +74,16 @@ namespace ChilliSource
         //-------------------------------------------------------
         TextureResourceOptions(bool in_mipmaps, TextureFilterMode in_filter, TextureWrapMode in_wrapS, TextureWrapMode in_wrapT);
         //-------------------------------------------------------
+        /// Constructor. Creates options with the default texture
+        /// settings and the given upload priority.
+        ///
+        /// @param The priority with which the texture data is
+        /// uploaded to the GPU. This doesn't affect the loaded
+        /// texture, so isn't included in the hash; a texture that
+        /// is already loaded will be returned regardless.
+        //-------------------------------------------------------
+        explicit TextureResourceOptions(RenderUploadPriority in_uploadPriority);
+        //-------------------------------------------------------
         /// Generate a unique hash based on the
         /// currently set options
         ///
@@ -106,6 +117,11 @@ namespace ChilliSource
         /// @return Filter mode to create texture with
         //-------------------------------------------------------
         TextureFilterMode GetFilterMode() const;
+        //-------------------------------------------------------
+        /// @return The priority with which the texture data is
+        /// uploaded to the GPU.
+        //-------------------------------------------------------
+        RenderUploadPriority GetUploadPriority() const;
         
     private:
         
@@ -124,6 +140,7 @@ namespace ChilliSource
         };
         
         Options m_options;
+        RenderUploadPriority m_uploadPriority = RenderUploadPriority::k_visible;
     };
 }
 
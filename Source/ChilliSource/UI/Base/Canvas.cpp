@@ -145,6 +145,18 @@ namespace ChilliSource
     {
         m_canvas->OnDraw(in_renderer);
     }
+    //----------------------------------------------------
+    //----------------------------------------------------
+    void Canvas::UpdateLayout()
+    {
+        m_numLayoutsLastUpdate = m_canvas->ResolveLayout();
+    }
+    //----------------------------------------------------
+    //----------------------------------------------------
+    u32 Canvas::GetNumLayoutsLastUpdate() const
+    {
+        return m_numLayoutsLastUpdate;
+    }
     //-------------------------------------------------------
     //-------------------------------------------------------
     void Canvas::OnBackground()
@@ -71,6 +71,19 @@ namespace ChilliSource
         //----------------------------------------------------
         void Draw(CanvasRenderer* in_renderer) const;
         //----------------------------------------------------
+        /// Lays out any widgets which have changed since the
+        /// last layout pass. Changes to widgets only mark them
+        /// as dirty, so this is called once per frame prior
+        /// to drawing to resolve them in a single top-down
+        /// pass.
+        //----------------------------------------------------
+        void UpdateLayout();
+        //----------------------------------------------------
+        /// @return The number of widgets laid out in the most
+        /// recent layout pass.
+        //----------------------------------------------------
+        u32 GetNumLayoutsLastUpdate() const;
+        //----------------------------------------------------
         /// Adds a widget to the canvas. The widget
         /// will be rendered and updated. Any relative coordinates
         /// will now be in relation to this widget.
@@ -267,6 +280,7 @@ namespace ChilliSource
     private:
         
         WidgetUPtr m_canvas;
+        u32 m_numLayoutsLastUpdate = 0;
         EventConnectionUPtr m_screenResizedConnection;
         EventConnectionUPtr m_pointerAddedConnection;
         EventConnectionUPtr m_pointerDownConnection;
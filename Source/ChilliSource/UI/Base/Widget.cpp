@@ -1272,6 +1272,14 @@ namespace ChilliSource
         
         if (m_layoutComponent != nullptr)
         {
+            //If the layout is queried before the layout pass it needs to be built first. The flag is cleared prior to
+            //building as building the layout can query the layout for a child.
+            if (m_canvas != nullptr && m_isLayoutComponentDirty == true)
+            {
+                m_isLayoutComponentDirty = false;
+                m_layoutComponent->BuildLayout();
+            }
+            
             for(u32 i=0; i<m_children.size(); ++i)
             {
                 if(m_children[i].get() == in_child)
@@ -1376,6 +1384,14 @@ namespace ChilliSource
     //----------------------------------------------------------------------------------------
     void Widget::OnParentTransformChanged()
     {
+        //If every cache is already invalid and the widget is dirty then nothing has been re-calculated since the
+        //last invalidation, so the children are already invalid too. This stops repeated changes to a widget within
+        //a frame from walking the whole sub-tree each time.
+        if (m_isLayoutDirty == true && m_isParentTransformCacheValid == false && m_isParentSizeCacheValid == false && m_isLocalTransformCacheValid == false && m_isLocalSizeCacheValid == false)
+        {
+            return;
+        }
+        
         m_isParentTransformCacheValid = false;
         m_isParentSizeCacheValid = false;
         
@@ -1557,12 +1573,13 @@ namespace ChilliSource
         m_isLocalTransformCacheValid = false;
         m_isLocalSizeCacheValid = false;
         
-        if(m_canvas != nullptr)
+        m_isLayoutDirty = true;
+        m_isLayoutComponentDirty = true;
+        
+        //Flag the path to the root so the layout pass can find this widget without visiting clean sub-trees.
+        for (Widget* parent = m_parent; parent != nullptr && parent->m_isDescendantLayoutDirty == false; parent = parent->m_parent)
         {
-            if(m_layoutComponent != nullptr)
-            {
-                m_layoutComponent->BuildLayout();
-            }
+            parent->m_isDescendantLayoutDirty = true;
         }
         
         for(auto& child : m_internalChildren)
@@ -1574,11 +1591,54 @@ namespace ChilliSource
         {
             child->OnParentTransformChanged();
         }
+    }
+    //----------------------------------------------------------------------------------------
+    //----------------------------------------------------------------------------------------
+    u32 Widget::ResolveLayout()
+    {
+        u32 numLayouts = 0;
         
-        if (m_canvas != nullptr && m_isInputEnabled == true)
+        if (m_isLayoutDirty == true)
         {
-            UpdateAllContainedPointers();
+            m_isLayoutDirty = false;
+            
+            if (m_canvas != nullptr)
+            {
+                if (m_layoutComponent != nullptr && m_isLayoutComponentDirty == true)
+                {
+                    m_isLayoutComponentDirty = false;
+                    m_layoutComponent->BuildLayout();
+                }
+                
+                if (m_isInputEnabled == true)
+                {
+                    UpdateAllContainedPointers();
+                }
+            }
+            
+            ++numLayouts;
+        }
+        
+        if (m_isDescendantLayoutDirty == true)
+        {
+            m_isDescendantLayoutDirty = false;
+            
+            m_internalChildren.lock();
+            for(auto& child : m_internalChildren)
+            {
+                numLayouts += child->ResolveLayout();
+            }
+            m_internalChildren.unlock();
+            
+            m_children.lock();
+            for(auto& child : m_children)
+            {
+                numLayouts += child->ResolveLayout();
+            }
+            m_children.unlock();
         }
+        
+        return numLayouts;
     }
     //------------------------------------------------------------------------------
     //------------------------------------------------------------------------------
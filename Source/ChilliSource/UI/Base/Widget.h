@@ -844,7 +844,10 @@ namespace ChilliSource
         Vector2 ToLocalSpace(const Vector2& in_point, AlignmentAnchor in_alignmentAnchor) const;
         //------------------------------------------------------------------------------
         /// Invalidates all caches, ensuring the transform for the widget and its
-        /// children are re-calculated the next time it is rendered.
+        /// children are re-calculated the next time it is rendered. This doesn't
+        /// perform the layout immediately; the widget is marked as dirty and laid out
+        /// in the canvas layout pass which occurs once per frame prior to drawing. If
+        /// the layout is queried before then it is built on demand.
         ///
         /// @author Ian Copland
         //------------------------------------------------------------------------------
@@ -1103,6 +1106,14 @@ namespace ChilliSource
         //----------------------------------------------------------------------------------------
         void OnParentTransformChanged();
         //----------------------------------------------------------------------------------------
+        /// Rebuilds the layout of this widget and any of its descendants which have been
+        /// marked as dirty since the last layout pass, skipping any clean sub-trees. This is
+        /// called by the canvas once per frame prior to drawing.
+        ///
+        /// @return The number of widgets which were laid out.
+        //----------------------------------------------------------------------------------------
+        u32 ResolveLayout();
+        //----------------------------------------------------------------------------------------
         /// Resumes the widget, its components and its children. This is called when the widget
         /// is attached to the canvas and every time the state that owns the canvas is resumed while
         /// the widget is attached.
@@ -1256,6 +1267,10 @@ namespace ChilliSource
         mutable bool m_isLocalTransformCacheValid = false;
         mutable bool m_isLocalSizeCacheValid = false;
         mutable bool m_isParentSizeCacheValid = false;
+        
+        bool m_isLayoutDirty = true;
+        bool m_isLayoutComponentDirty = true;
+        bool m_isDescendantLayoutDirty = false;
 
         Screen* m_screen = nullptr;
         PointerSystem* m_pointerSystem = nullptr;
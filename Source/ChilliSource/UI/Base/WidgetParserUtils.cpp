@@ -39,6 +39,7 @@
 #include <ChilliSource/Rendering/Font/Font.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureAtlas.h>
+#include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 #include <ChilliSource/UI/Base/PropertyTypes.h>
 #include <ChilliSource/UI/Base/Widget.h>
 #include <ChilliSource/UI/Base/WidgetDef.h>
@@ -107,7 +108,7 @@ namespace ChilliSource
             if (propertyType == PropertyTypes::Texture())
             {
                 auto resourcePair = ParseResource(in_jsonValue, in_relStorageLocation, in_relDirectoryPath);
-                auto texture = Application::Get()->GetResourcePool()->LoadResource<Texture>(resourcePair.first, resourcePair.second);
+                auto texture = Application::Get()->GetResourcePool()->LoadResource<Texture>(resourcePair.first, resourcePair.second, std::make_shared<TextureResourceOptions>(RenderUploadPriority::k_ui));
                 out_propertyMap.SetProperty(in_propertyName, texture);
             }
             else if (propertyType == PropertyTypes::TextureAtlas())
@@ -34,6 +34,7 @@
 #include <ChilliSource/Rendering/Base/CanvasDrawMode.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureAtlas.h>
+#include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 #include <ChilliSource/UI/Drawable/StandardUIDrawable.h>
 
 #include <json/json.h>
@@ -123,7 +124,7 @@ namespace ChilliSource
             texturePath = StringUtils::StandardiseDirectoryPath(in_defaultPath) + texturePath;
         }
         
-        m_texture = resPool->LoadResource<Texture>(textureLocation, texturePath);
+        m_texture = resPool->LoadResource<Texture>(textureLocation, texturePath, std::make_shared<TextureResourceOptions>(RenderUploadPriority::k_ui));
         CS_ASSERT(m_texture != nullptr, "Invalid texture supplied in a Standard UIDrawable Def.");
         
         //try and load the atlas
@@ -34,6 +34,7 @@
 #include <ChilliSource/Rendering/Base/CanvasDrawMode.h>
 #include <ChilliSource/Rendering/Texture/Texture.h>
 #include <ChilliSource/Rendering/Texture/TextureAtlas.h>
+#include <ChilliSource/Rendering/Texture/TextureResourceOptions.h>
 
 namespace ChilliSource
 {
@@ -166,7 +167,7 @@ namespace ChilliSource
             texturePath = StringUtils::StandardiseDirectoryPath(in_defaultPath) + texturePath;
         }
         
-        m_texture = resPool->LoadResource<Texture>(textureLocation, texturePath);
+        m_texture = resPool->LoadResource<Texture>(textureLocation, texturePath, std::make_shared<TextureResourceOptions>(RenderUploadPriority::k_ui));
         CS_ASSERT(m_texture != nullptr, "Invalid texture supplied in a Three-Patch UIDrawable Def.");
         
         //try and load the atlas
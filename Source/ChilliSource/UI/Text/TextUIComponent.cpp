@@ -498,6 +498,8 @@ namespace ChilliSource
             m_invalidateCache = true;
         }
         
+        Colour textColour = m_textColour * GetWidget()->GetFinalColour();
+        
         if (m_invalidateCache == true)
         {
             m_invalidateCache = false;
@@ -505,10 +507,18 @@ namespace ChilliSource
             f32 textScale = 1.0f;
             m_cachedText = in_renderer->BuildText(m_text, m_font, in_absSize, m_textProperties, textScale);
             m_cachedIcons = BuildIcons(m_font, m_cachedText, m_iconIndices, textScale);
+            
+            m_cachedTextMesh = in_renderer->BuildTextMesh(m_cachedText.m_characters, textColour);
+            m_cachedTextMeshColour = textColour;
+        }
+        else if (m_cachedTextMeshColour != textColour)
+        {
+            m_cachedTextMesh = in_renderer->BuildTextMesh(m_cachedText.m_characters, textColour);
+            m_cachedTextMeshColour = textColour;
         }
         
         // Draw text
-        in_renderer->DrawText(m_cachedText.m_characters, in_transform, m_textColour * GetWidget()->GetFinalColour(), m_font->GetTexture());
+        in_renderer->DrawText(m_cachedTextMesh, in_transform, m_font->GetTexture());
         
         // Draw images
         for(const auto& iconData : m_cachedIcons)
@@ -496,6 +496,8 @@ namespace ChilliSource
         bool m_invalidateCache = true;
         Vector2 m_cachedSize;
         CanvasRenderer::BuiltText m_cachedText;
+        CanvasRenderer::BuiltTextMesh m_cachedTextMesh;
+        Colour m_cachedTextMeshColour;
         std::vector<TextIconCachedData> m_cachedIcons;
         
         StringMarkupParser m_markupParser;
@@ -0,0 +1,270 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <CSBackend/Platform/Android/Main/JNI/Core/File/ZippedFileSystem.h>
+
+#include <ChilliSource/Core/Base/ByteBuffer.h>
+#include <ChilliSource/Core/Base/Utils.h>
+#include <ChilliSource/Core/Container/ParamDictionary.h>
+#include <ChilliSource/Core/File/FileStream/IBinaryInputStream.h>
+#include <ChilliSource/Core/String/StringParser.h>
+#include <ChilliSource/Core/String/UTF8StringUtils.h>
+
+#include <minizip/zip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ChilliSource;
+using namespace CSBackend::Android;
+
+namespace
+{
+    constexpr u32 k_numFilesPerMethod = 1000;
+    constexpr u32 k_fileSize = 16 * 1024;
+    constexpr u32 k_minMaxThreads = 4;
+    
+    /// How a file is stored in the test zip.
+    ///
+    enum class Method
+    {
+        k_stored,
+        k_deflated
+    };
+    
+    /// @return The path of the file with the given index in the test zip.
+    ///
+    std::string GetFilePath(Method method, u32 fileIndex) noexcept
+    {
+        return std::string(method == Method::k_stored ? "stored/" : "deflated/") + std::to_string(fileIndex) + ".bin";
+    }
+    
+    /// @return The contents of the file with the given index. Stored files are noise, like
+    ///     already compressed textures, while deflated files are repetitive, like text.
+    ///
+    std::vector<u8> CreateFileContents(Method method, u32 fileIndex) noexcept
+    {
+        std::vector<u8> contents(k_fileSize);
+        u32 state = fileIndex * 2654435761u + 1;
+        for (u32 i = 0; i < k_fileSize; ++i)
+        {
+            if (method == Method::k_stored)
+            {
+                state = state * 1664525u + 1013904223u;
+                contents[i] = u8(state >> 24);
+            }
+            else
+            {
+                contents[i] = u8('a' + (i + fileIndex) % 16 + (i / 64) % 3);
+            }
+        }
+        
+        return contents;
+    }
+    
+    /// Writes a zip containing the stored and deflated test files.
+    ///
+    /// @param zipFilePath
+    ///     The path to write the zip to.
+    ///
+    /// @return Whether or not the zip was written.
+    ///
+    bool CreateZip(const std::string& zipFilePath) noexcept
+    {
+        auto zip = zipOpen(zipFilePath.c_str(), APPEND_STATUS_CREATE);
+        if (zip == nullptr)
+        {
+            return false;
+        }
+        
+        bool success = true;
+        for (auto method : { Method::k_stored, Method::k_deflated })
+        {
+            for (u32 i = 0; i < k_numFilesPerMethod && success; ++i)
+            {
+                auto contents = CreateFileContents(method, i);
+                s32 compressionMethod = (method == Method::k_stored) ? 0 : Z_DEFLATED;
+                s32 compressionLevel = (method == Method::k_stored) ? 0 : Z_DEFAULT_COMPRESSION;
+                
+                success = zipOpenNewFileInZip(zip, GetFilePath(method, i).c_str(), nullptr, nullptr, 0, nullptr, 0, nullptr, compressionMethod, compressionLevel) == ZIP_OK &&
+                    zipWriteInFileInZip(zip, contents.data(), u32(contents.size())) == ZIP_OK &&
+                    zipCloseFileInZip(zip) == ZIP_OK;
+            }
+        }
+        
+        return zipClose(zip, nullptr) == ZIP_OK && success;
+    }
+    
+    /// @return Whether or not every file in the zip has the expected contents.
+    ///
+    bool VerifyFiles(const ZippedFileSystem& zippedFileSystem) noexcept
+    {
+        for (auto method : { Method::k_stored, Method::k_deflated })
+        {
+            for (u32 i = 0; i < k_numFilesPerMethod; ++i)
+            {
+                auto stream = zippedFileSystem.CreateBinaryInputStream(GetFilePath(method, i));
+                if (stream == nullptr)
+                {
+                    return false;
+                }
+                
+                auto contents = stream->ReadAll();
+                auto expectedContents = CreateFileContents(method, i);
+                if (contents->GetLength() != expectedContents.size() || !std::equal(expectedContents.begin(), expectedContents.end(), contents->GetData()))
+                {
+                    return false;
+                }
+            }
+        }
+        
+        return true;
+    }
+    
+    /// Reads every file stored with the given method through CreateBinaryInputStream(),
+    /// with the given number of threads taking files in turn, and prints the throughput.
+    ///
+    /// @param zippedFileSystem
+    ///     The zipped file system.
+    /// @param method
+    ///     The method of the files to read.
+    /// @param numThreads
+    ///     The number of threads reading concurrently.
+    ///
+    /// @return Whether or not every file was read in full.
+    ///
+    bool ReadFiles(const ZippedFileSystem& zippedFileSystem, Method method, u32 numThreads) noexcept
+    {
+        std::vector<std::string> filePaths;
+        for (u32 i = 0; i < k_numFilesPerMethod; ++i)
+        {
+            filePaths.push_back(GetFilePath(method, i));
+        }
+        
+        std::atomic<u32> nextFileIndex(0);
+        std::atomic<u64> numBytesRead(0);
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        std::vector<std::thread> threads;
+        for (u32 i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                u32 fileIndex;
+                while ((fileIndex = nextFileIndex++) < k_numFilesPerMethod)
+                {
+                    auto stream = zippedFileSystem.CreateBinaryInputStream(filePaths[fileIndex]);
+                    if (stream != nullptr)
+                    {
+                        numBytesRead += stream->ReadAll()->GetLength();
+                    }
+                }
+            });
+        }
+        
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        
+        f64 milliseconds = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-8s %2u threads %8.1f files/ms %8.1f MB/s\n", method == Method::k_stored ? "stored" : "deflated", numThreads,
+                    k_numFilesPerMethod / milliseconds, f64(numBytesRead) / (milliseconds * 1000.0));
+        
+        return numBytesRead == u64(k_numFilesPerMethod) * k_fileSize;
+    }
+}
+
+namespace ChilliSource
+{
+    //StringUtils.cpp is linked for its path functions. Its markup and number parsing functions
+    //are never called by the zip file system, so their dependencies are stubbed.
+    
+    //------------------------------------------------------------------------------
+    bool ParamDictionary::TryGetValue(const std::string& in_key, std::string& out_value) const
+    {
+        return false;
+    }
+    
+    //------------------------------------------------------------------------------
+    s32 ParseS32(const std::string& in_string)
+    {
+        return 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    u8 Utils::HexToDec(const u8* in_hex)
+    {
+        return 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    void UTF8StringUtils::Append(UTF8Char in_char, std::string& out_appendedResult)
+    {
+    }
+}
+
+/// Measures the throughput of concurrent CreateBinaryInputStream() calls on a zip containing
+/// stored and deflated files, for each number of threads from 1 up to the hardware
+/// concurrency, or at least 4. The zip is written beside the benchmark executable.
+///
+int main(int argc, char** argv)
+{
+    std::string zipFilePath = std::string(argv[0]) + ".zip";
+    if (!CreateZip(zipFilePath))
+    {
+        std::printf("FAILED: could not write %s\n", zipFilePath.c_str());
+        return 1;
+    }
+    
+    ZippedFileSystem zippedFileSystem(zipFilePath);
+    if (!zippedFileSystem.IsValid() || !VerifyFiles(zippedFileSystem))
+    {
+        std::printf("FAILED: the contents of %s could not be read back.\n", zipFilePath.c_str());
+        return 1;
+    }
+    
+    u32 maxThreads = std::max(k_minMaxThreads, std::thread::hardware_concurrency());
+    
+    bool passed = true;
+    for (auto method : { Method::k_stored, Method::k_deflated })
+    {
+        for (u32 numThreads = 1; numThreads <= maxThreads; ++numThreads)
+        {
+            if (!ReadFiles(zippedFileSystem, method, numThreads))
+            {
+                std::printf("FAILED: not every file was read with %u threads.\n", numThreads);
+                passed = false;
+            }
+        }
+    }
+    
+    return passed ? 0 : 1;
+}
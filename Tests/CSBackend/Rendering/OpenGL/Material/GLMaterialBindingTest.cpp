@@ -0,0 +1,252 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <CSBackend/Rendering/OpenGL/Base/GLStateCache.h>
+#include <CSBackend/Rendering/OpenGL/Material/GLMaterialBinding.h>
+#include <CSBackend/Rendering/OpenGL/Shader/GLShader.h>
+#include <ChilliSource/Rendering/Base/BlendMode.h>
+#include <ChilliSource/Rendering/Base/CullFace.h>
+#include <ChilliSource/Rendering/Base/StencilOp.h>
+#include <ChilliSource/Rendering/Base/TestFunc.h>
+#include <ChilliSource/Rendering/Material/RenderMaterial.h>
+#include <ChilliSource/Rendering/Shader/RenderShaderVariables.h>
+
+#include <RecordingGL.h>
+
+#include <cstdio>
+#include <memory>
+
+using namespace ChilliSource;
+using namespace CSBackend::OpenGL;
+
+namespace
+{
+    constexpr u32 k_numFrames = 4;
+    constexpr u32 k_numDrawsPerFrame = 100;
+    
+    /// The uniforms used by the test shader. The sampler and tint are looked up by the
+    /// material bindings, the rest are engine uniforms resolved when the shader is linked.
+    ///
+    const std::vector<std::string> k_shaderUniforms = { "u_wvpMat", "u_emissive", "u_ambient", "u_diffuse", "u_specular", "u_texture0", "u_tint" };
+    
+    /// The number of engine uniforms looked up when a shader is linked.
+    ///
+    constexpr u32 k_numEngineUniforms = u32(GLShader::Uniform::k_total);
+    
+    /// The number of uniforms a material binding looks up by name: u_texture0 and u_tint.
+    ///
+    constexpr u32 k_numBoundUniforms = 2;
+    
+    /// The number of uniforms set by applying a material for the first time: the sampler, the
+    /// four material colours and the tint.
+    ///
+    constexpr u32 k_numMaterialUniforms = 6;
+    
+    /// Storage whose address stands in for a render texture. Material bindings only count
+    /// textures, so it is never dereferenced.
+    ///
+    u8 g_renderTexture;
+    
+    /// Prints the given message if the condition is false.
+    ///
+    /// @return The condition.
+    ///
+    bool Check(bool condition, const char* message) noexcept
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", message);
+        }
+        
+        return condition;
+    }
+    
+    /// Creates a material with one texture and a custom tint variable.
+    ///
+    /// @param diffuseColour
+    ///     The diffuse colour.
+    /// @param tint
+    ///     The value of the u_tint variable.
+    ///
+    /// @return The new material.
+    ///
+    std::unique_ptr<RenderMaterial> CreateRenderMaterial(const Colour& diffuseColour, f32 tint) noexcept
+    {
+        std::vector<const RenderTexture*> renderTextures2D = { reinterpret_cast<const RenderTexture*>(&g_renderTexture) };
+        RenderShaderVariablesUPtr renderShaderVariables(new RenderShaderVariables({ { "u_tint", tint } }, {}, {}, {}, {}, {}));
+        
+        return std::unique_ptr<RenderMaterial>(new RenderMaterial(nullptr, std::move(renderTextures2D), std::vector<const RenderTexture*>(), false, true, true, true, true, false,
+                                                                  TestFunc::k_lessEqual, BlendMode::k_one, BlendMode::k_zero, StencilOp::k_keep, StencilOp::k_keep, StencilOp::k_keep, TestFunc::k_always, 0, 0xff,
+                                                                  CullFace::k_back, Colour::k_black, Colour::k_white, diffuseColour, Colour::k_black, std::move(renderShaderVariables)));
+    }
+    
+    /// Renders a number of frames, alternating between two materials for each draw, and checks
+    /// that only the first frame looks up uniform locations and that later frames only upload the
+    /// uniforms which differ between the materials.
+    ///
+    /// @param glShader
+    ///     The shader to apply the materials to.
+    /// @param bindingA
+    ///     The first material binding.
+    /// @param bindingB
+    ///     The second material binding.
+    /// @param numDifferingUniforms
+    ///     The number of uniforms whose value differs between the two materials.
+    ///
+    /// @return Whether or not the checks passed.
+    ///
+    bool RenderFrames(GLShader* glShader, GLMaterialBinding& bindingA, GLMaterialBinding& bindingB, u32 numDifferingUniforms) noexcept
+    {
+        bool passed = true;
+        
+        for (u32 frame = 0; frame < k_numFrames; ++frame)
+        {
+            Test::ResetGLCallCounts();
+            
+            for (u32 draw = 0; draw < k_numDrawsPerFrame; ++draw)
+            {
+                (draw % 2 == 0 ? bindingA : bindingB).Apply(glShader);
+            }
+            
+            auto counts = Test::GetGLCallCounts();
+            std::printf("  frame %u: %u glUniform calls, %u glGetUniformLocation calls\n", frame, counts.m_numUniformUploads, counts.m_numUniformLocationLookups);
+            
+            //Every draw after the first of a frame switches material, so uploads exactly the differing uniforms.
+            u32 expectedUploads = (k_numDrawsPerFrame - 1) * numDifferingUniforms;
+            if (frame == 0)
+            {
+                passed &= Check(counts.m_numUniformLocationLookups == k_numBoundUniforms, "The first frame should look up each bound uniform location once.");
+                passed &= Check(counts.m_numUniformUploads == k_numMaterialUniforms + expectedUploads, "The first frame should upload every uniform once, then only differing uniforms.");
+            }
+            else
+            {
+                passed &= Check(counts.m_numUniformLocationLookups == 0, "Uniform locations should not be looked up after the first frame.");
+                passed &= Check(counts.m_numUniformUploads == numDifferingUniforms + expectedUploads, "Only uniforms which differ from the previous draw should be uploaded.");
+            }
+            
+            passed &= Check(counts.m_numOtherCalls == 0 && counts.m_numProgramBinds == 0, "Applying a material should only set uniforms.");
+        }
+        
+        return passed;
+    }
+    
+    /// Checks that linking a shader resolves the engine uniforms up front.
+    ///
+    /// @return Whether or not the checks passed.
+    ///
+    bool TestShaderCreation() noexcept
+    {
+        Test::ResetGLCallCounts();
+        GLShader glShader("", "");
+        
+        return Check(Test::GetGLCallCounts().m_numUniformLocationLookups == k_numEngineUniforms, "Linking a shader should look up each engine uniform once.");
+    }
+    
+    /// Checks that applying the same material repeatedly issues no GL calls after the first.
+    ///
+    /// @return Whether or not the checks passed.
+    ///
+    bool TestSameMaterial() noexcept
+    {
+        bool passed = true;
+        
+        auto renderMaterial = CreateRenderMaterial(Colour::k_white, 1.0f);
+        GLMaterialBinding binding(renderMaterial.get());
+        GLShader glShader("", "");
+        
+        Test::ResetGLCallCounts();
+        binding.Apply(&glShader);
+        auto counts = Test::GetGLCallCounts();
+        passed &= Check(counts.m_numUniformUploads == k_numMaterialUniforms, "The first apply should upload every material uniform.");
+        passed &= Check(counts.m_numUniformLocationLookups == k_numBoundUniforms, "The first apply should look up each bound uniform location once.");
+        
+        Test::ResetGLCallCounts();
+        for (u32 i = 0; i < k_numDrawsPerFrame; ++i)
+        {
+            binding.Apply(&glShader);
+        }
+        counts = Test::GetGLCallCounts();
+        passed &= Check(counts.m_numUniformUploads == 0 && counts.m_numUniformLocationLookups == 0, "Re-applying an unchanged material should not make any GL calls.");
+        
+        return passed;
+    }
+    
+    /// Checks that alternating materials only uploads the uniforms which differ between them,
+    /// and that a new shader re-resolves the bindings.
+    ///
+    /// @return Whether or not the checks passed.
+    ///
+    bool TestAlternatingMaterials() noexcept
+    {
+        bool passed = true;
+        
+        auto renderMaterialA = CreateRenderMaterial(Colour::k_white, 1.0f);
+        auto renderMaterialB = CreateRenderMaterial(Colour::k_red, 0.5f);
+        auto renderMaterialC = CreateRenderMaterial(Colour::k_white, 0.5f);
+        GLMaterialBinding bindingA(renderMaterialA.get());
+        GLMaterialBinding bindingB(renderMaterialB.get());
+        GLMaterialBinding bindingC(renderMaterialC.get());
+        
+        std::printf("Materials differing in diffuse colour and tint:\n");
+        GLShader glShader("", "");
+        passed &= RenderFrames(&glShader, bindingA, bindingB, 2);
+        
+        std::printf("Materials differing in tint only:\n");
+        GLShader otherGLShader("", "");
+        passed &= RenderFrames(&otherGLShader, bindingA, bindingC, 1);
+        
+        return passed;
+    }
+}
+
+namespace CSBackend
+{
+    namespace OpenGL
+    {
+        //GLStateCache.cpp is not linked. Only the members used by GLShader are defined.
+        
+        //------------------------------------------------------------------------------
+        void GLStateCache::UseProgram(GLuint programId) noexcept
+        {
+            glUseProgram(programId);
+        }
+    }
+}
+
+/// Applies material bindings through a recording GL stub and checks the number of uniform
+/// uploads and location lookups made per frame.
+///
+int main()
+{
+    Test::SetGLUniformNames(k_shaderUniforms);
+    
+    bool passed = true;
+    passed &= TestShaderCreation();
+    passed &= TestSameMaterial();
+    passed &= TestAlternatingMaterials();
+    
+    std::printf("%s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
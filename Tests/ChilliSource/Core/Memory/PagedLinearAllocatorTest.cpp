@@ -0,0 +1,187 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Memory/PagedLinearAllocator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr std::size_t k_pageSize = 64 * 1024;
+    constexpr u32 k_numAllocationsPerThread = 20000;
+    constexpr u32 k_minAllocationSize = 1;
+    constexpr u32 k_maxAllocationSize = 512;
+    constexpr u32 k_numFrames = 20;
+    constexpr u32 k_minMaxThreads = 4;
+    
+    /// A single allocation made by a thread, filled with a byte unique to the thread so
+    /// overlapping allocations can be detected once all threads have finished.
+    ///
+    struct Allocation final
+    {
+        u8* m_pointer;
+        u32 m_size;
+        u8 m_fill;
+    };
+    
+    /// Prints a failure message if the given condition is false.
+    ///
+    /// @param condition
+    ///     The condition to check.
+    /// @param description
+    ///     A description of what was expected.
+    ///
+    /// @return The condition.
+    ///
+    bool Check(bool condition, const char* description) noexcept
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+        }
+        
+        return condition;
+    }
+    
+    /// Makes a number of allocations of random sizes from the given allocator, filling
+    /// each with the given byte.
+    ///
+    /// @param allocator
+    ///     The allocator.
+    /// @param fill
+    ///     The byte to fill each allocation with.
+    /// @param out_allocations
+    ///     (Out) The allocations which were made.
+    ///
+    void Allocate(PagedLinearAllocator& allocator, u8 fill, std::vector<Allocation>& out_allocations) noexcept
+    {
+        std::mt19937 random(fill);
+        std::uniform_int_distribution<u32> sizeDistribution(k_minAllocationSize, k_maxAllocationSize);
+        
+        out_allocations.clear();
+        for (u32 i = 0; i < k_numAllocationsPerThread; ++i)
+        {
+            u32 size = sizeDistribution(random);
+            auto pointer = reinterpret_cast<u8*>(allocator.Allocate(size));
+            std::memset(pointer, fill, size);
+            out_allocations.push_back(Allocation { pointer, size, fill });
+        }
+    }
+    
+    /// Allocates from the given allocator on the given number of threads at once, then
+    /// checks that every allocation is aligned and still holds its own fill, before
+    /// deallocating everything and resetting the allocator.
+    ///
+    /// @param allocator
+    ///     The allocator.
+    /// @param numThreads
+    ///     The number of threads.
+    /// @param out_passed
+    ///     (Out) Set to false if any allocation was misaligned or overwritten.
+    ///
+    /// @return The time taken to make the allocations, in microseconds.
+    ///
+    f64 RunFrame(PagedLinearAllocator& allocator, u32 numThreads, bool& out_passed) noexcept
+    {
+        std::vector<std::vector<Allocation>> allocations(numThreads);
+        std::vector<std::thread> threads;
+        
+        auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([&allocator, &allocations, i]() { Allocate(allocator, u8(i + 1), allocations[i]); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto microS = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+        
+        bool aligned = true;
+        bool intact = true;
+        for (const auto& threadAllocations : allocations)
+        {
+            for (const auto& allocation : threadAllocations)
+            {
+                aligned &= (reinterpret_cast<std::uintptr_t>(allocation.m_pointer) % sizeof(std::intptr_t)) == 0;
+                intact &= std::all_of(allocation.m_pointer, allocation.m_pointer + allocation.m_size, [&allocation](u8 value) { return value == allocation.m_fill; });
+                
+                allocator.Deallocate(allocation.m_pointer, allocation.m_size);
+            }
+        }
+        
+        out_passed &= Check(aligned, "every allocation is pointer aligned.");
+        out_passed &= Check(intact, "no allocation is overwritten by another thread.");
+        
+        allocator.Reset();
+        
+        return microS;
+    }
+}
+
+/// Allocates from a single allocator on 1 thread and on the hardware concurrency, or at
+/// least 4 threads, checking that concurrent allocations never overlap and that pages are
+/// reused after a reset. The average time per allocation is printed for each.
+///
+int main()
+{
+    u32 maxThreads = std::max(k_minMaxThreads, std::thread::hardware_concurrency());
+    
+    bool passed = true;
+    for (u32 numThreads : { 1u, maxThreads })
+    {
+        PagedLinearAllocator allocator(k_pageSize);
+        
+        f64 totalMicroS = 0.0;
+        std::size_t numPages = 0;
+        for (u32 frame = 0; frame < k_numFrames; ++frame)
+        {
+            totalMicroS += RunFrame(allocator, numThreads, passed);
+            
+            if (frame == 0)
+            {
+                numPages = allocator.GetNumPages();
+            }
+        }
+        
+        passed &= Check(allocator.GetNumPages() == numPages, "pages are reused after a reset.");
+        
+        allocator.ResetAndShrink();
+        passed &= Check(allocator.GetNumPages() == 1, "shrinking releases all but the first page.");
+        
+        f64 nsPerAllocation = totalMicroS * 1000.0 / (f64(k_numFrames) * numThreads * k_numAllocationsPerThread);
+        std::printf("%2u threads  %6.1f ns/allocation  %4zu pages\n", numThreads, nsPerAllocation, numPages);
+    }
+    
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Threading/FileTaskQueue.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_numThreads = 2;
+    
+    /// Blocks the tasks which wait on it until it is opened.
+    ///
+    class Gate final
+    {
+    public:
+        /// Blocks until the gate is opened.
+        ///
+        void Wait() noexcept
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_isOpen; });
+        }
+        
+        /// Opens the gate, releasing all waiting threads.
+        ///
+        void Open() noexcept
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_isOpen = true;
+            m_condition.notify_all();
+        }
+        
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_isOpen = false;
+    };
+    
+    /// Prints a failure message if the given condition is false.
+    ///
+    /// @param condition
+    ///     The condition to check.
+    /// @param description
+    ///     A description of what was expected.
+    ///
+    /// @return The condition.
+    ///
+    bool Check(bool condition, const char* description) noexcept
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+        }
+        
+        return condition;
+    }
+    
+    /// Waits until the queue has completed the given number of requests.
+    ///
+    /// @param fileTaskQueue
+    ///     The queue.
+    /// @param numRequests
+    ///     The number of requests.
+    ///
+    void WaitForRequests(const FileTaskQueue& fileTaskQueue, u32 numRequests) noexcept
+    {
+        while (fileTaskQueue.GetStats().m_numRequestsCompleted < numRequests)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    
+    /// Checks that pending tasks are started in priority order, that tasks sharing a
+    /// coalescing key are merged into one request at the higher priority, and that
+    /// cancelled tasks never run.
+    ///
+    /// @param taskPool
+    ///     The pool on which the queue runs its tasks.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestOrderCoalescingAndCancel(TaskPool& taskPool) noexcept
+    {
+        bool passed = true;
+        std::mutex orderMutex;
+        std::string order;
+        auto append = [&orderMutex, &order](char c)
+        {
+            std::unique_lock<std::mutex> lock(orderMutex);
+            order += c;
+        };
+        
+        FileTaskQueue fileTaskQueue(&taskPool, 1);
+        
+        //The first task holds the only slot, so everything added after it stays pending.
+        Gate gate;
+        fileTaskQueue.Add(FileTaskPriority::k_blocking, [&](const TaskContext&) noexcept { gate.Wait(); append('g'); });
+        
+        fileTaskQueue.Add(FileTaskPriority::k_prefetch, [&](const TaskContext&) noexcept { append('p'); });
+        auto a = fileTaskQueue.Add(FileTaskPriority::k_prefetch, [&](const TaskContext&) noexcept { append('a'); }, "a.png");
+        fileTaskQueue.Add(FileTaskPriority::k_visible, [&](const TaskContext&) noexcept { append('v'); });
+        auto b = fileTaskQueue.Add(FileTaskPriority::k_blocking, [&](const TaskContext&) noexcept { append('b'); }, "a.png");
+        auto c = fileTaskQueue.Add(FileTaskPriority::k_visible, [&](const TaskContext&) noexcept { append('c'); });
+        
+        passed &= Check(a != FileTaskQueue::k_invalidTaskId && a != b && b != c, "each task is given a unique id.");
+        passed &= Check(fileTaskQueue.GetNumPendingTasks() == 5, "tasks wait while the concurrency limit is reached.");
+        passed &= Check(fileTaskQueue.Cancel(c), "a pending task can be cancelled.");
+        passed &= Check(!fileTaskQueue.Cancel(c), "a task can only be cancelled once.");
+        
+        gate.Open();
+        WaitForRequests(fileTaskQueue, 4);
+        
+        passed &= Check(order == "gabvp", "requests start in priority order, and coalesced tasks run in the order they were added at the higher priority.");
+        passed &= Check(!fileTaskQueue.Cancel(a), "a task which has run cannot be cancelled.");
+        passed &= Check(fileTaskQueue.GetNumPendingTasks() == 0, "no tasks are left pending.");
+        
+        auto stats = fileTaskQueue.GetStats();
+        passed &= Check(stats.m_numRequestsCompleted == 4 && stats.m_numTasksCoalesced == 1 && stats.m_numTasksCancelled == 1, "coalesced and cancelled tasks are counted.");
+        
+        return passed;
+    }
+    
+    /// Checks that a request whose only task is cancelled is discarded, and that later
+    /// tasks with the same coalescing key start a new request.
+    ///
+    /// @param taskPool
+    ///     The pool on which the queue runs its tasks.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestCancelledRequest(TaskPool& taskPool) noexcept
+    {
+        bool passed = true;
+        std::mutex orderMutex;
+        std::string order;
+        auto append = [&orderMutex, &order](char c)
+        {
+            std::unique_lock<std::mutex> lock(orderMutex);
+            order += c;
+        };
+        
+        FileTaskQueue fileTaskQueue(&taskPool, 1);
+        
+        Gate gate;
+        fileTaskQueue.Add(FileTaskPriority::k_blocking, [&](const TaskContext&) noexcept { gate.Wait(); append('g'); });
+        
+        auto a = fileTaskQueue.Add(FileTaskPriority::k_visible, [&](const TaskContext&) noexcept { append('a'); }, "a.png");
+        passed &= Check(fileTaskQueue.Cancel(a), "a pending coalescable task can be cancelled.");
+        fileTaskQueue.Add(FileTaskPriority::k_prefetch, [&](const TaskContext&) noexcept { append('b'); }, "a.png");
+        
+        gate.Open();
+        WaitForRequests(fileTaskQueue, 2);
+        
+        passed &= Check(order == "gb", "the emptied request is skipped and the later task runs on its own.");
+        passed &= Check(fileTaskQueue.GetStats().m_numTasksCoalesced == 0, "tasks are not coalesced into an emptied request.");
+        
+        return passed;
+    }
+}
+
+/// Tests the start order, coalescing and cancellation of file tasks.
+///
+int main()
+{
+    TaskPool taskPool(TaskType::k_large, k_numThreads);
+    
+    bool passed = true;
+    passed &= TestOrderCoalescingAndCancel(taskPool);
+    passed &= TestCancelledRequest(taskPool);
+    
+    std::printf("%s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
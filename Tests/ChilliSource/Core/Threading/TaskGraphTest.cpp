@@ -0,0 +1,227 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskGraph.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_longChainLength = 100000;
+    
+    /// Tasks scheduled by task graphs, in the order they were scheduled. They are only run
+    /// when the test calls RunScheduledTasks(), so the state of a graph can be checked
+    /// between each step.
+    ///
+    std::deque<std::pair<TaskType, Task>> g_scheduledTasks;
+    
+    /// Runs every scheduled task, including any scheduled while running, in the order they
+    /// were scheduled.
+    ///
+    /// @return The number of tasks run.
+    ///
+    u32 RunScheduledTasks() noexcept
+    {
+        u32 numTasksRun = 0;
+        while (!g_scheduledTasks.empty())
+        {
+            auto scheduledTask = std::move(g_scheduledTasks.front());
+            g_scheduledTasks.pop_front();
+            
+            TaskContext taskContext(scheduledTask.first);
+            scheduledTask.second(taskContext);
+            ++numTasksRun;
+        }
+        
+        return numTasksRun;
+    }
+    
+    /// Prints a failure message if the given condition is false.
+    ///
+    /// @param condition
+    ///     The condition to check.
+    /// @param description
+    ///     A description of what was expected.
+    ///
+    /// @return The condition.
+    ///
+    bool Check(bool condition, const char* description) noexcept
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+        }
+        
+        return condition;
+    }
+    
+    /// Checks that tasks are only scheduled once all of their dependencies have finished,
+    /// and that WhenAll() handles finish with the last of their dependencies.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestDependencyOrder() noexcept
+    {
+        bool passed = true;
+        std::string order;
+        
+        TaskGraph taskGraph;
+        auto a = taskGraph.Add(TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'a'; });
+        auto b = taskGraph.Add(TaskType::k_file, [&order](const TaskContext&) noexcept { order += 'b'; });
+        auto c = taskGraph.Add(TaskType::k_large, [&order](const TaskContext&) noexcept { order += 'c'; }, { a, b });
+        auto d = taskGraph.Then(c, TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'd'; });
+        auto all = taskGraph.WhenAll({ a, d });
+        
+        passed &= Check(g_scheduledTasks.size() == 2, "only tasks without dependencies are scheduled when added.");
+        passed &= Check(!c.IsFinished() && !d.IsFinished() && !all.IsFinished(), "dependent tasks are not finished before their dependencies.");
+        
+        passed &= Check(RunScheduledTasks() == 4, "every task is run exactly once.");
+        passed &= Check(order == "abcd", "tasks run in dependency order.");
+        passed &= Check(a.IsFinished() && b.IsFinished() && c.IsFinished() && d.IsFinished() && all.IsFinished(), "all tasks are finished.");
+        passed &= Check(!d.IsCancelled() && !all.IsCancelled(), "tasks in a graph which was not cancelled are not cancelled.");
+        
+        auto e = taskGraph.Then(d, TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'e'; });
+        passed &= Check(g_scheduledTasks.size() == 1, "a task whose dependencies have already finished is scheduled immediately.");
+        RunScheduledTasks();
+        passed &= Check(e.IsFinished() && order == "abcde", "a late continuation runs.");
+        
+        return passed;
+    }
+    
+    /// Checks that cancelling a graph skips its scheduled and pending tasks, that the
+    /// skipped tasks still finish, and that continuations in other graphs still run.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestCancel() noexcept
+    {
+        bool passed = true;
+        std::string order;
+        
+        TaskGraph taskGraph;
+        TaskGraph otherTaskGraph;
+        auto a = taskGraph.Add(TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'a'; });
+        auto b = taskGraph.Then(a, TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'b'; });
+        auto c = taskGraph.Then(b, TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'c'; });
+        auto all = taskGraph.WhenAll({ c });
+        auto other = otherTaskGraph.Then(all, TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'o'; });
+        
+        taskGraph.Cancel();
+        passed &= Check(taskGraph.IsCancelled() && !otherTaskGraph.IsCancelled(), "cancellation applies per graph.");
+        
+        RunScheduledTasks();
+        passed &= Check(order == "o", "tasks in a cancelled graph are skipped, including those already scheduled.");
+        passed &= Check(a.IsCancelled() && b.IsCancelled() && c.IsCancelled(), "skipped tasks are cancelled.");
+        passed &= Check(a.IsFinished() && b.IsFinished() && c.IsFinished() && all.IsFinished(), "skipped tasks are finished.");
+        passed &= Check(!all.IsCancelled(), "WhenAll() handles have no task, so are never cancelled.");
+        passed &= Check(other.IsFinished() && !other.IsCancelled(), "continuations in other graphs still run.");
+        
+        auto late = taskGraph.Add(TaskType::k_small, [&order](const TaskContext&) noexcept { order += 'l'; });
+        passed &= Check(g_scheduledTasks.empty() && late.IsFinished() && late.IsCancelled(), "tasks added after cancellation are finished immediately.");
+        
+        return passed;
+    }
+    
+    /// Checks that long chains of cancelled tasks and WhenAll() handles, which are finished
+    /// without being scheduled, finish when the task at the start of the chain does.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestLongChains() noexcept
+    {
+        bool passed = true;
+        
+        TaskGraph rootTaskGraph;
+        TaskGraph cancelledTaskGraph;
+        TaskGraph whenAllTaskGraph;
+        cancelledTaskGraph.Cancel();
+        
+        auto root = rootTaskGraph.Add(TaskType::k_small, [](const TaskContext&) noexcept {});
+        
+        auto cancelled = root;
+        auto whenAll = root;
+        for (u32 i = 0; i < k_longChainLength; ++i)
+        {
+            cancelled = cancelledTaskGraph.Then(cancelled, TaskType::k_small, [](const TaskContext&) noexcept {});
+            whenAll = whenAllTaskGraph.WhenAll({ whenAll });
+        }
+        
+        auto end = rootTaskGraph.Add(TaskType::k_small, [](const TaskContext&) noexcept {}, { cancelled, whenAll });
+        passed &= Check(!cancelled.IsFinished() && !whenAll.IsFinished() && !end.IsFinished(), "chains wait for the task at their start.");
+        
+        passed &= Check(RunScheduledTasks() == 2, "only the tasks at the start and end of the chains are run.");
+        passed &= Check(cancelled.IsFinished() && cancelled.IsCancelled(), "the chain of cancelled tasks finishes.");
+        passed &= Check(whenAll.IsFinished(), "the chain of WhenAll() handles finishes.");
+        passed &= Check(end.IsFinished() && !end.IsCancelled(), "the task after both chains runs.");
+        
+        return passed;
+    }
+}
+
+namespace ChilliSource
+{
+    //The application and task scheduler are never created by this test. Only the members used by task
+    //graphs are defined, with scheduled tasks queued so the test controls when they run.
+    
+    //------------------------------------------------------------------------------
+    Application* Application::Get() noexcept
+    {
+        static u8 s_application;
+        return reinterpret_cast<Application*>(&s_application);
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskScheduler* Application::GetTaskScheduler() noexcept
+    {
+        static u8 s_taskScheduler;
+        return reinterpret_cast<TaskScheduler*>(&s_taskScheduler);
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskScheduler::ScheduleTask(TaskType taskType, const Task& task) noexcept
+    {
+        g_scheduledTasks.emplace_back(taskType, task);
+    }
+}
+
+/// Tests the ordering of task graph dependencies, cancellation, and chains of tasks which
+/// finish without being scheduled.
+///
+int main()
+{
+    bool passed = true;
+    passed &= TestDependencyOrder();
+    passed &= TestCancel();
+    passed &= TestLongChains();
+    
+    std::printf("%s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
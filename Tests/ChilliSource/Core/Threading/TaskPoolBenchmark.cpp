@@ -0,0 +1,231 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+
+#include <AllocationCounter.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_numThreads = 4;
+    constexpr u32 k_numBatches = 2000;
+    constexpr u32 k_tasksPerBatch = 256;
+    constexpr u32 k_numForkJoins = 2000;
+    
+#ifdef CS_TEST_BASELINE_TASK_POOL
+    const char k_taskPoolName[] = "baseline (mutex and deque)";
+    constexpr bool k_isPushAllocationFree = false;
+#else
+    const char k_taskPoolName[] = "work stealing";
+    constexpr bool k_isPushAllocationFree = true;
+#endif
+    
+    /// Blocks until the given number of tasks have signalled completion.
+    ///
+    class Latch final
+    {
+    public:
+        explicit Latch(u32 count) noexcept : m_count(count) {}
+        
+        void CountDown() noexcept
+        {
+            if (--m_count == 0)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_isDone = true;
+                m_condition.notify_all();
+            }
+        }
+        
+        void Wait() noexcept
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_isDone; });
+        }
+        
+    private:
+        std::atomic<u32> m_count;
+        bool m_isDone = false;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+    };
+    
+    /// Pushes batches of tasks from a worker thread, which uses the worker's own
+    /// work stealing queue. Each batch is drained before the next is pushed so the
+    /// queue never overflows into the shared queue.
+    ///
+    /// @return The number of heap allocations made while the batches were added
+    ///     and processed.
+    ///
+    std::uint64_t RunWorkerBatches(TaskPool& taskPool, const char* label) noexcept
+    {
+        //The producer also counts down, so that it has finished using the batch before this returns.
+        Latch latch(k_numBatches * k_tasksPerBatch + 1);
+        std::atomic<u32> numCompleted(0);
+        std::uint64_t allocations = 0;
+        
+        std::vector<Task> batch(k_tasksPerBatch, [&](const TaskContext&) noexcept
+        {
+            ++numCompleted;
+            latch.CountDown();
+        });
+        
+        //Allocations are counted inside the producer, so that adding the producer itself isn't included.
+        std::vector<Task> producer(1, [&](const TaskContext& taskContext) noexcept
+        {
+            auto allocationsBefore = Test::GetAllocationCount();
+            for (u32 i = 0; i < k_numBatches; ++i)
+            {
+                taskContext.m_taskPool->AddTasks(batch);
+                while (numCompleted < (i + 1) * k_tasksPerBatch)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            allocations = Test::GetAllocationCount() - allocationsBefore;
+            latch.CountDown();
+        });
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        taskPool.AddTasks(producer);
+        latch.Wait();
+        
+        auto duration = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count();
+        
+        u32 numTasks = k_numBatches * k_tasksPerBatch;
+        std::printf("%-28s %10u tasks %8.1f ns/task %8.3f allocations/task\n", label, numTasks, duration / numTasks, f64(allocations) / numTasks);
+        return allocations;
+    }
+    
+    /// Pushes batches of tasks from a thread outside the pool, which uses the shared
+    /// queue.
+    ///
+    void RunExternalBatches(TaskPool& taskPool) noexcept
+    {
+        Latch latch(k_numBatches * k_tasksPerBatch);
+        std::vector<Task> batch(k_tasksPerBatch, [&latch](const TaskContext&) noexcept { latch.CountDown(); });
+        
+        auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < k_numBatches; ++i)
+        {
+            taskPool.AddTasks(batch);
+        }
+        latch.Wait();
+        
+        auto duration = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count();
+        u32 numTasks = k_numBatches * k_tasksPerBatch;
+        std::printf("%-28s %10u tasks %8.1f ns/task\n", "external thread batches", numTasks, duration / numTasks);
+    }
+    
+    /// Forks the given number of child tasks from a task in the pool using
+    /// TaskContext::ProcessChildTasks(), which yields until they have all finished, and
+    /// reports the average round trip latency.
+    ///
+    /// @param taskPool
+    ///     The task pool.
+    /// @param fanOut
+    ///     The number of child tasks forked each time.
+    ///
+    /// @return Whether or not every child task was run.
+    ///
+    bool RunForkJoin(TaskPool& taskPool, u32 fanOut) noexcept
+    {
+        Latch latch(1);
+        std::atomic<u32> numChildrenRun(0);
+        f64 duration = 0.0;
+        
+        std::vector<Task> children(fanOut, [&numChildrenRun](const TaskContext&) noexcept
+        {
+            ++numChildrenRun;
+        });
+        
+        std::vector<Task> parent(1, [&](const TaskContext& taskContext) noexcept
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (u32 i = 0; i < k_numForkJoins; ++i)
+            {
+                taskContext.ProcessChildTasks(children);
+            }
+            duration = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+            latch.CountDown();
+        });
+        
+        taskPool.AddTasks(parent);
+        latch.Wait();
+        
+        std::printf("fork/join fan-out %-10u %10u joins %8.2f us/join %8.1f ns/child\n", fanOut, k_numForkJoins, duration / k_numForkJoins, 1000.0 * duration / (k_numForkJoins * fanOut));
+        return numChildrenRun == k_numForkJoins * fanOut;
+    }
+}
+
+/// A micro-benchmark of the task pool. This reports throughput for tasks added from
+/// worker and external threads, and the round trip latency of forking and joining
+/// child tasks at several fan-outs. It fails if tasks added from a worker allocate
+/// once the pool has warmed up.
+///
+/// Building with CS_TEST_BASELINE_TASK_POOL uses the mutex and deque pool which
+/// preceded the work stealing pool, found in Baseline/, for comparison. The baseline
+/// pool allocates on every push, so its allocations are only reported.
+///
+int main()
+{
+    TaskPool taskPool(TaskType::k_small, k_numThreads);
+    std::printf("%s task pool, %u threads\n", k_taskPoolName, k_numThreads);
+    
+    RunWorkerBatches(taskPool, "worker batches (cold)");
+    auto allocations = RunWorkerBatches(taskPool, "worker batches (warm)");
+    RunExternalBatches(taskPool);
+    
+    bool passed = true;
+    for (u32 fanOut : { 1u, 4u, 16u, 64u, 256u })
+    {
+        if (!RunForkJoin(taskPool, fanOut))
+        {
+            std::printf("FAILED: not every child task was run with a fan-out of %u.\n", fanOut);
+            passed = false;
+        }
+    }
+    
+    if (k_isPushAllocationFree && allocations != 0)
+    {
+        std::printf("FAILED: the warm worker push path made %llu heap allocations.\n", (unsigned long long)allocations);
+        passed = false;
+    }
+    
+    return passed ? 0 : 1;
+}
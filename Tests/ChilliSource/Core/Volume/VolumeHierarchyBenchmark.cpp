@@ -0,0 +1,302 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Entity/Entity.h>
+#include <ChilliSource/Core/Math/MathUtils.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Scene/Scene.h>
+#include <ChilliSource/Core/Volume/VolumeComponent.h>
+#include <ChilliSource/Core/Volume/VolumeHierarchy.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_volumeCounts[] = { 1000, 10000, 100000 };
+    constexpr u32 k_numQueries = 100;
+    constexpr u32 k_numMovesPerFrame = 100;
+    constexpr f32 k_spacing = 3.0f;
+    constexpr f32 k_sphereRadius = 4.0f;
+    constexpr f32 k_maxMoveDistance = 0.5f;
+    
+    /// A unit box volume centred on its entity, and oriented with it.
+    ///
+    class BoxVolumeComponent final : public VolumeComponent
+    {
+    public:
+        bool IsA(InterfaceIDType interfaceId) const override
+        {
+            return interfaceId == VolumeComponent::InterfaceID;
+        }
+        
+        const AABB& GetAABB() override
+        {
+            //The diagonal of the box is the widest it can be in any orientation.
+            m_aabb.SetSize(Vector3::k_one * std::sqrt(3.0f));
+            m_aabb.SetOrigin(GetEntity()->GetTransform().GetWorldPosition());
+            return m_aabb;
+        }
+        
+        const OOBB& GetOOBB() override
+        {
+            m_oobb.SetOrigin(Vector3::k_zero);
+            m_oobb.SetSize(Vector3::k_one);
+            m_oobb.SetTransform(GetEntity()->GetTransform().GetWorldTransform());
+            return m_oobb;
+        }
+        
+        const Sphere& GetBoundingSphere() override
+        {
+            m_boundingSphere.vOrigin = GetEntity()->GetTransform().GetWorldPosition();
+            m_boundingSphere.fRadius = std::sqrt(3.0f) * 0.5f;
+            return m_boundingSphere;
+        }
+        
+        bool IsVisible() const override
+        {
+            return true;
+        }
+        
+    private:
+        AABB m_aabb;
+        OOBB m_oobb;
+        Sphere m_boundingSphere;
+    };
+    
+    /// @return A random point in a cube of the given size, with one corner at the origin.
+    ///
+    Vector3 RandomPoint(std::mt19937& random, f32 size) noexcept
+    {
+        std::uniform_real_distribution<f32> distribution(0.0f, size);
+        return Vector3(distribution(random), distribution(random), distribution(random));
+    }
+    
+    /// @return The number of volumes whose OOBB is intersected by the ray, found by testing
+    ///     every volume, as Scene::QuerySceneForIntersection() did before the hierarchy.
+    ///
+    u32 QueryRayLinear(const std::vector<VolumeComponent*>& volumeComponents, const Ray& ray) noexcept
+    {
+        u32 numHits = 0;
+        for (auto volumeComponent : volumeComponents)
+        {
+            f32 nearIntersection = 0.0f, farIntersection = 0.0f;
+            if (volumeComponent->GetOOBB().Contains(ray, nearIntersection, farIntersection))
+            {
+                ++numHits;
+            }
+        }
+        
+        return numHits;
+    }
+    
+    /// @return The number of volumes whose OOBB intersects the sphere, found by testing every
+    ///     volume. The closest point is found in the local space of each OOBB.
+    ///
+    u32 QuerySphereLinear(const std::vector<VolumeComponent*>& volumeComponents, const Sphere& sphere) noexcept
+    {
+        u32 numHits = 0;
+        for (auto volumeComponent : volumeComponents)
+        {
+            const auto& oobb = volumeComponent->GetOOBB();
+            const Vector3 halfSize = oobb.GetSize() * 0.5f;
+            Vector3 localCentre = sphere.vOrigin * Matrix4::Inverse(oobb.GetTransform());
+            Vector3 closest = Vector3::Clamp(localCentre, oobb.GetOrigin() - halfSize, oobb.GetOrigin() + halfSize) * oobb.GetTransform();
+            if ((closest - sphere.vOrigin).LengthSquared() <= sphere.fRadius * sphere.fRadius)
+            {
+                ++numHits;
+            }
+        }
+        
+        return numHits;
+    }
+    
+    /// @return The time since the given start time in microseconds.
+    ///
+    f64 GetMicrosecondsSince(const std::chrono::steady_clock::time_point& start) noexcept
+    {
+        return std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    /// Scatters randomly oriented unit boxes uniformly at a constant density, then times ray and sphere
+    /// queries against the hierarchy and against a linear scan, and the cost of refitting
+    /// after some of the boxes move.
+    ///
+    /// @param numVolumes
+    ///     The number of volumes.
+    ///
+    /// @return Whether or not the hierarchy found the same volumes as the linear scan.
+    ///
+    bool RunQueries(u32 numVolumes) noexcept
+    {
+        std::mt19937 random(numVolumes);
+        const f32 fieldSize = std::cbrt(f32(numVolumes)) * k_spacing;
+        
+        std::vector<EntityUPtr> entities;
+        std::vector<VolumeComponent*> volumeComponents;
+        VolumeHierarchy volumeHierarchy;
+        std::uniform_real_distribution<f32> angleDistribution(0.0f, MathUtils::k_pi);
+        for (u32 i = 0; i < numVolumes; ++i)
+        {
+            auto entity = Entity::Create();
+            entity->GetTransform().SetPosition(RandomPoint(random, fieldSize));
+            entity->GetTransform().SetOrientation(Quaternion(Vector3::Normalise(RandomPoint(random, 1.0f) + Vector3::k_one), angleDistribution(random)));
+            
+            auto volumeComponent = std::make_shared<BoxVolumeComponent>();
+            entity->AddComponent(volumeComponent);
+            volumeHierarchy.Add(volumeComponent.get());
+            
+            volumeComponents.push_back(volumeComponent.get());
+            entities.push_back(std::move(entity));
+        }
+        
+        std::vector<Ray> rays;
+        std::vector<Sphere> spheres;
+        for (u32 i = 0; i < k_numQueries; ++i)
+        {
+            Vector3 origin = RandomPoint(random, fieldSize);
+            Vector3 direction = Vector3::Normalise(RandomPoint(random, fieldSize) - origin);
+            rays.push_back(Ray(origin, direction, fieldSize * 2.0f));
+            spheres.push_back(Sphere(RandomPoint(random, fieldSize), k_sphereRadius));
+        }
+        
+        std::vector<VolumeComponent*> results;
+        
+        //The first query builds the tree, so is timed on its own.
+        auto start = std::chrono::steady_clock::now();
+        volumeHierarchy.QueryRay(rays[0], results);
+        f64 buildMicroS = GetMicrosecondsSince(start);
+        
+        bool passed = true;
+        
+        u32 numHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& ray : rays)
+        {
+            results.clear();
+            volumeHierarchy.QueryRay(ray, results);
+            numHits += u32(results.size());
+        }
+        f64 rayMicroS = GetMicrosecondsSince(start) / k_numQueries;
+        
+        u32 numLinearHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& ray : rays)
+        {
+            numLinearHits += QueryRayLinear(volumeComponents, ray);
+        }
+        f64 rayLinearMicroS = GetMicrosecondsSince(start) / k_numQueries;
+        
+        if (numHits != numLinearHits)
+        {
+            std::printf("FAILED: %u volumes, the hierarchy found %u ray hits but the linear scan found %u.\n", numVolumes, numHits, numLinearHits);
+            passed = false;
+        }
+        
+        numHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& sphere : spheres)
+        {
+            results.clear();
+            volumeHierarchy.QuerySphere(sphere, results);
+            numHits += u32(results.size());
+        }
+        f64 sphereMicroS = GetMicrosecondsSince(start) / k_numQueries;
+        
+        numLinearHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto& sphere : spheres)
+        {
+            numLinearHits += QuerySphereLinear(volumeComponents, sphere);
+        }
+        f64 sphereLinearMicroS = GetMicrosecondsSince(start) / k_numQueries;
+        
+        if (numHits != numLinearHits)
+        {
+            std::printf("FAILED: %u volumes, the hierarchy found %u sphere hits but the linear scan found %u.\n", numVolumes, numHits, numLinearHits);
+            passed = false;
+        }
+        
+        //Each frame some boxes move a short distance, and the next query refits them.
+        std::uniform_real_distribution<f32> moveDistribution(-k_maxMoveDistance, k_maxMoveDistance);
+        start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < k_numQueries; ++i)
+        {
+            for (u32 j = 0; j < k_numMovesPerFrame; ++j)
+            {
+                entities[random() % numVolumes]->GetTransform().MoveBy(moveDistribution(random), moveDistribution(random), moveDistribution(random));
+            }
+            
+            results.clear();
+            volumeHierarchy.QueryRay(rays[i], results);
+        }
+        f64 frameMicroS = GetMicrosecondsSince(start) / k_numQueries;
+        
+        std::printf("%6u volumes  build %9.1f us  ray %8.2f us (linear %9.1f us)  sphere %8.2f us (linear %9.1f us)  %u moves + ray %8.2f us\n",
+                    numVolumes, buildMicroS, rayMicroS, rayLinearMicroS, sphereMicroS, sphereLinearMicroS, k_numMovesPerFrame, frameMicroS);
+        
+        for (auto volumeComponent : volumeComponents)
+        {
+            volumeHierarchy.Remove(volumeComponent);
+        }
+        
+        return passed;
+    }
+}
+
+namespace ChilliSource
+{
+    //Scene.cpp is not linked. The benchmark's entities are never added to a scene, so these are never called.
+    
+    //------------------------------------------------------------------------------
+    void Scene::Add(const EntitySPtr& entity)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    void Scene::Remove(Entity* entity)
+    {
+    }
+}
+
+/// Measures the cost of volume hierarchy queries at 1k, 10k and 100k volumes, compared with
+/// testing every volume, and checks that both find the same number of volumes.
+///
+int main()
+{
+    bool passed = true;
+    for (auto numVolumes : k_volumeCounts)
+    {
+        passed &= RunQueries(numVolumes);
+    }
+    
+    return passed ? 0 : 1;
+}
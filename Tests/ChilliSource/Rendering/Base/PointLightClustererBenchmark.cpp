@@ -0,0 +1,223 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Rendering/Base/PointLightClusterer.h>
+#include <ChilliSource/Rendering/Lighting/PointRenderLight.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_lightCounts[] = { 1, 8, 32, 64 };
+    constexpr u32 k_numObjects = 2000;
+    constexpr u32 k_numScenes = 20;
+    constexpr f32 k_fieldSize = 200.0f;
+    constexpr f32 k_minObjectRadius = 0.5f;
+    constexpr f32 k_maxObjectRadius = 4.0f;
+    constexpr f32 k_minRangeOfInfluence = 5.0f;
+    constexpr f32 k_maxRangeOfInfluence = 40.0f;
+    
+    /// Lights are placed in a cube this much larger than the objects, so that some are out
+    /// of range of every object.
+    ///
+    constexpr f32 k_lightFieldMargin = 50.0f;
+    
+    /// @return A random point in a cube spanning the given range on each axis.
+    ///
+    Vector3 RandomPoint(std::mt19937& random, f32 min, f32 max) noexcept
+    {
+        std::uniform_real_distribution<f32> distribution(min, max);
+        return Vector3(distribution(random), distribution(random), distribution(random));
+    }
+    
+    /// @return The given number of randomly placed object bounding spheres.
+    ///
+    std::vector<Sphere> CreateObjectBoundingSpheres(std::mt19937& random, u32 numObjects) noexcept
+    {
+        std::uniform_real_distribution<f32> radiusDistribution(k_minObjectRadius, k_maxObjectRadius);
+        
+        std::vector<Sphere> objectBoundingSpheres;
+        objectBoundingSpheres.reserve(numObjects);
+        for (u32 i = 0; i < numObjects; ++i)
+        {
+            objectBoundingSpheres.push_back(Sphere(RandomPoint(random, 0.0f, k_fieldSize), radiusDistribution(random)));
+        }
+        
+        return objectBoundingSpheres;
+    }
+    
+    /// @return The given number of randomly placed point lights.
+    ///
+    std::vector<PointRenderLight> CreatePointRenderLights(std::mt19937& random, u32 numLights) noexcept
+    {
+        std::uniform_real_distribution<f32> rangeDistribution(k_minRangeOfInfluence, k_maxRangeOfInfluence);
+        
+        std::vector<PointRenderLight> pointRenderLights;
+        pointRenderLights.reserve(numLights);
+        for (u32 i = 0; i < numLights; ++i)
+        {
+            auto position = RandomPoint(random, -k_lightFieldMargin, k_fieldSize + k_lightFieldMargin);
+            pointRenderLights.push_back(PointRenderLight(Colour::k_white, position, Vector3::k_zero, rangeDistribution(random)));
+        }
+        
+        return pointRenderLights;
+    }
+    
+    /// Calculates which objects are influenced by each light by testing every object against
+    /// every light, as ForwardRenderPassCompiler did before PointLightClusterer.
+    ///
+    /// @param objectBoundingSpheres
+    ///     The bounding spheres of the objects which can be lit.
+    /// @param pointRenderLights
+    ///     The point lights.
+    ///
+    /// @return A list for each point light of the indices of the objects it influences.
+    ///
+    std::vector<std::vector<u32>> CalculateLitObjectsBruteForce(const std::vector<Sphere>& objectBoundingSpheres, const std::vector<PointRenderLight>& pointRenderLights) noexcept
+    {
+        std::vector<std::vector<u32>> litObjects;
+        litObjects.reserve(pointRenderLights.size());
+        
+        for (const auto& pointRenderLight : pointRenderLights)
+        {
+            Sphere pointLightBoundingSphere(pointRenderLight.GetPosition(), pointRenderLight.GetRangeOfInfluence());
+            
+            std::vector<u32> objectIndices;
+            for (u32 objectIndex = 0; objectIndex < objectBoundingSpheres.size(); ++objectIndex)
+            {
+                if (pointLightBoundingSphere.Contains(objectBoundingSpheres[objectIndex]))
+                {
+                    objectIndices.push_back(objectIndex);
+                }
+            }
+            
+            litObjects.push_back(std::move(objectIndices));
+        }
+        
+        return litObjects;
+    }
+    
+    /// @return The time since the given start time in microseconds.
+    ///
+    f64 GetMicrosecondsSince(const std::chrono::steady_clock::time_point& start) noexcept
+    {
+        return std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    /// Builds a number of random scenes with the given number of lights, then checks that
+    /// the clustered object lists match the brute force ones, and times both.
+    ///
+    /// @param numLights
+    ///     The number of point lights.
+    ///
+    /// @return Whether or not the clustered lists matched the brute force ones in every scene.
+    ///
+    bool RunScenes(u32 numLights) noexcept
+    {
+        std::mt19937 random(numLights);
+        
+        bool passed = true;
+        u32 numLitObjects = 0;
+        f64 clusteredMicroS = 0.0;
+        f64 bruteForceMicroS = 0.0;
+        
+        for (u32 sceneIndex = 0; sceneIndex < k_numScenes; ++sceneIndex)
+        {
+            auto objectBoundingSpheres = CreateObjectBoundingSpheres(random, k_numObjects);
+            auto pointRenderLights = CreatePointRenderLights(random, numLights);
+            
+            auto start = std::chrono::steady_clock::now();
+            auto clustered = PointLightClusterer::CalculateLitObjects(objectBoundingSpheres, pointRenderLights);
+            clusteredMicroS += GetMicrosecondsSince(start);
+            
+            start = std::chrono::steady_clock::now();
+            auto bruteForce = CalculateLitObjectsBruteForce(objectBoundingSpheres, pointRenderLights);
+            bruteForceMicroS += GetMicrosecondsSince(start);
+            
+            for (u32 lightIndex = 0; lightIndex < numLights; ++lightIndex)
+            {
+                if (clustered[lightIndex] != bruteForce[lightIndex])
+                {
+                    std::printf("FAILED: %u lights, scene %u, light %u is clustered with %u objects but influences %u.\n", numLights, sceneIndex, lightIndex,
+                                u32(clustered[lightIndex].size()), u32(bruteForce[lightIndex].size()));
+                    passed = false;
+                }
+                
+                numLitObjects += u32(bruteForce[lightIndex].size());
+            }
+        }
+        
+        std::printf("%2u lights  %6.1f lit objects per light  clustered %8.1f us  brute force %8.1f us\n", numLights, f64(numLitObjects) / (numLights * k_numScenes),
+                    clusteredMicroS / k_numScenes, bruteForceMicroS / k_numScenes);
+        
+        return passed;
+    }
+    
+    /// Checks the cases where there is nothing to cluster, or where every object is at the
+    /// same position so the grid has no extent.
+    ///
+    /// @return Whether or not the clustered lists matched the brute force ones.
+    ///
+    bool TestDegenerateScenes() noexcept
+    {
+        std::mt19937 random(0);
+        auto pointRenderLights = CreatePointRenderLights(random, 8);
+        
+        if (PointLightClusterer::CalculateLitObjects(std::vector<Sphere>(), pointRenderLights) != std::vector<std::vector<u32>>(pointRenderLights.size()))
+        {
+            std::printf("FAILED: Lights with no objects should each influence no objects.\n");
+            return false;
+        }
+        
+        std::vector<Sphere> objectBoundingSpheres(k_numObjects, Sphere(Vector3(k_fieldSize * 0.5f, k_fieldSize * 0.5f, k_fieldSize * 0.5f), k_minObjectRadius));
+        if (PointLightClusterer::CalculateLitObjects(objectBoundingSpheres, pointRenderLights) != CalculateLitObjectsBruteForce(objectBoundingSpheres, pointRenderLights))
+        {
+            std::printf("FAILED: Coincident objects were clustered differently from the brute force result.\n");
+            return false;
+        }
+        
+        return true;
+    }
+}
+
+/// Checks that PointLightClusterer assigns the same objects to each light as testing every
+/// object against every light, and measures both at 1, 8, 32 and 64 lights.
+///
+int main()
+{
+    bool passed = TestDegenerateScenes();
+    for (auto numLights : k_lightCounts)
+    {
+        passed &= RunScenes(numLights);
+    }
+    
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+#include <ChilliSource/Rendering/Base/RenderPassObject.h>
+#include <ChilliSource/Rendering/Base/RenderPassObjectSorter.h>
+#include <ChilliSource/Rendering/Camera/RenderCamera.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    /// One collection which fits in a single sort task, and one which is split across several.
+    ///
+    constexpr u32 k_objectCounts[] = { 100, 10000 };
+    constexpr u32 k_numThreads = 2;
+    constexpr u32 k_numMaterials = 6;
+    constexpr u32 k_numMeshes = 5;
+    constexpr u32 k_numPositions = 40;
+    constexpr u32 k_maxPriority = 8;
+    constexpr f32 k_fieldOfView = 1.0f;
+    constexpr f32 k_nearClip = 1.0f;
+    constexpr f32 k_farClip = 1000.0f;
+    
+    /// The sorter only compares material and mesh addresses, so these provide distinct addresses
+    /// without creating the resources. They are never dereferenced.
+    ///
+    char g_materials[k_numMaterials];
+    char g_meshes[k_numMeshes];
+    
+    /// Prints a failure message if the given condition is false.
+    ///
+    /// @param condition
+    ///     The condition to check.
+    /// @param description
+    ///     A description of what was expected.
+    ///
+    /// @return The condition.
+    ///
+    bool Check(bool condition, const char* description) noexcept
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+        }
+        
+        return condition;
+    }
+    
+    /// @return The view projection depth of the given object, as calculated by the comparator
+    ///     sorts which the radix sorts replaced.
+    ///
+    f32 CalcDepth(const RenderPassObject& renderPassObject, const RenderCamera& camera) noexcept
+    {
+        return (renderPassObject.GetWorldMatrix() * camera.GetViewProjectionMatrix()).GetTranslation().z;
+    }
+    
+    /// Creates render pass objects drawn from a small set of materials, meshes, positions and
+    /// priorities, so many objects share some or all of their sort key. The radius of each
+    /// bounding sphere is the index of the object, identifying it after sorting.
+    ///
+    /// @param random
+    ///     The random number generator.
+    /// @param numObjects
+    ///     The number of objects to create.
+    ///
+    /// @return The render pass objects.
+    ///
+    std::vector<RenderPassObject> CreateRenderPassObjects(std::mt19937& random, u32 numObjects) noexcept
+    {
+        std::uniform_real_distribution<f32> lateralDistribution(-10.0f, 10.0f);
+        std::uniform_real_distribution<f32> depthDistribution(2.0f, 100.0f);
+        std::vector<Vector3> positions;
+        for (u32 i = 0; i < k_numPositions; ++i)
+        {
+            positions.push_back(Vector3(lateralDistribution(random), lateralDistribution(random), depthDistribution(random)));
+        }
+        
+        std::vector<RenderPassObject> renderPassObjects;
+        renderPassObjects.reserve(numObjects);
+        for (u32 i = 0; i < numObjects; ++i)
+        {
+            auto material = reinterpret_cast<const RenderMaterial*>(&g_materials[random() % k_numMaterials]);
+            auto mesh = reinterpret_cast<const RenderMesh*>(&g_meshes[random() % k_numMeshes]);
+            const auto& position = positions[random() % k_numPositions];
+            renderPassObjects.push_back(RenderPassObject(material, mesh, Matrix4::CreateTranslation(position), Sphere(position, f32(i)), random() % k_maxPriority));
+        }
+        
+        return renderPassObjects;
+    }
+    
+    /// @return Whether or not the two collections contain the same objects in the same order.
+    ///
+    bool IsSameOrder(const std::vector<RenderPassObject>& a, const std::vector<RenderPassObject>& b) noexcept
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const RenderPassObject& objectA, const RenderPassObject& objectB)
+        {
+            return objectA.GetBoundingSphere().fRadius == objectB.GetBoundingSphere().fRadius;
+        });
+    }
+    
+    /// Sorts a copy of the given objects with the given sort function, run within a task
+    /// context so that large collections are split across tasks, and a copy with a stable
+    /// sort using the given comparator. Stable sorting leaves objects with equal keys in
+    /// their original order, which the sort function should match.
+    ///
+    /// @param taskPool
+    ///     The task pool to run the sort tasks on.
+    /// @param renderPassObjects
+    ///     The objects to sort.
+    /// @param sort
+    ///     The sort function under test.
+    /// @param comparator
+    ///     The comparator the sort function should order objects by.
+    ///
+    /// @return Whether or not both sorts gave the same order.
+    ///
+    bool SortsMatch(TaskPool& taskPool, const std::vector<RenderPassObject>& renderPassObjects, const std::function<void(const TaskContext&, std::vector<RenderPassObject>&)>& sort,
+                    const std::function<bool(const RenderPassObject&, const RenderPassObject&)>& comparator) noexcept
+    {
+        auto sorted = renderPassObjects;
+        TaskContext taskContext(TaskType::k_small, &taskPool);
+        sort(taskContext, sorted);
+        
+        auto expected = renderPassObjects;
+        std::stable_sort(expected.begin(), expected.end(), comparator);
+        
+        return IsSameOrder(sorted, expected);
+    }
+    
+    /// Tests each sort against the comparator sort it replaced.
+    ///
+    /// @param taskPool
+    ///     The task pool to run the sort tasks on.
+    /// @param numObjects
+    ///     The number of objects to sort.
+    ///
+    /// @return Whether or not the tests passed.
+    ///
+    bool TestSortOrder(TaskPool& taskPool, u32 numObjects) noexcept
+    {
+        std::mt19937 random(numObjects);
+        auto renderPassObjects = CreateRenderPassObjects(random, numObjects);
+        
+        auto projection = Matrix4::CreatePerspectiveProjectionLH(k_fieldOfView, 1.0f, k_nearClip, k_farClip);
+        RenderCamera camera(Matrix4::k_identity, projection, Quaternion::k_identity);
+        
+        bool opaqueMatches = SortsMatch(taskPool, renderPassObjects, [&](const TaskContext& taskContext, std::vector<RenderPassObject>& objects)
+        {
+            RenderPassObjectSorter::OpaqueSort(taskContext, camera, objects);
+        },
+        [&](const RenderPassObject& a, const RenderPassObject& b)
+        {
+            if (a.GetRenderMaterial() != b.GetRenderMaterial())
+            {
+                return a.GetRenderMaterial() < b.GetRenderMaterial();
+            }
+            
+            f32 depthA = CalcDepth(a, camera);
+            f32 depthB = CalcDepth(b, camera);
+            if (depthA != depthB)
+            {
+                return depthA > depthB;
+            }
+            
+            return a.GetRenderMesh() < b.GetRenderMesh();
+        });
+        
+        bool transparentMatches = SortsMatch(taskPool, renderPassObjects, [&](const TaskContext& taskContext, std::vector<RenderPassObject>& objects)
+        {
+            RenderPassObjectSorter::TransparentSort(taskContext, camera, objects);
+        },
+        [&](const RenderPassObject& a, const RenderPassObject& b)
+        {
+            f32 depthA = CalcDepth(a, camera);
+            f32 depthB = CalcDepth(b, camera);
+            if (depthA != depthB)
+            {
+                return depthA > depthB;
+            }
+            
+            return a.GetRenderMesh() < b.GetRenderMesh();
+        });
+        
+        bool priorityMatches = SortsMatch(taskPool, renderPassObjects, [&](const TaskContext& taskContext, std::vector<RenderPassObject>& objects)
+        {
+            RenderPassObjectSorter::PrioritySort(taskContext, objects);
+        },
+        [&](const RenderPassObject& a, const RenderPassObject& b)
+        {
+            if (a.GetPriority() != b.GetPriority())
+            {
+                return a.GetPriority() < b.GetPriority();
+            }
+            
+            return a.GetRenderMaterial() < b.GetRenderMaterial();
+        });
+        
+        std::printf("%5u objects\n", numObjects);
+        
+        bool passed = true;
+        passed &= Check(opaqueMatches, "the opaque sort matches a stable sort by material, then depth, then mesh.");
+        passed &= Check(transparentMatches, "the transparent sort matches a stable sort by depth, then mesh.");
+        passed &= Check(priorityMatches, "the priority sort matches a stable sort by priority, then material.");
+        
+        return passed;
+    }
+}
+
+/// Tests that the radix sorts of render pass objects give the same order as a stable sort
+/// with the equivalent comparator, including objects with equal keys, both when sorting
+/// in a single task and across several.
+///
+int main()
+{
+    TaskPool taskPool(TaskType::k_small, k_numThreads);
+    
+    bool passed = true;
+    for (auto numObjects : k_objectCounts)
+    {
+        passed &= TestSortOrder(taskPool, numObjects);
+    }
+    
+    std::printf("%s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,484 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Image/ImageCompression.h>
+#include <ChilliSource/Core/Image/ImageFormat.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+#include <ChilliSource/Rendering/Base/BlendMode.h>
+#include <ChilliSource/Rendering/Base/CullFace.h>
+#include <ChilliSource/Rendering/Base/IRenderCommandProcessor.h>
+#include <ChilliSource/Rendering/Base/RenderCommandBufferManager.h>
+#include <ChilliSource/Rendering/Base/Renderer.h>
+#include <ChilliSource/Rendering/Base/RenderLayer.h>
+#include <ChilliSource/Rendering/Base/RenderObject.h>
+#include <ChilliSource/Rendering/Base/RenderPasses.h>
+#include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/StencilOp.h>
+#include <ChilliSource/Rendering/Base/TestFunc.h>
+#include <ChilliSource/Rendering/Lighting/PointRenderLight.h>
+#include <ChilliSource/Rendering/Material/RenderMaterial.h>
+#include <ChilliSource/Rendering/Material/RenderMaterialGroup.h>
+#include <ChilliSource/Rendering/Model/IndexFormat.h>
+#include <ChilliSource/Rendering/Model/PolygonType.h>
+#include <ChilliSource/Rendering/Model/RenderMesh.h>
+#include <ChilliSource/Rendering/Model/VertexFormat.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandBuffer.h>
+#include <ChilliSource/Rendering/Shader/RenderShader.h>
+#include <ChilliSource/Rendering/Target/RenderTargetGroup.h>
+#include <ChilliSource/Rendering/Texture/RenderTexture.h>
+#include <ChilliSource/Rendering/Texture/TextureFilterMode.h>
+#include <ChilliSource/Rendering/Texture/TextureWrapMode.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_maxOffscreenSnapshots = 6;
+    constexpr u32 k_numObjectsPerSnapshot = 2000;
+    constexpr u32 k_numPointLightsPerSnapshot = 4;
+    constexpr u32 k_numFrames = 50;
+    constexpr u32 k_minMaxThreads = 4;
+    constexpr f32 k_objectSpacing = 2.0f;
+    constexpr f32 k_fieldOfView = 1.0f;
+    constexpr f32 k_nearClip = 1.0f;
+    constexpr f32 k_farClip = 1000.0f;
+    
+    const Integer2 k_resolution(1280, 720);
+    
+    /// The main thread, which submits each frame's snapshots.
+    ///
+    std::thread::id g_mainThreadId;
+    
+    /// The pool on which scheduled tasks are run. This is replaced for each thread count.
+    ///
+    TaskPool* g_taskPool = nullptr;
+    
+    /// Tracks the tasks scheduled by the renderer, so the benchmark can wait for each frame's
+    /// render prep to finish.
+    ///
+    std::mutex g_scheduledTasksMutex;
+    std::condition_variable g_scheduledTasksCondition;
+    u32 g_numScheduledTasksRemaining = 0;
+    
+    /// The command buffer pushed by the most recent render prep.
+    ///
+    RenderCommandBufferUPtr g_renderCommandBuffer;
+    
+    /// The application which owns the renderer. Only the members the renderer uses are
+    /// defined by this benchmark.
+    ///
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication() noexcept : Application(nullptr) {}
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// Calls OnInit() and OnDestroy() on an app system, as the application does. The
+    /// methods are protected, so they are named through this derived class.
+    ///
+    class AppSystemLifecycle final : public AppSystem
+    {
+    public:
+        /// @param appSystem
+        ///     The system to initialise.
+        ///
+        static void Init(AppSystem* appSystem) noexcept
+        {
+            (appSystem->*(&AppSystemLifecycle::OnInit))();
+        }
+        
+        /// @param appSystem
+        ///     The system to destroy.
+        ///
+        static void Destroy(AppSystem* appSystem) noexcept
+        {
+            (appSystem->*(&AppSystemLifecycle::OnDestroy))();
+        }
+    };
+    
+    /// The render resources shared by every object in the benchmark. These are never loaded,
+    /// as the render command processor is not run, so the mesh is flagged as uploaded directly.
+    ///
+    struct Resources final
+    {
+        RenderShader m_renderShader;
+        RenderMesh m_renderMesh;
+        std::unique_ptr<RenderMaterialGroup> m_renderMaterialGroup;
+        std::vector<std::unique_ptr<RenderTexture>> m_renderTextures;
+        std::vector<std::unique_ptr<RenderTargetGroup>> m_renderTargetGroups;
+        
+        Resources() noexcept;
+    };
+    
+    /// @return A new opaque material using the given shader. The engine's UniquePtr
+    /// has no default deleter, so one is given explicitly.
+    ///
+    UniquePtr<RenderMaterial> CreateRenderMaterial(const RenderShader* renderShader) noexcept
+    {
+        return UniquePtr<RenderMaterial>(new RenderMaterial(renderShader, std::vector<const RenderTexture*>(), std::vector<const RenderTexture*>(), false, true, true, true, true, false,
+                                                            TestFunc::k_lessEqual, BlendMode::k_one, BlendMode::k_zero, StencilOp::k_keep, StencilOp::k_keep, StencilOp::k_keep, TestFunc::k_always, 0, 0xff,
+                                                            CullFace::k_back, Colour::k_black, Colour::k_white, Colour::k_white, Colour::k_black, nullptr),
+                                         [](const RenderMaterial* renderMaterial) { delete renderMaterial; });
+    }
+    
+    /// @return A material group with a base pass and a point light pass for static meshes.
+    ///
+    std::unique_ptr<RenderMaterialGroup> CreateRenderMaterialGroup(const RenderShader* renderShader) noexcept
+    {
+        std::vector<UniquePtr<RenderMaterial>> renderMaterials;
+        renderMaterials.push_back(CreateRenderMaterial(renderShader));
+        renderMaterials.push_back(CreateRenderMaterial(renderShader));
+        
+        std::array<const RenderMaterial*, RenderMaterialGroup::k_numMaterialSlots> slots {};
+        slots[u32(RenderPasses::k_base)] = renderMaterials[0].get();
+        slots[u32(RenderPasses::k_pointLight)] = renderMaterials[1].get();
+        
+        std::vector<RenderMaterialGroup::Collection> collections;
+        collections.push_back(RenderMaterialGroup::Collection(VertexFormat::k_staticMesh, slots));
+        
+        return std::unique_ptr<RenderMaterialGroup>(new RenderMaterialGroup(std::move(renderMaterials), std::move(collections)));
+    }
+    
+    //------------------------------------------------------------------------------
+    Resources::Resources() noexcept
+        : m_renderMesh(PolygonType::k_triangle, VertexFormat::k_staticMesh, IndexFormat::k_short, 24, 36, Sphere(Vector3::k_zero, 1.0f), false),
+          m_renderMaterialGroup(CreateRenderMaterialGroup(&m_renderShader))
+    {
+        m_renderMesh.SetUploaded();
+        
+        m_renderTextures.reserve(k_maxOffscreenSnapshots);
+        m_renderTargetGroups.reserve(k_maxOffscreenSnapshots);
+        for (u32 i = 0; i < k_maxOffscreenSnapshots; ++i)
+        {
+            m_renderTextures.push_back(std::unique_ptr<RenderTexture>(new RenderTexture(k_resolution, ImageFormat::k_RGBA8888, ImageCompression::k_none, TextureFilterMode::k_bilinear, TextureWrapMode::k_clamp, TextureWrapMode::k_clamp, false, false)));
+            m_renderTargetGroups.push_back(std::unique_ptr<RenderTargetGroup>(new RenderTargetGroup(m_renderTextures.back().get(), nullptr, RenderTargetGroupType::k_colour)));
+        }
+    }
+    
+    /// Creates a snapshot of a grid of objects in front of the camera, lit by a few point
+    /// lights, as each offscreen target and the main screen would have in a game scene.
+    ///
+    /// @param renderer
+    ///     The renderer.
+    /// @param resources
+    ///     The shared render resources.
+    /// @param renderTargetGroup
+    ///     The offscreen target, or null for the main screen.
+    ///
+    /// @return The snapshot.
+    ///
+    RenderSnapshot CreateRenderSnapshot(Renderer* renderer, const Resources& resources, const RenderTargetGroup* renderTargetGroup) noexcept
+    {
+        auto projection = Matrix4::CreatePerspectiveProjectionLH(k_fieldOfView, f32(k_resolution.x) / f32(k_resolution.y), k_nearClip, k_farClip);
+        RenderCamera renderCamera(Matrix4::k_identity, projection, Quaternion::k_identity);
+        
+        auto renderSnapshot = renderer->CreateRenderSnapshot(renderTargetGroup, k_resolution, Colour::k_black, renderCamera);
+        
+        u32 gridSize = u32(std::sqrt(f32(k_numObjectsPerSnapshot)));
+        f32 gridOffset = f32(gridSize) * k_objectSpacing * 0.5f;
+        for (u32 i = 0; i < k_numObjectsPerSnapshot; ++i)
+        {
+            Vector3 position(f32(i % gridSize) * k_objectSpacing - gridOffset, f32(i / gridSize % gridSize) * k_objectSpacing - gridOffset, gridOffset * 2.0f + f32(i % 7));
+            renderSnapshot.AddRenderObject(RenderObject(resources.m_renderMaterialGroup.get(), &resources.m_renderMesh, Matrix4::CreateTranslation(position), Sphere(position, 1.0f), false,
+                                                        RenderLayer::k_standard));
+        }
+        
+        for (u32 i = 0; i < k_numPointLightsPerSnapshot; ++i)
+        {
+            Vector3 position(f32(i) * gridOffset * 0.5f - gridOffset * 0.75f, 0.0f, gridOffset * 2.0f);
+            renderSnapshot.AddPointRenderLight(PointRenderLight(Colour::k_white, position, Vector3::k_zero, gridOffset * 0.5f));
+        }
+        
+        return renderSnapshot;
+    }
+    
+    /// @return The total number of render commands in the given buffer.
+    ///
+    u32 CountRenderCommands(RenderCommandBuffer* renderCommandBuffer) noexcept
+    {
+        u32 numCommands = 0;
+        for (u32 i = 0; i < renderCommandBuffer->GetNumSlots(); ++i)
+        {
+            numCommands += renderCommandBuffer->GetRenderCommandList(i)->GetNumCommands();
+        }
+        
+        return numCommands;
+    }
+    
+    /// Submits a number of frames with the given number of offscreen snapshots on a pool
+    /// with the given number of threads, and times how long each frame's render prep takes.
+    ///
+    /// @param renderer
+    ///     The renderer.
+    /// @param resources
+    ///     The shared render resources.
+    /// @param numOffscreenSnapshots
+    ///     The number of offscreen snapshots in each frame.
+    /// @param numThreads
+    ///     The number of worker threads.
+    /// @param out_numCommands
+    ///     (Out) The number of render commands compiled for the final frame.
+    ///
+    /// @return The average render prep time in microseconds.
+    ///
+    f64 RunFrames(Renderer* renderer, const Resources& resources, u32 numOffscreenSnapshots, u32 numThreads, u32& out_numCommands) noexcept
+    {
+        TaskPool taskPool(TaskType::k_small, numThreads);
+        g_taskPool = &taskPool;
+        
+        f64 totalMicroS = 0.0;
+        for (u32 frame = 0; frame < k_numFrames; ++frame)
+        {
+            auto frameAllocator = renderer->GetFrameAllocatorQueue().Pop();
+            
+            auto mainSnapshot = CreateRenderSnapshot(renderer, resources, nullptr);
+            std::vector<RenderSnapshot> offscreenSnapshots;
+            for (u32 i = 0; i < numOffscreenSnapshots; ++i)
+            {
+                offscreenSnapshots.push_back(CreateRenderSnapshot(renderer, resources, resources.m_renderTargetGroups[i].get()));
+            }
+            
+            auto start = std::chrono::steady_clock::now();
+            renderer->ProcessRenderSnapshots(frameAllocator, std::move(mainSnapshot), std::move(offscreenSnapshots));
+            {
+                std::unique_lock<std::mutex> lock(g_scheduledTasksMutex);
+                g_scheduledTasksCondition.wait(lock, []() { return g_numScheduledTasksRemaining == 0; });
+            }
+            totalMicroS += std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+            
+            out_numCommands = CountRenderCommands(g_renderCommandBuffer.get());
+            g_renderCommandBuffer.reset();
+            renderer->GetFrameAllocatorQueue().Push(frameAllocator);
+        }
+        
+        g_taskPool = nullptr;
+        
+        return totalMicroS / k_numFrames;
+    }
+}
+
+namespace ChilliSource
+{
+    //Application.cpp, TaskScheduler.cpp, IRenderCommandProcessor.cpp and RenderCommandBufferManager.cpp are not linked. Only the
+    //members used during render prep are defined, with scheduled tasks run on the benchmark's own task pool, and the compiled
+    //command buffer kept by the benchmark rather than passed to a render command processor.
+    
+    CS_DEFINE_NAMEDTYPE(RenderCommandBufferManager);
+    
+    Application* Application::s_application = nullptr;
+    
+    //------------------------------------------------------------------------------
+    Application::Application(SystemInfoCUPtr systemInfo) noexcept
+        : m_systemInfo(std::move(systemInfo))
+    {
+        s_application = this;
+        m_isSystemCreationAllowed = true;
+    }
+    
+    //------------------------------------------------------------------------------
+    Application::~Application() noexcept
+    {
+        s_application = nullptr;
+    }
+    
+    //------------------------------------------------------------------------------
+    Application* Application::Get() noexcept
+    {
+        return s_application;
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskScheduler* Application::GetTaskScheduler() noexcept
+    {
+        static u8 s_taskScheduler;
+        return reinterpret_cast<TaskScheduler*>(&s_taskScheduler);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool TaskScheduler::IsMainThread() const noexcept
+    {
+        return std::this_thread::get_id() == g_mainThreadId;
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskScheduler::ScheduleTask(TaskType taskType, const Task& task) noexcept
+    {
+        ScheduleTasks(taskType, std::vector<Task>({ task }));
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskScheduler::ScheduleTasks(TaskType taskType, const std::vector<Task>& tasks) noexcept
+    {
+        {
+            std::unique_lock<std::mutex> lock(g_scheduledTasksMutex);
+            g_numScheduledTasksRemaining += u32(tasks.size());
+        }
+        
+        std::vector<Task> trackedTasks;
+        trackedTasks.reserve(tasks.size());
+        for (const auto& task : tasks)
+        {
+            trackedTasks.push_back([=](const TaskContext& taskContext) noexcept
+            {
+                task(taskContext);
+                
+                std::unique_lock<std::mutex> lock(g_scheduledTasksMutex);
+                if (--g_numScheduledTasksRemaining == 0)
+                {
+                    g_scheduledTasksCondition.notify_all();
+                }
+            });
+        }
+        
+        g_taskPool->AddTasks(trackedTasks);
+    }
+    
+    //------------------------------------------------------------------------------
+    IRenderCommandProcessorUPtr IRenderCommandProcessor::Create() noexcept
+    {
+        return nullptr;
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandBufferManagerUPtr RenderCommandBufferManager::Create() noexcept
+    {
+        return RenderCommandBufferManagerUPtr(new RenderCommandBufferManager());
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandBufferManager::RenderCommandBufferManager()
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    bool RenderCommandBufferManager::IsA(InterfaceIDType interfaceId) const noexcept
+    {
+        return (RenderCommandBufferManager::InterfaceID == interfaceId);
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandBufferManager::WaitThenPushCommandBuffer(RenderCommandBufferUPtr renderCommandBuffer) noexcept
+    {
+        g_renderCommandBuffer = std::move(renderCommandBuffer);
+    }
+    
+    //------------------------------------------------------------------------------
+    RenderCommandBufferCUPtr RenderCommandBufferManager::WaitThenPopCommandBuffer() noexcept
+    {
+        return nullptr;
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandBufferManager::OnInit() noexcept
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandBufferManager::OnResume() noexcept
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    void RenderCommandBufferManager::OnRenderSnapshot(TargetType targetType, RenderSnapshot& renderSnapshot, IAllocator* frameAllocator) noexcept
+    {
+    }
+}
+
+/// Measures how long render prep takes for a frame with 0 to 6 offscreen snapshots, on 1
+/// thread and on the hardware concurrency, or at least 4 threads. Each snapshot holds the
+/// same scene, so the number of render commands compiled is checked to grow by the same
+/// amount for each offscreen snapshot, and to be identical for both thread counts.
+///
+int main()
+{
+    g_mainThreadId = std::this_thread::get_id();
+    
+    BenchmarkApplication application;
+    auto renderCommandBufferManager = application.CreateSystem<RenderCommandBufferManager>();
+    auto renderer = application.CreateSystem<Renderer>();
+    AppSystemLifecycle::Init(renderCommandBufferManager);
+    AppSystemLifecycle::Init(renderer);
+    
+    Resources resources;
+    
+    u32 maxThreads = std::max(k_minMaxThreads, std::thread::hardware_concurrency());
+    std::printf("%u objects and %u point lights per snapshot\n", k_numObjectsPerSnapshot, k_numPointLightsPerSnapshot);
+    
+    bool passed = true;
+    u32 numCommandsPerSnapshot = 0;
+    u32 numMainCommands = 0;
+    for (u32 numOffscreenSnapshots = 0; numOffscreenSnapshots <= k_maxOffscreenSnapshots; ++numOffscreenSnapshots)
+    {
+        u32 numCommands = 0, numCommandsMultiThreaded = 0;
+        f64 microS = RunFrames(renderer, resources, numOffscreenSnapshots, 1, numCommands);
+        f64 microSMultiThreaded = RunFrames(renderer, resources, numOffscreenSnapshots, maxThreads, numCommandsMultiThreaded);
+        
+        std::printf("%u offscreen  1 thread %9.1f us  %2u threads %9.1f us  %6u commands\n", numOffscreenSnapshots, microS, maxThreads, microSMultiThreaded, numCommands);
+        
+        if (numCommands != numCommandsMultiThreaded)
+        {
+            std::printf("FAILED: %u offscreen snapshots compiled %u commands on 1 thread but %u on %u threads.\n", numOffscreenSnapshots, numCommands, numCommandsMultiThreaded, maxThreads);
+            passed = false;
+        }
+        
+        if (numOffscreenSnapshots == 0)
+        {
+            numMainCommands = numCommands;
+        }
+        else if (numOffscreenSnapshots == 1)
+        {
+            numCommandsPerSnapshot = numCommands - numMainCommands;
+        }
+        else if (numCommands != numMainCommands + numOffscreenSnapshots * numCommandsPerSnapshot)
+        {
+            std::printf("FAILED: %u offscreen snapshots compiled %u commands, expected %u.\n", numOffscreenSnapshots, numCommands, numMainCommands + numOffscreenSnapshots * numCommandsPerSnapshot);
+            passed = false;
+        }
+    }
+    
+    AppSystemLifecycle::Destroy(renderer);
+    
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Rendering/Model/CompressedKeyFrames.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimationPose.h>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_nodeCounts[] = { 20, 60, 120 };
+    constexpr u32 k_numFrames = 120;
+    constexpr u32 k_numPasses = 200;
+    
+    /// Every nth node has an animated translation. The rest have constant translations, as
+    /// most joints only rotate.
+    ///
+    constexpr u32 k_animatedTranslationInterval = 8;
+    
+    /// Every nth node has a constant orientation, such as the end of a chain.
+    ///
+    constexpr u32 k_constantOrientationInterval = 5;
+    
+    /// Every nth node has an animated scale.
+    ///
+    constexpr u32 k_animatedScaleInterval = 16;
+    
+    /// @return Key frames for a typical character animation with the given number of nodes.
+    ///     Most joints only rotate, and the rest of the tracks are constant.
+    ///
+    std::vector<SkinnedAnimation::FrameCUPtr> CreateKeyFrames(u32 numNodes) noexcept
+    {
+        std::mt19937 random(numNodes);
+        std::uniform_real_distribution<f32> unitDistribution(-1.0f, 1.0f);
+        
+        std::vector<Vector3> axes;
+        std::vector<Vector3> translations;
+        for (u32 i = 0; i < numNodes; ++i)
+        {
+            axes.push_back(Vector3::Normalise(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random))));
+            translations.push_back(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)));
+        }
+        
+        std::vector<SkinnedAnimation::FrameCUPtr> frames;
+        for (u32 frameIndex = 0; frameIndex < k_numFrames; ++frameIndex)
+        {
+            f32 time = f32(frameIndex) / f32(k_numFrames);
+            
+            SkinnedAnimation::FrameUPtr frame(new SkinnedAnimation::Frame());
+            for (u32 i = 0; i < numNodes; ++i)
+            {
+                bool isTranslationAnimated = (i % k_animatedTranslationInterval == 0);
+                bool isOrientationAnimated = (i % k_constantOrientationInterval != 0);
+                bool isScaleAnimated = (i % k_animatedScaleInterval == 0);
+                
+                frame->m_nodeTranslations.push_back(isTranslationAnimated ? translations[i] + Vector3(time, 0.5f * time * time, 0.0f) : translations[i]);
+                frame->m_nodeOrientations.push_back(Quaternion(axes[i], isOrientationAnimated ? 6.0f * time : 0.5f));
+                frame->m_nodeScales.push_back(isScaleAnimated ? Vector3(1.0f + time, 1.0f, 1.0f + time) : Vector3::k_one);
+            }
+            frames.push_back(std::move(frame));
+        }
+        
+        return frames;
+    }
+    
+    /// @return The number of bytes used by the given key frames when they are stored at full
+    ///     precision, as they are in SkinnedAnimation.
+    ///
+    u32 GetMemoryUsage(const std::vector<SkinnedAnimation::FrameCUPtr>& frames) noexcept
+    {
+        u32 memoryUsage = u32(frames.capacity() * sizeof(SkinnedAnimation::FrameCUPtr));
+        for (const auto& frame : frames)
+        {
+            memoryUsage += u32(sizeof(SkinnedAnimation::Frame) + frame->m_nodeTranslations.capacity() * sizeof(Vector3) + frame->m_nodeOrientations.capacity() * sizeof(Quaternion) +
+                               frame->m_nodeScales.capacity() * sizeof(Vector3));
+        }
+        
+        return memoryUsage;
+    }
+    
+    /// @return The time since the given start time in microseconds.
+    ///
+    f64 GetMicrosecondsSince(const std::chrono::steady_clock::time_point& start) noexcept
+    {
+        return std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    /// Compresses the key frames of an animation with the given number of nodes, then reports
+    /// the memory used and the time taken to decode each frame, compared to the full precision
+    /// frames.
+    ///
+    /// Full precision frames are decoded with SkinnedAnimationPose::SetFrame(), which is what
+    /// sampling an uncompressed animation does. Compressed frames are decoded with
+    /// CompressedKeyFrames::DecodeFrame() into channels laid out in the same way as the pose,
+    /// which is what sampling a compressed animation does.
+    ///
+    /// @param numNodes
+    ///     The number of nodes.
+    ///
+    void RunDecodes(u32 numNodes) noexcept
+    {
+        auto frames = CreateKeyFrames(numNodes);
+        CompressedKeyFrames compressedKeyFrames(frames);
+        
+        SkinnedAnimationPose pose(numNodes);
+        auto start = std::chrono::steady_clock::now();
+        for (u32 pass = 0; pass < k_numPasses; ++pass)
+        {
+            for (const auto& frame : frames)
+            {
+                pose.SetFrame(*frame);
+            }
+        }
+        f64 rawMicroS = GetMicrosecondsSince(start);
+        
+        std::vector<f32> channels[10];
+        for (auto& channel : channels)
+        {
+            channel.resize(numNodes);
+        }
+        f32* const translations[3] = { channels[0].data(), channels[1].data(), channels[2].data() };
+        f32* const scales[3] = { channels[3].data(), channels[4].data(), channels[5].data() };
+        f32* const orientations[4] = { channels[6].data(), channels[7].data(), channels[8].data(), channels[9].data() };
+        
+        start = std::chrono::steady_clock::now();
+        for (u32 pass = 0; pass < k_numPasses; ++pass)
+        {
+            for (u32 frameIndex = 0; frameIndex < k_numFrames; ++frameIndex)
+            {
+                compressedKeyFrames.DecodeFrame(frameIndex, numNodes, translations, scales, orientations);
+            }
+        }
+        f64 compressedMicroS = GetMicrosecondsSince(start);
+        
+        u32 rawBytes = GetMemoryUsage(frames);
+        u32 compressedBytes = compressedKeyFrames.GetMemoryUsage();
+        f64 numDecodes = f64(k_numPasses * k_numFrames);
+        std::printf("%4u nodes  raw %8u bytes  compressed %7u bytes (%4.1f%%)  decode raw %6.3f us  compressed %6.3f us  (%5.0f vs %5.0f frames/ms)\n", numNodes, rawBytes, compressedBytes,
+                    100.0 * f64(compressedBytes) / f64(rawBytes), rawMicroS / numDecodes, compressedMicroS / numDecodes, numDecodes * 1000.0 / rawMicroS, numDecodes * 1000.0 / compressedMicroS);
+    }
+}
+
+/// Measures the memory used by compressed key frames and the time taken to decode them, against
+/// full precision key frames. The accuracy of the decoded frames is checked by
+/// CompressedKeyFramesTest.
+///
+int main()
+{
+    std::printf("%u frames per animation\n", k_numFrames);
+    
+    for (u32 numNodes : k_nodeCounts)
+    {
+        RunDecodes(numNodes);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,459 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Rendering/Model/CompressedKeyFrames.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_numNodes = 40;
+    constexpr u32 k_numFrames = 50;
+    constexpr f32 k_maxQuantisedValue = 65535.0f;
+    
+    /// The largest difference allowed between a value in a track which is stored as constant
+    /// and the original value in any frame.
+    ///
+    constexpr f32 k_constantTolerance = 0.00001f;
+    
+    /// The largest angle in radians allowed between a decoded orientation and the original.
+    /// Each of the three stored components of an orientation is quantised to 15-bits over
+    /// +/- 1 / sqrt(2), so is within 2.2e-5 of the original, and the dropped component is
+    /// rebuilt from them.
+    ///
+    constexpr f64 k_maxOrientationError = 0.0002;
+    
+    /// The output channels for a single decoded frame.
+    ///
+    struct DecodedFrame final
+    {
+        std::vector<f32> m_channels[10];
+        
+        /// Creates channels for the given number of nodes. Each value is set to the given fill
+        /// value, so that untouched values can be detected.
+        ///
+        DecodedFrame(u32 numNodes, f32 fill) noexcept
+        {
+            for (auto& channel : m_channels)
+            {
+                channel.assign(numNodes, fill);
+            }
+        }
+        
+        /// Decodes the given frame into the channels.
+        ///
+        void Decode(const CompressedKeyFrames& compressedKeyFrames, u32 frameIndex) noexcept
+        {
+            f32* const translations[3] = { m_channels[0].data(), m_channels[1].data(), m_channels[2].data() };
+            f32* const scales[3] = { m_channels[3].data(), m_channels[4].data(), m_channels[5].data() };
+            f32* const orientations[4] = { m_channels[6].data(), m_channels[7].data(), m_channels[8].data(), m_channels[9].data() };
+            compressedKeyFrames.DecodeFrame(frameIndex, u32(m_channels[0].size()), translations, scales, orientations);
+        }
+        
+        Vector3 GetTranslation(u32 i) const noexcept { return Vector3(m_channels[0][i], m_channels[1][i], m_channels[2][i]); }
+        Vector3 GetScale(u32 i) const noexcept { return Vector3(m_channels[3][i], m_channels[4][i], m_channels[5][i]); }
+        Quaternion GetOrientation(u32 i) const noexcept { return Quaternion(m_channels[6][i], m_channels[7][i], m_channels[8][i], m_channels[9][i]); }
+    };
+    
+    /// Prints a failure message if the given condition is false.
+    ///
+    /// @param condition
+    ///     The condition to check.
+    /// @param description
+    ///     A description of what was expected.
+    ///
+    /// @return The condition.
+    ///
+    bool Check(bool condition, const char* description) noexcept
+    {
+        if (!condition)
+        {
+            std::printf("FAILED: %s\n", description);
+        }
+        
+        return condition;
+    }
+    
+    /// The ways in which a track can change over the course of the key frames.
+    ///
+    enum class TrackType
+    {
+        k_animated,
+        k_constant,
+        k_withinTolerance
+    };
+    
+    /// @return The type of each track of the given node. Each node has a different combination.
+    ///
+    TrackType GetTranslationType(u32 nodeIndex) noexcept { return TrackType(nodeIndex % 3); }
+    TrackType GetOrientationType(u32 nodeIndex) noexcept { return TrackType((nodeIndex / 3) % 3); }
+    TrackType GetScaleType(u32 nodeIndex) noexcept { return TrackType((nodeIndex / 9) % 3); }
+    
+    /// @return A random unit quaternion.
+    ///
+    Quaternion RandomOrientation(std::mt19937& random) noexcept
+    {
+        std::normal_distribution<f32> distribution;
+        return Quaternion::Normalise(Quaternion(distribution(random), distribution(random), distribution(random), distribution(random)));
+    }
+    
+    /// @return The given orientation with each component negated. This describes the same
+    ///     orientation.
+    ///
+    Quaternion Negate(const Quaternion& orientation) noexcept
+    {
+        return Quaternion(-orientation.x, -orientation.y, -orientation.z, -orientation.w);
+    }
+    
+    /// @return Key frames covering the cases the encoding has to handle. Each node's tracks
+    ///     are animated, constant, or vary by less than the constant tolerance, in a different
+    ///     combination per node. Animated translations range from a few millimetres to
+    ///     thousands of units, scales can be negative, and orientations are random, so each
+    ///     component is the largest in some frames and quaternions with a negative largest
+    ///     component are included.
+    ///
+    std::vector<SkinnedAnimation::FrameCUPtr> CreateKeyFrames(std::mt19937& random) noexcept
+    {
+        std::uniform_real_distribution<f32> unitDistribution(-1.0f, 1.0f);
+        
+        std::vector<Vector3> constantTranslations, constantScales;
+        std::vector<Quaternion> constantOrientations;
+        std::vector<f32> translationRanges;
+        for (u32 i = 0; i < k_numNodes; ++i)
+        {
+            constantTranslations.push_back(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)) * 10.0f);
+            constantScales.push_back(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)) * 2.0f);
+            constantOrientations.push_back(RandomOrientation(random));
+            translationRanges.push_back(std::pow(10.0f, f32(i % 7) - 3.0f));
+        }
+        
+        std::vector<SkinnedAnimation::FrameCUPtr> frames;
+        for (u32 frameIndex = 0; frameIndex < k_numFrames; ++frameIndex)
+        {
+            SkinnedAnimation::FrameUPtr frame(new SkinnedAnimation::Frame());
+            for (u32 i = 0; i < k_numNodes; ++i)
+            {
+                Vector3 jitter = Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)) * (0.4f * k_constantTolerance);
+                
+                switch (GetTranslationType(i))
+                {
+                    case TrackType::k_animated:
+                        frame->m_nodeTranslations.push_back(constantTranslations[i] + Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)) * translationRanges[i]);
+                        break;
+                    case TrackType::k_constant:
+                        frame->m_nodeTranslations.push_back(constantTranslations[i]);
+                        break;
+                    case TrackType::k_withinTolerance:
+                        frame->m_nodeTranslations.push_back(constantTranslations[i] + jitter);
+                        break;
+                }
+                
+                switch (GetOrientationType(i))
+                {
+                    case TrackType::k_animated:
+                    {
+                        auto orientation = RandomOrientation(random);
+                        frame->m_nodeOrientations.push_back((frameIndex % 2 == 0) ? orientation : Negate(orientation));
+                        break;
+                    }
+                    case TrackType::k_constant:
+                        frame->m_nodeOrientations.push_back((frameIndex % 2 == 0) ? constantOrientations[i] : Negate(constantOrientations[i]));
+                        break;
+                    case TrackType::k_withinTolerance:
+                        frame->m_nodeOrientations.push_back(Quaternion::Normalise(constantOrientations[i] + Quaternion(jitter.x, jitter.y, jitter.z, jitter.x)));
+                        break;
+                }
+                
+                switch (GetScaleType(i))
+                {
+                    case TrackType::k_animated:
+                        frame->m_nodeScales.push_back(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)) * 3.0f);
+                        break;
+                    case TrackType::k_constant:
+                        frame->m_nodeScales.push_back(constantScales[i]);
+                        break;
+                    case TrackType::k_withinTolerance:
+                        frame->m_nodeScales.push_back(constantScales[i] + jitter);
+                        break;
+                }
+            }
+            frames.push_back(std::move(frame));
+        }
+        
+        return frames;
+    }
+    
+    /// @return The extents of each component of the given vector track over all frames.
+    ///
+    Vector3 GetTrackExtents(const std::vector<SkinnedAnimation::FrameCUPtr>& frames, u32 nodeIndex, std::vector<Vector3> SkinnedAnimation::Frame::* member) noexcept
+    {
+        Vector3 min = ((*frames[0]).*member)[nodeIndex];
+        Vector3 max = min;
+        for (const auto& frame : frames)
+        {
+            min = Vector3::Min(min, ((*frame).*member)[nodeIndex]);
+            max = Vector3::Max(max, ((*frame).*member)[nodeIndex]);
+        }
+        
+        return max - min;
+    }
+    
+    /// @return Whether or not each component of the decoded vector is within the error bound of
+    ///     the original. The bound is one quantisation step of the track's extents, allowing for
+    ///     rounding of both the encoded value and the float arithmetic, or the constant tolerance,
+    ///     whichever is larger.
+    ///
+    bool IsVectorWithinBounds(const Vector3& decoded, const Vector3& original, const Vector3& extents) noexcept
+    {
+        const f32 decodedValues[3] = { decoded.x, decoded.y, decoded.z };
+        const f32 originalValues[3] = { original.x, original.y, original.z };
+        const f32 extentValues[3] = { extents.x, extents.y, extents.z };
+        for (u32 i = 0; i < 3; ++i)
+        {
+            f32 bound = std::max(extentValues[i] / k_maxQuantisedValue, k_constantTolerance) + 1e-6f * std::abs(originalValues[i]);
+            if (std::abs(decodedValues[i] - originalValues[i]) > bound)
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    /// @return The angle in radians between the two orientations.
+    ///
+    f64 GetAngleBetween(const Quaternion& a, const Quaternion& b) noexcept
+    {
+        f64 dot = std::abs(f64(a.x) * b.x + f64(a.y) * b.y + f64(a.z) * b.z + f64(a.w) * b.w);
+        f64 lengths = std::sqrt((f64(a.x) * a.x + f64(a.y) * a.y + f64(a.z) * a.z + f64(a.w) * a.w) * (f64(b.x) * b.x + f64(b.y) * b.y + f64(b.z) * b.z + f64(b.w) * b.w));
+        return 2.0 * std::acos(std::min(dot / lengths, 1.0));
+    }
+    
+    /// Checks that every decoded value of every frame is within the error bounds of the
+    /// original key frames, and that decoded orientations are normalised.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestErrorBounds() noexcept
+    {
+        std::mt19937 random(19);
+        auto frames = CreateKeyFrames(random);
+        CompressedKeyFrames compressedKeyFrames(frames);
+        
+        bool passed = true;
+        passed &= Check(compressedKeyFrames.GetNumFrames() == k_numFrames && compressedKeyFrames.GetNumNodes() == k_numNodes, "the frame and node counts are unchanged.");
+        
+        u32 numTranslationFailures = 0, numScaleFailures = 0, numOrientationFailures = 0, numUnnormalised = 0;
+        f64 maxOrientationError = 0.0;
+        DecodedFrame decodedFrame(k_numNodes, 0.0f);
+        for (u32 frameIndex = 0; frameIndex < k_numFrames; ++frameIndex)
+        {
+            decodedFrame.Decode(compressedKeyFrames, frameIndex);
+            const auto& frame = *frames[frameIndex];
+            
+            for (u32 i = 0; i < k_numNodes; ++i)
+            {
+                auto translationExtents = GetTrackExtents(frames, i, &SkinnedAnimation::Frame::m_nodeTranslations);
+                if (!IsVectorWithinBounds(decodedFrame.GetTranslation(i), frame.m_nodeTranslations[i], translationExtents))
+                {
+                    ++numTranslationFailures;
+                }
+                
+                auto scaleExtents = GetTrackExtents(frames, i, &SkinnedAnimation::Frame::m_nodeScales);
+                if (!IsVectorWithinBounds(decodedFrame.GetScale(i), frame.m_nodeScales[i], scaleExtents))
+                {
+                    ++numScaleFailures;
+                }
+                
+                auto orientation = decodedFrame.GetOrientation(i);
+                f64 orientationError = GetAngleBetween(orientation, frame.m_nodeOrientations[i]);
+                maxOrientationError = std::max(maxOrientationError, orientationError);
+                if (orientationError > k_maxOrientationError)
+                {
+                    ++numOrientationFailures;
+                }
+                
+                if (std::abs(Quaternion::Dot(orientation, orientation) - 1.0f) > 1e-4f)
+                {
+                    ++numUnnormalised;
+                }
+            }
+        }
+        
+        std::printf("max orientation error %.2e radians\n", maxOrientationError);
+        
+        passed &= Check(numTranslationFailures == 0, "decoded translations are within one quantisation step of the original.");
+        passed &= Check(numScaleFailures == 0, "decoded scales are within one quantisation step of the original.");
+        passed &= Check(numOrientationFailures == 0, "decoded orientations are within the error bound of the original.");
+        passed &= Check(numUnnormalised == 0, "decoded orientations are normalised.");
+        
+        return passed;
+    }
+    
+    /// Checks that only animated tracks are stored per frame, and that a single frame is
+    /// stored entirely as constant tracks.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestConstantTrackElision() noexcept
+    {
+        std::mt19937 random(7);
+        auto frames = CreateKeyFrames(random);
+        
+        std::vector<SkinnedAnimation::FrameCUPtr> singleFrame;
+        singleFrame.push_back(SkinnedAnimation::FrameCUPtr(new SkinnedAnimation::Frame(*frames[0])));
+        
+        std::vector<SkinnedAnimation::FrameCUPtr> twoFrames;
+        twoFrames.push_back(SkinnedAnimation::FrameCUPtr(new SkinnedAnimation::Frame(*frames[0])));
+        twoFrames.push_back(SkinnedAnimation::FrameCUPtr(new SkinnedAnimation::Frame(*frames[1])));
+        
+        CompressedKeyFrames compressedSingleFrame(singleFrame);
+        CompressedKeyFrames compressedTwoFrames(twoFrames);
+        
+        //Every track of a single frame is constant, so the two frames hold three 16-bit values
+        //per frame for each animated track, and nothing for the rest.
+        u32 numAnimatedTracks = 0;
+        for (u32 i = 0; i < k_numNodes; ++i)
+        {
+            numAnimatedTracks += (GetTranslationType(i) == TrackType::k_animated) + (GetOrientationType(i) == TrackType::k_animated) + (GetScaleType(i) == TrackType::k_animated);
+        }
+        u32 animatedBytes = numAnimatedTracks * 3 * sizeof(u16) * 2;
+        
+        bool passed = true;
+        passed &= Check(compressedTwoFrames.GetMemoryUsage() == compressedSingleFrame.GetMemoryUsage() + animatedBytes, "only animated tracks are stored per frame.");
+        
+        DecodedFrame decodedFrame(k_numNodes, 0.0f);
+        decodedFrame.Decode(compressedSingleFrame, 0);
+        
+        bool isExact = true;
+        for (u32 i = 0; i < k_numNodes; ++i)
+        {
+            isExact &= (decodedFrame.GetTranslation(i) == frames[0]->m_nodeTranslations[i] && decodedFrame.GetScale(i) == frames[0]->m_nodeScales[i]);
+        }
+        passed &= Check(isExact, "a single frame is stored at full precision.");
+        
+        return passed;
+    }
+    
+    /// Checks that an orientation track which turns slowly is not mistaken for a constant
+    /// track. Quaternions which differ by a small angle have a dot product very close to 1,
+    /// so a tolerance on that would treat rotations of up to half a degree as constant.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestSlowRotation() noexcept
+    {
+        constexpr u32 k_numSlowFrames = 5;
+        constexpr f32 k_anglePerFrame = 0.001f;
+        
+        std::vector<SkinnedAnimation::FrameCUPtr> frames;
+        for (u32 frameIndex = 0; frameIndex < k_numSlowFrames; ++frameIndex)
+        {
+            SkinnedAnimation::FrameUPtr frame(new SkinnedAnimation::Frame());
+            frame->m_nodeTranslations.push_back(Vector3::k_zero);
+            frame->m_nodeOrientations.push_back(Quaternion(Vector3::k_unitPositiveY, k_anglePerFrame * f32(frameIndex)));
+            frame->m_nodeScales.push_back(Vector3::k_one);
+            frames.push_back(std::move(frame));
+        }
+        
+        CompressedKeyFrames compressedKeyFrames(frames);
+        
+        f64 maxOrientationError = 0.0;
+        DecodedFrame decodedFrame(1, 0.0f);
+        for (u32 frameIndex = 0; frameIndex < k_numSlowFrames; ++frameIndex)
+        {
+            decodedFrame.Decode(compressedKeyFrames, frameIndex);
+            maxOrientationError = std::max(maxOrientationError, GetAngleBetween(decodedFrame.GetOrientation(0), frames[frameIndex]->m_nodeOrientations[0]));
+        }
+        
+        return Check(maxOrientationError <= k_maxOrientationError, "a slowly turning orientation is within the error bound of the original.");
+    }
+    
+    /// Checks that decoding into fewer channels than there are nodes only writes the
+    /// requested nodes, and decoding into more leaves the extra nodes untouched.
+    ///
+    /// @return Whether or not the test passed.
+    ///
+    bool TestNodeCounts() noexcept
+    {
+        std::mt19937 random(3);
+        auto frames = CreateKeyFrames(random);
+        CompressedKeyFrames compressedKeyFrames(frames);
+        
+        constexpr f32 k_fill = 12345.0f;
+        
+        DecodedFrame largerFrame(k_numNodes + 4, k_fill);
+        largerFrame.Decode(compressedKeyFrames, 1);
+        
+        bool untouched = true;
+        for (const auto& channel : largerFrame.m_channels)
+        {
+            untouched &= std::all_of(channel.begin() + k_numNodes, channel.end(), [=](f32 value) { return value == k_fill; });
+        }
+        
+        //Decoding a prefix of the nodes must skip the per frame data of the others correctly, so
+        //the values are compared to a full decode.
+        DecodedFrame fullFrame(k_numNodes, k_fill);
+        fullFrame.Decode(compressedKeyFrames, 1);
+        DecodedFrame smallerFrame(k_numNodes / 2, k_fill);
+        smallerFrame.Decode(compressedKeyFrames, 1);
+        
+        bool matches = true;
+        for (u32 c = 0; c < 10; ++c)
+        {
+            matches &= std::equal(smallerFrame.m_channels[c].begin(), smallerFrame.m_channels[c].end(), fullFrame.m_channels[c].begin());
+        }
+        
+        bool passed = true;
+        passed &= Check(untouched, "nodes beyond those in the key frames are left untouched.");
+        passed &= Check(matches, "decoding fewer nodes gives the same values as a full decode.");
+        
+        return passed;
+    }
+}
+
+/// Tests that compressed key frames decode to within the error bounds of the original key
+/// frames, and that constant tracks aren't stored per frame.
+///
+int main()
+{
+    bool passed = true;
+    passed &= TestErrorBounds();
+    passed &= TestConstantTrackElision();
+    passed &= TestSlowRotation();
+    passed &= TestNodeCounts();
+    
+    std::printf("%s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Math/MathUtils.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Rendering/Model/Skeleton.h>
+#include <ChilliSource/Rendering/Model/SkeletonDesc.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimation.h>
+#include <ChilliSource/Rendering/Model/SkinnedAnimationPose.h>
+
+#include <AllocationCounter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_nodeCounts[] = { 20, 53, 120 };
+    constexpr u32 k_numCharacters = 100;
+    constexpr u32 k_numKeyFrames = 30;
+    constexpr u32 k_numUpdates = 50;
+    constexpr u32 k_childrenPerNode = 3;
+    constexpr f32 k_frameTime = 1.0f / 30.0f;
+    constexpr f32 k_blendlinePosition = 0.3f;
+    constexpr f32 k_maxKeyFrameRotation = 0.02f;
+    
+    /// The largest allowed difference between any matrix element built from poses and from
+    /// the previous implementation. Orientations are now nlerped rather than slerped. The
+    /// difference grows with the angle between the blended orientations, which here is up to
+    /// about a radian between the two animations, and is compounded down the hierarchy.
+    ///
+    constexpr f32 k_maxError = 1e-2f;
+    
+    /// The key frames of one animation.
+    ///
+    using KeyFrames = std::vector<SkinnedAnimation::FrameCUPtr>;
+    
+    /// The animated state of one character when sampled the way SkinnedAnimationGroup does
+    /// now, with each pose owned by the character.
+    ///
+    struct PoseCharacter final
+    {
+        SkinnedAnimationPose m_currentPose;
+        SkinnedAnimationPose m_blendPose;
+        SkinnedAnimationPose m_keyFramePose;
+        std::vector<Matrix4> m_matrices;
+    };
+    
+    /// @return A skeleton with the given number of nodes, in which each node has up to
+    ///     k_childrenPerNode children. Every node is a joint.
+    ///
+    Skeleton CreateSkeleton(u32 numNodes) noexcept
+    {
+        std::vector<std::string> nodeNames;
+        std::vector<s32> parentNodeIndices;
+        std::vector<s32> jointIndices;
+        for (u32 i = 0; i < numNodes; ++i)
+        {
+            nodeNames.push_back("node" + std::to_string(i));
+            parentNodeIndices.push_back(i == 0 ? -1 : s32((i - 1) / k_childrenPerNode));
+            jointIndices.push_back(s32(i));
+        }
+        
+        return Skeleton(SkeletonDesc(nodeNames, parentNodeIndices, jointIndices));
+    }
+    
+    /// @return A random orientation for each of the given number of nodes, which is used as
+    ///     the rest pose of the skeleton.
+    ///
+    std::vector<Quaternion> CreateRestOrientations(std::mt19937& random, u32 numNodes) noexcept
+    {
+        std::uniform_real_distribution<f32> unitDistribution(-1.0f, 1.0f);
+        
+        std::vector<Quaternion> restOrientations;
+        for (u32 i = 0; i < numNodes; ++i)
+        {
+            auto axis = Vector3::Normalise(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)));
+            restOrientations.push_back(Quaternion(axis, 3.0f * unitDistribution(random)));
+        }
+        
+        return restOrientations;
+    }
+    
+    /// @return The key frames of an animation. Each node starts from its rest orientation and
+    ///     rotates by up to k_maxKeyFrameRotation radians between key frames, as exported
+    ///     animations do. Translations and scales are random.
+    ///
+    KeyFrames CreateKeyFrames(std::mt19937& random, const std::vector<Quaternion>& restOrientations) noexcept
+    {
+        std::uniform_real_distribution<f32> unitDistribution(-1.0f, 1.0f);
+        std::uniform_real_distribution<f32> scaleDistribution(0.8f, 1.2f);
+        
+        std::vector<Vector3> axes;
+        std::vector<f32> angularSpeeds;
+        for (u32 i = 0; i < restOrientations.size(); ++i)
+        {
+            axes.push_back(Vector3::Normalise(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random))));
+            angularSpeeds.push_back(k_maxKeyFrameRotation * unitDistribution(random));
+        }
+        
+        KeyFrames keyFrames;
+        for (u32 frameIndex = 0; frameIndex < k_numKeyFrames; ++frameIndex)
+        {
+            SkinnedAnimation::FrameUPtr frame(new SkinnedAnimation::Frame());
+            for (u32 i = 0; i < restOrientations.size(); ++i)
+            {
+                frame->m_nodeTranslations.push_back(Vector3(unitDistribution(random), unitDistribution(random), unitDistribution(random)));
+                frame->m_nodeScales.push_back(Vector3(scaleDistribution(random), scaleDistribution(random), scaleDistribution(random)));
+                frame->m_nodeOrientations.push_back(restOrientations[i] * Quaternion(axes[i], angularSpeeds[i] * f32(frameIndex)));
+            }
+            keyFrames.push_back(std::move(frame));
+        }
+        
+        return keyFrames;
+    }
+    
+    /// Finds the key frames either side of the given playback position, in the same way as
+    /// SkinnedAnimationGroup.
+    ///
+    /// @param playbackPosition
+    ///     The playback position in seconds.
+    /// @param out_frameA
+    ///     (Out) The index of the earlier key frame.
+    /// @param out_frameB
+    ///     (Out) The index of the later key frame.
+    ///
+    /// @return The interpolation factor between the two key frames.
+    ///
+    f32 GetKeyFrames(f32 playbackPosition, u32& out_frameA, u32& out_frameB) noexcept
+    {
+        f32 frames = playbackPosition / k_frameTime;
+        out_frameA = std::min(u32(std::floor(frames)), k_numKeyFrames - 1);
+        out_frameB = std::min(u32(std::ceil(frames)), k_numKeyFrames - 1);
+        return (playbackPosition - f32(out_frameA) * k_frameTime) / k_frameTime;
+    }
+    
+    /// @return The playback position of the given character in the given update. Each
+    ///     character is at a different point in the animation.
+    ///
+    f32 GetPlaybackPosition(u32 characterIndex, u32 updateIndex) noexcept
+    {
+        f32 length = k_frameTime * f32(k_numKeyFrames - 1);
+        return std::fmod(0.37f * f32(characterIndex) + 0.016f * f32(updateIndex), length);
+    }
+    
+    /// Interpolates between two frames by allocating a new frame, as
+    /// SkinnedAnimationGroup::LerpBetweenFrames() did before poses were added.
+    ///
+    SkinnedAnimation::FrameCUPtr LerpBetweenFramesBaseline(const SkinnedAnimation::Frame* frameA, const SkinnedAnimation::Frame* frameB, f32 factor) noexcept
+    {
+        SkinnedAnimation::FrameUPtr outFrame(new SkinnedAnimation::Frame());
+        
+        outFrame->m_nodeTranslations.reserve(frameB->m_nodeTranslations.size());
+        for (u32 i = 0; i < frameA->m_nodeTranslations.size() && i < frameB->m_nodeTranslations.size(); ++i)
+        {
+            outFrame->m_nodeTranslations.push_back(MathUtils::Lerp(factor, frameA->m_nodeTranslations[i], frameB->m_nodeTranslations[i]));
+        }
+        
+        outFrame->m_nodeOrientations.reserve(frameB->m_nodeOrientations.size());
+        for (u32 i = 0; i < frameA->m_nodeOrientations.size() && i < frameB->m_nodeOrientations.size(); ++i)
+        {
+            outFrame->m_nodeOrientations.push_back(Quaternion::Slerp(frameA->m_nodeOrientations[i], frameB->m_nodeOrientations[i], factor));
+        }
+        
+        outFrame->m_nodeScales.reserve(frameB->m_nodeScales.size());
+        for (u32 i = 0; i < frameA->m_nodeScales.size() && i < frameB->m_nodeScales.size(); ++i)
+        {
+            outFrame->m_nodeScales.push_back(MathUtils::Lerp(factor, frameA->m_nodeScales[i], frameB->m_nodeScales[i]));
+        }
+        
+        return SkinnedAnimation::FrameCUPtr(std::move(outFrame));
+    }
+    
+    /// Builds the matrices of every child of the given parent by rescanning the skeleton at
+    /// each level, as SkinnedAnimationGroup::BuildMatrices() did before poses were added.
+    ///
+    void BuildMatricesBaseline(const Skeleton& skeleton, const SkinnedAnimation::Frame& frame, s32 parentIndex, const Matrix4& parentMatrix, std::vector<Matrix4>& out_matrices) noexcept
+    {
+        const auto& nodes = skeleton.GetNodes();
+        for (u32 i = 0; i < nodes.size(); ++i)
+        {
+            if (nodes[i]->mdwParentIndex == parentIndex)
+            {
+                auto localMatrix = Matrix4::CreateTransform(frame.m_nodeTranslations[i], frame.m_nodeScales[i], frame.m_nodeOrientations[i]);
+                out_matrices[i] = localMatrix * parentMatrix;
+                BuildMatricesBaseline(skeleton, frame, s32(i), out_matrices[i], out_matrices);
+            }
+        }
+    }
+    
+    /// Samples both animations for one character, blends them and builds the matrices in
+    /// the way SkinnedAnimationGroup did before poses were added.
+    ///
+    void UpdateBaseline(const Skeleton& skeleton, const KeyFrames& animationA, const KeyFrames& animationB, f32 playbackPosition, std::vector<Matrix4>& out_matrices) noexcept
+    {
+        u32 frameA = 0, frameB = 0;
+        f32 factor = GetKeyFrames(playbackPosition, frameA, frameB);
+        
+        auto sampleA = LerpBetweenFramesBaseline(animationA[frameA].get(), animationA[frameB].get(), factor);
+        auto sampleB = LerpBetweenFramesBaseline(animationB[frameA].get(), animationB[frameB].get(), factor);
+        auto blended = LerpBetweenFramesBaseline(sampleA.get(), sampleB.get(), k_blendlinePosition);
+        
+        BuildMatricesBaseline(skeleton, *blended, -1, Matrix4::k_identity, out_matrices);
+    }
+    
+    /// Samples both animations for one character, blends them and builds the matrices in
+    /// the way SkinnedAnimationGroup now does.
+    ///
+    void UpdatePose(const Skeleton& skeleton, const KeyFrames& animationA, const KeyFrames& animationB, f32 playbackPosition, PoseCharacter& character) noexcept
+    {
+        u32 frameA = 0, frameB = 0;
+        f32 factor = GetKeyFrames(playbackPosition, frameA, frameB);
+        
+        character.m_currentPose.SetFrame(*animationA[frameA]);
+        character.m_keyFramePose.SetFrame(*animationA[frameB]);
+        character.m_currentPose.Blend(character.m_keyFramePose, factor);
+        
+        character.m_blendPose.SetFrame(*animationB[frameA]);
+        character.m_keyFramePose.SetFrame(*animationB[frameB]);
+        character.m_blendPose.Blend(character.m_keyFramePose, factor);
+        
+        character.m_currentPose.Blend(character.m_blendPose, k_blendlinePosition);
+        character.m_currentPose.BuildMatrices(skeleton, character.m_matrices);
+    }
+    
+    /// @return The largest difference between any element of the two sets of matrices.
+    ///
+    f32 GetMaxDifference(const std::vector<Matrix4>& matricesA, const std::vector<Matrix4>& matricesB) noexcept
+    {
+        f32 maxDifference = 0.0f;
+        for (u32 i = 0; i < matricesA.size(); ++i)
+        {
+            for (u32 j = 0; j < 16; ++j)
+            {
+                maxDifference = std::max(maxDifference, std::abs(matricesA[i].m[j] - matricesB[i].m[j]));
+            }
+        }
+        
+        return maxDifference;
+    }
+    
+    /// @return The time since the given start time in milliseconds.
+    ///
+    f64 GetMillisecondsSince(const std::chrono::steady_clock::time_point& start) noexcept
+    {
+        return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    /// Updates a crowd of characters, each blending two animations of a skeleton with the
+    /// given number of nodes, using both the previous allocating implementation and poses.
+    ///
+    /// @param numNodes
+    ///     The number of nodes in the skeleton.
+    ///
+    /// @return Whether or not the poses allocated nothing and matched the previous
+    ///     implementation.
+    ///
+    bool RunUpdates(u32 numNodes) noexcept
+    {
+        std::mt19937 random(numNodes);
+        auto skeleton = CreateSkeleton(numNodes);
+        auto restOrientations = CreateRestOrientations(random, numNodes);
+        auto animationA = CreateKeyFrames(random, restOrientations);
+        auto animationB = CreateKeyFrames(random, restOrientations);
+        
+        std::vector<std::vector<Matrix4>> baselineMatrices(k_numCharacters, std::vector<Matrix4>(numNodes));
+        std::vector<PoseCharacter> characters(k_numCharacters);
+        for (auto& character : characters)
+        {
+            character.m_currentPose = SkinnedAnimationPose(numNodes);
+            character.m_blendPose = SkinnedAnimationPose(numNodes);
+            character.m_keyFramePose = SkinnedAnimationPose(numNodes);
+            character.m_matrices.resize(numNodes);
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        for (u32 update = 0; update < k_numUpdates; ++update)
+        {
+            for (u32 i = 0; i < k_numCharacters; ++i)
+            {
+                UpdateBaseline(skeleton, animationA, animationB, GetPlaybackPosition(i, update), baselineMatrices[i]);
+            }
+        }
+        f64 baselineMs = GetMillisecondsSince(start);
+        
+        auto allocationCount = Test::GetAllocationCount();
+        start = std::chrono::steady_clock::now();
+        for (u32 update = 0; update < k_numUpdates; ++update)
+        {
+            for (u32 i = 0; i < k_numCharacters; ++i)
+            {
+                UpdatePose(skeleton, animationA, animationB, GetPlaybackPosition(i, update), characters[i]);
+            }
+        }
+        f64 poseMs = GetMillisecondsSince(start);
+        auto poseAllocations = Test::GetAllocationCount() - allocationCount;
+        
+        f32 maxError = 0.0f;
+        for (u32 i = 0; i < k_numCharacters; ++i)
+        {
+            maxError = std::max(maxError, GetMaxDifference(baselineMatrices[i], characters[i].m_matrices));
+        }
+        
+        f64 numCharacterUpdates = f64(k_numCharacters * k_numUpdates);
+        std::printf("%4u nodes  baseline %8.1f characters/ms  pose %8.1f characters/ms  %4.1fx  max error %.1e  %llu allocations\n", numNodes,
+                    numCharacterUpdates / baselineMs, numCharacterUpdates / poseMs, baselineMs / poseMs, maxError, static_cast<unsigned long long>(poseAllocations));
+        
+        bool passed = true;
+        if (poseAllocations != 0)
+        {
+            std::printf("FAILED: sampling and blending poses allocated %llu times.\n", static_cast<unsigned long long>(poseAllocations));
+            passed = false;
+        }
+        
+        if (maxError > k_maxError)
+        {
+            std::printf("FAILED: the pose matrices differ from the previous implementation by %.1e.\n", maxError);
+            passed = false;
+        }
+        
+        return passed;
+    }
+}
+
+/// Measures how many characters per millisecond can have two skinned animations sampled,
+/// blended and converted to matrices, using SkinnedAnimationPose and using the previous
+/// implementation which allocated a new frame for each interpolation. The results of the
+/// two are checked against each other.
+///
+int main()
+{
+    std::printf("%u characters, 2 animations each\n", k_numCharacters);
+    
+    bool passed = true;
+    for (u32 numNodes : k_nodeCounts)
+    {
+        passed &= RunUpdates(numNodes);
+    }
+    
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,355 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/Entity/Entity.h>
+#include <ChilliSource/Core/Entity/Transform.h>
+#include <ChilliSource/Core/Math/Geometry/Shapes.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Math/Quaternion.h>
+#include <ChilliSource/Core/Math/Vector2.h>
+#include <ChilliSource/Core/Math/Vector3.h>
+#include <ChilliSource/Core/Memory/PagedLinearAllocator.h>
+#include <ChilliSource/Rendering/Base/RenderObject.h>
+#include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+#include <ChilliSource/Rendering/Base/SizePolicy.h>
+#include <ChilliSource/Rendering/Camera/RenderCamera.h>
+#include <ChilliSource/Rendering/Material/Material.h>
+#include <ChilliSource/Rendering/Model/RenderDynamicMesh.h>
+#include <ChilliSource/Rendering/Particle/ConcurrentParticleData.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
+#include <ChilliSource/Rendering/Particle/ParticleEffect.h>
+#include <ChilliSource/Rendering/Particle/Drawable/ParticleDrawable.h>
+#include <ChilliSource/Rendering/Particle/Drawable/ParticleDrawableDef.h>
+#include <ChilliSource/Rendering/Particle/Drawable/StaticBillboardParticleDrawable.h>
+#include <ChilliSource/Rendering/Particle/Drawable/StaticBillboardParticleDrawableDef.h>
+#include <ChilliSource/Rendering/Sprite/SpriteMeshBuilder.h>
+#include <ChilliSource/Rendering/Texture/Texture.h>
+#include <ChilliSource/Rendering/Texture/TextureAtlas.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_numFrames = 20;
+    
+    /// The page size used by the renderer's frame allocators. Batched meshes are allocated
+    /// from the frame allocator, so this must be at least RenderDynamicMesh::k_maxVertexDataSize.
+    ///
+    constexpr std::size_t k_frameAllocatorPageSize = 1024 * 1024;
+    constexpr u32 k_maxBillboardsByVertexData = RenderDynamicMesh::k_maxVertexDataSize / (4 * sizeof(SpriteVertex));
+    constexpr u32 k_maxBillboardsByIndexData = RenderDynamicMesh::k_maxIndexDataSize / (6 * sizeof(u16));
+    constexpr u32 k_maxBillboardsPerMesh = (k_maxBillboardsByVertexData < k_maxBillboardsByIndexData) ? k_maxBillboardsByVertexData : k_maxBillboardsByIndexData;
+    
+    const Integer2 k_resolution(1280, 720);
+    const Integer2 k_textureDimensions(64, 64);
+    const Vector2 k_particleSize(0.5f, 0.5f);
+    
+    /// Storage standing in for the particle effect, material, texture and render material
+    /// group. Only the members used by the drawable are defined below, none of which read
+    /// from them.
+    ///
+    u8 g_particleEffect;
+    u8 g_material;
+    u8 g_texture;
+    u8 g_renderMaterialGroup;
+    
+    /// The maximum number of particles in the benchmark's effect. This is changed for each
+    /// particle count.
+    ///
+    u32 g_maxParticles = 0;
+    
+    /// The result of drawing the effect for a number of frames.
+    ///
+    struct DrawResult final
+    {
+        f64 m_microsecondsPerFrame = 0.0;
+        u32 m_numRenderObjects = 0;
+        u32 m_numVertices = 0;
+    };
+    
+    /// Fills the given particle data with the given number of visible particles spread
+    /// through a cube, with varying scales, rotations and colours.
+    ///
+    /// @param concurrentParticleData
+    ///     The particle data to fill.
+    /// @param numParticles
+    ///     The number of particles.
+    ///
+    void FillParticles(ConcurrentParticleData& concurrentParticleData, u32 numParticles) noexcept
+    {
+        ParticleArray particleArray(numParticles);
+        std::vector<u32> newIds;
+        newIds.reserve(numParticles);
+        
+        AABB aabb(Vector3::k_zero, Vector3::k_zero);
+        for (u32 i = 0; i < numParticles; ++i)
+        {
+            auto index = particleArray.Add();
+            auto value = f32((i * 7919u) % 1000u) * 0.01f;
+            
+            auto position = Vector3(value, 10.0f - value, 0.5f * value);
+            particleArray.SetPosition(index, position);
+            particleArray.SetScale(index, Vector2(1.0f + 0.1f * value, 1.0f));
+            particleArray.GetRotations()[index] = value;
+            particleArray.SetColour(index, Colour(1.0f, 0.1f * value, 0.5f, 1.0f));
+            
+            newIds.push_back(particleArray.GetIds()[index]);
+        }
+        
+        Sphere boundingSphere(Vector3(5.0f, 5.0f, 2.5f), 10.0f);
+        concurrentParticleData.CommitParticleData(&particleArray, newIds, AABB(boundingSphere.vOrigin, Vector3(20.0f, 20.0f, 20.0f)), boundingSphere);
+    }
+    
+    /// Draws the effect into a new render snapshot each frame, and reports the average time
+    /// taken along with the number of render objects and vertices the final frame produced.
+    ///
+    /// @param drawMode
+    ///     The draw mode.
+    /// @param numParticles
+    ///     The number of particles in the effect.
+    /// @param frameAllocator
+    ///     The allocator used for each frame's render data. This is reset after every frame.
+    ///
+    /// @return The result.
+    ///
+    DrawResult DrawEffect(StaticBillboardParticleDrawableDef::DrawMode drawMode, u32 numParticles, PagedLinearAllocator& frameAllocator) noexcept
+    {
+        g_maxParticles = numParticles;
+        
+        MaterialCSPtr material(reinterpret_cast<const Material*>(&g_material), [](const Material*) {});
+        StaticBillboardParticleDrawableDef drawableDef(material, k_particleSize, SizePolicy::k_none, drawMode);
+        
+        ConcurrentParticleData concurrentParticleData(numParticles);
+        FillParticles(concurrentParticleData, numParticles);
+        
+        auto drawable = drawableDef.CreateInstance(nullptr, &concurrentParticleData);
+        RenderCamera renderCamera(Matrix4::k_identity, Matrix4::k_identity, Quaternion(Vector3::k_unitPositiveY, 0.5f));
+        
+        DrawResult result;
+        f64 totalMicroseconds = 0.0;
+        for (u32 frame = 0; frame < k_numFrames; ++frame)
+        {
+            {
+                RenderSnapshot renderSnapshot(nullptr, k_resolution, Colour::k_black, renderCamera);
+                
+                auto start = std::chrono::steady_clock::now();
+                drawable->Draw(renderSnapshot, &frameAllocator);
+                totalMicroseconds += std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+                
+                auto renderObjects = renderSnapshot.ClaimRenderObjects();
+                result.m_numRenderObjects = u32(renderObjects.size());
+                result.m_numVertices = 0;
+                for (const auto& renderObject : renderObjects)
+                {
+                    result.m_numVertices += renderObject.GetRenderDynamicMesh()->GetNumVertices();
+                }
+            }
+            
+            frameAllocator.Reset();
+        }
+        
+        result.m_microsecondsPerFrame = totalMicroseconds / k_numFrames;
+        return result;
+    }
+}
+
+namespace ChilliSource
+{
+    //Material.cpp, Texture.cpp, TextureAtlas.cpp, ParticleEffect.cpp, ParticleDrawableDef.cpp and StaticBillboardParticleDrawableDef.cpp
+    //are not linked, as they depend on resource loading, and neither are Entity.cpp or Transform.cpp. Only the members used by the
+    //drawable are defined, with the drawable def's members matching StaticBillboardParticleDrawableDef.cpp. The effect is drawn in
+    //world space without a texture atlas, so the entity transform and atlas frames are never used.
+    
+    CS_DEFINE_NAMEDTYPE(ParticleDrawableDef);
+    CS_DEFINE_NAMEDTYPE(StaticBillboardParticleDrawableDef);
+    
+    //------------------------------------------------------------------------------
+    StaticBillboardParticleDrawableDef::StaticBillboardParticleDrawableDef(const MaterialCSPtr& in_material, const Vector2& in_particleSize, SizePolicy in_sizePolicy, DrawMode in_drawMode)
+        : m_material(in_material), m_particleSize(in_particleSize), m_sizePolicy(in_sizePolicy), m_drawMode(in_drawMode)
+    {
+    }
+    
+    //------------------------------------------------------------------------------
+    bool StaticBillboardParticleDrawableDef::IsA(InterfaceIDType in_interfaceId) const
+    {
+        return (ParticleDrawableDef::InterfaceID == in_interfaceId || StaticBillboardParticleDrawableDef::InterfaceID == in_interfaceId);
+    }
+    
+    //------------------------------------------------------------------------------
+    ParticleDrawableUPtr StaticBillboardParticleDrawableDef::CreateInstance(const Entity* in_entity, ConcurrentParticleData* in_concurrentParticleData) const
+    {
+        return ParticleDrawableUPtr(new StaticBillboardParticleDrawable(in_entity, this, in_concurrentParticleData));
+    }
+    
+    //------------------------------------------------------------------------------
+    const MaterialCSPtr& StaticBillboardParticleDrawableDef::GetMaterial() const
+    {
+        return m_material;
+    }
+    
+    //------------------------------------------------------------------------------
+    const TextureAtlasCSPtr& StaticBillboardParticleDrawableDef::GetTextureAltas() const
+    {
+        return m_textureAtlas;
+    }
+    
+    //------------------------------------------------------------------------------
+    const std::vector<std::string>& StaticBillboardParticleDrawableDef::GetAtlasIds() const
+    {
+        return m_atlasIds;
+    }
+    
+    //------------------------------------------------------------------------------
+    StaticBillboardParticleDrawableDef::ImageSelectionType StaticBillboardParticleDrawableDef::GetImageSelectionType() const
+    {
+        return m_imageSelectionType;
+    }
+    
+    //------------------------------------------------------------------------------
+    const Vector2& StaticBillboardParticleDrawableDef::GetParticleSize() const
+    {
+        return m_particleSize;
+    }
+    
+    //------------------------------------------------------------------------------
+    SizePolicy StaticBillboardParticleDrawableDef::GetSizePolicy() const
+    {
+        return m_sizePolicy;
+    }
+    
+    //------------------------------------------------------------------------------
+    StaticBillboardParticleDrawableDef::DrawMode StaticBillboardParticleDrawableDef::GetDrawMode() const
+    {
+        return m_drawMode;
+    }
+    
+    //------------------------------------------------------------------------------
+    const ParticleEffect* ParticleDrawableDef::GetParticleEffect() const
+    {
+        return reinterpret_cast<const ParticleEffect*>(&g_particleEffect);
+    }
+    
+    //------------------------------------------------------------------------------
+    u32 ParticleEffect::GetMaxParticles() const
+    {
+        return g_maxParticles;
+    }
+    
+    //------------------------------------------------------------------------------
+    ParticleEffect::SimulationSpace ParticleEffect::GetSimulationSpace() const
+    {
+        return SimulationSpace::k_world;
+    }
+    
+    //------------------------------------------------------------------------------
+    const TextureCSPtr& Material::GetTexture(u32 in_texIndex) const noexcept
+    {
+        static const TextureCSPtr s_texture(reinterpret_cast<const Texture*>(&g_texture), [](const Texture*) {});
+        return s_texture;
+    }
+    
+    //------------------------------------------------------------------------------
+    const RenderMaterialGroup* Material::GetRenderMaterialGroup() const noexcept
+    {
+        return reinterpret_cast<const RenderMaterialGroup*>(&g_renderMaterialGroup);
+    }
+    
+    //------------------------------------------------------------------------------
+    const Integer2& Texture::GetDimensions() const noexcept
+    {
+        return k_textureDimensions;
+    }
+    
+    //------------------------------------------------------------------------------
+    const TextureAtlas::Frame& TextureAtlas::GetFrame(const std::string& in_textureId) const
+    {
+        CS_LOG_FATAL("The benchmark doesn't use a texture atlas.");
+        return *reinterpret_cast<const Frame*>(&g_texture);
+    }
+    
+    //------------------------------------------------------------------------------
+    const Transform& Entity::GetTransform() const
+    {
+        CS_LOG_FATAL("The benchmark only draws world space effects, which don't use the entity transform.");
+        return *reinterpret_cast<const Transform*>(&g_particleEffect);
+    }
+    
+    //------------------------------------------------------------------------------
+    const Matrix4& Transform::GetWorldTransform() const
+    {
+        return Matrix4::k_identity;
+    }
+    
+    //------------------------------------------------------------------------------
+    const Vector3& Transform::GetWorldScale() const
+    {
+        return Vector3::k_one;
+    }
+}
+
+/// Measures the time taken to draw a world space billboard particle effect into a render
+/// snapshot at several particle counts, in both the individual draw mode, which adds a
+/// render object and dynamic mesh per particle, and the batched draw mode, which writes
+/// every particle into as few dynamic meshes as possible. Both modes are checked to
+/// produce a quad for every particle.
+///
+int main()
+{
+    PagedLinearAllocator frameAllocator(k_frameAllocatorPageSize);
+    
+    std::printf("%10s %16s %16s %8s %16s\n", "particles", "individual", "batched", "speedup", "batched objects");
+    
+    bool passed = true;
+    for (u32 numParticles : { 1000u, 10000u, 50000u })
+    {
+        auto individual = DrawEffect(StaticBillboardParticleDrawableDef::DrawMode::k_individual, numParticles, frameAllocator);
+        auto batched = DrawEffect(StaticBillboardParticleDrawableDef::DrawMode::k_batched, numParticles, frameAllocator);
+        
+        std::printf("%10u %13.1f us %13.1f us %7.1fx %16u\n", numParticles, individual.m_microsecondsPerFrame, batched.m_microsecondsPerFrame,
+                    individual.m_microsecondsPerFrame / batched.m_microsecondsPerFrame, batched.m_numRenderObjects);
+        
+        u32 expectedBatchedObjects = (numParticles + k_maxBillboardsPerMesh - 1) / k_maxBillboardsPerMesh;
+        if (individual.m_numRenderObjects != numParticles || batched.m_numRenderObjects != expectedBatchedObjects)
+        {
+            std::printf("FAILED: expected %u individual and %u batched render objects for %u particles, got %u and %u.\n", numParticles, expectedBatchedObjects, numParticles,
+                        individual.m_numRenderObjects, batched.m_numRenderObjects);
+            passed = false;
+        }
+        
+        if (individual.m_numVertices != 4 * numParticles || batched.m_numVertices != 4 * numParticles)
+        {
+            std::printf("FAILED: expected %u vertices for %u particles, got %u individual and %u batched.\n", 4 * numParticles, numParticles, individual.m_numVertices, batched.m_numVertices);
+            passed = false;
+        }
+    }
+    
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,370 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Application.h>
+#include <ChilliSource/Core/Base/SystemInfo.h>
+#include <ChilliSource/Core/Threading/TaskContext.h>
+#include <ChilliSource/Core/Threading/TaskPool.h>
+#include <ChilliSource/Core/Threading/TaskScheduler.h>
+#include <ChilliSource/Core/Threading/TaskType.h>
+#include <ChilliSource/Rendering/Particle/ConcurrentParticleData.h>
+#include <ChilliSource/Rendering/Particle/ParticleArray.h>
+#include <ChilliSource/Rendering/Particle/ParticleEffect.h>
+#include <ChilliSource/Rendering/Particle/Emitter/ParticleEmitter.h>
+#include <ChilliSource/Rendering/Particle/ParticleUpdateScheduler.h>
+#include <ChilliSource/Rendering/Base/RenderSnapshot.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ChilliSource;
+
+namespace
+{
+    constexpr u32 k_numSmallEffects = 256;
+    constexpr u32 k_particlesPerSmallEffect = 256;
+    constexpr u32 k_numLargeEffects = 4;
+    constexpr u32 k_particlesPerLargeEffect = 32768;
+    constexpr u32 k_numFrames = 50;
+    constexpr u32 k_minMaxThreads = 4;
+    constexpr f32 k_deltaTime = 1.0f / 60.0f;
+    constexpr f32 k_effectDuration = 10.0f;
+    
+    /// The thread which queues and flushes updates.
+    ///
+    std::thread::id g_mainThreadId;
+    
+    /// The pool on which scheduled tasks are run. This is replaced for each thread count.
+    ///
+    TaskPool* g_taskPool = nullptr;
+    
+    /// Tracks the tasks scheduled by the particle update scheduler, so the benchmark can
+    /// wait for each frame's updates to finish.
+    ///
+    std::mutex g_scheduledTasksMutex;
+    std::condition_variable g_scheduledTasksCondition;
+    u32 g_numScheduledTasksRemaining = 0;
+    
+    /// Storage standing in for the particle effect. Only GetDuration() is called on it,
+    /// which is defined below without reading any members.
+    ///
+    u8 g_particleEffect;
+    
+    /// The application which owns the particle update scheduler. Only the members the
+    /// scheduler uses are defined by this benchmark.
+    ///
+    class BenchmarkApplication final : public Application
+    {
+    public:
+        BenchmarkApplication() noexcept : Application(nullptr) {}
+        
+    private:
+        void CreateSystems() noexcept override {}
+        void OnInit() noexcept override {}
+        void PushInitialState() noexcept override {}
+        void OnDestroy() noexcept override {}
+    };
+    
+    /// Calls OnUpdate() on an app system, as the application does each frame. The method
+    /// is protected, so it is named through this derived class.
+    ///
+    class AppSystemUpdater final : public AppSystem
+    {
+    public:
+        /// @param appSystem
+        ///     The system to update.
+        /// @param deltaTime
+        ///     The time since the last update.
+        ///
+        static void Update(AppSystem* appSystem, f32 deltaTime) noexcept
+        {
+            (appSystem->*(&AppSystemUpdater::OnUpdate))(deltaTime);
+        }
+    };
+    
+    /// The state of a single particle effect.
+    ///
+    struct Effect final
+    {
+        std::shared_ptr<ParticleArray> m_particleArray;
+        ConcurrentParticleDataSPtr m_concurrentParticleData;
+    };
+    
+    /// Creates an effect with the given number of live particles. The particles never run
+    /// out of energy, so the number being updated stays constant.
+    ///
+    /// @param numParticles
+    ///     The number of particles.
+    /// @param seed
+    ///     Varies the starting positions and velocities between effects.
+    ///
+    /// @return The effect.
+    ///
+    Effect CreateEffect(u32 numParticles, u32 seed) noexcept
+    {
+        Effect effect;
+        effect.m_particleArray = std::make_shared<ParticleArray>(numParticles);
+        effect.m_concurrentParticleData = std::make_shared<ConcurrentParticleData>(numParticles);
+        
+        for (u32 i = 0; i < numParticles; ++i)
+        {
+            auto index = effect.m_particleArray->Add();
+            auto value = f32((i * 7919u + seed * 104729u) % 1000u) * 0.01f;
+            
+            effect.m_particleArray->GetEnergies()[index] = 1000000.0f;
+            effect.m_particleArray->SetPosition(index, Vector3(value, -value, 0.5f * value));
+            effect.m_particleArray->SetVelocity(index, Vector3(1.0f - value, value, 2.0f));
+        }
+        
+        return effect;
+    }
+    
+    /// Creates a mix of small effects, which are coalesced into shared tasks, and large
+    /// effects, which are split into chunks.
+    ///
+    /// @return The effects.
+    ///
+    std::vector<Effect> CreateEffects() noexcept
+    {
+        std::vector<Effect> effects;
+        for (u32 i = 0; i < k_numSmallEffects; ++i)
+        {
+            effects.push_back(CreateEffect(k_particlesPerSmallEffect, i));
+        }
+        for (u32 i = 0; i < k_numLargeEffects; ++i)
+        {
+            effects.push_back(CreateEffect(k_particlesPerLargeEffect, k_numSmallEffects + i));
+        }
+        
+        return effects;
+    }
+    
+    /// Queues an update for every effect, flushes them and waits for them to finish.
+    ///
+    /// @param particleUpdateScheduler
+    ///     The scheduler.
+    /// @param effects
+    ///     The effects to update.
+    /// @param playbackTime
+    ///     The playback time of the effects.
+    ///
+    void UpdateEffects(ParticleUpdateScheduler* particleUpdateScheduler, const std::vector<Effect>& effects, f32 playbackTime) noexcept
+    {
+        ParticleEffectCSPtr particleEffect(reinterpret_cast<const ParticleEffect*>(&g_particleEffect), [](const ParticleEffect*) {});
+        
+        for (const auto& effect : effects)
+        {
+            effect.m_concurrentParticleData->StartUpdate();
+            
+            ParticleUpdateScheduler::UpdateDesc desc;
+            desc.m_particleEffect = particleEffect;
+            desc.m_particleArray = effect.m_particleArray;
+            desc.m_concurrentParticleData = effect.m_concurrentParticleData;
+            desc.m_playbackTime = playbackTime;
+            desc.m_deltaTime = k_deltaTime;
+            desc.m_entityScale = Vector3::k_one;
+            particleUpdateScheduler->QueueUpdate(desc);
+        }
+        
+        AppSystemUpdater::Update(particleUpdateScheduler, k_deltaTime);
+        
+        std::unique_lock<std::mutex> lock(g_scheduledTasksMutex);
+        g_scheduledTasksCondition.wait(lock, []() { return g_numScheduledTasksRemaining == 0; });
+    }
+    
+    /// Updates a fresh set of effects for a number of frames on a pool with the given
+    /// number of threads, and prints the throughput.
+    ///
+    /// @param particleUpdateScheduler
+    ///     The scheduler.
+    /// @param numThreads
+    ///     The number of worker threads.
+    ///
+    /// @return The bounds of each effect after the final frame.
+    ///
+    std::vector<AABB> RunUpdates(ParticleUpdateScheduler* particleUpdateScheduler, u32 numThreads) noexcept
+    {
+        TaskPool taskPool(TaskType::k_small, numThreads);
+        g_taskPool = &taskPool;
+        
+        auto effects = CreateEffects();
+        
+        auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < k_numFrames; ++frame)
+        {
+            UpdateEffects(particleUpdateScheduler, effects, f32(frame) * k_deltaTime);
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        g_taskPool = nullptr;
+        
+        u64 numParticleUpdates = u64(k_numSmallEffects * k_particlesPerSmallEffect + k_numLargeEffects * k_particlesPerLargeEffect) * k_numFrames;
+        f64 milliseconds = std::chrono::duration<f64, std::milli>(end - start).count();
+        std::printf("%2u threads %12.0f particles/ms\n", numThreads, f64(numParticleUpdates) / milliseconds);
+        
+        std::vector<AABB> bounds;
+        for (const auto& effect : effects)
+        {
+            bounds.push_back(effect.m_concurrentParticleData->GetAABB());
+        }
+        
+        return bounds;
+    }
+    
+    /// @return Whether or not the two sets of bounds are identical.
+    ///
+    bool AreBoundsEqual(const std::vector<AABB>& a, const std::vector<AABB>& b) noexcept
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        
+        for (u32 i = 0; i < a.size(); ++i)
+        {
+            if (a[i].GetOrigin() != b[i].GetOrigin() || a[i].GetSize() != b[i].GetSize())
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+}
+
+namespace ChilliSource
+{
+    //Application.cpp, TaskScheduler.cpp, ParticleEffect.cpp and ParticleEmitter.cpp are not linked. Only the members used by the
+    //particle update scheduler are defined, with scheduled tasks run on the benchmark's own task pool.
+    
+    Application* Application::s_application = nullptr;
+    
+    //------------------------------------------------------------------------------
+    Application::Application(SystemInfoCUPtr systemInfo) noexcept
+        : m_systemInfo(std::move(systemInfo))
+    {
+        s_application = this;
+        m_isSystemCreationAllowed = true;
+    }
+    
+    //------------------------------------------------------------------------------
+    Application::~Application() noexcept
+    {
+        s_application = nullptr;
+    }
+    
+    //------------------------------------------------------------------------------
+    Application* Application::Get() noexcept
+    {
+        return s_application;
+    }
+    
+    //------------------------------------------------------------------------------
+    TaskScheduler* Application::GetTaskScheduler() noexcept
+    {
+        static u8 s_taskScheduler;
+        return reinterpret_cast<TaskScheduler*>(&s_taskScheduler);
+    }
+    
+    //------------------------------------------------------------------------------
+    bool TaskScheduler::IsMainThread() const noexcept
+    {
+        return std::this_thread::get_id() == g_mainThreadId;
+    }
+    
+    //------------------------------------------------------------------------------
+    void TaskScheduler::ScheduleTasks(TaskType taskType, const std::vector<Task>& tasks) noexcept
+    {
+        {
+            std::unique_lock<std::mutex> lock(g_scheduledTasksMutex);
+            g_numScheduledTasksRemaining += u32(tasks.size());
+        }
+        
+        std::vector<Task> trackedTasks;
+        trackedTasks.reserve(tasks.size());
+        for (const auto& task : tasks)
+        {
+            trackedTasks.push_back([=](const TaskContext& taskContext) noexcept
+            {
+                task(taskContext);
+                
+                std::unique_lock<std::mutex> lock(g_scheduledTasksMutex);
+                if (--g_numScheduledTasksRemaining == 0)
+                {
+                    g_scheduledTasksCondition.notify_all();
+                }
+            });
+        }
+        
+        g_taskPool->AddTasks(trackedTasks);
+    }
+    
+    //------------------------------------------------------------------------------
+    f32 ParticleEffect::GetDuration() const
+    {
+        return k_effectDuration;
+    }
+    
+    //------------------------------------------------------------------------------
+    std::vector<u32> ParticleEmitter::TryEmit(f32 playbackTime, const Vector3& entityPosition, const Vector3& entityScale, const Quaternion& entityOrientation, bool interpolateEmission)
+    {
+        //The benchmark's effects have no emitter, so this is never called.
+        return std::vector<u32>();
+    }
+}
+
+/// Measures particle update throughput through the particle update scheduler for each
+/// number of worker threads from 1 up to the hardware concurrency, or at least 4. The
+/// workload mixes small effects, which are coalesced into shared tasks, with large
+/// effects, which are split into chunks. The bounds of each effect are checked to be
+/// identical for every thread count.
+///
+int main()
+{
+    g_mainThreadId = std::this_thread::get_id();
+    
+    BenchmarkApplication application;
+    auto particleUpdateScheduler = application.CreateSystem<ParticleUpdateScheduler>();
+    
+    u32 maxThreads = std::max(k_minMaxThreads, std::thread::hardware_concurrency());
+    std::printf("%u effects, %u particles\n", k_numSmallEffects + k_numLargeEffects, k_numSmallEffects * k_particlesPerSmallEffect + k_numLargeEffects * k_particlesPerLargeEffect);
+    
+    bool passed = true;
+    auto expectedBounds = RunUpdates(particleUpdateScheduler, 1);
+    for (u32 numThreads = 2; numThreads <= maxThreads; ++numThreads)
+    {
+        if (!AreBoundsEqual(RunUpdates(particleUpdateScheduler, numThreads), expectedBounds))
+        {
+            std::printf("FAILED: the bounds with %u threads differ from those with 1 thread.\n", numThreads);
+            passed = false;
+        }
+    }
+    
+    return passed ? 0 : 1;
+}
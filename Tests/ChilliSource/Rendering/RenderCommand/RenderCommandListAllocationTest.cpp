@@ -0,0 +1,173 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <ChilliSource/Core/Base/Colour.h>
+#include <ChilliSource/Core/Math/Matrix4.h>
+#include <ChilliSource/Core/Memory/PagedLinearAllocator.h>
+#include <ChilliSource/Core/Memory/UniquePtr.h>
+#include <ChilliSource/Rendering/RenderCommand/RenderCommandList.h>
+
+#include <AllocationCounter.h>
+
+#include <cstdint>
+#include <cstdio>
+
+using namespace ChilliSource;
+
+namespace
+{
+    /// The page size used by the renderer's frame allocators.
+    ///
+    constexpr std::size_t k_frameAllocatorPageSize = 1024 * 1024;
+    constexpr u32 k_instancesPerRun = 16;
+    
+    /// The number of commands and owning commands recorded by RecordFrame().
+    ///
+    struct FrameStats final
+    {
+        u32 m_numCommands = 0;
+        u32 m_numOwningCommands = 0;
+    };
+    
+    /// Records a frame of commands similar to that produced by the render command
+    /// compiler. Every instanced run adds an owning command, so larger frames add
+    /// enough entries to span several blocks of the ownership side table.
+    ///
+    /// @param renderCommandList
+    ///     The list to record into.
+    /// @param frameAllocator
+    ///     The frame allocator.
+    /// @param numDraws
+    ///     The number of single instance draws.
+    /// @param numInstancedRuns
+    ///     The number of instanced runs.
+    ///
+    void RecordFrame(RenderCommandList& renderCommandList, IAllocator& frameAllocator, u32 numDraws, u32 numInstancedRuns) noexcept
+    {
+        renderCommandList.AddBeginCommand(Integer2(1280, 720), Colour::k_black);
+        renderCommandList.AddApplyCameraCommand(Vector3::k_zero, Matrix4::k_identity, Matrix4::k_identity);
+        renderCommandList.AddApplyAmbientLightCommand(Colour::k_white);
+        
+        for (u32 i = 0; i < numDraws; ++i)
+        {
+            renderCommandList.AddApplyMaterialCommand(nullptr);
+            renderCommandList.AddApplyMeshCommand(nullptr);
+            renderCommandList.AddRenderInstanceCommand(Matrix4::CreateTranslation(Vector3(f32(i), 0.0f, 0.0f)));
+        }
+        
+        for (u32 i = 0; i < numInstancedRuns; ++i)
+        {
+            auto worldMatrices = MakeUniqueArray<Matrix4>(frameAllocator, k_instancesPerRun);
+            for (u32 j = 0; j < k_instancesPerRun; ++j)
+            {
+                worldMatrices[j] = Matrix4::CreateTranslation(Vector3(f32(i), f32(j), 0.0f));
+            }
+            
+            renderCommandList.AddApplyMeshCommand(nullptr);
+            renderCommandList.AddRenderInstancesCommand(std::move(worldMatrices), k_instancesPerRun);
+        }
+        
+        renderCommandList.AddEndCommand();
+    }
+    
+    /// Records a frame into a list backed by the given frame allocator, walks it as the
+    /// command processor and buffer manager would, then discards it and resets the
+    /// allocator ready for the next frame.
+    ///
+    /// @param frameAllocator
+    ///     The frame allocator.
+    /// @param numDraws
+    ///     The number of single instance draws.
+    /// @param numInstancedRuns
+    ///     The number of instanced runs.
+    ///
+    /// @return The number of commands and instanced run commands visited.
+    ///
+    FrameStats RunFrame(PagedLinearAllocator& frameAllocator, u32 numDraws, u32 numInstancedRuns) noexcept
+    {
+        FrameStats stats;
+        
+        {
+            RenderCommandList renderCommandList(&frameAllocator);
+            RecordFrame(renderCommandList, frameAllocator, numDraws, numInstancedRuns);
+            
+            for (auto it = renderCommandList.begin(); it != renderCommandList.end(); ++it)
+            {
+                ++stats.m_numCommands;
+            }
+            
+            renderCommandList.ForEachOwningCommand([&stats](RenderCommand* renderCommand)
+            {
+                if (renderCommand->GetType() == RenderCommand::Type::k_renderInstances)
+                {
+                    ++stats.m_numOwningCommands;
+                }
+            });
+        }
+        
+        frameAllocator.Reset();
+        return stats;
+    }
+}
+
+/// A regression test for heap allocations when recording render commands. Once the
+/// frame allocator has grown to fit a frame, recording, iterating and discarding a
+/// frame of commands - including the ownership side table - must not allocate, no
+/// matter how many commands are recorded.
+///
+int main()
+{
+    constexpr u32 k_numDraws = 2000;
+    constexpr u32 k_maxInstancedRuns = 1000;
+    
+    PagedLinearAllocator frameAllocator(k_frameAllocatorPageSize);
+    
+    //warm up with the largest frame so that the frame allocator has all the pages it needs.
+    RunFrame(frameAllocator, k_numDraws, k_maxInstancedRuns);
+    
+    bool passed = true;
+    for (u32 numInstancedRuns : { 0u, 1u, 64u, 65u, k_maxInstancedRuns })
+    {
+        auto allocationsBefore = Test::GetAllocationCount();
+        auto stats = RunFrame(frameAllocator, k_numDraws, numInstancedRuns);
+        auto allocations = Test::GetAllocationCount() - allocationsBefore;
+        
+        u32 expectedNumCommands = 4 + 3 * k_numDraws + 2 * numInstancedRuns;
+        std::printf("%6u commands %6u owning commands %4llu allocations\n", stats.m_numCommands, stats.m_numOwningCommands, (unsigned long long)allocations);
+        
+        if (stats.m_numCommands != expectedNumCommands || stats.m_numOwningCommands != numInstancedRuns)
+        {
+            std::printf("FAILED: expected %u commands and %u owning commands.\n", expectedNumCommands, numInstancedRuns);
+            passed = false;
+        }
+        
+        if (allocations != 0)
+        {
+            std::printf("FAILED: recording a frame made %llu heap allocations.\n", (unsigned long long)allocations);
+            passed = false;
+        }
+    }
+    
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#include <RecordingGL.h>
+
+#include <GLES2/gl2.h>
+
+#include <algorithm>
+
+namespace
+{
+    std::vector<std::string> g_uniformNames;
+    Test::GLCallCounts g_callCounts;
+    GLuint g_nextShaderId = 1;
+    GLuint g_nextProgramId = 1;
+}
+
+namespace Test
+{
+    //------------------------------------------------------------------------------
+    void SetGLUniformNames(std::vector<std::string> uniformNames) noexcept
+    {
+        g_uniformNames = std::move(uniformNames);
+    }
+    
+    //------------------------------------------------------------------------------
+    GLCallCounts GetGLCallCounts() noexcept
+    {
+        return g_callCounts;
+    }
+    
+    //------------------------------------------------------------------------------
+    void ResetGLCallCounts() noexcept
+    {
+        g_callCounts = GLCallCounts();
+    }
+}
+
+extern "C"
+{
+    //Shaders always compile and link successfully.
+    
+    //------------------------------------------------------------------------------
+    GLuint glCreateShader(GLenum type)
+    {
+        ++g_callCounts.m_numOtherCalls;
+        return g_nextShaderId++;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glCompileShader(GLuint shader)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+    {
+        ++g_callCounts.m_numOtherCalls;
+        *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glDeleteShader(GLuint shader)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    GLuint glCreateProgram()
+    {
+        ++g_callCounts.m_numOtherCalls;
+        return g_nextProgramId++;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glAttachShader(GLuint program, GLuint shader)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glDetachShader(GLuint program, GLuint shader)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glBindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glLinkProgram(GLuint program)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glGetProgramiv(GLuint program, GLenum pname, GLint* params)
+    {
+        ++g_callCounts.m_numOtherCalls;
+        *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glDeleteProgram(GLuint program)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUseProgram(GLuint program)
+    {
+        ++g_callCounts.m_numProgramBinds;
+    }
+    
+    //------------------------------------------------------------------------------
+    GLint glGetAttribLocation(GLuint program, const GLchar* name)
+    {
+        ++g_callCounts.m_numOtherCalls;
+        return -1;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+    {
+        ++g_callCounts.m_numOtherCalls;
+    }
+    
+    //------------------------------------------------------------------------------
+    GLint glGetUniformLocation(GLuint program, const GLchar* name)
+    {
+        ++g_callCounts.m_numUniformLocationLookups;
+        
+        auto it = std::find(g_uniformNames.begin(), g_uniformNames.end(), name);
+        return (it != g_uniformNames.end()) ? GLint(it - g_uniformNames.begin()) : -1;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUniform1i(GLint location, GLint v0)
+    {
+        ++g_callCounts.m_numUniformUploads;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUniform1f(GLint location, GLfloat v0)
+    {
+        ++g_callCounts.m_numUniformUploads;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUniform2fv(GLint location, GLsizei count, const GLfloat* value)
+    {
+        ++g_callCounts.m_numUniformUploads;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUniform3fv(GLint location, GLsizei count, const GLfloat* value)
+    {
+        ++g_callCounts.m_numUniformUploads;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUniform4fv(GLint location, GLsizei count, const GLfloat* value)
+    {
+        ++g_callCounts.m_numUniformUploads;
+    }
+    
+    //------------------------------------------------------------------------------
+    void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+    {
+        ++g_callCounts.m_numUniformUploads;
+    }
+    
+    //------------------------------------------------------------------------------
+    GLenum glGetError()
+    {
+        return GL_NO_ERROR;
+    }
+}
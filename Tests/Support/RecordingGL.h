@@ -0,0 +1,64 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+
+#ifndef _CHILLISOURCE_TESTS_SUPPORT_RECORDINGGL_H_
+#define _CHILLISOURCE_TESTS_SUPPORT_RECORDINGGL_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Test
+{
+    /// The number of calls made to the recording GL stub since it was last reset. Linking
+    /// RecordingGL.cpp defines the OpenGL ES 2.0 functions used by the shader and material
+    /// sources, so they can be run without a context.
+    ///
+    struct GLCallCounts
+    {
+        std::uint32_t m_numUniformLocationLookups = 0;
+        std::uint32_t m_numUniformUploads = 0;
+        std::uint32_t m_numProgramBinds = 0;
+        std::uint32_t m_numOtherCalls = 0;
+    };
+    
+    /// Sets the uniforms which exist in every program created from now on. Looking up any
+    /// other uniform returns -1, as it would for one which is not used by the shader.
+    ///
+    /// @param uniformNames
+    ///     The names of the uniforms. Each is given the location of its index.
+    ///
+    void SetGLUniformNames(std::vector<std::string> uniformNames) noexcept;
+    
+    /// @return The calls made since the counts were last reset.
+    ///
+    GLCallCounts GetGLCallCounts() noexcept;
+    
+    /// Resets all call counts to zero. This is typically called at the start of each frame.
+    ///
+    void ResetGLCallCounts() noexcept;
+}
+
+#endif
@@ -0,0 +1,64 @@
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017 Tag Games Limited
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef _CHILLISOURCE_TESTS_SUPPORT_ANDROID_LOG_H_
+#define _CHILLISOURCE_TESTS_SUPPORT_ANDROID_LOG_H_
+
+#include <cstdarg>
+#include <cstdio>
+
+//Stands in for the NDK logging header, so that Android backend sources can be built on the host.
+//Log messages are written to stderr.
+
+enum
+{
+    ANDROID_LOG_DEBUG = 3,
+    ANDROID_LOG_WARN = 5,
+    ANDROID_LOG_ERROR = 6
+};
+
+/// Writes a formatted message to stderr, prefixed with its tag.
+///
+/// @param priority
+///     The priority of the message. This is ignored.
+/// @param tag
+///     The tag.
+/// @param format
+///     The printf style format string.
+///
+/// @return The number of characters written.
+///
+inline int __android_log_print(int priority, const char* tag, const char* format, ...)
+{
+    std::va_list args;
+    va_start(args, format);
+    int numWritten = std::fprintf(stderr, "[%s] ", tag);
+    numWritten += std::vfprintf(stderr, format, args);
+    numWritten += std::fprintf(stderr, "\n");
+    va_end(args);
+    
+    return numWritten;
+}
+
+#endif